@@ -0,0 +1,256 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Schaub, H., Junkins, J.L. Analytical Mechanics of Space Systems, 2nd Edition, AIAA
+ *          Education Series, Reston, VA, 2009.
+ *
+ *    Notes
+ *      The conversions are verified against a numerically integrated orbit in a J2 gravity
+ *      field: the mean semi-major axis, eccentricity and inclination should be constant up to
+ *      second-order and long-period effects, and the mean node should drift at the secular rate.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/meanElementConversions.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/modifiedEquinoctialElementConversions.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+
+//! Gravitational parameter of the Earth.                                                [m^3/s^2]
+const double earthGravitationalParameter = 3.986004418e14;
+
+//! J2 coefficient of the Earth.                                                                [-]
+const double earthJ2 = 1.08262668e-3;
+
+//! Equatorial radius of the Earth.                                                             [m]
+const double earthRadius = 6378137.0;
+
+//! Compute Cartesian state derivative in J2 gravity field.
+/*!
+ * Computes the Cartesian state derivative for the point-mass and J2 gravity of the Earth.
+ * \param time Current time (unused).
+ * \param cartesianState Current Cartesian state.
+ * \return Cartesian state derivative.
+ */
+Eigen::VectorXd computeJ2CartesianStateDerivative( const double time,
+                                                   const Eigen::VectorXd& cartesianState )
+{
+    const Eigen::Vector3d position = cartesianState.segment( 0, 3 );
+    const double radius = position.norm( );
+    const double zOverRadiusSquared = position.z( ) * position.z( ) / ( radius * radius );
+    const double j2Factor = 1.5 * earthJ2 * earthRadius * earthRadius / ( radius * radius );
+    const double equatorialFactor = 1.0 + j2Factor * ( 1.0 - 5.0 * zOverRadiusSquared );
+    const double polarFactor = 1.0 + j2Factor * ( 3.0 - 5.0 * zOverRadiusSquared );
+
+    Eigen::VectorXd stateDerivative( 6 );
+    stateDerivative.segment( 0, 3 ) = cartesianState.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 ) = -earthGravitationalParameter / ( radius * radius * radius )
+            * Eigen::Vector3d( position.x( ) * equatorialFactor,
+                               position.y( ) * equatorialFactor,
+                               position.z( ) * polarFactor );
+    return stateDerivative;
+}
+
+BOOST_AUTO_TEST_SUITE( test_mean_element_conversions )
+
+//! Test if mean and osculating elements are converted consistently.
+BOOST_AUTO_TEST_CASE( testMeanOsculatingElementRoundTrip )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set mean elements of orbits, including circular, equatorial and retrograde orbits.
+    Eigen::MatrixXd meanElements( 6, 5 );
+    meanElements << 7.0e6, 6.8e6, 2.65e7, 7.2e6, 4.2164e7,
+            0.01, 0.0, 0.7, 0.001, 0.0,
+            0.9, 1.7, 63.4 / 180.0 * PI, 0.0, 0.001,
+            1.0, 0.0, 1.5 * PI, 2.0, 0.0,
+            2.0, 3.0, 0.5, 0.0, 4.0,
+            3.0, 0.2, 0.1, 5.0, 6.0;
+
+    for ( int orbitIndex = 0; orbitIndex < meanElements.cols( ); orbitIndex++ )
+    {
+        const Vector6d osculatingElements = convertMeanToOsculatingKeplerianElements(
+                    meanElements.col( orbitIndex ), earthJ2, earthRadius );
+        const Vector6d reconstructedMeanElements = convertOsculatingToMeanKeplerianElements(
+                    osculatingElements, earthJ2, earthRadius );
+
+        // Check that the short-period variations are significant for low orbits.
+        if ( meanElements( semiMajorAxisIndex, orbitIndex ) < 1.0e7 )
+        {
+            BOOST_CHECK_GT( std::fabs( osculatingElements( semiMajorAxisIndex )
+                                       - meanElements( semiMajorAxisIndex, orbitIndex ) )
+                            + std::fabs( osculatingElements( eccentricityIndex )
+                                         - meanElements( eccentricityIndex, orbitIndex ) )
+                            * 7.0e6, 100.0 );
+        }
+
+        // Compare the mean elements in modified equinoctial elements, which are non-singular.
+        Vector6d difference = convertKeplerianToModifiedEquinoctialElements(
+                    reconstructedMeanElements )
+                - convertKeplerianToModifiedEquinoctialElements( meanElements.col( orbitIndex ) );
+        difference( trueLongitudeIndex ) = std::fmod( difference( trueLongitudeIndex ) + 3.0 * PI,
+                                                      2.0 * PI ) - PI;
+        BOOST_CHECK_SMALL( difference( semiLatusRectumIndex ), 1.0e-4 );
+        BOOST_CHECK_SMALL( difference.tail( 5 ).cwiseAbs( ).maxCoeff( ), 1.0e-11 );
+    }
+}
+
+//! Test if mean elements of a numerically integrated orbit behave as predicted.
+BOOST_AUTO_TEST_CASE( testMeanElementsOfIntegratedOrbit )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set initial osculating elements of a low Earth orbit.
+    Vector6d initialElements;
+    initialElements << 7.0e6, 0.01, 50.0 / 180.0 * PI, 1.0, 2.0, 0.5;
+    numerical_integrators::RungeKutta4IntegratorXd integrator(
+                &computeJ2CartesianStateDerivative, 0.0,
+                convertKeplerianToCartesianElements( initialElements,
+                                                     earthGravitationalParameter ) );
+
+    // Propagate orbit over one day, and convert the osculating elements at regular intervals.
+    const int numberOfSamples = 145;
+    Eigen::MatrixXd osculatingElements( 6, numberOfSamples );
+    for ( int sampleIndex = 0; sampleIndex < numberOfSamples; sampleIndex++ )
+    {
+        const Eigen::VectorXd cartesianState = ( sampleIndex == 0 )
+                ? integrator.getCurrentState( )
+                : integrator.integrateTo( 600.0 * sampleIndex, 10.0 );
+        osculatingElements.col( sampleIndex ) = convertCartesianToKeplerianElements(
+                    cartesianState, earthGravitationalParameter );
+    }
+
+    Eigen::MatrixXd meanElements;
+    convertOsculatingToMeanKeplerianElements( osculatingElements, earthJ2, earthRadius,
+                                              meanElements );
+
+    // Check that the semi-major axis, eccentricity and inclination vary strongly in osculating
+    // elements, but are nearly constant in mean elements.
+    const Eigen::VectorXd osculatingRange = osculatingElements.rowwise( ).maxCoeff( )
+            - osculatingElements.rowwise( ).minCoeff( );
+    const Eigen::VectorXd meanRange = meanElements.rowwise( ).maxCoeff( )
+            - meanElements.rowwise( ).minCoeff( );
+    BOOST_CHECK_GT( osculatingRange( semiMajorAxisIndex ), 5.0e3 );
+    BOOST_CHECK_LT( meanRange( semiMajorAxisIndex ), 20.0 );
+    BOOST_CHECK_GT( osculatingRange( eccentricityIndex ), 5.0e-4 );
+    BOOST_CHECK_LT( meanRange( eccentricityIndex ), 2.0e-5 );
+    BOOST_CHECK_GT( osculatingRange( inclinationIndex ), 5.0e-4 );
+    BOOST_CHECK_LT( meanRange( inclinationIndex ), 2.0e-6 );
+
+    // Check that the mean node drifts at the first-order secular rate.
+    const double meanSemiMajorAxis = meanElements.row( semiMajorAxisIndex ).mean( );
+    const double meanEccentricity = meanElements.row( eccentricityIndex ).mean( );
+    const double meanInclination = meanElements.row( inclinationIndex ).mean( );
+    const double semiLatusRectumRatio = earthRadius
+            / ( meanSemiMajorAxis * ( 1.0 - meanEccentricity * meanEccentricity ) );
+    const double expectedNodeRate = -1.5 * std::sqrt( earthGravitationalParameter
+                                                      / std::pow( meanSemiMajorAxis, 3.0 ) )
+            * earthJ2 * semiLatusRectumRatio * semiLatusRectumRatio * std::cos( meanInclination );
+    const double nodeRate = ( meanElements( longitudeOfAscendingNodeIndex, numberOfSamples - 1 )
+                              - meanElements( longitudeOfAscendingNodeIndex, 0 ) )
+            / ( 600.0 * ( numberOfSamples - 1 ) );
+    BOOST_CHECK_CLOSE_FRACTION( nodeRate, expectedNodeRate, 2.0e-3 );
+}
+
+//! Test if batch conversions of mean and osculating elements are correct.
+BOOST_AUTO_TEST_CASE( testBatchMeanElementConversions )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Create set of orbits with random elements.
+    const int numberOfOrbits = 1000;
+    Eigen::MatrixXd meanElements = Eigen::MatrixXd::Random( 6, numberOfOrbits );
+    meanElements.row( semiMajorAxisIndex ) = 1.5e7 + 8.0e6 * meanElements.row( 0 ).array( );
+    meanElements.row( eccentricityIndex ) = 0.25 + 0.25 * meanElements.row( 1 ).array( );
+    meanElements.row( inclinationIndex ) = 0.5 * PI + 0.45 * PI * meanElements.row( 2 ).array( );
+    meanElements.bottomRows( 3 ) = PI + PI * meanElements.bottomRows( 3 ).array( );
+
+    // Convert with a single and multiple threads.
+    Eigen::MatrixXd osculatingElements;
+    convertMeanToOsculatingKeplerianElements( meanElements, earthJ2, earthRadius,
+                                              osculatingElements, 1 );
+    Eigen::MatrixXd osculatingElementsWithThreads;
+    convertMeanToOsculatingKeplerianElements( meanElements, earthJ2, earthRadius,
+                                              osculatingElementsWithThreads, 4 );
+    Eigen::MatrixXd reconstructedMeanElements;
+    convertOsculatingToMeanKeplerianElements( osculatingElements, earthJ2, earthRadius,
+                                              reconstructedMeanElements, 4 );
+
+    BOOST_CHECK_EQUAL( ( osculatingElements - osculatingElementsWithThreads ).norm( ), 0.0 );
+    for ( int orbitIndex = 0; orbitIndex < numberOfOrbits; orbitIndex++ )
+    {
+        BOOST_CHECK_EQUAL( ( osculatingElements.col( orbitIndex )
+                             - convertMeanToOsculatingKeplerianElements(
+                                 meanElements.col( orbitIndex ), earthJ2, earthRadius ) )
+                           .norm( ), 0.0 );
+        BOOST_CHECK_EQUAL( ( reconstructedMeanElements.col( orbitIndex )
+                             - convertOsculatingToMeanKeplerianElements(
+                                 osculatingElements.col( orbitIndex ), earthJ2, earthRadius ) )
+                           .norm( ), 0.0 );
+    }
+
+    // Check that the elements of a hyperbolic orbit are set to NaN in the batch conversions, and
+    // that an error is thrown in the single-orbit conversions.
+    meanElements( eccentricityIndex, 10 ) = 1.5;
+    meanElements( semiMajorAxisIndex, 10 ) = -1.0e7;
+    convertMeanToOsculatingKeplerianElements( meanElements, earthJ2, earthRadius,
+                                              osculatingElements );
+    convertOsculatingToMeanKeplerianElements( meanElements, earthJ2, earthRadius,
+                                              reconstructedMeanElements );
+    BOOST_CHECK( osculatingElements.col( 10 ).hasNaN( ) );
+    BOOST_CHECK( reconstructedMeanElements.col( 10 ).hasNaN( ) );
+    BOOST_CHECK( !osculatingElements.col( 11 ).hasNaN( ) );
+    BOOST_CHECK_THROW( convertMeanToOsculatingKeplerianElements(
+                           Vector6d( meanElements.col( 10 ) ), earthJ2, earthRadius ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( convertOsculatingToMeanKeplerianElements(
+                           Vector6d( meanElements.col( 10 ) ), earthJ2, earthRadius ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
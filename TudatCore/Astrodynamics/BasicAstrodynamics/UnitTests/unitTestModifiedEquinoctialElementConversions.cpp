@@ -0,0 +1,248 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/modifiedEquinoctialElementConversions.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+
+BOOST_AUTO_TEST_SUITE( test_modified_equinoctial_element_conversions )
+
+//! Test if conversions between Keplerian and modified equinoctial elements are correct.
+BOOST_AUTO_TEST_CASE( testKeplerianModifiedEquinoctialElementConversions )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Case 1: Elliptical orbit, for which the modified equinoctial elements are computed by hand.
+    {
+        Vector6d keplerianElements;
+        keplerianElements << 8.0e6, 0.2, PI / 3.0, PI / 4.0, PI / 6.0, PI / 2.0;
+
+        Vector6d expectedModifiedEquinoctialElements;
+        expectedModifiedEquinoctialElements
+                << 8.0e6 * 0.96, 0.2 * std::cos( 5.0 * PI / 12.0 ),
+                0.2 * std::sin( 5.0 * PI / 12.0 ), std::tan( PI / 6.0 ) * std::cos( PI / 6.0 ),
+                std::tan( PI / 6.0 ) * std::sin( PI / 6.0 ), 11.0 * PI / 12.0;
+
+        const Vector6d computedModifiedEquinoctialElements
+                = convertKeplerianToModifiedEquinoctialElements( keplerianElements );
+        BOOST_CHECK_SMALL( ( computedModifiedEquinoctialElements
+                             - expectedModifiedEquinoctialElements ).cwiseQuotient(
+                               expectedModifiedEquinoctialElements ).cwiseAbs( ).maxCoeff( ),
+                           1.0e-14 );
+
+        // Check if Keplerian elements are recovered.
+        const Vector6d recoveredKeplerianElements = convertModifiedEquinoctialToKeplerianElements(
+                    computedModifiedEquinoctialElements );
+        BOOST_CHECK_SMALL( ( recoveredKeplerianElements - keplerianElements ).cwiseQuotient(
+                               keplerianElements ).cwiseAbs( ).maxCoeff( ), 1.0e-14 );
+    }
+
+    // Case 2: Hyperbolic and parabolic orbits, for which Keplerian elements are recovered.
+    {
+        Vector6d hyperbolicKeplerianElements;
+        hyperbolicKeplerianElements << -2.0e7, 1.5, 2.0, 5.0, 4.0, 0.5;
+        const Vector6d recoveredHyperbolicKeplerianElements
+                = convertModifiedEquinoctialToKeplerianElements(
+                    convertKeplerianToModifiedEquinoctialElements(
+                        hyperbolicKeplerianElements ) );
+        BOOST_CHECK_SMALL( ( recoveredHyperbolicKeplerianElements - hyperbolicKeplerianElements )
+                           .cwiseQuotient( hyperbolicKeplerianElements ).cwiseAbs( ).maxCoeff( ),
+                           1.0e-13 );
+
+        // For parabolic orbits, the first Keplerian element is the semi-latus rectum.
+        Vector6d parabolicKeplerianElements;
+        parabolicKeplerianElements << 1.2e7, 1.0, 0.8, 2.0, 0.5, 1.0;
+        const Vector6d parabolicModifiedEquinoctialElements
+                = convertKeplerianToModifiedEquinoctialElements( parabolicKeplerianElements );
+        BOOST_CHECK_EQUAL( parabolicModifiedEquinoctialElements( semiLatusRectumIndex ), 1.2e7 );
+        BOOST_CHECK_SMALL( ( convertModifiedEquinoctialToKeplerianElements(
+                                 parabolicModifiedEquinoctialElements )
+                             - parabolicKeplerianElements ).cwiseQuotient(
+                               parabolicKeplerianElements ).cwiseAbs( ).maxCoeff( ), 1.0e-14 );
+    }
+}
+
+//! Test if conversions between Cartesian and modified equinoctial elements are correct.
+BOOST_AUTO_TEST_CASE( testCartesianModifiedEquinoctialElementConversions )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Case 1: Conversion from Cartesian elements should match conversion from Keplerian
+    // elements, for elliptical and hyperbolic orbits.
+    {
+        Eigen::MatrixXd keplerianElements( 6, 3 );
+        keplerianElements.col( 0 ) << 8.0e6, 0.2, 1.0, 0.8, 2.5, 3.5;
+        keplerianElements.col( 1 ) << 2.65e7, 0.74, 1.1, 4.7, 0.8, 2.9;
+        keplerianElements.col( 2 ) << -2.0e7, 1.5, 2.0, 5.0, 4.0, 0.5;
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            const Vector6d cartesianElements = convertKeplerianToCartesianElements(
+                        Vector6d( keplerianElements.col( i ) ), earthGravitationalParameter );
+            const Vector6d expectedModifiedEquinoctialElements
+                    = convertKeplerianToModifiedEquinoctialElements( keplerianElements.col( i ) );
+            const Vector6d computedModifiedEquinoctialElements
+                    = convertCartesianToModifiedEquinoctialElements(
+                        cartesianElements, earthGravitationalParameter );
+
+            BOOST_CHECK_SMALL( ( computedModifiedEquinoctialElements
+                                 - expectedModifiedEquinoctialElements ).cwiseQuotient(
+                                   expectedModifiedEquinoctialElements ).cwiseAbs( ).maxCoeff( ),
+                               1.0e-12 );
+
+            // Check if Cartesian elements are recovered.
+            const Vector6d recoveredCartesianElements
+                    = convertModifiedEquinoctialToCartesianElements(
+                        computedModifiedEquinoctialElements, earthGravitationalParameter );
+            BOOST_CHECK_SMALL( ( recoveredCartesianElements - cartesianElements ).segment( 0, 3 )
+                               .norm( ) / cartesianElements.segment( 0, 3 ).norm( ), 1.0e-14 );
+            BOOST_CHECK_SMALL( ( recoveredCartesianElements - cartesianElements ).segment( 3, 3 )
+                               .norm( ) / cartesianElements.segment( 3, 3 ).norm( ), 1.0e-14 );
+        }
+    }
+
+    // Case 2: Circular equatorial orbit, for which the Keplerian angles are undefined.
+    {
+        const double radius = 4.2164e7;
+        const double circularVelocity = std::sqrt( earthGravitationalParameter / radius );
+        Vector6d cartesianElements;
+        cartesianElements << radius * std::cos( 0.3 ), radius * std::sin( 0.3 ), 0.0,
+                -circularVelocity * std::sin( 0.3 ), circularVelocity * std::cos( 0.3 ), 0.0;
+
+        const Vector6d computedModifiedEquinoctialElements
+                = convertCartesianToModifiedEquinoctialElements( cartesianElements,
+                                                                 earthGravitationalParameter );
+
+        BOOST_CHECK_CLOSE_FRACTION( computedModifiedEquinoctialElements( semiLatusRectumIndex ),
+                                    radius, 1.0e-14 );
+        BOOST_CHECK_SMALL( computedModifiedEquinoctialElements.segment( 1, 4 ).norm( ),
+                           1.0e-15 );
+        BOOST_CHECK_CLOSE_FRACTION( computedModifiedEquinoctialElements( trueLongitudeIndex ),
+                                    0.3, 1.0e-14 );
+
+        const Vector6d recoveredCartesianElements = convertModifiedEquinoctialToCartesianElements(
+                    computedModifiedEquinoctialElements, earthGravitationalParameter );
+        BOOST_CHECK_SMALL( ( recoveredCartesianElements - cartesianElements ).segment( 0, 3 )
+                           .norm( ), 1.0e-14 * radius );
+        BOOST_CHECK_SMALL( ( recoveredCartesianElements - cartesianElements ).segment( 3, 3 )
+                           .norm( ), 1.0e-14 * circularVelocity );
+
+        // Check if conversion to Keplerian elements sets the undefined angles to zero.
+        const Vector6d keplerianElements = convertModifiedEquinoctialToKeplerianElements(
+                    computedModifiedEquinoctialElements );
+        BOOST_CHECK_EQUAL( keplerianElements( argumentOfPeriapsisIndex ), 0.0 );
+        BOOST_CHECK_EQUAL( keplerianElements( longitudeOfAscendingNodeIndex ), 0.0 );
+        BOOST_CHECK_CLOSE_FRACTION( keplerianElements( trueAnomalyIndex ), 0.3, 1.0e-14 );
+    }
+}
+
+//! Test if modified equinoctial element conversions for sets of orbits are correct.
+BOOST_AUTO_TEST_CASE( testBatchModifiedEquinoctialElementConversions )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set set of elliptical orbits [m,-,rad,rad,rad,rad].
+    const int numberOfOrbits = 257;
+    Eigen::MatrixXd keplerianElements( 6, numberOfOrbits );
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        keplerianElements.col( i ) << 7.0e6 + 1.0e5 * ( i % 37 ), 0.9 * ( i % 11 ) / 10.0,
+                PI * ( i % 13 ) / 13.0, 0.1 * ( i % 61 ), 0.1 * ( i % 67 ), 0.2 * ( i % 29 );
+    }
+
+    // Convert elements for set of orbits, using multiple threads.
+    Eigen::MatrixXd modifiedEquinoctialElements;
+    convertKeplerianToModifiedEquinoctialElements( keplerianElements,
+                                                   modifiedEquinoctialElements, 4 );
+    Eigen::MatrixXd recoveredKeplerianElements;
+    convertModifiedEquinoctialToKeplerianElements( modifiedEquinoctialElements,
+                                                   recoveredKeplerianElements, 4 );
+    Eigen::MatrixXd cartesianElements;
+    convertModifiedEquinoctialToCartesianElements( modifiedEquinoctialElements,
+                                                   earthGravitationalParameter,
+                                                   cartesianElements, 4 );
+    Eigen::MatrixXd recoveredModifiedEquinoctialElements;
+    convertCartesianToModifiedEquinoctialElements( cartesianElements, earthGravitationalParameter,
+                                                   recoveredModifiedEquinoctialElements, 4 );
+
+    BOOST_CHECK_EQUAL( modifiedEquinoctialElements.cols( ), numberOfOrbits );
+    BOOST_CHECK_EQUAL( cartesianElements.cols( ), numberOfOrbits );
+
+    // Check if results match the single-orbit conversions.
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        BOOST_CHECK( Vector6d( modifiedEquinoctialElements.col( i ) )
+                     == convertKeplerianToModifiedEquinoctialElements(
+                         keplerianElements.col( i ) ) );
+        BOOST_CHECK( Vector6d( recoveredKeplerianElements.col( i ) )
+                     == convertModifiedEquinoctialToKeplerianElements(
+                         modifiedEquinoctialElements.col( i ) ) );
+        BOOST_CHECK( Vector6d( cartesianElements.col( i ) )
+                     == convertModifiedEquinoctialToCartesianElements(
+                         modifiedEquinoctialElements.col( i ), earthGravitationalParameter ) );
+        BOOST_CHECK( Vector6d( recoveredModifiedEquinoctialElements.col( i ) )
+                     == convertCartesianToModifiedEquinoctialElements(
+                         cartesianElements.col( i ), earthGravitationalParameter ) );
+    }
+
+    // Check if an error is thrown for an elements matrix with the wrong number of rows.
+    BOOST_CHECK_THROW( convertKeplerianToModifiedEquinoctialElements(
+                           Eigen::MatrixXd::Zero( 5, 3 ), modifiedEquinoctialElements ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,258 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *      The partials are verified against central finite differences of the element conversions,
+ *      and by checking that the product of the partials in both directions is the identity matrix.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversionPartials.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Get Keplerian elements of test orbits for partials.
+/*!
+ * Returns Keplerian elements of a set of elliptical and hyperbolic test orbits, which are not
+ * circular or equatorial, such that all partials are defined [m,-,rad,rad,rad,rad].
+ * \return Matrix of Keplerian elements of test orbits (6 x 4).
+ */
+Eigen::MatrixXd getKeplerianElementsOfPartialsTestOrbits( )
+{
+    Eigen::MatrixXd keplerianElements( 6, 4 );
+    keplerianElements.col( 0 ) << 7.5e6, 0.1, 0.9, 1.3, 2.2, 0.6;
+    keplerianElements.col( 1 ) << 2.65e7, 0.74, 1.1, 4.7, 0.8, 2.9;
+    keplerianElements.col( 2 ) << 4.2e7, 0.01, 2.8, 0.3, 5.5, 4.1;
+    keplerianElements.col( 3 ) << -2.0e7, 1.6, 0.4, 2.5, 1.0, -0.9;
+    return keplerianElements;
+}
+
+BOOST_AUTO_TEST_SUITE( test_orbital_element_conversion_partials )
+
+//! Test if partials of Cartesian w.r.t. Keplerian elements are computed correctly.
+BOOST_AUTO_TEST_CASE( testPartialsOfCartesianWrtKeplerianElements )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    const Eigen::MatrixXd keplerianElements = getKeplerianElementsOfPartialsTestOrbits( );
+
+    for ( int orbitIndex = 0; orbitIndex < keplerianElements.cols( ); orbitIndex++ )
+    {
+        const Vector6d orbitElements = keplerianElements.col( orbitIndex );
+
+        // Compute partials analytically.
+        const Matrix6d computedPartials = computePartialsOfCartesianWrtKeplerianElements(
+                    orbitElements, earthGravitationalParameter );
+
+        // Compute partials by central differences, with the semi-major axis perturbation relative
+        // to the semi-major axis.
+        for ( int elementIndex = 0; elementIndex < 6; elementIndex++ )
+        {
+            const double perturbation = ( elementIndex == semiMajorAxisIndex )
+                    ? 1.0e-6 * std::fabs( orbitElements( semiMajorAxisIndex ) ) : 1.0e-6;
+
+            Vector6d perturbedElements = orbitElements;
+            perturbedElements( elementIndex ) += perturbation;
+            const Vector6d upperCartesianElements = convertKeplerianToCartesianElements(
+                        perturbedElements, earthGravitationalParameter );
+            perturbedElements( elementIndex ) -= 2.0 * perturbation;
+            const Vector6d lowerCartesianElements = convertKeplerianToCartesianElements(
+                        perturbedElements, earthGravitationalParameter );
+
+            const Vector6d expectedPartials = ( upperCartesianElements - lowerCartesianElements )
+                    / ( 2.0 * perturbation );
+
+            // Check position and velocity partials, relative to their magnitude.
+            const Vector6d computedColumn = computedPartials.col( elementIndex );
+            BOOST_CHECK_SMALL( ( computedColumn.segment( 0, 3 )
+                                 - expectedPartials.segment( 0, 3 ) ).norm( )
+                               / expectedPartials.segment( 0, 3 ).norm( ), 1.0e-7 );
+            BOOST_CHECK_SMALL( ( computedColumn.segment( 3, 3 )
+                                 - expectedPartials.segment( 3, 3 ) ).norm( )
+                               / expectedPartials.segment( 3, 3 ).norm( ), 1.0e-7 );
+        }
+    }
+
+    // Check if an error is thrown for parabolic orbits and negative eccentricity.
+    Vector6d invalidElements = keplerianElements.col( 0 );
+    invalidElements( eccentricityIndex ) = 1.0;
+    BOOST_CHECK_THROW( computePartialsOfCartesianWrtKeplerianElements(
+                           invalidElements, earthGravitationalParameter ), std::runtime_error );
+    invalidElements( eccentricityIndex ) = -0.1;
+    BOOST_CHECK_THROW( computePartialsOfCartesianWrtKeplerianElements(
+                           invalidElements, earthGravitationalParameter ), std::runtime_error );
+}
+
+//! Test if partials of Keplerian w.r.t. Cartesian elements are computed correctly.
+BOOST_AUTO_TEST_CASE( testPartialsOfKeplerianWrtCartesianElements )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    const Eigen::MatrixXd keplerianElements = getKeplerianElementsOfPartialsTestOrbits( );
+
+    for ( int orbitIndex = 0; orbitIndex < keplerianElements.cols( ); orbitIndex++ )
+    {
+        const Vector6d cartesianElements = convertKeplerianToCartesianElements(
+                    Vector6d( keplerianElements.col( orbitIndex ) ),
+                    earthGravitationalParameter );
+
+        // Compute partials analytically.
+        const Matrix6d computedPartials = computePartialsOfKeplerianWrtCartesianElements(
+                    cartesianElements, earthGravitationalParameter );
+
+        // Check if partials are the inverse of the partials in the other direction. The product
+        // is made non-dimensional by scaling the semi-major axis with its own magnitude.
+        Vector6d elementScales = Vector6d::Ones( );
+        elementScales( semiMajorAxisIndex )
+                = std::fabs( keplerianElements( semiMajorAxisIndex, orbitIndex ) );
+        const Matrix6d product = elementScales.cwiseInverse( ).asDiagonal( )
+                * computedPartials * computePartialsOfCartesianWrtKeplerianElements(
+                    keplerianElements.col( orbitIndex ), earthGravitationalParameter )
+                * elementScales.asDiagonal( );
+        BOOST_CHECK_SMALL( ( product - Matrix6d::Identity( ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0e-10 );
+
+        // Compute partials by central differences, with perturbations relative to the norm of
+        // the position and velocity, respectively.
+        for ( int elementIndex = 0; elementIndex < 6; elementIndex++ )
+        {
+            const double perturbation = 1.0e-6 * ( ( elementIndex < 3 )
+                                                   ? cartesianElements.segment( 0, 3 ).norm( )
+                                                   : cartesianElements.segment( 3, 3 ).norm( ) );
+
+            Vector6d perturbedElements = cartesianElements;
+            perturbedElements( elementIndex ) += perturbation;
+            const Vector6d upperKeplerianElements = convertCartesianToKeplerianElements(
+                        perturbedElements, earthGravitationalParameter );
+            perturbedElements( elementIndex ) -= 2.0 * perturbation;
+            const Vector6d lowerKeplerianElements = convertCartesianToKeplerianElements(
+                        perturbedElements, earthGravitationalParameter );
+
+            Vector6d differences = upperKeplerianElements - lowerKeplerianElements;
+
+            // Wrap differences of angles to [-pi, pi].
+            for ( int angleIndex = inclinationIndex; angleIndex <= trueAnomalyIndex; angleIndex++ )
+            {
+                differences( angleIndex ) = std::atan2( std::sin( differences( angleIndex ) ),
+                                                        std::cos( differences( angleIndex ) ) );
+            }
+
+            const Vector6d expectedPartials = differences / ( 2.0 * perturbation );
+
+            // Check partials, relative to the largest partial of each element with respect to
+            // the position or velocity.
+            for ( int keplerianIndex = 0; keplerianIndex < 6; keplerianIndex++ )
+            {
+                const double scale = ( elementIndex < 3 )
+                        ? computedPartials.block( keplerianIndex, 0, 1, 3 ).norm( )
+                        : computedPartials.block( keplerianIndex, 3, 1, 3 ).norm( );
+                BOOST_CHECK_SMALL( ( computedPartials( keplerianIndex, elementIndex )
+                                     - expectedPartials( keplerianIndex ) ) / scale, 1.0e-6 );
+            }
+        }
+    }
+}
+
+//! Test if partials for sets of orbits are computed correctly.
+BOOST_AUTO_TEST_CASE( testBatchPartialsComputation )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set set of orbits, by repeating the test orbits with varying true anomaly.
+    const Eigen::MatrixXd testElements = getKeplerianElementsOfPartialsTestOrbits( );
+    const int numberOfOrbits = 301;
+    Eigen::MatrixXd keplerianElements( 6, numberOfOrbits );
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        keplerianElements.col( i ) = testElements.col( i % 4 );
+        keplerianElements( trueAnomalyIndex, i ) = 0.6 * std::sin( 0.37 * i );
+    }
+
+    Eigen::MatrixXd cartesianElements;
+    convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter,
+                                         cartesianElements );
+
+    // Compute partials for set of orbits, using multiple threads and a single thread.
+    Eigen::MatrixXd cartesianPartials;
+    computePartialsOfCartesianWrtKeplerianElements(
+                keplerianElements, earthGravitationalParameter, cartesianPartials, 4 );
+    Eigen::MatrixXd keplerianPartials;
+    computePartialsOfKeplerianWrtCartesianElements(
+                cartesianElements, earthGravitationalParameter, keplerianPartials, 4 );
+    Eigen::MatrixXd keplerianPartialsSingleThread;
+    computePartialsOfKeplerianWrtCartesianElements(
+                cartesianElements, earthGravitationalParameter, keplerianPartialsSingleThread, 1 );
+
+    BOOST_CHECK_EQUAL( cartesianPartials.rows( ), 6 );
+    BOOST_CHECK_EQUAL( cartesianPartials.cols( ), 6 * numberOfOrbits );
+    BOOST_CHECK( keplerianPartials == keplerianPartialsSingleThread );
+
+    // Check if partials match the single-orbit functions.
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        const Matrix6d expectedCartesianPartials = computePartialsOfCartesianWrtKeplerianElements(
+                    keplerianElements.col( i ), earthGravitationalParameter );
+        const Matrix6d expectedKeplerianPartials = computePartialsOfKeplerianWrtCartesianElements(
+                    cartesianElements.col( i ), earthGravitationalParameter );
+
+        BOOST_CHECK( cartesianPartials.block( 0, 6 * i, 6, 6 ) == expectedCartesianPartials );
+        BOOST_CHECK( keplerianPartials.block( 0, 6 * i, 6, 6 ) == expectedKeplerianPartials );
+    }
+
+    // Check if an error is thrown for an elements matrix with the wrong number of rows.
+    BOOST_CHECK_THROW( computePartialsOfCartesianWrtKeplerianElements(
+                           Eigen::MatrixXd::Zero( 5, 3 ), earthGravitationalParameter,
+                           cartesianPartials ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
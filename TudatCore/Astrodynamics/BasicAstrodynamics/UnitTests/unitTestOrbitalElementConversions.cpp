@@ -92,9 +92,12 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <stdexcept>
 
+#include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -703,6 +706,297 @@ BOOST_AUTO_TEST_CASE( testCartesianToKeplerianElementConversion )
     }
 }
 
+//! Get Keplerian elements of set of test orbits.
+/*!
+ * Returns the Keplerian elements of a set of elliptical, parabolic and hyperbolic orbits around
+ * the Earth, used to test the batch orbital element conversions.
+ * \param numberOfOrbits Number of orbits; should not be a multiple of the internal block size, to
+ *          test the handling of partial blocks.
+ * \return Keplerian elements of test orbits (6 x N).
+ */
+Eigen::MatrixXd getKeplerianElementsOfTestOrbits( const int numberOfOrbits )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    Eigen::MatrixXd keplerianElements( 6, numberOfOrbits );
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        const double eccentricity = 3.0 * static_cast< double >( i % 100 ) / 99.0;
+
+        // Semi-major axis (semi-latus rectum for parabolic orbit) is negative for hyperbolic
+        // orbits; true anomaly is limited to within the asymptotes for hyperbolic orbits.
+        double semiMajorAxis = 7.0e6 + 100.0e3 * static_cast< double >( i % 37 );
+        double maximumTrueAnomaly = PI;
+        if ( eccentricity > 1.0 )
+        {
+            semiMajorAxis = -semiMajorAxis;
+            maximumTrueAnomaly = 0.9 * std::acos( -1.0 / eccentricity );
+        }
+
+        keplerianElements( semiMajorAxisIndex, i ) = semiMajorAxis;
+        keplerianElements( eccentricityIndex, i ) = eccentricity;
+        keplerianElements( inclinationIndex, i ) = PI * static_cast< double >( i % 13 ) / 12.0;
+        keplerianElements( argumentOfPeriapsisIndex, i ) = 0.1 * static_cast< double >( i % 61 );
+        keplerianElements( longitudeOfAscendingNodeIndex, i )
+                = -0.1 * static_cast< double >( i % 67 );
+        keplerianElements( trueAnomalyIndex, i )
+                = maximumTrueAnomaly * std::sin( 0.37 * static_cast< double >( i ) );
+    }
+
+    return keplerianElements;
+}
+
+//! Test if batch conversion from Keplerian to Cartesian elements is working correctly.
+BOOST_AUTO_TEST_CASE( testBatchKeplerianToCartesianElementConversion )
+{
+    // Using declarations.
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Earth gravitational parameter [m^3 s^-2].
+    const double earthGravitationalParameter = 3.9859383624e14;
+
+    // Set Keplerian elements of set of orbits.
+    const int numberOfOrbits = 1001;
+    const Eigen::MatrixXd keplerianElements = getKeplerianElementsOfTestOrbits( numberOfOrbits );
+
+    // Case 1: Batch conversion compared to single-orbit conversion.
+    {
+        // Convert Keplerian elements to Cartesian elements.
+        Eigen::MatrixXd computedCartesianElements;
+        convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter,
+                                             computedCartesianElements, 1 );
+
+        BOOST_CHECK_EQUAL( computedCartesianElements.rows( ), 6 );
+        BOOST_CHECK_EQUAL( computedCartesianElements.cols( ), numberOfOrbits );
+
+        // Check that computed Cartesian elements match single-orbit conversion.
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            const Eigen::VectorXd expectedCartesianElements
+                    = convertKeplerianToCartesianElements(
+                        Eigen::VectorXd( keplerianElements.col( i ) ),
+                        earthGravitationalParameter );
+
+            const double positionTolerance
+                    = 1.0e-14 * expectedCartesianElements.segment( 0, 3 ).norm( );
+            const double velocityTolerance
+                    = 1.0e-14 * expectedCartesianElements.segment( 3, 3 ).norm( );
+            BOOST_CHECK_SMALL( ( expectedCartesianElements.segment( 0, 3 )
+                                 - computedCartesianElements.block( 0, i, 3, 1 ) ).norm( ),
+                               positionTolerance );
+            BOOST_CHECK_SMALL( ( expectedCartesianElements.segment( 3, 3 )
+                                 - computedCartesianElements.block( 3, i, 3, 1 ) ).norm( ),
+                               velocityTolerance );
+        }
+    }
+
+    // Case 2: Multi-threaded batch conversion compared to single-threaded batch conversion.
+    {
+        // Convert Keplerian elements to Cartesian elements, using one and multiple threads.
+        Eigen::MatrixXd singleThreadCartesianElements;
+        convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter,
+                                             singleThreadCartesianElements, 1 );
+
+        Eigen::MatrixXd multiThreadCartesianElements = Eigen::MatrixXd::Zero( 6, numberOfOrbits );
+        convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter,
+                                             multiThreadCartesianElements, 4 );
+
+        // Check that results are identical.
+        BOOST_CHECK( singleThreadCartesianElements == multiThreadCartesianElements );
+    }
+
+    // Case 3: Input matrix with incorrect number of rows.
+    {
+        Eigen::MatrixXd cartesianElements;
+        BOOST_CHECK_THROW( convertKeplerianToCartesianElements(
+                               Eigen::MatrixXd::Zero( 5, 10 ), earthGravitationalParameter,
+                               cartesianElements ), std::runtime_error );
+    }
+}
+
+//! Test if batch conversion from Cartesian to Keplerian elements is working correctly.
+BOOST_AUTO_TEST_CASE( testBatchCartesianToKeplerianElementConversion )
+{
+    // Using declarations.
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Earth gravitational parameter [m^3 s^-2].
+    const double earthGravitationalParameter = 3.9859383624e14;
+
+    // Case 1: Elliptical orbit around the Earth.
+    // The benchmark data is obtained by running ODTBX (NASA, 2012).
+    {
+        // Set Cartesian elements.
+        Eigen::MatrixXd cartesianElements( 6, 1 );
+        cartesianElements << 3.75e6, 4.24e6, -1.39e6, -4.65e3, -2.21e3, 1.66e3;
+
+        // Set expected Keplerian elements.
+        Eigen::MatrixXd expectedKeplerianElements( 6, 1 );
+        expectedKeplerianElements << 3.707478199246163e6, 0.949175203660321, 0.334622356632438,
+                2.168430616511167, 1.630852596545341, 3.302032232567084;
+
+        // Compute Keplerian elements.
+        Eigen::MatrixXd computedKeplerianElements;
+        convertCartesianToKeplerianElements( cartesianElements, 3.986004415e14,
+                                             computedKeplerianElements );
+
+        // Check if computed Keplerian elements match the expected values.
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedKeplerianElements,
+                                           computedKeplerianElements, 1.0e-14 );
+    }
+
+    // Case 2: Limit cases compared to single-orbit conversion: circular equatorial, circular
+    // inclined, non-circular equatorial and parabolic orbits.
+    {
+        // Set Keplerian elements of limit cases.
+        Eigen::MatrixXd keplerianElements( 6, 4 );
+        keplerianElements << 8.0e6, 8.0e6, 8.0e6, 9.0e6,
+                0.0, 0.0, 0.2, 1.0,
+                0.0, 0.4, 0.0, 0.7,
+                0.0, 0.0, 4.2, 1.1,
+                0.0, 2.3, 0.0, 5.1,
+                2.1, 4.4, 1.2, -1.3;
+
+        // Compute Cartesian elements.
+        Eigen::MatrixXd cartesianElements;
+        convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter,
+                                             cartesianElements );
+
+        // Compute Keplerian elements with batch conversion.
+        Eigen::MatrixXd computedKeplerianElements;
+        convertCartesianToKeplerianElements( cartesianElements, earthGravitationalParameter,
+                                             computedKeplerianElements );
+
+        // Check if computed Keplerian elements match single-orbit conversion.
+        for ( int i = 0; i < keplerianElements.cols( ); i++ )
+        {
+            const Eigen::VectorXd expectedKeplerianElements
+                    = convertCartesianToKeplerianElements(
+                        Eigen::VectorXd( cartesianElements.col( i ) ),
+                        earthGravitationalParameter );
+
+            BOOST_CHECK_CLOSE_FRACTION( expectedKeplerianElements( semiMajorAxisIndex ),
+                                        computedKeplerianElements( semiMajorAxisIndex, i ),
+                                        1.0e-14 );
+            BOOST_CHECK_SMALL( expectedKeplerianElements( eccentricityIndex )
+                               - computedKeplerianElements( eccentricityIndex, i ), 1.0e-15 );
+
+            // Check angles, allowing for wrapping around 2 pi.
+            for ( int j = inclinationIndex; j <= trueAnomalyIndex; j++ )
+            {
+                BOOST_CHECK_SMALL( std::sin( 0.5 * ( expectedKeplerianElements( j )
+                                                     - computedKeplerianElements( j, i ) ) ),
+                                   1.0e-13 );
+            }
+        }
+    }
+
+    // Case 3: Batch conversion from Cartesian elements, and back, for elliptical, parabolic and
+    // hyperbolic orbits.
+    {
+        // Compute Cartesian elements of set of orbits.
+        const int numberOfOrbits = 1001;
+        const Eigen::MatrixXd keplerianElements
+                = getKeplerianElementsOfTestOrbits( numberOfOrbits );
+        Eigen::MatrixXd cartesianElements;
+        convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter,
+                                             cartesianElements );
+
+        // Convert Cartesian elements to Keplerian elements, and back.
+        Eigen::MatrixXd computedKeplerianElements;
+        convertCartesianToKeplerianElements( cartesianElements, earthGravitationalParameter,
+                                             computedKeplerianElements, 1 );
+
+        Eigen::MatrixXd recomputedCartesianElements;
+        convertKeplerianToCartesianElements( computedKeplerianElements,
+                                             earthGravitationalParameter,
+                                             recomputedCartesianElements, 1 );
+
+        // Check that recomputed Cartesian elements match the input values. Parabolic orbits are
+        // skipped, since the recomputed eccentricity is only equal to 1.0 to within the tolerance
+        // of the Cartesian to Keplerian conversion, which is larger than that of the Keplerian to
+        // Cartesian conversion; these are tested against the single-orbit conversion above.
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            if ( keplerianElements( eccentricityIndex, i ) == 1.0 )
+            {
+                continue;
+            }
+
+            const double positionTolerance
+                    = 1.0e-13 * cartesianElements.block( 0, i, 3, 1 ).norm( );
+            const double velocityTolerance
+                    = 1.0e-13 * cartesianElements.block( 3, i, 3, 1 ).norm( );
+            BOOST_CHECK_SMALL( ( cartesianElements.block( 0, i, 3, 1 )
+                                 - recomputedCartesianElements.block( 0, i, 3, 1 ) ).norm( ),
+                               positionTolerance );
+            BOOST_CHECK_SMALL( ( cartesianElements.block( 3, i, 3, 1 )
+                                 - recomputedCartesianElements.block( 3, i, 3, 1 ) ).norm( ),
+                               velocityTolerance );
+        }
+
+        // Check that multi-threaded conversion gives identical results.
+        Eigen::MatrixXd multiThreadKeplerianElements;
+        convertCartesianToKeplerianElements( cartesianElements, earthGravitationalParameter,
+                                             multiThreadKeplerianElements, 4 );
+        BOOST_CHECK( computedKeplerianElements == multiThreadKeplerianElements );
+    }
+
+    // Case 4: Input matrix with incorrect number of rows.
+    {
+        Eigen::MatrixXd keplerianElements;
+        BOOST_CHECK_THROW( convertCartesianToKeplerianElements(
+                               Eigen::MatrixXd::Zero( 7, 10 ), earthGravitationalParameter,
+                               keplerianElements ), std::runtime_error );
+    }
+}
+
+//! Test if fixed-size and dynamic-size element conversions give identical results.
+BOOST_AUTO_TEST_CASE( testFixedSizeElementConversions )
+{
+    // Using declarations.
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Earth gravitational parameter [m^3 s^-2].
+    const double earthGravitationalParameter = 3.9859383624e14;
+
+    // Set Keplerian elements of set of orbits.
+    const Eigen::MatrixXd keplerianElements = getKeplerianElementsOfTestOrbits( 100 );
+
+    for ( int i = 0; i < keplerianElements.cols( ); i++ )
+    {
+        // Case 1: Keplerian to Cartesian conversion, with dynamic-size vector, fixed-size vector
+        // and matrix column as input.
+        const Eigen::VectorXd dynamicCartesianElements = convertKeplerianToCartesianElements(
+                    Eigen::VectorXd( keplerianElements.col( i ) ), earthGravitationalParameter );
+        const Vector6d fixedCartesianElements = convertKeplerianToCartesianElements(
+                    Vector6d( keplerianElements.col( i ) ), earthGravitationalParameter );
+        const Vector6d expressionCartesianElements = convertKeplerianToCartesianElements(
+                    keplerianElements.col( i ), earthGravitationalParameter );
+
+        BOOST_CHECK( dynamicCartesianElements == fixedCartesianElements );
+        BOOST_CHECK( expressionCartesianElements == fixedCartesianElements );
+
+        // Case 2: Cartesian to Keplerian conversion, with dynamic-size vector, fixed-size vector
+        // and vector expression as input.
+        const Eigen::VectorXd dynamicKeplerianElements = convertCartesianToKeplerianElements(
+                    dynamicCartesianElements, earthGravitationalParameter );
+        const Vector6d fixedKeplerianElements = convertCartesianToKeplerianElements(
+                    fixedCartesianElements, earthGravitationalParameter );
+        const Vector6d expressionKeplerianElements = convertCartesianToKeplerianElements(
+                    1.0 * fixedCartesianElements, earthGravitationalParameter );
+
+        // Check that elements are identical; this includes elements that are NaN, which can
+        // occur due to rounding in the arguments of acos in the single-orbit conversion.
+        BOOST_CHECK( ( dynamicKeplerianElements.array( ) == fixedKeplerianElements.array( )
+                       || ( dynamicKeplerianElements.array( ).isNaN( )
+                            && fixedKeplerianElements.array( ).isNaN( ) ) ).all( ) );
+        BOOST_CHECK( ( expressionKeplerianElements.array( ) == fixedKeplerianElements.array( )
+                       || ( expressionKeplerianElements.array( ).isNaN( )
+                            && fixedKeplerianElements.array( ).isNaN( ) ) ).all( ) );
+    }
+}
+
 //! Test if conversion from true anomaly to eccentric anomaly is working correctly.
 BOOST_AUTO_TEST_CASE( testTrueAnomalyToEccentricAnomalyConversion )
 {
@@ -1116,6 +1410,366 @@ BOOST_AUTO_TEST_CASE( testEccentricAnomalyToMeanAnomalyConversion )
     }
 }
 
+//! Test if conversion from mean anomaly to eccentric anomaly is working correctly.
+BOOST_AUTO_TEST_CASE( testMeanAnomalyToEccentricAnomalyConversion )
+{
+    // Case 1: General elliptical orbit.
+    // The benchmark data is obtained from (Vallado, 2004), Example 2-1.
+    {
+        // Set eccentricity.
+        const double eccentricity = 0.4;
+
+        // Set mean anomaly.
+        const double meanAnomaly = 235.4 / 180.0 * PI;
+
+        // Set expected elliptical eccentric anomaly.
+        const double expectedEllipticalEccentricAnomaly = 220.512074767522 / 180.0 * PI;
+
+        // Compute elliptical eccentric anomaly.
+        const double computedEllipticalEccentricAnomaly
+                = tudat::basic_astrodynamics::orbital_element_conversions
+                ::convertMeanAnomalyToEllipticalEccentricAnomaly( meanAnomaly, eccentricity );
+
+        // Check if computed elliptical eccentric anomaly matches the expected value.
+        BOOST_CHECK_CLOSE_FRACTION( expectedEllipticalEccentricAnomaly,
+                                    computedEllipticalEccentricAnomaly, 1.0e-13 );
+    }
+
+    // Case 2: General hyperbolic orbit.
+    // The benchmark data is obtained from (Vallado, 2004), Example 2-3.
+    {
+        // Set eccentricity.
+        const double eccentricity = 2.4;
+
+        // Set hyperbolic mean anomaly.
+        const double hyperbolicMeanAnomaly = 235.4 / 180.0 * PI;
+
+        // Set expected hyperbolic eccentric anomaly.
+        const double expectedHyperbolicEccentricAnomaly = 1.6013761449;
+
+        // Compute hyperbolic eccentric anomaly.
+        const double computedHyperbolicEccentricAnomaly
+                = tudat::basic_astrodynamics::orbital_element_conversions
+                ::convertMeanAnomalyToHyperbolicEccentricAnomaly( hyperbolicMeanAnomaly,
+                                                                  eccentricity );
+
+        // Check if computed hyperbolic eccentric anomaly matches the expected value.
+        BOOST_CHECK_CLOSE_FRACTION( expectedHyperbolicEccentricAnomaly,
+                                    computedHyperbolicEccentricAnomaly, 1.0e-10 );
+    }
+
+    // Case 3: Elliptical orbits, including eccentricities close to 1.0 and multiple revolutions.
+    // This test is based on converting the computed eccentric anomaly back to mean anomaly.
+    {
+        using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+        // Set eccentricities and mean anomalies to test.
+        const double eccentricities[ 7 ] = { 0.0, 1.0e-8, 0.3, 0.8, 0.99, 0.999999,
+                                             1.0 - 1.0e-12 };
+        const double meanAnomalies[ 9 ] = { 0.0, 1.0e-10, 1.0e-6, 1.0e-3, 0.5, PI - 1.0e-12,
+                                            -2.0, 7.5, -25.0 };
+
+        for ( unsigned int i = 0; i < 7; i++ )
+        {
+            for ( unsigned int j = 0; j < 9; j++ )
+            {
+                // Compute elliptical eccentric anomaly.
+                const double computedEllipticalEccentricAnomaly
+                        = convertMeanAnomalyToEllipticalEccentricAnomaly( meanAnomalies[ j ],
+                                                                          eccentricities[ i ] );
+
+                // Recompute mean anomaly.
+                const double recomputedMeanAnomaly
+                        = convertEllipticalEccentricAnomalyToMeanAnomaly(
+                            computedEllipticalEccentricAnomaly, eccentricities[ i ] );
+
+                // Check if recomputed mean anomaly matches the input value.
+                BOOST_CHECK_SMALL( recomputedMeanAnomaly - meanAnomalies[ j ],
+                                   1.0e-15 * std::max( 1.0, std::fabs( meanAnomalies[ j ] ) ) );
+            }
+        }
+    }
+
+    // Case 4: Hyperbolic orbits, including eccentricities close to 1.0 and high eccentricities.
+    // This test is based on converting the computed eccentric anomaly back to mean anomaly.
+    {
+        using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+        // Set eccentricities and mean anomalies to test.
+        const double eccentricities[ 7 ] = { 1.0 + 1.0e-12, 1.0 + 1.0e-6, 1.01, 1.5, 3.0, 100.0,
+                                             1.0e4 };
+        const double meanAnomalies[ 8 ] = { 0.0, 1.0e-10, 1.0e-4, 0.5, -3.0, 50.0, -1.0e3,
+                                            1.0e6 };
+
+        for ( unsigned int i = 0; i < 7; i++ )
+        {
+            for ( unsigned int j = 0; j < 8; j++ )
+            {
+                // Compute hyperbolic eccentric anomaly.
+                const double computedHyperbolicEccentricAnomaly
+                        = convertMeanAnomalyToHyperbolicEccentricAnomaly( meanAnomalies[ j ],
+                                                                          eccentricities[ i ] );
+
+                // Recompute mean anomaly.
+                const double recomputedMeanAnomaly
+                        = convertHyperbolicEccentricAnomalyToMeanAnomaly(
+                            computedHyperbolicEccentricAnomaly, eccentricities[ i ] );
+
+                // Check if recomputed mean anomaly matches the input value.
+                BOOST_CHECK_SMALL( recomputedMeanAnomaly - meanAnomalies[ j ],
+                                   1.0e-14 * std::max( 1.0, std::fabs( meanAnomalies[ j ] ) ) );
+            }
+        }
+    }
+
+    // Case 5: Mixed elliptical and hyperbolic orbits, using the vector interface.
+    {
+        using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+        // Set eccentricities and mean anomalies.
+        Eigen::VectorXd eccentricities( 4 );
+        eccentricities << 0.1, 0.95, 1.2, 4.5;
+        Eigen::VectorXd meanAnomalies( 4 );
+        meanAnomalies << 1.2, -0.02, 3.4, -12.0;
+
+        // Compute eccentric anomalies.
+        const Eigen::VectorXd computedEccentricAnomalies
+                = convertMeanAnomalyToEccentricAnomaly( meanAnomalies, eccentricities );
+
+        // Check if computed eccentric anomalies match the values from the scalar function.
+        for ( int i = 0; i < 4; i++ )
+        {
+            BOOST_CHECK_EQUAL( convertMeanAnomalyToEccentricAnomaly( meanAnomalies( i ),
+                                                                     eccentricities( i ) ),
+                               computedEccentricAnomalies( i ) );
+        }
+    }
+
+    // Case 6: Invalid input and non-convergence.
+    {
+        using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+        // Check if an error is thrown for parabolic and negative eccentricity.
+        BOOST_CHECK_THROW( convertMeanAnomalyToEccentricAnomaly( 1.0, 1.0 ),
+                           std::runtime_error );
+        BOOST_CHECK_THROW( convertMeanAnomalyToEccentricAnomaly( 1.0, -0.1 ),
+                           std::runtime_error );
+
+        // Check if an error is thrown if the iteration has not converged.
+        BOOST_CHECK_THROW( convertMeanAnomalyToEllipticalEccentricAnomaly( 1.0, 0.9, 1.0e-14, 1 ),
+                           std::runtime_error );
+    }
+}
+
+//! Test if anomaly conversions for sets of orbits are working correctly.
+BOOST_AUTO_TEST_CASE( testBatchAnomalyConversions )
+{
+    // Using declarations.
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Case 1: Mixed elliptical and hyperbolic orbits, of which the number is not a multiple of
+    // the internal block size. Results should agree with the scalar conversions.
+    {
+        // Set number of orbits.
+        const int numberOfOrbits = 1001;
+
+        // Set eccentricities and anomalies, including anomalies close to zero. For the conversion
+        // from true anomaly, the true anomaly is kept within the asymptotes of hyperbolic orbits.
+        Eigen::ArrayXd eccentricities( numberOfOrbits );
+        Eigen::ArrayXd trueAnomalies( numberOfOrbits );
+        Eigen::ArrayXd eccentricAnomalies( numberOfOrbits );
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            eccentricities( i ) = ( i % 2 == 0 ) ? 0.99 * ( i % 101 ) / 100.0
+                                                 : 1.01 + 0.05 * ( i % 97 );
+
+            const double maximumTrueAnomaly = ( eccentricities( i ) < 1.0 )
+                    ? 3.0 : 0.99 * std::acos( -1.0 / eccentricities( i ) );
+            trueAnomalies( i ) = ( i % 5 == 0 ) ? 1.0e-3 * std::sin( 0.37 * i )
+                                                : maximumTrueAnomaly * std::sin( 0.37 * i );
+            eccentricAnomalies( i ) = ( i % 5 == 0 ) ? 1.0e-3 * std::cos( 0.53 * i )
+                                                     : 3.0 * std::cos( 0.53 * i );
+        }
+
+        // Convert anomalies for set of orbits.
+        const Eigen::ArrayXd computedEccentricAnomalies
+                = convertTrueAnomalyToEccentricAnomaly( trueAnomalies, eccentricities );
+        const Eigen::ArrayXd computedTrueAnomalies
+                = convertEccentricAnomalyToTrueAnomaly( eccentricAnomalies, eccentricities );
+        const Eigen::ArrayXd computedMeanAnomalies
+                = convertEccentricAnomalyToMeanAnomaly( eccentricAnomalies, eccentricities );
+
+        BOOST_CHECK_EQUAL( computedEccentricAnomalies.rows( ), numberOfOrbits );
+        BOOST_CHECK_EQUAL( computedTrueAnomalies.rows( ), numberOfOrbits );
+        BOOST_CHECK_EQUAL( computedMeanAnomalies.rows( ), numberOfOrbits );
+
+        // Check if converted anomalies match scalar conversions, relative to the magnitude of
+        // the anomaly (or 1.0 rad for larger anomalies).
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            const double expectedEccentricAnomaly = convertTrueAnomalyToEccentricAnomaly(
+                        trueAnomalies( i ), eccentricities( i ) );
+            BOOST_CHECK_SMALL( ( computedEccentricAnomalies( i ) - expectedEccentricAnomaly )
+                               / std::max( std::fabs( expectedEccentricAnomaly ), 1.0 ),
+                               1.0e-13 );
+
+            const double expectedTrueAnomaly = convertEccentricAnomalyToTrueAnomaly(
+                        eccentricAnomalies( i ), eccentricities( i ) );
+            BOOST_CHECK_SMALL( ( computedTrueAnomalies( i ) - expectedTrueAnomaly )
+                               / std::max( std::fabs( expectedTrueAnomaly ), 1.0 ), 1.0e-13 );
+
+            const double expectedMeanAnomaly = convertEccentricAnomalyToMeanAnomaly(
+                        eccentricAnomalies( i ), eccentricities( i ) );
+            BOOST_CHECK_SMALL( ( computedMeanAnomalies( i ) - expectedMeanAnomaly )
+                               / std::max( std::fabs( expectedMeanAnomaly ), 1.0 ), 1.0e-13 );
+        }
+    }
+
+    // Case 2: Empty set of orbits.
+    {
+        const Eigen::ArrayXd emptyArray( 0 );
+        BOOST_CHECK_EQUAL( convertEccentricAnomalyToMeanAnomaly(
+                               emptyArray, emptyArray ).rows( ), 0 );
+    }
+
+    // Case 3: Invalid input.
+    {
+        const Eigen::ArrayXd anomalies = Eigen::ArrayXd::Constant( 20, 0.5 );
+        Eigen::ArrayXd eccentricities = Eigen::ArrayXd::Constant( 20, 0.5 );
+
+        // Check if an error is thrown if the number of anomalies and eccentricities differ.
+        BOOST_CHECK_THROW( convertEccentricAnomalyToMeanAnomaly(
+                               anomalies, eccentricities.head( 19 ) ), std::runtime_error );
+
+        // Check if an error is thrown for negative eccentricity.
+        eccentricities( 17 ) = -0.1;
+        BOOST_CHECK_THROW( convertTrueAnomalyToEccentricAnomaly( anomalies, eccentricities ),
+                           std::runtime_error );
+
+        // Check if an error is thrown for parabolic orbits.
+        eccentricities( 17 ) = 1.0;
+        BOOST_CHECK_THROW( convertEccentricAnomalyToTrueAnomaly( anomalies, eccentricities ),
+                           std::runtime_error );
+    }
+}
+
+//! Test if policy-templated anomaly and elapsed time conversions are working correctly.
+BOOST_AUTO_TEST_CASE( testConversionErrorPolicies )
+{
+    // Using declarations.
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set gravitational parameter [m^3 s^-2] and elapsed time [s].
+    const double gravitationalParameter = 3.9859383624e14;
+    const double elapsedTime = 1234.5;
+
+    // Case 1: Valid input; all policies should give the same result as the non-templated
+    // functions (to within rounding, since the templated functions may be inlined differently).
+    {
+        const double eccentricities[ ] = { 0.0, 0.3, 0.99, 1.01, 2.5 };
+        const double anomaly = 0.7;
+
+        for ( unsigned int i = 0; i < 5; i++ )
+        {
+            const double eccentricity = eccentricities[ i ];
+
+            // Check true anomaly to eccentric anomaly conversion.
+            const double expectedEccentricAnomaly
+                    = convertTrueAnomalyToEccentricAnomaly( anomaly, eccentricity );
+            const double eccentricAnomalyWithNaNPolicy
+                    = convertTrueAnomalyToEccentricAnomaly< ReturnNaNOnInvalidInput >(
+                        anomaly, eccentricity );
+            const double eccentricAnomalyWithoutChecks
+                    = convertTrueAnomalyToEccentricAnomaly< AssumeValidInput >(
+                        anomaly, eccentricity );
+            BOOST_CHECK_CLOSE_FRACTION( eccentricAnomalyWithNaNPolicy, expectedEccentricAnomaly,
+                                        1.0e-14 );
+            BOOST_CHECK_CLOSE_FRACTION( eccentricAnomalyWithoutChecks, expectedEccentricAnomaly,
+                                        1.0e-14 );
+
+            // Check eccentric anomaly to true anomaly conversion.
+            const double expectedTrueAnomaly
+                    = convertEccentricAnomalyToTrueAnomaly( anomaly, eccentricity );
+            const double trueAnomalyWithNaNPolicy
+                    = convertEccentricAnomalyToTrueAnomaly< ReturnNaNOnInvalidInput >(
+                        anomaly, eccentricity );
+            const double trueAnomalyWithoutChecks
+                    = convertEccentricAnomalyToTrueAnomaly< AssumeValidInput >(
+                        anomaly, eccentricity );
+            BOOST_CHECK_CLOSE_FRACTION( trueAnomalyWithNaNPolicy, expectedTrueAnomaly, 1.0e-14 );
+            BOOST_CHECK_CLOSE_FRACTION( trueAnomalyWithoutChecks, expectedTrueAnomaly, 1.0e-14 );
+
+            // Check eccentric anomaly to mean anomaly conversion.
+            const double expectedMeanAnomaly
+                    = convertEccentricAnomalyToMeanAnomaly( anomaly, eccentricity );
+            const double meanAnomalyWithNaNPolicy
+                    = convertEccentricAnomalyToMeanAnomaly< ReturnNaNOnInvalidInput >(
+                        anomaly, eccentricity );
+            const double meanAnomalyWithoutChecks
+                    = convertEccentricAnomalyToMeanAnomaly< AssumeValidInput >(
+                        anomaly, eccentricity );
+            BOOST_CHECK_CLOSE_FRACTION( meanAnomalyWithNaNPolicy, expectedMeanAnomaly, 1.0e-14 );
+            BOOST_CHECK_CLOSE_FRACTION( meanAnomalyWithoutChecks, expectedMeanAnomaly, 1.0e-14 );
+
+            // Check elapsed time to mean anomaly change conversion, and back. The semi-major axis
+            // is negative for hyperbolic orbits.
+            const double semiMajorAxis = ( eccentricity < 1.0 ) ? 7.0e6 : -7.0e6;
+            const double expectedMeanAnomalyChange = convertElapsedTimeToMeanAnomalyChange(
+                        elapsedTime, gravitationalParameter, semiMajorAxis );
+            const double meanAnomalyChange
+                    = convertElapsedTimeToMeanAnomalyChange< AssumeValidInput >(
+                        elapsedTime, gravitationalParameter, semiMajorAxis );
+            const double recomputedElapsedTime
+                    = convertMeanAnomalyChangeToElapsedTime< AssumeValidInput >(
+                        meanAnomalyChange, gravitationalParameter, semiMajorAxis );
+            BOOST_CHECK_CLOSE_FRACTION( meanAnomalyChange, expectedMeanAnomalyChange, 1.0e-14 );
+            BOOST_CHECK_CLOSE_FRACTION( recomputedElapsedTime, elapsedTime, 1.0e-14 );
+        }
+    }
+
+    // Case 2: Invalid input; the throwing policy should throw, and the NaN policy should return
+    // NaN.
+    {
+        BOOST_CHECK_THROW( convertTrueAnomalyToEllipticalEccentricAnomaly< ThrowOnInvalidInput >(
+                               0.7, 1.5 ), std::runtime_error );
+        BOOST_CHECK( boost::math::isnan(
+                         convertTrueAnomalyToEllipticalEccentricAnomaly< ReturnNaNOnInvalidInput >(
+                             0.7, 1.5 ) ) );
+
+        BOOST_CHECK_THROW( convertTrueAnomalyToHyperbolicEccentricAnomaly< ThrowOnInvalidInput >(
+                               0.7, 0.5 ), std::runtime_error );
+        BOOST_CHECK( boost::math::isnan(
+                         convertTrueAnomalyToHyperbolicEccentricAnomaly< ReturnNaNOnInvalidInput >(
+                             0.7, 0.5 ) ) );
+
+        BOOST_CHECK_THROW( convertEccentricAnomalyToTrueAnomaly< ThrowOnInvalidInput >(
+                               0.7, -0.1 ), std::runtime_error );
+        BOOST_CHECK( boost::math::isnan(
+                         convertEccentricAnomalyToTrueAnomaly< ReturnNaNOnInvalidInput >(
+                             0.7, -0.1 ) ) );
+
+        BOOST_CHECK_THROW( convertEccentricAnomalyToMeanAnomaly< ThrowOnInvalidInput >(
+                               0.7, 1.0 ), std::runtime_error );
+        BOOST_CHECK( boost::math::isnan(
+                         convertEccentricAnomalyToMeanAnomaly< ReturnNaNOnInvalidInput >(
+                             0.7, 1.0 ) ) );
+
+        BOOST_CHECK_THROW( convertElapsedTimeToEllipticalMeanAnomalyChange< ThrowOnInvalidInput >(
+                               elapsedTime, gravitationalParameter, -7.0e6 ),
+                           std::runtime_error );
+        BOOST_CHECK( boost::math::isnan(
+                         convertElapsedTimeToHyperbolicMeanAnomalyChange<
+                         ReturnNaNOnInvalidInput >( elapsedTime, gravitationalParameter,
+                                                    7.0e6 ) ) );
+
+        BOOST_CHECK_THROW( convertEllipticalMeanAnomalyChangeToElapsedTime< ThrowOnInvalidInput >(
+                               1.0, gravitationalParameter, -7.0e6 ), std::runtime_error );
+        BOOST_CHECK( boost::math::isnan(
+                         convertHyperbolicMeanAnomalyChangeToElapsedTime<
+                         ReturnNaNOnInvalidInput >( 1.0, gravitationalParameter, 7.0e6 ) ) );
+    }
+}
+
 //! Test if conversion from elapsed time to mean anomaly change is working correctly.
 BOOST_AUTO_TEST_CASE( testElapsedTimeToMeanAnomalyConversion )
 {
@@ -1398,6 +2052,83 @@ BOOST_AUTO_TEST_CASE( testMeanAnomalyToElaspedTimeConversion )
     }
 }
 
+//! Test if lookup table for eccentric anomaly is working correctly.
+BOOST_AUTO_TEST_CASE( testEccentricAnomalyLookupTable )
+{
+    // Using declarations.
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Create lookup table with default settings.
+    const EccentricAnomalyLookupTable lookupTable;
+
+    // Case 1: Check if estimated maximum errors match the documented values.
+    {
+        BOOST_CHECK_LT( lookupTable.getMaximumInterpolationError( ), 5.0e-5 );
+        BOOST_CHECK_LT( lookupTable.getMaximumPolishedError( ), 1.0e-9 );
+    }
+
+    // Case 2: Check if interpolated eccentric anomalies, for mean anomalies spanning multiple
+    // revolutions in both directions, agree with the iterative solution within the estimated
+    // maximum errors. Since the estimates are obtained at the points where the interpolation
+    // error is largest, a small margin suffices; the error after the Newton step scales with the
+    // square of the interpolation error, so that the margin is squared.
+    {
+        const int numberOfOrbits = 10001;
+        const Eigen::VectorXd meanAnomalies = Eigen::VectorXd::LinSpaced(
+                    numberOfOrbits, -20.0, 20.0 );
+        Eigen::VectorXd eccentricities( numberOfOrbits );
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            eccentricities( i ) = 0.9 * std::fabs( std::sin( 7.3 * static_cast< double >( i ) ) );
+        }
+
+        const Eigen::VectorXd expectedEccentricAnomalies
+                = convertMeanAnomalyToEccentricAnomaly( meanAnomalies, eccentricities );
+
+        BOOST_CHECK_LE( ( lookupTable.computeEccentricAnomalies( meanAnomalies, eccentricities )
+                          - expectedEccentricAnomalies ).cwiseAbs( ).maxCoeff( ),
+                        1.5 * lookupTable.getMaximumInterpolationError( ) );
+        BOOST_CHECK_LE( ( lookupTable.computeEccentricAnomalies( meanAnomalies, eccentricities,
+                                                                 true )
+                          - expectedEccentricAnomalies ).cwiseAbs( ).maxCoeff( ),
+                        2.25 * lookupTable.getMaximumPolishedError( ) + 1.0e-14 );
+    }
+
+    // Case 3: Check if exact values are reproduced at nodes of the table, and if the exact
+    // solution is used above the maximum eccentricity.
+    {
+        const double meanAnomaly = 2.0 * PI / 255.0 * 17.0 - 4.0 * PI;
+        const double eccentricity = 0.9 / 63.0 * 40.0;
+        BOOST_CHECK_SMALL( lookupTable.computeEccentricAnomaly( meanAnomaly, eccentricity )
+                           - convertMeanAnomalyToEccentricAnomaly( meanAnomaly, eccentricity ),
+                           1.0e-13 );
+
+        BOOST_CHECK_EQUAL( lookupTable.computeEccentricAnomaly( meanAnomaly, 0.95 ),
+                           convertMeanAnomalyToEccentricAnomaly( meanAnomaly, 0.95 ) );
+    }
+
+    // Case 4: Check if the error decreases with the fourth power of the grid spacing.
+    {
+        const EccentricAnomalyLookupTable coarseLookupTable( 64, 16, 0.5 );
+        const EccentricAnomalyLookupTable fineLookupTable( 128, 32, 0.5 );
+        const double errorRatio = coarseLookupTable.getMaximumInterpolationError( )
+                / fineLookupTable.getMaximumInterpolationError( );
+
+        BOOST_CHECK_GT( errorRatio, 12.0 );
+        BOOST_CHECK_LT( errorRatio, 20.0 );
+    }
+
+    // Case 5: Check if errors are thrown for invalid input.
+    {
+        BOOST_CHECK_THROW( lookupTable.computeEccentricAnomaly( 1.0, -0.1 ), std::runtime_error );
+        BOOST_CHECK_THROW( EccentricAnomalyLookupTable( 1, 64 ), std::runtime_error );
+        BOOST_CHECK_THROW( EccentricAnomalyLookupTable( 256, 64, 1.0 ), std::runtime_error );
+        BOOST_CHECK_THROW( lookupTable.computeEccentricAnomalies( Eigen::VectorXd::Zero( 3 ),
+                                                                  Eigen::VectorXd::Zero( 2 ) ),
+                           std::runtime_error );
+    }
+}
+
 //! Test if conversion from mean motion to semi-major axis is working correctly.
 BOOST_AUTO_TEST_CASE( testMeanMotionToSemiMajorAxisConversion )
 {
@@ -0,0 +1,138 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *      The error policies defined here are used as template arguments of the policy-templated
+ *      orbital element conversion functions. A policy defines whether the input of a conversion
+ *      is checked, and how invalid input is handled. The non-throwing policies allow the
+ *      conversions to be inlined and used in vectorized and multi-threaded loops.
+ *
+ */
+
+#ifndef TUDAT_CORE_CONVERSION_ERROR_POLICIES_H
+#define TUDAT_CORE_CONVERSION_ERROR_POLICIES_H
+
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+//! Error policy that throws an exception on invalid input.
+/*!
+ * Error policy for conversion functions that checks the input, and throws a std::runtime_error
+ * if it is invalid. This is the behavior of the non-templated conversion functions.
+ */
+class ThrowOnInvalidInput
+{
+public:
+
+    //! Flag indicating that the input is checked.
+    static const bool isInputChecked = true;
+
+    //! Handle invalid input.
+    /*!
+     * Handles invalid input by throwing a std::runtime_error.
+     * \param errorMessage Message describing why the input is invalid.
+     * \return Does not return.
+     */
+    static double handleInvalidInput( const char* errorMessage )
+    {
+        boost::throw_exception( boost::enable_error_info( std::runtime_error( errorMessage ) ) );
+    }
+};
+
+//! Error policy that returns NaN on invalid input.
+/*!
+ * Error policy for conversion functions that checks the input, and returns NaN if it is invalid,
+ * such that the result acts as a status flag (to be checked with, e.g., boost::math::isnan()).
+ * Conversions using this policy do not throw, and can be used in vectorized and multi-threaded
+ * loops for which the validity of the input is not known a priori.
+ */
+class ReturnNaNOnInvalidInput
+{
+public:
+
+    //! Flag indicating that the input is checked.
+    static const bool isInputChecked = true;
+
+    //! Handle invalid input.
+    /*!
+     * Handles invalid input by returning NaN.
+     * \param errorMessage Message describing why the input is invalid (unused).
+     * \return NaN.
+     */
+    static double handleInvalidInput( const char* errorMessage )
+    {
+        static_cast< void >( errorMessage );
+        return TUDAT_NAN;
+    }
+};
+
+//! Error policy that assumes the input to be valid.
+/*!
+ * Error policy for conversion functions that does not check the input. The result of a
+ * conversion with invalid input is undefined. This policy should only be used in loops for which
+ * the validity of the input is guaranteed, e.g., because it was checked beforehand. Conversions
+ * using this policy do not branch on the validity checks, which allows them to be fully inlined
+ * and vectorized.
+ */
+class AssumeValidInput
+{
+public:
+
+    //! Flag indicating that the input is not checked.
+    static const bool isInputChecked = false;
+
+    //! Handle invalid input.
+    /*!
+     * Handles invalid input by returning NaN. This function is never called, since the input is
+     * not checked, but is required for the policy interface.
+     * \param errorMessage Message describing why the input is invalid (unused).
+     * \return NaN.
+     */
+    static double handleInvalidInput( const char* errorMessage )
+    {
+        static_cast< void >( errorMessage );
+        return TUDAT_NAN;
+    }
+};
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
+
+#endif // TUDAT_CORE_CONVERSION_ERROR_POLICIES_H
@@ -0,0 +1,489 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Brouwer, D. Solution of the problem of artificial satellite theory without drag,
+ *          The Astronomical Journal, 64(1274), 378-397, 1959.
+ *      Schaub, H., Junkins, J.L. Analytical Mechanics of Space Systems, 2nd Edition, AIAA
+ *          Education Series, Reston, VA, 2009.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/function.hpp>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/meanElementConversions.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/modifiedEquinoctialElementConversions.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/basicMathematicsFunctions.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+namespace
+{
+
+//! Check if Keplerian elements describe an elliptical orbit.
+/*!
+ * Checks if Keplerian elements describe an elliptical orbit, i.e., if the semi-major axis is
+ * positive and the eccentricity lies in [ 0, 1 ).
+ * \param keplerianElements Keplerian elements.
+ * \return True if the orbit is elliptical.
+ */
+bool isEllipticalOrbit( const Vector6d& keplerianElements )
+{
+    return keplerianElements( semiMajorAxisIndex ) > 0.0
+            && keplerianElements( eccentricityIndex ) >= 0.0
+            && keplerianElements( eccentricityIndex ) < 1.0;
+}
+
+//! Normalize angle to range [ -pi, pi ).
+/*!
+ * Normalizes an angle to the range [ -pi, pi ).
+ * \param angle Angle.                                                                        [rad]
+ * \return Normalized angle.                                                                  [rad]
+ */
+double normalizeAngleAroundZero( const double angle )
+{
+    using basic_mathematics::mathematical_constants::PI;
+    return basic_mathematics::computeModulo( angle + PI, 2.0 * PI ) - PI;
+}
+
+//! Add short-period variations to mean elements.
+/*!
+ * Adds the first-order short-period variations due to J2 to mean Keplerian elements of an
+ * elliptical orbit, as described for convertMeanToOsculatingKeplerianElements(). The variable
+ * names follow (Schaub and Junkins, 2009).
+ * \param meanKeplerianElements Mean Keplerian elements of an elliptical orbit.
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.
+ * \param equatorialRadius Equatorial radius of central body.
+ * \param osculatingKeplerianElements Osculating Keplerian elements (returned by reference).
+ * \return True if the osculating orbit is elliptical.
+ */
+bool addShortPeriodVariations( const Vector6d& meanKeplerianElements, const double j2Coefficient,
+                               const double equatorialRadius,
+                               Vector6d& osculatingKeplerianElements )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    const double a_ = meanKeplerianElements( semiMajorAxisIndex );
+    const double e_ = meanKeplerianElements( eccentricityIndex );
+    const double i_ = meanKeplerianElements( inclinationIndex );
+    const double omega_ = meanKeplerianElements( argumentOfPeriapsisIndex );
+    const double raan_ = meanKeplerianElements( longitudeOfAscendingNodeIndex );
+    const double f_ = meanKeplerianElements( trueAnomalyIndex );
+    const double meanAnomaly_ = convertEllipticalEccentricAnomalyToMeanAnomaly(
+                convertTrueAnomalyToEllipticalEccentricAnomaly( f_, e_ ), e_ );
+
+    // Compute auxiliary quantities.
+    const double gamma2_ = 0.5 * j2Coefficient * ( equatorialRadius / a_ )
+            * ( equatorialRadius / a_ );
+    const double eta_ = std::sqrt( 1.0 - e_ * e_ );
+    const double eta2_ = eta_ * eta_;
+    const double eta3_ = eta2_ * eta_;
+    const double eta6_ = eta3_ * eta3_;
+    const double gamma2Prime_ = gamma2_ / ( eta2_ * eta2_ );
+    const double cosineOfInclination_ = std::cos( i_ );
+    const double theta2_ = cosineOfInclination_ * cosineOfInclination_;
+    const double cosineOfF_ = std::cos( f_ );
+    const double sineOfF_ = std::sin( f_ );
+    const double aOverR_ = ( 1.0 + e_ * cosineOfF_ ) / eta2_;
+    const double aOverR3_ = aOverR_ * aOverR_ * aOverR_;
+    const double aEtaOverR2_ = aOverR_ * aOverR_ * eta2_;
+
+    const double cosine2OmegaPlusF_ = std::cos( 2.0 * omega_ + f_ );
+    const double cosine2OmegaPlus2F_ = std::cos( 2.0 * omega_ + 2.0 * f_ );
+    const double cosine2OmegaPlus3F_ = std::cos( 2.0 * omega_ + 3.0 * f_ );
+    const double sine2OmegaPlusF_ = std::sin( 2.0 * omega_ + f_ );
+    const double sine2OmegaPlus2F_ = std::sin( 2.0 * omega_ + 2.0 * f_ );
+    const double sine2OmegaPlus3F_ = std::sin( 2.0 * omega_ + 3.0 * f_ );
+
+    // Compute the equation of the center term and the common sum of sines.
+    const double equationOfCenter_ = normalizeAngleAroundZero( f_ - meanAnomaly_ )
+            + e_ * sineOfF_;
+    const double sumOfSines_ = 3.0 * sine2OmegaPlus2F_ + 3.0 * e_ * sine2OmegaPlusF_
+            + e_ * sine2OmegaPlus3F_;
+
+    // Compute the short-period variations.
+    const double deltaA_ = a_ * gamma2_
+            * ( ( 3.0 * theta2_ - 1.0 ) * ( aOverR3_ - 1.0 / eta3_ )
+                + 3.0 * ( 1.0 - theta2_ ) * aOverR3_ * cosine2OmegaPlus2F_ );
+
+    const double cosineSeries_ = 3.0 * cosineOfF_ + 3.0 * e_ * cosineOfF_ * cosineOfF_
+            + e_ * e_ * cosineOfF_ * cosineOfF_ * cosineOfF_;
+    const double deltaE_ = 0.5 * eta2_
+            * ( gamma2_ * ( ( 3.0 * theta2_ - 1.0 ) / eta6_
+                            * ( e_ * eta_ + e_ / ( 1.0 + eta_ ) + cosineSeries_ )
+                            + 3.0 * ( 1.0 - theta2_ ) / eta6_ * ( e_ + cosineSeries_ )
+                            * cosine2OmegaPlus2F_ )
+                - gamma2Prime_ * ( 1.0 - theta2_ )
+                * ( 3.0 * cosine2OmegaPlusF_ + cosine2OmegaPlus3F_ ) );
+
+    const double deltaI_ = 0.5 * gamma2Prime_ * cosineOfInclination_
+            * std::sqrt( 1.0 - theta2_ )
+            * ( 3.0 * cosine2OmegaPlus2F_ + 3.0 * e_ * cosine2OmegaPlusF_
+                + e_ * cosine2OmegaPlus3F_ );
+
+    const double deltaRaan_ = -0.5 * gamma2Prime_ * cosineOfInclination_
+            * ( 6.0 * equationOfCenter_ - sumOfSines_ );
+
+    const double deltaMeanLongitude_ = 0.25 * gamma2Prime_
+            * ( -6.0 * ( 1.0 - 5.0 * theta2_ ) * equationOfCenter_
+                + ( 3.0 - 5.0 * theta2_ ) * sumOfSines_ ) + deltaRaan_;
+
+    const double eDeltaM_ = -0.25 * gamma2Prime_ * eta3_
+            * ( 2.0 * ( 3.0 * theta2_ - 1.0 ) * ( aEtaOverR2_ + aOverR_ + 1.0 ) * sineOfF_
+                + 3.0 * ( 1.0 - theta2_ )
+                * ( ( -aEtaOverR2_ - aOverR_ + 1.0 ) * sine2OmegaPlusF_
+                    + ( aEtaOverR2_ + aOverR_ + 1.0 / 3.0 ) * sine2OmegaPlus3F_ ) );
+
+    // Apply the variations of eccentricity and mean anomaly through their non-singular
+    // combination.
+    const double d1_ = ( e_ + deltaE_ ) * std::sin( meanAnomaly_ )
+            + eDeltaM_ * std::cos( meanAnomaly_ );
+    const double d2_ = ( e_ + deltaE_ ) * std::cos( meanAnomaly_ )
+            - eDeltaM_ * std::sin( meanAnomaly_ );
+    const double osculatingMeanAnomaly_ = std::atan2( d1_, d2_ );
+    const double osculatingEccentricity_ = std::sqrt( d1_ * d1_ + d2_ * d2_ );
+
+    // Apply the variations of inclination and node through their non-singular combination.
+    const double sineOfHalfInclination_ = std::sin( 0.5 * i_ );
+    const double d3_ = ( sineOfHalfInclination_ + std::cos( 0.5 * i_ ) * 0.5 * deltaI_ )
+            * std::sin( raan_ ) + sineOfHalfInclination_ * deltaRaan_ * std::cos( raan_ );
+    const double d4_ = ( sineOfHalfInclination_ + std::cos( 0.5 * i_ ) * 0.5 * deltaI_ )
+            * std::cos( raan_ ) - sineOfHalfInclination_ * deltaRaan_ * std::sin( raan_ );
+    const double osculatingRaan_ = std::atan2( d3_, d4_ );
+    const double osculatingInclination_
+            = 2.0 * std::asin( std::min( 1.0, std::sqrt( d3_ * d3_ + d4_ * d4_ ) ) );
+
+    if ( !( osculatingEccentricity_ < 1.0 ) )
+    {
+        return false;
+    }
+
+    osculatingKeplerianElements( semiMajorAxisIndex ) = a_ + deltaA_;
+    osculatingKeplerianElements( eccentricityIndex ) = osculatingEccentricity_;
+    osculatingKeplerianElements( inclinationIndex ) = osculatingInclination_;
+    osculatingKeplerianElements( argumentOfPeriapsisIndex ) = basic_mathematics::computeModulo(
+                meanAnomaly_ + omega_ + raan_ + deltaMeanLongitude_
+                - osculatingMeanAnomaly_ - osculatingRaan_, 2.0 * PI );
+    osculatingKeplerianElements( longitudeOfAscendingNodeIndex )
+            = basic_mathematics::computeModulo( osculatingRaan_, 2.0 * PI );
+    osculatingKeplerianElements( trueAnomalyIndex ) = basic_mathematics::computeModulo(
+                convertEllipticalEccentricAnomalyToTrueAnomaly(
+                    convertMeanAnomalyToEllipticalEccentricAnomaly(
+                        osculatingMeanAnomaly_, osculatingEccentricity_ ),
+                    osculatingEccentricity_ ), 2.0 * PI );
+
+    return osculatingKeplerianElements( semiMajorAxisIndex ) > 0.0;
+}
+
+//! Remove short-period variations from osculating elements.
+/*!
+ * Removes the first-order short-period variations due to J2 from osculating Keplerian elements,
+ * by inverting addShortPeriodVariations() iteratively, as described for
+ * convertOsculatingToMeanKeplerianElements().
+ * \param osculatingKeplerianElements Osculating Keplerian elements.
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.
+ * \param equatorialRadius Equatorial radius of central body.
+ * \param tolerance Tolerance of the iteration.
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \param meanKeplerianElements Mean Keplerian elements (returned by reference).
+ * \return True if the iteration converged.
+ */
+bool removeShortPeriodVariations( const Vector6d& osculatingKeplerianElements,
+                                  const double j2Coefficient, const double equatorialRadius,
+                                  const double tolerance,
+                                  const unsigned int maximumNumberOfIterations,
+                                  Vector6d& meanKeplerianElements )
+{
+    if ( !isEllipticalOrbit( osculatingKeplerianElements ) )
+    {
+        return false;
+    }
+
+    const Vector6d targetModifiedEquinoctialElements_
+            = convertKeplerianToModifiedEquinoctialElements( osculatingKeplerianElements );
+
+    meanKeplerianElements = osculatingKeplerianElements;
+    Vector6d reconstructedKeplerianElements_;
+    for ( unsigned int iteration = 0; iteration <= maximumNumberOfIterations; iteration++ )
+    {
+        // Compute the difference between the given osculating elements and those of the current
+        // mean elements.
+        if ( !addShortPeriodVariations( meanKeplerianElements, j2Coefficient, equatorialRadius,
+                                        reconstructedKeplerianElements_ ) )
+        {
+            return false;
+        }
+
+        Vector6d residual_ = targetModifiedEquinoctialElements_
+                - convertKeplerianToModifiedEquinoctialElements( reconstructedKeplerianElements_ );
+        residual_( trueLongitudeIndex ) = normalizeAngleAroundZero(
+                    residual_( trueLongitudeIndex ) );
+
+        if ( std::fabs( residual_( semiLatusRectumIndex ) )
+             < tolerance * targetModifiedEquinoctialElements_( semiLatusRectumIndex )
+             && residual_.tail< 5 >( ).cwiseAbs( ).maxCoeff( ) < tolerance )
+        {
+            return true;
+        }
+
+        // Correct the mean elements.
+        meanKeplerianElements = convertModifiedEquinoctialToKeplerianElements(
+                    convertKeplerianToModifiedEquinoctialElements( meanKeplerianElements )
+                    + residual_ );
+        if ( !isEllipticalOrbit( meanKeplerianElements ) )
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//! Convert mean to osculating Keplerian elements, setting NaN for invalid orbits.
+/*!
+ * Converts mean to osculating Keplerian elements, and sets the elements to NaN for orbits that
+ * cannot be converted, for use in the batch conversion.
+ * \param meanKeplerianElements Mean Keplerian elements.
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.
+ * \param equatorialRadius Equatorial radius of central body.
+ * \return Osculating Keplerian elements, or NaN.
+ */
+Vector6d convertMeanToOsculatingKeplerianElementsOrNan( const Vector6d& meanKeplerianElements,
+                                                        const double j2Coefficient,
+                                                        const double equatorialRadius )
+{
+    Vector6d osculatingKeplerianElements_;
+    if ( !isEllipticalOrbit( meanKeplerianElements )
+         || !addShortPeriodVariations( meanKeplerianElements, j2Coefficient, equatorialRadius,
+                                       osculatingKeplerianElements_ ) )
+    {
+        osculatingKeplerianElements_.setConstant( TUDAT_NAN );
+    }
+    return osculatingKeplerianElements_;
+}
+
+//! Convert osculating to mean Keplerian elements, setting NaN for invalid orbits.
+/*!
+ * Converts osculating to mean Keplerian elements, and sets the elements to NaN for orbits that
+ * cannot be converted, for use in the batch conversion.
+ * \param osculatingKeplerianElements Osculating Keplerian elements.
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.
+ * \param equatorialRadius Equatorial radius of central body.
+ * \param tolerance Tolerance of the iteration.
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \return Mean Keplerian elements, or NaN.
+ */
+Vector6d convertOsculatingToMeanKeplerianElementsOrNan(
+        const Vector6d& osculatingKeplerianElements, const double j2Coefficient,
+        const double equatorialRadius, const double tolerance,
+        const unsigned int maximumNumberOfIterations )
+{
+    Vector6d meanKeplerianElements_;
+    if ( !removeShortPeriodVariations( osculatingKeplerianElements, j2Coefficient,
+                                       equatorialRadius, tolerance, maximumNumberOfIterations,
+                                       meanKeplerianElements_ ) )
+    {
+        meanKeplerianElements_.setConstant( TUDAT_NAN );
+    }
+    return meanKeplerianElements_;
+}
+
+//! Typedef for function converting elements of a single orbit.
+typedef boost::function< Vector6d( const Vector6d& ) > SingleOrbitConversionFunction;
+
+//! Loop body for conversion of mean and osculating elements for a set of orbits.
+/*!
+ * Loop body for conversion of mean and osculating elements for a set of orbits, to be used with
+ * executeParallelLoop(). Each call converts the elements of a contiguous range of orbits.
+ */
+class BatchMeanElementConversion
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param singleOrbitConversionFunction Function converting elements of a single orbit.
+     * \param inputElements Matrix containing elements to convert (6 x N).
+     * \param outputElements Matrix in which converted elements are stored (6 x N).
+     */
+    BatchMeanElementConversion( const SingleOrbitConversionFunction& singleOrbitConversionFunction,
+                                const Eigen::MatrixXd& inputElements,
+                                Eigen::MatrixXd& outputElements )
+        : singleOrbitConversionFunction_( singleOrbitConversionFunction ),
+          inputElements_( inputElements ),
+          outputElements_( outputElements )
+    { }
+
+    //! Convert range of orbits.
+    /*!
+     * Converts the elements of the orbits in the index range [ startIndex, endIndex ).
+     * \param startIndex Index of first orbit.
+     * \param endIndex One past the index of the last orbit.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        for ( int orbitIndex = startIndex; orbitIndex < endIndex; orbitIndex++ )
+        {
+            outputElements_.col( orbitIndex )
+                    = singleOrbitConversionFunction_( inputElements_.col( orbitIndex ) );
+        }
+    }
+
+private:
+
+    //! Function converting elements of a single orbit.
+    const SingleOrbitConversionFunction singleOrbitConversionFunction_;
+
+    //! Matrix containing elements to convert.
+    const Eigen::MatrixXd& inputElements_;
+
+    //! Matrix in which converted elements are stored.
+    Eigen::MatrixXd& outputElements_;
+};
+
+//! Convert mean and osculating elements for a set of orbits.
+/*!
+ * Converts mean and osculating elements for a set of orbits, divided over multiple threads.
+ * \param singleOrbitConversionFunction Function converting elements of a single orbit.
+ * \param inputElements Matrix containing elements to convert (6 x N).
+ * \param outputElements Matrix in which converted elements are stored (6 x N).
+ * \param numberOfThreads Number of threads to use.
+ */
+void convertElementsOfOrbits( const SingleOrbitConversionFunction& singleOrbitConversionFunction,
+                              const Eigen::MatrixXd& inputElements,
+                              Eigen::MatrixXd& outputElements,
+                              const unsigned int numberOfThreads )
+{
+    // Check if input matrix has the correct number of rows and throw an error if not.
+    if ( inputElements.rows( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Orbital elements matrix should have 6 rows." ) ) );
+    }
+
+    // Resize output matrix; this does not allocate if it already has the correct size.
+    outputElements.resize( 6, inputElements.cols( ) );
+
+    basics::executeParallelLoop(
+                static_cast< int >( inputElements.cols( ) ),
+                BatchMeanElementConversion( singleOrbitConversionFunction, inputElements,
+                                            outputElements ),
+                numberOfThreads, 64 );
+}
+
+} // namespace
+
+//! Convert mean to osculating Keplerian elements.
+Vector6d convertMeanToOsculatingKeplerianElements( const Vector6d& meanKeplerianElements,
+                                                   const double j2Coefficient,
+                                                   const double equatorialRadius )
+{
+    Vector6d osculatingKeplerianElements_;
+    if ( !isEllipticalOrbit( meanKeplerianElements )
+         || !addShortPeriodVariations( meanKeplerianElements, j2Coefficient, equatorialRadius,
+                                       osculatingKeplerianElements_ ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Mean to osculating element conversion is only "
+                                            "defined for elliptical orbits." ) ) );
+    }
+
+    return osculatingKeplerianElements_;
+}
+
+//! Convert osculating to mean Keplerian elements.
+Vector6d convertOsculatingToMeanKeplerianElements( const Vector6d& osculatingKeplerianElements,
+                                                   const double j2Coefficient,
+                                                   const double equatorialRadius,
+                                                   const double tolerance,
+                                                   const unsigned int maximumNumberOfIterations )
+{
+    Vector6d meanKeplerianElements_;
+    if ( !removeShortPeriodVariations( osculatingKeplerianElements, j2Coefficient,
+                                       equatorialRadius, tolerance, maximumNumberOfIterations,
+                                       meanKeplerianElements_ ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Osculating to mean element conversion failed; the "
+                                            "orbit is not elliptical or the iteration did not "
+                                            "converge." ) ) );
+    }
+
+    return meanKeplerianElements_;
+}
+
+//! Convert mean to osculating Keplerian elements for set of orbits.
+void convertMeanToOsculatingKeplerianElements( const Eigen::MatrixXd& meanKeplerianElements,
+                                               const double j2Coefficient,
+                                               const double equatorialRadius,
+                                               Eigen::MatrixXd& osculatingKeplerianElements,
+                                               const unsigned int numberOfThreads )
+{
+    convertElementsOfOrbits( boost::bind( &convertMeanToOsculatingKeplerianElementsOrNan, _1,
+                                          j2Coefficient, equatorialRadius ),
+                             meanKeplerianElements, osculatingKeplerianElements,
+                             numberOfThreads );
+}
+
+//! Convert osculating to mean Keplerian elements for set of orbits.
+void convertOsculatingToMeanKeplerianElements( const Eigen::MatrixXd& osculatingKeplerianElements,
+                                               const double j2Coefficient,
+                                               const double equatorialRadius,
+                                               Eigen::MatrixXd& meanKeplerianElements,
+                                               const unsigned int numberOfThreads,
+                                               const double tolerance,
+                                               const unsigned int maximumNumberOfIterations )
+{
+    convertElementsOfOrbits( boost::bind( &convertOsculatingToMeanKeplerianElementsOrNan, _1,
+                                          j2Coefficient, equatorialRadius, tolerance,
+                                          maximumNumberOfIterations ),
+                             osculatingKeplerianElements, meanKeplerianElements,
+                             numberOfThreads );
+}
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
@@ -0,0 +1,161 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Brouwer, D. Solution of the problem of artificial satellite theory without drag,
+ *          The Astronomical Journal, 64(1274), 378-397, 1959.
+ *      Kozai, Y. The motion of a close earth satellite, The Astronomical Journal, 64(1274),
+ *          367-377, 1959.
+ *      Schaub, H., Junkins, J.L. Analytical Mechanics of Space Systems, 2nd Edition, AIAA
+ *          Education Series, Reston, VA, 2009.
+ *
+ *    Notes
+ *      Only the first-order short-period terms due to J2 are included, such that the mean
+ *      elements contain the secular and long-period variations, as in the theory of Kozai (1959).
+ *      The long-period terms of Brouwer (1959), which are singular at the critical inclination,
+ *      are not removed. The mean elements are therefore consistent with the secular rates of
+ *      propagators::computeJ2SecularRates().
+ *
+ */
+
+#ifndef TUDAT_CORE_MEAN_ELEMENT_CONVERSIONS_H
+#define TUDAT_CORE_MEAN_ELEMENT_CONVERSIONS_H
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+//! Convert mean to osculating Keplerian elements.
+/*!
+ * Converts mean to osculating Keplerian elements, by adding the first-order short-period
+ * variations due to J2 of Brouwer's theory, as given in the form of (Schaub and Junkins, 2009)
+ * without the long-period terms. The variations of the eccentricity and mean anomaly, and of the
+ * inclination and node, are applied through their non-singular combinations, such that circular
+ * and equatorial orbits are supported. Fixed-size vectors are used, such that no dynamic memory
+ * is allocated. An error is thrown for non-elliptical orbits.
+ * \param meanKeplerianElements Mean Keplerian elements, ordered as given by the
+ *          KeplerianElementVectorIndices enum; the true anomaly is computed from the mean anomaly
+ *          with the mean eccentricity.
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.                            [-]
+ * \param equatorialRadius Equatorial radius of central body.                                   [m]
+ * \return Osculating Keplerian elements, ordered as given by the KeplerianElementVectorIndices
+ *          enum, with all angles in the range [ 0, 2 pi ).
+ */
+Vector6d convertMeanToOsculatingKeplerianElements( const Vector6d& meanKeplerianElements,
+                                                   const double j2Coefficient,
+                                                   const double equatorialRadius );
+
+//! Convert osculating to mean Keplerian elements.
+/*!
+ * Converts osculating to mean Keplerian elements, by inverting
+ * convertMeanToOsculatingKeplerianElements() iteratively. Starting from the osculating elements,
+ * the mean elements are corrected by the difference between the given osculating elements and
+ * those computed from the current mean elements. The differences are computed in modified
+ * equinoctial elements, which are non-singular for circular and equatorial orbits. The iteration
+ * converges by a factor of order J2 per iteration. An error is thrown for non-elliptical orbits
+ * and if the iteration does not converge.
+ * \param osculatingKeplerianElements Osculating Keplerian elements, ordered as given by the
+ *          KeplerianElementVectorIndices enum.
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.                            [-]
+ * \param equatorialRadius Equatorial radius of central body.                                   [m]
+ * \param tolerance Tolerance on the difference between the given and reconstructed osculating
+ *          modified equinoctial elements, relative for the semi-latus rectum and absolute for
+ *          the others.                                                                         [-]
+ * \param maximumNumberOfIterations Maximum number of iterations.                               [-]
+ * \return Mean Keplerian elements, ordered as given by the KeplerianElementVectorIndices enum,
+ *          with all angles in the range [ 0, 2 pi ).
+ * \sa convertMeanToOsculatingKeplerianElements().
+ */
+Vector6d convertOsculatingToMeanKeplerianElements( const Vector6d& osculatingKeplerianElements,
+                                                   const double j2Coefficient,
+                                                   const double equatorialRadius,
+                                                   const double tolerance = 1.0e-12,
+                                                   const unsigned int maximumNumberOfIterations
+                                                   = 20 );
+
+//! Convert mean to osculating Keplerian elements for set of orbits.
+/*!
+ * Converts mean to osculating Keplerian elements for a set of orbits, with the fixed-size
+ * conversion of convertMeanToOsculatingKeplerianElements() for each orbit. The set of orbits is
+ * divided over multiple threads. The elements of non-elliptical orbits are set to NaN, such that
+ * no errors are thrown from the threads.
+ * \param meanKeplerianElements Matrix containing mean Keplerian elements, with one orbit per
+ *          column (6 x N).
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.                            [-]
+ * \param equatorialRadius Equatorial radius of central body.                                   [m]
+ * \param osculatingKeplerianElements Matrix in which the osculating Keplerian elements are
+ *          stored (6 x N). If the matrix is preallocated with the correct size, no memory is
+ *          allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ */
+void convertMeanToOsculatingKeplerianElements( const Eigen::MatrixXd& meanKeplerianElements,
+                                               const double j2Coefficient,
+                                               const double equatorialRadius,
+                                               Eigen::MatrixXd& osculatingKeplerianElements,
+                                               const unsigned int numberOfThreads = 0 );
+
+//! Convert osculating to mean Keplerian elements for set of orbits.
+/*!
+ * Converts osculating to mean Keplerian elements for a set of orbits, with the fixed-size
+ * conversion of convertOsculatingToMeanKeplerianElements() for each orbit. The set of orbits is
+ * divided over multiple threads. The elements of non-elliptical orbits, and of orbits for which
+ * the iteration does not converge, are set to NaN, such that no errors are thrown from the
+ * threads.
+ * \param osculatingKeplerianElements Matrix containing osculating Keplerian elements, with one
+ *          orbit per column (6 x N).
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.                            [-]
+ * \param equatorialRadius Equatorial radius of central body.                                   [m]
+ * \param meanKeplerianElements Matrix in which the mean Keplerian elements are stored (6 x N).
+ *          If the matrix is preallocated with the correct size, no memory is allocated;
+ *          otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \param tolerance Tolerance of the iteration, as for convertOsculatingToMeanKeplerianElements().
+ * \param maximumNumberOfIterations Maximum number of iterations.                               [-]
+ */
+void convertOsculatingToMeanKeplerianElements( const Eigen::MatrixXd& osculatingKeplerianElements,
+                                               const double j2Coefficient,
+                                               const double equatorialRadius,
+                                               Eigen::MatrixXd& meanKeplerianElements,
+                                               const unsigned int numberOfThreads = 0,
+                                               const double tolerance = 1.0e-12,
+                                               const unsigned int maximumNumberOfIterations
+                                               = 20 );
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
+
+#endif // TUDAT_CORE_MEAN_ELEMENT_CONVERSIONS_H
@@ -0,0 +1,408 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Walker, M.J.H., Ireland, B., Owens, J. A set of modified equinoctial orbit elements,
+ *          Celestial Mechanics, 36, 409-419, 1985.
+ *      Betts, J.T. Practical Methods for Optimal Control and Estimation Using Nonlinear
+ *          Programming, 2nd Edition, SIAM, Philadelphia, 2010.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/function.hpp>
+
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/modifiedEquinoctialElementConversions.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/basicMathematicsFunctions.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+namespace
+{
+
+//! Compute unit vectors of equinoctial frame.
+/*!
+ * Computes the unit vectors of the equinoctial frame in the plane of the orbit, from the h and k
+ * modified equinoctial elements (Betts, 2010).
+ * \param hElement h element.
+ * \param kElement k element.
+ * \param unitFVector Unit vector along f direction (returned by reference).
+ * \param unitGVector Unit vector along g direction (returned by reference).
+ */
+void computeEquinoctialFrameUnitVectors( const double hElement, const double kElement,
+                                         Eigen::Vector3d& unitFVector,
+                                         Eigen::Vector3d& unitGVector )
+{
+    const double squaredH_ = hElement * hElement;
+    const double squaredK_ = kElement * kElement;
+    const double inverseOfSquaredS_ = 1.0 / ( 1.0 + squaredH_ + squaredK_ );
+    const double hTimesK_ = hElement * kElement;
+
+    unitFVector << inverseOfSquaredS_ * ( 1.0 - squaredK_ + squaredH_ ),
+            inverseOfSquaredS_ * 2.0 * hTimesK_, -inverseOfSquaredS_ * 2.0 * kElement;
+    unitGVector << inverseOfSquaredS_ * 2.0 * hTimesK_,
+            inverseOfSquaredS_ * ( 1.0 + squaredK_ - squaredH_ ),
+            inverseOfSquaredS_ * 2.0 * hElement;
+}
+
+//! Typedef for function converting elements of a single orbit.
+typedef boost::function< Vector6d( const Vector6d& ) > SingleOrbitConversionFunction;
+
+//! Loop body for conversion of elements for a set of orbits.
+/*!
+ * Loop body for conversion of elements for a set of orbits, to be used with
+ * executeParallelLoop(). Each call converts the elements of a contiguous range of orbits.
+ */
+class BatchModifiedEquinoctialElementConversion
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param singleOrbitConversionFunction Function converting elements of a single orbit.
+     * \param inputElements Matrix containing elements to convert (6 x N).
+     * \param outputElements Matrix in which converted elements are stored (6 x N).
+     */
+    BatchModifiedEquinoctialElementConversion(
+            const SingleOrbitConversionFunction& singleOrbitConversionFunction,
+            const Eigen::MatrixXd& inputElements, Eigen::MatrixXd& outputElements )
+        : singleOrbitConversionFunction_( singleOrbitConversionFunction ),
+          inputElements_( inputElements ),
+          outputElements_( outputElements )
+    { }
+
+    //! Convert range of orbits.
+    /*!
+     * Converts the elements of the orbits in the index range [ startIndex, endIndex ).
+     * \param startIndex Index of first orbit.
+     * \param endIndex One past the index of the last orbit.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        for ( int orbitIndex = startIndex; orbitIndex < endIndex; orbitIndex++ )
+        {
+            outputElements_.col( orbitIndex )
+                    = singleOrbitConversionFunction_( inputElements_.col( orbitIndex ) );
+        }
+    }
+
+private:
+
+    //! Function converting elements of a single orbit.
+    const SingleOrbitConversionFunction singleOrbitConversionFunction_;
+
+    //! Matrix containing elements to convert.
+    const Eigen::MatrixXd& inputElements_;
+
+    //! Matrix in which converted elements are stored.
+    Eigen::MatrixXd& outputElements_;
+};
+
+//! Convert elements for a set of orbits.
+/*!
+ * Converts elements for a set of orbits, divided over multiple threads.
+ * \param singleOrbitConversionFunction Function converting elements of a single orbit.
+ * \param inputElements Matrix containing elements to convert (6 x N).
+ * \param outputElements Matrix in which converted elements are stored (6 x N).
+ * \param numberOfThreads Number of threads to use.
+ */
+void convertElementsOfOrbits( const SingleOrbitConversionFunction& singleOrbitConversionFunction,
+                              const Eigen::MatrixXd& inputElements,
+                              Eigen::MatrixXd& outputElements,
+                              const unsigned int numberOfThreads )
+{
+    // Check if input matrix has the correct number of rows and throw an error if not.
+    if ( inputElements.rows( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Orbital elements matrix should have 6 rows." ) ) );
+    }
+
+    // Resize output matrix; this does not allocate if it already has the correct size.
+    outputElements.resize( 6, inputElements.cols( ) );
+
+    basics::executeParallelLoop(
+                static_cast< int >( inputElements.cols( ) ),
+                BatchModifiedEquinoctialElementConversion( singleOrbitConversionFunction,
+                                                           inputElements, outputElements ),
+                numberOfThreads, 256 );
+}
+
+} // namespace
+
+//! Convert Keplerian to modified equinoctial orbital elements.
+Vector6d convertKeplerianToModifiedEquinoctialElements( const Vector6d& keplerianElements )
+{
+    const double eccentricity_ = keplerianElements( eccentricityIndex );
+    const double longitudeOfAscendingNode_
+            = keplerianElements( longitudeOfAscendingNodeIndex );
+    const double longitudeOfPeriapsis_
+            = keplerianElements( argumentOfPeriapsisIndex ) + longitudeOfAscendingNode_;
+    const double tangentOfHalfInclination_
+            = std::tan( 0.5 * keplerianElements( inclinationIndex ) );
+
+    Vector6d modifiedEquinoctialElements_;
+
+    // Compute semi-latus rectum, which is given as the first element for parabolic orbits.
+    if ( std::fabs( eccentricity_ - 1.0 ) > std::numeric_limits< double >::epsilon( ) )
+    {
+        modifiedEquinoctialElements_( semiLatusRectumIndex )
+                = keplerianElements( semiMajorAxisIndex )
+                * ( 1.0 - eccentricity_ * eccentricity_ );
+    }
+
+    else
+    {
+        modifiedEquinoctialElements_( semiLatusRectumIndex )
+                = keplerianElements( semiMajorAxisIndex );
+    }
+
+    modifiedEquinoctialElements_( fElementIndex )
+            = eccentricity_ * std::cos( longitudeOfPeriapsis_ );
+    modifiedEquinoctialElements_( gElementIndex )
+            = eccentricity_ * std::sin( longitudeOfPeriapsis_ );
+    modifiedEquinoctialElements_( hElementIndex )
+            = tangentOfHalfInclination_ * std::cos( longitudeOfAscendingNode_ );
+    modifiedEquinoctialElements_( kElementIndex )
+            = tangentOfHalfInclination_ * std::sin( longitudeOfAscendingNode_ );
+    modifiedEquinoctialElements_( trueLongitudeIndex ) = basic_mathematics::computeModulo(
+                longitudeOfPeriapsis_ + keplerianElements( trueAnomalyIndex ),
+                2.0 * tudat::basic_mathematics::mathematical_constants::PI );
+
+    return modifiedEquinoctialElements_;
+}
+
+//! Convert modified equinoctial to Keplerian orbital elements.
+Vector6d convertModifiedEquinoctialToKeplerianElements(
+        const Vector6d& modifiedEquinoctialElements )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set tolerance, which is the same as used in convertCartesianToKeplerianElements().
+    const double tolerance_ = 1.0e-15;
+
+    const double fElement_ = modifiedEquinoctialElements( fElementIndex );
+    const double gElement_ = modifiedEquinoctialElements( gElementIndex );
+    const double hElement_ = modifiedEquinoctialElements( hElementIndex );
+    const double kElement_ = modifiedEquinoctialElements( kElementIndex );
+    const double semiLatusRectum_ = modifiedEquinoctialElements( semiLatusRectumIndex );
+
+    const double eccentricity_ = std::sqrt( fElement_ * fElement_ + gElement_ * gElement_ );
+    const double tangentOfHalfInclination_
+            = std::sqrt( hElement_ * hElement_ + kElement_ * kElement_ );
+
+    // Compute longitude of ascending node, which is zero for equatorial orbits.
+    const double longitudeOfAscendingNode_ = ( tangentOfHalfInclination_ < tolerance_ )
+            ? 0.0 : std::atan2( kElement_, hElement_ );
+
+    // Compute longitude of periapsis, for which periapsis is at the ascending node for circular
+    // orbits.
+    const double longitudeOfPeriapsis_ = ( eccentricity_ < tolerance_ )
+            ? longitudeOfAscendingNode_ : std::atan2( gElement_, fElement_ );
+
+    Vector6d keplerianElements_;
+
+    // Compute semi-major axis, for which the semi-latus rectum is used for parabolic orbits.
+    if ( std::fabs( eccentricity_ - 1.0 ) > std::numeric_limits< double >::epsilon( ) )
+    {
+        keplerianElements_( semiMajorAxisIndex )
+                = semiLatusRectum_ / ( ( 1.0 - eccentricity_ ) * ( 1.0 + eccentricity_ ) );
+    }
+
+    else
+    {
+        keplerianElements_( semiMajorAxisIndex ) = semiLatusRectum_;
+    }
+
+    keplerianElements_( eccentricityIndex ) = eccentricity_;
+    keplerianElements_( inclinationIndex ) = 2.0 * std::atan( tangentOfHalfInclination_ );
+    keplerianElements_( argumentOfPeriapsisIndex ) = basic_mathematics::computeModulo(
+                longitudeOfPeriapsis_ - longitudeOfAscendingNode_, 2.0 * PI );
+    keplerianElements_( longitudeOfAscendingNodeIndex ) = basic_mathematics::computeModulo(
+                longitudeOfAscendingNode_, 2.0 * PI );
+    keplerianElements_( trueAnomalyIndex ) = basic_mathematics::computeModulo(
+                modifiedEquinoctialElements( trueLongitudeIndex ) - longitudeOfPeriapsis_,
+                2.0 * PI );
+
+    return keplerianElements_;
+}
+
+//! Convert Cartesian to modified equinoctial orbital elements.
+Vector6d convertCartesianToModifiedEquinoctialElements(
+        const Vector6d& cartesianElements, const double centralBodyGravitationalParameter )
+{
+    using Eigen::Vector3d;
+
+    const Vector3d position_ = cartesianElements.segment< 3 >( xPositionIndex );
+    const Vector3d velocity_ = cartesianElements.segment< 3 >( xVelocityIndex );
+
+    // Compute angular momentum vector and its unit vector.
+    const Vector3d angularMomentum_ = position_.cross( velocity_ );
+    const double angularMomentumNorm_ = angularMomentum_.norm( );
+    const Vector3d unitAngularMomentumVector_ = angularMomentum_ / angularMomentumNorm_;
+
+    Vector6d modifiedEquinoctialElements_;
+
+    modifiedEquinoctialElements_( semiLatusRectumIndex )
+            = angularMomentumNorm_ * angularMomentumNorm_ / centralBodyGravitationalParameter;
+
+    // Compute h and k elements from the direction of the angular momentum vector.
+    const double inverseOfDenominator_ = 1.0 / ( 1.0 + unitAngularMomentumVector_.z( ) );
+    modifiedEquinoctialElements_( hElementIndex )
+            = -unitAngularMomentumVector_.y( ) * inverseOfDenominator_;
+    modifiedEquinoctialElements_( kElementIndex )
+            = unitAngularMomentumVector_.x( ) * inverseOfDenominator_;
+
+    // Compute unit vectors of equinoctial frame.
+    Vector3d unitFVector_;
+    Vector3d unitGVector_;
+    computeEquinoctialFrameUnitVectors( modifiedEquinoctialElements_( hElementIndex ),
+                                        modifiedEquinoctialElements_( kElementIndex ),
+                                        unitFVector_, unitGVector_ );
+
+    // Compute f and g elements as components of the eccentricity vector in equinoctial frame.
+    const Vector3d eccentricityVector_
+            = velocity_.cross( angularMomentum_ ) / centralBodyGravitationalParameter
+            - position_.normalized( );
+    modifiedEquinoctialElements_( fElementIndex ) = eccentricityVector_.dot( unitFVector_ );
+    modifiedEquinoctialElements_( gElementIndex ) = eccentricityVector_.dot( unitGVector_ );
+
+    // Compute true longitude from components of position vector in equinoctial frame.
+    modifiedEquinoctialElements_( trueLongitudeIndex ) = basic_mathematics::computeModulo(
+                std::atan2( position_.dot( unitGVector_ ), position_.dot( unitFVector_ ) ),
+                2.0 * tudat::basic_mathematics::mathematical_constants::PI );
+
+    return modifiedEquinoctialElements_;
+}
+
+//! Convert modified equinoctial to Cartesian orbital elements.
+Vector6d convertModifiedEquinoctialToCartesianElements(
+        const Vector6d& modifiedEquinoctialElements,
+        const double centralBodyGravitationalParameter )
+{
+    using Eigen::Vector3d;
+
+    const double semiLatusRectum_ = modifiedEquinoctialElements( semiLatusRectumIndex );
+    const double fElement_ = modifiedEquinoctialElements( fElementIndex );
+    const double gElement_ = modifiedEquinoctialElements( gElementIndex );
+    const double cosineOfTrueLongitude_
+            = std::cos( modifiedEquinoctialElements( trueLongitudeIndex ) );
+    const double sineOfTrueLongitude_
+            = std::sin( modifiedEquinoctialElements( trueLongitudeIndex ) );
+
+    // Compute unit vectors of equinoctial frame.
+    Vector3d unitFVector_;
+    Vector3d unitGVector_;
+    computeEquinoctialFrameUnitVectors( modifiedEquinoctialElements( hElementIndex ),
+                                        modifiedEquinoctialElements( kElementIndex ),
+                                        unitFVector_, unitGVector_ );
+
+    // Compute radius and velocity scale.
+    const double radius_ = semiLatusRectum_ / ( 1.0 + fElement_ * cosineOfTrueLongitude_
+                                                + gElement_ * sineOfTrueLongitude_ );
+    const double velocityScale_ = std::sqrt( centralBodyGravitationalParameter
+                                             / semiLatusRectum_ );
+
+    Vector6d cartesianElements_;
+    cartesianElements_.segment< 3 >( xPositionIndex )
+            = radius_ * ( cosineOfTrueLongitude_ * unitFVector_
+                          + sineOfTrueLongitude_ * unitGVector_ );
+    cartesianElements_.segment< 3 >( xVelocityIndex )
+            = velocityScale_ * ( -( sineOfTrueLongitude_ + gElement_ ) * unitFVector_
+                                 + ( cosineOfTrueLongitude_ + fElement_ ) * unitGVector_ );
+
+    return cartesianElements_;
+}
+
+//! Convert Keplerian to modified equinoctial orbital elements for set of orbits.
+void convertKeplerianToModifiedEquinoctialElements(
+        const Eigen::MatrixXd& keplerianElements, Eigen::MatrixXd& modifiedEquinoctialElements,
+        const unsigned int numberOfThreads )
+{
+    Vector6d ( *conversionFunction_ )( const Vector6d& )
+            = &convertKeplerianToModifiedEquinoctialElements;
+    convertElementsOfOrbits( conversionFunction_, keplerianElements,
+                             modifiedEquinoctialElements, numberOfThreads );
+}
+
+//! Convert modified equinoctial to Keplerian orbital elements for set of orbits.
+void convertModifiedEquinoctialToKeplerianElements(
+        const Eigen::MatrixXd& modifiedEquinoctialElements, Eigen::MatrixXd& keplerianElements,
+        const unsigned int numberOfThreads )
+{
+    Vector6d ( *conversionFunction_ )( const Vector6d& )
+            = &convertModifiedEquinoctialToKeplerianElements;
+    convertElementsOfOrbits( conversionFunction_, modifiedEquinoctialElements,
+                             keplerianElements, numberOfThreads );
+}
+
+//! Convert Cartesian to modified equinoctial orbital elements for set of orbits.
+void convertCartesianToModifiedEquinoctialElements(
+        const Eigen::MatrixXd& cartesianElements, const double centralBodyGravitationalParameter,
+        Eigen::MatrixXd& modifiedEquinoctialElements, const unsigned int numberOfThreads )
+{
+    Vector6d ( *conversionFunction_ )( const Vector6d&, const double )
+            = &convertCartesianToModifiedEquinoctialElements;
+    convertElementsOfOrbits( boost::bind( conversionFunction_, _1,
+                                          centralBodyGravitationalParameter ),
+                             cartesianElements, modifiedEquinoctialElements, numberOfThreads );
+}
+
+//! Convert modified equinoctial to Cartesian orbital elements for set of orbits.
+void convertModifiedEquinoctialToCartesianElements(
+        const Eigen::MatrixXd& modifiedEquinoctialElements,
+        const double centralBodyGravitationalParameter, Eigen::MatrixXd& cartesianElements,
+        const unsigned int numberOfThreads )
+{
+    Vector6d ( *conversionFunction_ )( const Vector6d&, const double )
+            = &convertModifiedEquinoctialToCartesianElements;
+    convertElementsOfOrbits( boost::bind( conversionFunction_, _1,
+                                          centralBodyGravitationalParameter ),
+                             modifiedEquinoctialElements, cartesianElements, numberOfThreads );
+}
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
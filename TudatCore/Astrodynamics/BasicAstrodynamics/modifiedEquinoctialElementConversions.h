@@ -0,0 +1,207 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Walker, M.J.H., Ireland, B., Owens, J. A set of modified equinoctial orbit elements,
+ *          Celestial Mechanics, 36, 409-419, 1985.
+ *      Betts, J.T. Practical Methods for Optimal Control and Estimation Using Nonlinear
+ *          Programming, 2nd Edition, SIAM, Philadelphia, 2010.
+ *
+ *    Notes
+ *      The modified equinoctial elements used here are those of the direct set (Walker et al.,
+ *      1985), which are non-singular for all elliptical, parabolic and hyperbolic orbits, except
+ *      for orbits with an inclination of exactly 180 degrees. No special cases for circular or
+ *      equatorial orbits are required.
+ *
+ */
+
+#ifndef TUDAT_CORE_MODIFIED_EQUINOCTIAL_ELEMENT_CONVERSIONS_H
+#define TUDAT_CORE_MODIFIED_EQUINOCTIAL_ELEMENT_CONVERSIONS_H
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+//! Modified equinoctial elements indices.
+/*!
+ * Modified equinoctial elements vector indices. The elements are the semi-latus rectum p, the
+ * eccentricity vector components f = e cos( omega + Omega ) and g = e sin( omega + Omega ), the
+ * components of the node vector h = tan( i / 2 ) cos( Omega ) and k = tan( i / 2 ) sin( Omega ),
+ * and the true longitude L = Omega + omega + theta. The semi-latus rectum is stored at
+ * semiLatusRectumIndex, as defined in the KeplerianElementVectorIndices enum.
+ */
+enum ModifiedEquinoctialElementVectorIndices
+{
+    fElementIndex = 1,
+    gElementIndex,
+    hElementIndex,
+    kElementIndex,
+    trueLongitudeIndex
+};
+
+//! Convert Keplerian to modified equinoctial orbital elements.
+/*!
+ * Converts Keplerian to modified equinoctial orbital elements (Walker et al., 1985). For
+ * parabolic orbits, the first Keplerian element is the semi-latus rectum, as for
+ * convertKeplerianToCartesianElements().
+ * \param keplerianElements Vector containing Keplerian elements, ordered as given by the
+ *          KeplerianElementVectorIndices enum.
+ * \return Vector containing modified equinoctial elements, ordered as given by the
+ *          ModifiedEquinoctialElementVectorIndices enum.
+ * \sa KeplerianElementVectorIndices, ModifiedEquinoctialElementVectorIndices.
+ */
+Vector6d convertKeplerianToModifiedEquinoctialElements( const Vector6d& keplerianElements );
+
+//! Convert modified equinoctial to Keplerian orbital elements.
+/*!
+ * Converts modified equinoctial to Keplerian orbital elements (Walker et al., 1985). The
+ * argument of periapsis, longitude of ascending node and true anomaly are given in the range
+ * [0, 2pi). For circular orbits, the argument of periapsis is set to zero; for equatorial orbits,
+ * the longitude of the ascending node is set to zero, as for
+ * convertCartesianToKeplerianElements(). For parabolic orbits, the first Keplerian element is
+ * the semi-latus rectum.
+ * \param modifiedEquinoctialElements Vector containing modified equinoctial elements, ordered
+ *          as given by the ModifiedEquinoctialElementVectorIndices enum.
+ * \return Vector containing Keplerian elements, ordered as given by the
+ *          KeplerianElementVectorIndices enum.
+ * \sa KeplerianElementVectorIndices, ModifiedEquinoctialElementVectorIndices.
+ */
+Vector6d convertModifiedEquinoctialToKeplerianElements(
+        const Vector6d& modifiedEquinoctialElements );
+
+//! Convert Cartesian to modified equinoctial orbital elements.
+/*!
+ * Converts Cartesian to modified equinoctial orbital elements, directly from the angular momentum
+ * and eccentricity vectors expressed in the equinoctial frame (Betts, 2010), without computing
+ * Keplerian elements.
+ * \param cartesianElements Vector containing Cartesian elements, ordered as given by the
+ *          CartesianElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Vector containing modified equinoctial elements, ordered as given by the
+ *          ModifiedEquinoctialElementVectorIndices enum.
+ * \sa CartesianElementVectorIndices, ModifiedEquinoctialElementVectorIndices.
+ */
+Vector6d convertCartesianToModifiedEquinoctialElements(
+        const Vector6d& cartesianElements, const double centralBodyGravitationalParameter );
+
+//! Convert modified equinoctial to Cartesian orbital elements.
+/*!
+ * Converts modified equinoctial to Cartesian orbital elements (Betts, 2010).
+ * \param modifiedEquinoctialElements Vector containing modified equinoctial elements, ordered
+ *          as given by the ModifiedEquinoctialElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Vector containing Cartesian elements, ordered as given by the
+ *          CartesianElementVectorIndices enum.
+ * \sa CartesianElementVectorIndices, ModifiedEquinoctialElementVectorIndices.
+ */
+Vector6d convertModifiedEquinoctialToCartesianElements(
+        const Vector6d& modifiedEquinoctialElements,
+        const double centralBodyGravitationalParameter );
+
+//! Convert Keplerian to modified equinoctial orbital elements for set of orbits.
+/*!
+ * Converts Keplerian to modified equinoctial orbital elements for a set of orbits, by calling
+ * convertKeplerianToModifiedEquinoctialElements() for each orbit. The set of orbits is divided
+ * over multiple threads.
+ * \param keplerianElements Matrix containing Keplerian elements, with one orbit per column
+ *          (6 x N).
+ * \param modifiedEquinoctialElements Matrix in which the modified equinoctial elements are
+ *          stored (6 x N). If the matrix is preallocated with the correct size, no memory is
+ *          allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ */
+void convertKeplerianToModifiedEquinoctialElements(
+        const Eigen::MatrixXd& keplerianElements, Eigen::MatrixXd& modifiedEquinoctialElements,
+        const unsigned int numberOfThreads = 0 );
+
+//! Convert modified equinoctial to Keplerian orbital elements for set of orbits.
+/*!
+ * Converts modified equinoctial to Keplerian orbital elements for a set of orbits, by calling
+ * convertModifiedEquinoctialToKeplerianElements() for each orbit. The set of orbits is divided
+ * over multiple threads.
+ * \param modifiedEquinoctialElements Matrix containing modified equinoctial elements, with one
+ *          orbit per column (6 x N).
+ * \param keplerianElements Matrix in which the Keplerian elements are stored (6 x N). If the
+ *          matrix is preallocated with the correct size, no memory is allocated; otherwise it is
+ *          resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ */
+void convertModifiedEquinoctialToKeplerianElements(
+        const Eigen::MatrixXd& modifiedEquinoctialElements, Eigen::MatrixXd& keplerianElements,
+        const unsigned int numberOfThreads = 0 );
+
+//! Convert Cartesian to modified equinoctial orbital elements for set of orbits.
+/*!
+ * Converts Cartesian to modified equinoctial orbital elements for a set of orbits, by calling
+ * convertCartesianToModifiedEquinoctialElements() for each orbit. The set of orbits is divided
+ * over multiple threads.
+ * \param cartesianElements Matrix containing Cartesian elements, with one orbit per column
+ *          (6 x N).
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param modifiedEquinoctialElements Matrix in which the modified equinoctial elements are
+ *          stored (6 x N). If the matrix is preallocated with the correct size, no memory is
+ *          allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ */
+void convertCartesianToModifiedEquinoctialElements(
+        const Eigen::MatrixXd& cartesianElements, const double centralBodyGravitationalParameter,
+        Eigen::MatrixXd& modifiedEquinoctialElements, const unsigned int numberOfThreads = 0 );
+
+//! Convert modified equinoctial to Cartesian orbital elements for set of orbits.
+/*!
+ * Converts modified equinoctial to Cartesian orbital elements for a set of orbits, by calling
+ * convertModifiedEquinoctialToCartesianElements() for each orbit. The set of orbits is divided
+ * over multiple threads.
+ * \param modifiedEquinoctialElements Matrix containing modified equinoctial elements, with one
+ *          orbit per column (6 x N).
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param cartesianElements Matrix in which the Cartesian elements are stored (6 x N). If the
+ *          matrix is preallocated with the correct size, no memory is allocated; otherwise it is
+ *          resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ */
+void convertModifiedEquinoctialToCartesianElements(
+        const Eigen::MatrixXd& modifiedEquinoctialElements,
+        const double centralBodyGravitationalParameter, Eigen::MatrixXd& cartesianElements,
+        const unsigned int numberOfThreads = 0 );
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
+
+#endif // TUDAT_CORE_MODIFIED_EQUINOCTIAL_ELEMENT_CONVERSIONS_H
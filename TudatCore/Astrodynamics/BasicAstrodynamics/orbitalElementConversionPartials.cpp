@@ -0,0 +1,437 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer,
+ *          Berlin, 2000.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversionPartials.h"
+#include "TudatCore/Basics/parallelLoop.h"
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+namespace
+{
+
+//! Typedef for row vector of partials of a scalar with respect to Cartesian elements.
+typedef Eigen::Matrix< double, 1, 6 > CartesianPartialsRowVector;
+
+//! Compute cross product of z-axis with vector.
+/*!
+ * Computes the cross product of the z-axis with a vector, i.e., the derivative of the vector with
+ * respect to a rotation about the z-axis.
+ * \param vector Vector.
+ * \return Cross product of z-axis with vector.
+ */
+Eigen::Vector3d computeCrossProductOfZAxisWithVector( const Eigen::Vector3d& vector )
+{
+    return Eigen::Vector3d( -vector.y( ), vector.x( ), 0.0 );
+}
+
+//! Compute cross product matrix.
+/*!
+ * Computes the matrix that, when multiplied with a vector b, gives the cross product of the given
+ * vector with b.
+ * \param vector Vector.
+ * \return Cross product matrix.
+ */
+Eigen::Matrix3d computeCrossProductMatrix( const Eigen::Vector3d& vector )
+{
+    Eigen::Matrix3d crossProductMatrix_;
+    crossProductMatrix_ << 0.0, -vector.z( ), vector.y( ),
+            vector.z( ), 0.0, -vector.x( ),
+            -vector.y( ), vector.x( ), 0.0;
+    return crossProductMatrix_;
+}
+
+//! Typedef for function computing partials for a single orbit.
+typedef Matrix6d ( *SingleOrbitPartialsFunction )( const Vector6d&, const double );
+
+//! Loop body for computation of partials for a set of orbits.
+/*!
+ * Loop body for computation of partials for a set of orbits, to be used with
+ * executeParallelLoop(). Each call computes the partials for a contiguous range of orbits.
+ */
+class BatchPartialsComputation
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param singleOrbitPartialsFunction Function computing partials for a single orbit.
+     * \param elements Matrix containing elements of all orbits (6 x N).
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+     * \param partials Matrix in which the partials are stored (6 x 6N).
+     */
+    BatchPartialsComputation( const SingleOrbitPartialsFunction singleOrbitPartialsFunction,
+                              const Eigen::MatrixXd& elements,
+                              const double centralBodyGravitationalParameter,
+                              Eigen::MatrixXd& partials )
+        : singleOrbitPartialsFunction_( singleOrbitPartialsFunction ),
+          elements_( elements ),
+          centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+          partials_( partials )
+    { }
+
+    //! Compute partials for range of orbits.
+    /*!
+     * Computes the partials for the orbits in the index range [ startIndex, endIndex ).
+     * \param startIndex Index of first orbit.
+     * \param endIndex One past the index of the last orbit.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        for ( int orbitIndex = startIndex; orbitIndex < endIndex; orbitIndex++ )
+        {
+            partials_.block< 6, 6 >( 0, 6 * orbitIndex ) = singleOrbitPartialsFunction_(
+                        elements_.col( orbitIndex ), centralBodyGravitationalParameter_ );
+        }
+    }
+
+private:
+
+    //! Function computing partials for a single orbit.
+    const SingleOrbitPartialsFunction singleOrbitPartialsFunction_;
+
+    //! Matrix containing elements of all orbits.
+    const Eigen::MatrixXd& elements_;
+
+    //! Gravitational parameter of central body.
+    const double centralBodyGravitationalParameter_;
+
+    //! Matrix in which the partials are stored.
+    Eigen::MatrixXd& partials_;
+};
+
+//! Compute partials for a set of orbits.
+/*!
+ * Computes partials for a set of orbits, divided over multiple threads.
+ * \param singleOrbitPartialsFunction Function computing partials for a single orbit.
+ * \param elements Matrix containing elements of all orbits (6 x N).
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+ * \param partials Matrix in which the partials are stored (6 x 6N).
+ * \param numberOfThreads Number of threads to use.
+ */
+void computePartialsOfOrbits( const SingleOrbitPartialsFunction singleOrbitPartialsFunction,
+                              const Eigen::MatrixXd& elements,
+                              const double centralBodyGravitationalParameter,
+                              Eigen::MatrixXd& partials, const unsigned int numberOfThreads )
+{
+    // Check if input matrix has the correct number of rows and throw an error if not.
+    if ( elements.rows( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Orbital elements matrix should have 6 rows." ) ) );
+    }
+
+    // Resize output matrix; this does not allocate if it already has the correct size.
+    partials.resize( 6, 6 * elements.cols( ) );
+
+    basics::executeParallelLoop(
+                static_cast< int >( elements.cols( ) ),
+                BatchPartialsComputation( singleOrbitPartialsFunction, elements,
+                                          centralBodyGravitationalParameter, partials ),
+                numberOfThreads, 64 );
+}
+
+} // namespace
+
+//! Compute partials of Cartesian elements with respect to Keplerian elements.
+Matrix6d computePartialsOfCartesianWrtKeplerianElements(
+        const Vector6d& keplerianElements, const double centralBodyGravitationalParameter )
+{
+    using Eigen::Vector3d;
+
+    // Set local Keplerian elements.
+    const double semiMajorAxis_ = keplerianElements( semiMajorAxisIndex );
+    const double eccentricity_ = keplerianElements( eccentricityIndex );
+
+    // Check if eccentricity is invalid or orbit is parabolic and throw an error if true.
+    if ( eccentricity_ < 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Eccentricity is invalid." ) ) );
+    }
+
+    else if ( std::fabs( eccentricity_ - 1.0 ) <= std::numeric_limits< double >::epsilon( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Parabolic orbits have not yet been implemented." ) ) );
+    }
+
+    // Pre-compute sines and cosines of involved angles.
+    const double cosineOfInclination_ = std::cos( keplerianElements( inclinationIndex ) );
+    const double sineOfInclination_ = std::sin( keplerianElements( inclinationIndex ) );
+    const double cosineOfArgumentOfPeriapsis_
+            = std::cos( keplerianElements( argumentOfPeriapsisIndex ) );
+    const double sineOfArgumentOfPeriapsis_
+            = std::sin( keplerianElements( argumentOfPeriapsisIndex ) );
+    const double cosineOfLongitudeOfAscendingNode_
+            = std::cos( keplerianElements( longitudeOfAscendingNodeIndex ) );
+    const double sineOfLongitudeOfAscendingNode_
+            = std::sin( keplerianElements( longitudeOfAscendingNodeIndex ) );
+    const double cosineOfTrueAnomaly_ = std::cos( keplerianElements( trueAnomalyIndex ) );
+    const double sineOfTrueAnomaly_ = std::sin( keplerianElements( trueAnomalyIndex ) );
+
+    // Compute unit vectors pointing to periapsis, along the semi-latus rectum, along the line of
+    // nodes and along the angular momentum.
+    const Vector3d unitPeriapsisVector_(
+                cosineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+                - sineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+                * cosineOfInclination_,
+                sineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+                + cosineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+                * cosineOfInclination_,
+                sineOfArgumentOfPeriapsis_ * sineOfInclination_ );
+    const Vector3d unitSemiLatusRectumVector_(
+                -cosineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+                - sineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+                * cosineOfInclination_,
+                -sineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+                + cosineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+                * cosineOfInclination_,
+                cosineOfArgumentOfPeriapsis_ * sineOfInclination_ );
+    const Vector3d unitLineOfNodesVector_(
+                cosineOfLongitudeOfAscendingNode_, sineOfLongitudeOfAscendingNode_, 0.0 );
+    const Vector3d unitAngularMomentumVector_(
+                sineOfLongitudeOfAscendingNode_ * sineOfInclination_,
+                -cosineOfLongitudeOfAscendingNode_ * sineOfInclination_, cosineOfInclination_ );
+
+    // Compute position and velocity.
+    const double semiLatusRectum_ = semiMajorAxis_ * ( 1.0 - eccentricity_ * eccentricity_ );
+    const double radiusFactor_ = 1.0 + eccentricity_ * cosineOfTrueAnomaly_;
+    const double radius_ = semiLatusRectum_ / radiusFactor_;
+    const double velocityScale_ = std::sqrt( centralBodyGravitationalParameter
+                                             / semiLatusRectum_ );
+
+    const Vector3d position_ = radius_ * ( cosineOfTrueAnomaly_ * unitPeriapsisVector_
+                                           + sineOfTrueAnomaly_ * unitSemiLatusRectumVector_ );
+    const Vector3d velocity_ = velocityScale_
+            * ( -sineOfTrueAnomaly_ * unitPeriapsisVector_
+                + ( eccentricity_ + cosineOfTrueAnomaly_ ) * unitSemiLatusRectumVector_ );
+
+    // Declare partials.
+    Matrix6d partials_;
+
+    // Compute partials with respect to semi-major axis. Position scales with the semi-latus
+    // rectum, and velocity with its inverse square root.
+    partials_.block< 3, 1 >( 0, semiMajorAxisIndex ) = position_ / semiMajorAxis_;
+    partials_.block< 3, 1 >( 3, semiMajorAxisIndex ) = -0.5 * velocity_ / semiMajorAxis_;
+
+    // Compute partials with respect to eccentricity.
+    const double eccentricityTerm_ = eccentricity_
+            / ( ( 1.0 - eccentricity_ ) * ( 1.0 + eccentricity_ ) );
+    partials_.block< 3, 1 >( 0, eccentricityIndex )
+            = -( 2.0 * eccentricityTerm_ + cosineOfTrueAnomaly_ / radiusFactor_ ) * position_;
+    partials_.block< 3, 1 >( 3, eccentricityIndex )
+            = eccentricityTerm_ * velocity_ + velocityScale_ * unitSemiLatusRectumVector_;
+
+    // Compute partials with respect to the orientation angles, which are rotations about the
+    // line of nodes, the angular momentum vector and the z-axis, respectively.
+    partials_.block< 3, 1 >( 0, inclinationIndex ) = unitLineOfNodesVector_.cross( position_ );
+    partials_.block< 3, 1 >( 3, inclinationIndex ) = unitLineOfNodesVector_.cross( velocity_ );
+    partials_.block< 3, 1 >( 0, argumentOfPeriapsisIndex )
+            = unitAngularMomentumVector_.cross( position_ );
+    partials_.block< 3, 1 >( 3, argumentOfPeriapsisIndex )
+            = unitAngularMomentumVector_.cross( velocity_ );
+    partials_.block< 3, 1 >( 0, longitudeOfAscendingNodeIndex )
+            = computeCrossProductOfZAxisWithVector( position_ );
+    partials_.block< 3, 1 >( 3, longitudeOfAscendingNodeIndex )
+            = computeCrossProductOfZAxisWithVector( velocity_ );
+
+    // Compute partials with respect to true anomaly.
+    partials_.block< 3, 1 >( 0, trueAnomalyIndex )
+            = ( eccentricity_ * sineOfTrueAnomaly_ / radiusFactor_ ) * position_
+            + radius_ * ( -sineOfTrueAnomaly_ * unitPeriapsisVector_
+                          + cosineOfTrueAnomaly_ * unitSemiLatusRectumVector_ );
+    partials_.block< 3, 1 >( 3, trueAnomalyIndex )
+            = -velocityScale_ * ( cosineOfTrueAnomaly_ * unitPeriapsisVector_
+                                  + sineOfTrueAnomaly_ * unitSemiLatusRectumVector_ );
+
+    return partials_;
+}
+
+//! Compute partials of Keplerian elements with respect to Cartesian elements.
+Matrix6d computePartialsOfKeplerianWrtCartesianElements(
+        const Vector6d& cartesianElements, const double centralBodyGravitationalParameter )
+{
+    using Eigen::Vector3d;
+
+    // Set local position and velocity.
+    const Vector3d position_ = cartesianElements.segment< 3 >( xPositionIndex );
+    const Vector3d velocity_ = cartesianElements.segment< 3 >( xVelocityIndex );
+
+    // Compute scalar quantities and angular momentum.
+    const double radius_ = position_.norm( );
+    const double radialTerm_ = position_.dot( velocity_ );
+    const Vector3d angularMomentum_ = position_.cross( velocity_ );
+    const double angularMomentumNorm_ = angularMomentum_.norm( );
+    const double squaredAngularMomentumInPlane_
+            = angularMomentum_.x( ) * angularMomentum_.x( )
+            + angularMomentum_.y( ) * angularMomentum_.y( );
+    const double angularMomentumInPlane_ = std::sqrt( squaredAngularMomentumInPlane_ );
+
+    // Compute partials of position components, radius, radial term and angular momentum.
+    CartesianPartialsRowVector radiusPartials_;
+    radiusPartials_ << position_.transpose( ) / radius_, 0.0, 0.0, 0.0;
+
+    CartesianPartialsRowVector radialTermPartials_;
+    radialTermPartials_ << velocity_.transpose( ), position_.transpose( );
+
+    Eigen::Matrix< double, 3, 6 > angularMomentumPartials_;
+    angularMomentumPartials_.leftCols< 3 >( ) = -computeCrossProductMatrix( velocity_ );
+    angularMomentumPartials_.rightCols< 3 >( ) = computeCrossProductMatrix( position_ );
+
+    const CartesianPartialsRowVector angularMomentumNormPartials_
+            = angularMomentum_.transpose( ) * angularMomentumPartials_ / angularMomentumNorm_;
+
+    // Declare partials.
+    Matrix6d partials_;
+
+    // Compute partials of semi-major axis from the vis-viva equation.
+    const double semiMajorAxis_ = 1.0 / ( 2.0 / radius_ - velocity_.squaredNorm( )
+                                          / centralBodyGravitationalParameter );
+    partials_.block< 1, 3 >( semiMajorAxisIndex, 0 ) = 2.0 * semiMajorAxis_ * semiMajorAxis_
+            / ( radius_ * radius_ * radius_ ) * position_.transpose( );
+    partials_.block< 1, 3 >( semiMajorAxisIndex, 3 ) = 2.0 * semiMajorAxis_ * semiMajorAxis_
+            / centralBodyGravitationalParameter * velocity_.transpose( );
+
+    // Compute components of the eccentricity vector along and perpendicular to the position
+    // vector, i.e., e cos( true anomaly ) and e sin( true anomaly ), and their partials.
+    const double scaledInverseRadius_ = 1.0 / ( centralBodyGravitationalParameter * radius_ );
+    const double eccentricityCosineTerm_
+            = angularMomentumNorm_ * angularMomentumNorm_ * scaledInverseRadius_ - 1.0;
+    const double eccentricitySineTerm_
+            = angularMomentumNorm_ * radialTerm_ * scaledInverseRadius_;
+
+    const CartesianPartialsRowVector eccentricityCosineTermPartials_
+            = 2.0 * angularMomentumNorm_ * scaledInverseRadius_ * angularMomentumNormPartials_
+            - ( eccentricityCosineTerm_ + 1.0 ) / radius_ * radiusPartials_;
+    const CartesianPartialsRowVector eccentricitySineTermPartials_
+            = scaledInverseRadius_ * ( radialTerm_ * angularMomentumNormPartials_
+                                       + angularMomentumNorm_ * radialTermPartials_ )
+            - eccentricitySineTerm_ / radius_ * radiusPartials_;
+
+    // Compute partials of eccentricity and true anomaly.
+    const double squaredEccentricity_ = eccentricityCosineTerm_ * eccentricityCosineTerm_
+            + eccentricitySineTerm_ * eccentricitySineTerm_;
+    partials_.row( eccentricityIndex )
+            = ( eccentricityCosineTerm_ * eccentricityCosineTermPartials_
+                + eccentricitySineTerm_ * eccentricitySineTermPartials_ )
+            / std::sqrt( squaredEccentricity_ );
+    const CartesianPartialsRowVector trueAnomalyPartials_
+            = ( eccentricityCosineTerm_ * eccentricitySineTermPartials_
+                - eccentricitySineTerm_ * eccentricityCosineTermPartials_ ) / squaredEccentricity_;
+    partials_.row( trueAnomalyIndex ) = trueAnomalyPartials_;
+
+    // Compute partials of inclination, given by atan2( |h_xy|, h_z ).
+    const CartesianPartialsRowVector angularMomentumInPlanePartials_
+            = ( angularMomentum_.x( ) * angularMomentumPartials_.row( 0 )
+                + angularMomentum_.y( ) * angularMomentumPartials_.row( 1 ) )
+            / angularMomentumInPlane_;
+    partials_.row( inclinationIndex )
+            = ( angularMomentum_.z( ) * angularMomentumInPlanePartials_
+                - angularMomentumInPlane_ * angularMomentumPartials_.row( 2 ) )
+            / ( angularMomentumNorm_ * angularMomentumNorm_ );
+
+    // Compute partials of longitude of ascending node, given by atan2( h_x, -h_y ).
+    partials_.row( longitudeOfAscendingNodeIndex )
+            = ( angularMomentum_.x( ) * angularMomentumPartials_.row( 1 )
+                - angularMomentum_.y( ) * angularMomentumPartials_.row( 0 ) )
+            / squaredAngularMomentumInPlane_;
+
+    // Compute partials of argument of latitude, given by atan2( z h, h_x y - h_y x ), and
+    // subtract partials of true anomaly to obtain those of argument of periapsis.
+    const double argumentOfLatitudeSineTerm_ = position_.z( ) * angularMomentumNorm_;
+    const double argumentOfLatitudeCosineTerm_ = angularMomentum_.x( ) * position_.y( )
+            - angularMomentum_.y( ) * position_.x( );
+
+    CartesianPartialsRowVector argumentOfLatitudeSineTermPartials_
+            = position_.z( ) * angularMomentumNormPartials_;
+    argumentOfLatitudeSineTermPartials_( zPositionIndex ) += angularMomentumNorm_;
+
+    CartesianPartialsRowVector argumentOfLatitudeCosineTermPartials_
+            = position_.y( ) * angularMomentumPartials_.row( 0 )
+            - position_.x( ) * angularMomentumPartials_.row( 1 );
+    argumentOfLatitudeCosineTermPartials_( xPositionIndex ) -= angularMomentum_.y( );
+    argumentOfLatitudeCosineTermPartials_( yPositionIndex ) += angularMomentum_.x( );
+
+    partials_.row( argumentOfPeriapsisIndex )
+            = ( argumentOfLatitudeCosineTerm_ * argumentOfLatitudeSineTermPartials_
+                - argumentOfLatitudeSineTerm_ * argumentOfLatitudeCosineTermPartials_ )
+            / ( argumentOfLatitudeCosineTerm_ * argumentOfLatitudeCosineTerm_
+                + argumentOfLatitudeSineTerm_ * argumentOfLatitudeSineTerm_ )
+            - trueAnomalyPartials_;
+
+    return partials_;
+}
+
+//! Compute partials of Cartesian elements with respect to Keplerian elements for set of orbits.
+void computePartialsOfCartesianWrtKeplerianElements(
+        const Eigen::MatrixXd& keplerianElements, const double centralBodyGravitationalParameter,
+        Eigen::MatrixXd& partials, const unsigned int numberOfThreads )
+{
+    computePartialsOfOrbits( &computePartialsOfCartesianWrtKeplerianElements, keplerianElements,
+                             centralBodyGravitationalParameter, partials, numberOfThreads );
+}
+
+//! Compute partials of Keplerian elements with respect to Cartesian elements for set of orbits.
+void computePartialsOfKeplerianWrtCartesianElements(
+        const Eigen::MatrixXd& cartesianElements, const double centralBodyGravitationalParameter,
+        Eigen::MatrixXd& partials, const unsigned int numberOfThreads )
+{
+    computePartialsOfOrbits( &computePartialsOfKeplerianWrtCartesianElements, cartesianElements,
+                             centralBodyGravitationalParameter, partials, numberOfThreads );
+}
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
@@ -0,0 +1,137 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer,
+ *          Berlin, 2000.
+ *
+ *    Notes
+ *      The partials are not defined for parabolic orbits, and the partials of the Keplerian
+ *      elements with respect to the Cartesian elements are singular for circular and equatorial
+ *      orbits, since some of the angles are undefined for these orbits. No checks are performed
+ *      for the latter, such that the batch functions can be used for catalogs that contain them;
+ *      the corresponding entries are non-finite.
+ *
+ */
+
+#ifndef TUDAT_CORE_ORBITAL_ELEMENT_CONVERSION_PARTIALS_H
+#define TUDAT_CORE_ORBITAL_ELEMENT_CONVERSION_PARTIALS_H
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace basic_astrodynamics
+{
+namespace orbital_element_conversions
+{
+
+//! Compute partials of Cartesian elements with respect to Keplerian elements.
+/*!
+ * Computes the partial derivatives of the Cartesian elements with respect to the Keplerian
+ * elements for elliptical and hyperbolic orbits, in closed form. The partials with respect to the
+ * semi-major axis, eccentricity and true anomaly follow from differentiating the position and
+ * velocity in the perifocal frame. The partials with respect to the inclination, argument of
+ * periapsis and longitude of the ascending node are the cross products of the rotation axes of
+ * these angles (the line of nodes, the angular momentum direction and the z-axis, respectively)
+ * with the position and velocity. An error is thrown for eccentricity < 0.0 and parabolic orbits.
+ * \param keplerianElements Vector containing Keplerian elements, ordered as given by the
+ *          KeplerianElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Matrix of partials, in which entry ( i, j ) is the partial of Cartesian element i with
+ *          respect to Keplerian element j.
+ * \sa KeplerianElementVectorIndices, CartesianElementVectorIndices.
+ */
+Matrix6d computePartialsOfCartesianWrtKeplerianElements(
+        const Vector6d& keplerianElements, const double centralBodyGravitationalParameter );
+
+//! Compute partials of Keplerian elements with respect to Cartesian elements.
+/*!
+ * Computes the partial derivatives of the Keplerian elements with respect to the Cartesian
+ * elements for elliptical and hyperbolic orbits, in closed form. The partials are obtained by
+ * applying the chain rule to the vis-viva equation (semi-major axis), the angular momentum vector
+ * (inclination and longitude of the ascending node), the components of the eccentricity vector
+ * along and perpendicular to the position vector (eccentricity and true anomaly), and the
+ * argument of latitude (argument of periapsis, as argument of latitude minus true anomaly)
+ * (Montenbruck and Gill, 2000). The partials are non-finite for circular and equatorial orbits.
+ * \param cartesianElements Vector containing Cartesian elements, ordered as given by the
+ *          CartesianElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Matrix of partials, in which entry ( i, j ) is the partial of Keplerian element i with
+ *          respect to Cartesian element j.
+ * \sa KeplerianElementVectorIndices, CartesianElementVectorIndices.
+ */
+Matrix6d computePartialsOfKeplerianWrtCartesianElements(
+        const Vector6d& cartesianElements, const double centralBodyGravitationalParameter );
+
+//! Compute partials of Cartesian elements with respect to Keplerian elements for set of orbits.
+/*!
+ * Computes the partial derivatives of the Cartesian elements with respect to the Keplerian
+ * elements for a set of elliptical and hyperbolic orbits, by calling
+ * computePartialsOfCartesianWrtKeplerianElements() for each orbit. The set of orbits is divided
+ * over multiple threads.
+ * \param keplerianElements Matrix containing Keplerian elements, with one orbit per column
+ *          (6 x N), ordered as given by the KeplerianElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param partials Matrix in which the partials are stored (6 x 6N), such that columns 6i to 6i+5
+ *          contain the partials of orbit i. If the matrix is preallocated with the correct size,
+ *          no memory is allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ */
+void computePartialsOfCartesianWrtKeplerianElements(
+        const Eigen::MatrixXd& keplerianElements, const double centralBodyGravitationalParameter,
+        Eigen::MatrixXd& partials, const unsigned int numberOfThreads = 0 );
+
+//! Compute partials of Keplerian elements with respect to Cartesian elements for set of orbits.
+/*!
+ * Computes the partial derivatives of the Keplerian elements with respect to the Cartesian
+ * elements for a set of elliptical and hyperbolic orbits, by calling
+ * computePartialsOfKeplerianWrtCartesianElements() for each orbit. The set of orbits is divided
+ * over multiple threads.
+ * \param cartesianElements Matrix containing Cartesian elements, with one orbit per column
+ *          (6 x N), ordered as given by the CartesianElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param partials Matrix in which the partials are stored (6 x 6N), such that columns 6i to 6i+5
+ *          contain the partials of orbit i. If the matrix is preallocated with the correct size,
+ *          no memory is allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ */
+void computePartialsOfKeplerianWrtCartesianElements(
+        const Eigen::MatrixXd& cartesianElements, const double centralBodyGravitationalParameter,
+        Eigen::MatrixXd& partials, const unsigned int numberOfThreads = 0 );
+
+} // namespace orbital_element_conversions
+} // namespace basic_astrodynamics
+} // namespace tudat
+
+#endif // TUDAT_CORE_ORBITAL_ELEMENT_CONVERSION_PARTIALS_H
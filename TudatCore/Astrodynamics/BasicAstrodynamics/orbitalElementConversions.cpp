@@ -73,6 +73,7 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <numeric>
@@ -80,10 +81,13 @@
 
 #include <boost/exception/all.hpp>
 #include <boost/math/special_functions/atanh.hpp>
+#include <boost/math/special_functions/cbrt.hpp>
 
 #include <Eigen/Geometry>
 
 #include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/basicMathematicsFunctions.h"
 #include "TudatCore/Mathematics/BasicMathematics/linearAlgebra.h"
 #include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
 
@@ -94,9 +98,750 @@ namespace basic_astrodynamics
 namespace orbital_element_conversions
 {
 
+namespace
+{
+
+//! Compute root of cubic approximation of Kepler's equation.
+/*!
+ * Computes the real root of the cubic equation x^3 + a x - b = 0, with a > 0, using Cardano's
+ * formula. This is used to compute the starter value of the iterative solution of Kepler's
+ * equation near periapsis for (near-)parabolic orbits, where Kepler's equation is approximated by
+ * |1 - e| x + e x^3 / 6 = M.
+ * \param linearCoefficient Coefficient a of linear term.
+ * \param constantTerm Constant term b.
+ * \return Real root of cubic equation.
+ */
+double computeRootOfCubicKeplerApproximation( const double linearCoefficient,
+                                              const double constantTerm )
+{
+    const double discriminantRoot_ = std::sqrt(
+                std::pow( linearCoefficient / 3.0, 3.0 ) + 0.25 * constantTerm * constantTerm );
+
+    return boost::math::cbrt( 0.5 * constantTerm + discriminantRoot_ )
+            - boost::math::cbrt( discriminantRoot_ - 0.5 * constantTerm );
+}
+
+//! Compute the difference between an angle and its sine, or its hyperbolic sine.
+/*!
+ * Computes E - sin E, or sinh E - E if isHyperbolic is set to true. For small angles, the Taylor
+ * series is used, since direct evaluation suffers from loss of precision due to cancellation.
+ * \param angle Angle E.
+ * \param isHyperbolic Flag indicating whether sinh E - E is to be computed instead of E - sin E.
+ * \return E - sin E, or sinh E - E.
+ */
+double computeAngleMinusSineOfAngle( const double angle, const bool isHyperbolic )
+{
+    // Use direct evaluation if angle is not small.
+    if ( std::fabs( angle ) >= 0.5 )
+    {
+        return isHyperbolic ? std::sinh( angle ) - angle : angle - std::sin( angle );
+    }
+
+    // Else sum Taylor series until the terms no longer contribute.
+    const double squaredAngle_ = angle * angle;
+    const double signOfSeries_ = isHyperbolic ? 1.0 : -1.0;
+    double term_ = angle * squaredAngle_ / 6.0;
+    double sum_ = term_;
+
+    for ( unsigned int power = 3; std::fabs( term_ )
+          > std::numeric_limits< double >::epsilon( ) * std::fabs( sum_ ); power += 2 )
+    {
+        term_ *= signOfSeries_ * squaredAngle_ / ( ( power + 1.0 ) * ( power + 2.0 ) );
+        sum_ += term_;
+    }
+
+    return sum_;
+}
+
+//! Solve Kepler's equation for non-negative mean anomaly using Halley's method.
+/*!
+ * Solves Kepler's equation for elliptical ( M = E - e sin E ) or hyperbolic
+ * ( M = e sinh E - E ) orbits for non-negative mean anomaly, using Halley's method.
+ * \param meanAnomaly Non-negative mean anomaly (reduced to [ 0, PI ] for elliptical orbits).
+ * \param eccentricity Eccentricity.
+ * \param initialGuess Starter value of the iteration.
+ * \param isHyperbolic Flag indicating whether the orbit is hyperbolic.
+ * \param relativeTolerance Relative convergence tolerance.
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \return Eccentric anomaly.
+ */
+double solveKeplerEquationWithHalleyMethod(
+        const double meanAnomaly, const double eccentricity, const double initialGuess,
+        const bool isHyperbolic, const double relativeTolerance,
+        const unsigned int maximumNumberOfIterations )
+{
+    // Write Kepler's equation as f = |1 - e| E + e ( E - sin E ) - M for elliptical orbits, and as
+    // f = ( e - 1 ) E + e ( sinh E - E ) - M for hyperbolic orbits, to retain precision near
+    // periapsis for eccentricities close to 1.0.
+    const double linearCoefficient_ = std::fabs( 1.0 - eccentricity );
+    double eccentricAnomaly_ = initialGuess;
+
+    for ( unsigned int iteration = 0; iteration < maximumNumberOfIterations; iteration++ )
+    {
+        // Compute function value and its first and second derivatives.
+        double firstDerivative_ = -0.0;
+        double secondDerivative_ = -0.0;
+        if ( isHyperbolic )
+        {
+            firstDerivative_ = eccentricity * std::cosh( eccentricAnomaly_ ) - 1.0;
+            secondDerivative_ = eccentricity * std::sinh( eccentricAnomaly_ );
+        }
+
+        else
+        {
+            firstDerivative_ = 1.0 - eccentricity * std::cos( eccentricAnomaly_ );
+            secondDerivative_ = eccentricity * std::sin( eccentricAnomaly_ );
+        }
+
+        const double functionValue_ = linearCoefficient_ * eccentricAnomaly_
+                + eccentricity * computeAngleMinusSineOfAngle( eccentricAnomaly_, isHyperbolic )
+                - meanAnomaly;
+
+        // Compute Halley step and update eccentric anomaly.
+        const double step_ = -functionValue_ / ( firstDerivative_ - 0.5 * functionValue_
+                                                 * secondDerivative_ / firstDerivative_ );
+        eccentricAnomaly_ += step_;
+
+        // Check for convergence.
+        if ( std::fabs( step_ ) <= relativeTolerance
+             * std::max( 1.0, std::fabs( eccentricAnomaly_ ) ) )
+        {
+            return eccentricAnomaly_;
+        }
+    }
+
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error( "Kepler's equation did not converge." ) ) );
+}
+
+//! Number of orbits per block in batch orbital element conversions.
+const int CONVERSION_BLOCK_SIZE = 16;
+
+//! Typedef for fixed-size array used for blocks in batch orbital element conversions.
+typedef Eigen::Array< double, CONVERSION_BLOCK_SIZE, 1 > ConversionBlockArray;
+
+//! Convert Keplerian to Cartesian orbital elements for a block of orbits.
+/*!
+ * Converts Keplerian to Cartesian orbital elements for a block of at most CONVERSION_BLOCK_SIZE
+ * orbits, using fixed-size arrays. The equations are the same as in
+ * convertKeplerianToCartesianElements().
+ * \param keplerianElements Matrix containing Keplerian elements (6 x N).
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+ * \param startColumn Index of first orbit in block.
+ * \param numberOfColumns Number of orbits in block.
+ * \param cartesianElements Matrix in which converted Cartesian elements are stored (6 x N).
+ */
+void convertKeplerianToCartesianElementsBlock(
+        const Eigen::MatrixXd& keplerianElements, const double centralBodyGravitationalParameter,
+        const int startColumn, const int numberOfColumns, Eigen::MatrixXd& cartesianElements )
+{
+    // Load Keplerian elements into fixed-size arrays. Unused entries of a partial block are set to
+    // a circular orbit with unit semi-major axis, to avoid computations on invalid values.
+    ConversionBlockArray semiMajorAxis_ = ConversionBlockArray::Ones( );
+    ConversionBlockArray eccentricity_ = ConversionBlockArray::Zero( );
+    ConversionBlockArray inclination_ = ConversionBlockArray::Zero( );
+    ConversionBlockArray argumentOfPeriapsis_ = ConversionBlockArray::Zero( );
+    ConversionBlockArray longitudeOfAscendingNode_ = ConversionBlockArray::Zero( );
+    ConversionBlockArray trueAnomaly_ = ConversionBlockArray::Zero( );
+
+    for ( int i = 0; i < numberOfColumns; i++ )
+    {
+        semiMajorAxis_( i ) = keplerianElements( semiMajorAxisIndex, startColumn + i );
+        eccentricity_( i ) = keplerianElements( eccentricityIndex, startColumn + i );
+        inclination_( i ) = keplerianElements( inclinationIndex, startColumn + i );
+        argumentOfPeriapsis_( i ) = keplerianElements( argumentOfPeriapsisIndex, startColumn + i );
+        longitudeOfAscendingNode_( i )
+                = keplerianElements( longitudeOfAscendingNodeIndex, startColumn + i );
+        trueAnomaly_( i ) = keplerianElements( trueAnomalyIndex, startColumn + i );
+    }
+
+    // Pre-compute sines and cosines of involved angles for efficient computation.
+    const ConversionBlockArray cosineOfInclination_ = inclination_.cos( );
+    const ConversionBlockArray sineOfInclination_ = inclination_.sin( );
+    const ConversionBlockArray cosineOfArgumentOfPeriapsis_ = argumentOfPeriapsis_.cos( );
+    const ConversionBlockArray sineOfArgumentOfPeriapsis_ = argumentOfPeriapsis_.sin( );
+    const ConversionBlockArray cosineOfLongitudeOfAscendingNode_
+            = longitudeOfAscendingNode_.cos( );
+    const ConversionBlockArray sineOfLongitudeOfAscendingNode_ = longitudeOfAscendingNode_.sin( );
+    const ConversionBlockArray cosineOfTrueAnomaly_ = trueAnomaly_.cos( );
+    const ConversionBlockArray sineOfTrueAnomaly_ = trueAnomaly_.sin( );
+
+    // Compute semi-latus rectum; for parabolic orbits, it is given as the first element.
+    const ConversionBlockArray semiLatusRectum_
+            = ( ( eccentricity_ - 1.0 ).abs( ) > std::numeric_limits< double >::epsilon( ) )
+            .select( semiMajorAxis_ * ( 1.0 - eccentricity_.square( ) ), semiMajorAxis_ );
+
+    // Compute position and velocity in the perifocal coordinate system.
+    const ConversionBlockArray radius_
+            = semiLatusRectum_ / ( 1.0 + eccentricity_ * cosineOfTrueAnomaly_ );
+    const ConversionBlockArray xPositionPerifocal_ = radius_ * cosineOfTrueAnomaly_;
+    const ConversionBlockArray yPositionPerifocal_ = radius_ * sineOfTrueAnomaly_;
+
+    const ConversionBlockArray velocityScale_
+            = ( centralBodyGravitationalParameter / semiLatusRectum_ ).sqrt( );
+    const ConversionBlockArray xVelocityPerifocal_ = -velocityScale_ * sineOfTrueAnomaly_;
+    const ConversionBlockArray yVelocityPerifocal_
+            = velocityScale_ * ( eccentricity_ + cosineOfTrueAnomaly_ );
+
+    // Compute the transformation matrix entries.
+    const ConversionBlockArray transformation00_
+            = cosineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+            - sineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_ * cosineOfInclination_;
+    const ConversionBlockArray transformation01_
+            = -cosineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+            - sineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_ * cosineOfInclination_;
+    const ConversionBlockArray transformation10_
+            = sineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+            + cosineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_ * cosineOfInclination_;
+    const ConversionBlockArray transformation11_
+            = -sineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+            + cosineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+            * cosineOfInclination_;
+    const ConversionBlockArray transformation20_
+            = sineOfArgumentOfPeriapsis_ * sineOfInclination_;
+    const ConversionBlockArray transformation21_
+            = cosineOfArgumentOfPeriapsis_ * sineOfInclination_;
+
+    // Compute Cartesian position and velocity, and store them.
+    const ConversionBlockArray xPosition_ = transformation00_ * xPositionPerifocal_
+            + transformation01_ * yPositionPerifocal_;
+    const ConversionBlockArray yPosition_ = transformation10_ * xPositionPerifocal_
+            + transformation11_ * yPositionPerifocal_;
+    const ConversionBlockArray zPosition_ = transformation20_ * xPositionPerifocal_
+            + transformation21_ * yPositionPerifocal_;
+    const ConversionBlockArray xVelocity_ = transformation00_ * xVelocityPerifocal_
+            + transformation01_ * yVelocityPerifocal_;
+    const ConversionBlockArray yVelocity_ = transformation10_ * xVelocityPerifocal_
+            + transformation11_ * yVelocityPerifocal_;
+    const ConversionBlockArray zVelocity_ = transformation20_ * xVelocityPerifocal_
+            + transformation21_ * yVelocityPerifocal_;
+
+    for ( int i = 0; i < numberOfColumns; i++ )
+    {
+        cartesianElements( xPositionIndex, startColumn + i ) = xPosition_( i );
+        cartesianElements( yPositionIndex, startColumn + i ) = yPosition_( i );
+        cartesianElements( zPositionIndex, startColumn + i ) = zPosition_( i );
+        cartesianElements( xVelocityIndex, startColumn + i ) = xVelocity_( i );
+        cartesianElements( yVelocityIndex, startColumn + i ) = yVelocity_( i );
+        cartesianElements( zVelocityIndex, startColumn + i ) = zVelocity_( i );
+    }
+}
+
+//! Compute arctangents from sine- and cosine-proportional terms for a block of orbits.
+/*!
+ * Computes the angles whose sines and cosines are proportional to the given terms, using atan2,
+ * which is evaluated per element, since it is not vectorized by Eigen.
+ * \param sineTerms Terms proportional to the sines of the angles.
+ * \param cosineTerms Terms proportional to the cosines of the angles.
+ * \return Angles in the range [-pi, pi].
+ */
+ConversionBlockArray computeBlockOfArcTangents( const ConversionBlockArray& sineTerms,
+                                                const ConversionBlockArray& cosineTerms )
+{
+    ConversionBlockArray angles_;
+    for ( int i = 0; i < CONVERSION_BLOCK_SIZE; i++ )
+    {
+        angles_( i ) = std::atan2( sineTerms( i ), cosineTerms( i ) );
+    }
+
+    return angles_;
+}
+
+//! Compute angle from sine- and cosine-proportional terms for a block of orbits.
+/*!
+ * Computes the angles whose sines and cosines are proportional to the given terms, using atan2,
+ * and maps them to the range [0, 2 pi).
+ * \param sineTerms Terms proportional to the sines of the angles.
+ * \param cosineTerms Terms proportional to the cosines of the angles.
+ * \return Angles in the range [0, 2 pi).
+ */
+ConversionBlockArray computeBlockOfAnglesInFullRange( const ConversionBlockArray& sineTerms,
+                                                      const ConversionBlockArray& cosineTerms )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    const ConversionBlockArray angles_ = computeBlockOfArcTangents( sineTerms, cosineTerms );
+    return ( angles_ < 0.0 ).select( angles_ + 2.0 * PI, angles_ );
+}
+
+//! Convert Cartesian to Keplerian orbital elements for a block of orbits.
+/*!
+ * Converts Cartesian to Keplerian orbital elements for a block of at most CONVERSION_BLOCK_SIZE
+ * orbits, using fixed-size arrays. The elements are computed with the same conventions as in
+ * convertCartesianToKeplerianElements(), but the singular cases are handled by selecting between
+ * the regular and limiting values for all orbits in the block, and all angles are computed with
+ * atan2 from non-normalized vector components. The angles are obtained as:
+ *
+ *  i     = atan2( |z x h|, h_z ),
+ *  Omega = atan2( n_y, n_x ),
+ *  omega = atan2( ( n x e ) . h, |h| ( n . e ) ),
+ *  theta = atan2( ( e x r ) . h, |h| ( e . r ) ),
+ *
+ * where n = z x h is the node vector, which is replaced by the x-axis for equatorial orbits, and
+ * the eccentricity vector e is replaced by n for circular orbits.
+ * \param cartesianElements Matrix containing Cartesian elements (6 x N).
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+ * \param startColumn Index of first orbit in block.
+ * \param numberOfColumns Number of orbits in block.
+ * \param keplerianElements Matrix in which converted Keplerian elements are stored (6 x N).
+ */
+void convertCartesianToKeplerianElementsBlock(
+        const Eigen::MatrixXd& cartesianElements, const double centralBodyGravitationalParameter,
+        const int startColumn, const int numberOfColumns, Eigen::MatrixXd& keplerianElements )
+{
+    // Set tolerance.
+    const double tolerance = 1.0e-15;
+
+    // Load Cartesian elements into fixed-size arrays. Unused entries of a partial block are set to
+    // a non-singular orbit, to avoid computations on invalid values.
+    ConversionBlockArray xPosition_ = ConversionBlockArray::Ones( );
+    ConversionBlockArray yPosition_ = ConversionBlockArray::Zero( );
+    ConversionBlockArray zPosition_ = ConversionBlockArray::Zero( );
+    ConversionBlockArray xVelocity_ = ConversionBlockArray::Zero( );
+    ConversionBlockArray yVelocity_ = ConversionBlockArray::Ones( );
+    ConversionBlockArray zVelocity_ = ConversionBlockArray::Ones( );
+
+    for ( int i = 0; i < numberOfColumns; i++ )
+    {
+        xPosition_( i ) = cartesianElements( xPositionIndex, startColumn + i );
+        yPosition_( i ) = cartesianElements( yPositionIndex, startColumn + i );
+        zPosition_( i ) = cartesianElements( zPositionIndex, startColumn + i );
+        xVelocity_( i ) = cartesianElements( xVelocityIndex, startColumn + i );
+        yVelocity_( i ) = cartesianElements( yVelocityIndex, startColumn + i );
+        zVelocity_( i ) = cartesianElements( zVelocityIndex, startColumn + i );
+    }
+
+    // Compute orbital angular momentum vector and its norm.
+    const ConversionBlockArray xAngularMomentum_
+            = yPosition_ * zVelocity_ - zPosition_ * yVelocity_;
+    const ConversionBlockArray yAngularMomentum_
+            = zPosition_ * xVelocity_ - xPosition_ * zVelocity_;
+    const ConversionBlockArray zAngularMomentum_
+            = xPosition_ * yVelocity_ - yPosition_ * xVelocity_;
+    const ConversionBlockArray angularMomentumInPlane_
+            = ( xAngularMomentum_.square( ) + yAngularMomentum_.square( ) ).sqrt( );
+    const ConversionBlockArray angularMomentum_
+            = ( angularMomentumInPlane_.square( ) + zAngularMomentum_.square( ) ).sqrt( );
+
+    // Compute semi-latus rectum.
+    const ConversionBlockArray semiLatusRectum_
+            = angularMomentum_.square( ) / centralBodyGravitationalParameter;
+
+    // Compute eccentricity vector and eccentricity.
+    const ConversionBlockArray inverseRadius_
+            = ( xPosition_.square( ) + yPosition_.square( ) + zPosition_.square( ) ).rsqrt( );
+    const ConversionBlockArray xEccentricity_
+            = ( yVelocity_ * zAngularMomentum_ - zVelocity_ * yAngularMomentum_ )
+            / centralBodyGravitationalParameter - xPosition_ * inverseRadius_;
+    const ConversionBlockArray yEccentricity_
+            = ( zVelocity_ * xAngularMomentum_ - xVelocity_ * zAngularMomentum_ )
+            / centralBodyGravitationalParameter - yPosition_ * inverseRadius_;
+    const ConversionBlockArray zEccentricity_
+            = ( xVelocity_ * yAngularMomentum_ - yVelocity_ * xAngularMomentum_ )
+            / centralBodyGravitationalParameter - zPosition_ * inverseRadius_;
+    const ConversionBlockArray eccentricity_
+            = ( xEccentricity_.square( ) + yEccentricity_.square( )
+                + zEccentricity_.square( ) ).sqrt( );
+
+    // Compute semi-major axis; for parabolic orbits, the semi-latus rectum is stored instead.
+    const ConversionBlockArray semiMajorAxis_
+            = ( ( eccentricity_ - 1.0 ).abs( ) < tolerance ).select(
+                semiLatusRectum_, semiLatusRectum_ / ( 1.0 - eccentricity_.square( ) ) );
+
+    // Compute node vector, z x h, which is set to the x-axis for equatorial orbits.
+    const Eigen::Array< bool, CONVERSION_BLOCK_SIZE, 1 > isEquatorial_
+            = angularMomentumInPlane_ < tolerance * angularMomentum_;
+    const ConversionBlockArray xNode_
+            = isEquatorial_.select( ConversionBlockArray::Ones( ), -yAngularMomentum_ );
+    const ConversionBlockArray yNode_
+            = isEquatorial_.select( ConversionBlockArray::Zero( ), xAngularMomentum_ );
+
+    // Compute direction of periapsis, which is set to the node vector for circular orbits.
+    const Eigen::Array< bool, CONVERSION_BLOCK_SIZE, 1 > isCircular_ = eccentricity_ < tolerance;
+    const ConversionBlockArray xPeriapsis_ = isCircular_.select( xNode_, xEccentricity_ );
+    const ConversionBlockArray yPeriapsis_ = isCircular_.select( yNode_, yEccentricity_ );
+    const ConversionBlockArray zPeriapsis_
+            = isCircular_.select( ConversionBlockArray::Zero( ), zEccentricity_ );
+
+    // Compute inclination and longitude of ascending node.
+    const ConversionBlockArray inclination_
+            = computeBlockOfAnglesInFullRange( angularMomentumInPlane_, zAngularMomentum_ );
+    const ConversionBlockArray longitudeOfAscendingNode_
+            = computeBlockOfAnglesInFullRange( yNode_, xNode_ );
+
+    // Compute argument of periapsis, from ( n x e ) . h and |h| ( n . e ).
+    const ConversionBlockArray argumentOfPeriapsis_ = computeBlockOfAnglesInFullRange(
+                ( yNode_ * zPeriapsis_ ) * xAngularMomentum_
+                - ( xNode_ * zPeriapsis_ ) * yAngularMomentum_
+                + ( xNode_ * yPeriapsis_ - yNode_ * xPeriapsis_ ) * zAngularMomentum_,
+                angularMomentum_ * ( xNode_ * xPeriapsis_ + yNode_ * yPeriapsis_ ) );
+
+    // Compute true anomaly, from ( e x r ) . h and |h| ( e . r ).
+    const ConversionBlockArray trueAnomaly_ = computeBlockOfAnglesInFullRange(
+                ( yPeriapsis_ * zPosition_ - zPeriapsis_ * yPosition_ ) * xAngularMomentum_
+                + ( zPeriapsis_ * xPosition_ - xPeriapsis_ * zPosition_ ) * yAngularMomentum_
+                + ( xPeriapsis_ * yPosition_ - yPeriapsis_ * xPosition_ ) * zAngularMomentum_,
+                angularMomentum_ * ( xPeriapsis_ * xPosition_ + yPeriapsis_ * yPosition_
+                                     + zPeriapsis_ * zPosition_ ) );
+
+    // Store Keplerian elements.
+    for ( int i = 0; i < numberOfColumns; i++ )
+    {
+        keplerianElements( semiMajorAxisIndex, startColumn + i ) = semiMajorAxis_( i );
+        keplerianElements( eccentricityIndex, startColumn + i ) = eccentricity_( i );
+        keplerianElements( inclinationIndex, startColumn + i ) = inclination_( i );
+        keplerianElements( argumentOfPeriapsisIndex, startColumn + i ) = argumentOfPeriapsis_( i );
+        keplerianElements( longitudeOfAscendingNodeIndex, startColumn + i )
+                = longitudeOfAscendingNode_( i );
+        keplerianElements( trueAnomalyIndex, startColumn + i ) = trueAnomaly_( i );
+    }
+}
+
+//! Typedef for function converting orbital elements for a block of orbits.
+typedef void ( *BlockElementConversionFunction )( const Eigen::MatrixXd&, const double,
+                                                 const int, const int, Eigen::MatrixXd& );
+
+//! Loop body for batch conversion of orbital elements.
+/*!
+ * Loop body for batch conversion of orbital elements, to be used with executeParallelLoop().
+ * Each call converts a contiguous range of blocks of orbits, using the given block conversion
+ * function.
+ */
+class BatchElementConversion
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param blockElementConversionFunction Function converting elements for a block of orbits.
+     * \param inputElements Matrix containing elements to convert (6 x N).
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+     * \param outputElements Matrix in which converted elements are stored (6 x N).
+     */
+    BatchElementConversion( const BlockElementConversionFunction blockElementConversionFunction,
+                            const Eigen::MatrixXd& inputElements,
+                            const double centralBodyGravitationalParameter,
+                            Eigen::MatrixXd& outputElements )
+        : blockElementConversionFunction_( blockElementConversionFunction ),
+          inputElements_( inputElements ),
+          centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+          outputElements_( outputElements )
+    { }
+
+    //! Convert range of blocks.
+    /*!
+     * Converts the blocks of orbits in the index range [ startBlock, endBlock ).
+     * \param startBlock Index of first block.
+     * \param endBlock One past the index of the last block.
+     */
+    void operator( )( const int startBlock, const int endBlock ) const
+    {
+        for ( int block = startBlock; block < endBlock; block++ )
+        {
+            const int startColumn_ = block * CONVERSION_BLOCK_SIZE;
+            blockElementConversionFunction_(
+                        inputElements_, centralBodyGravitationalParameter_, startColumn_,
+                        std::min( CONVERSION_BLOCK_SIZE,
+                                  static_cast< int >( inputElements_.cols( ) ) - startColumn_ ),
+                        outputElements_ );
+        }
+    }
+
+private:
+
+    //! Function converting elements for a block of orbits.
+    const BlockElementConversionFunction blockElementConversionFunction_;
+
+    //! Matrix containing elements to convert.
+    const Eigen::MatrixXd& inputElements_;
+
+    //! Gravitational parameter of central body.
+    const double centralBodyGravitationalParameter_;
+
+    //! Matrix in which converted elements are stored.
+    Eigen::MatrixXd& outputElements_;
+};
+
+//! Convert orbital elements for a set of orbits.
+/*!
+ * Converts orbital elements for a set of orbits, by dividing the orbits into blocks that are
+ * converted with the given block conversion function, possibly in multiple threads.
+ * \param blockElementConversionFunction Function converting elements for a block of orbits.
+ * \param inputElements Matrix containing elements to convert (6 x N).
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+ * \param outputElements Matrix in which converted elements are stored; resized if needed.
+ * \param numberOfThreads Number of threads to use (0 for number of hardware threads).
+ */
+void convertElementsInBlocks( const BlockElementConversionFunction blockElementConversionFunction,
+                              const Eigen::MatrixXd& inputElements,
+                              const double centralBodyGravitationalParameter,
+                              Eigen::MatrixXd& outputElements,
+                              const unsigned int numberOfThreads )
+{
+    // Check if input matrix has the correct number of rows and throw an error if not.
+    if ( inputElements.rows( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Orbital elements matrix should have 6 rows." ) ) );
+    }
+
+    // Resize output matrix; this does not allocate if it already has the correct size.
+    outputElements.resize( 6, inputElements.cols( ) );
+
+    // Convert blocks of orbits, divided over multiple threads.
+    const int numberOfBlocks_ = ( static_cast< int >( inputElements.cols( ) )
+                                  + CONVERSION_BLOCK_SIZE - 1 ) / CONVERSION_BLOCK_SIZE;
+    basics::executeParallelLoop(
+                numberOfBlocks_, BatchElementConversion(
+                    blockElementConversionFunction, inputElements,
+                    centralBodyGravitationalParameter, outputElements ),
+                numberOfThreads, 256 );
+}
+
+//! Compute sines and cosines for a block of angles.
+/*!
+ * Computes sines and cosines for a block of angles. The sine and cosine of each angle are
+ * computed in the same loop iteration, such that the compiler can fuse them into a single sincos
+ * call.
+ * \param angles Angles.
+ * \param sines Sines of angles (returned by reference).
+ * \param cosines Cosines of angles (returned by reference).
+ */
+void computeBlockOfSinesAndCosines( const ConversionBlockArray& angles,
+                                    ConversionBlockArray& sines, ConversionBlockArray& cosines )
+{
+    for ( int i = 0; i < CONVERSION_BLOCK_SIZE; i++ )
+    {
+        sines( i ) = std::sin( angles( i ) );
+        cosines( i ) = std::cos( angles( i ) );
+    }
+}
+
+//! Compute hyperbolic sines and cosines for a block of angles.
+/*!
+ * Computes hyperbolic sines and cosines for a block of angles, using vectorized exponentials.
+ * To avoid cancellation for small angles, the hyperbolic sine is computed from its Taylor series
+ * for angles with a magnitude smaller than 0.5.
+ * \param angles Angles.
+ * \param hyperbolicSines Hyperbolic sines of angles (returned by reference).
+ * \param hyperbolicCosines Hyperbolic cosines of angles (returned by reference).
+ */
+void computeBlockOfHyperbolicSinesAndCosines( const ConversionBlockArray& angles,
+                                              ConversionBlockArray& hyperbolicSines,
+                                              ConversionBlockArray& hyperbolicCosines )
+{
+    const ConversionBlockArray exponential_ = angles.exp( );
+    const ConversionBlockArray inverseExponential_ = ( -angles ).exp( );
+
+    // Compute Taylor series of sinh( x ) / x = 1 + x^2 / 3! + x^4 / 5! + ..., up to x^14 / 15!,
+    // which is accurate to machine precision for |x| < 0.5.
+    const ConversionBlockArray squaredAngles_ = angles.square( );
+    ConversionBlockArray series_ = ConversionBlockArray::Ones( );
+    for ( int power = 14; power >= 2; power -= 2 )
+    {
+        series_ = 1.0 + squaredAngles_ * series_ / ( power * ( power + 1.0 ) );
+    }
+
+    hyperbolicSines = ( angles.abs( ) < 0.5 ).select(
+                angles * series_, 0.5 * ( exponential_ - inverseExponential_ ) );
+    hyperbolicCosines = 0.5 * ( exponential_ + inverseExponential_ );
+}
+
+//! Compute inverse hyperbolic tangents for a block of arguments.
+/*!
+ * Computes inverse hyperbolic tangents for a block of arguments, using vectorized logarithms.
+ * To avoid cancellation for small arguments, the inverse hyperbolic tangent is computed from its
+ * Taylor series for arguments with a magnitude smaller than 0.1.
+ * \param arguments Arguments, with magnitude smaller than 1.
+ * \return Inverse hyperbolic tangents of arguments.
+ */
+ConversionBlockArray computeBlockOfInverseHyperbolicTangents(
+        const ConversionBlockArray& arguments )
+{
+    // Compute Taylor series of atanh( x ) / x = 1 + x^2 / 3 + x^4 / 5 + ..., up to x^16 / 17,
+    // which is accurate to machine precision for |x| < 0.1.
+    const ConversionBlockArray squaredArguments_ = arguments.square( );
+    ConversionBlockArray series_ = ConversionBlockArray::Constant( 1.0 / 17.0 );
+    for ( int power = 15; power >= 1; power -= 2 )
+    {
+        series_ = 1.0 / power + squaredArguments_ * series_;
+    }
+
+    return ( arguments.abs( ) < 0.1 ).select(
+                arguments * series_, 0.5 * ( ( 1.0 + arguments ) / ( 1.0 - arguments ) ).log( ) );
+}
+
+//! Convert true anomaly to eccentric anomaly for a block of orbits.
+/*!
+ * Converts true anomaly to eccentric anomaly for a block of elliptical and hyperbolic orbits,
+ * using the same equations as convertTrueAnomalyToEccentricAnomaly(). Both equations are
+ * evaluated for the full block, after which the result is selected per orbit.
+ * \param trueAnomalies True anomalies.
+ * \param eccentricities Eccentricities.
+ * \return Eccentric anomalies.
+ */
+ConversionBlockArray convertTrueAnomalyToEccentricAnomalyBlock(
+        const ConversionBlockArray& trueAnomalies, const ConversionBlockArray& eccentricities )
+{
+    ConversionBlockArray sineOfTrueAnomaly_;
+    ConversionBlockArray cosineOfTrueAnomaly_;
+    computeBlockOfSinesAndCosines( trueAnomalies, sineOfTrueAnomaly_, cosineOfTrueAnomaly_ );
+
+    // Compute terms proportional to the (hyperbolic) sine and cosine of the eccentric anomaly.
+    const ConversionBlockArray sineTerm_
+            = ( ( 1.0 - eccentricities ) * ( 1.0 + eccentricities ) ).abs( ).sqrt( )
+            * sineOfTrueAnomaly_;
+    const ConversionBlockArray cosineTerm_ = eccentricities + cosineOfTrueAnomaly_;
+
+    return ( eccentricities > 1.0 ).select(
+                computeBlockOfInverseHyperbolicTangents( sineTerm_ / cosineTerm_ ),
+                computeBlockOfArcTangents( sineTerm_, cosineTerm_ ) );
+}
+
+//! Convert eccentric anomaly to true anomaly for a block of orbits.
+/*!
+ * Converts eccentric anomaly to true anomaly for a block of elliptical and hyperbolic orbits,
+ * using the same equations as convertEccentricAnomalyToTrueAnomaly(). Both equations are
+ * evaluated for the full block, after which the result is selected per orbit.
+ * \param eccentricAnomalies Eccentric anomalies.
+ * \param eccentricities Eccentricities.
+ * \return True anomalies.
+ */
+ConversionBlockArray convertEccentricAnomalyToTrueAnomalyBlock(
+        const ConversionBlockArray& eccentricAnomalies,
+        const ConversionBlockArray& eccentricities )
+{
+    ConversionBlockArray sineOfEccentricAnomaly_;
+    ConversionBlockArray cosineOfEccentricAnomaly_;
+    computeBlockOfSinesAndCosines( eccentricAnomalies, sineOfEccentricAnomaly_,
+                                   cosineOfEccentricAnomaly_ );
+
+    ConversionBlockArray hyperbolicSineOfEccentricAnomaly_;
+    ConversionBlockArray hyperbolicCosineOfEccentricAnomaly_;
+    computeBlockOfHyperbolicSinesAndCosines( eccentricAnomalies,
+                                             hyperbolicSineOfEccentricAnomaly_,
+                                             hyperbolicCosineOfEccentricAnomaly_ );
+
+    // Compute terms proportional to the sine and cosine of the true anomaly.
+    const Eigen::Array< bool, CONVERSION_BLOCK_SIZE, 1 > isHyperbolic_ = eccentricities > 1.0;
+    const ConversionBlockArray sineTerm_
+            = ( ( 1.0 - eccentricities ) * ( 1.0 + eccentricities ) ).abs( ).sqrt( )
+            * isHyperbolic_.select( hyperbolicSineOfEccentricAnomaly_, sineOfEccentricAnomaly_ );
+    const ConversionBlockArray cosineTerm_ = isHyperbolic_.select(
+                eccentricities - hyperbolicCosineOfEccentricAnomaly_,
+                cosineOfEccentricAnomaly_ - eccentricities );
+
+    return computeBlockOfArcTangents( sineTerm_, cosineTerm_ );
+}
+
+//! Convert eccentric anomaly to mean anomaly for a block of orbits.
+/*!
+ * Converts eccentric anomaly to mean anomaly for a block of elliptical and hyperbolic orbits,
+ * using the same equations as convertEccentricAnomalyToMeanAnomaly(). Both equations are
+ * evaluated for the full block, after which the result is selected per orbit.
+ * \param eccentricAnomalies Eccentric anomalies.
+ * \param eccentricities Eccentricities.
+ * \return Mean anomalies.
+ */
+ConversionBlockArray convertEccentricAnomalyToMeanAnomalyBlock(
+        const ConversionBlockArray& eccentricAnomalies,
+        const ConversionBlockArray& eccentricities )
+{
+    ConversionBlockArray sineOfEccentricAnomaly_;
+    ConversionBlockArray cosineOfEccentricAnomaly_;
+    computeBlockOfSinesAndCosines( eccentricAnomalies, sineOfEccentricAnomaly_,
+                                   cosineOfEccentricAnomaly_ );
+
+    ConversionBlockArray hyperbolicSineOfEccentricAnomaly_;
+    ConversionBlockArray hyperbolicCosineOfEccentricAnomaly_;
+    computeBlockOfHyperbolicSinesAndCosines( eccentricAnomalies,
+                                             hyperbolicSineOfEccentricAnomaly_,
+                                             hyperbolicCosineOfEccentricAnomaly_ );
+
+    return ( eccentricities > 1.0 ).select(
+                eccentricities * hyperbolicSineOfEccentricAnomaly_ - eccentricAnomalies,
+                eccentricAnomalies - eccentricities * sineOfEccentricAnomaly_ );
+}
+
+//! Typedef for function converting anomalies for a block of orbits.
+typedef ConversionBlockArray ( *BlockAnomalyConversionFunction )(
+        const ConversionBlockArray&, const ConversionBlockArray& );
+
+//! Convert anomalies for a set of orbits.
+/*!
+ * Converts anomalies for a set of elliptical and hyperbolic orbits, by dividing the orbits into
+ * blocks that are converted with the given block conversion function. Unused entries of a
+ * partial block are set to a zero anomaly on a circular orbit.
+ * \param blockAnomalyConversionFunction Function converting anomalies for a block of orbits.
+ * \param anomalies Anomalies to convert.
+ * \param eccentricities Eccentricities.
+ * \return Converted anomalies.
+ */
+Eigen::ArrayXd convertAnomaliesInBlocks(
+        const BlockAnomalyConversionFunction blockAnomalyConversionFunction,
+        const Eigen::ArrayXd& anomalies, const Eigen::ArrayXd& eccentricities )
+{
+    // Check if input arrays are of equal size and throw an error if not.
+    if ( anomalies.rows( ) != eccentricities.rows( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Number of anomalies and eccentricities is not equal." ) ) );
+    }
+
+    // Check if eccentricities are invalid or parabolic and throw an error if true.
+    if ( ( eccentricities < 0.0 ).any( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Eccentricity is invalid." ) ) );
+    }
+
+    if ( ( ( eccentricities - 1.0 ).abs( ) < std::numeric_limits< double >::epsilon( ) ).any( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Parabolic orbits have not yet been implemented." ) ) );
+    }
+
+    // Convert blocks of anomalies.
+    const int numberOfAnomalies_ = static_cast< int >( anomalies.rows( ) );
+    Eigen::ArrayXd convertedAnomalies_( numberOfAnomalies_ );
+    for ( int startIndex = 0; startIndex < numberOfAnomalies_;
+          startIndex += CONVERSION_BLOCK_SIZE )
+    {
+        const int blockSize_ = std::min( CONVERSION_BLOCK_SIZE, numberOfAnomalies_ - startIndex );
+
+        ConversionBlockArray anomalies_ = ConversionBlockArray::Zero( );
+        ConversionBlockArray eccentricities_ = ConversionBlockArray::Zero( );
+        anomalies_.head( blockSize_ ) = anomalies.segment( startIndex, blockSize_ );
+        eccentricities_.head( blockSize_ ) = eccentricities.segment( startIndex, blockSize_ );
+
+        convertedAnomalies_.segment( startIndex, blockSize_ )
+                = blockAnomalyConversionFunction( anomalies_, eccentricities_ ).head( blockSize_ );
+    }
+
+    return convertedAnomalies_;
+}
+
+} // namespace
+
 //! Convert Keplerian to Cartesian orbital elements.
 Eigen::VectorXd convertKeplerianToCartesianElements(
         const Eigen::VectorXd& keplerianElements, const double centralBodyGravitationalParameter )
+{
+    return convertKeplerianToCartesianElements( Vector6d( keplerianElements ),
+                                                centralBodyGravitationalParameter );
+}
+
+//! Convert Keplerian to Cartesian orbital elements, using fixed-size vectors.
+Vector6d convertKeplerianToCartesianElements( const Vector6d& keplerianElements,
+                                              const double centralBodyGravitationalParameter )
 {
     using std::cos;
     using std::fabs;
@@ -139,7 +884,7 @@ Eigen::VectorXd convertKeplerianToCartesianElements(
     else  { semiLatusRectum_ = semiMajorAxis_; }
 
     // Definition of position in the perifocal coordinate system.
-    Vector2d positionPerifocal_ = Eigen::Vector2d::Zero( 2 );
+    Vector2d positionPerifocal_ = Eigen::Vector2d::Zero( );
     positionPerifocal_.x( ) = semiLatusRectum_ * cosineOfTrueAnomaly_
             / ( 1.0 + eccentricity_ * cosineOfTrueAnomaly_ );
     positionPerifocal_.y( ) = semiLatusRectum_ * sineOfTrueAnomaly_
@@ -152,7 +897,7 @@ Eigen::VectorXd convertKeplerianToCartesianElements(
                 * ( eccentricity_ + cosineOfTrueAnomaly_ ) );
 
     // Definition of the transformation matrix.
-    Eigen::MatrixXd transformationMatrix_ = Eigen::MatrixXd::Zero( 3, 2 );
+    Eigen::Matrix< double, 3, 2 > transformationMatrix_ = Eigen::Matrix< double, 3, 2 >::Zero( );
 
     // Compute the transformation matrix.
     transformationMatrix_( 0, 0 ) = cosineOfLongitudeOfAscendingNode_
@@ -171,7 +916,7 @@ Eigen::VectorXd convertKeplerianToCartesianElements(
     transformationMatrix_( 2, 1 ) = cosineOfArgumentOfPeriapsis_ * sineOfInclination_;
 
     // Declare converted Cartesian elements.
-    Eigen::VectorXd convertedCartesianElements_ = Eigen::VectorXd::Zero( 6 );
+    Vector6d convertedCartesianElements_ = Vector6d::Zero( );
 
     // Compute value of position in Cartesian coordinates.
     Vector3d position_ = transformationMatrix_ * positionPerifocal_;
@@ -185,15 +930,34 @@ Eigen::VectorXd convertKeplerianToCartesianElements(
     return convertedCartesianElements_;
 }
 
+//! Convert Keplerian to Cartesian orbital elements for a set of orbits.
+void convertKeplerianToCartesianElements( const Eigen::MatrixXd& keplerianElements,
+                                          const double centralBodyGravitationalParameter,
+                                          Eigen::MatrixXd& cartesianElements,
+                                          const unsigned int numberOfThreads )
+{
+    convertElementsInBlocks( &convertKeplerianToCartesianElementsBlock, keplerianElements,
+                             centralBodyGravitationalParameter, cartesianElements,
+                             numberOfThreads );
+}
+
 //! Convert Cartesian to Keplerian orbital elements.
 Eigen::VectorXd convertCartesianToKeplerianElements(
         const Eigen::VectorXd& cartesianElements, const double centralBodyGravitationalParameter )
+{
+    return convertCartesianToKeplerianElements( Vector6d( cartesianElements ),
+                                                centralBodyGravitationalParameter );
+}
+
+//! Convert Cartesian to Keplerian orbital elements, using fixed-size vectors.
+Vector6d convertCartesianToKeplerianElements( const Vector6d& cartesianElements,
+                                              const double centralBodyGravitationalParameter )
 {
     // Set tolerance.
     const double tolerance = 1.0e-15;
 
     // Declare converted Keplerian elements.
-    Eigen::VectorXd computedKeplerianElements_ = Eigen::VectorXd::Zero( 6 );
+    Vector6d computedKeplerianElements_ = Vector6d::Zero( );
 
     // Set position and velocity vectors.
     const Eigen::Vector3d position_( cartesianElements.segment( 0, 3 ) );
@@ -344,9 +1108,114 @@ Eigen::VectorXd convertCartesianToKeplerianElements(
     return computedKeplerianElements_;
 }
 
+//! Convert Cartesian to Keplerian orbital elements for a set of orbits.
+void convertCartesianToKeplerianElements( const Eigen::MatrixXd& cartesianElements,
+                                          const double centralBodyGravitationalParameter,
+                                          Eigen::MatrixXd& keplerianElements,
+                                          const unsigned int numberOfThreads )
+{
+    convertElementsInBlocks( &convertCartesianToKeplerianElementsBlock, cartesianElements,
+                             centralBodyGravitationalParameter, keplerianElements,
+                             numberOfThreads );
+}
+
 //! Convert true anomaly to (elliptic) eccentric anomaly.
 double convertTrueAnomalyToEllipticalEccentricAnomaly( const double trueAnomaly,
                                                        const double eccentricity )
+{
+    return convertTrueAnomalyToEllipticalEccentricAnomaly< ThrowOnInvalidInput >(
+                trueAnomaly, eccentricity );
+}
+
+//! Convert true anomaly to hyperbolic eccentric anomaly.
+double convertTrueAnomalyToHyperbolicEccentricAnomaly( const double trueAnomaly,
+                                                       const double eccentricity )
+{
+    return convertTrueAnomalyToHyperbolicEccentricAnomaly< ThrowOnInvalidInput >(
+                trueAnomaly, eccentricity );
+}
+
+//! Convert true anomaly to eccentric anomaly.
+double convertTrueAnomalyToEccentricAnomaly( const double trueAnomaly,
+                                             const double eccentricity )
+{
+    return convertTrueAnomalyToEccentricAnomaly< ThrowOnInvalidInput >( trueAnomaly, eccentricity );
+}
+
+//! Convert (elliptic) eccentric anomaly to true anomaly.
+double convertEllipticalEccentricAnomalyToTrueAnomaly( const double ellipticEccentricAnomaly,
+                                                       const double eccentricity )
+{
+    return convertEllipticalEccentricAnomalyToTrueAnomaly< ThrowOnInvalidInput >(
+                ellipticEccentricAnomaly, eccentricity );
+}
+
+//! Convert hyperbolic eccentric anomaly to true anomaly.
+double convertHyperbolicEccentricAnomalyToTrueAnomaly( const double hyperbolicEccentricAnomaly,
+                                                       const double eccentricity )
+{
+    return convertHyperbolicEccentricAnomalyToTrueAnomaly< ThrowOnInvalidInput >(
+                hyperbolicEccentricAnomaly, eccentricity );
+}
+
+//! Convert eccentric anomaly to true anomaly.
+double convertEccentricAnomalyToTrueAnomaly( const double eccentricAnomaly,
+                                             const double eccentricity )
+{
+    return convertEccentricAnomalyToTrueAnomaly< ThrowOnInvalidInput >(
+                eccentricAnomaly, eccentricity );
+}
+
+//! Convert (elliptical) eccentric anomaly to mean anomaly.
+double convertEllipticalEccentricAnomalyToMeanAnomaly( const double ellipticalEccentricAnomaly,
+                                                       const double eccentricity )
+{
+    return ellipticalEccentricAnomaly - eccentricity * std::sin( ellipticalEccentricAnomaly );
+}
+
+//! Convert hyperbolic eccentric anomaly to mean anomaly.
+double convertHyperbolicEccentricAnomalyToMeanAnomaly(
+    const double hyperbolicEccentricAnomaly, const double eccentricity )
+{
+    return eccentricity * std::sinh( hyperbolicEccentricAnomaly ) - hyperbolicEccentricAnomaly;
+}
+
+//! Convert eccentric anomaly to mean anomaly.
+double convertEccentricAnomalyToMeanAnomaly( const double eccentricAnomaly,
+                                             const double eccentricity )
+{
+    return convertEccentricAnomalyToMeanAnomaly< ThrowOnInvalidInput >(
+                eccentricAnomaly, eccentricity );
+}
+
+//! Convert true anomaly to eccentric anomaly for a set of orbits.
+Eigen::ArrayXd convertTrueAnomalyToEccentricAnomaly( const Eigen::ArrayXd& trueAnomalies,
+                                                     const Eigen::ArrayXd& eccentricities )
+{
+    return convertAnomaliesInBlocks( &convertTrueAnomalyToEccentricAnomalyBlock,
+                                     trueAnomalies, eccentricities );
+}
+
+//! Convert eccentric anomaly to true anomaly for a set of orbits.
+Eigen::ArrayXd convertEccentricAnomalyToTrueAnomaly( const Eigen::ArrayXd& eccentricAnomalies,
+                                                     const Eigen::ArrayXd& eccentricities )
+{
+    return convertAnomaliesInBlocks( &convertEccentricAnomalyToTrueAnomalyBlock,
+                                     eccentricAnomalies, eccentricities );
+}
+
+//! Convert eccentric anomaly to mean anomaly for a set of orbits.
+Eigen::ArrayXd convertEccentricAnomalyToMeanAnomaly( const Eigen::ArrayXd& eccentricAnomalies,
+                                                     const Eigen::ArrayXd& eccentricities )
+{
+    return convertAnomaliesInBlocks( &convertEccentricAnomalyToMeanAnomalyBlock,
+                                     eccentricAnomalies, eccentricities );
+}
+
+//! Convert mean anomaly to (elliptical) eccentric anomaly.
+double convertMeanAnomalyToEllipticalEccentricAnomaly(
+        const double ellipticalMeanAnomaly, const double eccentricity,
+        const double relativeTolerance, const unsigned int maximumNumberOfIterations )
 {
     if ( eccentricity >= 1.0 || eccentricity < 0.0 )
     {
@@ -357,23 +1226,40 @@ double convertTrueAnomalyToEllipticalEccentricAnomaly( const double trueAnomaly,
 
     else
     {
-        using std::cos;
-        using std::sqrt;
+        using tudat::basic_mathematics::mathematical_constants::PI;
+
+        // Reduce mean anomaly to [ -PI, PI ] and solve for its absolute value, which is allowed
+        // due to the symmetry of Kepler's equation.
+        const double reducedMeanAnomaly_
+                = basic_mathematics::computeModulo( ellipticalMeanAnomaly + PI, 2.0 * PI ) - PI;
+        const double absoluteMeanAnomaly_ = std::fabs( reducedMeanAnomaly_ );
+
+        // Compute starter value. Near periapsis of high-eccentricity orbits, use the cubic
+        // approximation of Kepler's equation.
+        double initialGuess_ = absoluteMeanAnomaly_ + 0.85 * eccentricity;
+        if ( eccentricity > 0.8 && absoluteMeanAnomaly_ < 0.5 )
+        {
+            initialGuess_ = computeRootOfCubicKeplerApproximation(
+                        6.0 * ( 1.0 - eccentricity ) / eccentricity,
+                        6.0 * absoluteMeanAnomaly_ / eccentricity );
+        }
 
-        // Declare and compute sine and cosine of eccentric anomaly.
-        double sineOfEccentricAnomaly_ = sqrt( 1.0 - std::pow( eccentricity, 2.0 ) )
-                * std::sin( trueAnomaly ) / ( 1.0 + eccentricity * cos( trueAnomaly ) );
-        double cosineOfEccentricAnomaly_ = ( eccentricity + cos( trueAnomaly ) )
-                / ( 1.0 + eccentricity * cos( trueAnomaly ) );
+        // Solve Kepler's equation.
+        const double absoluteEccentricAnomaly_ = solveKeplerEquationWithHalleyMethod(
+                    absoluteMeanAnomaly_, eccentricity, initialGuess_, false,
+                    relativeTolerance, maximumNumberOfIterations );
 
-        // Return elliptic eccentric anomaly.
-        return std::atan2( sineOfEccentricAnomaly_, cosineOfEccentricAnomaly_ );
+        // Restore sign and number of revolutions of the mean anomaly.
+        return ( reducedMeanAnomaly_ < 0.0 ? -absoluteEccentricAnomaly_
+                                           : absoluteEccentricAnomaly_ )
+                + ( ellipticalMeanAnomaly - reducedMeanAnomaly_ );
     }
 }
 
-//! Convert true anomaly to hyperbolic eccentric anomaly.
-double convertTrueAnomalyToHyperbolicEccentricAnomaly( const double trueAnomaly,
-                                                       const double eccentricity )
+//! Convert mean anomaly to hyperbolic eccentric anomaly.
+double convertMeanAnomalyToHyperbolicEccentricAnomaly(
+        const double hyperbolicMeanAnomaly, const double eccentricity,
+        const double relativeTolerance, const unsigned int maximumNumberOfIterations )
 {
     if ( eccentricity <= 1.0 )
     {
@@ -384,25 +1270,35 @@ double convertTrueAnomalyToHyperbolicEccentricAnomaly( const double trueAnomaly,
 
     else
     {
-        using std::cos;
-
-        // Compute hyperbolic sine and hyperbolic cosine of hyperbolic eccentric anomaly.
-        double hyperbolicSineOfHyperbolicEccentricAnomaly_
-                = std::sqrt( std::pow( eccentricity, 2.0 ) - 1.0 )
-                * std::sin( trueAnomaly ) / ( 1.0 + cos( trueAnomaly ) );
+        // Solve for absolute value of mean anomaly, which is allowed due to the symmetry of
+        // Kepler's equation.
+        const double absoluteMeanAnomaly_ = std::fabs( hyperbolicMeanAnomaly );
+
+        // Compute starter value. For low mean anomalies of near-parabolic orbits, use the cubic
+        // approximation of Kepler's equation.
+        double initialGuess_ = std::log( 2.0 * absoluteMeanAnomaly_ / eccentricity + 1.8 );
+        if ( eccentricity < 1.6 && absoluteMeanAnomaly_ < 1.0 )
+        {
+            initialGuess_ = computeRootOfCubicKeplerApproximation(
+                        6.0 * ( eccentricity - 1.0 ) / eccentricity,
+                        6.0 * absoluteMeanAnomaly_ / eccentricity );
+        }
 
-        double hyperbolicCosineOfHyperbolicEccentricAnomaly_
-                = ( cos( trueAnomaly ) + eccentricity ) / ( 1.0 + cos( trueAnomaly ) );
+        // Solve Kepler's equation.
+        const double absoluteEccentricAnomaly_ = solveKeplerEquationWithHalleyMethod(
+                    absoluteMeanAnomaly_, eccentricity, initialGuess_, true,
+                    relativeTolerance, maximumNumberOfIterations );
 
-        // Return hyperbolic eccentric anomaly.
-        return boost::math::atanh( hyperbolicSineOfHyperbolicEccentricAnomaly_
-                      / hyperbolicCosineOfHyperbolicEccentricAnomaly_ );
+        // Restore sign of the mean anomaly.
+        return hyperbolicMeanAnomaly < 0.0 ? -absoluteEccentricAnomaly_
+                                           : absoluteEccentricAnomaly_;
     }
 }
 
-//! Convert true anomaly to eccentric anomaly.
-double convertTrueAnomalyToEccentricAnomaly( const double trueAnomaly,
-                                             const double eccentricity )
+//! Convert mean anomaly to eccentric anomaly.
+double convertMeanAnomalyToEccentricAnomaly( const double meanAnomaly, const double eccentricity,
+                                             const double relativeTolerance,
+                                             const unsigned int maximumNumberOfIterations )
 {
     // Declare computed eccentric anomaly.
     double eccentricAnomaly_ = -0.0;
@@ -427,86 +1323,138 @@ double convertTrueAnomalyToEccentricAnomaly( const double trueAnomaly,
     // Check if orbit is elliptical and compute eccentric anomaly.
     else if ( eccentricity >= 0.0 && eccentricity < 1.0 )
     {
-        eccentricAnomaly_ = convertTrueAnomalyToEllipticalEccentricAnomaly( trueAnomaly,
-                                                                            eccentricity );
+        eccentricAnomaly_ = convertMeanAnomalyToEllipticalEccentricAnomaly(
+                    meanAnomaly, eccentricity, relativeTolerance, maximumNumberOfIterations );
     }
 
     else if ( eccentricity > 1.0 )
     {
-        eccentricAnomaly_ = convertTrueAnomalyToHyperbolicEccentricAnomaly( trueAnomaly,
-                                                                            eccentricity );
+        eccentricAnomaly_ = convertMeanAnomalyToHyperbolicEccentricAnomaly(
+                    meanAnomaly, eccentricity, relativeTolerance, maximumNumberOfIterations );
     }
 
     // Return computed eccentric anomaly.
     return eccentricAnomaly_;
 }
 
-//! Convert (elliptic) eccentric anomaly to true anomaly.
-double convertEllipticalEccentricAnomalyToTrueAnomaly( const double ellipticEccentricAnomaly,
-                                                       const double eccentricity )
+//! Convert mean anomalies to eccentric anomalies.
+Eigen::VectorXd convertMeanAnomalyToEccentricAnomaly(
+        const Eigen::VectorXd& meanAnomalies, const Eigen::VectorXd& eccentricities,
+        const double relativeTolerance, const unsigned int maximumNumberOfIterations )
 {
-    if ( eccentricity >= 1.0 || eccentricity < 0.0 )
+    // Check if input vectors are of equal size and throw an error if not.
+    if ( meanAnomalies.rows( ) != eccentricities.rows( ) )
     {
         boost::throw_exception(
                     boost::enable_error_info(
-                        std::runtime_error( "Eccentricity is invalid." ) ) );
+                        std::runtime_error(
+                            "Number of mean anomalies and eccentricities is not equal." ) ) );
     }
 
-    else
-    {
-        using std::cos;
-        using std::sqrt;
-
-        // Compute sine and cosine of true anomaly.
-        double sineOfTrueAnomaly_ = sqrt( 1.0 - std::pow( eccentricity, 2.0 ) ) *
-                std::sin( ellipticEccentricAnomaly )
-                / ( 1.0 - eccentricity * cos( ellipticEccentricAnomaly ) );
-
-        double cosineOfTrueAnomaly_ = ( cos( ellipticEccentricAnomaly ) - eccentricity )
-                / ( 1.0 - eccentricity * cos( ellipticEccentricAnomaly ) );
+    // Declare computed eccentric anomalies.
+    Eigen::VectorXd eccentricAnomalies_( meanAnomalies.rows( ) );
 
-        // Return true anomaly.
-        return atan2( sineOfTrueAnomaly_, cosineOfTrueAnomaly_  );
+    // Solve Kepler's equation for each entry.
+    for ( int i = 0; i < meanAnomalies.rows( ); i++ )
+    {
+        eccentricAnomalies_( i ) = convertMeanAnomalyToEccentricAnomaly(
+                    meanAnomalies( i ), eccentricities( i ),
+                    relativeTolerance, maximumNumberOfIterations );
     }
+
+    // Return computed eccentric anomalies.
+    return eccentricAnomalies_;
 }
 
-//! Convert hyperbolic eccentric anomaly to true anomaly.
-double convertHyperbolicEccentricAnomalyToTrueAnomaly( const double hyperbolicEccentricAnomaly,
-                                                       const double eccentricity )
+//! Default constructor.
+EccentricAnomalyLookupTable::EccentricAnomalyLookupTable( const int numberOfMeanAnomalyNodes,
+                                                          const int numberOfEccentricityNodes,
+                                                          const double maximumEccentricity )
+    : numberOfMeanAnomalyNodes_( numberOfMeanAnomalyNodes ),
+      numberOfEccentricityNodes_( numberOfEccentricityNodes ),
+      maximumEccentricity_( maximumEccentricity ),
+      maximumInterpolationError_( 0.0 ),
+      maximumPolishedError_( 0.0 )
 {
-    if ( eccentricity <= 1.0 )
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Check if table settings are valid and throw an error if not.
+    if ( numberOfMeanAnomalyNodes < 2 || numberOfEccentricityNodes < 2 )
     {
         boost::throw_exception(
                     boost::enable_error_info(
-                        std::runtime_error( "Eccentricity is invalid." ) ) );
+                        std::runtime_error( "Lookup table should have at least two nodes." ) ) );
     }
 
-    else
+    if ( !( maximumEccentricity > 0.0 && maximumEccentricity < 1.0 ) )
     {
-        using std::cosh;
-
-        // Compute sine and cosine of true anomaly.
-        double sineOfTrueAnomaly_
-                = std::sqrt( std::pow( eccentricity, 2.0 ) - 1.0 )
-                * std::sinh( hyperbolicEccentricAnomaly )
-                / ( eccentricity * cosh( hyperbolicEccentricAnomaly ) - 1.0 );
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Maximum eccentricity of lookup table is invalid." ) ) );
+    }
 
-        double cosineOfTrueAnomaly_
-                = ( eccentricity - cosh( hyperbolicEccentricAnomaly ) )
-                / ( eccentricity * cosh( hyperbolicEccentricAnomaly ) - 1.0 );
+    meanAnomalyStep_ = PI / static_cast< double >( numberOfMeanAnomalyNodes - 1 );
+    eccentricityStep_
+            = maximumEccentricity / static_cast< double >( numberOfEccentricityNodes - 1 );
 
-        // Return true anomaly.
-        return std::atan2( sineOfTrueAnomaly_, cosineOfTrueAnomaly_ );
+    // Compute eccentric anomaly and its derivatives at all nodes.
+    nodeData_.resize( 4, numberOfMeanAnomalyNodes * numberOfEccentricityNodes );
+    for ( int j = 0; j < numberOfEccentricityNodes; j++ )
+    {
+        const double eccentricity_ = static_cast< double >( j ) * eccentricityStep_;
+        for ( int i = 0; i < numberOfMeanAnomalyNodes; i++ )
+        {
+            const double eccentricAnomaly_ = convertMeanAnomalyToEllipticalEccentricAnomaly(
+                        static_cast< double >( i ) * meanAnomalyStep_, eccentricity_ );
+            const double sineOfEccentricAnomaly_ = std::sin( eccentricAnomaly_ );
+            const double cosineOfEccentricAnomaly_ = std::cos( eccentricAnomaly_ );
+            const double inverseDenominator_
+                    = 1.0 / ( 1.0 - eccentricity_ * cosineOfEccentricAnomaly_ );
+            const double eccentricityDerivative_ = sineOfEccentricAnomaly_ * inverseDenominator_;
+
+            nodeData_.col( j * numberOfMeanAnomalyNodes + i )
+                    << eccentricAnomaly_, inverseDenominator_, eccentricityDerivative_,
+                    ( cosineOfEccentricAnomaly_
+                      - eccentricity_ * sineOfEccentricAnomaly_ * eccentricityDerivative_ )
+                    * inverseDenominator_ * inverseDenominator_;
+        }
     }
 
+    // Estimate maximum errors at centers and edge midpoints of all cells.
+    for ( int j = 0; j < numberOfEccentricityNodes - 1; j++ )
+    {
+        for ( int i = 0; i < numberOfMeanAnomalyNodes - 1; i++ )
+        {
+            for ( int point = 0; point < 3; point++ )
+            {
+                const double meanAnomaly_ = ( static_cast< double >( i )
+                                              + ( point == 1 ? 0.0 : 0.5 ) ) * meanAnomalyStep_;
+                const double eccentricity_ = ( static_cast< double >( j )
+                                               + ( point == 2 ? 0.0 : 0.5 ) ) * eccentricityStep_;
+                const double exactEccentricAnomaly_
+                        = convertMeanAnomalyToEllipticalEccentricAnomaly( meanAnomaly_,
+                                                                          eccentricity_ );
+
+                maximumInterpolationError_ = std::max(
+                            maximumInterpolationError_,
+                            std::fabs( interpolateEccentricAnomaly( meanAnomaly_, eccentricity_ )
+                                       - exactEccentricAnomaly_ ) );
+                maximumPolishedError_ = std::max(
+                            maximumPolishedError_,
+                            std::fabs( computeEccentricAnomaly( meanAnomaly_, eccentricity_, true )
+                                       - exactEccentricAnomaly_ ) );
+            }
+        }
+    }
 }
 
-//! Convert eccentric anomaly to true anomaly.
-double convertEccentricAnomalyToTrueAnomaly( const double eccentricAnomaly,
-                                             const double eccentricity )
+//! Compute eccentric anomaly.
+double EccentricAnomalyLookupTable::computeEccentricAnomaly( const double meanAnomaly,
+                                                            const double eccentricity,
+                                                            const bool usePolishingStep ) const
 {
-    // Declare computed true anomaly.
-    double trueAnomaly_ = -0.0;
+    using tudat::basic_mathematics::mathematical_constants::PI;
 
     // Check if eccentricity is invalid and throw an error if true.
     if ( eccentricity < 0.0 )
@@ -516,85 +1464,109 @@ double convertEccentricAnomalyToTrueAnomaly( const double eccentricAnomaly,
                         std::runtime_error( "Eccentricity is invalid." ) ) );
     }
 
-    // Check if orbit is parabolic and throw an error if true.
-    else if ( std::fabs( eccentricity - 1.0 ) < std::numeric_limits< double >::epsilon( ) )
+    // Use exact conversion for eccentricities outside of table.
+    if ( eccentricity > maximumEccentricity_ )
     {
-        boost::throw_exception(
-                    boost::enable_error_info(
-                        std::runtime_error(
-                            "Parabolic orbits have not yet been implemented." ) ) );
+        return convertMeanAnomalyToEllipticalEccentricAnomaly( meanAnomaly, eccentricity );
     }
 
-    // Check if orbit is elliptical and compute true anomaly.
-    else if ( eccentricity >= 0.0 && eccentricity < 1.0 )
-    {
-        trueAnomaly_ = convertEllipticalEccentricAnomalyToTrueAnomaly( eccentricAnomaly,
-                                                                       eccentricity );
-    }
+    // Reduce mean anomaly to [ -PI, PI ] and interpolate for its absolute value, which is allowed
+    // due to the symmetry of Kepler's equation.
+    const double reducedMeanAnomaly_
+            = basic_mathematics::computeModulo( meanAnomaly + PI, 2.0 * PI ) - PI;
+    const double absoluteMeanAnomaly_ = std::fabs( reducedMeanAnomaly_ );
 
-    else if ( eccentricity > 1.0 )
+    double absoluteEccentricAnomaly_
+            = interpolateEccentricAnomaly( absoluteMeanAnomaly_, eccentricity );
+
+    // Apply Newton step on Kepler's equation, if requested.
+    if ( usePolishingStep )
     {
-        trueAnomaly_ = convertHyperbolicEccentricAnomalyToTrueAnomaly( eccentricAnomaly,
-                                                                       eccentricity );
+        absoluteEccentricAnomaly_
+                -= ( absoluteEccentricAnomaly_
+                     - eccentricity * std::sin( absoluteEccentricAnomaly_ )
+                     - absoluteMeanAnomaly_ )
+                / ( 1.0 - eccentricity * std::cos( absoluteEccentricAnomaly_ ) );
     }
 
-    // Return computed true anomaly.
-    return trueAnomaly_;
+    // Restore sign and number of revolutions of the mean anomaly.
+    return ( reducedMeanAnomaly_ < 0.0 ? -absoluteEccentricAnomaly_ : absoluteEccentricAnomaly_ )
+            + ( meanAnomaly - reducedMeanAnomaly_ );
 }
 
-//! Convert (elliptical) eccentric anomaly to mean anomaly.
-double convertEllipticalEccentricAnomalyToMeanAnomaly( const double ellipticalEccentricAnomaly,
-                                                       const double eccentricity )
+//! Compute eccentric anomalies.
+Eigen::VectorXd EccentricAnomalyLookupTable::computeEccentricAnomalies(
+        const Eigen::VectorXd& meanAnomalies, const Eigen::VectorXd& eccentricities,
+        const bool usePolishingStep ) const
 {
-    return ellipticalEccentricAnomaly - eccentricity * std::sin( ellipticalEccentricAnomaly );
-}
-
-//! Convert hyperbolic eccentric anomaly to mean anomaly.
-double convertHyperbolicEccentricAnomalyToMeanAnomaly(
-    const double hyperbolicEccentricAnomaly, const double eccentricity )
-{
-    return eccentricity * std::sinh( hyperbolicEccentricAnomaly ) - hyperbolicEccentricAnomaly;
-}
-
-//! Convert eccentric anomaly to mean anomaly.
-double convertEccentricAnomalyToMeanAnomaly( const double eccentricAnomaly,
-                                             const double eccentricity )
-{
-    // Declare computed mean anomaly.
-    double meanAnomaly_ = -0.0;
-
-    // Check if eccentricity is invalid and throw an error if true.
-    if ( eccentricity < 0.0 )
-    {
-        boost::throw_exception(
-                    boost::enable_error_info(
-                        std::runtime_error( "Eccentricity is invalid." ) ) );
-    }
-
-    // Check if orbit is parabolic and throw an error if true.
-    else if ( std::fabs( eccentricity - 1.0 ) < std::numeric_limits< double >::epsilon( ) )
+    // Check if input vectors are of equal size and throw an error if not.
+    if ( meanAnomalies.rows( ) != eccentricities.rows( ) )
     {
         boost::throw_exception(
                     boost::enable_error_info(
                         std::runtime_error(
-                            "Parabolic orbits have not yet been implemented." ) ) );
+                            "Number of mean anomalies and eccentricities is not equal." ) ) );
     }
 
-    // Check if orbit is elliptical and compute true anomaly.
-    else if ( eccentricity >= 0.0 && eccentricity < 1.0 )
+    Eigen::VectorXd eccentricAnomalies_( meanAnomalies.rows( ) );
+    for ( int i = 0; i < meanAnomalies.rows( ); i++ )
     {
-        meanAnomaly_ = convertEllipticalEccentricAnomalyToMeanAnomaly( eccentricAnomaly,
-                                                                       eccentricity );
+        eccentricAnomalies_( i ) = computeEccentricAnomaly( meanAnomalies( i ),
+                                                            eccentricities( i ),
+                                                            usePolishingStep );
     }
 
-    else if ( eccentricity > 1.0 )
+    return eccentricAnomalies_;
+}
+
+//! Interpolate eccentric anomaly for reduced mean anomaly.
+double EccentricAnomalyLookupTable::interpolateEccentricAnomaly(
+        const double absoluteMeanAnomaly, const double eccentricity ) const
+{
+    // Determine cell and normalized coordinates in cell.
+    const double scaledMeanAnomaly_ = absoluteMeanAnomaly / meanAnomalyStep_;
+    const double scaledEccentricity_ = eccentricity / eccentricityStep_;
+    const int meanAnomalyIndex_ = std::min( static_cast< int >( scaledMeanAnomaly_ ),
+                                            numberOfMeanAnomalyNodes_ - 2 );
+    const int eccentricityIndex_ = std::min( static_cast< int >( scaledEccentricity_ ),
+                                             numberOfEccentricityNodes_ - 2 );
+    const double t_ = scaledMeanAnomaly_ - static_cast< double >( meanAnomalyIndex_ );
+    const double s_ = scaledEccentricity_ - static_cast< double >( eccentricityIndex_ );
+
+    // Compute cubic Hermite basis functions in both directions, with the derivative basis
+    // functions scaled by the grid spacing.
+    const double meanAnomalyValueBasis_[ 2 ]
+            = { ( 1.0 + 2.0 * t_ ) * ( 1.0 - t_ ) * ( 1.0 - t_ ), t_ * t_ * ( 3.0 - 2.0 * t_ ) };
+    const double meanAnomalyDerivativeBasis_[ 2 ]
+            = { meanAnomalyStep_ * t_ * ( 1.0 - t_ ) * ( 1.0 - t_ ),
+                meanAnomalyStep_ * t_ * t_ * ( t_ - 1.0 ) };
+    const double eccentricityValueBasis_[ 2 ]
+            = { ( 1.0 + 2.0 * s_ ) * ( 1.0 - s_ ) * ( 1.0 - s_ ), s_ * s_ * ( 3.0 - 2.0 * s_ ) };
+    const double eccentricityDerivativeBasis_[ 2 ]
+            = { eccentricityStep_ * s_ * ( 1.0 - s_ ) * ( 1.0 - s_ ),
+                eccentricityStep_ * s_ * s_ * ( s_ - 1.0 ) };
+
+    // Sum contributions of the four corners of the cell.
+    double eccentricAnomaly_ = 0.0;
+    for ( int b = 0; b < 2; b++ )
     {
-        meanAnomaly_ = convertHyperbolicEccentricAnomalyToMeanAnomaly( eccentricAnomaly,
-                                                                       eccentricity );
+        for ( int a = 0; a < 2; a++ )
+        {
+            const int nodeIndex_ = ( eccentricityIndex_ + b ) * numberOfMeanAnomalyNodes_
+                    + meanAnomalyIndex_ + a;
+            eccentricAnomaly_
+                    += meanAnomalyValueBasis_[ a ] * eccentricityValueBasis_[ b ]
+                    * nodeData_( 0, nodeIndex_ )
+                    + meanAnomalyDerivativeBasis_[ a ] * eccentricityValueBasis_[ b ]
+                    * nodeData_( 1, nodeIndex_ )
+                    + meanAnomalyValueBasis_[ a ] * eccentricityDerivativeBasis_[ b ]
+                    * nodeData_( 2, nodeIndex_ )
+                    + meanAnomalyDerivativeBasis_[ a ] * eccentricityDerivativeBasis_[ b ]
+                    * nodeData_( 3, nodeIndex_ );
+        }
     }
 
-    // Return computed mean anomaly.
-    return meanAnomaly_;
+    return eccentricAnomaly_;
 }
 
 //! Convert elapsed time to (elliptical) mean anomaly change.
@@ -602,20 +1574,8 @@ double convertElapsedTimeToEllipticalMeanAnomalyChange(
         const double elapsedTime, const double centralBodyGravitationalParameter,
         const double semiMajorAxis )
 {
-    // Check if semi-major axis is invalid and throw error if true.
-    if ( semiMajorAxis < 0.0 )
-    {
-        boost::throw_exception(
-                    boost::enable_error_info(
-                        std::runtime_error( "Semi-major axis is invalid." ) ) );
-    }
-
-    // Else return elliptical mean anomaly change.
-    else
-    {
-        return std::sqrt( centralBodyGravitationalParameter
-                          / std::pow( semiMajorAxis, 3.0 ) ) * elapsedTime;
-    }
+    return convertElapsedTimeToEllipticalMeanAnomalyChange< ThrowOnInvalidInput >(
+                elapsedTime, centralBodyGravitationalParameter, semiMajorAxis );
 }
 
 //! Convert elapsed time to mean anomaly change for hyperbolic orbits.
@@ -623,20 +1583,8 @@ double convertElapsedTimeToHyperbolicMeanAnomalyChange(
         const double elapsedTime, const double centralBodyGravitationalParameter,
         const double semiMajorAxis )
 {
-    // Check if semi-major axis is invalid and throw error if true.
-    if ( semiMajorAxis > 0.0 )
-    {
-        boost::throw_exception(
-                    boost::enable_error_info(
-                        std::runtime_error( "Semi-major axis is invalid." ) ) );
-    }
-
-    // Else return hyperbolic mean anomaly change.
-    else
-    {
-        return std::sqrt( centralBodyGravitationalParameter
-                          / std::pow( -semiMajorAxis, 3.0 ) ) * elapsedTime;
-    }
+    return convertElapsedTimeToHyperbolicMeanAnomalyChange< ThrowOnInvalidInput >(
+                elapsedTime, centralBodyGravitationalParameter, semiMajorAxis );
 }
 
 //! Convert elapsed time to mean anomaly change.
@@ -644,25 +1592,8 @@ double convertElapsedTimeToMeanAnomalyChange(
         const double elapsedTime, const double centralBodyGravitationalParameter,
         const double semiMajorAxis )
 {
-    // Declare computed mean anomaly change.
-    double meanAnomalyChange_ = -0.0;
-
-    // Check if orbit is elliptical and compute mean anomaly change.
-    if ( semiMajorAxis > 0.0 )
-    {
-        meanAnomalyChange_ = convertElapsedTimeToEllipticalMeanAnomalyChange(
-                    elapsedTime, centralBodyGravitationalParameter, semiMajorAxis );
-    }
-
-    // Else orbit is hyperbolic; compute mean anomaly change.
-    else if ( semiMajorAxis < 0.0 )
-    {
-        meanAnomalyChange_ = convertElapsedTimeToHyperbolicMeanAnomalyChange(
-                    elapsedTime, centralBodyGravitationalParameter, semiMajorAxis );
-    }
-
-    // Return computed mean anomaly change.
-    return meanAnomalyChange_;
+    return convertElapsedTimeToMeanAnomalyChange< ThrowOnInvalidInput >(
+                elapsedTime, centralBodyGravitationalParameter, semiMajorAxis );
 }
 
 //! Convert (elliptical) mean anomaly change to elapsed time.
@@ -670,20 +1601,8 @@ double convertEllipticalMeanAnomalyChangeToElapsedTime(
         const double ellipticalMeanAnomalyChange, const double centralBodyGravitationalParameter,
         const double semiMajorAxis )
 {
-    // Check if semi-major axis is invalid and throw error if true.
-    if ( semiMajorAxis < 0.0 )
-    {
-        boost::throw_exception(
-                    boost::enable_error_info(
-                        std::runtime_error( "Semi-major axis is invalid." ) ) );
-    }
-
-    // Else return elapsed time.
-    else
-    {
-        return ellipticalMeanAnomalyChange * std::sqrt( std::pow( semiMajorAxis, 3.0 )
-                                                        / centralBodyGravitationalParameter );
-    }
+    return convertEllipticalMeanAnomalyChangeToElapsedTime< ThrowOnInvalidInput >(
+                ellipticalMeanAnomalyChange, centralBodyGravitationalParameter, semiMajorAxis );
 }
 
 //! Convert hyperbolic mean anomaly change to elapsed time.
@@ -691,20 +1610,8 @@ double convertHyperbolicMeanAnomalyChangeToElapsedTime(
         const double hyperbolicMeanAnomalyChange, const double centralBodyGravitationalParameter,
         const double semiMajorAxis )
 {
-    // Check if semi-major axis is invalid and throw error if true.
-    if ( semiMajorAxis > 0.0 )
-    {
-        boost::throw_exception(
-                    boost::enable_error_info(
-                        std::runtime_error( "Semi-major axis is invalid." ) ) );
-    }
-
-    // Else return elapsed time.
-    else
-    {
-        return std::sqrt( std::pow( -semiMajorAxis, 3.0 )
-                          / centralBodyGravitationalParameter ) * hyperbolicMeanAnomalyChange;
-    }
+    return convertHyperbolicMeanAnomalyChangeToElapsedTime< ThrowOnInvalidInput >(
+                hyperbolicMeanAnomalyChange, centralBodyGravitationalParameter, semiMajorAxis );
 }
 
 //! Convert mean anomaly change to elapsed time.
@@ -712,25 +1619,8 @@ double convertMeanAnomalyChangeToElapsedTime(
         const double meanAnomalyChange, const double centralBodyGravitationalParameter,
         const double semiMajorAxis )
 {
-    // Declare computed elapsed time.
-    double elapsedTime_ = -0.0;
-
-    // Check if orbit is elliptical and compute elapsed time.
-    if ( semiMajorAxis > 0.0 )
-    {
-        elapsedTime_ = convertEllipticalMeanAnomalyChangeToElapsedTime(
-                    meanAnomalyChange, centralBodyGravitationalParameter, semiMajorAxis );
-    }
-
-    // Else orbit is hyperbolic; compute elapsed time.
-    else if ( semiMajorAxis < 0.0 )
-    {
-        elapsedTime_ = convertHyperbolicMeanAnomalyChangeToElapsedTime(
-                    meanAnomalyChange, centralBodyGravitationalParameter, semiMajorAxis );
-    }
-
-    // Return computed elapsed time.
-    return elapsedTime_;
+    return convertMeanAnomalyChangeToElapsedTime< ThrowOnInvalidInput >(
+                meanAnomalyChange, centralBodyGravitationalParameter, semiMajorAxis );
 }
 
 //! Convert (elliptical) mean motion to semi-major axis.
@@ -52,6 +52,11 @@
  *          Orbit and Attitude Systems, Microcosm Press, Kluwer Academic Publishers, 2001.
  *      Advanced Concepts Team, ESA. Keplerian Toolbox, http://sourceforge.net/projects/keptoolbox,
  *          last accessed: 21st April, 2012.
+ *      Danby, J.M.A. Fundamentals of Celestial Mechanics, Second Edition, Willmann-Bell, 1988.
+ *      Mikkola, S. A cubic approximation for Kepler's equation, Celestial Mechanics 40,
+ *          pp. 329-334, 1987.
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
  *
  *    Notes
  *      Backwards compatibility of namespaces is implemented for Tudat Core 2 in this file. The
@@ -62,8 +67,15 @@
 #ifndef TUDAT_CORE_ORBITAL_ELEMENT_CONVERSIONS_H
 #define TUDAT_CORE_ORBITAL_ELEMENT_CONVERSIONS_H
 
+#include <cmath>
+#include <limits>
+
+#include <boost/math/special_functions/atanh.hpp>
+
 #include <Eigen/Core>
 
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/conversionErrorPolicies.h"
+
 namespace tudat
 {
 namespace basic_astrodynamics
@@ -102,6 +114,20 @@ enum CartesianElementVectorIndices
     xPositionIndex, yPositionIndex, zPositionIndex, xVelocityIndex, yVelocityIndex, zVelocityIndex
 };
 
+//! Typedef for fixed-size vector of six orbital elements.
+/*!
+ * Typedef for fixed-size vector of six orbital elements, e.g., Keplerian or Cartesian elements.
+ * Unlike Eigen::VectorXd, this vector type does not require dynamic memory allocation.
+ */
+typedef Eigen::Matrix< double, 6, 1 > Vector6d;
+
+//! Typedef for fixed-size 6x6 matrix.
+/*!
+ * Typedef for fixed-size 6x6 matrix, e.g., of partial derivatives between element sets or of a
+ * state transition matrix.
+ */
+typedef Eigen::Matrix< double, 6, 6 > Matrix6d;
+
 //! Convert Keplerian to Cartesian orbital elements.
 /*!
  * Converts Keplerian to Cartesian orbital elements (Chobotov, 2002). Use the 
@@ -139,6 +165,63 @@ enum CartesianElementVectorIndices
 Eigen::VectorXd convertKeplerianToCartesianElements(
         const Eigen::VectorXd& keplerianElements, const double centralBodyGravitationalParameter );
 
+//! Convert Keplerian to Cartesian orbital elements, using fixed-size vectors.
+/*!
+ * Converts Keplerian to Cartesian orbital elements, using fixed-size vectors only, such that no
+ * dynamic memory is allocated.
+ * \param keplerianElements Vector containing Keplerian elements.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Converted state in Cartesian elements.
+ * \sa convertKeplerianToCartesianElements( const Eigen::VectorXd&, const double ).
+ */
+Vector6d convertKeplerianToCartesianElements( const Vector6d& keplerianElements,
+                                              const double centralBodyGravitationalParameter );
+
+//! Convert Keplerian to Cartesian orbital elements, given as Eigen expression.
+/*!
+ * Converts Keplerian to Cartesian orbital elements, given as an arbitrary Eigen expression of six
+ * elements, e.g., a column of a matrix. The elements are evaluated into a fixed-size vector, such
+ * that no dynamic memory is allocated.
+ * \param keplerianElements Eigen expression containing Keplerian elements.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Converted state in Cartesian elements.
+ * \sa convertKeplerianToCartesianElements( const Eigen::VectorXd&, const double ).
+ */
+template< typename KeplerianElementsType >
+Vector6d convertKeplerianToCartesianElements(
+        const Eigen::MatrixBase< KeplerianElementsType >& keplerianElements,
+        const double centralBodyGravitationalParameter )
+{
+    return convertKeplerianToCartesianElements( Vector6d( keplerianElements ),
+                                                centralBodyGravitationalParameter );
+}
+
+//! Convert Keplerian to Cartesian orbital elements for a set of orbits.
+/*!
+ * Converts Keplerian to Cartesian orbital elements for a set of orbits, using the same equations
+ * as the single-orbit convertKeplerianToCartesianElements() function. The orbits are processed in
+ * fixed-size blocks, such that the computations on a block are performed with fixed-size Eigen
+ * arrays, allowing vectorization across orbits, without dynamic memory allocation. For large
+ * numbers of orbits, the blocks are divided over multiple threads.
+ * \param keplerianElements Matrix containing Keplerian elements, with one orbit per column
+ *          (6 x N), ordered as given by the KeplerianElementVectorIndices enum. If the
+ *          eccentricity is 1.0 within machine precision, the first element is the semi-latus
+ *          rectum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param cartesianElements Matrix in which the converted Cartesian elements are stored (6 x N),
+ *          ordered as given by the CartesianElementVectorIndices enum. If the matrix is
+ *          preallocated with the correct size, no memory is allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used. Threads are only started if the number of orbits is large enough for this to be
+ *          worthwhile.
+ * \sa convertKeplerianToCartesianElements(), KeplerianElementVectorIndices,
+ *     CartesianElementVectorIndices.
+ */
+void convertKeplerianToCartesianElements( const Eigen::MatrixXd& keplerianElements,
+                                          const double centralBodyGravitationalParameter,
+                                          Eigen::MatrixXd& cartesianElements,
+                                          const unsigned int numberOfThreads = 0 );
+
 //! Convert Cartesian to Keplerian orbital elements.
 /*!
  * Converts Cartesian to Keplerian orbital elements.
@@ -178,6 +261,64 @@ Eigen::VectorXd convertKeplerianToCartesianElements(
 Eigen::VectorXd convertCartesianToKeplerianElements(
         const Eigen::VectorXd& cartesianElements, const double centralBodyGravitationalParameter );
 
+//! Convert Cartesian to Keplerian orbital elements, using fixed-size vectors.
+/*!
+ * Converts Cartesian to Keplerian orbital elements, using fixed-size vectors only, such that no
+ * dynamic memory is allocated.
+ * \param cartesianElements Vector containing Cartesian elements.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Converted state in Keplerian elements.
+ * \sa convertCartesianToKeplerianElements( const Eigen::VectorXd&, const double ).
+ */
+Vector6d convertCartesianToKeplerianElements( const Vector6d& cartesianElements,
+                                              const double centralBodyGravitationalParameter );
+
+//! Convert Cartesian to Keplerian orbital elements, given as Eigen expression.
+/*!
+ * Converts Cartesian to Keplerian orbital elements, given as an arbitrary Eigen expression of six
+ * elements, e.g., a column of a matrix. The elements are evaluated into a fixed-size vector, such
+ * that no dynamic memory is allocated.
+ * \param cartesianElements Eigen expression containing Cartesian elements.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Converted state in Keplerian elements.
+ * \sa convertCartesianToKeplerianElements( const Eigen::VectorXd&, const double ).
+ */
+template< typename CartesianElementsType >
+Vector6d convertCartesianToKeplerianElements(
+        const Eigen::MatrixBase< CartesianElementsType >& cartesianElements,
+        const double centralBodyGravitationalParameter )
+{
+    return convertCartesianToKeplerianElements( Vector6d( cartesianElements ),
+                                                centralBodyGravitationalParameter );
+}
+
+//! Convert Cartesian to Keplerian orbital elements for a set of orbits.
+/*!
+ * Converts Cartesian to Keplerian orbital elements for a set of orbits, using the same element
+ * conventions and limit-case tolerances as the single-orbit convertCartesianToKeplerianElements()
+ * function. The orbits are processed in fixed-size blocks, without dynamic memory allocation, and
+ * without branches on the limit cases: for each block, the regular and limiting values are
+ * selected per orbit, and all angles are computed with atan2, which is accurate over the full
+ * range of angles. For large numbers of orbits, the blocks are divided over multiple threads.
+ * \param cartesianElements Matrix containing Cartesian elements, with one orbit per column
+ *          (6 x N), ordered as given by the CartesianElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param keplerianElements Matrix in which the converted Keplerian elements are stored (6 x N),
+ *          ordered as given by the KeplerianElementVectorIndices enum. The limit cases are
+ *          treated as described for convertCartesianToKeplerianElements(); the equatorial limit
+ *          case also applies to retrograde orbits with an inclination of pi. If the matrix is
+ *          preallocated with the correct size, no memory is allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used. Threads are only started if the number of orbits is large enough for this to be
+ *          worthwhile.
+ * \sa convertCartesianToKeplerianElements(), KeplerianElementVectorIndices,
+ *     CartesianElementVectorIndices.
+ */
+void convertCartesianToKeplerianElements( const Eigen::MatrixXd& cartesianElements,
+                                          const double centralBodyGravitationalParameter,
+                                          Eigen::MatrixXd& keplerianElements,
+                                          const unsigned int numberOfThreads = 0 );
+
 //! Convert true anomaly to (elliptical) eccentric anomaly.
 /*!
  * Converts true anomaly to eccentric anomaly for elliptical orbits ( 0 <= eccentricity < 1.0 ).
@@ -292,6 +433,265 @@ double convertHyperbolicEccentricAnomalyToMeanAnomaly( const double hyperbolicEc
 double convertEccentricAnomalyToMeanAnomaly( const double eccentricAnomaly,
                                              const double eccentricity );
 
+//! Convert true anomaly to eccentric anomaly for a set of orbits.
+/*!
+ * Converts true anomaly to eccentric anomaly for a set of elliptical and hyperbolic orbits, which
+ * may be mixed. The orbits are processed in fixed-size blocks, for which the elliptical and
+ * hyperbolic equations are both evaluated with vectorized arithmetic, after which the result is
+ * selected per orbit. The results agree with convertTrueAnomalyToEccentricAnomaly() to within
+ * rounding errors. An error is thrown for eccentricity < 0.0 and parabolic orbits.
+ * \param trueAnomalies True anomalies.                                                      [rad]
+ * \param eccentricities Eccentricities, of the same size as trueAnomalies.                    [-]
+ * \return Eccentric anomalies (elliptical or hyperbolic).                                   [rad]
+ */
+Eigen::ArrayXd convertTrueAnomalyToEccentricAnomaly( const Eigen::ArrayXd& trueAnomalies,
+                                                     const Eigen::ArrayXd& eccentricities );
+
+//! Convert eccentric anomaly to true anomaly for a set of orbits.
+/*!
+ * Converts eccentric anomaly to true anomaly for a set of elliptical and hyperbolic orbits, which
+ * may be mixed. The orbits are processed in fixed-size blocks, for which the elliptical and
+ * hyperbolic equations are both evaluated with vectorized arithmetic, after which the result is
+ * selected per orbit. The results agree with convertEccentricAnomalyToTrueAnomaly() to within
+ * rounding errors. An error is thrown for eccentricity < 0.0 and parabolic orbits.
+ * \param eccentricAnomalies Eccentric anomalies (elliptical or hyperbolic).                 [rad]
+ * \param eccentricities Eccentricities, of the same size as eccentricAnomalies.               [-]
+ * \return True anomalies.                                                                   [rad]
+ */
+Eigen::ArrayXd convertEccentricAnomalyToTrueAnomaly( const Eigen::ArrayXd& eccentricAnomalies,
+                                                     const Eigen::ArrayXd& eccentricities );
+
+//! Convert eccentric anomaly to mean anomaly for a set of orbits.
+/*!
+ * Converts eccentric anomaly to mean anomaly for a set of elliptical and hyperbolic orbits, which
+ * may be mixed. The orbits are processed in fixed-size blocks, for which the elliptical and
+ * hyperbolic equations are both evaluated with vectorized arithmetic, after which the result is
+ * selected per orbit. The results agree with convertEccentricAnomalyToMeanAnomaly() to within
+ * rounding errors. An error is thrown for eccentricity < 0.0 and parabolic orbits.
+ * \param eccentricAnomalies Eccentric anomalies (elliptical or hyperbolic).                 [rad]
+ * \param eccentricities Eccentricities, of the same size as eccentricAnomalies.               [-]
+ * \return Mean anomalies.                                                                   [rad]
+ */
+Eigen::ArrayXd convertEccentricAnomalyToMeanAnomaly( const Eigen::ArrayXd& eccentricAnomalies,
+                                                     const Eigen::ArrayXd& eccentricities );
+
+//! Convert mean anomaly to (elliptical) eccentric anomaly.
+/*!
+ * Converts mean anomaly to eccentric anomaly for elliptical orbits ( 0 <= eccentricity < 1.0 ),
+ * by solving Kepler's equation, M = E - e sin E, using Halley's method. The mean anomaly is first
+ * reduced to the interval [ -PI, PI ], after which the starter value of the iteration is taken as
+ * E0 = M + 0.85 e (Danby, 1988), or, for high-eccentricity orbits close to periapsis, as the root
+ * of the cubic approximation of Kepler's equation (Mikkola, 1987). Close to periapsis, the
+ * function E - sin E is evaluated using its Taylor series to avoid loss of precision due to
+ * cancellation, such that accuracy is retained for eccentricities close to 1.0. The returned
+ * eccentric anomaly lies in the same revolution as the given mean anomaly, i.e., the number of
+ * whole revolutions is added back after the reduction. If the iteration does not converge within
+ * the maximum number of iterations, an error is thrown.
+ * \param ellipticalMeanAnomaly (Elliptical) Mean anomaly.                                   [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \param relativeTolerance Relative tolerance on the iteration step used as convergence
+ *          criterion, with respect to max( 1.0, |E| ).                                         [-]
+ * \param maximumNumberOfIterations Maximum number of Halley iterations.                        [-]
+ * \return (Elliptical) Eccentric anomaly.                                                    [rad]
+ */
+double convertMeanAnomalyToEllipticalEccentricAnomaly(
+        const double ellipticalMeanAnomaly, const double eccentricity,
+        const double relativeTolerance = 1.0e-14,
+        const unsigned int maximumNumberOfIterations = 20 );
+
+//! Convert mean anomaly to hyperbolic eccentric anomaly.
+/*!
+ * Converts mean anomaly to hyperbolic eccentric anomaly for hyperbolic orbits
+ * ( eccentricity > 1.0 ), by solving Kepler's equation, M = e sinh F - F, using Halley's method.
+ * The starter value of the iteration is taken as F0 = ln( 2 |M| / e + 1.8 ) (Vallado, 2004), or,
+ * for low mean anomalies of near-parabolic orbits, as the root of the cubic approximation of
+ * Kepler's equation. Close to periapsis, the function sinh F - F is evaluated using its Taylor
+ * series to avoid loss of precision due to cancellation, such that accuracy is retained for
+ * eccentricities close to 1.0. If the iteration does not converge within the maximum number of
+ * iterations, an error is thrown.
+ * \param hyperbolicMeanAnomaly Hyperbolic mean anomaly.                                      [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \param relativeTolerance Relative tolerance on the iteration step used as convergence
+ *          criterion, with respect to max( 1.0, |F| ).                                         [-]
+ * \param maximumNumberOfIterations Maximum number of Halley iterations.                        [-]
+ * \return Hyperbolic eccentric anomaly.                                                      [rad]
+ */
+double convertMeanAnomalyToHyperbolicEccentricAnomaly(
+        const double hyperbolicMeanAnomaly, const double eccentricity,
+        const double relativeTolerance = 1.0e-14,
+        const unsigned int maximumNumberOfIterations = 20 );
+
+//! Convert mean anomaly to eccentric anomaly.
+/*!
+ * Converts mean anomaly to eccentric anomaly for elliptical and hyperbolic orbits
+ * ( eccentricity < 1.0 && eccentricity > 1.0 ). This function is essentially a wrapper for
+ * convertMeanAnomalyToEllipticalEccentricAnomaly() and
+ * convertMeanAnomalyToHyperbolicEccentricAnomaly(). It should be used in cases where the
+ * eccentricity of the orbit is not known a priori. Currently, this implementation performs a
+ * check on the eccentricity and throws an error for eccentricity < 0.0 and parabolic orbits, which
+ * have not been implemented.
+ * \param meanAnomaly Mean anomaly.                                                           [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \param relativeTolerance Relative tolerance on the iteration step used as convergence
+ *          criterion.                                                                          [-]
+ * \param maximumNumberOfIterations Maximum number of Halley iterations.                        [-]
+ * \return Eccentric anomaly.                                                                 [rad]
+ */
+double convertMeanAnomalyToEccentricAnomaly( const double meanAnomaly, const double eccentricity,
+                                             const double relativeTolerance = 1.0e-14,
+                                             const unsigned int maximumNumberOfIterations = 20 );
+
+//! Convert mean anomalies to eccentric anomalies.
+/*!
+ * Converts a set of mean anomalies to eccentric anomalies for elliptical and hyperbolic orbits,
+ * by calling convertMeanAnomalyToEccentricAnomaly() for each entry. The orbits may be mixed, i.e.,
+ * each entry is treated as elliptical or hyperbolic based on its own eccentricity.
+ * \param meanAnomalies Vector of mean anomalies.                                             [rad]
+ * \param eccentricities Vector of eccentricities, of the same size as meanAnomalies.           [-]
+ * \param relativeTolerance Relative tolerance on the iteration step used as convergence
+ *          criterion.                                                                          [-]
+ * \param maximumNumberOfIterations Maximum number of Halley iterations per entry.              [-]
+ * \return Vector of eccentric anomalies.                                                     [rad]
+ */
+Eigen::VectorXd convertMeanAnomalyToEccentricAnomaly(
+        const Eigen::VectorXd& meanAnomalies, const Eigen::VectorXd& eccentricities,
+        const double relativeTolerance = 1.0e-14,
+        const unsigned int maximumNumberOfIterations = 20 );
+
+//! Lookup table for conversion of mean anomaly to eccentric anomaly.
+/*!
+ * Lookup table for approximate conversion of mean anomaly to eccentric anomaly for elliptical
+ * orbits, intended for bulk computations in which a limited accuracy suffices, such as coarse
+ * screening of large catalogs. The eccentric anomaly is tabulated on an equidistant grid of mean
+ * anomalies in [ 0, PI ] and eccentricities in [ 0, maximum eccentricity ], together with its
+ * partial derivatives, which follow analytically from Kepler's equation:
+ *
+ *   dE/dM = 1 / ( 1 - e cos E ),
+ *   dE/de = sin E / ( 1 - e cos E ).
+ *
+ * Values are obtained by bicubic Hermite interpolation, whose error scales with the fourth power
+ * of the grid spacing. Optionally, a single Newton step on Kepler's equation is applied to the
+ * interpolated value, which approximately squares the error at the cost of one sine and cosine
+ * evaluation. The maximum interpolation error is estimated when the table is created, by
+ * comparing the interpolated values with exact values at the centers and edge midpoints of all
+ * grid cells, where the interpolation error is largest. For the default table (256 x 64 nodes,
+ * maximum eccentricity 0.9), this estimate is about 2e-5 rad without, and 3e-10 rad with Newton
+ * step. The error is dominated by the highest eccentricities near periapsis, where the
+ * derivatives of the eccentric anomaly are large: for a maximum eccentricity of 0.5, the estimate
+ * is about 2e-9 rad without Newton step, and close to machine precision with it. For
+ * eccentricities above the maximum eccentricity of the table,
+ * convertMeanAnomalyToEllipticalEccentricAnomaly() is used instead.
+ */
+class EccentricAnomalyLookupTable
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, which computes the table, and estimates the maximum interpolation
+     * error. An error is thrown if the table would contain fewer than two nodes in either
+     * direction, or if the maximum eccentricity does not lie in ( 0.0, 1.0 ).
+     * \param numberOfMeanAnomalyNodes Number of nodes of mean anomaly grid.
+     * \param numberOfEccentricityNodes Number of nodes of eccentricity grid.
+     * \param maximumEccentricity Maximum eccentricity of table.                                [-]
+     */
+    EccentricAnomalyLookupTable( const int numberOfMeanAnomalyNodes = 256,
+                                 const int numberOfEccentricityNodes = 64,
+                                 const double maximumEccentricity = 0.9 );
+
+    //! Compute eccentric anomaly.
+    /*!
+     * Computes the eccentric anomaly from the mean anomaly and eccentricity by interpolation in
+     * the table. The mean anomaly is reduced to [ -PI, PI ], and the returned eccentric anomaly
+     * lies in the same revolution as the given mean anomaly. An error is thrown if the
+     * eccentricity is negative.
+     * \param meanAnomaly Mean anomaly.                                                       [rad]
+     * \param eccentricity Eccentricity.                                                        [-]
+     * \param usePolishingStep Flag indicating whether a Newton step is applied to the
+     *          interpolated value.
+     * \return Eccentric anomaly.                                                             [rad]
+     */
+    double computeEccentricAnomaly( const double meanAnomaly, const double eccentricity,
+                                    const bool usePolishingStep = false ) const;
+
+    //! Compute eccentric anomalies.
+    /*!
+     * Computes a set of eccentric anomalies, by calling computeEccentricAnomaly() for each entry.
+     * \param meanAnomalies Vector of mean anomalies.                                         [rad]
+     * \param eccentricities Vector of eccentricities, of the same size as meanAnomalies.       [-]
+     * \param usePolishingStep Flag indicating whether a Newton step is applied to the
+     *          interpolated values.
+     * \return Vector of eccentric anomalies.                                                 [rad]
+     */
+    Eigen::VectorXd computeEccentricAnomalies( const Eigen::VectorXd& meanAnomalies,
+                                               const Eigen::VectorXd& eccentricities,
+                                               const bool usePolishingStep = false ) const;
+
+    //! Get maximum eccentricity of table.
+    /*!
+     * Returns the maximum eccentricity of the table.
+     * \return Maximum eccentricity.                                                            [-]
+     */
+    double getMaximumEccentricity( ) const { return maximumEccentricity_; }
+
+    //! Get estimated maximum interpolation error.
+    /*!
+     * Returns the estimated maximum error of interpolated eccentric anomalies, without Newton
+     * step.
+     * \return Estimated maximum interpolation error.                                         [rad]
+     */
+    double getMaximumInterpolationError( ) const { return maximumInterpolationError_; }
+
+    //! Get estimated maximum error after Newton step.
+    /*!
+     * Returns the estimated maximum error of interpolated eccentric anomalies, with Newton step.
+     * \return Estimated maximum error after Newton step.                                     [rad]
+     */
+    double getMaximumPolishedError( ) const { return maximumPolishedError_; }
+
+private:
+
+    //! Interpolate eccentric anomaly for reduced mean anomaly.
+    /*!
+     * Interpolates the eccentric anomaly in the table for a mean anomaly in [ 0, PI ] and an
+     * eccentricity in [ 0, maximum eccentricity ].
+     * \param absoluteMeanAnomaly Mean anomaly in [ 0, PI ].                                  [rad]
+     * \param eccentricity Eccentricity.                                                        [-]
+     * \return Interpolated eccentric anomaly.                                                [rad]
+     */
+    double interpolateEccentricAnomaly( const double absoluteMeanAnomaly,
+                                        const double eccentricity ) const;
+
+    //! Number of nodes of mean anomaly grid.
+    int numberOfMeanAnomalyNodes_;
+
+    //! Number of nodes of eccentricity grid.
+    int numberOfEccentricityNodes_;
+
+    //! Maximum eccentricity of table.
+    double maximumEccentricity_;
+
+    //! Spacing of mean anomaly grid.
+    double meanAnomalyStep_;
+
+    //! Spacing of eccentricity grid.
+    double eccentricityStep_;
+
+    //! Tabulated data.
+    /*!
+     * Tabulated eccentric anomaly, its derivatives with respect to mean anomaly and eccentricity,
+     * and its mixed second derivative, with one column per node; the mean anomaly index runs
+     * fastest.
+     */
+    Eigen::Matrix< double, 4, Eigen::Dynamic > nodeData_;
+
+    //! Estimated maximum interpolation error.
+    double maximumInterpolationError_;
+
+    //! Estimated maximum error after Newton step.
+    double maximumPolishedError_;
+};
+
 //! Convert elapsed time to (elliptical) mean anomaly change.
 /*!
  * Converts elapsed time to mean anomaly change for elliptical orbits ( 0 <= eccentricity < 1.0 ).
@@ -402,6 +802,380 @@ double convertEllipticalMeanMotionToSemiMajorAxis(
 double convertSemiMajorAxisToEllipticalMeanMotion(
         const double semiMajorAxis, const double centralBodyGravitationalParameter );
 
+//! Convert true anomaly to (elliptical) eccentric anomaly, using given error policy.
+/*!
+ * Converts true anomaly to eccentric anomaly for elliptical orbits ( 0 <= eccentricity < 1.0 ),
+ * handling invalid eccentricities as defined by the error policy.
+ * \tparam ErrorPolicy Error policy (ThrowOnInvalidInput, ReturnNaNOnInvalidInput or
+ *          AssumeValidInput).
+ * \param trueAnomaly True anomaly.                                                           [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \return (Elliptical) Eccentric anomaly.                                                    [rad]
+ * \sa convertTrueAnomalyToEllipticalEccentricAnomaly( const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertTrueAnomalyToEllipticalEccentricAnomaly( const double trueAnomaly,
+                                                              const double eccentricity )
+{
+    if ( ErrorPolicy::isInputChecked && ( eccentricity >= 1.0 || eccentricity < 0.0 ) )
+    {
+        return ErrorPolicy::handleInvalidInput( "Eccentricity is invalid." );
+    }
+
+    // Compute sine and cosine of eccentric anomaly.
+    const double cosineOfTrueAnomaly_ = std::cos( trueAnomaly );
+    const double sineOfEccentricAnomaly_
+            = std::sqrt( 1.0 - eccentricity * eccentricity ) * std::sin( trueAnomaly )
+            / ( 1.0 + eccentricity * cosineOfTrueAnomaly_ );
+    const double cosineOfEccentricAnomaly_ = ( eccentricity + cosineOfTrueAnomaly_ )
+            / ( 1.0 + eccentricity * cosineOfTrueAnomaly_ );
+
+    // Return elliptical eccentric anomaly.
+    return std::atan2( sineOfEccentricAnomaly_, cosineOfEccentricAnomaly_ );
+}
+
+//! Convert true anomaly to hyperbolic eccentric anomaly, using given error policy.
+/*!
+ * Converts true anomaly to hyperbolic eccentric anomaly for hyperbolic orbits
+ * ( eccentricity > 1.0 ), handling invalid eccentricities as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param trueAnomaly True anomaly.                                                           [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \return Hyperbolic eccentric anomaly.                                                      [rad]
+ * \sa convertTrueAnomalyToHyperbolicEccentricAnomaly( const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertTrueAnomalyToHyperbolicEccentricAnomaly( const double trueAnomaly,
+                                                              const double eccentricity )
+{
+    if ( ErrorPolicy::isInputChecked && eccentricity <= 1.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Eccentricity is invalid." );
+    }
+
+    // Compute hyperbolic sine and hyperbolic cosine of hyperbolic eccentric anomaly.
+    const double cosineOfTrueAnomaly_ = std::cos( trueAnomaly );
+    const double hyperbolicSineOfHyperbolicEccentricAnomaly_
+            = std::sqrt( eccentricity * eccentricity - 1.0 ) * std::sin( trueAnomaly )
+            / ( 1.0 + cosineOfTrueAnomaly_ );
+    const double hyperbolicCosineOfHyperbolicEccentricAnomaly_
+            = ( cosineOfTrueAnomaly_ + eccentricity ) / ( 1.0 + cosineOfTrueAnomaly_ );
+
+    // Return hyperbolic eccentric anomaly.
+    return boost::math::atanh( hyperbolicSineOfHyperbolicEccentricAnomaly_
+                               / hyperbolicCosineOfHyperbolicEccentricAnomaly_ );
+}
+
+//! Convert true anomaly to eccentric anomaly, using given error policy.
+/*!
+ * Converts true anomaly to eccentric anomaly for elliptical and hyperbolic orbits, handling
+ * negative and parabolic eccentricities as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param trueAnomaly True anomaly.                                                           [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \return Eccentric anomaly.                                                                 [rad]
+ * \sa convertTrueAnomalyToEccentricAnomaly( const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertTrueAnomalyToEccentricAnomaly( const double trueAnomaly,
+                                                    const double eccentricity )
+{
+    if ( ErrorPolicy::isInputChecked && eccentricity < 0.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Eccentricity is invalid." );
+    }
+
+    else if ( ErrorPolicy::isInputChecked
+              && std::fabs( eccentricity - 1.0 ) < std::numeric_limits< double >::epsilon( ) )
+    {
+        return ErrorPolicy::handleInvalidInput( "Parabolic orbits have not yet been implemented." );
+    }
+
+    return ( eccentricity < 1.0 )
+            ? convertTrueAnomalyToEllipticalEccentricAnomaly< AssumeValidInput >(
+                  trueAnomaly, eccentricity )
+            : convertTrueAnomalyToHyperbolicEccentricAnomaly< AssumeValidInput >(
+                  trueAnomaly, eccentricity );
+}
+
+//! Convert (elliptical) eccentric anomaly to true anomaly, using given error policy.
+/*!
+ * Converts eccentric anomaly to true anomaly for elliptical orbits ( 0 <= eccentricity < 1.0 ),
+ * handling invalid eccentricities as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param ellipticalEccentricAnomaly Elliptical eccentric anomaly.                            [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \return True anomaly.                                                                      [rad]
+ * \sa convertEllipticalEccentricAnomalyToTrueAnomaly( const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertEllipticalEccentricAnomalyToTrueAnomaly(
+        const double ellipticalEccentricAnomaly, const double eccentricity )
+{
+    if ( ErrorPolicy::isInputChecked && ( eccentricity >= 1.0 || eccentricity < 0.0 ) )
+    {
+        return ErrorPolicy::handleInvalidInput( "Eccentricity is invalid." );
+    }
+
+    // Compute sine and cosine of true anomaly.
+    const double cosineOfEccentricAnomaly_ = std::cos( ellipticalEccentricAnomaly );
+    const double sineOfTrueAnomaly_
+            = std::sqrt( 1.0 - eccentricity * eccentricity )
+            * std::sin( ellipticalEccentricAnomaly )
+            / ( 1.0 - eccentricity * cosineOfEccentricAnomaly_ );
+    const double cosineOfTrueAnomaly_ = ( cosineOfEccentricAnomaly_ - eccentricity )
+            / ( 1.0 - eccentricity * cosineOfEccentricAnomaly_ );
+
+    // Return true anomaly.
+    return std::atan2( sineOfTrueAnomaly_, cosineOfTrueAnomaly_ );
+}
+
+//! Convert hyperbolic eccentric anomaly to true anomaly, using given error policy.
+/*!
+ * Converts hyperbolic eccentric anomaly to true anomaly for hyperbolic orbits
+ * ( eccentricity > 1.0 ), handling invalid eccentricities as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param hyperbolicEccentricAnomaly Hyperbolic eccentric anomaly.                            [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \return True anomaly.                                                                      [rad]
+ * \sa convertHyperbolicEccentricAnomalyToTrueAnomaly( const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertHyperbolicEccentricAnomalyToTrueAnomaly(
+        const double hyperbolicEccentricAnomaly, const double eccentricity )
+{
+    if ( ErrorPolicy::isInputChecked && eccentricity <= 1.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Eccentricity is invalid." );
+    }
+
+    // Compute sine and cosine of true anomaly.
+    const double hyperbolicCosineOfEccentricAnomaly_ = std::cosh( hyperbolicEccentricAnomaly );
+    const double sineOfTrueAnomaly_
+            = std::sqrt( eccentricity * eccentricity - 1.0 )
+            * std::sinh( hyperbolicEccentricAnomaly )
+            / ( eccentricity * hyperbolicCosineOfEccentricAnomaly_ - 1.0 );
+    const double cosineOfTrueAnomaly_ = ( eccentricity - hyperbolicCosineOfEccentricAnomaly_ )
+            / ( eccentricity * hyperbolicCosineOfEccentricAnomaly_ - 1.0 );
+
+    // Return true anomaly.
+    return std::atan2( sineOfTrueAnomaly_, cosineOfTrueAnomaly_ );
+}
+
+//! Convert eccentric anomaly to true anomaly, using given error policy.
+/*!
+ * Converts eccentric anomaly to true anomaly for elliptical and hyperbolic orbits, handling
+ * negative and parabolic eccentricities as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param eccentricAnomaly Eccentric anomaly.                                                 [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \return True anomaly.                                                                      [rad]
+ * \sa convertEccentricAnomalyToTrueAnomaly( const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertEccentricAnomalyToTrueAnomaly( const double eccentricAnomaly,
+                                                    const double eccentricity )
+{
+    if ( ErrorPolicy::isInputChecked && eccentricity < 0.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Eccentricity is invalid." );
+    }
+
+    else if ( ErrorPolicy::isInputChecked
+              && std::fabs( eccentricity - 1.0 ) < std::numeric_limits< double >::epsilon( ) )
+    {
+        return ErrorPolicy::handleInvalidInput( "Parabolic orbits have not yet been implemented." );
+    }
+
+    return ( eccentricity < 1.0 )
+            ? convertEllipticalEccentricAnomalyToTrueAnomaly< AssumeValidInput >(
+                  eccentricAnomaly, eccentricity )
+            : convertHyperbolicEccentricAnomalyToTrueAnomaly< AssumeValidInput >(
+                  eccentricAnomaly, eccentricity );
+}
+
+//! Convert eccentric anomaly to mean anomaly, using given error policy.
+/*!
+ * Converts eccentric anomaly to mean anomaly for elliptical and hyperbolic orbits, handling
+ * negative and parabolic eccentricities as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param eccentricAnomaly Eccentric anomaly.                                                 [rad]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \return Mean anomaly.                                                                      [rad]
+ * \sa convertEccentricAnomalyToMeanAnomaly( const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertEccentricAnomalyToMeanAnomaly( const double eccentricAnomaly,
+                                                    const double eccentricity )
+{
+    if ( ErrorPolicy::isInputChecked && eccentricity < 0.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Eccentricity is invalid." );
+    }
+
+    else if ( ErrorPolicy::isInputChecked
+              && std::fabs( eccentricity - 1.0 ) < std::numeric_limits< double >::epsilon( ) )
+    {
+        return ErrorPolicy::handleInvalidInput( "Parabolic orbits have not yet been implemented." );
+    }
+
+    return ( eccentricity < 1.0 )
+            ? eccentricAnomaly - eccentricity * std::sin( eccentricAnomaly )
+            : eccentricity * std::sinh( eccentricAnomaly ) - eccentricAnomaly;
+}
+
+//! Convert elapsed time to (elliptical) mean anomaly change, using given error policy.
+/*!
+ * Converts elapsed time to mean anomaly change for elliptical orbits, handling negative
+ * semi-major axes as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param elapsedTime Elapsed time.                                                             [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param semiMajorAxis Semi-major axis.                                                        [m]
+ * \return (Elliptical) Mean anomaly change.                                                  [rad]
+ * \sa convertElapsedTimeToEllipticalMeanAnomalyChange( const double, const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertElapsedTimeToEllipticalMeanAnomalyChange(
+        const double elapsedTime, const double centralBodyGravitationalParameter,
+        const double semiMajorAxis )
+{
+    if ( ErrorPolicy::isInputChecked && semiMajorAxis < 0.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Semi-major axis is invalid." );
+    }
+
+    return std::sqrt( centralBodyGravitationalParameter
+                      / ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) ) * elapsedTime;
+}
+
+//! Convert elapsed time to mean anomaly change for hyperbolic orbits, using given error policy.
+/*!
+ * Converts elapsed time to mean anomaly change for hyperbolic orbits, handling positive
+ * semi-major axes as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param elapsedTime Elapsed time.                                                             [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param semiMajorAxis Semi-major axis.                                                        [m]
+ * \return Hyperbolic mean anomaly change.                                                    [rad]
+ * \sa convertElapsedTimeToHyperbolicMeanAnomalyChange( const double, const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertElapsedTimeToHyperbolicMeanAnomalyChange(
+        const double elapsedTime, const double centralBodyGravitationalParameter,
+        const double semiMajorAxis )
+{
+    if ( ErrorPolicy::isInputChecked && semiMajorAxis > 0.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Semi-major axis is invalid." );
+    }
+
+    return std::sqrt( centralBodyGravitationalParameter
+                      / -( semiMajorAxis * semiMajorAxis * semiMajorAxis ) ) * elapsedTime;
+}
+
+//! Convert elapsed time to mean anomaly change, using given error policy.
+/*!
+ * Converts elapsed time to mean anomaly change for elliptical and hyperbolic orbits. As for the
+ * non-templated function, zero is returned if the semi-major axis is zero.
+ * \tparam ErrorPolicy Error policy.
+ * \param elapsedTime Elapsed time.                                                             [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param semiMajorAxis Semi-major axis.                                                        [m]
+ * \return Mean anomaly change.                                                               [rad]
+ * \sa convertElapsedTimeToMeanAnomalyChange( const double, const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertElapsedTimeToMeanAnomalyChange(
+        const double elapsedTime, const double centralBodyGravitationalParameter,
+        const double semiMajorAxis )
+{
+    if ( semiMajorAxis == 0.0 )
+    {
+        return -0.0;
+    }
+
+    return std::sqrt( centralBodyGravitationalParameter
+                      / std::fabs( semiMajorAxis * semiMajorAxis * semiMajorAxis ) )
+            * elapsedTime;
+}
+
+//! Convert (elliptical) mean anomaly change to elapsed time, using given error policy.
+/*!
+ * Converts mean anomaly change to elapsed time for elliptical orbits, handling negative
+ * semi-major axes as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param ellipticalMeanAnomalyChange (Elliptical) Mean anomaly change.                       [rad]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param semiMajorAxis Semi-major axis.                                                        [m]
+ * \return Elapsed time.                                                                        [s]
+ * \sa convertEllipticalMeanAnomalyChangeToElapsedTime( const double, const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertEllipticalMeanAnomalyChangeToElapsedTime(
+        const double ellipticalMeanAnomalyChange, const double centralBodyGravitationalParameter,
+        const double semiMajorAxis )
+{
+    if ( ErrorPolicy::isInputChecked && semiMajorAxis < 0.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Semi-major axis is invalid." );
+    }
+
+    return ellipticalMeanAnomalyChange
+            * std::sqrt( semiMajorAxis * semiMajorAxis * semiMajorAxis
+                         / centralBodyGravitationalParameter );
+}
+
+//! Convert hyperbolic mean anomaly change to elapsed time, using given error policy.
+/*!
+ * Converts mean anomaly change to elapsed time for hyperbolic orbits, handling positive
+ * semi-major axes as defined by the error policy.
+ * \tparam ErrorPolicy Error policy.
+ * \param hyperbolicMeanAnomalyChange Hyperbolic mean anomaly change.                         [rad]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param semiMajorAxis Semi-major axis.                                                        [m]
+ * \return Elapsed time.                                                                        [s]
+ * \sa convertHyperbolicMeanAnomalyChangeToElapsedTime( const double, const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertHyperbolicMeanAnomalyChangeToElapsedTime(
+        const double hyperbolicMeanAnomalyChange, const double centralBodyGravitationalParameter,
+        const double semiMajorAxis )
+{
+    if ( ErrorPolicy::isInputChecked && semiMajorAxis > 0.0 )
+    {
+        return ErrorPolicy::handleInvalidInput( "Semi-major axis is invalid." );
+    }
+
+    return std::sqrt( -( semiMajorAxis * semiMajorAxis * semiMajorAxis )
+                      / centralBodyGravitationalParameter ) * hyperbolicMeanAnomalyChange;
+}
+
+//! Convert mean anomaly change to elapsed time, using given error policy.
+/*!
+ * Converts mean anomaly change to elapsed time for elliptical and hyperbolic orbits. As for the
+ * non-templated function, zero is returned if the semi-major axis is zero.
+ * \tparam ErrorPolicy Error policy.
+ * \param meanAnomalyChange Mean anomaly change.                                              [rad]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param semiMajorAxis Semi-major axis.                                                        [m]
+ * \return Elapsed time.                                                                        [s]
+ * \sa convertMeanAnomalyChangeToElapsedTime( const double, const double, const double ).
+ */
+template< typename ErrorPolicy >
+inline double convertMeanAnomalyChangeToElapsedTime(
+        const double meanAnomalyChange, const double centralBodyGravitationalParameter,
+        const double semiMajorAxis )
+{
+    if ( semiMajorAxis == 0.0 )
+    {
+        return -0.0;
+    }
+
+    return std::sqrt( std::fabs( semiMajorAxis * semiMajorAxis * semiMajorAxis )
+                      / centralBodyGravitationalParameter ) * meanAnomalyChange;
+}
+
 } // namespace orbital_element_conversions
 } // namespace basic_astrodynamics
 } // namespace tudat
@@ -0,0 +1,358 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *      The catalog used in these tests consists of pseudo-random orbits in a thin shell, in which
+ *      close approaches occur naturally, supplemented by objects that are constructed to have a
+ *      conjunction with a known time of closest approach and miss distance.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/ConjunctionScreening/catalogScreening.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+using basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+//! Gravitational parameter of the Earth.
+const double earthGravitationalParameter = 3.986004418e14;
+
+//! Create object with conjunction with given object.
+/*!
+ * Creates Keplerian elements of an object that, at a given time, is at a given offset from an
+ * object of the catalog, with a velocity rotated about the radial direction.
+ * \param keplerianElements Keplerian elements of object of the catalog.
+ * \param timeOfClosestApproach Time of conjunction.
+ * \param radialOffset Offset of new object in radial direction at time of conjunction.
+ * \return Keplerian elements of new object at epoch of catalog.
+ */
+Vector6d createObjectWithConjunction( const Vector6d& keplerianElements,
+                                      const double timeOfClosestApproach,
+                                      const double radialOffset )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    // Compute state of object at time of conjunction, and apply offset and velocity rotation.
+    const Vector6d state = propagators::KeplerOrbit(
+                keplerianElements, earthGravitationalParameter ).getStateAtTime(
+                timeOfClosestApproach );
+    const Eigen::Vector3d radialUnitVector = state.segment( 0, 3 ).normalized( );
+
+    Vector6d newState;
+    newState << state.segment( 0, 3 ) + radialOffset * radialUnitVector,
+            Eigen::AngleAxisd( 70.0 * PI / 180.0, radialUnitVector ) * state.segment( 3, 3 );
+
+    // Propagate new object back to epoch of catalog.
+    const propagators::KeplerOrbit newOrbit(
+                convertCartesianToKeplerianElements( newState, earthGravitationalParameter ),
+                earthGravitationalParameter );
+    return convertCartesianToKeplerianElements( newOrbit.getStateAtTime( -timeOfClosestApproach ),
+                                                earthGravitationalParameter );
+}
+
+//! Create catalog used in tests.
+/*!
+ * Creates a catalog of pseudo-random orbits in a thin shell, followed by an object with a
+ * collision with object 0 at 1500 s, an object with a 3 km miss distance with object 5 at
+ * 4000 s, and an object in geostationary orbit.
+ * \return Matrix of Keplerian elements of catalog (6 x N).
+ */
+Eigen::MatrixXd createTestCatalog( )
+{
+    const int numberOfRandomObjects = 40;
+    Eigen::MatrixXd keplerianElements( 6, numberOfRandomObjects + 3 );
+
+    boost::mt19937 randomNumberGenerator( 42 );
+    boost::random::uniform_real_distribution< double > uniformDistribution( 0.0, 1.0 );
+
+    for ( int i = 0; i < numberOfRandomObjects; i++ )
+    {
+        keplerianElements.col( i )
+                << 6.98e6 + 4.0e4 * uniformDistribution( randomNumberGenerator ),
+                2.0e-3 * uniformDistribution( randomNumberGenerator ),
+                PI * uniformDistribution( randomNumberGenerator ),
+                2.0 * PI * uniformDistribution( randomNumberGenerator ),
+                2.0 * PI * uniformDistribution( randomNumberGenerator ),
+                2.0 * PI * uniformDistribution( randomNumberGenerator );
+    }
+
+    keplerianElements.col( numberOfRandomObjects )
+            = createObjectWithConjunction( keplerianElements.col( 0 ), 1500.0, 0.0 );
+    keplerianElements.col( numberOfRandomObjects + 1 )
+            = createObjectWithConjunction( keplerianElements.col( 5 ), 4000.0, 3000.0 );
+    keplerianElements.col( numberOfRandomObjects + 2 ) << 4.2164e7, 1.0e-4, 1.0e-3, 0.0, 0.0, 0.0;
+
+    return keplerianElements;
+}
+
+BOOST_AUTO_TEST_SUITE( test_catalog_screening )
+
+//! Test apogee/perigee filter.
+BOOST_AUTO_TEST_CASE( testApogeePerigeeFilter )
+{
+    Vector6d lowEarthOrbit, geostationaryOrbit, ellipticalOrbit;
+    lowEarthOrbit << 7.0e6, 0.01, 1.0, 0.0, 0.0, 0.0;
+    geostationaryOrbit << 4.2164e7, 0.0, 0.0, 0.0, 0.0, 0.0;
+    ellipticalOrbit << 7.1e6 + 5.0e3, 0.0, 0.0, 0.0, 0.0, 0.0;
+
+    using conjunction_screening::passesApogeePerigeeFilter;
+
+    // Apogee of low Earth orbit is 7.07e6 m, so that the gap with the circular orbit is 3.5e4 m.
+    BOOST_CHECK( !passesApogeePerigeeFilter( lowEarthOrbit, geostationaryOrbit, 1.0e4 ) );
+    BOOST_CHECK( !passesApogeePerigeeFilter( lowEarthOrbit, ellipticalOrbit, 3.4e4 ) );
+    BOOST_CHECK( passesApogeePerigeeFilter( lowEarthOrbit, ellipticalOrbit, 3.6e4 ) );
+    BOOST_CHECK( passesApogeePerigeeFilter( ellipticalOrbit, lowEarthOrbit, 3.6e4 ) );
+    BOOST_CHECK( passesApogeePerigeeFilter( lowEarthOrbit, lowEarthOrbit, 1.0 ) );
+}
+
+//! Test orbit path filter.
+BOOST_AUTO_TEST_CASE( testOrbitPathFilter )
+{
+    // Set circular orbit, and polar orbit with perigee and apogee at the nodes, at which it lies
+    // 100 km from the circular orbit. The ranges of radii of the orbits overlap.
+    Vector6d circularOrbit, polarOrbit;
+    circularOrbit << 7.0e6, 0.0, 0.0, 0.0, 0.0, 0.0;
+    polarOrbit << 7.0e6, 1.0e5 / 7.0e6, 0.5 * PI, 0.0, 0.0, 0.0;
+
+    using conjunction_screening::passesApogeePerigeeFilter;
+    using conjunction_screening::passesOrbitPathFilter;
+
+    BOOST_CHECK( passesApogeePerigeeFilter( circularOrbit, polarOrbit, 1.0e4 ) );
+    BOOST_CHECK( !passesOrbitPathFilter( circularOrbit, polarOrbit, 1.0e4 ) );
+    BOOST_CHECK( !passesOrbitPathFilter( polarOrbit, circularOrbit, 1.0e4 ) );
+    BOOST_CHECK( passesOrbitPathFilter( circularOrbit, polarOrbit, 1.01e5 ) );
+
+    // Rotate line of apsides, such that the orbits intersect near the nodes.
+    polarOrbit( 3 ) = 0.5 * PI;
+    BOOST_CHECK( passesOrbitPathFilter( circularOrbit, polarOrbit, 1.0e4 ) );
+
+    // Check if filter is not applied to coplanar orbits.
+    polarOrbit( 2 ) = 0.0;
+    BOOST_CHECK( passesOrbitPathFilter( circularOrbit, polarOrbit, 1.0e4 ) );
+}
+
+//! Test if constructed conjunctions are found with correct time and miss distance.
+BOOST_AUTO_TEST_CASE( testConstructedConjunctions )
+{
+    const Eigen::MatrixXd keplerianElements = createTestCatalog( );
+    const Eigen::VectorXd epochs = Eigen::VectorXd::LinSpaced( 241, 0.0, 7200.0 );
+
+    const std::vector< conjunction_screening::Conjunction > conjunctions
+            = conjunction_screening::screenCatalogForConjunctions(
+                keplerianElements, earthGravitationalParameter, epochs, 1.0e4 );
+
+    // Find constructed conjunctions.
+    bool isCollisionFound = false;
+    bool isCloseApproachFound = false;
+    for ( unsigned int i = 0; i < conjunctions.size( ); i++ )
+    {
+        if ( conjunctions[ i ].firstObjectIndex == 0 && conjunctions[ i ].secondObjectIndex == 40
+             && std::fabs( conjunctions[ i ].timeOfClosestApproach - 1500.0 ) < 1.0 )
+        {
+            isCollisionFound = true;
+            BOOST_CHECK_SMALL( conjunctions[ i ].timeOfClosestApproach - 1500.0, 1.0e-5 );
+            BOOST_CHECK_SMALL( conjunctions[ i ].missDistance, 1.0e-2 );
+        }
+
+        if ( conjunctions[ i ].firstObjectIndex == 5 && conjunctions[ i ].secondObjectIndex == 41
+             && std::fabs( conjunctions[ i ].timeOfClosestApproach - 4000.0 ) < 1.0 )
+        {
+            isCloseApproachFound = true;
+            BOOST_CHECK_SMALL( conjunctions[ i ].timeOfClosestApproach - 4000.0, 1.0e-1 );
+            BOOST_CHECK_SMALL( conjunctions[ i ].missDistance - 3000.0, 10.0 );
+        }
+
+        // Check if the geostationary object is not part of any conjunction.
+        BOOST_CHECK( conjunctions[ i ].secondObjectIndex != 42 );
+    }
+
+    BOOST_CHECK( isCollisionFound );
+    BOOST_CHECK( isCloseApproachFound );
+}
+
+//! Test if screening finds the same conjunctions as brute-force sampling.
+BOOST_AUTO_TEST_CASE( testScreeningAgainstBruteForce )
+{
+    const Eigen::MatrixXd keplerianElements = createTestCatalog( );
+    const int numberOfObjects = static_cast< int >( keplerianElements.cols( ) );
+    const double screeningDistance = 3.0e5;
+    const double endTime = 7200.0;
+    const Eigen::VectorXd epochs = Eigen::VectorXd::LinSpaced( 241, 0.0, endTime );
+
+    // Screen catalog with different numbers of threads, and check if results are identical.
+    const std::vector< conjunction_screening::Conjunction > conjunctions
+            = conjunction_screening::screenCatalogForConjunctions(
+                keplerianElements, earthGravitationalParameter, epochs, screeningDistance, 1 );
+    const std::vector< conjunction_screening::Conjunction > threadedConjunctions
+            = conjunction_screening::screenCatalogForConjunctions(
+                keplerianElements, earthGravitationalParameter, epochs, screeningDistance, 3 );
+
+    BOOST_REQUIRE_EQUAL( conjunctions.size( ), threadedConjunctions.size( ) );
+    for ( unsigned int i = 0; i < conjunctions.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( conjunctions[ i ].firstObjectIndex,
+                           threadedConjunctions[ i ].firstObjectIndex );
+        BOOST_CHECK_EQUAL( conjunctions[ i ].secondObjectIndex,
+                           threadedConjunctions[ i ].secondObjectIndex );
+        BOOST_CHECK_EQUAL( conjunctions[ i ].timeOfClosestApproach,
+                           threadedConjunctions[ i ].timeOfClosestApproach );
+        BOOST_CHECK_EQUAL( conjunctions[ i ].missDistance,
+                           threadedConjunctions[ i ].missDistance );
+    }
+
+    // Create Kepler orbits.
+    std::vector< propagators::KeplerOrbit > orbits;
+    for ( int i = 0; i < numberOfObjects; i++ )
+    {
+        orbits.push_back( propagators::KeplerOrbit( keplerianElements.col( i ),
+                                                    earthGravitationalParameter ) );
+    }
+
+    // Check if each conjunction is a local minimum of the distance within the screening distance.
+    for ( unsigned int i = 0; i < conjunctions.size( ); i++ )
+    {
+        const propagators::KeplerOrbit& firstOrbit = orbits[ conjunctions[ i ].firstObjectIndex ];
+        const propagators::KeplerOrbit& secondOrbit
+                = orbits[ conjunctions[ i ].secondObjectIndex ];
+        const double time = conjunctions[ i ].timeOfClosestApproach;
+
+        BOOST_CHECK_LE( conjunctions[ i ].missDistance, screeningDistance );
+        BOOST_CHECK_SMALL( ( firstOrbit.getStateAtTime( time ).segment( 0, 3 )
+                             - secondOrbit.getStateAtTime( time ).segment( 0, 3 ) ).norm( )
+                           - conjunctions[ i ].missDistance, 1.0e-6 );
+
+        for ( int sign = -1; sign <= 1; sign += 2 )
+        {
+            const double neighbouringTime = std::min(
+                        std::max( time + 0.1 * static_cast< double >( sign ), 0.0 ), endTime );
+            BOOST_CHECK_GE( ( firstOrbit.getStateAtTime( neighbouringTime ).segment( 0, 3 )
+                              - secondOrbit.getStateAtTime( neighbouringTime ).segment( 0, 3 ) )
+                            .norm( ), conjunctions[ i ].missDistance );
+        }
+    }
+
+    // Sample distances of all pairs with a step of 2 s, and check if each sampled local minimum
+    // that is well within the screening distance is found by the screening.
+    const int numberOfSamples = 3601;
+    const double sampleStep = endTime / static_cast< double >( numberOfSamples - 1 );
+    Eigen::MatrixXd positions( 3 * numberOfObjects, numberOfSamples );
+    for ( int i = 0; i < numberOfObjects; i++ )
+    {
+        for ( int k = 0; k < numberOfSamples; k++ )
+        {
+            positions.block( 3 * i, k, 3, 1 ) = orbits[ i ].getStateAtTime(
+                        sampleStep * static_cast< double >( k ) ).segment( 0, 3 );
+        }
+    }
+
+    int numberOfSampledConjunctions = 0;
+    for ( int i = 0; i < numberOfObjects; i++ )
+    {
+        for ( int j = i + 1; j < numberOfObjects; j++ )
+        {
+            const Eigen::VectorXd distances
+                    = ( positions.block( 3 * i, 0, 3, numberOfSamples )
+                        - positions.block( 3 * j, 0, 3, numberOfSamples ) ).colwise( ).norm( );
+
+            for ( int k = 0; k < numberOfSamples; k++ )
+            {
+                if ( distances( k ) > screeningDistance - 1.0e3
+                     || ( k > 0 && !( distances( k ) < distances( k - 1 ) ) )
+                     || ( k < numberOfSamples - 1 && distances( k ) > distances( k + 1 ) ) )
+                {
+                    continue;
+                }
+
+                numberOfSampledConjunctions++;
+
+                bool isConjunctionFound = false;
+                for ( unsigned int l = 0; l < conjunctions.size( ); l++ )
+                {
+                    if ( conjunctions[ l ].firstObjectIndex == i
+                         && conjunctions[ l ].secondObjectIndex == j
+                         && std::fabs( conjunctions[ l ].timeOfClosestApproach
+                                       - sampleStep * static_cast< double >( k ) ) <= sampleStep )
+                    {
+                        isConjunctionFound = true;
+                        BOOST_CHECK_LE( conjunctions[ l ].missDistance, distances( k ) + 1.0e-6 );
+                    }
+                }
+
+                BOOST_CHECK( isConjunctionFound );
+            }
+        }
+    }
+
+    BOOST_CHECK_GT( numberOfSampledConjunctions, 10 );
+}
+
+//! Test if errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testInvalidScreeningInput )
+{
+    const Eigen::MatrixXd keplerianElements = createTestCatalog( );
+    const Eigen::VectorXd epochs = Eigen::VectorXd::LinSpaced( 11, 0.0, 600.0 );
+
+    using conjunction_screening::screenCatalogForConjunctions;
+
+    BOOST_CHECK_THROW( screenCatalogForConjunctions(
+                           keplerianElements.topRows( 5 ), earthGravitationalParameter, epochs,
+                           1.0e3 ), std::runtime_error );
+    BOOST_CHECK_THROW( screenCatalogForConjunctions(
+                           keplerianElements, earthGravitationalParameter, epochs.head( 1 ),
+                           1.0e3 ), std::runtime_error );
+    BOOST_CHECK_THROW( screenCatalogForConjunctions(
+                           keplerianElements, earthGravitationalParameter, epochs.reverse( ),
+                           1.0e3 ), std::runtime_error );
+    BOOST_CHECK_THROW( screenCatalogForConjunctions(
+                           keplerianElements, earthGravitationalParameter, epochs, 0.0 ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
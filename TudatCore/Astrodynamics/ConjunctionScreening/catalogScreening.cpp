@@ -0,0 +1,916 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Hoots, F. R., Crawford, L. L., Roehrich, R. L. An analytical method to determine future
+ *          close approaches between satellites, Celestial Mechanics, 33(2), 143-158, 1984.
+ *
+ *    Notes
+ *      The distance between two objects changes at a rate of at most twice the maximum speed in
+ *      the catalog, and each instant lies within half a grid spacing of an epoch. Hence, if two
+ *      objects come within the screening distance, their distance at the nearest epoch of the
+ *      grid is at most the screening distance plus the maximum speed times the largest spacing of
+ *      the grid. This distance is used as the size of the cells of the spatial hash grid, such
+ *      that all pairs within this distance lie in neighbouring cells.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/ConjunctionScreening/catalogScreening.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace conjunction_screening
+{
+
+namespace
+{
+
+using namespace basic_astrodynamics::orbital_element_conversions;
+using basic_mathematics::mathematical_constants::PI;
+
+//! Typedef for cell key and index of object in cell.
+typedef std::pair< boost::int64_t, int > CellEntry;
+
+//! Offset of cell indices, such that cell indices are stored as positive numbers.
+const boost::int64_t CELL_INDEX_OFFSET = 1 << 20;
+
+//! Candidate interval of time grid for conjunction between two objects.
+struct CandidateInterval
+{
+    //! Index of first object in catalog.
+    int firstObjectIndex;
+
+    //! Index of second object in catalog.
+    int secondObjectIndex;
+
+    //! Index of interval of time grid, starting at the epoch with the same index.
+    int intervalIndex;
+};
+
+//! Compare candidate intervals.
+/*!
+ * Compares candidate intervals lexicographically by object indices and interval index.
+ * \param firstInterval First candidate interval.
+ * \param secondInterval Second candidate interval.
+ * \return True if the first candidate interval is ordered before the second.
+ */
+bool operator<( const CandidateInterval& firstInterval, const CandidateInterval& secondInterval )
+{
+    if ( firstInterval.firstObjectIndex != secondInterval.firstObjectIndex )
+    {
+        return firstInterval.firstObjectIndex < secondInterval.firstObjectIndex;
+    }
+
+    if ( firstInterval.secondObjectIndex != secondInterval.secondObjectIndex )
+    {
+        return firstInterval.secondObjectIndex < secondInterval.secondObjectIndex;
+    }
+
+    return firstInterval.intervalIndex < secondInterval.intervalIndex;
+}
+
+//! Check if candidate intervals are equal.
+/*!
+ * Checks if candidate intervals are equal.
+ * \param firstInterval First candidate interval.
+ * \param secondInterval Second candidate interval.
+ * \return True if the candidate intervals are equal.
+ */
+bool operator==( const CandidateInterval& firstInterval,
+                 const CandidateInterval& secondInterval )
+{
+    return !( firstInterval < secondInterval ) && !( secondInterval < firstInterval );
+}
+
+//! Compare conjunctions.
+/*!
+ * Compares conjunctions by object indices and time of closest approach.
+ * \param firstConjunction First conjunction.
+ * \param secondConjunction Second conjunction.
+ * \return True if the first conjunction is ordered before the second.
+ */
+bool compareConjunctions( const Conjunction& firstConjunction,
+                          const Conjunction& secondConjunction )
+{
+    if ( firstConjunction.firstObjectIndex != secondConjunction.firstObjectIndex )
+    {
+        return firstConjunction.firstObjectIndex < secondConjunction.firstObjectIndex;
+    }
+
+    if ( firstConjunction.secondObjectIndex != secondConjunction.secondObjectIndex )
+    {
+        return firstConjunction.secondObjectIndex < secondConjunction.secondObjectIndex;
+    }
+
+    return firstConjunction.timeOfClosestApproach < secondConjunction.timeOfClosestApproach;
+}
+
+//! Compare cell entry with cell key.
+/*!
+ * Compares the cell key of a cell entry with a cell key, for use in binary searches.
+ * \param cellEntry Cell entry.
+ * \param cellKey Cell key.
+ * \return True if the key of the cell entry is smaller than the cell key.
+ */
+bool isCellKeySmaller( const CellEntry& cellEntry, const boost::int64_t cellKey )
+{
+    return cellEntry.first < cellKey;
+}
+
+//! Compute perigee and apogee radius.
+/*!
+ * Computes perigee and apogee radius of an orbit. For parabolic and hyperbolic orbits, the
+ * apogee radius is infinite; for parabolic orbits, the first element is the semi-latus rectum.
+ * \param keplerianElements Keplerian elements.
+ * \param perigeeRadius Perigee radius (returned by reference).
+ * \param apogeeRadius Apogee radius (returned by reference).
+ */
+void computePerigeeAndApogeeRadius( const Vector6d& keplerianElements, double& perigeeRadius,
+                                    double& apogeeRadius )
+{
+    const double eccentricity_ = keplerianElements( eccentricityIndex );
+
+    // Check if eccentricity is invalid and throw an error if true.
+    if ( eccentricity_ < 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Eccentricity is invalid." ) ) );
+    }
+
+    if ( eccentricity_ == 1.0 )
+    {
+        perigeeRadius = 0.5 * keplerianElements( semiLatusRectumIndex );
+        apogeeRadius = std::numeric_limits< double >::infinity( );
+    }
+
+    else
+    {
+        perigeeRadius = keplerianElements( semiMajorAxisIndex ) * ( 1.0 - eccentricity_ );
+        apogeeRadius = eccentricity_ < 1.0
+                ? keplerianElements( semiMajorAxisIndex ) * ( 1.0 + eccentricity_ )
+                : std::numeric_limits< double >::infinity( );
+    }
+}
+
+//! Compute perifocal unit vectors.
+/*!
+ * Computes the unit vectors of the perifocal frame of an orbit, i.e., the unit vectors in the
+ * direction of perigee, perpendicular to it in the orbital plane, and along the angular momentum.
+ * \param keplerianElements Keplerian elements.
+ * \return Matrix with perifocal unit vectors as columns.
+ */
+Eigen::Matrix3d computePerifocalUnitVectors( const Vector6d& keplerianElements )
+{
+    const double cosineOfInclination_ = std::cos( keplerianElements( inclinationIndex ) );
+    const double sineOfInclination_ = std::sin( keplerianElements( inclinationIndex ) );
+    const double cosineOfArgumentOfPeriapsis_
+            = std::cos( keplerianElements( argumentOfPeriapsisIndex ) );
+    const double sineOfArgumentOfPeriapsis_
+            = std::sin( keplerianElements( argumentOfPeriapsisIndex ) );
+    const double cosineOfLongitudeOfAscendingNode_
+            = std::cos( keplerianElements( longitudeOfAscendingNodeIndex ) );
+    const double sineOfLongitudeOfAscendingNode_
+            = std::sin( keplerianElements( longitudeOfAscendingNodeIndex ) );
+
+    Eigen::Matrix3d perifocalUnitVectors_;
+    perifocalUnitVectors_
+            << cosineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+               - sineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+               * cosineOfInclination_,
+            -cosineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+            - sineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+            * cosineOfInclination_,
+            sineOfLongitudeOfAscendingNode_ * sineOfInclination_,
+            sineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+            + cosineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+            * cosineOfInclination_,
+            -sineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+            + cosineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+            * cosineOfInclination_,
+            -cosineOfLongitudeOfAscendingNode_ * sineOfInclination_,
+            sineOfArgumentOfPeriapsis_ * sineOfInclination_,
+            cosineOfArgumentOfPeriapsis_ * sineOfInclination_,
+            cosineOfInclination_;
+
+    return perifocalUnitVectors_;
+}
+
+//! Compute range of radii of elliptical orbit in window of true anomaly.
+/*!
+ * Computes the minimum and maximum radius of an elliptical orbit in a window of true anomaly.
+ * Since the radius increases monotonically with decreasing cosine of the true anomaly, the
+ * extremes lie at the boundaries of the window, or at perigee or apogee if these lie inside.
+ * \param keplerianElements Keplerian elements.
+ * \param centralTrueAnomaly True anomaly at center of window.
+ * \param halfWidth Half-width of window, smaller than pi.
+ * \param minimumRadius Minimum radius (returned by reference).
+ * \param maximumRadius Maximum radius (returned by reference).
+ */
+void computeRangeOfRadii( const Vector6d& keplerianElements, const double centralTrueAnomaly,
+                          const double halfWidth, double& minimumRadius, double& maximumRadius )
+{
+    const double eccentricity_ = keplerianElements( eccentricityIndex );
+    const double semiLatusRectum_ = keplerianElements( semiMajorAxisIndex )
+            * ( 1.0 - eccentricity_ * eccentricity_ );
+
+    // Compute range of cosine of true anomaly in window.
+    const double distanceToPerigee_ = std::fabs( std::atan2( std::sin( centralTrueAnomaly ),
+                                                             std::cos( centralTrueAnomaly ) ) );
+    const double cosineAtLowerBoundary_ = std::cos( centralTrueAnomaly - halfWidth );
+    const double cosineAtUpperBoundary_ = std::cos( centralTrueAnomaly + halfWidth );
+
+    const double maximumCosine_ = distanceToPerigee_ <= halfWidth
+            ? 1.0 : std::max( cosineAtLowerBoundary_, cosineAtUpperBoundary_ );
+    const double minimumCosine_ = distanceToPerigee_ >= PI - halfWidth
+            ? -1.0 : std::min( cosineAtLowerBoundary_, cosineAtUpperBoundary_ );
+
+    minimumRadius = semiLatusRectum_ / ( 1.0 + eccentricity_ * maximumCosine_ );
+    maximumRadius = semiLatusRectum_ / ( 1.0 + eccentricity_ * minimumCosine_ );
+}
+
+//! Compute spatial hash key of cell.
+/*!
+ * Computes the key of a cell of the spatial hash grid from its integer coordinates, and throws an
+ * error if the coordinates are out of range.
+ * \param xCellIndex Cell index along x-axis.
+ * \param yCellIndex Cell index along y-axis.
+ * \param zCellIndex Cell index along z-axis.
+ * \return Key of cell.
+ */
+boost::int64_t computeCellKey( const boost::int64_t xCellIndex, const boost::int64_t yCellIndex,
+                               const boost::int64_t zCellIndex )
+{
+    if ( std::max( std::max( std::abs( xCellIndex ), std::abs( yCellIndex ) ),
+                   std::abs( zCellIndex ) ) >= CELL_INDEX_OFFSET )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Position is outside range of spatial hash grid." ) ) );
+    }
+
+    return ( ( xCellIndex + CELL_INDEX_OFFSET ) << 42 )
+            | ( ( yCellIndex + CELL_INDEX_OFFSET ) << 21 )
+            | ( zCellIndex + CELL_INDEX_OFFSET );
+}
+
+//! Compute relative position and velocity of two objects.
+/*!
+ * Computes the position and velocity of the second object with respect to the first.
+ * \param firstOrbit Kepler orbit of first object.
+ * \param secondOrbit Kepler orbit of second object.
+ * \param time Time since epoch of catalog.
+ * \param relativePosition Relative position (returned by reference).
+ * \param relativeVelocity Relative velocity (returned by reference).
+ * \param relativeAcceleration Relative acceleration (returned by reference).
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+ */
+void computeRelativeState( const propagators::KeplerOrbit& firstOrbit,
+                           const propagators::KeplerOrbit& secondOrbit, const double time,
+                           const double centralBodyGravitationalParameter,
+                           Eigen::Vector3d& relativePosition, Eigen::Vector3d& relativeVelocity,
+                           Eigen::Vector3d& relativeAcceleration )
+{
+    const Vector6d firstState_ = firstOrbit.getStateAtTime( time );
+    const Vector6d secondState_ = secondOrbit.getStateAtTime( time );
+
+    relativePosition = secondState_.segment< 3 >( xPositionIndex )
+            - firstState_.segment< 3 >( xPositionIndex );
+    relativeVelocity = secondState_.segment< 3 >( xVelocityIndex )
+            - firstState_.segment< 3 >( xVelocityIndex );
+
+    const double firstRadius_ = firstState_.segment< 3 >( xPositionIndex ).norm( );
+    const double secondRadius_ = secondState_.segment< 3 >( xPositionIndex ).norm( );
+    relativeAcceleration = -centralBodyGravitationalParameter
+            * ( secondState_.segment< 3 >( xPositionIndex )
+                / ( secondRadius_ * secondRadius_ * secondRadius_ )
+                - firstState_.segment< 3 >( xPositionIndex )
+                / ( firstRadius_ * firstRadius_ * firstRadius_ ) );
+}
+
+//! Loop body for spatial hashing of objects at epochs of time grid.
+/*!
+ * Loop body for spatial hashing of objects at epochs of the time grid, to be used with
+ * executeParallelLoop(). Each call processes a contiguous range of epochs, and stores the
+ * candidate intervals found at each epoch in a separate list.
+ */
+class SpatialHashScreening
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param keplerianElements Matrix of Keplerian elements of the objects (6 x N).
+     * \param orbits Kepler orbits of the objects.
+     * \param activeObjectIndices Indices of objects that passed the apogee/perigee pre-filter,
+     *          in increasing order.
+     * \param epochs Time grid.
+     * \param screeningDistance Screening distance.
+     * \param cellSize Size of cells of spatial hash grid.
+     * \param candidateIntervalsPerEpoch Lists in which candidate intervals are stored, one per
+     *          epoch.
+     */
+    SpatialHashScreening( const Eigen::MatrixXd& keplerianElements,
+                          const std::vector< propagators::KeplerOrbit >& orbits,
+                          const std::vector< int >& activeObjectIndices,
+                          const Eigen::VectorXd& epochs, const double screeningDistance,
+                          const double cellSize,
+                          std::vector< std::vector< CandidateInterval > >&
+                          candidateIntervalsPerEpoch )
+        : keplerianElements_( keplerianElements ),
+          orbits_( orbits ),
+          activeObjectIndices_( activeObjectIndices ),
+          epochs_( epochs ),
+          screeningDistance_( screeningDistance ),
+          cellSize_( cellSize ),
+          candidateIntervalsPerEpoch_( candidateIntervalsPerEpoch )
+    { }
+
+    //! Process range of epochs.
+    /*!
+     * Processes the epochs in the index range [ startIndex, endIndex ).
+     * \param startIndex Index of first epoch.
+     * \param endIndex One past the index of the last epoch.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        const int numberOfActiveObjects_ = static_cast< int >( activeObjectIndices_.size( ) );
+        const int numberOfEpochs_ = static_cast< int >( epochs_.rows( ) );
+
+        // Allocate buffers once, and reuse them for all epochs in range.
+        Eigen::Matrix3Xd positions_( 3, numberOfActiveObjects_ );
+        Eigen::Matrix< boost::int64_t, 3, Eigen::Dynamic > cellIndices_(
+                    3, numberOfActiveObjects_ );
+        std::vector< CellEntry > cellEntries_( numberOfActiveObjects_ );
+
+        for ( int epochIndex = startIndex; epochIndex < endIndex; epochIndex++ )
+        {
+            // Compute positions and cells of all objects, and sort objects by cell.
+            for ( int i = 0; i < numberOfActiveObjects_; i++ )
+            {
+                positions_.col( i ) = orbits_[ activeObjectIndices_[ i ] ].getStateAtTime(
+                            epochs_( epochIndex ) ).segment< 3 >( xPositionIndex );
+                for ( int j = 0; j < 3; j++ )
+                {
+                    cellIndices_( j, i ) = static_cast< boost::int64_t >(
+                                std::floor( positions_( j, i ) / cellSize_ ) );
+                }
+
+                cellEntries_[ i ] = std::make_pair(
+                            computeCellKey( cellIndices_( 0, i ), cellIndices_( 1, i ),
+                                            cellIndices_( 2, i ) ), i );
+            }
+
+            std::sort( cellEntries_.begin( ), cellEntries_.end( ) );
+
+            // Compare each object with objects with a higher index in the neighbouring cells.
+            for ( int i = 0; i < numberOfActiveObjects_; i++ )
+            {
+                for ( int neighbour = 0; neighbour < 27; neighbour++ )
+                {
+                    const boost::int64_t neighbourCellKey_ = computeCellKey(
+                                cellIndices_( 0, i ) + neighbour % 3 - 1,
+                                cellIndices_( 1, i ) + ( neighbour / 3 ) % 3 - 1,
+                                cellIndices_( 2, i ) + neighbour / 9 - 1 );
+
+                    for ( std::vector< CellEntry >::const_iterator cellEntryIterator
+                          = std::lower_bound( cellEntries_.begin( ), cellEntries_.end( ),
+                                              neighbourCellKey_, &isCellKeySmaller );
+                          cellEntryIterator != cellEntries_.end( )
+                          && cellEntryIterator->first == neighbourCellKey_;
+                          cellEntryIterator++ )
+                    {
+                        const int j = cellEntryIterator->second;
+                        if ( j > i && ( positions_.col( j ) - positions_.col( i ) ).norm( )
+                             <= cellSize_ )
+                        {
+                            addCandidateIntervals( activeObjectIndices_[ i ],
+                                                   activeObjectIndices_[ j ], epochIndex,
+                                                   numberOfEpochs_ );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+
+    //! Add candidate intervals around epoch for pair of objects.
+    /*!
+     * Adds the intervals before and after an epoch as candidate intervals for a pair of objects,
+     * if the pair passes the apogee/perigee and orbit path filters.
+     * \param firstObjectIndex Index of first object.
+     * \param secondObjectIndex Index of second object.
+     * \param epochIndex Index of epoch.
+     * \param numberOfEpochs Number of epochs in time grid.
+     */
+    void addCandidateIntervals( const int firstObjectIndex, const int secondObjectIndex,
+                                const int epochIndex, const int numberOfEpochs ) const
+    {
+        const Vector6d firstElements_ = keplerianElements_.col( firstObjectIndex );
+        const Vector6d secondElements_ = keplerianElements_.col( secondObjectIndex );
+
+        if ( !passesApogeePerigeeFilter( firstElements_, secondElements_, screeningDistance_ )
+             || !passesOrbitPathFilter( firstElements_, secondElements_, screeningDistance_ ) )
+        {
+            return;
+        }
+
+        CandidateInterval candidateInterval_;
+        candidateInterval_.firstObjectIndex = firstObjectIndex;
+        candidateInterval_.secondObjectIndex = secondObjectIndex;
+
+        if ( epochIndex > 0 )
+        {
+            candidateInterval_.intervalIndex = epochIndex - 1;
+            candidateIntervalsPerEpoch_[ epochIndex ].push_back( candidateInterval_ );
+        }
+
+        if ( epochIndex < numberOfEpochs - 1 )
+        {
+            candidateInterval_.intervalIndex = epochIndex;
+            candidateIntervalsPerEpoch_[ epochIndex ].push_back( candidateInterval_ );
+        }
+    }
+
+    //! Matrix of Keplerian elements of the objects.
+    const Eigen::MatrixXd& keplerianElements_;
+
+    //! Kepler orbits of the objects.
+    const std::vector< propagators::KeplerOrbit >& orbits_;
+
+    //! Indices of objects that passed the apogee/perigee pre-filter.
+    const std::vector< int >& activeObjectIndices_;
+
+    //! Time grid.
+    const Eigen::VectorXd& epochs_;
+
+    //! Screening distance.
+    const double screeningDistance_;
+
+    //! Size of cells of spatial hash grid.
+    const double cellSize_;
+
+    //! Lists in which candidate intervals are stored, one per epoch.
+    std::vector< std::vector< CandidateInterval > >& candidateIntervalsPerEpoch_;
+};
+
+//! Loop body for computation of times of closest approach.
+/*!
+ * Loop body for computation of times of closest approach in candidate intervals, to be used with
+ * executeParallelLoop(). For each candidate interval, two conjunctions can be stored: a local
+ * minimum inside the interval or at the start of the time grid, and a local minimum at the end
+ * of the time grid. Conjunctions that are not found are marked with a NaN miss distance.
+ */
+class ClosestApproachComputation
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param orbits Kepler orbits of the objects.
+     * \param epochs Time grid.
+     * \param candidateIntervals Candidate intervals.
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+     * \param timeOfClosestApproachTolerance Absolute tolerance on time of closest approach.
+     * \param conjunctions Conjunctions, two per candidate interval.
+     */
+    ClosestApproachComputation( const std::vector< propagators::KeplerOrbit >& orbits,
+                                const Eigen::VectorXd& epochs,
+                                const std::vector< CandidateInterval >& candidateIntervals,
+                                const double centralBodyGravitationalParameter,
+                                const double timeOfClosestApproachTolerance,
+                                std::vector< Conjunction >& conjunctions )
+        : orbits_( orbits ),
+          epochs_( epochs ),
+          candidateIntervals_( candidateIntervals ),
+          centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+          timeOfClosestApproachTolerance_( timeOfClosestApproachTolerance ),
+          conjunctions_( conjunctions )
+    { }
+
+    //! Process range of candidate intervals.
+    /*!
+     * Processes the candidate intervals in the index range [ startIndex, endIndex ).
+     * \param startIndex Index of first candidate interval.
+     * \param endIndex One past the index of the last candidate interval.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        const int lastIntervalIndex_ = static_cast< int >( epochs_.rows( ) ) - 2;
+
+        for ( int i = startIndex; i < endIndex; i++ )
+        {
+            const CandidateInterval& candidateInterval_ = candidateIntervals_[ i ];
+            const propagators::KeplerOrbit& firstOrbit_
+                    = orbits_[ candidateInterval_.firstObjectIndex ];
+            const propagators::KeplerOrbit& secondOrbit_
+                    = orbits_[ candidateInterval_.secondObjectIndex ];
+            const double startTime_ = epochs_( candidateInterval_.intervalIndex );
+            const double endTime_ = epochs_( candidateInterval_.intervalIndex + 1 );
+
+            // Compute range rate at boundaries of interval.
+            Eigen::Vector3d relativePosition_, relativeVelocity_, relativeAcceleration_;
+            computeRelativeState( firstOrbit_, secondOrbit_, startTime_,
+                                  centralBodyGravitationalParameter_, relativePosition_,
+                                  relativeVelocity_, relativeAcceleration_ );
+            const double startRangeRate_ = relativePosition_.dot( relativeVelocity_ );
+            computeRelativeState( firstOrbit_, secondOrbit_, endTime_,
+                                  centralBodyGravitationalParameter_, relativePosition_,
+                                  relativeVelocity_, relativeAcceleration_ );
+            const double endRangeRate_ = relativePosition_.dot( relativeVelocity_ );
+
+            // Set conjunctions to not found.
+            Conjunction& firstConjunction_ = conjunctions_[ 2 * i ];
+            Conjunction& secondConjunction_ = conjunctions_[ 2 * i + 1 ];
+            firstConjunction_.firstObjectIndex = candidateInterval_.firstObjectIndex;
+            firstConjunction_.secondObjectIndex = candidateInterval_.secondObjectIndex;
+            firstConjunction_.timeOfClosestApproach = TUDAT_NAN;
+            firstConjunction_.missDistance = TUDAT_NAN;
+            secondConjunction_ = firstConjunction_;
+
+            // Find local minimum inside interval, or at start of time grid.
+            if ( startRangeRate_ < 0.0 && endRangeRate_ > 0.0 )
+            {
+                firstConjunction_.timeOfClosestApproach = findTimeOfClosestApproach(
+                            firstOrbit_, secondOrbit_, startTime_, endTime_ );
+            }
+
+            else if ( candidateInterval_.intervalIndex == 0 && startRangeRate_ >= 0.0 )
+            {
+                firstConjunction_.timeOfClosestApproach = startTime_;
+            }
+
+            if ( firstConjunction_.timeOfClosestApproach
+                 == firstConjunction_.timeOfClosestApproach )
+            {
+                computeRelativeState( firstOrbit_, secondOrbit_,
+                                      firstConjunction_.timeOfClosestApproach,
+                                      centralBodyGravitationalParameter_, relativePosition_,
+                                      relativeVelocity_, relativeAcceleration_ );
+                firstConjunction_.missDistance = relativePosition_.norm( );
+            }
+
+            // Find local minimum at end of time grid.
+            if ( candidateInterval_.intervalIndex == lastIntervalIndex_ && endRangeRate_ <= 0.0 )
+            {
+                secondConjunction_.timeOfClosestApproach = endTime_;
+                computeRelativeState( firstOrbit_, secondOrbit_, endTime_,
+                                      centralBodyGravitationalParameter_, relativePosition_,
+                                      relativeVelocity_, relativeAcceleration_ );
+                secondConjunction_.missDistance = relativePosition_.norm( );
+            }
+        }
+    }
+
+private:
+
+    //! Find time of closest approach.
+    /*!
+     * Finds the time of closest approach in an interval in which the range rate changes sign
+     * from negative to positive, using Newton iterations on the range rate, safeguarded by
+     * bisection.
+     * \param firstOrbit Kepler orbit of first object.
+     * \param secondOrbit Kepler orbit of second object.
+     * \param startTime Start of interval.
+     * \param endTime End of interval.
+     * \return Time of closest approach.
+     */
+    double findTimeOfClosestApproach( const propagators::KeplerOrbit& firstOrbit,
+                                      const propagators::KeplerOrbit& secondOrbit,
+                                      const double startTime, const double endTime ) const
+    {
+        double lowerBound_ = startTime;
+        double upperBound_ = endTime;
+        double time_ = 0.5 * ( startTime + endTime );
+        Eigen::Vector3d relativePosition_, relativeVelocity_, relativeAcceleration_;
+
+        for ( unsigned int iteration = 0; iteration < 100; iteration++ )
+        {
+            // Compute range rate and its derivative, and update bracket.
+            computeRelativeState( firstOrbit, secondOrbit, time_,
+                                  centralBodyGravitationalParameter_, relativePosition_,
+                                  relativeVelocity_, relativeAcceleration_ );
+            const double rangeRate_ = relativePosition_.dot( relativeVelocity_ );
+            const double rangeRateDerivative_ = relativeVelocity_.squaredNorm( )
+                    + relativePosition_.dot( relativeAcceleration_ );
+
+            if ( rangeRate_ < 0.0 )
+            {
+                lowerBound_ = time_;
+            }
+
+            else
+            {
+                upperBound_ = time_;
+            }
+
+            // Take Newton step, or bisection step if Newton step leaves bracket.
+            double newTime_ = time_ - rangeRate_ / rangeRateDerivative_;
+            if ( !( rangeRateDerivative_ > 0.0 ) || !( newTime_ > lowerBound_ )
+                 || !( newTime_ < upperBound_ ) )
+            {
+                newTime_ = 0.5 * ( lowerBound_ + upperBound_ );
+            }
+
+            if ( std::fabs( newTime_ - time_ ) <= timeOfClosestApproachTolerance_ )
+            {
+                return newTime_;
+            }
+
+            time_ = newTime_;
+        }
+
+        return time_;
+    }
+
+    //! Kepler orbits of the objects.
+    const std::vector< propagators::KeplerOrbit >& orbits_;
+
+    //! Time grid.
+    const Eigen::VectorXd& epochs_;
+
+    //! Candidate intervals.
+    const std::vector< CandidateInterval >& candidateIntervals_;
+
+    //! Gravitational parameter of central body.
+    const double centralBodyGravitationalParameter_;
+
+    //! Absolute tolerance on time of closest approach.
+    const double timeOfClosestApproachTolerance_;
+
+    //! Conjunctions, two per candidate interval.
+    std::vector< Conjunction >& conjunctions_;
+};
+
+} // namespace
+
+//! Check if ranges of radii of two orbits overlap.
+bool passesApogeePerigeeFilter( const Vector6d& keplerianElementsOfFirstObject,
+                                const Vector6d& keplerianElementsOfSecondObject,
+                                const double screeningDistance )
+{
+    double firstPerigeeRadius_, firstApogeeRadius_, secondPerigeeRadius_, secondApogeeRadius_;
+    computePerigeeAndApogeeRadius( keplerianElementsOfFirstObject, firstPerigeeRadius_,
+                                   firstApogeeRadius_ );
+    computePerigeeAndApogeeRadius( keplerianElementsOfSecondObject, secondPerigeeRadius_,
+                                   secondApogeeRadius_ );
+
+    return std::max( firstPerigeeRadius_, secondPerigeeRadius_ )
+            - std::min( firstApogeeRadius_, secondApogeeRadius_ ) <= screeningDistance;
+}
+
+//! Check if orbit paths of two objects can come within screening distance.
+bool passesOrbitPathFilter( const Vector6d& keplerianElementsOfFirstObject,
+                            const Vector6d& keplerianElementsOfSecondObject,
+                            const double screeningDistance )
+{
+    // Do not apply filter for non-elliptical orbits.
+    if ( !( keplerianElementsOfFirstObject( eccentricityIndex ) < 1.0 )
+         || !( keplerianElementsOfSecondObject( eccentricityIndex ) < 1.0 ) )
+    {
+        return true;
+    }
+
+    // Compute direction of line of intersection of orbital planes.
+    const Eigen::Matrix3d firstPerifocalUnitVectors_
+            = computePerifocalUnitVectors( keplerianElementsOfFirstObject );
+    const Eigen::Matrix3d secondPerifocalUnitVectors_
+            = computePerifocalUnitVectors( keplerianElementsOfSecondObject );
+
+    Eigen::Vector3d nodeUnitVector_ = firstPerifocalUnitVectors_.col( 2 ).cross(
+                secondPerifocalUnitVectors_.col( 2 ) );
+    const double sineOfRelativeInclination_ = nodeUnitVector_.norm( );
+
+    // Compute half-widths of windows around nodes in which the orbits lie within the screening
+    // distance of the other orbital plane. For windows wider than pi/4, which occur for (nearly)
+    // coplanar orbits, points near opposite nodes may be close, and the filter is not applied.
+    const double firstPerigeeRadius_ = keplerianElementsOfFirstObject( semiMajorAxisIndex )
+            * ( 1.0 - keplerianElementsOfFirstObject( eccentricityIndex ) );
+    const double secondPerigeeRadius_ = keplerianElementsOfSecondObject( semiMajorAxisIndex )
+            * ( 1.0 - keplerianElementsOfSecondObject( eccentricityIndex ) );
+    const double maximumSineOfHalfWidth_ = std::sin( 0.25 * PI );
+
+    const double sineOfFirstHalfWidth_
+            = screeningDistance / ( firstPerigeeRadius_ * sineOfRelativeInclination_ );
+    const double sineOfSecondHalfWidth_
+            = screeningDistance / ( secondPerigeeRadius_ * sineOfRelativeInclination_ );
+
+    if ( !( sineOfFirstHalfWidth_ < maximumSineOfHalfWidth_ )
+         || !( sineOfSecondHalfWidth_ < maximumSineOfHalfWidth_ ) )
+    {
+        return true;
+    }
+
+    const double firstHalfWidth_ = std::asin( sineOfFirstHalfWidth_ );
+    const double secondHalfWidth_ = std::asin( sineOfSecondHalfWidth_ );
+    nodeUnitVector_ /= sineOfRelativeInclination_;
+
+    // Compare ranges of radii of both orbits in windows around both nodes.
+    for ( int node = 0; node < 2; node++ )
+    {
+        const Eigen::Vector3d nodeDirection_ = node == 0 ? nodeUnitVector_
+                                                         : Eigen::Vector3d( -nodeUnitVector_ );
+
+        const double firstNodeTrueAnomaly_ = std::atan2(
+                    nodeDirection_.dot( firstPerifocalUnitVectors_.col( 1 ) ),
+                    nodeDirection_.dot( firstPerifocalUnitVectors_.col( 0 ) ) );
+        const double secondNodeTrueAnomaly_ = std::atan2(
+                    nodeDirection_.dot( secondPerifocalUnitVectors_.col( 1 ) ),
+                    nodeDirection_.dot( secondPerifocalUnitVectors_.col( 0 ) ) );
+
+        double firstMinimumRadius_, firstMaximumRadius_;
+        computeRangeOfRadii( keplerianElementsOfFirstObject, firstNodeTrueAnomaly_,
+                             firstHalfWidth_, firstMinimumRadius_, firstMaximumRadius_ );
+
+        double secondMinimumRadius_, secondMaximumRadius_;
+        computeRangeOfRadii( keplerianElementsOfSecondObject, secondNodeTrueAnomaly_,
+                             secondHalfWidth_, secondMinimumRadius_, secondMaximumRadius_ );
+
+        if ( std::max( firstMinimumRadius_, secondMinimumRadius_ )
+             - std::min( firstMaximumRadius_, secondMaximumRadius_ ) <= screeningDistance )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//! Screen catalog of objects for conjunctions.
+std::vector< Conjunction > screenCatalogForConjunctions(
+        const Eigen::MatrixXd& keplerianElements, const double centralBodyGravitationalParameter,
+        const Eigen::VectorXd& epochs, const double screeningDistance,
+        const unsigned int numberOfThreads, const double timeOfClosestApproachTolerance )
+{
+    // Check if input is valid and throw an error if not.
+    if ( keplerianElements.rows( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Orbital elements matrix should have 6 rows." ) ) );
+    }
+
+    if ( epochs.rows( ) < 2 || !( ( epochs.tail( epochs.rows( ) - 1 )
+                                    - epochs.head( epochs.rows( ) - 1 ) ).minCoeff( ) > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Time grid should contain at least two increasing epochs." ) ) );
+    }
+
+    if ( !( screeningDistance > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Screening distance should be positive." ) ) );
+    }
+
+    const int numberOfObjects_ = static_cast< int >( keplerianElements.cols( ) );
+    const int numberOfEpochs_ = static_cast< int >( epochs.rows( ) );
+
+    // Create Kepler orbits, and sort objects by perigee radius.
+    std::vector< propagators::KeplerOrbit > orbits_;
+    orbits_.reserve( numberOfObjects_ );
+    std::vector< double > apogeeRadii_( numberOfObjects_ );
+    std::vector< std::pair< double, int > > sortedPerigeeRadii_( numberOfObjects_ );
+
+    for ( int i = 0; i < numberOfObjects_; i++ )
+    {
+        orbits_.push_back( propagators::KeplerOrbit( keplerianElements.col( i ),
+                                                     centralBodyGravitationalParameter ) );
+        computePerigeeAndApogeeRadius( keplerianElements.col( i ),
+                                       sortedPerigeeRadii_[ i ].first, apogeeRadii_[ i ] );
+        sortedPerigeeRadii_[ i ].second = i;
+    }
+
+    std::sort( sortedPerigeeRadii_.begin( ), sortedPerigeeRadii_.end( ) );
+
+    // Apply apogee/perigee pre-filter: an object can only conjunct if its range of radii overlaps
+    // with that of an object with lower perigee, or with that of the object with the next higher
+    // perigee. Compute the maximum perigee speed of the remaining objects.
+    std::vector< int > activeObjectIndices_;
+    double maximumApogeeRadiusSoFar_ = -std::numeric_limits< double >::infinity( );
+    double maximumSpeed_ = 0.0;
+
+    for ( int i = 0; i < numberOfObjects_; i++ )
+    {
+        const double perigeeRadius_ = sortedPerigeeRadii_[ i ].first;
+        const int objectIndex_ = sortedPerigeeRadii_[ i ].second;
+
+        if ( maximumApogeeRadiusSoFar_ >= perigeeRadius_ - screeningDistance
+             || ( i + 1 < numberOfObjects_ && sortedPerigeeRadii_[ i + 1 ].first
+                  - screeningDistance <= apogeeRadii_[ objectIndex_ ] ) )
+        {
+            activeObjectIndices_.push_back( objectIndex_ );
+            maximumSpeed_ = std::max(
+                        maximumSpeed_,
+                        std::sqrt( centralBodyGravitationalParameter
+                                   * ( 2.0 / perigeeRadius_
+                                       - 1.0 / keplerianElements( semiMajorAxisIndex,
+                                                                  objectIndex_ ) ) ) );
+        }
+
+        maximumApogeeRadiusSoFar_ = std::max( maximumApogeeRadiusSoFar_,
+                                              apogeeRadii_[ objectIndex_ ] );
+    }
+
+    std::sort( activeObjectIndices_.begin( ), activeObjectIndices_.end( ) );
+
+    // Find candidate intervals using spatial hashing at each epoch.
+    const double cellSize_ = screeningDistance + maximumSpeed_
+            * ( epochs.tail( numberOfEpochs_ - 1 ) - epochs.head( numberOfEpochs_ - 1 ) )
+            .maxCoeff( );
+
+    std::vector< std::vector< CandidateInterval > > candidateIntervalsPerEpoch_(
+                numberOfEpochs_ );
+    basics::executeParallelLoop(
+                numberOfEpochs_,
+                SpatialHashScreening( keplerianElements, orbits_, activeObjectIndices_, epochs,
+                                      screeningDistance, cellSize_, candidateIntervalsPerEpoch_ ),
+                numberOfThreads, 1 );
+
+    // Merge candidate intervals of all epochs, and remove duplicates.
+    std::vector< CandidateInterval > candidateIntervals_;
+    for ( int i = 0; i < numberOfEpochs_; i++ )
+    {
+        candidateIntervals_.insert( candidateIntervals_.end( ),
+                                    candidateIntervalsPerEpoch_[ i ].begin( ),
+                                    candidateIntervalsPerEpoch_[ i ].end( ) );
+    }
+
+    std::sort( candidateIntervals_.begin( ), candidateIntervals_.end( ) );
+    candidateIntervals_.erase( std::unique( candidateIntervals_.begin( ),
+                                            candidateIntervals_.end( ) ),
+                               candidateIntervals_.end( ) );
+
+    // Compute times of closest approach in candidate intervals.
+    std::vector< Conjunction > allConjunctions_( 2 * candidateIntervals_.size( ) );
+    basics::executeParallelLoop(
+                static_cast< int >( candidateIntervals_.size( ) ),
+                ClosestApproachComputation( orbits_, epochs, candidateIntervals_,
+                                            centralBodyGravitationalParameter,
+                                            timeOfClosestApproachTolerance, allConjunctions_ ),
+                numberOfThreads, 16 );
+
+    // Select conjunctions within screening distance.
+    std::vector< Conjunction > conjunctions_;
+    for ( unsigned int i = 0; i < allConjunctions_.size( ); i++ )
+    {
+        if ( allConjunctions_[ i ].missDistance <= screeningDistance )
+        {
+            conjunctions_.push_back( allConjunctions_[ i ] );
+        }
+    }
+
+    std::sort( conjunctions_.begin( ), conjunctions_.end( ), &compareConjunctions );
+
+    return conjunctions_;
+}
+
+} // namespace conjunction_screening
+} // namespace tudat
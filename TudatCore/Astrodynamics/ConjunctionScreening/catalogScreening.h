@@ -0,0 +1,150 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Hoots, F. R., Crawford, L. L., Roehrich, R. L. An analytical method to determine future
+ *          close approaches between satellites, Celestial Mechanics, 33(2), 143-158, 1984.
+ *
+ *    Notes
+ *      Conjunctions are screened in three stages (Hoots et al., 1984). First, objects whose range
+ *      of radii does not overlap that of any other object are discarded (apogee/perigee filter).
+ *      Second, the remaining objects are propagated to each epoch of the time grid, and binned in
+ *      a spatial hash grid of cubic cells, such that only objects in neighbouring cells are
+ *      compared. Pairs that are close enough to possibly conjunct between two epochs are checked
+ *      with the apogee/perigee and orbit path filters. Third, the time of closest approach of each
+ *      remaining pair is computed by finding the root of the range rate with a safeguarded Newton
+ *      method.
+ *
+ *      Objects are propagated as Kepler orbits. The epochs of the time grid should be spaced
+ *      closely enough that the range rate of a pair changes sign at most once between two epochs;
+ *      a spacing of a few percent of the shortest orbital period is generally sufficient.
+ *
+ */
+
+#ifndef TUDAT_CORE_CATALOG_SCREENING_H
+#define TUDAT_CORE_CATALOG_SCREENING_H
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace conjunction_screening
+{
+
+//! Conjunction between two objects.
+/*!
+ * Data structure containing a conjunction between two objects of a catalog.
+ */
+struct Conjunction
+{
+    //! Index of first object in catalog.
+    int firstObjectIndex;
+
+    //! Index of second object in catalog; larger than that of the first object.
+    int secondObjectIndex;
+
+    //! Time of closest approach, with respect to the epoch of the catalog.                     [s]
+    double timeOfClosestApproach;
+
+    //! Distance at time of closest approach.                                                   [m]
+    double missDistance;
+};
+
+//! Check if ranges of radii of two orbits overlap.
+/*!
+ * Checks if the ranges of radii of two orbits, from perigee to apogee, overlap when extended by
+ * the screening distance. If not, the objects cannot come within the screening distance of each
+ * other (Hoots et al., 1984).
+ * \param keplerianElementsOfFirstObject Keplerian elements of first object.
+ * \param keplerianElementsOfSecondObject Keplerian elements of second object.
+ * \param screeningDistance Screening distance.                                                 [m]
+ * \return True if the ranges of radii overlap.
+ */
+bool passesApogeePerigeeFilter(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d&
+        keplerianElementsOfFirstObject,
+        const basic_astrodynamics::orbital_element_conversions::Vector6d&
+        keplerianElementsOfSecondObject,
+        const double screeningDistance );
+
+//! Check if orbit paths of two objects can come within screening distance.
+/*!
+ * Checks if the orbit paths of two objects can come within the screening distance of each other.
+ * This filter is meant to be applied to pairs that pass passesApogeePerigeeFilter(). For
+ * non-coplanar orbits, points of the orbits can only be close near the line of intersection of
+ * the orbital planes. Around each node, the range of true anomaly in which an orbit lies within
+ * the screening distance of the other orbital plane is determined, and the ranges of radii of
+ * both orbits in these windows are compared (Hoots et al., 1984). For (nearly) coplanar orbits,
+ * for which these windows become large, and for non-elliptical orbits, the filter is not applied
+ * and true is returned. The filter is conservative: it never rejects orbits that can come within
+ * the screening distance.
+ * \param keplerianElementsOfFirstObject Keplerian elements of first object.
+ * \param keplerianElementsOfSecondObject Keplerian elements of second object.
+ * \param screeningDistance Screening distance.                                                 [m]
+ * \return True if the orbit paths can come within the screening distance.
+ */
+bool passesOrbitPathFilter(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d&
+        keplerianElementsOfFirstObject,
+        const basic_astrodynamics::orbital_element_conversions::Vector6d&
+        keplerianElementsOfSecondObject,
+        const double screeningDistance );
+
+//! Screen catalog of objects for conjunctions.
+/*!
+ * Screens a catalog of objects for conjunctions, i.e., local minima of the distance between two
+ * objects that are smaller than the screening distance, over the span of a time grid. The
+ * epochs of the grid are divided over multiple threads for the spatial hashing stage, and the
+ * candidate pairs are divided over multiple threads for the computation of the times of closest
+ * approach. Local minima at the start and end of the time grid are included. An error is thrown
+ * if the catalog contains parabolic orbits or invalid eccentricities, or if the time grid is
+ * invalid.
+ * \param keplerianElements Matrix of Keplerian elements of the objects at the epoch of the
+ *          catalog, one per column (6 x N).
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param epochs Strictly increasing time grid with at least two epochs, with respect to the epoch
+ *          of the catalog.                                                                     [s]
+ * \param screeningDistance Screening distance.                                                 [m]
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \param timeOfClosestApproachTolerance Absolute tolerance on time of closest approach.        [s]
+ * \return Conjunctions, sorted by object indices and time of closest approach.
+ */
+std::vector< Conjunction > screenCatalogForConjunctions(
+        const Eigen::MatrixXd& keplerianElements, const double centralBodyGravitationalParameter,
+        const Eigen::VectorXd& epochs, const double screeningDistance,
+        const unsigned int numberOfThreads = 0,
+        const double timeOfClosestApproachTolerance = 1.0e-6 );
+
+} // namespace conjunction_screening
+} // namespace tudat
+
+#endif // TUDAT_CORE_CATALOG_SCREENING_H
@@ -0,0 +1,216 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Meeus, J. Astronomical Algorithms, 2nd Edition, Willmann-Bell, Richmond, VA, 1998.
+ *
+ *    Notes
+ *      The reference positions are taken from the worked examples of Meeus (1998), which are
+ *      based on the full VSOP87 and ELP2000 theories, converted to the ecliptic of J2000 where
+ *      the examples are given with respect to the ecliptic of date. The tolerances reflect the
+ *      accuracy of the approximate models.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h"
+#include "TudatCore/Astrodynamics/Ephemerides/approximateEphemerides.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_astrodynamics::physical_constants::ASTRONOMICAL_UNIT;
+using tudat::basic_astrodynamics::physical_constants::JULIAN_DAY;
+using tudat::basic_mathematics::mathematical_constants::PI;
+using tudat::basic_astrodynamics::unit_conversions::convertDegreesToRadians;
+using tudat::basic_astrodynamics::unit_conversions::convertRadiansToDegrees;
+
+//! Convert Julian date to seconds since J2000.
+/*!
+ * Converts a Julian date to seconds since J2000.
+ * \param julianDate Julian date.                                                            [days]
+ * \return Seconds since J2000.                                                                 [s]
+ */
+double convertJulianDateToSecondsSinceJ2000( const double julianDate )
+{
+    return ( julianDate - 2451545.0 ) * JULIAN_DAY;
+}
+
+//! Convert equatorial position to ecliptic longitude, latitude and distance.
+/*!
+ * Converts a position in the frame of the mean equator and equinox of J2000 to longitude,
+ * latitude and distance with respect to the ecliptic and equinox of J2000.
+ * \param position Position in frame of mean equator and equinox of J2000.                      [m]
+ * \return Ecliptic longitude [deg], in the range [0, 360), latitude [deg] and distance [m].
+ */
+Eigen::Vector3d convertToEclipticCoordinates( const Eigen::Vector3d& position )
+{
+    const Eigen::Vector3d eclipticPosition
+            = Eigen::AngleAxisd( -convertDegreesToRadians( 23.43929111 ),
+                                 Eigen::Vector3d::UnitX( ) ) * position;
+    double longitude = std::atan2( eclipticPosition.y( ), eclipticPosition.x( ) );
+    if ( longitude < 0.0 )
+    {
+        longitude += 2.0 * PI;
+    }
+
+    return Eigen::Vector3d( convertRadiansToDegrees( longitude ),
+                            convertRadiansToDegrees(
+                                std::asin( eclipticPosition.z( ) / eclipticPosition.norm( ) ) ),
+                            eclipticPosition.norm( ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_approximate_ephemerides )
+
+//! Test approximate position of Sun.
+BOOST_AUTO_TEST_CASE( testApproximateSunPosition )
+{
+    // Geometric position of Sun at J2000 (Meeus, 1998, Chapter 25).
+    const Eigen::Vector3d eclipticCoordinates = convertToEclipticCoordinates(
+                ephemerides::computeApproximateGeocentricPosition( ephemerides::sun, 0.0 ) );
+
+    BOOST_CHECK_SMALL( eclipticCoordinates( 0 ) - 280.3822, 0.01 );
+    BOOST_CHECK_SMALL( eclipticCoordinates( 1 ), 0.001 );
+    BOOST_CHECK_CLOSE_FRACTION( eclipticCoordinates( 2 ), 0.983327 * ASTRONOMICAL_UNIT, 1.0e-4 );
+}
+
+//! Test approximate position of Venus.
+BOOST_AUTO_TEST_CASE( testApproximateVenusPosition )
+{
+    // Heliocentric position of Venus on 1992 December 20, 0h TD (Meeus, 1998, Example 32.a).
+    const double epoch = convertJulianDateToSecondsSinceJ2000( 2448976.5 );
+    const Eigen::Vector3d eclipticCoordinates = convertToEclipticCoordinates(
+                ephemerides::computeApproximateGeocentricPosition( ephemerides::venus, epoch )
+                - ephemerides::computeApproximateGeocentricPosition( ephemerides::sun, epoch ) );
+
+    BOOST_CHECK_SMALL( eclipticCoordinates( 0 ) - 26.2125, 0.02 );
+    BOOST_CHECK_SMALL( eclipticCoordinates( 1 ) + 2.6207, 0.01 );
+    BOOST_CHECK_CLOSE_FRACTION( eclipticCoordinates( 2 ), 0.724603 * ASTRONOMICAL_UNIT, 1.0e-4 );
+}
+
+//! Test approximate position of Moon.
+BOOST_AUTO_TEST_CASE( testApproximateMoonPosition )
+{
+    // Geometric position of Moon on 1992 April 12, 0h TD (Meeus, 1998, Example 47.a).
+    const Eigen::Vector3d eclipticCoordinates = convertToEclipticCoordinates(
+                ephemerides::computeApproximateGeocentricPosition(
+                    ephemerides::moon, convertJulianDateToSecondsSinceJ2000( 2448724.5 ) ) );
+
+    BOOST_CHECK_SMALL( eclipticCoordinates( 0 ) - 133.2706, 0.05 );
+    BOOST_CHECK_SMALL( eclipticCoordinates( 1 ) + 3.2291, 0.02 );
+    BOOST_CHECK_SMALL( eclipticCoordinates( 2 ) - 3.684097e8, 2.0e5 );
+}
+
+//! Test approximate positions at multiple epochs against single computations.
+BOOST_AUTO_TEST_CASE( testApproximateGeocentricPositions )
+{
+    const Eigen::VectorXd epochs = Eigen::VectorXd::LinSpaced( 101, -3.0e9, 3.0e9 );
+
+    for ( int body = ephemerides::sun; body <= ephemerides::neptune; body++ )
+    {
+        const ephemerides::ApproximateEphemerisBody ephemerisBody
+                = static_cast< ephemerides::ApproximateEphemerisBody >( body );
+
+        // Compute positions at all epochs, both with a single and multiple threads.
+        Eigen::MatrixXd positions;
+        ephemerides::computeApproximateGeocentricPositions( ephemerisBody, epochs, positions, 1 );
+        Eigen::MatrixXd parallelPositions;
+        ephemerides::computeApproximateGeocentricPositions( ephemerisBody, epochs,
+                                                            parallelPositions, 4 );
+
+        BOOST_CHECK_EQUAL( positions.rows( ), 3 );
+        BOOST_CHECK_EQUAL( positions.cols( ), epochs.rows( ) );
+        BOOST_CHECK( positions == parallelPositions );
+
+        for ( int i = 0; i < epochs.rows( ); i++ )
+        {
+            const Eigen::Vector3d expectedPosition
+                    = ephemerides::computeApproximateGeocentricPosition( ephemerisBody,
+                                                                         epochs( i ) );
+            BOOST_CHECK_SMALL( ( positions.col( i ) - expectedPosition ).norm( )
+                               / expectedPosition.norm( ), 1.0e-12 );
+        }
+    }
+}
+
+//! Test tabulated approximate ephemeris.
+BOOST_AUTO_TEST_CASE( testTabulatedApproximateEphemeris )
+{
+    const double startEpoch = 1.0e8;
+    const double timeStep = 3600.0;
+    const int numberOfEpochs = 49;
+
+    const ephemerides::TabulatedApproximateEphemeris tabulatedEphemeris(
+                ephemerides::moon, startEpoch, timeStep, numberOfEpochs );
+
+    BOOST_CHECK_EQUAL( tabulatedEphemeris.getTabulatedPositions( ).cols( ), numberOfEpochs );
+    BOOST_CHECK_EQUAL( tabulatedEphemeris.getStartEpoch( ), startEpoch );
+    BOOST_CHECK_EQUAL( tabulatedEphemeris.getTimeStep( ), timeStep );
+
+    // Check that positions at grid epochs are returned exactly.
+    for ( int i = 0; i < numberOfEpochs; i++ )
+    {
+        BOOST_CHECK( tabulatedEphemeris.getPosition( startEpoch + i * timeStep )
+                     == tabulatedEphemeris.getTabulatedPositions( ).col( i ) );
+    }
+
+    // Check interpolated positions in between grid epochs, including first and last intervals.
+    for ( double epoch = startEpoch + 0.3 * timeStep;
+          epoch < startEpoch + ( numberOfEpochs - 1 ) * timeStep; epoch += 0.7 * timeStep )
+    {
+        BOOST_CHECK_SMALL( ( tabulatedEphemeris.getPosition( epoch )
+                             - ephemerides::computeApproximateGeocentricPosition(
+                                 ephemerides::moon, epoch ) ).norm( ), 1.0 );
+    }
+
+    // Check that epochs outside grid and invalid grids throw.
+    BOOST_CHECK_THROW( tabulatedEphemeris.getPosition( startEpoch - 1.0 ), std::runtime_error );
+    BOOST_CHECK_THROW( tabulatedEphemeris.getPosition(
+                           startEpoch + numberOfEpochs * timeStep ), std::runtime_error );
+    BOOST_CHECK_THROW( ephemerides::TabulatedApproximateEphemeris(
+                           ephemerides::moon, startEpoch, 0.0, numberOfEpochs ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( ephemerides::TabulatedApproximateEphemeris(
+                           ephemerides::moon, startEpoch, timeStep, 3 ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
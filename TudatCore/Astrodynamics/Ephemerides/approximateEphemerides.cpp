@@ -0,0 +1,463 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Standish, E.M. Keplerian elements for approximate positions of the major planets, JPL
+ *          Solar System Dynamics, http://ssd.jpl.nasa.gov/txt/aprx_pos_planets.pdf, 2006.
+ *      Montenbruck, O., Gill, E. Satellite Orbits, Springer, 2000.
+ *
+ *    Notes
+ *      The mean Keplerian elements only determine positions; the gravitational parameter of the
+ *      Sun passed to the conversion of Keplerian elements only affects the velocities, which are
+ *      not used.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h"
+#include "TudatCore/Astrodynamics/Ephemerides/approximateEphemerides.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+namespace
+{
+
+using basic_astrodynamics::orbital_element_conversions::Vector6d;
+using basic_astrodynamics::unit_conversions::convertDegreesToRadians;
+
+//! Gravitational parameter of the Sun, only used to convert mean elements to positions.
+const double SUN_GRAVITATIONAL_PARAMETER = 1.32712440018e20;
+
+//! Obliquity of the ecliptic at J2000.
+const double OBLIQUITY_OF_ECLIPTIC_AT_J2000 = convertDegreesToRadians( 23.43929111 );
+
+//! Number of seconds per Julian century.
+const double JULIAN_CENTURY = 100.0 * basic_astrodynamics::physical_constants::JULIAN_YEAR;
+
+//! Arcseconds in radians.
+const double ARCSECOND = basic_mathematics::mathematical_constants::PI / ( 180.0 * 3600.0 );
+
+//! Mean Keplerian elements of a planet and their rates.
+/*!
+ * Mean Keplerian elements of a planet with respect to the mean ecliptic and equinox of J2000,
+ * and their rates per Julian century (Standish, 2006), in astronomical units and degrees.
+ */
+struct ApproximatePlanetElements
+{
+    //! Semi-major axis and its rate.                                              [AU, AU/cy]
+    double semiMajorAxis[ 2 ];
+
+    //! Eccentricity and its rate.                                                  [-, 1/cy]
+    double eccentricity[ 2 ];
+
+    //! Inclination and its rate.                                               [deg, deg/cy]
+    double inclination[ 2 ];
+
+    //! Mean longitude and its rate.                                            [deg, deg/cy]
+    double meanLongitude[ 2 ];
+
+    //! Longitude of perihelion and its rate.                                   [deg, deg/cy]
+    double longitudeOfPerihelion[ 2 ];
+
+    //! Longitude of ascending node and its rate.                               [deg, deg/cy]
+    double longitudeOfAscendingNode[ 2 ];
+};
+
+//! Mean Keplerian elements of the Earth-Moon barycenter (Standish, 2006, Table 1).
+const ApproximatePlanetElements EARTH_MOON_BARYCENTER_ELEMENTS =
+{
+    { 1.00000261, 0.00000562 }, { 0.01671123, -0.00004392 }, { -0.00001531, -0.01294668 },
+    { 100.46457166, 35999.37244981 }, { 102.93768193, 0.32327364 }, { 0.0, 0.0 }
+};
+
+//! Mean Keplerian elements of the planets, ordered as in ApproximateEphemerisBody (Standish,
+//! 2006, Table 1).
+const ApproximatePlanetElements PLANET_ELEMENTS[ 7 ] =
+{
+    // Mercury.
+    { { 0.38709927, 0.00000037 }, { 0.20563593, 0.00001906 }, { 7.00497902, -0.00594749 },
+      { 252.25032350, 149472.67411175 }, { 77.45779628, 0.16047689 },
+      { 48.33076593, -0.12534081 } },
+    // Venus.
+    { { 0.72333566, 0.00000390 }, { 0.00677672, -0.00004107 }, { 3.39467605, -0.00078890 },
+      { 181.97909950, 58517.81538729 }, { 131.60246718, 0.00268329 },
+      { 76.67984255, -0.27769418 } },
+    // Mars.
+    { { 1.52371034, 0.00001847 }, { 0.09339410, 0.00007882 }, { 1.84969142, -0.00813131 },
+      { -4.55343205, 19140.30268499 }, { -23.94362959, 0.44441088 },
+      { 49.55953891, -0.29257343 } },
+    // Jupiter.
+    { { 5.20288700, -0.00011607 }, { 0.04838624, -0.00013253 }, { 1.30439695, -0.00183714 },
+      { 34.39644051, 3034.74612775 }, { 14.72847983, 0.21252668 },
+      { 100.47390909, 0.20469106 } },
+    // Saturn.
+    { { 9.53667594, -0.00125060 }, { 0.05386179, -0.00050991 }, { 2.48599187, 0.00193609 },
+      { 49.95424423, 1222.49362201 }, { 92.59887831, -0.41897216 },
+      { 113.66242448, -0.28867794 } },
+    // Uranus.
+    { { 19.18916464, -0.00196176 }, { 0.04725744, -0.00004397 }, { 0.77263783, -0.00242939 },
+      { 313.23810451, 428.48202785 }, { 170.95427630, 0.40805281 },
+      { 74.01692503, 0.04240589 } },
+    // Neptune.
+    { { 30.06992276, 0.00026291 }, { 0.00859048, 0.00005105 }, { 1.77004347, 0.00035372 },
+      { -55.12002969, 218.45945325 }, { 44.96476227, -0.32241464 },
+      { 131.78422574, -0.00508664 } }
+};
+
+//! Get mean Keplerian elements of planet.
+/*!
+ * Returns the mean Keplerian elements of a planet, throwing an error if the body is not a planet.
+ * \param body Planet.
+ * \return Mean Keplerian elements of planet.
+ */
+const ApproximatePlanetElements& getPlanetElements( const ApproximateEphemerisBody body )
+{
+    if ( body < mercury || body > neptune )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Body has no approximate planet elements." ) ) );
+    }
+    return PLANET_ELEMENTS[ body - mercury ];
+}
+
+//! Compute Keplerian elements from mean elements.
+/*!
+ * Computes the Keplerian elements at a number of epochs from the mean elements and their rates,
+ * except for the true anomaly, which is returned as mean anomaly.
+ * \param elements Mean elements and rates.
+ * \param julianCenturies Epochs in Julian centuries since J2000.
+ * \param keplerianElements Matrix in which the Keplerian elements are stored (6 x N), with the
+ *          mean anomaly instead of the true anomaly.
+ */
+void computeKeplerianElementsFromMeanElements( const ApproximatePlanetElements& elements,
+                                               const Eigen::ArrayXd& julianCenturies,
+                                               Eigen::MatrixXd& keplerianElements )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    const double degreesToRadians_ = convertDegreesToRadians( 1.0 );
+
+    keplerianElements.resize( 6, julianCenturies.size( ) );
+    keplerianElements.row( semiMajorAxisIndex ) = basic_astrodynamics::physical_constants::
+            ASTRONOMICAL_UNIT * ( elements.semiMajorAxis[ 0 ]
+                                  + elements.semiMajorAxis[ 1 ] * julianCenturies ).matrix( );
+    keplerianElements.row( eccentricityIndex ) = ( elements.eccentricity[ 0 ]
+            + elements.eccentricity[ 1 ] * julianCenturies ).matrix( );
+    keplerianElements.row( inclinationIndex ) = degreesToRadians_
+            * ( elements.inclination[ 0 ] + elements.inclination[ 1 ] * julianCenturies )
+            .matrix( );
+    keplerianElements.row( longitudeOfAscendingNodeIndex ) = degreesToRadians_
+            * ( elements.longitudeOfAscendingNode[ 0 ]
+                + elements.longitudeOfAscendingNode[ 1 ] * julianCenturies ).matrix( );
+
+    // Argument of periapsis and mean anomaly from longitudes of perihelion and node, and mean
+    // longitude.
+    keplerianElements.row( argumentOfPeriapsisIndex ) = degreesToRadians_
+            * ( elements.longitudeOfPerihelion[ 0 ] - elements.longitudeOfAscendingNode[ 0 ]
+                + ( elements.longitudeOfPerihelion[ 1 ] - elements.longitudeOfAscendingNode[ 1 ] )
+                * julianCenturies ).matrix( );
+    keplerianElements.row( trueAnomalyIndex ) = degreesToRadians_
+            * ( elements.meanLongitude[ 0 ] - elements.longitudeOfPerihelion[ 0 ]
+                + ( elements.meanLongitude[ 1 ] - elements.longitudeOfPerihelion[ 1 ] )
+                * julianCenturies ).matrix( );
+}
+
+//! Compute heliocentric ecliptic position from mean elements.
+/*!
+ * Computes the heliocentric position with respect to the mean ecliptic and equinox of J2000 from
+ * the mean elements, at a single epoch.
+ * \param elements Mean elements and rates.
+ * \param julianCenturies Epoch in Julian centuries since J2000.
+ * \return Heliocentric ecliptic position.                                                     [m]
+ */
+Eigen::Vector3d computeHeliocentricEclipticPosition( const ApproximatePlanetElements& elements,
+                                                     const double julianCenturies )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    Eigen::MatrixXd keplerianElements_;
+    computeKeplerianElementsFromMeanElements(
+                elements, Eigen::ArrayXd::Constant( 1, julianCenturies ), keplerianElements_ );
+
+    Vector6d keplerianElementsVector_ = keplerianElements_.col( 0 );
+    const double eccentricity_ = keplerianElementsVector_( eccentricityIndex );
+    keplerianElementsVector_( trueAnomalyIndex ) = convertEllipticalEccentricAnomalyToTrueAnomaly(
+                convertMeanAnomalyToEllipticalEccentricAnomaly(
+                    keplerianElementsVector_( trueAnomalyIndex ), eccentricity_ ),
+                eccentricity_ );
+
+    return convertKeplerianToCartesianElements(
+                keplerianElementsVector_, SUN_GRAVITATIONAL_PARAMETER ).head< 3 >( );
+}
+
+//! Compute heliocentric ecliptic positions from mean elements at multiple epochs.
+/*!
+ * Computes the heliocentric positions with respect to the mean ecliptic and equinox of J2000
+ * from the mean elements, at a number of epochs, with the multi-orbit conversions of anomalies
+ * and Keplerian elements.
+ * \param elements Mean elements and rates.
+ * \param julianCenturies Epochs in Julian centuries since J2000.
+ * \param numberOfThreads Number of threads to use for conversion of Keplerian elements.
+ * \return Heliocentric ecliptic positions (3 x N).                                            [m]
+ */
+Eigen::MatrixXd computeHeliocentricEclipticPositions( const ApproximatePlanetElements& elements,
+                                                      const Eigen::ArrayXd& julianCenturies,
+                                                      const unsigned int numberOfThreads )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    Eigen::MatrixXd keplerianElements_;
+    computeKeplerianElementsFromMeanElements( elements, julianCenturies, keplerianElements_ );
+
+    const Eigen::VectorXd eccentricities_ = keplerianElements_.row( eccentricityIndex )
+            .transpose( );
+    keplerianElements_.row( trueAnomalyIndex ) = convertEccentricAnomalyToTrueAnomaly(
+                convertMeanAnomalyToEccentricAnomaly(
+                    keplerianElements_.row( trueAnomalyIndex ).transpose( ),
+                    eccentricities_ ).array( ), eccentricities_.array( ) ).matrix( ).transpose( );
+
+    Eigen::MatrixXd cartesianElements_;
+    convertKeplerianToCartesianElements( keplerianElements_, SUN_GRAVITATIONAL_PARAMETER,
+                                         cartesianElements_, numberOfThreads );
+    return cartesianElements_.topRows( 3 );
+}
+
+//! Compute lunar ecliptic coordinates.
+/*!
+ * Computes the geocentric ecliptic longitude, latitude and distance of the Moon with respect to
+ * the mean ecliptic and equinox of J2000, from the main periodic terms of the lunar theory
+ * (Montenbruck and Gill, 2000). The function is evaluated either for a single epoch, or for a
+ * set of epochs with vectorized array expressions.
+ * \param julianCenturies Epoch(s) in Julian centuries since J2000 (double or Eigen::ArrayXd).
+ * \param longitude Ecliptic longitude.                                                       [rad]
+ * \param latitude Ecliptic latitude.                                                         [rad]
+ * \param distance Distance.                                                                    [m]
+ */
+template< typename ScalarOrArray >
+void computeLunarEclipticCoordinates( const ScalarOrArray& julianCenturies,
+                                      ScalarOrArray& longitude, ScalarOrArray& latitude,
+                                      ScalarOrArray& distance )
+{
+    using std::cos;
+    using std::sin;
+
+    const double degreesToRadians_ = convertDegreesToRadians( 1.0 );
+
+    // Mean longitude of the Moon, including precession to the equinox of J2000, mean anomalies
+    // of the Moon and the Sun, mean argument of latitude of the Moon, and mean elongation of the
+    // Moon from the Sun.
+    const ScalarOrArray meanLongitude_
+            = degreesToRadians_ * ( 218.31617 + ( 481267.88088 - 1.3972 ) * julianCenturies );
+    const ScalarOrArray l_ = degreesToRadians_ * ( 134.96292 + 477198.86753 * julianCenturies );
+    const ScalarOrArray lp_ = degreesToRadians_ * ( 357.52543 + 35999.04944 * julianCenturies );
+    const ScalarOrArray f_ = degreesToRadians_ * ( 93.27283 + 483202.01873 * julianCenturies );
+    const ScalarOrArray d_ = degreesToRadians_ * ( 297.85027 + 445267.11135 * julianCenturies );
+
+    longitude = meanLongitude_ + ARCSECOND * (
+                22640.0 * sin( l_ ) + 769.0 * sin( 2.0 * l_ )
+                - 4586.0 * sin( l_ - 2.0 * d_ ) + 2370.0 * sin( 2.0 * d_ )
+                - 668.0 * sin( lp_ ) - 412.0 * sin( 2.0 * f_ )
+                - 212.0 * sin( 2.0 * l_ - 2.0 * d_ ) - 206.0 * sin( l_ + lp_ - 2.0 * d_ )
+                + 192.0 * sin( l_ + 2.0 * d_ ) - 165.0 * sin( lp_ - 2.0 * d_ )
+                + 148.0 * sin( l_ - lp_ ) - 125.0 * sin( d_ )
+                - 110.0 * sin( l_ + lp_ ) - 55.0 * sin( 2.0 * f_ - 2.0 * d_ ) );
+
+    latitude = ARCSECOND * (
+                18520.0 * sin( f_ + longitude - meanLongitude_
+                               + ARCSECOND * ( 412.0 * sin( 2.0 * f_ ) + 541.0 * sin( lp_ ) ) )
+                - 526.0 * sin( f_ - 2.0 * d_ ) + 44.0 * sin( l_ + f_ - 2.0 * d_ )
+                - 31.0 * sin( -l_ + f_ - 2.0 * d_ ) - 25.0 * sin( -2.0 * l_ + f_ )
+                - 23.0 * sin( lp_ + f_ - 2.0 * d_ ) + 21.0 * sin( -l_ + f_ )
+                + 11.0 * sin( -lp_ + f_ - 2.0 * d_ ) );
+
+    distance = 1.0e3 * ( 385000.0 - 20905.0 * cos( l_ ) - 3699.0 * cos( 2.0 * d_ - l_ )
+                         - 2956.0 * cos( 2.0 * d_ ) - 570.0 * cos( 2.0 * l_ )
+                         + 246.0 * cos( 2.0 * l_ - 2.0 * d_ ) - 205.0 * cos( lp_ - 2.0 * d_ )
+                         - 171.0 * cos( l_ + 2.0 * d_ ) - 152.0 * cos( l_ + lp_ - 2.0 * d_ ) );
+}
+
+//! Get rotation from ecliptic to equatorial frame of J2000.
+/*!
+ * Returns the rotation matrix from the frame of the mean ecliptic and equinox of J2000 to the
+ * frame of the mean equator and equinox of J2000.
+ * \return Rotation matrix from ecliptic to equatorial frame.
+ */
+Eigen::Matrix3d getEclipticToEquatorialRotation( )
+{
+    return Eigen::AngleAxisd( OBLIQUITY_OF_ECLIPTIC_AT_J2000,
+                              Eigen::Vector3d::UnitX( ) ).toRotationMatrix( );
+}
+
+} // namespace
+
+//! Compute approximate geocentric position of body.
+Eigen::Vector3d computeApproximateGeocentricPosition( const ApproximateEphemerisBody body,
+                                                      const double secondsSinceJ2000 )
+{
+    const double julianCenturies_ = secondsSinceJ2000 / JULIAN_CENTURY;
+
+    Eigen::Vector3d eclipticPosition_;
+    if ( body == moon )
+    {
+        double longitude_, latitude_, distance_;
+        computeLunarEclipticCoordinates( julianCenturies_, longitude_, latitude_, distance_ );
+        eclipticPosition_ << distance_ * std::cos( latitude_ ) * std::cos( longitude_ ),
+                distance_ * std::cos( latitude_ ) * std::sin( longitude_ ),
+                distance_ * std::sin( latitude_ );
+    }
+    else
+    {
+        eclipticPosition_ = -computeHeliocentricEclipticPosition(
+                    EARTH_MOON_BARYCENTER_ELEMENTS, julianCenturies_ );
+        if ( body != sun )
+        {
+            eclipticPosition_ += computeHeliocentricEclipticPosition(
+                        getPlanetElements( body ), julianCenturies_ );
+        }
+    }
+
+    return getEclipticToEquatorialRotation( ) * eclipticPosition_;
+}
+
+//! Compute approximate geocentric positions of body at multiple epochs.
+void computeApproximateGeocentricPositions( const ApproximateEphemerisBody body,
+                                            const Eigen::VectorXd& secondsSinceJ2000,
+                                            Eigen::MatrixXd& geocentricPositions,
+                                            const unsigned int numberOfThreads )
+{
+    const Eigen::ArrayXd julianCenturies_ = secondsSinceJ2000.array( ) / JULIAN_CENTURY;
+
+    Eigen::MatrixXd eclipticPositions_;
+    if ( body == moon )
+    {
+        Eigen::ArrayXd longitudes_, latitudes_, distances_;
+        computeLunarEclipticCoordinates( julianCenturies_, longitudes_, latitudes_, distances_ );
+
+        eclipticPositions_.resize( 3, julianCenturies_.size( ) );
+        eclipticPositions_.row( 0 ) = ( distances_ * latitudes_.cos( ) * longitudes_.cos( ) )
+                .matrix( ).transpose( );
+        eclipticPositions_.row( 1 ) = ( distances_ * latitudes_.cos( ) * longitudes_.sin( ) )
+                .matrix( ).transpose( );
+        eclipticPositions_.row( 2 ) = ( distances_ * latitudes_.sin( ) ).matrix( ).transpose( );
+    }
+    else
+    {
+        eclipticPositions_ = -computeHeliocentricEclipticPositions(
+                    EARTH_MOON_BARYCENTER_ELEMENTS, julianCenturies_, numberOfThreads );
+        if ( body != sun )
+        {
+            eclipticPositions_ += computeHeliocentricEclipticPositions(
+                        getPlanetElements( body ), julianCenturies_, numberOfThreads );
+        }
+    }
+
+    geocentricPositions.resize( 3, secondsSinceJ2000.size( ) );
+    geocentricPositions.noalias( ) = getEclipticToEquatorialRotation( ) * eclipticPositions_;
+}
+
+//! Default constructor.
+TabulatedApproximateEphemeris::TabulatedApproximateEphemeris(
+        const ApproximateEphemerisBody body, const double startEpoch, const double timeStep,
+        const int numberOfEpochs, const unsigned int numberOfThreads )
+    : startEpoch_( startEpoch ),
+      timeStep_( timeStep )
+{
+    if ( !( timeStep_ > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Time step of tabulated ephemeris is not "
+                                            "positive." ) ) );
+    }
+
+    if ( numberOfEpochs < 4 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Tabulated ephemeris requires at least four "
+                                            "epochs." ) ) );
+    }
+
+    const Eigen::VectorXd epochs_ = ( startEpoch_ + timeStep_ * Eigen::ArrayXd::LinSpaced(
+                                          numberOfEpochs, 0.0, numberOfEpochs - 1.0 ) ).matrix( );
+    computeApproximateGeocentricPositions( body, epochs_, tabulatedPositions_, numberOfThreads );
+}
+
+//! Get position.
+Eigen::Vector3d TabulatedApproximateEphemeris::getPosition( const double secondsSinceJ2000 ) const
+{
+    // Tolerance on the fractional grid index, within which epochs are taken to coincide with grid
+    // epochs.
+    const double gridTolerance_ = 1.0e-9;
+
+    const int numberOfEpochs_ = static_cast< int >( tabulatedPositions_.cols( ) );
+    const double gridIndex_ = ( secondsSinceJ2000 - startEpoch_ ) / timeStep_;
+
+    if ( gridIndex_ < -gridTolerance_ || gridIndex_ > numberOfEpochs_ - 1 + gridTolerance_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Epoch lies outside tabulated ephemeris." ) ) );
+    }
+
+    const double nearestGridIndex_ = std::floor( gridIndex_ + 0.5 );
+    if ( std::fabs( gridIndex_ - nearestGridIndex_ ) <= gridTolerance_ )
+    {
+        return tabulatedPositions_.col( static_cast< int >( nearestGridIndex_ ) );
+    }
+
+    // Cubic Lagrange interpolation through the four nearest grid epochs, shifted inwards at the
+    // boundaries of the grid.
+    const int firstIndex_ = std::min( std::max( static_cast< int >( std::floor( gridIndex_ ) ) - 1,
+                                                0 ), numberOfEpochs_ - 4 );
+    const double x_ = gridIndex_ - firstIndex_;
+
+    Eigen::Vector4d weights_;
+    weights_ << -( x_ - 1.0 ) * ( x_ - 2.0 ) * ( x_ - 3.0 ) / 6.0,
+            x_ * ( x_ - 2.0 ) * ( x_ - 3.0 ) / 2.0,
+            -x_ * ( x_ - 1.0 ) * ( x_ - 3.0 ) / 2.0,
+            x_ * ( x_ - 1.0 ) * ( x_ - 2.0 ) / 6.0;
+
+    return tabulatedPositions_.middleCols< 4 >( firstIndex_ ) * weights_;
+}
+
+} // namespace ephemerides
+} // namespace tudat
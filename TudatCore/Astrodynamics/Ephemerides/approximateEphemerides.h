@@ -0,0 +1,175 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Standish, E.M. Keplerian elements for approximate positions of the major planets, JPL
+ *          Solar System Dynamics, http://ssd.jpl.nasa.gov/txt/aprx_pos_planets.pdf, 2006.
+ *      Montenbruck, O., Gill, E. Satellite Orbits, Springer, 2000.
+ *
+ *    Notes
+ *      The positions of the planets and the Earth-Moon barycenter are computed from the mean
+ *      Keplerian elements of Standish (2006), Table 1, which are valid from 1800 AD to 2050 AD.
+ *      The position of the Sun with respect to the Earth is taken as the opposite of the
+ *      heliocentric position of the Earth-Moon barycenter, and the geocentric positions of the
+ *      planets as their heliocentric positions minus that of the Earth-Moon barycenter, which
+ *      introduces an error of at most 4700 km. The orbit of the Moon is too strongly perturbed by
+ *      the Sun to be represented by mean Keplerian elements, so that its position is computed
+ *      from the main periodic terms of the lunar theory (Montenbruck and Gill, 2000), with an
+ *      accuracy of several arcminutes.
+ *
+ *      All positions are expressed in the frame of the mean equator and equinox of J2000, and
+ *      epochs are given in seconds since J2000 (1 January 2000, 12:00 TDB), without distinction
+ *      between the TDB and TT time scales.
+ *
+ */
+
+#ifndef TUDAT_CORE_APPROXIMATE_EPHEMERIDES_H
+#define TUDAT_CORE_APPROXIMATE_EPHEMERIDES_H
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+//! Bodies for which approximate ephemerides are available.
+enum ApproximateEphemerisBody
+{
+    sun, moon, mercury, venus, mars, jupiter, saturn, uranus, neptune
+};
+
+//! Compute approximate geocentric position of body.
+/*!
+ * Computes the approximate position of a body with respect to the Earth, as described in the
+ * notes of this file.
+ * \param body Body of which the position is computed.
+ * \param secondsSinceJ2000 Epoch in seconds since J2000.                                       [s]
+ * \return Geocentric position in frame of mean equator and equinox of J2000.                  [m]
+ */
+Eigen::Vector3d computeApproximateGeocentricPosition( const ApproximateEphemerisBody body,
+                                                      const double secondsSinceJ2000 );
+
+//! Compute approximate geocentric positions of body at multiple epochs.
+/*!
+ * Computes the approximate positions of a body with respect to the Earth at a set of epochs,
+ * using the same models as computeApproximateGeocentricPosition(). The mean elements of all
+ * epochs are converted to Cartesian positions at once, with the multi-orbit conversion of
+ * Keplerian elements, and the lunar series is evaluated with vectorized array expressions over
+ * all epochs.
+ * \param body Body of which the positions are computed.
+ * \param secondsSinceJ2000 Vector of epochs in seconds since J2000.                           [s]
+ * \param geocentricPositions Matrix in which the geocentric positions in the frame of mean
+ *          equator and equinox of J2000 are stored, with one epoch per column (3 x N). If the
+ *          matrix is preallocated with the correct size, it is not resized.                    [m]
+ * \param numberOfThreads Number of threads to use for the conversion of Keplerian elements. If
+ *          set to 0, the number of hardware threads is used.
+ */
+void computeApproximateGeocentricPositions( const ApproximateEphemerisBody body,
+                                            const Eigen::VectorXd& secondsSinceJ2000,
+                                            Eigen::MatrixXd& geocentricPositions,
+                                            const unsigned int numberOfThreads = 0 );
+
+//! Tabulated approximate ephemeris.
+/*!
+ * Approximate ephemeris of a body, tabulated on an equidistant grid of epochs on construction,
+ * such that repeated evaluations during a numerical propagation do not require the models to be
+ * evaluated again. Positions at the grid epochs are returned as tabulated; in between, they are
+ * interpolated with cubic Lagrange polynomials through the four nearest grid epochs. By choosing
+ * a grid step equal to half the integration step of a Runge-Kutta 4 integrator, all epochs at
+ * which the state derivative is evaluated coincide with grid epochs. The getPosition() function
+ * can be bound to a position function, e.g.:
+ * \code
+ * boost::bind( &TabulatedApproximateEphemeris::getPosition, &tabulatedEphemeris, _1 )
+ * \endcode
+ */
+class TabulatedApproximateEphemeris
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, which tabulates the geocentric positions of a body with
+     * computeApproximateGeocentricPositions(). An error is thrown if the time step is not
+     * positive, or if fewer than four epochs are requested.
+     * \param body Body of which the positions are tabulated.
+     * \param startEpoch First epoch of grid in seconds since J2000.                            [s]
+     * \param timeStep Time step of grid.                                                       [s]
+     * \param numberOfEpochs Number of epochs of grid.
+     * \param numberOfThreads Number of threads to use for the tabulation. If set to 0, the
+     *          number of hardware threads is used.
+     */
+    TabulatedApproximateEphemeris( const ApproximateEphemerisBody body, const double startEpoch,
+                                   const double timeStep, const int numberOfEpochs,
+                                   const unsigned int numberOfThreads = 0 );
+
+    //! Get position.
+    /*!
+     * Returns the geocentric position of the body at a given epoch, which is taken from the grid
+     * or interpolated. An error is thrown if the epoch lies outside the grid.
+     * \param secondsSinceJ2000 Epoch in seconds since J2000.                                   [s]
+     * \return Geocentric position in frame of mean equator and equinox of J2000.              [m]
+     */
+    Eigen::Vector3d getPosition( const double secondsSinceJ2000 ) const;
+
+    //! Get tabulated positions.
+    /*!
+     * Returns the tabulated geocentric positions.
+     * \return Matrix of geocentric positions, with one grid epoch per column (3 x N).          [m]
+     */
+    const Eigen::MatrixXd& getTabulatedPositions( ) const { return tabulatedPositions_; }
+
+    //! Get start epoch.
+    /*!
+     * Returns the first epoch of the grid.
+     * \return Start epoch in seconds since J2000.                                              [s]
+     */
+    double getStartEpoch( ) const { return startEpoch_; }
+
+    //! Get time step.
+    /*!
+     * Returns the time step of the grid.
+     * \return Time step.                                                                       [s]
+     */
+    double getTimeStep( ) const { return timeStep_; }
+
+private:
+
+    //! First epoch of grid in seconds since J2000.
+    const double startEpoch_;
+
+    //! Time step of grid.
+    const double timeStep_;
+
+    //! Tabulated geocentric positions, with one grid epoch per column.
+    Eigen::MatrixXd tabulatedPositions_;
+};
+
+} // namespace ephemerides
+} // namespace tudat
+
+#endif // TUDAT_CORE_APPROXIMATE_EPHEMERIDES_H
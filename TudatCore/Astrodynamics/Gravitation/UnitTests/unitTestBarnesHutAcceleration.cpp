@@ -0,0 +1,272 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "TudatCore/Astrodynamics/Gravitation/barnesHutAcceleration.h"
+#include "TudatCore/Astrodynamics/Gravitation/nBodyPointMassAcceleration.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_astrodynamics::physical_constants::GRAVITATIONAL_CONSTANT;
+
+//! Create clustered positions of bodies.
+/*!
+ * Creates pseudo-random positions of bodies in a number of clusters of different sizes, stored
+ * as a structure of arrays, such that the octree has leaves at many different levels.
+ * \param numberOfBodies Number of bodies.
+ * \return Vector of positions (3N entries).                                                   [m]
+ */
+Eigen::VectorXd createClusteredPositions( const int numberOfBodies )
+{
+    const int numberOfClusters = 5;
+    const Eigen::MatrixXd clusterCenters = Eigen::MatrixXd::Random( 3, numberOfClusters ) * 1.0e9;
+    const Eigen::MatrixXd offsets = Eigen::MatrixXd::Random( 3, numberOfBodies );
+
+    Eigen::VectorXd positions( 3 * numberOfBodies );
+    for ( int body = 0; body < numberOfBodies; body++ )
+    {
+        const int cluster = body % numberOfClusters;
+        const double clusterSize = 1.0e7 * std::pow( 4.0, cluster );
+        for ( int i = 0; i < 3; i++ )
+        {
+            positions( i * numberOfBodies + body ) = clusterCenters( i, cluster )
+                    + clusterSize * offsets( i, body ) * std::fabs( offsets( i, body ) );
+        }
+    }
+    return positions;
+}
+
+//! Compute root-mean-square relative acceleration error.
+/*!
+ * Computes the root-mean-square of the norms of the acceleration errors of the bodies, each
+ * relative to the norm of the expected acceleration.
+ * \param accelerations Computed accelerations (3N entries).                               [m/s^2]
+ * \param expectedAccelerations Expected accelerations (3N entries).                       [m/s^2]
+ * \return Root-mean-square relative error.                                                     [-]
+ */
+double computeRootMeanSquareRelativeError( const Eigen::VectorXd& accelerations,
+                                           const Eigen::VectorXd& expectedAccelerations )
+{
+    const int numberOfBodies = accelerations.size( ) / 3;
+    const Eigen::Map< const Eigen::MatrixXd > computed(
+                accelerations.data( ), numberOfBodies, 3 );
+    const Eigen::Map< const Eigen::MatrixXd > expected(
+                expectedAccelerations.data( ), numberOfBodies, 3 );
+    return std::sqrt( ( ( computed - expected ).rowwise( ).squaredNorm( ).array( )
+                        / expected.rowwise( ).squaredNorm( ).array( ) ).mean( ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_barnes_hut_acceleration )
+
+//! Test if octree is consistent and reproduces direct summation for a zero opening angle.
+BOOST_AUTO_TEST_CASE( testBarnesHutTreeAndDirectSummation )
+{
+    const int numberOfBodies = 3000;
+    const Eigen::VectorXd positions = createClusteredPositions( numberOfBodies );
+    const Eigen::VectorXd masses
+            = ( Eigen::ArrayXd::Random( numberOfBodies ) + 1.5 ).matrix( ) * 1.0e20;
+
+    Eigen::VectorXd expectedAccelerations;
+    gravitation::computeNBodyPointMassAccelerations(
+                positions, GRAVITATIONAL_CONSTANT * masses, expectedAccelerations );
+
+    gravitation::BarnesHutStateDerivative stateDerivative( masses, 0.0, 1, 4 );
+    Eigen::VectorXd accelerations;
+    stateDerivative.computeAccelerations( positions, accelerations );
+
+    for ( int i = 0; i < 3 * numberOfBodies; i++ )
+    {
+        BOOST_CHECK_SMALL( accelerations( i ) - expectedAccelerations( i ),
+                           1.0e-12 * expectedAccelerations.cwiseAbs( ).maxCoeff( ) );
+    }
+
+    // Check that the root node contains all bodies and mass, and that each leaf contains at most
+    // the leaf capacity, and that the leaves cover all bodies in order.
+    const std::vector< gravitation::BarnesHutTreeNode >& treeNodes
+            = stateDerivative.getTreeNodes( );
+    const int numberOfNodes = static_cast< int >( treeNodes.size( ) );
+    BOOST_CHECK_EQUAL( treeNodes[ 0 ].numberOfBodies, numberOfBodies );
+    BOOST_CHECK_EQUAL( treeNodes[ 0 ].nextNodeIndex, numberOfNodes );
+    BOOST_CHECK_CLOSE_FRACTION( treeNodes[ 0 ].gravitationalParameter,
+                                GRAVITATIONAL_CONSTANT * masses.sum( ), 1.0e-13 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    treeNodes[ 0 ].centerOfMass[ i ],
+                    masses.dot( positions.segment( i * numberOfBodies, numberOfBodies ) )
+                    / masses.sum( ), 1.0e-12 );
+    }
+
+    int numberOfBodiesInLeaves = 0;
+    for ( int k = 0; k < numberOfNodes; k++ )
+    {
+        BOOST_CHECK_GT( treeNodes[ k ].nextNodeIndex, k );
+        if ( treeNodes[ k ].isLeaf )
+        {
+            BOOST_CHECK_EQUAL( treeNodes[ k ].firstBodyIndex, numberOfBodiesInLeaves );
+            BOOST_CHECK_LE( treeNodes[ k ].numberOfBodies, 4 );
+            BOOST_CHECK_EQUAL( treeNodes[ k ].nextNodeIndex, k + 1 );
+            numberOfBodiesInLeaves += treeNodes[ k ].numberOfBodies;
+        }
+    }
+    BOOST_CHECK_EQUAL( numberOfBodiesInLeaves, numberOfBodies );
+}
+
+//! Test if accelerations converge with decreasing opening angle and do not depend on threads.
+BOOST_AUTO_TEST_CASE( testBarnesHutAccuracy )
+{
+    const int numberOfBodies = 5000;
+    const Eigen::VectorXd positions = createClusteredPositions( numberOfBodies );
+    const Eigen::VectorXd masses
+            = ( Eigen::ArrayXd::Random( numberOfBodies ) + 1.5 ).matrix( ) * 1.0e20;
+
+    Eigen::VectorXd expectedAccelerations;
+    gravitation::computeNBodyPointMassAccelerations(
+                positions, GRAVITATIONAL_CONSTANT * masses, expectedAccelerations );
+
+    const double openingAngles[ 3 ] = { 0.8, 0.5, 0.3 };
+    const double maximumErrors[ 3 ] = { 3.0e-2, 1.0e-2, 3.0e-3 };
+    double previousError = 1.0;
+    for ( int k = 0; k < 3; k++ )
+    {
+        gravitation::BarnesHutStateDerivative singleThreadStateDerivative(
+                    masses, openingAngles[ k ], 1 );
+        Eigen::VectorXd accelerations;
+        singleThreadStateDerivative.computeAccelerations( positions, accelerations );
+
+        const double error = computeRootMeanSquareRelativeError( accelerations,
+                                                                 expectedAccelerations );
+        BOOST_CHECK_LT( error, maximumErrors[ k ] );
+        BOOST_CHECK_LT( error, previousError );
+        previousError = error;
+
+        // Check that the accelerations are identical for multiple threads, and for repeated
+        // evaluations with reused tree storage.
+        gravitation::BarnesHutStateDerivative multipleThreadStateDerivative(
+                    masses, openingAngles[ k ], 4 );
+        Eigen::VectorXd multipleThreadAccelerations;
+        multipleThreadStateDerivative.computeAccelerations(
+                    createClusteredPositions( numberOfBodies / 2 ).head( 3 * numberOfBodies / 2 )
+                    .replicate( 2, 1 ), multipleThreadAccelerations );
+        multipleThreadStateDerivative.computeAccelerations( positions,
+                                                            multipleThreadAccelerations );
+        BOOST_CHECK( multipleThreadAccelerations == accelerations );
+    }
+}
+
+//! Test if Barnes-Hut state derivative reproduces direct summation when integrated.
+BOOST_AUTO_TEST_CASE( testBarnesHutStateDerivativeIntegration )
+{
+    // Set up a star, a planet and a moon.
+    Eigen::VectorXd masses( 3 );
+    masses << 2.0e30, 6.0e24, 7.0e22;
+
+    Eigen::MatrixXd cartesianStates = Eigen::MatrixXd::Zero( 6, 3 );
+    cartesianStates( 0, 1 ) = 1.5e11;
+    cartesianStates( 4, 1 ) = 3.0e4;
+    cartesianStates( 0, 2 ) = 1.5e11 + 3.8e8;
+    cartesianStates( 4, 2 ) = 3.1e4;
+    cartesianStates( 5, 2 ) = 1.0e2;
+    const Eigen::VectorXd initialState
+            = gravitation::convertCartesianStatesToNBodyState( cartesianStates );
+
+    // Integrate with the Barnes-Hut and direct state derivatives, and compare.
+    gravitation::BarnesHutStateDerivative barnesHutStateDerivative( masses, 0.5, 1 );
+    gravitation::NBodyPointMassStateDerivative directStateDerivative( masses, 1 );
+
+    numerical_integrators::RungeKutta4IntegratorXd barnesHutIntegrator(
+                boost::bind( &gravitation::BarnesHutStateDerivative::computeStateDerivative,
+                             &barnesHutStateDerivative, _1, _2 ), 0.0, initialState );
+    numerical_integrators::RungeKutta4IntegratorXd directIntegrator(
+                boost::bind( &gravitation::NBodyPointMassStateDerivative::computeStateDerivative,
+                             &directStateDerivative, _1, _2 ), 0.0, initialState );
+
+    const double finalTime = 30.0 * 86400.0;
+    const Eigen::MatrixXd barnesHutCartesianStates
+            = gravitation::convertNBodyStateToCartesianStates(
+                barnesHutIntegrator.integrateTo( finalTime, 600.0 ) );
+    const Eigen::MatrixXd directCartesianStates
+            = gravitation::convertNBodyStateToCartesianStates(
+                directIntegrator.integrateTo( finalTime, 600.0 ) );
+
+    // The planet and moon share a leaf, and the star is in a separate leaf, such that the
+    // accelerations of the planet and moon are exact. The star is attracted by the leaf of the
+    // planet and moon as a point mass, which slightly perturbs its motion.
+    for ( int body = 1; body < 3; body++ )
+    {
+        BOOST_CHECK_SMALL( ( barnesHutCartesianStates.col( body )
+                             - directCartesianStates.col( body ) ).head( 3 ).norm( ),
+                           1.0e-12 * directCartesianStates.col( body ).head( 3 ).norm( ) );
+    }
+    BOOST_CHECK_SMALL( ( barnesHutCartesianStates.col( 0 )
+                         - directCartesianStates.col( 0 ) ).head( 3 ).norm( ),
+                       1.0e-6 * directCartesianStates.col( 0 ).head( 3 ).norm( ) );
+    BOOST_CHECK_GT( directCartesianStates.col( 0 ).head( 3 ).norm( ), 1.0e4 );
+
+    // Check that a single body experiences no acceleration.
+    gravitation::BarnesHutStateDerivative singleBodyStateDerivative(
+                Eigen::VectorXd::Constant( 1, 1.0e20 ) );
+    Eigen::VectorXd singleBodyAccelerations;
+    singleBodyStateDerivative.computeAccelerations( Eigen::VectorXd::Constant( 3, 1.0e6 ),
+                                                    singleBodyAccelerations );
+    BOOST_CHECK( singleBodyAccelerations == Eigen::VectorXd::Zero( 3 ) );
+
+    // Check that errors are thrown for invalid settings and inconsistent sizes.
+    BOOST_CHECK_THROW( gravitation::BarnesHutStateDerivative( masses, -0.1 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( gravitation::BarnesHutStateDerivative( masses, 0.5, 1, 0 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( barnesHutStateDerivative.computeStateDerivative(
+                           0.0, Eigen::VectorXd::Zero( 12 ) ), std::runtime_error );
+    Eigen::VectorXd accelerations;
+    BOOST_CHECK_THROW( barnesHutStateDerivative.computeAccelerations(
+                           Eigen::VectorXd::Zero( 6 ), accelerations ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
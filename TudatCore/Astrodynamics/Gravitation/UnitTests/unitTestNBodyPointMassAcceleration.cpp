@@ -0,0 +1,233 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "TudatCore/Astrodynamics/Gravitation/nBodyPointMassAcceleration.h"
+#include "TudatCore/Astrodynamics/Propagators/universalVariablePropagator.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_astrodynamics::orbital_element_conversions::Vector6d;
+using tudat::basic_astrodynamics::physical_constants::GRAVITATIONAL_CONSTANT;
+using tudat::basic_mathematics::mathematical_constants::PI;
+
+//! Compute N-body point-mass accelerations by direct double loop.
+/*!
+ * Computes N-body point-mass accelerations by a direct double loop over all pairs of bodies,
+ * used as reference for the tiled computation.
+ * \param positions Matrix of positions, with one body per column (3 x N).                     [m]
+ * \param gravitationalParameters Vector of gravitational parameters (N entries).         [m^3/s^2]
+ * \return Matrix of accelerations, with one body per column (3 x N).                     [m/s^2]
+ */
+Eigen::MatrixXd computeReferenceNBodyAccelerations( const Eigen::MatrixXd& positions,
+                                                    const Eigen::VectorXd& gravitationalParameters )
+{
+    Eigen::MatrixXd accelerations = Eigen::MatrixXd::Zero( 3, positions.cols( ) );
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        for ( int j = 0; j < positions.cols( ); j++ )
+        {
+            if ( i != j )
+            {
+                const Eigen::Vector3d separation = positions.col( j ) - positions.col( i );
+                accelerations.col( i ) += gravitationalParameters( j ) * separation
+                        / std::pow( separation.norm( ), 3.0 );
+            }
+        }
+    }
+    return accelerations;
+}
+
+BOOST_AUTO_TEST_SUITE( test_n_body_point_mass_acceleration )
+
+//! Test if N-body state is converted correctly to and from Cartesian states.
+BOOST_AUTO_TEST_CASE( testNBodyStateConversion )
+{
+    const Eigen::MatrixXd cartesianStates = Eigen::MatrixXd::Random( 6, 5 );
+    const Eigen::VectorXd nBodyState
+            = gravitation::convertCartesianStatesToNBodyState( cartesianStates );
+
+    // Check the structure-of-arrays layout, and the conversion back to Cartesian states.
+    BOOST_CHECK_EQUAL( nBodyState.size( ), 30 );
+    for ( int body = 0; body < 5; body++ )
+    {
+        for ( int element = 0; element < 6; element++ )
+        {
+            BOOST_CHECK_EQUAL( nBodyState( element * 5 + body ),
+                               cartesianStates( element, body ) );
+        }
+    }
+    BOOST_CHECK( gravitation::convertNBodyStateToCartesianStates( nBodyState )
+                 == cartesianStates );
+
+    BOOST_CHECK_THROW( gravitation::convertCartesianStatesToNBodyState(
+                           Eigen::MatrixXd::Zero( 3, 5 ) ), std::runtime_error );
+    BOOST_CHECK_THROW( gravitation::convertNBodyStateToCartesianStates(
+                           Eigen::VectorXd::Zero( 7 ) ), std::runtime_error );
+}
+
+//! Test if N-body accelerations agree with direct summation, for any tiling and threading.
+BOOST_AUTO_TEST_CASE( testNBodyPointMassAccelerations )
+{
+    // Set random positions, spread over a few astronomical units, and random masses.
+    const int numberOfBodies = 300;
+    const Eigen::MatrixXd positions = Eigen::MatrixXd::Random( 3, numberOfBodies ) * 5.0e11;
+    const Eigen::VectorXd gravitationalParameters = GRAVITATIONAL_CONSTANT
+            * ( Eigen::ArrayXd::Random( numberOfBodies ) + 1.5 ).matrix( ) * 1.0e24;
+
+    const Eigen::MatrixXd expectedAccelerations
+            = computeReferenceNBodyAccelerations( positions, gravitationalParameters );
+
+    Eigen::VectorXd structureOfArraysPositions( 3 * numberOfBodies );
+    Eigen::Map< Eigen::MatrixXd >( structureOfArraysPositions.data( ), numberOfBodies, 3 )
+            = positions.transpose( );
+
+    const int blockSizes[ 5 ] = { 1, 7, 64, 256, 1000 };
+    const unsigned int numbersOfThreads[ 2 ] = { 1, 3 };
+    for ( int k = 0; k < 5; k++ )
+    {
+        for ( int l = 0; l < 2; l++ )
+        {
+            Eigen::VectorXd accelerations;
+            gravitation::computeNBodyPointMassAccelerations(
+                        structureOfArraysPositions, gravitationalParameters, accelerations,
+                        numbersOfThreads[ l ], blockSizes[ k ] );
+
+            BOOST_CHECK_EQUAL( accelerations.size( ), 3 * numberOfBodies );
+            for ( int i = 0; i < numberOfBodies; i++ )
+            {
+                const Eigen::Vector3d computedAcceleration(
+                            accelerations( i ), accelerations( numberOfBodies + i ),
+                            accelerations( 2 * numberOfBodies + i ) );
+                BOOST_CHECK_SMALL( ( computedAcceleration
+                                     - expectedAccelerations.col( i ) ).norm( ),
+                                   1.0e-12 * expectedAccelerations.col( i ).norm( ) );
+            }
+        }
+    }
+
+    // Check that the total momentum is conserved, i.e., that the mass-weighted sum of the
+    // accelerations vanishes.
+    Eigen::VectorXd accelerations;
+    gravitation::computeNBodyPointMassAccelerations(
+                structureOfArraysPositions, gravitationalParameters, accelerations );
+    for ( int component = 0; component < 3; component++ )
+    {
+        const Eigen::VectorXd componentAccelerations
+                = accelerations.segment( component * numberOfBodies, numberOfBodies );
+        BOOST_CHECK_SMALL( gravitationalParameters.dot( componentAccelerations ),
+                           1.0e-12 * ( gravitationalParameters.array( )
+                                       * componentAccelerations.array( ).abs( ) ).sum( ) );
+    }
+
+    // Check that errors are thrown for inconsistent sizes and invalid block sizes.
+    BOOST_CHECK_THROW( gravitation::computeNBodyPointMassAccelerations(
+                           structureOfArraysPositions.head( 30 ), gravitationalParameters,
+                           accelerations ), std::runtime_error );
+    BOOST_CHECK_THROW( gravitation::computeNBodyPointMassAccelerations(
+                           structureOfArraysPositions, gravitationalParameters,
+                           accelerations, 1, 0 ), std::runtime_error );
+}
+
+//! Test if N-body state derivative reproduces two-body motion when integrated.
+BOOST_AUTO_TEST_CASE( testNBodyPointMassStateDerivativeIntegration )
+{
+    // Set up a star and a planet, with the initial state of the planet relative to the star
+    // following from a Keplerian orbit with the sum of both gravitational parameters.
+    Eigen::VectorXd masses( 2 );
+    masses << 2.0e30, 6.0e27;
+    const double totalGravitationalParameter = GRAVITATIONAL_CONSTANT * masses.sum( );
+
+    Vector6d keplerianElements;
+    keplerianElements << 1.5e11, 0.3, 0.2, 0.5, 1.0, 0.1;
+    const Vector6d relativeState
+            = basic_astrodynamics::orbital_element_conversions::
+            convertKeplerianToCartesianElements( keplerianElements, totalGravitationalParameter );
+
+    // Place both bodies such that the barycenter is at rest in the origin.
+    Eigen::MatrixXd cartesianStates( 6, 2 );
+    cartesianStates.col( 0 ) = -masses( 1 ) / masses.sum( ) * relativeState;
+    cartesianStates.col( 1 ) = masses( 0 ) / masses.sum( ) * relativeState;
+
+    gravitation::NBodyPointMassStateDerivative stateDerivative( masses, 1 );
+    BOOST_CHECK_CLOSE_FRACTION( stateDerivative.getGravitationalParameters( ).sum( ),
+                                totalGravitationalParameter, 1.0e-15 );
+
+    // Propagate over half a revolution, and compare with the Keplerian relative motion.
+    const double finalTime = PI * std::sqrt( std::pow( keplerianElements( 0 ), 3.0 )
+                                             / totalGravitationalParameter );
+    numerical_integrators::RungeKutta4IntegratorXd integrator(
+                boost::bind( &gravitation::NBodyPointMassStateDerivative::computeStateDerivative,
+                             &stateDerivative, _1, _2 ), 0.0,
+                gravitation::convertCartesianStatesToNBodyState( cartesianStates ) );
+    const Eigen::MatrixXd finalCartesianStates
+            = gravitation::convertNBodyStateToCartesianStates(
+                integrator.integrateTo( finalTime, 3600.0 ) );
+
+    const Vector6d expectedRelativeState = propagators::propagateKeplerOrbitWithUniversalVariable(
+                relativeState, finalTime, totalGravitationalParameter );
+    const Vector6d computedRelativeState = finalCartesianStates.col( 1 )
+            - finalCartesianStates.col( 0 );
+
+    BOOST_CHECK_SMALL( ( computedRelativeState - expectedRelativeState ).head( 3 ).norm( ),
+                       1.0e-8 * keplerianElements( 0 ) );
+    BOOST_CHECK_SMALL( ( masses( 0 ) * finalCartesianStates.col( 0 )
+                         + masses( 1 ) * finalCartesianStates.col( 1 ) ).head( 3 ).norm( )
+                       / masses.sum( ), 1.0e-3 );
+
+    // Check that errors are thrown for an inconsistent state size and invalid block size.
+    BOOST_CHECK_THROW( stateDerivative.computeStateDerivative( 0.0, Eigen::VectorXd::Zero( 6 ) ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( gravitation::NBodyPointMassStateDerivative( masses, 1, 0 ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,386 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Lemoine, F.G., et al. The development of the joint NASA GSFC and the National Imagery and
+ *          Mapping Agency (NIMA) geopotential model EGM96, NASA/TP-1998-206861, 1998.
+ *      Montenbruck, O., Gill, E. Satellite Orbits, Springer, 2000.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/math/special_functions/factorials.hpp>
+#include <boost/math/special_functions/legendre.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/Gravitation/sphericalHarmonicGravityField.h"
+#include "TudatCore/InputOutput/basicInputOutput.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Gravitational parameter of the Earth, as used in EGM96.
+const double EARTH_GRAVITATIONAL_PARAMETER = 3.986004415e14;
+
+//! Reference radius of the Earth, as used in EGM96.
+const double EARTH_REFERENCE_RADIUS = 6378136.3;
+
+//! Compute gravitational potential by direct evaluation of spherical harmonic expansion.
+/*!
+ * Computes the gravitational potential by direct evaluation of the spherical harmonic expansion
+ * in spherical coordinates, with the Legendre functions of Boost and explicit normalization
+ * factors, used as reference for the recursive computation.
+ * \param position Position in body-fixed frame.                                              [m]
+ * \param gravitationalParameter Gravitational parameter of central body.                 [m^3/s^2]
+ * \param referenceRadius Reference radius of spherical harmonic expansion.                   [m]
+ * \param cosineCoefficients Fully normalized cosine coefficients.                             [-]
+ * \param sineCoefficients Fully normalized sine coefficients.                                 [-]
+ * \return Gravitational potential.                                                     [m^2/s^2]
+ */
+double computeReferencePotential( const Eigen::Vector3d& position,
+                                  const double gravitationalParameter,
+                                  const double referenceRadius,
+                                  const Eigen::MatrixXd& cosineCoefficients,
+                                  const Eigen::MatrixXd& sineCoefficients )
+{
+    const double radius = position.norm( );
+    const double sineOfLatitude = position.z( ) / radius;
+    const double longitude = std::atan2( position.y( ), position.x( ) );
+
+    double potential = 0.0;
+    for ( int degree = 0; degree < cosineCoefficients.rows( ); degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            // Normalization factor, and removal of the Condon-Shortley phase used by Boost.
+            const double normalizationFactor = std::sqrt(
+                        ( order == 0 ? 1.0 : 2.0 ) * ( 2.0 * degree + 1.0 )
+                        * boost::math::factorial< double >( degree - order )
+                        / boost::math::factorial< double >( degree + order ) )
+                    * ( order % 2 == 0 ? 1.0 : -1.0 );
+
+            potential += std::pow( referenceRadius / radius, degree ) * normalizationFactor
+                    * boost::math::legendre_p( degree, order, sineOfLatitude )
+                    * ( cosineCoefficients( degree, order ) * std::cos( order * longitude )
+                        + sineCoefficients( degree, order ) * std::sin( order * longitude ) );
+        }
+    }
+
+    return gravitationalParameter / radius * potential;
+}
+
+//! Create random spherical harmonic coefficients.
+/*!
+ * Creates random fully normalized coefficients with a magnitude decreasing with degree, and with
+ * a central term of one.
+ * \param maximumDegree Maximum degree of coefficients.
+ * \param cosineCoefficients Matrix in which the cosine coefficients are stored.
+ * \param sineCoefficients Matrix in which the sine coefficients are stored.
+ */
+void createRandomCoefficients( const int maximumDegree, Eigen::MatrixXd& cosineCoefficients,
+                               Eigen::MatrixXd& sineCoefficients )
+{
+    cosineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumDegree + 1 );
+    sineCoefficients = Eigen::MatrixXd::Random( maximumDegree + 1, maximumDegree + 1 );
+    for ( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        const double scaling = 1.0e-5 / ( degree * degree + 1.0 );
+        cosineCoefficients.row( degree ) *= scaling;
+        sineCoefficients.row( degree ) *= scaling;
+        sineCoefficients( degree, 0 ) = 0.0;
+    }
+    cosineCoefficients( 0, 0 ) = 1.0;
+}
+
+//! Compute accelerations by repeated single evaluations.
+/*!
+ * Computes the accelerations at a set of positions by repeated single evaluations of the
+ * gravity field, used to test the per-thread work buffers.
+ * \param gravityField Gravity field to evaluate.
+ * \param positions Matrix of positions, with one position per column.
+ * \param accelerations Matrix in which the accelerations are stored.
+ */
+void computeAccelerationsOneByOne( const gravitation::SphericalHarmonicGravityField* gravityField,
+                                   const Eigen::MatrixXd* positions,
+                                   Eigen::MatrixXd* accelerations )
+{
+    accelerations->resize( 3, positions->cols( ) );
+    for ( int i = 0; i < positions->cols( ); i++ )
+    {
+        accelerations->col( i ) = gravityField->computeAcceleration( positions->col( i ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_spherical_harmonic_gravity_field )
+
+//! Test if point-mass and J2 accelerations are reproduced.
+BOOST_AUTO_TEST_CASE( testPointMassAndJ2Accelerations )
+{
+    const double earthJ2 = 1.0826359e-3;
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( 3, 3 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    cosineCoefficients( 2, 0 ) = -earthJ2 / std::sqrt( 5.0 );
+    const Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( 3, 3 );
+
+    const gravitation::SphericalHarmonicGravityField pointMassField(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients, 0 );
+    const gravitation::SphericalHarmonicGravityField j2Field(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients );
+    BOOST_CHECK_EQUAL( pointMassField.getTruncationDegree( ), 0 );
+    BOOST_CHECK_EQUAL( j2Field.getTruncationDegree( ), 2 );
+
+    const Eigen::MatrixXd positions = Eigen::MatrixXd::Random( 3, 20 ) * 1.0e7;
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d position = positions.col( i );
+        const double radius = position.norm( );
+
+        const Eigen::Vector3d pointMassAcceleration
+                = -EARTH_GRAVITATIONAL_PARAMETER / std::pow( radius, 3.0 ) * position;
+
+        // J2 acceleration from (Montenbruck and Gill, 2000).
+        const double zSquaredRatio = 5.0 * position.z( ) * position.z( ) / ( radius * radius );
+        const Eigen::Vector3d j2Acceleration = -1.5 * earthJ2 * EARTH_GRAVITATIONAL_PARAMETER
+                * EARTH_REFERENCE_RADIUS * EARTH_REFERENCE_RADIUS / std::pow( radius, 5.0 )
+                * Eigen::Vector3d( position.x( ) * ( 1.0 - zSquaredRatio ),
+                                   position.y( ) * ( 1.0 - zSquaredRatio ),
+                                   position.z( ) * ( 3.0 - zSquaredRatio ) );
+
+        BOOST_CHECK_SMALL( ( pointMassField.computeAcceleration( position )
+                             - pointMassAcceleration ).norm( )
+                           / pointMassAcceleration.norm( ), 1.0e-15 );
+        BOOST_CHECK_SMALL( ( j2Field.computeAcceleration( position ) - pointMassAcceleration
+                             - j2Acceleration ).norm( ) / j2Acceleration.norm( ), 1.0e-12 );
+        BOOST_CHECK_CLOSE_FRACTION( pointMassField.computePotential( position ),
+                                    EARTH_GRAVITATIONAL_PARAMETER / radius, 1.0e-15 );
+    }
+}
+
+//! Test if potential agrees with direct evaluation of spherical harmonic expansion.
+BOOST_AUTO_TEST_CASE( testPotentialAgainstDirectEvaluation )
+{
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createRandomCoefficients( 16, cosineCoefficients, sineCoefficients );
+
+    // Omit the central term, to test the higher-degree terms at full precision.
+    cosineCoefficients( 0, 0 ) = 0.0;
+
+    const gravitation::SphericalHarmonicGravityField gravityField(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients );
+
+    const Eigen::MatrixXd positions = Eigen::MatrixXd::Random( 3, 20 ) * 1.0e7;
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    gravityField.computePotential( positions.col( i ) ),
+                    computeReferencePotential( positions.col( i ), EARTH_GRAVITATIONAL_PARAMETER,
+                                               EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                                               sineCoefficients ), 1.0e-12 );
+    }
+}
+
+//! Test if acceleration agrees with numerical gradient of potential, including at the poles.
+BOOST_AUTO_TEST_CASE( testAccelerationAgainstPotentialGradient )
+{
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createRandomCoefficients( 40, cosineCoefficients, sineCoefficients );
+
+    const gravitation::SphericalHarmonicGravityField gravityField(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients );
+
+    Eigen::MatrixXd positions = Eigen::MatrixXd::Random( 3, 22 ) * 1.0e7;
+    positions.col( 20 ) << 0.0, 0.0, 7.0e6;
+    positions.col( 21 ) << 1.0e-3, -2.0e-3, -7.0e6;
+
+    const double stepSize = 1.0;
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d acceleration = gravityField.computeAcceleration( positions.col( i ) );
+
+        Eigen::Vector3d numericalGradient;
+        for ( int component = 0; component < 3; component++ )
+        {
+            const Eigen::Vector3d step = stepSize * Eigen::Vector3d::Unit( component );
+            numericalGradient( component )
+                    = ( gravityField.computePotential( positions.col( i ) + step )
+                        - gravityField.computePotential( positions.col( i ) - step ) )
+                    / ( 2.0 * stepSize );
+        }
+
+        BOOST_CHECK( acceleration.allFinite( ) );
+        BOOST_CHECK_SMALL( ( acceleration - numericalGradient ).norm( ) / acceleration.norm( ),
+                           1.0e-8 );
+    }
+}
+
+//! Test if truncation degree limits the evaluated terms.
+BOOST_AUTO_TEST_CASE( testTruncationDegree )
+{
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createRandomCoefficients( 10, cosineCoefficients, sineCoefficients );
+
+    const gravitation::SphericalHarmonicGravityField truncatedField(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients, 4 );
+    const gravitation::SphericalHarmonicGravityField reducedField(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS,
+                cosineCoefficients.topLeftCorner( 5, 5 ), sineCoefficients.topLeftCorner( 5, 5 ) );
+    const gravitation::SphericalHarmonicGravityField fullField(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients );
+
+    const Eigen::Vector3d position( 4.0e6, -3.0e6, 5.0e6 );
+    BOOST_CHECK_EQUAL( truncatedField.computeAcceleration( position ),
+                       reducedField.computeAcceleration( position ) );
+    BOOST_CHECK_EQUAL( truncatedField.computePotential( position ),
+                       reducedField.computePotential( position ) );
+    BOOST_CHECK( truncatedField.computeAcceleration( position )
+                 != fullField.computeAcceleration( position ) );
+
+    BOOST_CHECK_THROW( gravitation::SphericalHarmonicGravityField(
+                           EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS,
+                           cosineCoefficients, sineCoefficients, 11 ), std::runtime_error );
+    BOOST_CHECK_THROW( gravitation::SphericalHarmonicGravityField(
+                           EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS,
+                           cosineCoefficients.topRows( 5 ), sineCoefficients.topRows( 5 ) ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( gravitation::SphericalHarmonicGravityField(
+                           EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS,
+                           cosineCoefficients, sineCoefficients.topLeftCorner( 5, 5 ) ),
+                       std::runtime_error );
+}
+
+//! Test if multi-position and concurrent evaluations agree with single evaluations.
+BOOST_AUTO_TEST_CASE( testMultiplePositionsAndThreads )
+{
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    createRandomCoefficients( 30, cosineCoefficients, sineCoefficients );
+
+    const gravitation::SphericalHarmonicGravityField gravityField(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients );
+
+    const Eigen::MatrixXd positions = Eigen::MatrixXd::Random( 3, 200 ) * 1.0e7;
+    Eigen::MatrixXd expectedAccelerations( 3, positions.cols( ) );
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        expectedAccelerations.col( i ) = gravityField.computeAcceleration( positions.col( i ) );
+    }
+
+    for ( unsigned int numberOfThreads = 1; numberOfThreads <= 3; numberOfThreads++ )
+    {
+        Eigen::MatrixXd accelerations;
+        gravityField.computeAccelerations( positions, accelerations, numberOfThreads );
+        BOOST_CHECK_EQUAL( accelerations, expectedAccelerations );
+    }
+
+    // Evaluate single positions from multiple threads, each with its own work buffers.
+    std::vector< Eigen::MatrixXd > threadAccelerations( 3 );
+    boost::thread_group threads;
+    for ( unsigned int i = 0; i < threadAccelerations.size( ); i++ )
+    {
+        threads.create_thread( boost::bind( &computeAccelerationsOneByOne, &gravityField,
+                                            &positions, &threadAccelerations[ i ] ) );
+    }
+    threads.join_all( );
+    for ( unsigned int i = 0; i < threadAccelerations.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( threadAccelerations[ i ], expectedAccelerations );
+    }
+
+    Eigen::MatrixXd accelerations;
+    BOOST_CHECK_THROW( gravityField.computeAccelerations( positions.topRows( 2 ), accelerations ),
+                       std::runtime_error );
+}
+
+//! Test if gravity field coefficients are read from file.
+BOOST_AUTO_TEST_CASE( testReadGravityFieldCoefficients )
+{
+    const std::string filePath = input_output::getCoreRootPath( )
+            + "/InputOutput/UnitTests/testSphericalHarmonicCoefficients.txt";
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    gravitation::readSphericalHarmonicGravityFieldCoefficients(
+                filePath, 6, cosineCoefficients, sineCoefficients );
+    BOOST_CHECK_EQUAL( cosineCoefficients.rows( ), 7 );
+    BOOST_CHECK_EQUAL( sineCoefficients.cols( ), 7 );
+    BOOST_CHECK_EQUAL( cosineCoefficients( 0, 0 ), 1.0 );
+    BOOST_CHECK_EQUAL( cosineCoefficients( 1, 0 ), 0.0 );
+    BOOST_CHECK_EQUAL( cosineCoefficients( 2, 0 ), -4.84165371736e-04 );
+    BOOST_CHECK_EQUAL( sineCoefficients( 2, 2 ), -1.40016683654e-06 );
+    BOOST_CHECK_EQUAL( cosineCoefficients( 4, 3 ), 9.90771803829e-07 );
+    BOOST_CHECK_EQUAL( sineCoefficients( 4, 4 ), 3.08853169333e-07 );
+    BOOST_CHECK_EQUAL( cosineCoefficients.bottomRows( 2 ).norm( ), 0.0 );
+
+    // The EGM96 acceleration at the surface is dominated by the point mass and J2 terms.
+    const gravitation::SphericalHarmonicGravityField gravityField(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients );
+    const gravitation::SphericalHarmonicGravityField j2Field(
+                EARTH_GRAVITATIONAL_PARAMETER, EARTH_REFERENCE_RADIUS, cosineCoefficients,
+                sineCoefficients, 2 );
+    const Eigen::Vector3d position( EARTH_REFERENCE_RADIUS, 0.0, 0.0 );
+    BOOST_CHECK_CLOSE_FRACTION( gravityField.computeAcceleration( position ).norm( ),
+                                j2Field.computeAcceleration( position ).norm( ), 1.0e-5 );
+    BOOST_CHECK_CLOSE_FRACTION( gravityField.computeAcceleration( position ).norm( ),
+                                9.814, 1.0e-3 );
+
+    // Read with truncation to degree two.
+    gravitation::readSphericalHarmonicGravityFieldCoefficients(
+                filePath, 2, cosineCoefficients, sineCoefficients );
+    BOOST_CHECK_EQUAL( cosineCoefficients.rows( ), 3 );
+    BOOST_CHECK_EQUAL( cosineCoefficients( 2, 2 ), 2.43914352398e-06 );
+
+    BOOST_CHECK_THROW( gravitation::readSphericalHarmonicGravityFieldCoefficients(
+                           filePath + ".missing", 2, cosineCoefficients, sineCoefficients ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( gravitation::readSphericalHarmonicGravityFieldCoefficients(
+                           input_output::getCoreRootPath( )
+                           + "/InputOutput/UnitTests/testMatrix.txt", 2,
+                           cosineCoefficients, sineCoefficients ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
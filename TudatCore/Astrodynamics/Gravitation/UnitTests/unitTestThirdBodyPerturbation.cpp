@@ -0,0 +1,229 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics, Revised
+ *          Edition, AIAA Education Series, 1999.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+//! Gravitational parameter of the Sun.
+const double sunGravitationalParameter = 1.32712440018e20;
+
+//! Gravitational parameter of the Moon.
+const double moonGravitationalParameter = 4.902800066e12;
+
+//! Compute third-body perturbing acceleration by direct difference in extended precision.
+/*!
+ * Computes the third-body perturbing acceleration as the difference of the accelerations of the
+ * third body on the orbiting and central bodies, in extended precision, used as reference.
+ * \param thirdBodyGravitationalParameter Gravitational parameter of third body.         [m^3/s^2]
+ * \param thirdBodyPosition Position of third body with respect to central body.               [m]
+ * \param position Position of orbiting body with respect to central body.                     [m]
+ * \return Perturbing acceleration.                                                        [m/s^2]
+ */
+Eigen::Vector3d computeReferenceThirdBodyPerturbingAcceleration(
+        const double thirdBodyGravitationalParameter, const Eigen::Vector3d& thirdBodyPosition,
+        const Eigen::Vector3d& position )
+{
+    typedef Eigen::Matrix< long double, 3, 1 > Vector3ld;
+    const Vector3ld thirdBodyPositionLd = thirdBodyPosition.cast< long double >( );
+    const Vector3ld separation = thirdBodyPositionLd - position.cast< long double >( );
+
+    const Vector3ld acceleration = static_cast< long double >( thirdBodyGravitationalParameter )
+            * ( separation / std::pow( separation.norm( ), 3.0L )
+                - thirdBodyPositionLd / std::pow( thirdBodyPositionLd.norm( ), 3.0L ) );
+    return acceleration.cast< double >( );
+}
+
+//! Get position of Sun with respect to Earth.
+/*!
+ * Returns a fixed position of the Sun with respect to the Earth, used as position function.
+ * \param time Time (unused).                                                                   [s]
+ * \return Position of Sun.                                                                     [m]
+ */
+Eigen::Vector3d getSunPosition( const double time )
+{
+    return Eigen::Vector3d( 1.2e11, -8.0e10, 3.5e10 );
+}
+
+//! Get position of Moon with respect to Earth.
+/*!
+ * Returns the position of the Moon with respect to the Earth on a circular orbit.
+ * \param time Time.                                                                            [s]
+ * \return Position of Moon.                                                                    [m]
+ */
+Eigen::Vector3d getMoonPosition( const double time )
+{
+    const double angle = 2.66e-6 * time;
+    return 3.844e8 * Eigen::Vector3d( std::cos( angle ), std::sin( angle ), 0.0 );
+}
+
+BOOST_AUTO_TEST_SUITE( test_third_body_perturbation )
+
+//! Test third-body perturbing acceleration against direct difference in extended precision.
+BOOST_AUTO_TEST_CASE( testThirdBodyPerturbingAcceleration )
+{
+    // Set positions of orbiting body, from low Earth orbit to beyond the Moon.
+    Eigen::MatrixXd positions( 3, 5 );
+    positions << 7.0e6, -4.2e6, 2.0e7, 4.0e8, -6.0e8,
+            1.0e3, 5.1e6, -3.5e7, 3.0e8, 1.0e8,
+            -2.0e5, 1.3e6, 4.0e6, -5.0e7, 9.0e7;
+
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d position = positions.col( i );
+
+        // Check perturbation by Sun and Moon.
+        const Eigen::Vector3d sunAcceleration
+                = gravitation::computeThirdBodyPerturbingAcceleration(
+                    sunGravitationalParameter, getSunPosition( 0.0 ), position );
+        const Eigen::Vector3d moonAcceleration
+                = gravitation::computeThirdBodyPerturbingAcceleration(
+                    moonGravitationalParameter, getMoonPosition( 1.0e5 ), position );
+
+        BOOST_CHECK_SMALL( ( sunAcceleration - computeReferenceThirdBodyPerturbingAcceleration(
+                                 sunGravitationalParameter, getSunPosition( 0.0 ), position ) )
+                           .norm( ) / sunAcceleration.norm( ), 1.0e-12 );
+        BOOST_CHECK_SMALL( ( moonAcceleration - computeReferenceThirdBodyPerturbingAcceleration(
+                                 moonGravitationalParameter, getMoonPosition( 1.0e5 ), position ) )
+                           .norm( ) / moonAcceleration.norm( ), 1.0e-12 );
+    }
+
+    // Check that perturbation vanishes at central body.
+    BOOST_CHECK_SMALL( gravitation::computeThirdBodyPerturbingAcceleration(
+                           sunGravitationalParameter, getSunPosition( 0.0 ),
+                           Eigen::Vector3d::Zero( ) ).norm( ), 1.0e-30 );
+}
+
+//! Test third-body perturbing accelerations at multiple epochs against single computations.
+BOOST_AUTO_TEST_CASE( testThirdBodyPerturbingAccelerations )
+{
+    const int numberOfEpochs = 50;
+
+    // Set positions of orbiting body and Moon.
+    Eigen::MatrixXd positions( 3, numberOfEpochs );
+    Eigen::MatrixXd moonPositions( 3, numberOfEpochs );
+    for ( int i = 0; i < numberOfEpochs; i++ )
+    {
+        const double angle = 0.7 * i;
+        positions.col( i ) = Eigen::Vector3d( 7.0e6 * std::cos( angle ),
+                                              6.0e6 * std::sin( angle ), 1.0e6 * i );
+        moonPositions.col( i ) = getMoonPosition( 3600.0 * i );
+    }
+
+    // Check perturbing accelerations, including with preallocated matrix.
+    Eigen::MatrixXd accelerations;
+    gravitation::computeThirdBodyPerturbingAccelerations(
+                moonGravitationalParameter, moonPositions, positions, accelerations );
+    BOOST_CHECK_EQUAL( accelerations.rows( ), 3 );
+    BOOST_CHECK_EQUAL( accelerations.cols( ), numberOfEpochs );
+
+    for ( int i = 0; i < numberOfEpochs; i++ )
+    {
+        const Eigen::Vector3d expectedAcceleration
+                = gravitation::computeThirdBodyPerturbingAcceleration(
+                    moonGravitationalParameter, moonPositions.col( i ), positions.col( i ) );
+        BOOST_CHECK_SMALL( ( accelerations.col( i ) - expectedAcceleration ).norm( )
+                           / expectedAcceleration.norm( ), 1.0e-14 );
+    }
+
+    // Check that mismatching position matrices throw.
+    BOOST_CHECK_THROW( gravitation::computeThirdBodyPerturbingAccelerations(
+                           moonGravitationalParameter, moonPositions.leftCols( 10 ), positions,
+                           accelerations ), std::runtime_error );
+    BOOST_CHECK_THROW( gravitation::computeThirdBodyPerturbingAccelerations(
+                           moonGravitationalParameter, moonPositions.topRows( 2 ),
+                           positions.topRows( 2 ), accelerations ), std::runtime_error );
+}
+
+//! Test third-body perturbation of multiple bodies.
+BOOST_AUTO_TEST_CASE( testThirdBodyPerturbation )
+{
+    std::vector< double > gravitationalParameters;
+    gravitationalParameters.push_back( sunGravitationalParameter );
+    gravitationalParameters.push_back( moonGravitationalParameter );
+
+    std::vector< gravitation::ThirdBodyPerturbation::PositionFunction > positionFunctions;
+    positionFunctions.push_back( &getSunPosition );
+    positionFunctions.push_back( &getMoonPosition );
+
+    const gravitation::ThirdBodyPerturbation thirdBodyPerturbation( gravitationalParameters,
+                                                                    positionFunctions );
+
+    // Bind perturbation to perturbing acceleration function, as used by the propagators.
+    const boost::function< Eigen::Vector3d( const double, const Vector6d& ) >
+            perturbingAccelerationFunction = boost::bind(
+                &gravitation::ThirdBodyPerturbation::computePerturbingAcceleration,
+                &thirdBodyPerturbation, _1, _2 );
+
+    Vector6d state;
+    state << 4.2e7, 1.0e5, -3.0e4, -7.0, 3.07e3, 1.0;
+    const double time = 2.5e5;
+
+    // Check that accelerations of both bodies are summed.
+    const Eigen::Vector3d expectedAcceleration
+            = gravitation::computeThirdBodyPerturbingAcceleration(
+                sunGravitationalParameter, getSunPosition( time ), state.head< 3 >( ) )
+            + gravitation::computeThirdBodyPerturbingAcceleration(
+                moonGravitationalParameter, getMoonPosition( time ), state.head< 3 >( ) );
+    BOOST_CHECK_SMALL( ( perturbingAccelerationFunction( time, state ) - expectedAcceleration )
+                       .norm( ) / expectedAcceleration.norm( ), 1.0e-15 );
+
+    // Check that mismatching numbers of gravitational parameters and functions throw.
+    positionFunctions.pop_back( );
+    BOOST_CHECK_THROW( gravitation::ThirdBodyPerturbation( gravitationalParameters,
+                                                           positionFunctions ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,918 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *      Warren, M.S., Salmon, J.K. A parallel hashed oct-tree N-body algorithm, Proceedings of
+ *          Supercomputing '93, 12-21, 1993.
+ *
+ *    Notes
+ *      The Morton code of a body interleaves the bits of its quantized x-, y- and z-coordinates
+ *      within the root cell, using 21 bits per coordinate, which limits the depth of the tree to
+ *      21 levels. The three bits of the code at a given level determine the child cell of the
+ *      body at that level.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/Gravitation/barnesHutAcceleration.h"
+#include "TudatCore/Basics/parallelLoop.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+namespace
+{
+
+//! Typedef for Morton code and index of body.
+typedef std::pair< boost::uint64_t, int > MortonCodeEntry;
+
+//! Maximum level of octree, limited by the number of bits per coordinate in the Morton codes.
+const int MAXIMUM_TREE_LEVEL = 21;
+
+//! Level of octree at which subtrees are built in parallel.
+const int PARALLEL_SUBTREE_LEVEL = 2;
+
+//! Minimum number of bodies per thread.
+const int MINIMUM_NUMBER_OF_BODIES_PER_THREAD = 1024;
+
+//! Spread bits of quantized coordinate.
+/*!
+ * Spreads the lowest 21 bits of a quantized coordinate, such that two zero bits are inserted
+ * between each pair of consecutive bits.
+ * \param value Quantized coordinate.
+ * \return Value with spread bits.
+ */
+boost::uint64_t spreadBits( boost::uint64_t value )
+{
+    value &= UINT64_C( 0x1fffff );
+    value = ( value | value << 32 ) & UINT64_C( 0x1f00000000ffff );
+    value = ( value | value << 16 ) & UINT64_C( 0x1f0000ff0000ff );
+    value = ( value | value << 8 ) & UINT64_C( 0x100f00f00f00f00f );
+    value = ( value | value << 4 ) & UINT64_C( 0x10c30c30c30c30c3 );
+    value = ( value | value << 2 ) & UINT64_C( 0x1249249249249249 );
+    return value;
+}
+
+//! Compare Morton code entry with Morton code.
+/*!
+ * Compares the Morton code of an entry with a Morton code, for use in binary searches.
+ * \param mortonCodeEntry Morton code entry.
+ * \param mortonCode Morton code.
+ * \return True if the code of the entry is smaller than the Morton code.
+ */
+bool isMortonCodeSmaller( const MortonCodeEntry& mortonCodeEntry,
+                          const boost::uint64_t mortonCode )
+{
+    return mortonCodeEntry.first < mortonCode;
+}
+
+//! Compute opening distance squared.
+/*!
+ * Computes the squared distance beyond which a node is approximated as a point mass.
+ * \param cellSize Edge length of cell of node.                                                [m]
+ * \param openingAngle Opening angle; if zero, the distance is infinite.                       [-]
+ * \return Squared opening distance.                                                         [m^2]
+ */
+double computeOpeningDistanceSquared( const double cellSize, const double openingAngle )
+{
+    if ( openingAngle > 0.0 )
+    {
+        return ( cellSize / openingAngle ) * ( cellSize / openingAngle );
+    }
+
+    return std::numeric_limits< double >::infinity( );
+}
+
+//! Compute aggregates of node from its children.
+/*!
+ * Computes the total gravitational parameter and center of mass of a node from those of its
+ * children, which directly follow the node in depth-first order and end at the end of the
+ * array. If the total gravitational parameter is zero, the center of mass of the first child is
+ * used.
+ * \param nodeIndex Index of node.
+ * \param nodes Nodes of tree, of which the node is updated.
+ */
+void computeNodeAggregatesFromChildren( const int nodeIndex,
+                                        std::vector< BarnesHutTreeNode >& nodes )
+{
+    const int endIndex_ = static_cast< int >( nodes.size( ) );
+
+    double gravitationalParameter_ = 0.0;
+    double weightedPosition_[ 3 ] = { 0.0, 0.0, 0.0 };
+    for ( int child = nodeIndex + 1; child < endIndex_; child = nodes[ child ].nextNodeIndex )
+    {
+        gravitationalParameter_ += nodes[ child ].gravitationalParameter;
+        for ( int i = 0; i < 3; i++ )
+        {
+            weightedPosition_[ i ] += nodes[ child ].gravitationalParameter
+                    * nodes[ child ].centerOfMass[ i ];
+        }
+    }
+
+    BarnesHutTreeNode& node_ = nodes[ nodeIndex ];
+    node_.gravitationalParameter = gravitationalParameter_;
+    for ( int i = 0; i < 3; i++ )
+    {
+        node_.centerOfMass[ i ] = ( gravitationalParameter_ > 0.0 )
+                ? weightedPosition_[ i ] / gravitationalParameter_
+                : nodes[ nodeIndex + 1 ].centerOfMass[ i ];
+    }
+}
+
+//! Loop body for computation of Morton codes.
+/*!
+ * Loop body for parallel computation of the Morton codes of the bodies, used with
+ * basics::executeParallelLoop().
+ */
+class MortonCodeComputation
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param positions Pointer to positions (3N entries).
+     * \param numberOfBodies Number of bodies.
+     * \param rootCellCorner Corner of root cell with minimum coordinates.
+     * \param rootCellSize Edge length of root cell.
+     * \param mortonCodes Morton code entries, which are computed.
+     */
+    MortonCodeComputation( const double* positions, const int numberOfBodies,
+                           const Eigen::Vector3d& rootCellCorner, const double rootCellSize,
+                           std::vector< MortonCodeEntry >& mortonCodes )
+        : positions_( positions ),
+          numberOfBodies_( numberOfBodies ),
+          rootCellCorner_( rootCellCorner ),
+          rootCellSize_( rootCellSize ),
+          mortonCodes_( mortonCodes )
+    { }
+
+    //! Compute Morton codes of range of bodies.
+    /*!
+     * Computes the Morton codes of the bodies in the range [ startIndex, endIndex ).
+     * \param startIndex Index of first body.
+     * \param endIndex Index one past the last body.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        const double numberOfCells_ = static_cast< double >( 1 << MAXIMUM_TREE_LEVEL );
+
+        for ( int body = startIndex; body < endIndex; body++ )
+        {
+            boost::uint64_t mortonCode_ = 0;
+            for ( int i = 0; i < 3; i++ )
+            {
+                const double scaledCoordinate_ = std::min(
+                            std::max( ( positions_[ i * numberOfBodies_ + body ]
+                                        - rootCellCorner_( i ) ) / rootCellSize_
+                                      * numberOfCells_, 0.0 ), numberOfCells_ - 1.0 );
+                mortonCode_ |= spreadBits( static_cast< boost::uint64_t >( scaledCoordinate_ ) )
+                        << ( 2 - i );
+            }
+            mortonCodes_[ body ] = std::make_pair( mortonCode_, body );
+        }
+    }
+
+private:
+
+    //! Pointer to positions.
+    const double* positions_;
+
+    //! Number of bodies.
+    const int numberOfBodies_;
+
+    //! Corner of root cell with minimum coordinates.
+    const Eigen::Vector3d rootCellCorner_;
+
+    //! Edge length of root cell.
+    const double rootCellSize_;
+
+    //! Morton code entries.
+    std::vector< MortonCodeEntry >& mortonCodes_;
+};
+
+//! Loop body for sorting and merging chunks of Morton code entries.
+/*!
+ * Loop body for parallel sorting of Morton code entries, used with basics::executeParallelLoop().
+ * If the merge width is zero, each iteration sorts one chunk; otherwise, each iteration merges
+ * two consecutive, sorted groups of the given number of chunks.
+ */
+class MortonCodeSorting
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param chunkBoundaries Indices of the boundaries of the chunks, including the end.
+     * \param mergeWidth Number of chunks per group to merge, or zero to sort the chunks.
+     * \param mortonCodes Morton code entries, which are sorted.
+     */
+    MortonCodeSorting( const std::vector< int >& chunkBoundaries, const int mergeWidth,
+                       std::vector< MortonCodeEntry >& mortonCodes )
+        : chunkBoundaries_( chunkBoundaries ),
+          mergeWidth_( mergeWidth ),
+          mortonCodes_( mortonCodes )
+    { }
+
+    //! Sort or merge range of chunks.
+    /*!
+     * Sorts the chunks, or merges the pairs of groups of chunks, in the range
+     * [ startIndex, endIndex ).
+     * \param startIndex Index of first chunk or pair of groups.
+     * \param endIndex Index one past the last chunk or pair of groups.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        const int numberOfChunks_ = static_cast< int >( chunkBoundaries_.size( ) ) - 1;
+
+        for ( int i = startIndex; i < endIndex; i++ )
+        {
+            if ( mergeWidth_ == 0 )
+            {
+                std::sort( mortonCodes_.begin( ) + chunkBoundaries_[ i ],
+                           mortonCodes_.begin( ) + chunkBoundaries_[ i + 1 ] );
+            }
+            else
+            {
+                const int firstChunk_ = 2 * i * mergeWidth_;
+                const int middleChunk_ = std::min( firstChunk_ + mergeWidth_, numberOfChunks_ );
+                const int endChunk_ = std::min( firstChunk_ + 2 * mergeWidth_, numberOfChunks_ );
+                std::inplace_merge( mortonCodes_.begin( ) + chunkBoundaries_[ firstChunk_ ],
+                                    mortonCodes_.begin( ) + chunkBoundaries_[ middleChunk_ ],
+                                    mortonCodes_.begin( ) + chunkBoundaries_[ endChunk_ ] );
+            }
+        }
+    }
+
+private:
+
+    //! Indices of the boundaries of the chunks, including the end.
+    const std::vector< int >& chunkBoundaries_;
+
+    //! Number of chunks per group to merge, or zero to sort the chunks.
+    const int mergeWidth_;
+
+    //! Morton code entries.
+    std::vector< MortonCodeEntry >& mortonCodes_;
+};
+
+//! Loop body for gathering of bodies in sorted order.
+/*!
+ * Loop body for parallel copying of the positions and gravitational parameters of the bodies to
+ * arrays in the order of their Morton codes, used with basics::executeParallelLoop().
+ */
+class SortedBodyGathering
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param positions Pointer to positions (3N entries).
+     * \param gravitationalParameters Gravitational parameters (N entries).
+     * \param sortedMortonCodes Morton code entries, sorted by Morton code.
+     * \param sortedPositions Positions in sorted order (3N entries), which are set.
+     * \param sortedGravitationalParameters Gravitational parameters in sorted order (N entries),
+     *          which are set.
+     */
+    SortedBodyGathering( const double* positions, const Eigen::VectorXd& gravitationalParameters,
+                         const std::vector< MortonCodeEntry >& sortedMortonCodes,
+                         Eigen::VectorXd& sortedPositions,
+                         Eigen::VectorXd& sortedGravitationalParameters )
+        : positions_( positions ),
+          gravitationalParameters_( gravitationalParameters ),
+          sortedMortonCodes_( sortedMortonCodes ),
+          sortedPositions_( sortedPositions ),
+          sortedGravitationalParameters_( sortedGravitationalParameters )
+    { }
+
+    //! Gather range of sorted bodies.
+    /*!
+     * Copies the bodies with sorted indices in the range [ startIndex, endIndex ).
+     * \param startIndex Sorted index of first body.
+     * \param endIndex Sorted index one past the last body.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        const int numberOfBodies_ = static_cast< int >( gravitationalParameters_.size( ) );
+
+        for ( int i = startIndex; i < endIndex; i++ )
+        {
+            const int body_ = sortedMortonCodes_[ i ].second;
+            for ( int j = 0; j < 3; j++ )
+            {
+                sortedPositions_( j * numberOfBodies_ + i )
+                        = positions_[ j * numberOfBodies_ + body_ ];
+            }
+            sortedGravitationalParameters_( i ) = gravitationalParameters_( body_ );
+        }
+    }
+
+private:
+
+    //! Pointer to positions.
+    const double* positions_;
+
+    //! Gravitational parameters.
+    const Eigen::VectorXd& gravitationalParameters_;
+
+    //! Morton code entries, sorted by Morton code.
+    const std::vector< MortonCodeEntry >& sortedMortonCodes_;
+
+    //! Positions in sorted order.
+    Eigen::VectorXd& sortedPositions_;
+
+    //! Gravitational parameters in sorted order.
+    Eigen::VectorXd& sortedGravitationalParameters_;
+};
+
+//! Loop body for construction of subtrees of octree.
+/*!
+ * Loop body for parallel construction of the subtrees of the octree below the top levels, used
+ * with basics::executeParallelLoop(). Each subtree is built in its own array of nodes, in
+ * depth-first order, with node indices relative to the start of that array.
+ */
+class SubtreeConstruction
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param sortedMortonCodes Morton code entries, sorted by Morton code.
+     * \param sortedPositions Positions in sorted order (3N entries).
+     * \param sortedGravitationalParameters Gravitational parameters in sorted order (N entries).
+     * \param subtreeBoundaries Sorted indices of the boundaries of the subtrees, including the
+     *          end.
+     * \param subtreeCellSize Edge length of the cells of the subtree roots.
+     * \param openingAngle Opening angle.
+     * \param leafCapacity Maximum number of bodies in a leaf node.
+     * \param subtreeNodes Arrays of nodes of the subtrees, which are built.
+     */
+    SubtreeConstruction( const std::vector< MortonCodeEntry >& sortedMortonCodes,
+                         const Eigen::VectorXd& sortedPositions,
+                         const Eigen::VectorXd& sortedGravitationalParameters,
+                         const std::vector< int >& subtreeBoundaries,
+                         const double subtreeCellSize, const double openingAngle,
+                         const int leafCapacity,
+                         std::vector< std::vector< BarnesHutTreeNode > >& subtreeNodes )
+        : sortedMortonCodes_( sortedMortonCodes ),
+          sortedPositions_( sortedPositions ),
+          sortedGravitationalParameters_( sortedGravitationalParameters ),
+          subtreeBoundaries_( subtreeBoundaries ),
+          subtreeCellSize_( subtreeCellSize ),
+          openingAngle_( openingAngle ),
+          leafCapacity_( leafCapacity ),
+          subtreeNodes_( subtreeNodes )
+    { }
+
+    //! Build range of subtrees.
+    /*!
+     * Builds the subtrees in the range [ startIndex, endIndex ).
+     * \param startIndex Index of first subtree.
+     * \param endIndex Index one past the last subtree.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        for ( int i = startIndex; i < endIndex; i++ )
+        {
+            subtreeNodes_[ i ].clear( );
+            buildNode( subtreeBoundaries_[ i ], subtreeBoundaries_[ i + 1 ],
+                       PARALLEL_SUBTREE_LEVEL, subtreeCellSize_, subtreeNodes_[ i ] );
+        }
+    }
+
+private:
+
+    //! Build node and its subtree.
+    /*!
+     * Builds the node containing the given range of sorted bodies, followed by its subtree in
+     * depth-first order. The node is a leaf if it contains at most the leaf capacity, or if the
+     * maximum level is reached.
+     * \param startIndex Sorted index of first body in node.
+     * \param endIndex Sorted index one past the last body in node.
+     * \param level Level of node in octree.
+     * \param cellSize Edge length of cell of node.
+     * \param nodes Array of nodes, to which the node and its subtree are appended.
+     */
+    void buildNode( const int startIndex, const int endIndex, const int level,
+                    const double cellSize, std::vector< BarnesHutTreeNode >& nodes ) const
+    {
+        const int nodeIndex_ = static_cast< int >( nodes.size( ) );
+        nodes.push_back( BarnesHutTreeNode( ) );
+
+        const bool isLeaf_ = ( endIndex - startIndex <= leafCapacity_ )
+                || ( level >= MAXIMUM_TREE_LEVEL );
+        if ( isLeaf_ )
+        {
+            computeLeafAggregates( startIndex, endIndex, nodes[ nodeIndex_ ] );
+        }
+        else
+        {
+            // Divide bodies over child cells, using the three bits of the Morton codes at the
+            // level of the children.
+            const int shift_ = 3 * ( MAXIMUM_TREE_LEVEL - 1 - level );
+            int childStartIndex_ = startIndex;
+            while ( childStartIndex_ < endIndex )
+            {
+                const boost::uint64_t childPrefix_
+                        = sortedMortonCodes_[ childStartIndex_ ].first >> shift_;
+                const int childEndIndex_ = static_cast< int >(
+                            std::lower_bound( sortedMortonCodes_.begin( ) + childStartIndex_,
+                                              sortedMortonCodes_.begin( ) + endIndex,
+                                              ( childPrefix_ + 1 ) << shift_,
+                                              &isMortonCodeSmaller )
+                            - sortedMortonCodes_.begin( ) );
+
+                buildNode( childStartIndex_, childEndIndex_, level + 1, 0.5 * cellSize, nodes );
+                childStartIndex_ = childEndIndex_;
+            }
+
+            computeNodeAggregatesFromChildren( nodeIndex_, nodes );
+        }
+
+        BarnesHutTreeNode& node_ = nodes[ nodeIndex_ ];
+        node_.openingDistanceSquared = computeOpeningDistanceSquared( cellSize, openingAngle_ );
+        node_.firstBodyIndex = startIndex;
+        node_.numberOfBodies = endIndex - startIndex;
+        node_.nextNodeIndex = static_cast< int >( nodes.size( ) );
+        node_.isLeaf = isLeaf_;
+    }
+
+    //! Compute aggregates of leaf node.
+    /*!
+     * Computes the total gravitational parameter and center of mass of a leaf node from its
+     * bodies. If the total gravitational parameter is zero, the mean position is used.
+     * \param startIndex Sorted index of first body in node.
+     * \param endIndex Sorted index one past the last body in node.
+     * \param node Leaf node, which is updated.
+     */
+    void computeLeafAggregates( const int startIndex, const int endIndex,
+                                BarnesHutTreeNode& node ) const
+    {
+        const int numberOfBodies_ = static_cast< int >( sortedGravitationalParameters_.size( ) );
+
+        double gravitationalParameter_ = 0.0;
+        double weightedPosition_[ 3 ] = { 0.0, 0.0, 0.0 };
+        double summedPosition_[ 3 ] = { 0.0, 0.0, 0.0 };
+        for ( int body = startIndex; body < endIndex; body++ )
+        {
+            gravitationalParameter_ += sortedGravitationalParameters_( body );
+            for ( int i = 0; i < 3; i++ )
+            {
+                weightedPosition_[ i ] += sortedGravitationalParameters_( body )
+                        * sortedPositions_( i * numberOfBodies_ + body );
+                summedPosition_[ i ] += sortedPositions_( i * numberOfBodies_ + body );
+            }
+        }
+
+        node.gravitationalParameter = gravitationalParameter_;
+        for ( int i = 0; i < 3; i++ )
+        {
+            node.centerOfMass[ i ] = ( gravitationalParameter_ > 0.0 )
+                    ? weightedPosition_[ i ] / gravitationalParameter_
+                    : summedPosition_[ i ] / static_cast< double >( endIndex - startIndex );
+        }
+    }
+
+    //! Morton code entries, sorted by Morton code.
+    const std::vector< MortonCodeEntry >& sortedMortonCodes_;
+
+    //! Positions in sorted order.
+    const Eigen::VectorXd& sortedPositions_;
+
+    //! Gravitational parameters in sorted order.
+    const Eigen::VectorXd& sortedGravitationalParameters_;
+
+    //! Sorted indices of the boundaries of the subtrees, including the end.
+    const std::vector< int >& subtreeBoundaries_;
+
+    //! Edge length of the cells of the subtree roots.
+    const double subtreeCellSize_;
+
+    //! Opening angle.
+    const double openingAngle_;
+
+    //! Maximum number of bodies in a leaf node.
+    const int leafCapacity_;
+
+    //! Arrays of nodes of the subtrees.
+    std::vector< std::vector< BarnesHutTreeNode > >& subtreeNodes_;
+};
+
+//! Assemble top levels of octree.
+/*!
+ * Appends the node at one of the top levels of the octree, containing the given range of
+ * subtrees, to the tree in depth-first order, followed by its children. At the level of the
+ * subtrees, the prebuilt subtree is copied, with its node indices offset to the position in the
+ * tree.
+ * \param subtreePrefixes Morton code prefixes of the subtrees, i.e., the bits of the Morton codes
+ *          that determine the cells at the level of the subtrees.
+ * \param subtreeBoundaries Sorted indices of the boundaries of the subtrees, including the end.
+ * \param startSubtree Index of first subtree in node.
+ * \param endSubtree Index one past the last subtree in node.
+ * \param level Level of node in octree.
+ * \param cellSize Edge length of cell of node.
+ * \param openingAngle Opening angle.
+ * \param subtreeNodes Arrays of nodes of the subtrees.
+ * \param treeNodes Nodes of octree, to which the node and its children are appended.
+ */
+void assembleTopLevelNode( const std::vector< boost::uint64_t >& subtreePrefixes,
+                           const std::vector< int >& subtreeBoundaries, const int startSubtree,
+                           const int endSubtree, const int level, const double cellSize,
+                           const double openingAngle,
+                           const std::vector< std::vector< BarnesHutTreeNode > >& subtreeNodes,
+                           std::vector< BarnesHutTreeNode >& treeNodes )
+{
+    const int nodeIndex_ = static_cast< int >( treeNodes.size( ) );
+
+    if ( level == PARALLEL_SUBTREE_LEVEL )
+    {
+        for ( unsigned int i = 0; i < subtreeNodes[ startSubtree ].size( ); i++ )
+        {
+            treeNodes.push_back( subtreeNodes[ startSubtree ][ i ] );
+            treeNodes.back( ).nextNodeIndex += nodeIndex_;
+        }
+        return;
+    }
+
+    treeNodes.push_back( BarnesHutTreeNode( ) );
+
+    // Group subtrees by their child cell at the next level.
+    const int shift_ = 3 * ( PARALLEL_SUBTREE_LEVEL - 1 - level );
+    int childStartSubtree_ = startSubtree;
+    while ( childStartSubtree_ < endSubtree )
+    {
+        const boost::uint64_t childDigit_ = ( subtreePrefixes[ childStartSubtree_ ] >> shift_ ) & 7;
+        int childEndSubtree_ = childStartSubtree_ + 1;
+        while ( childEndSubtree_ < endSubtree
+                && ( ( subtreePrefixes[ childEndSubtree_ ] >> shift_ ) & 7 ) == childDigit_ )
+        {
+            childEndSubtree_++;
+        }
+
+        assembleTopLevelNode( subtreePrefixes, subtreeBoundaries, childStartSubtree_,
+                              childEndSubtree_, level + 1, 0.5 * cellSize, openingAngle,
+                              subtreeNodes, treeNodes );
+        childStartSubtree_ = childEndSubtree_;
+    }
+
+    computeNodeAggregatesFromChildren( nodeIndex_, treeNodes );
+
+    BarnesHutTreeNode& node_ = treeNodes[ nodeIndex_ ];
+    node_.openingDistanceSquared = computeOpeningDistanceSquared( cellSize, openingAngle );
+    node_.firstBodyIndex = subtreeBoundaries[ startSubtree ];
+    node_.numberOfBodies = subtreeBoundaries[ endSubtree ] - subtreeBoundaries[ startSubtree ];
+    node_.nextNodeIndex = static_cast< int >( treeNodes.size( ) );
+    node_.isLeaf = false;
+}
+
+//! Loop body for traversal of octree.
+/*!
+ * Loop body for parallel computation of the accelerations of the bodies by traversal of the
+ * octree, used with basics::executeParallelLoop(). The bodies are processed in sorted order, such
+ * that consecutive bodies traverse nearly the same nodes.
+ */
+class OctreeTraversal
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param treeNodes Nodes of octree, in depth-first order.
+     * \param sortedMortonCodes Morton code entries, sorted by Morton code.
+     * \param sortedPositions Positions in sorted order (3N entries).
+     * \param sortedGravitationalParameters Gravitational parameters in sorted order (N entries).
+     * \param accelerations Pointer to accelerations (3N entries), in the original order of the
+     *          bodies, which are computed.
+     */
+    OctreeTraversal( const std::vector< BarnesHutTreeNode >& treeNodes,
+                     const std::vector< MortonCodeEntry >& sortedMortonCodes,
+                     const Eigen::VectorXd& sortedPositions,
+                     const Eigen::VectorXd& sortedGravitationalParameters,
+                     double* accelerations )
+        : treeNodes_( treeNodes ),
+          sortedMortonCodes_( sortedMortonCodes ),
+          sortedPositions_( sortedPositions ),
+          sortedGravitationalParameters_( sortedGravitationalParameters ),
+          accelerations_( accelerations )
+    { }
+
+    //! Compute accelerations of range of sorted bodies.
+    /*!
+     * Computes the accelerations of the bodies with sorted indices in the range
+     * [ startIndex, endIndex ).
+     * \param startIndex Sorted index of first body.
+     * \param endIndex Sorted index one past the last body.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        const int numberOfBodies_ = static_cast< int >( sortedGravitationalParameters_.size( ) );
+        const int numberOfNodes_ = static_cast< int >( treeNodes_.size( ) );
+        const double* positionsX_ = sortedPositions_.data( );
+        const double* positionsY_ = positionsX_ + numberOfBodies_;
+        const double* positionsZ_ = positionsY_ + numberOfBodies_;
+
+        for ( int target = startIndex; target < endIndex; target++ )
+        {
+            const double targetX_ = positionsX_[ target ];
+            const double targetY_ = positionsY_[ target ];
+            const double targetZ_ = positionsZ_[ target ];
+            double accelerationX_ = 0.0;
+            double accelerationY_ = 0.0;
+            double accelerationZ_ = 0.0;
+
+            int nodeIndex_ = 0;
+            while ( nodeIndex_ < numberOfNodes_ )
+            {
+                const BarnesHutTreeNode& node_ = treeNodes_[ nodeIndex_ ];
+                const bool containsTarget_ = ( target >= node_.firstBodyIndex )
+                        && ( target < node_.firstBodyIndex + node_.numberOfBodies );
+
+                const double separationX_ = node_.centerOfMass[ 0 ] - targetX_;
+                const double separationY_ = node_.centerOfMass[ 1 ] - targetY_;
+                const double separationZ_ = node_.centerOfMass[ 2 ] - targetZ_;
+                const double distanceSquared_ = separationX_ * separationX_
+                        + separationY_ * separationY_ + separationZ_ * separationZ_;
+
+                if ( !containsTarget_ && distanceSquared_ > node_.openingDistanceSquared )
+                {
+                    // Approximate node as point mass at its center of mass, and skip subtree.
+                    const double weight_ = node_.gravitationalParameter
+                            / ( distanceSquared_ * std::sqrt( distanceSquared_ ) );
+                    accelerationX_ += weight_ * separationX_;
+                    accelerationY_ += weight_ * separationY_;
+                    accelerationZ_ += weight_ * separationZ_;
+                    nodeIndex_ = node_.nextNodeIndex;
+                }
+                else if ( node_.isLeaf )
+                {
+                    // Sum contributions of bodies in leaf directly.
+                    const int leafEndIndex_ = node_.firstBodyIndex + node_.numberOfBodies;
+                    for ( int source = node_.firstBodyIndex; source < leafEndIndex_; source++ )
+                    {
+                        if ( source != target )
+                        {
+                            const double bodySeparationX_ = positionsX_[ source ] - targetX_;
+                            const double bodySeparationY_ = positionsY_[ source ] - targetY_;
+                            const double bodySeparationZ_ = positionsZ_[ source ] - targetZ_;
+                            const double bodyDistanceSquared_
+                                    = bodySeparationX_ * bodySeparationX_
+                                    + bodySeparationY_ * bodySeparationY_
+                                    + bodySeparationZ_ * bodySeparationZ_;
+                            const double weight_ = sortedGravitationalParameters_( source )
+                                    / ( bodyDistanceSquared_
+                                        * std::sqrt( bodyDistanceSquared_ ) );
+                            accelerationX_ += weight_ * bodySeparationX_;
+                            accelerationY_ += weight_ * bodySeparationY_;
+                            accelerationZ_ += weight_ * bodySeparationZ_;
+                        }
+                    }
+                    nodeIndex_ = node_.nextNodeIndex;
+                }
+                else
+                {
+                    // Open node, i.e., continue with its first child.
+                    nodeIndex_++;
+                }
+            }
+
+            const int body_ = sortedMortonCodes_[ target ].second;
+            accelerations_[ body_ ] = accelerationX_;
+            accelerations_[ numberOfBodies_ + body_ ] = accelerationY_;
+            accelerations_[ 2 * numberOfBodies_ + body_ ] = accelerationZ_;
+        }
+    }
+
+private:
+
+    //! Nodes of octree, in depth-first order.
+    const std::vector< BarnesHutTreeNode >& treeNodes_;
+
+    //! Morton code entries, sorted by Morton code.
+    const std::vector< MortonCodeEntry >& sortedMortonCodes_;
+
+    //! Positions in sorted order.
+    const Eigen::VectorXd& sortedPositions_;
+
+    //! Gravitational parameters in sorted order.
+    const Eigen::VectorXd& sortedGravitationalParameters_;
+
+    //! Pointer to accelerations.
+    double* accelerations_;
+};
+
+} // namespace
+
+//! Default constructor.
+BarnesHutStateDerivative::BarnesHutStateDerivative( const Eigen::VectorXd& masses,
+                                                    const double openingAngle,
+                                                    const unsigned int numberOfThreads,
+                                                    const int leafCapacity,
+                                                    const double gravitationalConstant )
+    : gravitationalParameters_( gravitationalConstant * masses ),
+      openingAngle_( openingAngle ),
+      numberOfThreads_( numberOfThreads ),
+      leafCapacity_( leafCapacity )
+{
+    if ( !( openingAngle >= 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Opening angle must be non-negative." ) ) );
+    }
+
+    if ( leafCapacity < 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Leaf capacity must be positive." ) ) );
+    }
+}
+
+//! Compute state derivative.
+Eigen::VectorXd BarnesHutStateDerivative::computeStateDerivative(
+        const double time, const Eigen::VectorXd& nBodyState )
+{
+    const int numberOfBodies_ = static_cast< int >( gravitationalParameters_.size( ) );
+    if ( nBodyState.size( ) != 6 * numberOfBodies_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Size of N-body state does not match number of "
+                                            "bodies." ) ) );
+    }
+
+    // The derivatives of the positions are the velocities, and the accelerations are written
+    // directly into the second half of the state derivative.
+    Eigen::VectorXd stateDerivative_( 6 * numberOfBodies_ );
+    stateDerivative_.head( 3 * numberOfBodies_ ) = nBodyState.tail( 3 * numberOfBodies_ );
+    buildTreeAndComputeAccelerations( nBodyState.data( ),
+                                      stateDerivative_.data( ) + 3 * numberOfBodies_ );
+    return stateDerivative_;
+}
+
+//! Compute accelerations.
+void BarnesHutStateDerivative::computeAccelerations( const Eigen::VectorXd& positions,
+                                                     Eigen::VectorXd& accelerations )
+{
+    const int numberOfBodies_ = static_cast< int >( gravitationalParameters_.size( ) );
+    if ( positions.size( ) != 3 * numberOfBodies_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Number of positions does not match number of "
+                                            "bodies." ) ) );
+    }
+
+    accelerations.resize( 3 * numberOfBodies_ );
+    buildTreeAndComputeAccelerations( positions.data( ), accelerations.data( ) );
+}
+
+//! Build octree and compute accelerations.
+void BarnesHutStateDerivative::buildTreeAndComputeAccelerations( const double* positions,
+                                                                 double* accelerations )
+{
+    const int numberOfBodies_ = static_cast< int >( gravitationalParameters_.size( ) );
+    sortedMortonCodes_.resize( numberOfBodies_ );
+    sortedPositions_.resize( 3 * numberOfBodies_ );
+    sortedGravitationalParameters_.resize( numberOfBodies_ );
+    treeNodes_.clear( );
+    if ( numberOfBodies_ == 0 )
+    {
+        return;
+    }
+
+    // Determine root cell as the smallest cube that contains all bodies.
+    Eigen::Vector3d rootCellCorner_;
+    double rootCellSize_ = 0.0;
+    for ( int i = 0; i < 3; i++ )
+    {
+        const Eigen::Map< const Eigen::ArrayXd > coordinates_(
+                    positions + i * numberOfBodies_, numberOfBodies_ );
+        rootCellCorner_( i ) = coordinates_.minCoeff( );
+        rootCellSize_ = std::max( rootCellSize_, coordinates_.maxCoeff( ) - rootCellCorner_( i ) );
+    }
+    if ( !( rootCellSize_ > 0.0 ) )
+    {
+        rootCellSize_ = 1.0;
+    }
+
+    // Compute Morton codes, and sort bodies by Morton code, by sorting chunks in parallel and
+    // merging them in pairs.
+    const int numberOfUsedThreads_ = static_cast< int >(
+                numberOfThreads_ == 0 ? boost::thread::hardware_concurrency( )
+                                      : numberOfThreads_ );
+    const int numberOfChunks_ = std::max(
+                1, std::min( numberOfUsedThreads_,
+                             numberOfBodies_ / MINIMUM_NUMBER_OF_BODIES_PER_THREAD ) );
+
+    basics::executeParallelLoop(
+                numberOfBodies_,
+                MortonCodeComputation( positions, numberOfBodies_, rootCellCorner_,
+                                       rootCellSize_, sortedMortonCodes_ ),
+                numberOfThreads_, MINIMUM_NUMBER_OF_BODIES_PER_THREAD );
+
+    std::vector< int > chunkBoundaries_( numberOfChunks_ + 1 );
+    for ( int i = 0; i <= numberOfChunks_; i++ )
+    {
+        chunkBoundaries_[ i ] = i * numberOfBodies_ / numberOfChunks_;
+    }
+    basics::executeParallelLoop( numberOfChunks_,
+                                 MortonCodeSorting( chunkBoundaries_, 0, sortedMortonCodes_ ),
+                                 numberOfThreads_ );
+    for ( int mergeWidth_ = 1; mergeWidth_ < numberOfChunks_; mergeWidth_ *= 2 )
+    {
+        basics::executeParallelLoop(
+                    ( numberOfChunks_ + 2 * mergeWidth_ - 1 ) / ( 2 * mergeWidth_ ),
+                    MortonCodeSorting( chunkBoundaries_, mergeWidth_, sortedMortonCodes_ ),
+                    numberOfThreads_ );
+    }
+
+    basics::executeParallelLoop(
+                numberOfBodies_,
+                SortedBodyGathering( positions, gravitationalParameters_, sortedMortonCodes_,
+                                     sortedPositions_, sortedGravitationalParameters_ ),
+                numberOfThreads_, MINIMUM_NUMBER_OF_BODIES_PER_THREAD );
+
+    // Determine the subtrees at the parallel subtree level, which are the ranges of bodies with
+    // equal Morton code prefixes.
+    const int prefixShift_ = 3 * ( MAXIMUM_TREE_LEVEL - PARALLEL_SUBTREE_LEVEL );
+    std::vector< boost::uint64_t > subtreePrefixes_;
+    std::vector< int > subtreeBoundaries_( 1, 0 );
+    while ( subtreeBoundaries_.back( ) < numberOfBodies_ )
+    {
+        const boost::uint64_t prefix_
+                = sortedMortonCodes_[ subtreeBoundaries_.back( ) ].first >> prefixShift_;
+        subtreePrefixes_.push_back( prefix_ );
+        subtreeBoundaries_.push_back( static_cast< int >(
+                    std::lower_bound( sortedMortonCodes_.begin( ) + subtreeBoundaries_.back( ),
+                                      sortedMortonCodes_.end( ), ( prefix_ + 1 ) << prefixShift_,
+                                      &isMortonCodeSmaller ) - sortedMortonCodes_.begin( ) ) );
+    }
+
+    // Build subtrees in parallel, and assemble the top levels of the tree.
+    const int numberOfSubtrees_ = static_cast< int >( subtreePrefixes_.size( ) );
+    if ( static_cast< int >( subtreeNodes_.size( ) ) < numberOfSubtrees_ )
+    {
+        subtreeNodes_.resize( numberOfSubtrees_ );
+    }
+    basics::executeParallelLoop(
+                numberOfSubtrees_,
+                SubtreeConstruction( sortedMortonCodes_, sortedPositions_,
+                                     sortedGravitationalParameters_, subtreeBoundaries_,
+                                     rootCellSize_ / static_cast< double >(
+                                         1 << PARALLEL_SUBTREE_LEVEL ),
+                                     openingAngle_, leafCapacity_, subtreeNodes_ ),
+                numberOfBodies_ >= MINIMUM_NUMBER_OF_BODIES_PER_THREAD
+                ? numberOfThreads_ : 1 );
+
+    assembleTopLevelNode( subtreePrefixes_, subtreeBoundaries_, 0, numberOfSubtrees_, 0,
+                          rootCellSize_, openingAngle_, subtreeNodes_, treeNodes_ );
+
+    // Traverse tree for all bodies in parallel.
+    basics::executeParallelLoop(
+                numberOfBodies_,
+                OctreeTraversal( treeNodes_, sortedMortonCodes_, sortedPositions_,
+                                 sortedGravitationalParameters_, accelerations ),
+                numberOfThreads_, MINIMUM_NUMBER_OF_BODIES_PER_THREAD );
+}
+
+} // namespace gravitation
+} // namespace tudat
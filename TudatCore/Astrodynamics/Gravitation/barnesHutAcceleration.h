@@ -0,0 +1,208 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *      Warren, M.S., Salmon, J.K. A parallel hashed oct-tree N-body algorithm, Proceedings of
+ *          Supercomputing '93, 12-21, 1993.
+ *
+ *    Notes
+ *      The octree is rebuilt at every evaluation. The bodies are sorted along a Morton
+ *      (Z-order) curve, such that the bodies in each node of the tree form a contiguous range,
+ *      and the nodes are stored in a single array in depth-first order. Each node stores the
+ *      index of the node following its subtree, such that the tree is traversed without a stack
+ *      by moving forward through the array. The node arrays are kept between evaluations, so that
+ *      no memory is allocated once they have reached their required size.
+ *
+ *      The Morton codes, the sorting, the subtrees below the second level of the tree and the
+ *      traversals for the target bodies are divided over multiple threads. The tree does not
+ *      depend on the number of threads, so neither do the accelerations.
+ *
+ *      Nodes are approximated by their total mass at their center of mass (monopole), if the
+ *      edge length of their cell divided by the distance to the center of mass is smaller than
+ *      the opening angle. Nodes containing the target body itself are always opened. For an
+ *      opening angle of zero, the accelerations are computed by direct summation.
+ *
+ */
+
+#ifndef TUDAT_CORE_BARNES_HUT_ACCELERATION_H
+#define TUDAT_CORE_BARNES_HUT_ACCELERATION_H
+
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Node of Barnes-Hut octree.
+struct BarnesHutTreeNode
+{
+    //! Center of mass of the bodies in the node.
+    double centerOfMass[ 3 ];
+
+    //! Sum of the gravitational parameters of the bodies in the node.
+    double gravitationalParameter;
+
+    //! Squared distance beyond which the node is approximated as a point mass.
+    double openingDistanceSquared;
+
+    //! Index of the first body in the node, in the order of the sorted bodies.
+    int firstBodyIndex;
+
+    //! Number of bodies in the node.
+    int numberOfBodies;
+
+    //! Index of the node following the subtree of this node, in depth-first order.
+    int nextNodeIndex;
+
+    //! Flag indicating whether the node is a leaf.
+    bool isLeaf;
+};
+
+//! State derivative for propagation of N point masses using a Barnes-Hut octree.
+/*!
+ * State derivative for numerical propagation of a set of point masses under their mutual
+ * gravitational attraction, in which the accelerations are approximated using a Barnes-Hut
+ * octree (Barnes and Hut, 1986). The state is stored as a structure of arrays, in the same way as
+ * for the NBodyPointMassStateDerivative. The computeStateDerivative() function can be bound to
+ * the state derivative function of the numerical integrators, e.g.:
+ * \code
+ * RungeKutta4IntegratorXd integrator(
+ *     boost::bind( &BarnesHutStateDerivative::computeStateDerivative,
+ *                  &stateDerivative, _1, _2 ), 0.0, initialNBodyState );
+ * \endcode
+ * Since the tree is stored in the object, a single object should not be used by multiple threads
+ * at the same time.
+ */
+class BarnesHutStateDerivative
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking the masses of the bodies, from which the gravitational
+     * parameters are computed using the given gravitational constant. An error is thrown if the
+     * opening angle is negative or the leaf capacity is not positive.
+     * \param masses Vector of masses of the bodies (N entries).                               [kg]
+     * \param openingAngle Opening angle, i.e., the maximum ratio of the edge length of a cell to
+     *          the distance to its center of mass, for which the cell is approximated as a point
+     *          mass.                                                                            [-]
+     * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware
+     *          threads is used.
+     * \param leafCapacity Maximum number of bodies in a leaf node.
+     * \param gravitationalConstant Gravitational constant.                          [m^3/(kg s^2)]
+     */
+    BarnesHutStateDerivative( const Eigen::VectorXd& masses, const double openingAngle = 0.5,
+                              const unsigned int numberOfThreads = 0,
+                              const int leafCapacity = 8,
+                              const double gravitationalConstant
+                              = basic_astrodynamics::physical_constants::GRAVITATIONAL_CONSTANT );
+
+    //! Compute state derivative.
+    /*!
+     * Computes the derivative of the N-body state, i.e., the velocities and accelerations of all
+     * bodies, after rebuilding the octree. An error is thrown if the size of the state does not
+     * match the number of bodies.
+     * \param time Current time (unused).                                                       [s]
+     * \param nBodyState Current N-body state (6N entries).
+     * \return Derivative of N-body state (6N entries).
+     */
+    Eigen::VectorXd computeStateDerivative( const double time, const Eigen::VectorXd& nBodyState );
+
+    //! Compute accelerations.
+    /*!
+     * Computes the accelerations of all bodies, after rebuilding the octree. An error is thrown
+     * if the number of positions does not match the number of bodies.
+     * \param positions Vector of positions (3N entries), containing the x-, y- and z-positions of
+     *          all bodies as consecutive blocks of N entries.                                  [m]
+     * \param accelerations Vector in which the accelerations are stored (3N entries), ordered in
+     *          the same way as the positions. If the vector is preallocated with the correct
+     *          size, no memory is allocated; otherwise it is resized.                      [m/s^2]
+     */
+    void computeAccelerations( const Eigen::VectorXd& positions, Eigen::VectorXd& accelerations );
+
+    //! Get nodes of octree.
+    /*!
+     * Returns the nodes of the octree built in the last evaluation, in depth-first order.
+     * \return Nodes of octree.
+     */
+    const std::vector< BarnesHutTreeNode >& getTreeNodes( ) const { return treeNodes_; }
+
+private:
+
+    //! Typedef for Morton code and index of body.
+    typedef std::pair< boost::uint64_t, int > MortonCodeEntry;
+
+    //! Build octree and compute accelerations.
+    /*!
+     * Builds the octree for the given positions and computes the accelerations of all bodies.
+     * \param positions Pointer to positions (3N entries).
+     * \param accelerations Pointer to accelerations (3N entries).
+     */
+    void buildTreeAndComputeAccelerations( const double* positions, double* accelerations );
+
+    //! Gravitational parameters of the bodies.
+    const Eigen::VectorXd gravitationalParameters_;
+
+    //! Opening angle.
+    const double openingAngle_;
+
+    //! Number of threads to use.
+    const unsigned int numberOfThreads_;
+
+    //! Maximum number of bodies in a leaf node.
+    const int leafCapacity_;
+
+    //! Morton codes and indices of bodies, sorted by Morton code.
+    std::vector< MortonCodeEntry > sortedMortonCodes_;
+
+    //! Positions of bodies in sorted order, stored as a structure of arrays.
+    Eigen::VectorXd sortedPositions_;
+
+    //! Gravitational parameters of bodies in sorted order.
+    Eigen::VectorXd sortedGravitationalParameters_;
+
+    //! Nodes of subtrees below the top levels of the octree, one array per subtree.
+    std::vector< std::vector< BarnesHutTreeNode > > subtreeNodes_;
+
+    //! Nodes of octree, in depth-first order.
+    std::vector< BarnesHutTreeNode > treeNodes_;
+};
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_CORE_BARNES_HUT_ACCELERATION_H
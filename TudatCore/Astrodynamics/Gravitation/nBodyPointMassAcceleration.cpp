@@ -0,0 +1,323 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Nyland, L., Harris, M., Prins, J. Fast N-body simulation with CUDA, GPU Gems 3, Chapter 31,
+ *          Addison-Wesley, 2007.
+ *
+ *    Notes
+ *      The inverse distances are computed with the vectorized reciprocal square root of Eigen,
+ *      such that the inverse cube of the distance requires no division.
+ *
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/Gravitation/nBodyPointMassAcceleration.h"
+#include "TudatCore/Basics/parallelLoop.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+namespace
+{
+
+//! Minimum number of target bodies per thread.
+const int MINIMUM_NUMBER_OF_BODIES_PER_THREAD = 64;
+
+//! Loop body for computation of N-body point-mass accelerations.
+/*!
+ * Loop body for parallel computation of N-body point-mass accelerations, used with
+ * basics::executeParallelLoop(). Each call computes the accelerations of a range of target
+ * bodies, by accumulating the contributions of tiles of source bodies.
+ */
+class NBodyPointMassAccelerationLoopBody
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param positions Pointer to positions, stored as consecutive blocks of x-, y- and
+     *          z-positions (3N entries).
+     * \param gravitationalParameters Pointer to gravitational parameters (N entries).
+     * \param numberOfBodies Number of bodies.
+     * \param blockSize Number of bodies per tile.
+     * \param accelerations Pointer to accelerations, stored in the same way as the positions.
+     */
+    NBodyPointMassAccelerationLoopBody( const double* positions,
+                                        const double* gravitationalParameters,
+                                        const int numberOfBodies, const int blockSize,
+                                        double* accelerations )
+        : positions_( positions ),
+          gravitationalParameters_( gravitationalParameters ),
+          numberOfBodies_( numberOfBodies ),
+          blockSize_( blockSize ),
+          accelerations_( accelerations )
+    { }
+
+    //! Compute accelerations of range of target bodies.
+    /*!
+     * Computes the accelerations of the target bodies in the range [ startIndex, endIndex ).
+     * \param startIndex Index of first target body.
+     * \param endIndex Index one past the last target body.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        // Work buffer for the weights of a tile of source bodies.
+        Eigen::ArrayXd weights_( blockSize_ );
+
+        for ( int targetTileStart = startIndex; targetTileStart < endIndex;
+              targetTileStart += blockSize_ )
+        {
+            const int targetTileEnd_ = std::min( targetTileStart + blockSize_, endIndex );
+
+            for ( int i = targetTileStart; i < targetTileEnd_; i++ )
+            {
+                accelerations_[ i ] = 0.0;
+                accelerations_[ numberOfBodies_ + i ] = 0.0;
+                accelerations_[ 2 * numberOfBodies_ + i ] = 0.0;
+            }
+
+            for ( int sourceTileStart = 0; sourceTileStart < numberOfBodies_;
+                  sourceTileStart += blockSize_ )
+            {
+                const int sourceTileEnd_ = std::min( sourceTileStart + blockSize_,
+                                                     numberOfBodies_ );
+
+                for ( int i = targetTileStart; i < targetTileEnd_; i++ )
+                {
+                    // Skip the interaction of the target body with itself.
+                    if ( i >= sourceTileStart && i < sourceTileEnd_ )
+                    {
+                        accumulateAcceleration( i, sourceTileStart, i, weights_ );
+                        accumulateAcceleration( i, i + 1, sourceTileEnd_, weights_ );
+                    }
+                    else
+                    {
+                        accumulateAcceleration( i, sourceTileStart, sourceTileEnd_, weights_ );
+                    }
+                }
+            }
+        }
+    }
+
+private:
+
+    //! Accumulate acceleration of target body due to range of source bodies.
+    /*!
+     * Adds the accelerations of a target body due to the source bodies in the range
+     * [ sourceStartIndex, sourceEndIndex ) to the stored accelerations. The separations are
+     * evaluated within the array expressions, rather than stored, which reduces the number of
+     * passes over the tile.
+     * \param targetIndex Index of target body.
+     * \param sourceStartIndex Index of first source body.
+     * \param sourceEndIndex Index one past the last source body.
+     * \param weights Work buffer for gravitational parameters over cubed distances.
+     */
+    void accumulateAcceleration( const int targetIndex, const int sourceStartIndex,
+                                 const int sourceEndIndex, Eigen::ArrayXd& weights ) const
+    {
+        const int numberOfSources_ = sourceEndIndex - sourceStartIndex;
+        if ( numberOfSources_ <= 0 )
+        {
+            return;
+        }
+
+        const Eigen::Map< const Eigen::ArrayXd > sourcePositionsX_(
+                    positions_ + sourceStartIndex, numberOfSources_ );
+        const Eigen::Map< const Eigen::ArrayXd > sourcePositionsY_(
+                    positions_ + numberOfBodies_ + sourceStartIndex, numberOfSources_ );
+        const Eigen::Map< const Eigen::ArrayXd > sourcePositionsZ_(
+                    positions_ + 2 * numberOfBodies_ + sourceStartIndex, numberOfSources_ );
+        const Eigen::Map< const Eigen::ArrayXd > sourceGravitationalParameters_(
+                    gravitationalParameters_ + sourceStartIndex, numberOfSources_ );
+
+        const double targetPositionX_ = positions_[ targetIndex ];
+        const double targetPositionY_ = positions_[ numberOfBodies_ + targetIndex ];
+        const double targetPositionZ_ = positions_[ 2 * numberOfBodies_ + targetIndex ];
+
+        // Compute inverse distances, and from these the weights mu / r^3.
+        weights.head( numberOfSources_ ) = sourceGravitationalParameters_
+                * ( ( sourcePositionsX_ - targetPositionX_ ).square( )
+                    + ( sourcePositionsY_ - targetPositionY_ ).square( )
+                    + ( sourcePositionsZ_ - targetPositionZ_ ).square( ) ).rsqrt( ).cube( );
+
+        accelerations_[ targetIndex ] += ( weights.head( numberOfSources_ )
+                                           * ( sourcePositionsX_ - targetPositionX_ ) ).sum( );
+        accelerations_[ numberOfBodies_ + targetIndex ]
+                += ( weights.head( numberOfSources_ )
+                     * ( sourcePositionsY_ - targetPositionY_ ) ).sum( );
+        accelerations_[ 2 * numberOfBodies_ + targetIndex ]
+                += ( weights.head( numberOfSources_ )
+                     * ( sourcePositionsZ_ - targetPositionZ_ ) ).sum( );
+    }
+
+    //! Pointer to positions.
+    const double* positions_;
+
+    //! Pointer to gravitational parameters.
+    const double* gravitationalParameters_;
+
+    //! Number of bodies.
+    const int numberOfBodies_;
+
+    //! Number of bodies per tile.
+    const int blockSize_;
+
+    //! Pointer to accelerations.
+    double* accelerations_;
+};
+
+//! Check block size.
+/*!
+ * Checks that the block size is positive, throwing an error otherwise.
+ * \param blockSize Number of bodies per tile.
+ */
+void checkBlockSize( const int blockSize )
+{
+    if ( blockSize < 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Block size must be positive." ) ) );
+    }
+}
+
+} // namespace
+
+//! Convert Cartesian states of bodies to N-body state.
+Eigen::VectorXd convertCartesianStatesToNBodyState( const Eigen::MatrixXd& cartesianStates )
+{
+    if ( cartesianStates.rows( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Cartesian states must have six rows." ) ) );
+    }
+
+    // Store the transpose, such that each Cartesian element forms a block of N entries.
+    const int numberOfBodies_ = cartesianStates.cols( );
+    Eigen::VectorXd nBodyState_( 6 * numberOfBodies_ );
+    Eigen::Map< Eigen::MatrixXd >( nBodyState_.data( ), numberOfBodies_, 6 )
+            = cartesianStates.transpose( );
+    return nBodyState_;
+}
+
+//! Convert N-body state to Cartesian states of bodies.
+Eigen::MatrixXd convertNBodyStateToCartesianStates( const Eigen::VectorXd& nBodyState )
+{
+    if ( nBodyState.size( ) % 6 != 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Size of N-body state must be a multiple of six." ) ) );
+    }
+
+    const int numberOfBodies_ = nBodyState.size( ) / 6;
+    return Eigen::Map< const Eigen::MatrixXd >(
+                nBodyState.data( ), numberOfBodies_, 6 ).transpose( );
+}
+
+//! Compute N-body point-mass accelerations.
+void computeNBodyPointMassAccelerations( const Eigen::VectorXd& positions,
+                                         const Eigen::VectorXd& gravitationalParameters,
+                                         Eigen::VectorXd& accelerations,
+                                         const unsigned int numberOfThreads,
+                                         const int blockSize )
+{
+    checkBlockSize( blockSize );
+
+    const int numberOfBodies_ = gravitationalParameters.size( );
+    if ( positions.size( ) != 3 * numberOfBodies_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Number of positions does not match number of "
+                                            "gravitational parameters." ) ) );
+    }
+
+    accelerations.resize( 3 * numberOfBodies_ );
+
+    basics::executeParallelLoop(
+                numberOfBodies_,
+                NBodyPointMassAccelerationLoopBody( positions.data( ),
+                                                    gravitationalParameters.data( ),
+                                                    numberOfBodies_, blockSize,
+                                                    accelerations.data( ) ),
+                numberOfThreads, MINIMUM_NUMBER_OF_BODIES_PER_THREAD );
+}
+
+//! Default constructor.
+NBodyPointMassStateDerivative::NBodyPointMassStateDerivative( const Eigen::VectorXd& masses,
+                                                              const unsigned int numberOfThreads,
+                                                              const int blockSize,
+                                                              const double gravitationalConstant )
+    : gravitationalParameters_( gravitationalConstant * masses ),
+      numberOfThreads_( numberOfThreads ),
+      blockSize_( blockSize )
+{
+    checkBlockSize( blockSize );
+}
+
+//! Compute state derivative.
+Eigen::VectorXd NBodyPointMassStateDerivative::computeStateDerivative(
+        const double time, const Eigen::VectorXd& nBodyState ) const
+{
+    const int numberOfBodies_ = gravitationalParameters_.size( );
+    if ( nBodyState.size( ) != 6 * numberOfBodies_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Size of N-body state does not match number of "
+                                            "bodies." ) ) );
+    }
+
+    // The derivatives of the positions are the velocities, and the accelerations are written
+    // directly into the second half of the state derivative.
+    Eigen::VectorXd stateDerivative_( 6 * numberOfBodies_ );
+    stateDerivative_.head( 3 * numberOfBodies_ ) = nBodyState.tail( 3 * numberOfBodies_ );
+
+    basics::executeParallelLoop(
+                numberOfBodies_,
+                NBodyPointMassAccelerationLoopBody( nBodyState.data( ),
+                                                    gravitationalParameters_.data( ),
+                                                    numberOfBodies_, blockSize_,
+                                                    stateDerivative_.data( )
+                                                    + 3 * numberOfBodies_ ),
+                numberOfThreads_, MINIMUM_NUMBER_OF_BODIES_PER_THREAD );
+
+    return stateDerivative_;
+}
+
+} // namespace gravitation
+} // namespace tudat
@@ -0,0 +1,177 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Nyland, L., Harris, M., Prins, J. Fast N-body simulation with CUDA, GPU Gems 3, Chapter 31,
+ *          Addison-Wesley, 2007.
+ *
+ *    Notes
+ *      The N-body state vector is stored as a structure of arrays: for N bodies, it contains the
+ *      x-, y- and z-positions of all bodies, followed by the x-, y- and z-velocities of all bodies,
+ *      each as a contiguous block of N entries. This allows the pairwise interactions to be
+ *      evaluated on contiguous arrays, which are vectorized by Eigen, without copying the state.
+ *
+ *      The pairwise interactions are evaluated in tiles of bodies, such that the positions and
+ *      gravitational parameters of a tile of source bodies remain in cache while the
+ *      accelerations of a tile of target bodies are accumulated. The target bodies are divided
+ *      over multiple threads, which each write to their own part of the accelerations.
+ *
+ *      Bodies are treated as point masses without softening, so that coinciding bodies result in
+ *      infinite or NaN accelerations.
+ *
+ */
+
+#ifndef TUDAT_CORE_N_BODY_POINT_MASS_ACCELERATION_H
+#define TUDAT_CORE_N_BODY_POINT_MASS_ACCELERATION_H
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Convert Cartesian states of bodies to N-body state.
+/*!
+ * Converts the Cartesian states of a set of bodies to an N-body state vector, stored as a
+ * structure of arrays as described in the notes of this file.
+ * \param cartesianStates Matrix of Cartesian states, with one body per column (6 x N), ordered as
+ *          given by the CartesianElementVectorIndices enum.
+ * \return N-body state vector (6N entries).
+ */
+Eigen::VectorXd convertCartesianStatesToNBodyState( const Eigen::MatrixXd& cartesianStates );
+
+//! Convert N-body state to Cartesian states of bodies.
+/*!
+ * Converts an N-body state vector, stored as a structure of arrays as described in the notes of
+ * this file, to the Cartesian states of the bodies. An error is thrown if the size of the state
+ * vector is not a multiple of six.
+ * \param nBodyState N-body state vector (6N entries).
+ * \return Matrix of Cartesian states, with one body per column (6 x N).
+ */
+Eigen::MatrixXd convertNBodyStateToCartesianStates( const Eigen::VectorXd& nBodyState );
+
+//! Compute N-body point-mass accelerations.
+/*!
+ * Computes the gravitational accelerations of a set of point masses due to all other point
+ * masses in the set, by direct summation of the pairwise interactions:
+ * \f[
+ *      \ddot{r}_i = \sum_{j \neq i} \mu_j \frac{ r_j - r_i }{ | r_j - r_i |^3 }
+ * \f]
+ * The interactions are evaluated in tiles of bodies and divided over multiple threads, as
+ * described in the notes of this file. An error is thrown if the input sizes do not match or the
+ * block size is not positive.
+ * \param positions Vector of positions (3N entries), containing the x-, y- and z-positions of all
+ *          bodies as consecutive blocks of N entries.                                          [m]
+ * \param gravitationalParameters Vector of gravitational parameters (N entries).         [m^3/s^2]
+ * \param accelerations Vector in which the accelerations are stored (3N entries), ordered in the
+ *          same way as the positions. If the vector is preallocated with the correct size, no
+ *          memory is allocated; otherwise it is resized.                                   [m/s^2]
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \param blockSize Number of bodies per tile.
+ */
+void computeNBodyPointMassAccelerations( const Eigen::VectorXd& positions,
+                                         const Eigen::VectorXd& gravitationalParameters,
+                                         Eigen::VectorXd& accelerations,
+                                         const unsigned int numberOfThreads = 0,
+                                         const int blockSize = 256 );
+
+//! State derivative for propagation of N point masses.
+/*!
+ * State derivative for numerical propagation of a set of point masses under their mutual
+ * gravitational attraction. The state is stored as a structure of arrays, as described in the
+ * notes of this file, and the accelerations are computed with
+ * computeNBodyPointMassAccelerations(). The computeStateDerivative() function can be bound to the
+ * state derivative function of the numerical integrators, e.g.:
+ * \code
+ * RungeKutta4IntegratorXd integrator(
+ *     boost::bind( &NBodyPointMassStateDerivative::computeStateDerivative,
+ *                  &stateDerivative, _1, _2 ), 0.0, initialNBodyState );
+ * \endcode
+ */
+class NBodyPointMassStateDerivative
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking the masses of the bodies, from which the gravitational
+     * parameters are computed using the given gravitational constant. An error is thrown if the
+     * block size is not positive.
+     * \param masses Vector of masses of the bodies (N entries).                               [kg]
+     * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware
+     *          threads is used.
+     * \param blockSize Number of bodies per tile.
+     * \param gravitationalConstant Gravitational constant.                          [m^3/(kg s^2)]
+     */
+    NBodyPointMassStateDerivative( const Eigen::VectorXd& masses,
+                                   const unsigned int numberOfThreads = 0,
+                                   const int blockSize = 256,
+                                   const double gravitationalConstant
+                                   = basic_astrodynamics::physical_constants::
+                                   GRAVITATIONAL_CONSTANT );
+
+    //! Compute state derivative.
+    /*!
+     * Computes the derivative of the N-body state, i.e., the velocities and accelerations of all
+     * bodies. An error is thrown if the size of the state does not match the number of bodies.
+     * \param time Current time (unused).                                                       [s]
+     * \param nBodyState Current N-body state (6N entries).
+     * \return Derivative of N-body state (6N entries).
+     */
+    Eigen::VectorXd computeStateDerivative( const double time,
+                                            const Eigen::VectorXd& nBodyState ) const;
+
+    //! Get gravitational parameters.
+    /*!
+     * Returns the gravitational parameters of the bodies.
+     * \return Vector of gravitational parameters.                                      [m^3/s^2]
+     */
+    const Eigen::VectorXd& getGravitationalParameters( ) const
+    {
+        return gravitationalParameters_;
+    }
+
+private:
+
+    //! Gravitational parameters of the bodies.
+    const Eigen::VectorXd gravitationalParameters_;
+
+    //! Number of threads to use.
+    const unsigned int numberOfThreads_;
+
+    //! Number of bodies per tile.
+    const int blockSize_;
+};
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_CORE_N_BODY_POINT_MASS_ACCELERATION_H
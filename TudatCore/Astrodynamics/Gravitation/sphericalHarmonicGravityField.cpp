@@ -0,0 +1,474 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Holmes, S.A., Featherstone, W.E. A unified approach to the Clenshaw summation and the
+ *          recursive computation of very high degree and order normalised associated Legendre
+ *          functions, Journal of Geodesy, 76, 279-299, 2002.
+ *      Montenbruck, O., Gill, E. Satellite Orbits, Springer, 2000.
+ *
+ *    Notes
+ *      With t = sin phi, the normalized associated Legendre functions are written as
+ *      Pnm( t ) = cos^m phi Qnm( t ), and the trigonometric terms as cos^m phi cos m lambda
+ *      + i cos^m phi sin m lambda = ( ( x + i y ) / r )^m. Each term of the potential is then a
+ *      function of t, r and ( x + i y )^m, of which the Cartesian gradient follows from the
+ *      chain rule. The derivative of Qnm( t ) is proportional to Qn,m+1( t ), such that no
+ *      separate recursion is needed for the derivatives.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/Gravitation/sphericalHarmonicGravityField.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/InputOutput/matrixTextFileReader.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Work buffers for evaluation of spherical harmonic gravity field.
+struct SphericalHarmonicWorkBuffers
+{
+    //! Default constructor.
+    /*!
+     * Default constructor, allocating the buffers for a given truncation degree.
+     * \param truncationDegree Maximum degree and order of gravity field.
+     */
+    explicit SphericalHarmonicWorkBuffers( const int truncationDegree )
+        : legendreFunctions( ( truncationDegree + 1 ) * ( truncationDegree + 2 ) / 2 ),
+          cosineTerms( truncationDegree + 1 ),
+          sineTerms( truncationDegree + 1 ),
+          harmonicTerms( truncationDegree + 1 )
+    { }
+
+    //! Normalized associated Legendre functions divided by cos^m phi, packed per degree.
+    Eigen::ArrayXd legendreFunctions;
+
+    //! Terms cos^m phi cos m lambda, per order.
+    Eigen::ArrayXd cosineTerms;
+
+    //! Terms cos^m phi sin m lambda, per order.
+    Eigen::ArrayXd sineTerms;
+
+    //! Sums of cosine and sine terms weighted by the coefficients of a single degree, per order.
+    Eigen::ArrayXd harmonicTerms;
+};
+
+namespace
+{
+
+//! Minimum number of positions per thread.
+const int MINIMUM_NUMBER_OF_POSITIONS_PER_THREAD = 16;
+
+//! Loop body for computation of spherical harmonic gravitational accelerations.
+/*!
+ * Loop body for parallel computation of spherical harmonic gravitational accelerations, used
+ * with basics::executeParallelLoop(). Each call allocates a single set of work buffers, which is
+ * reused for all positions in its range.
+ */
+class SphericalHarmonicAccelerationLoopBody
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param gravityField Gravity field to evaluate.
+     * \param positions Matrix of positions, with one position per column.
+     * \param accelerations Matrix in which the accelerations are stored.
+     */
+    SphericalHarmonicAccelerationLoopBody( const SphericalHarmonicGravityField& gravityField,
+                                           const Eigen::MatrixXd& positions,
+                                           Eigen::MatrixXd& accelerations )
+        : gravityField_( gravityField ),
+          positions_( positions ),
+          accelerations_( accelerations )
+    { }
+
+    //! Compute accelerations at range of positions.
+    /*!
+     * Computes the accelerations at the positions in the range [ startIndex, endIndex ).
+     * \param startIndex Index of first position.
+     * \param endIndex Index one past the last position.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        SphericalHarmonicWorkBuffers workBuffers_( gravityField_.getTruncationDegree( ) );
+
+        for ( int i = startIndex; i < endIndex; i++ )
+        {
+            accelerations_.col( i ) = gravityField_.computeAcceleration(
+                        positions_.col( i ), workBuffers_ );
+        }
+    }
+
+private:
+
+    //! Gravity field to evaluate.
+    const SphericalHarmonicGravityField& gravityField_;
+
+    //! Matrix of positions.
+    const Eigen::MatrixXd& positions_;
+
+    //! Matrix of accelerations.
+    Eigen::MatrixXd& accelerations_;
+};
+
+} // namespace
+
+//! Read spherical harmonic gravity field coefficients from file.
+void readSphericalHarmonicGravityFieldCoefficients( const std::string& filePath,
+                                                    const int maximumDegree,
+                                                    Eigen::MatrixXd& cosineCoefficients,
+                                                    Eigen::MatrixXd& sineCoefficients )
+{
+    if ( maximumDegree < 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Maximum degree of gravity field is negative." ) ) );
+    }
+
+    const Eigen::MatrixXd fileContents_ = input_output::readMatrixFromFile(
+                filePath, "\t ;,", "%#" );
+
+    if ( fileContents_.cols( ) < 4 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Gravity field coefficient file has fewer than four "
+                                            "columns." ) ) );
+    }
+
+    cosineCoefficients.setZero( maximumDegree + 1, maximumDegree + 1 );
+    sineCoefficients.setZero( maximumDegree + 1, maximumDegree + 1 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+
+    for ( int i = 0; i < fileContents_.rows( ); i++ )
+    {
+        const int degree_ = static_cast< int >( fileContents_( i, 0 ) );
+        const int order_ = static_cast< int >( fileContents_( i, 1 ) );
+
+        if ( degree_ != fileContents_( i, 0 ) || order_ != fileContents_( i, 1 )
+             || order_ < 0 || order_ > degree_ )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Invalid degree or order in gravity field "
+                                                "coefficient file." ) ) );
+        }
+
+        if ( degree_ <= maximumDegree )
+        {
+            cosineCoefficients( degree_, order_ ) = fileContents_( i, 2 );
+            sineCoefficients( degree_, order_ ) = fileContents_( i, 3 );
+        }
+    }
+}
+
+//! Default constructor.
+SphericalHarmonicGravityField::SphericalHarmonicGravityField(
+        const double gravitationalParameter, const double referenceRadius,
+        const Eigen::MatrixXd& cosineCoefficients, const Eigen::MatrixXd& sineCoefficients,
+        const int truncationDegree )
+    : gravitationalParameter_( gravitationalParameter ),
+      referenceRadius_( referenceRadius ),
+      truncationDegree_( truncationDegree )
+{
+    if ( cosineCoefficients.rows( ) == 0 || cosineCoefficients.rows( ) != cosineCoefficients.cols( )
+         || sineCoefficients.rows( ) != cosineCoefficients.rows( )
+         || sineCoefficients.cols( ) != cosineCoefficients.cols( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Gravity field coefficient matrices are not square "
+                                            "and of equal size." ) ) );
+    }
+
+    if ( truncationDegree_ < 0 )
+    {
+        truncationDegree_ = static_cast< int >( cosineCoefficients.rows( ) ) - 1;
+    }
+    else if ( truncationDegree_ >= cosineCoefficients.rows( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Truncation degree exceeds maximum degree of gravity "
+                                            "field coefficients." ) ) );
+    }
+
+    // Store coefficients and recursion coefficients in packed triangular arrays, with the
+    // orders of each degree stored consecutively.
+    const int numberOfTerms_ = ( truncationDegree_ + 1 ) * ( truncationDegree_ + 2 ) / 2;
+    orders_ = Eigen::ArrayXd::LinSpaced( truncationDegree_ + 1, 0.0, truncationDegree_ );
+    packedCosineCoefficients_.resize( numberOfTerms_ );
+    packedSineCoefficients_.resize( numberOfTerms_ );
+    firstRecursionCoefficients_.setZero( numberOfTerms_ );
+    secondRecursionCoefficients_.setZero( numberOfTerms_ );
+    derivativeFactors_.setZero( numberOfTerms_ );
+
+    int index_ = 0;
+    for ( int degree_ = 0; degree_ <= truncationDegree_; degree_++ )
+    {
+        const double n_ = static_cast< double >( degree_ );
+
+        for ( int order_ = 0; order_ <= degree_; order_++, index_++ )
+        {
+            const double m_ = static_cast< double >( order_ );
+            packedCosineCoefficients_( index_ ) = cosineCoefficients( degree_, order_ );
+            packedSineCoefficients_( index_ ) = sineCoefficients( degree_, order_ );
+
+            if ( degree_ == 0 )
+            {
+                continue;
+            }
+            else if ( order_ == degree_ )
+            {
+                // Sectorial recursion, from degree and order n - 1.
+                firstRecursionCoefficients_( index_ ) = ( degree_ == 1 )
+                        ? std::sqrt( 3.0 ) : std::sqrt( ( 2.0 * n_ + 1.0 ) / ( 2.0 * n_ ) );
+            }
+            else
+            {
+                // Recursion over degree, which reduces to a single term for m = n - 1.
+                firstRecursionCoefficients_( index_ ) = std::sqrt(
+                            ( 2.0 * n_ - 1.0 ) * ( 2.0 * n_ + 1.0 )
+                            / ( ( n_ - m_ ) * ( n_ + m_ ) ) );
+                if ( order_ < degree_ - 1 )
+                {
+                    secondRecursionCoefficients_( index_ ) = std::sqrt(
+                                ( 2.0 * n_ + 1.0 ) * ( n_ + m_ - 1.0 ) * ( n_ - m_ - 1.0 )
+                                / ( ( n_ - m_ ) * ( n_ + m_ ) * ( 2.0 * n_ - 3.0 ) ) );
+                }
+
+                // dQnm / dt = k Qn,m+1, with the ratio of normalization factors k.
+                derivativeFactors_( index_ ) = ( order_ == 0 )
+                        ? std::sqrt( 0.5 * n_ * ( n_ + 1.0 ) )
+                        : std::sqrt( ( n_ - m_ ) * ( n_ + m_ + 1.0 ) );
+            }
+        }
+    }
+}
+
+//! Default destructor.
+SphericalHarmonicGravityField::~SphericalHarmonicGravityField( ) { }
+
+//! Compute gravitational potential.
+double SphericalHarmonicGravityField::computePotential(
+        const Eigen::Vector3d& bodyFixedPosition ) const
+{
+    SphericalHarmonicWorkBuffers& workBuffers_ = getWorkBuffers( );
+    computeLegendreFunctionsAndHarmonicTerms( bodyFixedPosition, workBuffers_ );
+
+    const double radiusRatio_ = referenceRadius_ / bodyFixedPosition.norm( );
+    double radiusRatioPower_ = 1.0;
+    double potential_ = 0.0;
+    for ( int degree_ = 0; degree_ <= truncationDegree_; degree_++ )
+    {
+        const int offset_ = degree_ * ( degree_ + 1 ) / 2;
+        const int numberOfOrders_ = degree_ + 1;
+
+        potential_ += radiusRatioPower_
+                * ( workBuffers_.legendreFunctions.segment( offset_, numberOfOrders_ )
+                    * ( packedCosineCoefficients_.segment( offset_, numberOfOrders_ )
+                        * workBuffers_.cosineTerms.head( numberOfOrders_ )
+                        + packedSineCoefficients_.segment( offset_, numberOfOrders_ )
+                        * workBuffers_.sineTerms.head( numberOfOrders_ ) ) ).sum( );
+        radiusRatioPower_ *= radiusRatio_;
+    }
+
+    return gravitationalParameter_ / bodyFixedPosition.norm( ) * potential_;
+}
+
+//! Compute gravitational acceleration.
+Eigen::Vector3d SphericalHarmonicGravityField::computeAcceleration(
+        const Eigen::Vector3d& bodyFixedPosition ) const
+{
+    return computeAcceleration( bodyFixedPosition, getWorkBuffers( ) );
+}
+
+//! Compute gravitational accelerations at multiple positions.
+void SphericalHarmonicGravityField::computeAccelerations(
+        const Eigen::MatrixXd& bodyFixedPositions, Eigen::MatrixXd& accelerations,
+        const unsigned int numberOfThreads ) const
+{
+    if ( bodyFixedPositions.rows( ) != 3 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Positions do not have three rows." ) ) );
+    }
+
+    accelerations.resize( 3, bodyFixedPositions.cols( ) );
+
+    basics::executeParallelLoop(
+                static_cast< int >( bodyFixedPositions.cols( ) ),
+                SphericalHarmonicAccelerationLoopBody( *this, bodyFixedPositions, accelerations ),
+                numberOfThreads, MINIMUM_NUMBER_OF_POSITIONS_PER_THREAD );
+}
+
+//! Compute gravitational acceleration using given work buffers.
+Eigen::Vector3d SphericalHarmonicGravityField::computeAcceleration(
+        const Eigen::Vector3d& bodyFixedPosition,
+        SphericalHarmonicWorkBuffers& workBuffers ) const
+{
+    computeLegendreFunctionsAndHarmonicTerms( bodyFixedPosition, workBuffers );
+
+    const double radius_ = bodyFixedPosition.norm( );
+    const Eigen::Vector3d unitPosition_ = bodyFixedPosition / radius_;
+    const double sineOfLatitude_ = unitPosition_.z( );
+    const double radiusRatio_ = referenceRadius_ / radius_;
+
+    // Sums of the terms of the gradient due to the dependence on r (radial), on t = z / r
+    // (latitudinal) and on ( x + i y )^m (longitudinal).
+    double radialSum_ = 0.0;
+    double latitudinalSum_ = 0.0;
+    double longitudinalSumX_ = 0.0;
+    double longitudinalSumY_ = 0.0;
+
+    double radiusRatioPower_ = 1.0;
+    for ( int degree_ = 0; degree_ <= truncationDegree_; degree_++ )
+    {
+        const int offset_ = degree_ * ( degree_ + 1 ) / 2;
+        const int numberOfOrders_ = degree_ + 1;
+
+        const Eigen::Map< const Eigen::ArrayXd > legendreFunctions_(
+                    workBuffers.legendreFunctions.data( ) + offset_, numberOfOrders_ );
+        const Eigen::Map< const Eigen::ArrayXd > cosineCoefficients_(
+                    packedCosineCoefficients_.data( ) + offset_, numberOfOrders_ );
+        const Eigen::Map< const Eigen::ArrayXd > sineCoefficients_(
+                    packedSineCoefficients_.data( ) + offset_, numberOfOrders_ );
+
+        workBuffers.harmonicTerms.head( numberOfOrders_ )
+                = cosineCoefficients_ * workBuffers.cosineTerms.head( numberOfOrders_ )
+                + sineCoefficients_ * workBuffers.sineTerms.head( numberOfOrders_ );
+
+        // The factor of the radial term is n + m + 1.
+        radialSum_ += radiusRatioPower_
+                * ( ( orders_.head( numberOfOrders_ ) + ( degree_ + 1.0 ) ) * legendreFunctions_
+                    * workBuffers.harmonicTerms.head( numberOfOrders_ ) ).sum( );
+
+        // The derivative of Qnm is proportional to Qn,m+1, which is zero for m = n.
+        latitudinalSum_ += radiusRatioPower_
+                * ( derivativeFactors_.segment( offset_, degree_ )
+                    * legendreFunctions_.tail( degree_ )
+                    * workBuffers.harmonicTerms.head( degree_ ) ).sum( );
+
+        // The derivative of ( x + i y )^m is m ( x + i y )^( m - 1 ), which is zero for m = 0.
+        const Eigen::Map< const Eigen::ArrayXd > previousCosineTerms_(
+                    workBuffers.cosineTerms.data( ), degree_ );
+        const Eigen::Map< const Eigen::ArrayXd > previousSineTerms_(
+                    workBuffers.sineTerms.data( ), degree_ );
+        longitudinalSumX_ += radiusRatioPower_
+                * ( orders_.segment( 1, degree_ ) * legendreFunctions_.tail( degree_ )
+                    * ( cosineCoefficients_.tail( degree_ ) * previousCosineTerms_
+                        + sineCoefficients_.tail( degree_ ) * previousSineTerms_ ) ).sum( );
+        longitudinalSumY_ += radiusRatioPower_
+                * ( orders_.segment( 1, degree_ ) * legendreFunctions_.tail( degree_ )
+                    * ( sineCoefficients_.tail( degree_ ) * previousCosineTerms_
+                        - cosineCoefficients_.tail( degree_ ) * previousSineTerms_ ) ).sum( );
+
+        radiusRatioPower_ *= radiusRatio_;
+    }
+
+    // Gradient of t = z / r, multiplied by r.
+    const Eigen::Vector3d scaledLatitudeGradient_(
+                -sineOfLatitude_ * unitPosition_.x( ), -sineOfLatitude_ * unitPosition_.y( ),
+                1.0 - sineOfLatitude_ * sineOfLatitude_ );
+
+    return gravitationalParameter_ / ( radius_ * radius_ )
+            * ( -radialSum_ * unitPosition_ + latitudinalSum_ * scaledLatitudeGradient_
+                + Eigen::Vector3d( longitudinalSumX_, longitudinalSumY_, 0.0 ) );
+}
+
+//! Get work buffers of current thread.
+SphericalHarmonicWorkBuffers& SphericalHarmonicGravityField::getWorkBuffers( ) const
+{
+    if ( workBuffers_.get( ) == 0 )
+    {
+        workBuffers_.reset( new SphericalHarmonicWorkBuffers( truncationDegree_ ) );
+    }
+    return *workBuffers_;
+}
+
+//! Compute Legendre functions and harmonic terms.
+void SphericalHarmonicGravityField::computeLegendreFunctionsAndHarmonicTerms(
+        const Eigen::Vector3d& bodyFixedPosition,
+        SphericalHarmonicWorkBuffers& workBuffers ) const
+{
+    const Eigen::Vector3d unitPosition_ = bodyFixedPosition.normalized( );
+    const double sineOfLatitude_ = unitPosition_.z( );
+
+    // Multiple-angle recurrences for the terms
+    // cos^m phi ( cos m lambda + i sin m lambda ) = ( ( x + i y ) / r )^m.
+    workBuffers.cosineTerms( 0 ) = 1.0;
+    workBuffers.sineTerms( 0 ) = 0.0;
+    for ( int order_ = 1; order_ <= truncationDegree_; order_++ )
+    {
+        workBuffers.cosineTerms( order_ )
+                = unitPosition_.x( ) * workBuffers.cosineTerms( order_ - 1 )
+                - unitPosition_.y( ) * workBuffers.sineTerms( order_ - 1 );
+        workBuffers.sineTerms( order_ )
+                = unitPosition_.x( ) * workBuffers.sineTerms( order_ - 1 )
+                + unitPosition_.y( ) * workBuffers.cosineTerms( order_ - 1 );
+    }
+
+    // Recursions of the Legendre functions divided by cos^m phi over degree. The functions of
+    // all orders m < n - 1 of a degree are computed at once from those of the two previous
+    // degrees, followed by the functions of order n - 1 and the sectorial function.
+    Eigen::ArrayXd& legendreFunctions_ = workBuffers.legendreFunctions;
+    legendreFunctions_( 0 ) = 1.0;
+    for ( int degree_ = 1; degree_ <= truncationDegree_; degree_++ )
+    {
+        const int offset_ = degree_ * ( degree_ + 1 ) / 2;
+        const int previousOffset_ = offset_ - degree_;
+
+        if ( degree_ > 1 )
+        {
+            const int secondPreviousOffset_ = previousOffset_ - degree_ + 1;
+            legendreFunctions_.segment( offset_, degree_ - 1 )
+                    = sineOfLatitude_ * firstRecursionCoefficients_.segment( offset_, degree_ - 1 )
+                    * legendreFunctions_.segment( previousOffset_, degree_ - 1 )
+                    - secondRecursionCoefficients_.segment( offset_, degree_ - 1 )
+                    * legendreFunctions_.segment( secondPreviousOffset_, degree_ - 1 );
+        }
+
+        legendreFunctions_( offset_ + degree_ - 1 ) = sineOfLatitude_
+                * firstRecursionCoefficients_( offset_ + degree_ - 1 )
+                * legendreFunctions_( previousOffset_ + degree_ - 1 );
+        legendreFunctions_( offset_ + degree_ ) = firstRecursionCoefficients_( offset_ + degree_ )
+                * legendreFunctions_( previousOffset_ + degree_ - 1 );
+    }
+}
+
+} // namespace gravitation
+} // namespace tudat
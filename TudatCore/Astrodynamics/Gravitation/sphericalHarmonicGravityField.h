@@ -0,0 +1,254 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Holmes, S.A., Featherstone, W.E. A unified approach to the Clenshaw summation and the
+ *          recursive computation of very high degree and order normalised associated Legendre
+ *          functions, Journal of Geodesy, 76, 279-299, 2002.
+ *      Montenbruck, O., Gill, E. Satellite Orbits, Springer, 2000.
+ *      Heiskanen, W.A., Moritz, H. Physical Geodesy, W.H. Freeman and Company, 1967.
+ *
+ *    Notes
+ *      The gravitational potential is expanded in fully normalized spherical harmonics, without
+ *      Condon-Shortley phase, as is customary in geodesy:
+ *          U = mu / r sum_n ( R / r )^n sum_m Pnm( sin phi ) ( Cnm cos m lambda
+ *                                                            + Snm sin m lambda )
+ *      The associated Legendre functions are evaluated divided by cos^m phi, and the trigonometric
+ *      functions multiplied by cos^m phi, which follow from multiple-angle recurrences on x / r
+ *      and y / r. As a result, no trigonometric functions are evaluated, and the acceleration is
+ *      computed directly in Cartesian coordinates without singularities at the poles.
+ *
+ *      Positions and accelerations are expressed in the body-fixed frame of the central body; the
+ *      rotation to and from an inertial frame is left to the caller. The central term C00 is
+ *      included in the potential, such that the point-mass acceleration is obtained for a field
+ *      of degree zero; it can be set to zero to obtain only the perturbation.
+ *
+ */
+
+#ifndef TUDAT_CORE_SPHERICAL_HARMONIC_GRAVITY_FIELD_H
+#define TUDAT_CORE_SPHERICAL_HARMONIC_GRAVITY_FIELD_H
+
+#include <string>
+
+#include <boost/thread/tss.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Read spherical harmonic gravity field coefficients from file.
+/*!
+ * Reads fully normalized spherical harmonic gravity field coefficients from a text file, using
+ * the matrix text file reader. Each line of the file contains the degree, order, cosine
+ * coefficient and sine coefficient, optionally followed by further columns (e.g., standard
+ * deviations), which are ignored. Lines starting with '%' or '#' are skipped. Coefficients of a
+ * degree higher than the maximum degree are ignored, and coefficients that are not in the file
+ * are set to zero, except the central term C00, which is set to one. An error is thrown if the
+ * file has fewer than four columns, or contains an invalid degree or order.
+ * \param filePath Path to coefficient file.
+ * \param maximumDegree Maximum degree of coefficients to read.
+ * \param cosineCoefficients Matrix in which the cosine coefficients are stored, with the degree
+ *          as row index and the order as column index.
+ * \param sineCoefficients Matrix in which the sine coefficients are stored, with the degree as
+ *          row index and the order as column index.
+ */
+void readSphericalHarmonicGravityFieldCoefficients( const std::string& filePath,
+                                                    const int maximumDegree,
+                                                    Eigen::MatrixXd& cosineCoefficients,
+                                                    Eigen::MatrixXd& sineCoefficients );
+
+//! Work buffers for evaluation of spherical harmonic gravity field.
+struct SphericalHarmonicWorkBuffers;
+
+//! Spherical harmonic gravity field.
+/*!
+ * Gravity field of a central body, expanded in fully normalized spherical harmonics up to a
+ * given truncation degree (Heiskanen and Moritz, 1967). The normalized associated Legendre
+ * functions are computed with the standard forward column recursions (Holmes and Featherstone,
+ * 2002), of which the coefficients are precomputed on construction. The recursions are
+ * evaluated for all orders of a degree at once, such that they, and the summation of the
+ * series, are vectorized over order. The work buffers of the recursions are allocated once per
+ * thread that evaluates the field, and reused for all subsequent evaluations by that thread,
+ * such that the field can be evaluated concurrently by multiple threads.
+ */
+class SphericalHarmonicGravityField
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking the gravity field parameters and the fully normalized
+     * coefficients. An error is thrown if the coefficient matrices are not square and of equal
+     * size, or if the truncation degree exceeds their maximum degree.
+     * \param gravitationalParameter Gravitational parameter of central body.              [m^3/s^2]
+     * \param referenceRadius Reference radius of the spherical harmonic expansion.           [m]
+     * \param cosineCoefficients Fully normalized cosine coefficients, with the degree as row
+     *          index and the order as column index.                                           [-]
+     * \param sineCoefficients Fully normalized sine coefficients, with the degree as row index
+     *          and the order as column index.                                                 [-]
+     * \param truncationDegree Maximum degree and order used in the evaluation. If negative, the
+     *          maximum degree of the coefficient matrices is used.
+     */
+    SphericalHarmonicGravityField( const double gravitationalParameter,
+                                   const double referenceRadius,
+                                   const Eigen::MatrixXd& cosineCoefficients,
+                                   const Eigen::MatrixXd& sineCoefficients,
+                                   const int truncationDegree = -1 );
+
+    //! Default destructor.
+    ~SphericalHarmonicGravityField( );
+
+    //! Compute gravitational potential.
+    /*!
+     * Computes the gravitational potential at a given position.
+     * \param bodyFixedPosition Position in body-fixed frame.                                   [m]
+     * \return Gravitational potential (positive).                                      [m^2/s^2]
+     */
+    double computePotential( const Eigen::Vector3d& bodyFixedPosition ) const;
+
+    //! Compute gravitational acceleration.
+    /*!
+     * Computes the gravitational acceleration, i.e., the gradient of the potential, at a given
+     * position.
+     * \param bodyFixedPosition Position in body-fixed frame.                                   [m]
+     * \return Gravitational acceleration in body-fixed frame.                              [m/s^2]
+     */
+    Eigen::Vector3d computeAcceleration( const Eigen::Vector3d& bodyFixedPosition ) const;
+
+    //! Compute gravitational accelerations at multiple positions.
+    /*!
+     * Computes the gravitational accelerations at a set of positions, which are divided over
+     * multiple threads. An error is thrown if the positions do not have three rows.
+     * \param bodyFixedPositions Matrix of positions in body-fixed frame, with one position per
+     *          column (3 x N).                                                                 [m]
+     * \param accelerations Matrix in which the accelerations in the body-fixed frame are stored
+     *          (3 x N). If the matrix is preallocated with the correct size, no memory is
+     *          allocated; otherwise it is resized.                                         [m/s^2]
+     * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware
+     *          threads is used.
+     */
+    void computeAccelerations( const Eigen::MatrixXd& bodyFixedPositions,
+                               Eigen::MatrixXd& accelerations,
+                               const unsigned int numberOfThreads = 0 ) const;
+
+    //! Get gravitational parameter.
+    /*!
+     * Returns the gravitational parameter of the central body.
+     * \return Gravitational parameter.                                                 [m^3/s^2]
+     */
+    double getGravitationalParameter( ) const { return gravitationalParameter_; }
+
+    //! Get reference radius.
+    /*!
+     * Returns the reference radius of the spherical harmonic expansion.
+     * \return Reference radius.                                                                [m]
+     */
+    double getReferenceRadius( ) const { return referenceRadius_; }
+
+    //! Get truncation degree.
+    /*!
+     * Returns the maximum degree and order used in the evaluation.
+     * \return Truncation degree.
+     */
+    int getTruncationDegree( ) const { return truncationDegree_; }
+
+    //! Compute gravitational acceleration using given work buffers.
+    /*!
+     * Computes the gravitational acceleration at a given position, using the given work buffers
+     * for the recursions. This function is used by the single- and multi-position evaluations.
+     * \param bodyFixedPosition Position in body-fixed frame.                                   [m]
+     * \param workBuffers Work buffers, sized for the truncation degree.
+     * \return Gravitational acceleration in body-fixed frame.                              [m/s^2]
+     */
+    Eigen::Vector3d computeAcceleration( const Eigen::Vector3d& bodyFixedPosition,
+                                         SphericalHarmonicWorkBuffers& workBuffers ) const;
+
+private:
+
+    //! Copy constructor, not implemented, since the per-thread work buffers cannot be copied.
+    SphericalHarmonicGravityField( const SphericalHarmonicGravityField& );
+
+    //! Assignment operator, not implemented, since the per-thread work buffers cannot be copied.
+    SphericalHarmonicGravityField& operator=( const SphericalHarmonicGravityField& );
+
+    //! Get work buffers of current thread.
+    /*!
+     * Returns the work buffers of the current thread, which are allocated on first use.
+     * \return Work buffers of current thread.
+     */
+    SphericalHarmonicWorkBuffers& getWorkBuffers( ) const;
+
+    //! Compute Legendre functions and harmonic terms.
+    /*!
+     * Computes the normalized associated Legendre functions divided by cos^m phi, the cosine and
+     * sine terms multiplied by cos^m phi and the powers of the ratio of reference radius to
+     * radius at a given position, and stores them in the work buffers.
+     * \param bodyFixedPosition Position in body-fixed frame.                                   [m]
+     * \param workBuffers Work buffers, in which the results are stored.
+     */
+    void computeLegendreFunctionsAndHarmonicTerms( const Eigen::Vector3d& bodyFixedPosition,
+                                                   SphericalHarmonicWorkBuffers& workBuffers )
+    const;
+
+    //! Gravitational parameter of central body.
+    const double gravitationalParameter_;
+
+    //! Reference radius of spherical harmonic expansion.
+    const double referenceRadius_;
+
+    //! Maximum degree and order used in evaluation.
+    int truncationDegree_;
+
+    //! Orders, from zero to the truncation degree.
+    Eigen::ArrayXd orders_;
+
+    //! Cosine coefficients, packed per degree for increasing order.
+    Eigen::ArrayXd packedCosineCoefficients_;
+
+    //! Sine coefficients, packed per degree for increasing order.
+    Eigen::ArrayXd packedSineCoefficients_;
+
+    //! Coefficients of the Legendre function of one degree lower in the recursions.
+    Eigen::ArrayXd firstRecursionCoefficients_;
+
+    //! Coefficients of the Legendre function of two degrees lower in the recursions.
+    Eigen::ArrayXd secondRecursionCoefficients_;
+
+    //! Factors relating the derivative of a Legendre function to the function of next order.
+    Eigen::ArrayXd derivativeFactors_;
+
+    //! Work buffers, one set per thread.
+    mutable boost::thread_specific_ptr< SphericalHarmonicWorkBuffers > workBuffers_;
+};
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_CORE_SPHERICAL_HARMONIC_GRAVITY_FIELD_H
@@ -0,0 +1,127 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics, Revised
+ *          Edition, AIAA Education Series, 1999.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Compute third-body perturbing acceleration.
+Eigen::Vector3d computeThirdBodyPerturbingAcceleration(
+        const double thirdBodyGravitationalParameter, const Eigen::Vector3d& thirdBodyPosition,
+        const Eigen::Vector3d& position )
+{
+    const double q_ = position.dot( position - 2.0 * thirdBodyPosition )
+            / thirdBodyPosition.squaredNorm( );
+    const double onePlusQ_ = 1.0 + q_;
+    const double f_ = q_ * ( 3.0 + 3.0 * q_ + q_ * q_ )
+            / ( 1.0 + onePlusQ_ * std::sqrt( onePlusQ_ ) );
+
+    const double distance_ = ( position - thirdBodyPosition ).norm( );
+
+    return -thirdBodyGravitationalParameter / ( distance_ * distance_ * distance_ )
+            * ( position + f_ * thirdBodyPosition );
+}
+
+//! Compute third-body perturbing accelerations at multiple epochs.
+void computeThirdBodyPerturbingAccelerations( const double thirdBodyGravitationalParameter,
+                                              const Eigen::MatrixXd& thirdBodyPositions,
+                                              const Eigen::MatrixXd& positions,
+                                              Eigen::MatrixXd& accelerations )
+{
+    if ( positions.rows( ) != 3 || thirdBodyPositions.rows( ) != 3
+         || positions.cols( ) != thirdBodyPositions.cols( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Position matrices are not of equal size, or do not "
+                                            "have three rows." ) ) );
+    }
+
+    const Eigen::ArrayXXd q_ = ( positions.array( ) * ( positions - 2.0 * thirdBodyPositions )
+                                 .array( ) ).colwise( ).sum( )
+            / thirdBodyPositions.colwise( ).squaredNorm( ).array( );
+    const Eigen::ArrayXXd f_ = q_ * ( 3.0 + 3.0 * q_ + q_.square( ) )
+            / ( 1.0 + ( 1.0 + q_ ) * ( 1.0 + q_ ).sqrt( ) );
+    const Eigen::ArrayXXd scaledInverseCubedDistances_ = -thirdBodyGravitationalParameter
+            * ( positions - thirdBodyPositions ).colwise( ).norm( ).array( ).cube( ).inverse( );
+
+    accelerations.resize( 3, positions.cols( ) );
+    accelerations.array( ) = ( positions.array( ) + thirdBodyPositions.array( ).rowwise( )
+                               * f_.row( 0 ) ).rowwise( ) * scaledInverseCubedDistances_.row( 0 );
+}
+
+//! Default constructor.
+ThirdBodyPerturbation::ThirdBodyPerturbation(
+        const std::vector< double >& thirdBodyGravitationalParameters,
+        const std::vector< PositionFunction >& thirdBodyPositionFunctions )
+    : thirdBodyGravitationalParameters_( thirdBodyGravitationalParameters ),
+      thirdBodyPositionFunctions_( thirdBodyPositionFunctions )
+{
+    if ( thirdBodyGravitationalParameters_.size( ) != thirdBodyPositionFunctions_.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Numbers of third-body gravitational parameters and "
+                                            "position functions are not equal." ) ) );
+    }
+}
+
+//! Compute perturbing acceleration.
+Eigen::Vector3d ThirdBodyPerturbation::computePerturbingAcceleration(
+        const double time,
+        const basic_astrodynamics::orbital_element_conversions::Vector6d& cartesianState ) const
+{
+    const Eigen::Vector3d position_ = cartesianState.head< 3 >( );
+
+    Eigen::Vector3d perturbingAcceleration_ = Eigen::Vector3d::Zero( );
+    for ( unsigned int i = 0; i < thirdBodyGravitationalParameters_.size( ); i++ )
+    {
+        perturbingAcceleration_ += computeThirdBodyPerturbingAcceleration(
+                    thirdBodyGravitationalParameters_[ i ],
+                    thirdBodyPositionFunctions_[ i ]( time ), position_ );
+    }
+    return perturbingAcceleration_;
+}
+
+} // namespace gravitation
+} // namespace tudat
@@ -0,0 +1,158 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics, Revised
+ *          Edition, AIAA Education Series, 1999.
+ *
+ *    Notes
+ *      The perturbing acceleration of a third body on a body orbiting a central body is the
+ *      difference between the accelerations of the third body on the orbiting body and on the
+ *      central body. If the orbiting body is much closer to the central body than the third
+ *      body, e.g., for the solar perturbation on an Earth satellite, both accelerations are
+ *      nearly equal, such that their difference suffers from cancellation. This is avoided by
+ *      writing the difference in terms of the function f( q ) of Battin (1999), which is
+ *      evaluated without cancellation for small q.
+ *
+ */
+
+#ifndef TUDAT_CORE_THIRD_BODY_PERTURBATION_H
+#define TUDAT_CORE_THIRD_BODY_PERTURBATION_H
+
+#include <vector>
+
+#include <boost/function.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Compute third-body perturbing acceleration.
+/*!
+ * Computes the perturbing acceleration of a third body on a body orbiting a central body, i.e.,
+ * the acceleration of the orbiting body relative to the central body due to the third body
+ * (Battin, 1999):
+ *      a = -mu / d^3 ( r + f( q ) s ),
+ * with r the position of the orbiting body, s the position of the third body, both with respect
+ * to the central body, d = r - s, q = r . ( r - 2 s ) / s^2, and
+ *      f( q ) = q ( 3 + 3 q + q^2 ) / ( 1 + ( 1 + q )^( 3 / 2 ) ).
+ * This is equal to mu ( ( s - r ) / d^3 - s / s^3 ), but without loss of precision due to
+ * cancellation when r is much smaller than s.
+ * \param thirdBodyGravitationalParameter Gravitational parameter of third body.         [m^3/s^2]
+ * \param thirdBodyPosition Position of third body with respect to central body.               [m]
+ * \param position Position of orbiting body with respect to central body.                     [m]
+ * \return Perturbing acceleration of orbiting body relative to central body.              [m/s^2]
+ */
+Eigen::Vector3d computeThirdBodyPerturbingAcceleration(
+        const double thirdBodyGravitationalParameter, const Eigen::Vector3d& thirdBodyPosition,
+        const Eigen::Vector3d& position );
+
+//! Compute third-body perturbing accelerations at multiple epochs.
+/*!
+ * Computes the perturbing accelerations of a third body for a set of pairs of positions of the
+ * third body and the orbiting body, e.g., at the epochs of a trajectory, using the same
+ * equations as computeThirdBodyPerturbingAcceleration(), evaluated with vectorized array
+ * expressions over all pairs. An error is thrown if the position matrices are not of equal size
+ * or do not have three rows.
+ * \param thirdBodyGravitationalParameter Gravitational parameter of third body.         [m^3/s^2]
+ * \param thirdBodyPositions Matrix of positions of third body with respect to central body,
+ *          with one epoch per column (3 x N).                                                  [m]
+ * \param positions Matrix of positions of orbiting body with respect to central body, with one
+ *          epoch per column (3 x N).                                                           [m]
+ * \param accelerations Matrix in which the perturbing accelerations are stored (3 x N). If the
+ *          matrix is preallocated with the correct size, it is not resized.               [m/s^2]
+ */
+void computeThirdBodyPerturbingAccelerations( const double thirdBodyGravitationalParameter,
+                                              const Eigen::MatrixXd& thirdBodyPositions,
+                                              const Eigen::MatrixXd& positions,
+                                              Eigen::MatrixXd& accelerations );
+
+//! Third-body perturbation.
+/*!
+ * Perturbing acceleration of a set of third bodies on a body orbiting a central body, of which
+ * the positions with respect to the central body are given as functions of time, e.g., bound
+ * tabulated ephemerides. The computePerturbingAcceleration() function can be bound to the
+ * perturbing acceleration function of the propagators, e.g.:
+ * \code
+ * ModifiedEquinoctialStateDerivative stateDerivative(
+ *     earthGravitationalParameter,
+ *     boost::bind( &ThirdBodyPerturbation::computePerturbingAcceleration,
+ *                  &thirdBodyPerturbation, _1, _2 ) );
+ * \endcode
+ */
+class ThirdBodyPerturbation
+{
+public:
+
+    //! Typedef for position function.
+    /*!
+     * Typedef for function returning the position of a third body with respect to the central
+     * body, given the time.
+     */
+    typedef boost::function< Eigen::Vector3d( const double ) > PositionFunction;
+
+    //! Default constructor.
+    /*!
+     * Default constructor. An error is thrown if the number of gravitational parameters and
+     * position functions are not equal.
+     * \param thirdBodyGravitationalParameters Gravitational parameters of third bodies. [m^3/s^2]
+     * \param thirdBodyPositionFunctions Functions returning the positions of the third bodies
+     *          with respect to the central body.
+     */
+    ThirdBodyPerturbation( const std::vector< double >& thirdBodyGravitationalParameters,
+                           const std::vector< PositionFunction >& thirdBodyPositionFunctions );
+
+    //! Compute perturbing acceleration.
+    /*!
+     * Computes the sum of the perturbing accelerations of the third bodies.
+     * \param time Current time.                                                                [s]
+     * \param cartesianState Cartesian state of orbiting body with respect to central body.
+     * \return Perturbing acceleration.                                                     [m/s^2]
+     */
+    Eigen::Vector3d computePerturbingAcceleration(
+            const double time,
+            const basic_astrodynamics::orbital_element_conversions::Vector6d& cartesianState )
+    const;
+
+private:
+
+    //! Gravitational parameters of third bodies.
+    const std::vector< double > thirdBodyGravitationalParameters_;
+
+    //! Functions returning the positions of the third bodies with respect to the central body.
+    const std::vector< PositionFunction > thirdBodyPositionFunctions_;
+};
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_CORE_THIRD_BODY_PERTURBATION_H
@@ -0,0 +1,394 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/MissionSegments/lambertRoutines.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+
+//! Compute time of flight between two true anomalies.
+/*!
+ * Computes the time of flight between two true anomalies on a Kepler orbit, using the anomaly
+ * conversions of orbital_element_conversions.
+ * \param keplerianElements Keplerian elements of orbit.
+ * \param gravitationalParameter Gravitational parameter of central body.
+ * \param departureTrueAnomaly True anomaly at departure.
+ * \param arrivalTrueAnomaly True anomaly at arrival.
+ * \return Time of flight.
+ */
+double computeTimeOfFlightBetweenTrueAnomalies( const Eigen::VectorXd& keplerianElements,
+                                                const double gravitationalParameter,
+                                                const double departureTrueAnomaly,
+                                                const double arrivalTrueAnomaly )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    const double eccentricity = keplerianElements( eccentricityIndex );
+    double meanAnomalyChange
+            = convertEccentricAnomalyToMeanAnomaly(
+                convertTrueAnomalyToEccentricAnomaly( arrivalTrueAnomaly, eccentricity ),
+                eccentricity )
+            - convertEccentricAnomalyToMeanAnomaly(
+                convertTrueAnomalyToEccentricAnomaly( departureTrueAnomaly, eccentricity ),
+                eccentricity );
+
+    if ( eccentricity < 1.0 && meanAnomalyChange < 0.0 )
+    {
+        meanAnomalyChange += 2.0 * PI;
+    }
+
+    return convertMeanAnomalyChangeToElapsedTime(
+                meanAnomalyChange, gravitationalParameter,
+                keplerianElements( semiMajorAxisIndex ) );
+}
+
+//! Compute arrival position of Kepler orbit through departure state.
+/*!
+ * Computes the arrival position of the Kepler orbit through a given departure state, after a
+ * given time of flight.
+ * \param departurePosition Position at departure.
+ * \param departureVelocity Velocity at departure.
+ * \param timeOfFlight Time of flight.
+ * \param gravitationalParameter Gravitational parameter of central body.
+ * \return Position at arrival.
+ */
+Eigen::Vector3d propagateDepartureState( const Eigen::Vector3d& departurePosition,
+                                         const Eigen::Vector3d& departureVelocity,
+                                         const double timeOfFlight,
+                                         const double gravitationalParameter )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    Vector6d departureState;
+    departureState << departurePosition, departureVelocity;
+
+    const propagators::KeplerOrbit orbit(
+                convertCartesianToKeplerianElements( departureState, gravitationalParameter ),
+                gravitationalParameter );
+    return orbit.getStateAtTime( timeOfFlight ).segment( 0, 3 );
+}
+
+BOOST_AUTO_TEST_SUITE( test_lambert_routines )
+
+//! Test if Lambert solver reproduces the example of (Vallado, 2004).
+BOOST_AUTO_TEST_CASE( testLambertProblemValladoExample )
+{
+    // Example 7-5 of (Vallado, 2004), converted to SI units.
+    const double earthGravitationalParameter = 3.986004418e14;
+    const Eigen::Vector3d departurePosition( 15945.34e3, 0.0, 0.0 );
+    const Eigen::Vector3d arrivalPosition( 12214.83899e3, 10249.46731e3, 0.0 );
+    const double timeOfFlight = 76.0 * 60.0;
+
+    const Eigen::Vector3d expectedDepartureVelocity( 2058.913, 2915.965, 0.0 );
+    const Eigen::Vector3d expectedArrivalVelocity( -3451.565, 910.315, 0.0 );
+
+    // Solve Lambert problem.
+    Eigen::Vector3d departureVelocity, arrivalVelocity;
+    BOOST_CHECK( mission_segments::solveLambertProblemIzzo(
+                     departurePosition, arrivalPosition, timeOfFlight,
+                     earthGravitationalParameter, departureVelocity, arrivalVelocity ) );
+
+    // Check if velocities match to the precision given in (Vallado, 2004).
+    BOOST_CHECK_SMALL( ( departureVelocity - expectedDepartureVelocity ).norm( ), 2.0e-3 );
+    BOOST_CHECK_SMALL( ( arrivalVelocity - expectedArrivalVelocity ).norm( ), 2.0e-3 );
+}
+
+//! Test if zero-revolution Lambert solutions match Kepler orbits.
+BOOST_AUTO_TEST_CASE( testZeroRevolutionLambertProblems )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set orbits, given as Keplerian elements, departure and arrival true anomaly, and retrograde
+    // flag. The set includes transfer angles smaller and larger than pi, high-eccentricity and
+    // hyperbolic orbits, and a retrograde orbit.
+    const unsigned int numberOfOrbits = 6;
+    Eigen::MatrixXd orbits( 9, numberOfOrbits );
+    orbits.col( 0 ) << 7.0e6, 0.1, 30.0, 40.0, 80.0, 0.0, 10.0, 120.0, 0.0;
+    orbits.col( 1 ) << 2.5e7, 0.6, 60.0, 120.0, 10.0, 0.0, -30.0, 250.0, 0.0;
+    orbits.col( 2 ) << 4.2e7, 0.9, 10.0, 300.0, 200.0, 0.0, 170.0, 190.0, 0.0;
+    orbits.col( 3 ) << -2.0e7, 1.5, 20.0, 0.0, 45.0, 0.0, -60.0, 80.0, 0.0;
+    orbits.col( 4 ) << -1.0e8, 1.05, 5.0, 70.0, 330.0, 0.0, -10.0, 30.0, 0.0;
+    orbits.col( 5 ) << 1.2e7, 0.2, 150.0, 15.0, 100.0, 0.0, 0.0, 200.0, 1.0;
+
+    for ( unsigned int i = 0; i < numberOfOrbits; i++ )
+    {
+        // Compute departure and arrival states and time of flight.
+        Eigen::VectorXd keplerianElements = orbits.col( i ).segment( 0, 6 );
+        keplerianElements.segment( 2, 3 ) *= PI / 180.0;
+
+        const double departureTrueAnomaly = orbits( 6, i ) * PI / 180.0;
+        const double arrivalTrueAnomaly = orbits( 7, i ) * PI / 180.0;
+
+        keplerianElements( trueAnomalyIndex ) = departureTrueAnomaly;
+        const Eigen::VectorXd departureState = convertKeplerianToCartesianElements(
+                    keplerianElements, earthGravitationalParameter );
+
+        keplerianElements( trueAnomalyIndex ) = arrivalTrueAnomaly;
+        const Eigen::VectorXd arrivalState = convertKeplerianToCartesianElements(
+                    keplerianElements, earthGravitationalParameter );
+
+        const double timeOfFlight = computeTimeOfFlightBetweenTrueAnomalies(
+                    keplerianElements, earthGravitationalParameter, departureTrueAnomaly,
+                    arrivalTrueAnomaly );
+
+        // Solve Lambert problem.
+        Eigen::Vector3d departureVelocity, arrivalVelocity;
+        BOOST_CHECK( mission_segments::solveLambertProblemIzzo(
+                         departureState.segment( 0, 3 ), arrivalState.segment( 0, 3 ),
+                         timeOfFlight, earthGravitationalParameter, departureVelocity,
+                         arrivalVelocity, orbits( 8, i ) > 0.5 ) );
+
+        // Check if velocities match those of the Kepler orbit.
+        BOOST_CHECK_SMALL( ( departureVelocity - departureState.segment( 3, 3 ) ).norm( ),
+                           1.0e-10 * departureState.segment( 3, 3 ).norm( ) );
+        BOOST_CHECK_SMALL( ( arrivalVelocity - arrivalState.segment( 3, 3 ) ).norm( ),
+                           1.0e-10 * arrivalState.segment( 3, 3 ).norm( ) );
+    }
+}
+
+//! Test if multi-revolution Lambert solutions are computed correctly.
+BOOST_AUTO_TEST_CASE( testMultiRevolutionLambertProblems )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set orbit, and compute departure and arrival states after more than one revolution.
+    Eigen::VectorXd keplerianElements( 6 );
+    keplerianElements << 1.0e7, 0.3, 0.4, 1.0, 2.0, 20.0 * PI / 180.0;
+    const double arrivalTrueAnomaly = 150.0 * PI / 180.0;
+
+    const Eigen::VectorXd departureState = convertKeplerianToCartesianElements(
+                keplerianElements, earthGravitationalParameter );
+    const double timeOfFlight = computeTimeOfFlightBetweenTrueAnomalies(
+                keplerianElements, earthGravitationalParameter,
+                keplerianElements( trueAnomalyIndex ), arrivalTrueAnomaly )
+            + 2.0 * PI * std::sqrt( std::pow( keplerianElements( semiMajorAxisIndex ), 3.0 )
+                                    / earthGravitationalParameter );
+
+    keplerianElements( trueAnomalyIndex ) = arrivalTrueAnomaly;
+    const Eigen::VectorXd arrivalState = convertKeplerianToCartesianElements(
+                keplerianElements, earthGravitationalParameter );
+
+    const Eigen::Vector3d departurePosition = departureState.segment( 0, 3 );
+    const Eigen::Vector3d arrivalPosition = arrivalState.segment( 0, 3 );
+
+    // Check if maximum number of revolutions is consistent with existence of solutions.
+    const unsigned int maximumNumberOfRevolutions
+            = mission_segments::computeMaximumNumberOfLambertRevolutions(
+                departurePosition, arrivalPosition, timeOfFlight, earthGravitationalParameter );
+    BOOST_CHECK_EQUAL( maximumNumberOfRevolutions, 1u );
+
+    Eigen::Vector3d departureVelocity, arrivalVelocity;
+    BOOST_CHECK( !mission_segments::solveLambertProblemIzzo(
+                     departurePosition, arrivalPosition, timeOfFlight,
+                     earthGravitationalParameter, departureVelocity, arrivalVelocity, false,
+                     maximumNumberOfRevolutions + 1 ) );
+    BOOST_CHECK( departureVelocity.hasNaN( ) && arrivalVelocity.hasNaN( ) );
+
+    // Solve for both branches, and check if both solutions reach the arrival position, and if one
+    // of them is the original orbit.
+    double minimumVelocityError = TUDAT_NAN;
+    for ( unsigned int branch = 0; branch < 2; branch++ )
+    {
+        BOOST_CHECK( mission_segments::solveLambertProblemIzzo(
+                         departurePosition, arrivalPosition, timeOfFlight,
+                         earthGravitationalParameter, departureVelocity, arrivalVelocity, false,
+                         1, branch == 1 ) );
+
+        BOOST_CHECK_SMALL( ( propagateDepartureState( departurePosition, departureVelocity,
+                                                      timeOfFlight, earthGravitationalParameter )
+                             - arrivalPosition ).norm( ), 1.0e-9 * arrivalPosition.norm( ) );
+
+        const double velocityError
+                = ( departureVelocity - departureState.segment( 3, 3 ) ).norm( )
+                + ( arrivalVelocity - arrivalState.segment( 3, 3 ) ).norm( );
+        if ( branch == 0 || velocityError < minimumVelocityError )
+        {
+            minimumVelocityError = velocityError;
+        }
+    }
+
+    BOOST_CHECK_SMALL( minimumVelocityError, 1.0e-10 * departureState.segment( 3, 3 ).norm( ) );
+}
+
+//! Test if set of Lambert problems is solved consistently with single Lambert problems.
+BOOST_AUTO_TEST_CASE( testBatchLambertProblems )
+{
+    const double sunGravitationalParameter = 1.32712440018e20;
+    const double astronomicalUnit = 1.495978707e11;
+
+    // Set departure and arrival positions on two circular orbits, and times of flight.
+    const int numberOfProblems = 50;
+    Eigen::MatrixXd departurePositions( 3, numberOfProblems );
+    Eigen::MatrixXd arrivalPositions( 3, numberOfProblems );
+    Eigen::VectorXd timesOfFlight( numberOfProblems );
+
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        const double departureAngle = 0.1 * static_cast< double >( i );
+        const double arrivalAngle = 1.0 + 0.13 * static_cast< double >( i );
+        departurePositions.col( i ) << std::cos( departureAngle ), std::sin( departureAngle ),
+                0.01 * std::sin( 2.0 * departureAngle );
+        arrivalPositions.col( i ) << 1.52 * std::cos( arrivalAngle ),
+                1.52 * std::sin( arrivalAngle ), 0.0;
+        timesOfFlight( i ) = ( 100.0 + 5.0 * static_cast< double >( i ) ) * 86400.0;
+    }
+
+    departurePositions *= astronomicalUnit;
+    arrivalPositions *= astronomicalUnit;
+
+    // Solve Lambert problems one by one.
+    Eigen::MatrixXd expectedDepartureVelocities( 3, numberOfProblems );
+    Eigen::MatrixXd expectedArrivalVelocities( 3, numberOfProblems );
+    for ( int i = 0; i < numberOfProblems; i++ )
+    {
+        Eigen::Vector3d departureVelocity, arrivalVelocity;
+        mission_segments::solveLambertProblemIzzo(
+                    departurePositions.col( i ), arrivalPositions.col( i ), timesOfFlight( i ),
+                    sunGravitationalParameter, departureVelocity, arrivalVelocity );
+        expectedDepartureVelocities.col( i ) = departureVelocity;
+        expectedArrivalVelocities.col( i ) = arrivalVelocity;
+    }
+
+    // Solve set of Lambert problems using different numbers of threads, and check if results are
+    // identical.
+    for ( unsigned int numberOfThreads = 1; numberOfThreads <= 3; numberOfThreads++ )
+    {
+        Eigen::MatrixXd departureVelocities, arrivalVelocities;
+        mission_segments::solveLambertProblemsIzzo(
+                    departurePositions, arrivalPositions, timesOfFlight,
+                    sunGravitationalParameter, departureVelocities, arrivalVelocities, false, 0,
+                    false, numberOfThreads );
+
+        BOOST_CHECK_EQUAL( ( departureVelocities - expectedDepartureVelocities )
+                           .cwiseAbs( ).maxCoeff( ), 0.0 );
+        BOOST_CHECK_EQUAL( ( arrivalVelocities - expectedArrivalVelocities )
+                           .cwiseAbs( ).maxCoeff( ), 0.0 );
+    }
+
+    // Check if infeasible multi-revolution problems result in NaN velocities.
+    Eigen::MatrixXd departureVelocities, arrivalVelocities;
+    mission_segments::solveLambertProblemsIzzo(
+                departurePositions, arrivalPositions, timesOfFlight, sunGravitationalParameter,
+                departureVelocities, arrivalVelocities, false, 5 );
+    BOOST_CHECK( departureVelocities.hasNaN( ) && arrivalVelocities.hasNaN( ) );
+}
+
+//! Test if unsolvable problem in set of Lambert problems does not affect other problems.
+BOOST_AUTO_TEST_CASE( testBatchLambertProblemsWithCollinearPositions )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set three problems, of which the middle one is a transfer over 180 degrees.
+    Eigen::MatrixXd departurePositions( 3, 3 );
+    departurePositions << 7.0e6, 7.0e6, 7.0e6,
+            0.0, 0.0, 0.0,
+            0.0, 0.0, 0.0;
+    Eigen::MatrixXd arrivalPositions( 3, 3 );
+    arrivalPositions << 0.0, -8.0e6, 5.0e6,
+            8.0e6, 0.0, 6.0e6,
+            0.0, 0.0, 1.0e6;
+    const Eigen::VectorXd timesOfFlight = Eigen::Vector3d( 2400.0, 3600.0, 1800.0 );
+
+    Eigen::MatrixXd departureVelocities, arrivalVelocities;
+    mission_segments::solveLambertProblemsIzzo(
+                departurePositions, arrivalPositions, timesOfFlight, earthGravitationalParameter,
+                departureVelocities, arrivalVelocities );
+
+    // Check if velocities of collinear problem are NaN.
+    BOOST_CHECK( departureVelocities.col( 1 ).array( ).isNaN( ).all( ) );
+    BOOST_CHECK( arrivalVelocities.col( 1 ).array( ).isNaN( ).all( ) );
+
+    // Check if neighbouring problems are solved as single problems.
+    for ( int i = 0; i < 3; i += 2 )
+    {
+        Eigen::Vector3d departureVelocity, arrivalVelocity;
+        mission_segments::solveLambertProblemIzzo(
+                    departurePositions.col( i ), arrivalPositions.col( i ), timesOfFlight( i ),
+                    earthGravitationalParameter, departureVelocity, arrivalVelocity );
+        BOOST_CHECK( departureVelocities.col( i ) == departureVelocity );
+        BOOST_CHECK( arrivalVelocities.col( i ) == arrivalVelocity );
+    }
+}
+
+//! Test if errors are thrown for invalid Lambert problems.
+BOOST_AUTO_TEST_CASE( testInvalidLambertProblems )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+    const Eigen::Vector3d departurePosition( 7.0e6, 0.0, 0.0 );
+    Eigen::Vector3d departureVelocity, arrivalVelocity;
+
+    // Check if error is thrown for non-positive time of flight.
+    BOOST_CHECK_THROW( mission_segments::solveLambertProblemIzzo(
+                           departurePosition, Eigen::Vector3d( 0.0, 8.0e6, 0.0 ), 0.0,
+                           earthGravitationalParameter, departureVelocity, arrivalVelocity ),
+                       std::runtime_error );
+
+    // Check if error is thrown for collinear positions.
+    BOOST_CHECK_THROW( mission_segments::solveLambertProblemIzzo(
+                           departurePosition, Eigen::Vector3d( -8.0e6, 0.0, 0.0 ), 3600.0,
+                           earthGravitationalParameter, departureVelocity, arrivalVelocity ),
+                       std::runtime_error );
+
+    // Check if error is thrown for inconsistent sizes of set of Lambert problems.
+    Eigen::MatrixXd departureVelocities, arrivalVelocities;
+    BOOST_CHECK_THROW( mission_segments::solveLambertProblemsIzzo(
+                           Eigen::MatrixXd::Ones( 3, 4 ), Eigen::MatrixXd::Ones( 3, 4 ),
+                           Eigen::VectorXd::Ones( 3 ), earthGravitationalParameter,
+                           departureVelocities, arrivalVelocities ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
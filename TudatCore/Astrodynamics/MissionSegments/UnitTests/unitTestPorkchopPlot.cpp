@@ -0,0 +1,257 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Wakker, K. F. Astrodynamics I + II. Lecture Notes AE4-874, Delft University of Technology,
+ *          Delft, Netherlands.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/astrodynamicsFunctions.h"
+#include "TudatCore/Astrodynamics/MissionSegments/lambertRoutines.h"
+#include "TudatCore/Astrodynamics/MissionSegments/porkchopPlot.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+
+//! Create circular orbit around the Sun.
+/*!
+ * Creates a circular orbit around the Sun in the ecliptic, with the body on the x-axis at the
+ * epoch of the orbit.
+ * \param radius Radius of the orbit.
+ * \param gravitationalParameter Gravitational parameter of the Sun.
+ * \return Kepler orbit.
+ */
+propagators::KeplerOrbit createCircularOrbit( const double radius,
+                                              const double gravitationalParameter )
+{
+    Eigen::VectorXd keplerianElements = Eigen::VectorXd::Zero( 6 );
+    keplerianElements( 0 ) = radius;
+    return propagators::KeplerOrbit( keplerianElements, gravitationalParameter );
+}
+
+BOOST_AUTO_TEST_SUITE( test_porkchop_plot )
+
+//! Test if porkchop plot matches single Lambert problems, independent of threads and tiles.
+BOOST_AUTO_TEST_CASE( testPorkchopPlotConsistency )
+{
+    using basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+    const double sunGravitationalParameter = 1.32712440018e20;
+    const double astronomicalUnit = 1.495978707e11;
+    const double julianDay = 86400.0;
+
+    // Set inclined, eccentric orbit of arrival body, and circular orbit of departure body.
+    Eigen::VectorXd keplerianElements( 6 );
+    keplerianElements << 1.5 * astronomicalUnit, 0.1, 0.03, 5.0, 0.8, 1.0;
+    const propagators::KeplerOrbit departureOrbit
+            = createCircularOrbit( astronomicalUnit, sunGravitationalParameter );
+    const propagators::KeplerOrbit arrivalOrbit( keplerianElements, sunGravitationalParameter );
+
+    const mission_segments::BodyStateFunction departureBodyStateFunction
+            = boost::bind( &propagators::KeplerOrbit::getStateAtTime, &departureOrbit, _1 );
+    const mission_segments::BodyStateFunction arrivalBodyStateFunction
+            = boost::bind( &propagators::KeplerOrbit::getStateAtTime, &arrivalOrbit, _1 );
+
+    // Set epoch grids, such that some arrival epochs lie before departure epochs.
+    const Eigen::VectorXd departureEpochs
+            = Eigen::VectorXd::LinSpaced( 23, 0.0, 220.0 ) * julianDay;
+    const Eigen::VectorXd arrivalEpochs
+            = Eigen::VectorXd::LinSpaced( 31, 100.0, 500.0 ) * julianDay;
+
+    // Compute expected delta-v's by solving Lambert problems one by one.
+    Eigen::MatrixXd expectedDepartureDeltaVs( departureEpochs.rows( ), arrivalEpochs.rows( ) );
+    Eigen::MatrixXd expectedArrivalDeltaVs( departureEpochs.rows( ), arrivalEpochs.rows( ) );
+    for ( int i = 0; i < departureEpochs.rows( ); i++ )
+    {
+        const Vector6d departureState = departureBodyStateFunction( departureEpochs( i ) );
+        for ( int j = 0; j < arrivalEpochs.rows( ); j++ )
+        {
+            const Vector6d arrivalState = arrivalBodyStateFunction( arrivalEpochs( j ) );
+            const double timeOfFlight = arrivalEpochs( j ) - departureEpochs( i );
+            if ( timeOfFlight > 0.0 )
+            {
+                Eigen::Vector3d departureVelocity, arrivalVelocity;
+                mission_segments::solveLambertProblemIzzo(
+                            departureState.segment( 0, 3 ), arrivalState.segment( 0, 3 ),
+                            timeOfFlight, sunGravitationalParameter, departureVelocity,
+                            arrivalVelocity );
+                expectedDepartureDeltaVs( i, j )
+                        = ( departureVelocity - departureState.segment( 3, 3 ) ).norm( );
+                expectedArrivalDeltaVs( i, j )
+                        = ( arrivalState.segment( 3, 3 ) - arrivalVelocity ).norm( );
+            }
+        }
+    }
+
+    // Compute porkchop plot using different numbers of threads and tile sizes, including tiles
+    // that do not divide the grid, and check if results are identical.
+    const int tileSizes[ 3 ] = { 1, 7, 64 };
+    for ( unsigned int numberOfThreads = 1; numberOfThreads <= 3; numberOfThreads++ )
+    {
+        for ( unsigned int tileSizeIndex = 0; tileSizeIndex < 3; tileSizeIndex++ )
+        {
+            Eigen::MatrixXd departureDeltaVs, arrivalDeltaVs;
+            mission_segments::computePorkchopPlot(
+                        departureBodyStateFunction, arrivalBodyStateFunction, departureEpochs,
+                        arrivalEpochs, sunGravitationalParameter, departureDeltaVs,
+                        arrivalDeltaVs, numberOfThreads, tileSizes[ tileSizeIndex ] );
+
+            for ( int i = 0; i < departureEpochs.rows( ); i++ )
+            {
+                for ( int j = 0; j < arrivalEpochs.rows( ); j++ )
+                {
+                    if ( arrivalEpochs( j ) > departureEpochs( i ) )
+                    {
+                        BOOST_CHECK_EQUAL( departureDeltaVs( i, j ),
+                                           expectedDepartureDeltaVs( i, j ) );
+                        BOOST_CHECK_EQUAL( arrivalDeltaVs( i, j ),
+                                           expectedArrivalDeltaVs( i, j ) );
+                    }
+
+                    else
+                    {
+                        BOOST_CHECK( departureDeltaVs( i, j ) != departureDeltaVs( i, j ) );
+                        BOOST_CHECK( arrivalDeltaVs( i, j ) != arrivalDeltaVs( i, j ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+//! Test if minimum delta-v over synodic period approaches Hohmann transfer.
+BOOST_AUTO_TEST_CASE( testPorkchopPlotHohmannTransfer )
+{
+    const double sunGravitationalParameter = 1.32712440018e20;
+    const double astronomicalUnit = 1.495978707e11;
+    const double julianDay = 86400.0;
+
+    // Set circular, coplanar orbits of departure and arrival body.
+    const double departureRadius = astronomicalUnit;
+    const double arrivalRadius = 1.524 * astronomicalUnit;
+    const propagators::KeplerOrbit departureOrbit
+            = createCircularOrbit( departureRadius, sunGravitationalParameter );
+    const propagators::KeplerOrbit arrivalOrbit
+            = createCircularOrbit( arrivalRadius, sunGravitationalParameter );
+
+    // Create departure epoch grid covering one synodic period, and arrival epoch grid covering
+    // times of flight around that of the Hohmann transfer.
+    const Eigen::VectorXd departureEpochs = mission_segments::createSynodicDepartureEpochGrid(
+                0.0, 2.0 * PI / departureOrbit.getMeanMotion( ),
+                2.0 * PI / arrivalOrbit.getMeanMotion( ), 200 );
+    const Eigen::VectorXd arrivalEpochs = Eigen::VectorXd::LinSpaced(
+                300, departureEpochs( 0 ) + 150.0 * julianDay,
+                departureEpochs( departureEpochs.rows( ) - 1 ) + 350.0 * julianDay );
+
+    Eigen::MatrixXd departureDeltaVs, arrivalDeltaVs;
+    mission_segments::computePorkchopPlot(
+                boost::bind( &propagators::KeplerOrbit::getStateAtTime, &departureOrbit, _1 ),
+                boost::bind( &propagators::KeplerOrbit::getStateAtTime, &arrivalOrbit, _1 ),
+                departureEpochs, arrivalEpochs, sunGravitationalParameter, departureDeltaVs,
+                arrivalDeltaVs );
+
+    // Find minimum total delta-v.
+    double minimumTotalDeltaV = std::numeric_limits< double >::infinity( );
+    for ( int i = 0; i < departureDeltaVs.rows( ); i++ )
+    {
+        for ( int j = 0; j < departureDeltaVs.cols( ); j++ )
+        {
+            const double totalDeltaV = departureDeltaVs( i, j ) + arrivalDeltaVs( i, j );
+            if ( totalDeltaV < minimumTotalDeltaV )
+            {
+                minimumTotalDeltaV = totalDeltaV;
+            }
+        }
+    }
+
+    // Compute delta-v of Hohmann transfer (Wakker, 2007), which is the minimum two-impulse
+    // delta-v for this ratio of radii.
+    const double hohmannDeltaV
+            = std::sqrt( sunGravitationalParameter / departureRadius )
+            * ( std::sqrt( 2.0 * arrivalRadius / ( departureRadius + arrivalRadius ) ) - 1.0 )
+            + std::sqrt( sunGravitationalParameter / arrivalRadius )
+            * ( 1.0 - std::sqrt( 2.0 * departureRadius / ( departureRadius + arrivalRadius ) ) );
+
+    BOOST_CHECK_GE( minimumTotalDeltaV, hohmannDeltaV * ( 1.0 - 1.0e-10 ) );
+    BOOST_CHECK_LE( minimumTotalDeltaV, 1.02 * hohmannDeltaV );
+}
+
+//! Test if departure epoch grid covers one synodic period.
+BOOST_AUTO_TEST_CASE( testSynodicDepartureEpochGrid )
+{
+    const double startEpoch = 1.0e8;
+    const double orbitalPeriodOfDepartureBody = 3.15581e7;
+    const double orbitalPeriodOfArrivalBody = 5.93551e7;
+    const double synodicPeriod = basic_astrodynamics::computeSynodicPeriod(
+                orbitalPeriodOfDepartureBody, orbitalPeriodOfArrivalBody );
+
+    const Eigen::VectorXd departureEpochs = mission_segments::createSynodicDepartureEpochGrid(
+                startEpoch, orbitalPeriodOfDepartureBody, orbitalPeriodOfArrivalBody, 10 );
+
+    BOOST_CHECK_EQUAL( departureEpochs.rows( ), 10 );
+    BOOST_CHECK_EQUAL( departureEpochs( 0 ), startEpoch );
+    for ( int i = 1; i < departureEpochs.rows( ); i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( departureEpochs( i ) - departureEpochs( i - 1 ),
+                                    0.1 * synodicPeriod, 1.0e-12 );
+    }
+
+    // Check if errors are thrown for invalid grid sizes and tile sizes.
+    BOOST_CHECK_THROW( mission_segments::createSynodicDepartureEpochGrid(
+                           startEpoch, orbitalPeriodOfDepartureBody, orbitalPeriodOfArrivalBody,
+                           0 ), std::runtime_error );
+
+    Eigen::MatrixXd departureDeltaVs, arrivalDeltaVs;
+    BOOST_CHECK_THROW( mission_segments::computePorkchopPlot(
+                           mission_segments::BodyStateFunction( ),
+                           mission_segments::BodyStateFunction( ), departureEpochs,
+                           departureEpochs, 1.0, departureDeltaVs, arrivalDeltaVs, 1, 0 ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,710 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Izzo, D. Revisiting Lambert's problem, Celestial Mechanics and Dynamical Astronomy, 121(1),
+ *          1-15, 2015.
+ *      Izzo, D. PyKEP, Keplerian toolbox, European Space Agency, http://esa.github.io/pykep/,
+ *          last accessed: 2013.
+ *
+ *    Notes
+ *      The time of flight equation is evaluated using a hypergeometric series close to the
+ *      parabolic case (|x - 1| < 0.01), Lagrange's equation for 0.01 < |x - 1| < 0.2, and
+ *      Lancaster's equation otherwise, as recommended in (Izzo, 2015).
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/MissionSegments/lambertRoutines.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+namespace
+{
+
+using basic_mathematics::mathematical_constants::PI;
+
+//! Non-dimensional geometry of a Lambert problem.
+struct LambertGeometry
+{
+    //! Lambda parameter, defined by the chord and semi-perimeter of the transfer triangle.
+    double lambda;
+
+    //! Non-dimensional time of flight.
+    double nonDimensionalTimeOfFlight;
+
+    //! Semi-perimeter of the transfer triangle.
+    double semiPerimeter;
+
+    //! Chord of the transfer triangle.
+    double chord;
+
+    //! Norm of departure position.
+    double departureRadius;
+
+    //! Norm of arrival position.
+    double arrivalRadius;
+
+    //! Unit vector in direction of departure position.
+    Eigen::Vector3d departureRadialUnitVector;
+
+    //! Unit vector in direction of arrival position.
+    Eigen::Vector3d arrivalRadialUnitVector;
+
+    //! Unit vector in transverse direction at departure.
+    Eigen::Vector3d departureTransverseUnitVector;
+
+    //! Unit vector in transverse direction at arrival.
+    Eigen::Vector3d arrivalTransverseUnitVector;
+};
+
+//! Compute non-dimensional geometry of a Lambert problem.
+/*!
+ * Computes the non-dimensional geometry of a Lambert problem (Izzo, 2015), and throws an error if
+ * the time of flight is not positive or the positions are collinear.
+ * \param departurePosition Position at departure.
+ * \param arrivalPosition Position at arrival.
+ * \param timeOfFlight Time of flight.
+ * \param gravitationalParameter Gravitational parameter of central body.
+ * \param isRetrograde Flag indicating whether the transfer is retrograde.
+ * \param geometry Geometry of Lambert problem (returned by reference).
+ */
+void computeLambertGeometry( const Eigen::Vector3d& departurePosition,
+                             const Eigen::Vector3d& arrivalPosition,
+                             const double timeOfFlight, const double gravitationalParameter,
+                             const bool isRetrograde, LambertGeometry& geometry )
+{
+    // Check if time of flight is positive and throw an error if not.
+    if ( !( timeOfFlight > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Time of flight should be positive." ) ) );
+    }
+
+    // Compute transfer triangle.
+    geometry.chord = ( arrivalPosition - departurePosition ).norm( );
+    geometry.departureRadius = departurePosition.norm( );
+    geometry.arrivalRadius = arrivalPosition.norm( );
+    geometry.semiPerimeter = 0.5 * ( geometry.chord + geometry.departureRadius
+                                     + geometry.arrivalRadius );
+    geometry.departureRadialUnitVector = departurePosition / geometry.departureRadius;
+    geometry.arrivalRadialUnitVector = arrivalPosition / geometry.arrivalRadius;
+
+    // Compute unit vector normal to transfer plane, and throw an error if it is undefined.
+    Eigen::Vector3d angularMomentumUnitVector_
+            = geometry.departureRadialUnitVector.cross( geometry.arrivalRadialUnitVector );
+    const double angularMomentumUnitVectorNorm_ = angularMomentumUnitVector_.norm( );
+
+    if ( !( angularMomentumUnitVectorNorm_ > std::numeric_limits< double >::epsilon( ) ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Transfer plane is undefined for collinear positions." ) ) );
+    }
+
+    angularMomentumUnitVector_ /= angularMomentumUnitVectorNorm_;
+
+    // Compute lambda parameter and transverse unit vectors; for a prograde transfer, a negative
+    // z-component of the angular momentum corresponds to a transfer angle larger than pi.
+    geometry.lambda = std::sqrt( 1.0 - geometry.chord / geometry.semiPerimeter );
+
+    if ( angularMomentumUnitVector_.z( ) < 0.0 )
+    {
+        geometry.lambda = -geometry.lambda;
+        geometry.departureTransverseUnitVector
+                = geometry.departureRadialUnitVector.cross( angularMomentumUnitVector_ );
+        geometry.arrivalTransverseUnitVector
+                = geometry.arrivalRadialUnitVector.cross( angularMomentumUnitVector_ );
+    }
+
+    else
+    {
+        geometry.departureTransverseUnitVector
+                = angularMomentumUnitVector_.cross( geometry.departureRadialUnitVector );
+        geometry.arrivalTransverseUnitVector
+                = angularMomentumUnitVector_.cross( geometry.arrivalRadialUnitVector );
+    }
+
+    if ( isRetrograde )
+    {
+        geometry.lambda = -geometry.lambda;
+        geometry.departureTransverseUnitVector = -geometry.departureTransverseUnitVector;
+        geometry.arrivalTransverseUnitVector = -geometry.arrivalTransverseUnitVector;
+    }
+
+    // Compute non-dimensional time of flight.
+    geometry.nonDimensionalTimeOfFlight = std::sqrt(
+                2.0 * gravitationalParameter / ( geometry.semiPerimeter * geometry.semiPerimeter
+                                                 * geometry.semiPerimeter ) ) * timeOfFlight;
+}
+
+//! Compute hypergeometric function used in time of flight equation.
+/*!
+ * Computes the Gauss hypergeometric function 2F1( 3, 1; 5/2; z ) by summing its series, which
+ * converges for |z| < 1.
+ * \param z Argument of hypergeometric function.
+ * \param tolerance Absolute tolerance on last term of series used as stopping criterion.
+ * \return Value of hypergeometric function.
+ */
+double computeHypergeometricFunction( const double z, const double tolerance )
+{
+    double sum_ = 1.0;
+    double term_ = 1.0;
+    double termIndex_ = 0.0;
+
+    while ( std::fabs( term_ ) > tolerance )
+    {
+        term_ *= ( 3.0 + termIndex_ ) * ( 1.0 + termIndex_ ) / ( 2.5 + termIndex_ ) * z
+                / ( termIndex_ + 1.0 );
+        sum_ += term_;
+        termIndex_ += 1.0;
+    }
+
+    return sum_;
+}
+
+//! Compute non-dimensional time of flight using Lagrange's equation.
+/*!
+ * Computes non-dimensional time of flight as a function of x using Lagrange's equation.
+ * \param x Non-dimensional Lambert parameter.
+ * \param lambda Lambda parameter of Lambert problem.
+ * \param numberOfRevolutions Number of complete revolutions.
+ * \return Non-dimensional time of flight.
+ */
+double computeTimeOfFlightWithLagrangeEquation( const double x, const double lambda,
+                                                const unsigned int numberOfRevolutions )
+{
+    const double semiMajorAxis_ = 1.0 / ( 1.0 - x * x );
+
+    // Elliptical case.
+    if ( semiMajorAxis_ > 0.0 )
+    {
+        const double alpha_ = 2.0 * std::acos( x );
+        double beta_ = 2.0 * std::asin( std::sqrt( lambda * lambda / semiMajorAxis_ ) );
+        if ( lambda < 0.0 )
+        {
+            beta_ = -beta_;
+        }
+
+        return 0.5 * semiMajorAxis_ * std::sqrt( semiMajorAxis_ )
+                * ( ( alpha_ - std::sin( alpha_ ) ) - ( beta_ - std::sin( beta_ ) )
+                    + 2.0 * PI * static_cast< double >( numberOfRevolutions ) );
+    }
+
+    // Hyperbolic case.
+    const double alpha_ = 2.0 * std::log( x + std::sqrt( x * x - 1.0 ) );
+    const double betaArgument_ = std::sqrt( -lambda * lambda / semiMajorAxis_ );
+    double beta_ = 2.0 * std::log( betaArgument_ + std::sqrt( betaArgument_ * betaArgument_
+                                                              + 1.0 ) );
+    if ( lambda < 0.0 )
+    {
+        beta_ = -beta_;
+    }
+
+    return -0.5 * semiMajorAxis_ * std::sqrt( -semiMajorAxis_ )
+            * ( ( beta_ - std::sinh( beta_ ) ) - ( alpha_ - std::sinh( alpha_ ) ) );
+}
+
+//! Compute non-dimensional time of flight.
+/*!
+ * Computes non-dimensional time of flight as a function of x, using the hypergeometric series,
+ * Lagrange's equation or Lancaster's equation, depending on the distance of x to 1.
+ * \param x Non-dimensional Lambert parameter.
+ * \param lambda Lambda parameter of Lambert problem.
+ * \param numberOfRevolutions Number of complete revolutions.
+ * \return Non-dimensional time of flight.
+ */
+double computeNonDimensionalTimeOfFlight( const double x, const double lambda,
+                                          const unsigned int numberOfRevolutions )
+{
+    const double distanceToParabola_ = std::fabs( x - 1.0 );
+
+    if ( distanceToParabola_ < 0.2 && distanceToParabola_ > 0.01 )
+    {
+        return computeTimeOfFlightWithLagrangeEquation( x, lambda, numberOfRevolutions );
+    }
+
+    const double energyParameter_ = x * x - 1.0;
+    const double rho_ = std::fabs( energyParameter_ );
+    const double z_ = std::sqrt( 1.0 + lambda * lambda * energyParameter_ );
+    const double revolutionTerm_ = PI * static_cast< double >( numberOfRevolutions );
+
+    // Use hypergeometric series close to parabolic case.
+    if ( distanceToParabola_ <= 0.01 )
+    {
+        const double eta_ = z_ - lambda * x;
+        const double hypergeometricArgument_ = 0.5 * ( 1.0 - lambda - x * eta_ );
+        const double q_ = 4.0 / 3.0 * computeHypergeometricFunction(
+                    hypergeometricArgument_, 1.0e-11 );
+
+        double timeOfFlight_ = 0.5 * ( eta_ * eta_ * eta_ * q_ + 4.0 * lambda * eta_ );
+        if ( numberOfRevolutions > 0 )
+        {
+            timeOfFlight_ += revolutionTerm_ / ( rho_ * std::sqrt( rho_ ) );
+        }
+
+        return timeOfFlight_;
+    }
+
+    // Use Lancaster's equation otherwise.
+    const double y_ = std::sqrt( rho_ );
+    const double g_ = x * z_ - lambda * energyParameter_;
+    double d_ = 0.0;
+
+    if ( energyParameter_ < 0.0 )
+    {
+        d_ = revolutionTerm_ + std::acos( g_ );
+    }
+
+    else
+    {
+        d_ = std::log( y_ * ( z_ - lambda * x ) + g_ );
+    }
+
+    return ( x - lambda * z_ - d_ / y_ ) / energyParameter_;
+}
+
+//! Compute derivatives of non-dimensional time of flight.
+/*!
+ * Computes first, second and third derivative of the non-dimensional time of flight with respect
+ * to x (Izzo, 2015).
+ * \param x Non-dimensional Lambert parameter.
+ * \param timeOfFlight Non-dimensional time of flight at x.
+ * \param lambda Lambda parameter of Lambert problem.
+ * \param firstDerivative First derivative (returned by reference).
+ * \param secondDerivative Second derivative (returned by reference).
+ * \param thirdDerivative Third derivative (returned by reference).
+ */
+void computeTimeOfFlightDerivatives( const double x, const double timeOfFlight,
+                                     const double lambda, double& firstDerivative,
+                                     double& secondDerivative, double& thirdDerivative )
+{
+    const double lambdaSquared_ = lambda * lambda;
+    const double lambdaCubed_ = lambdaSquared_ * lambda;
+    const double oneMinusXSquared_ = 1.0 - x * x;
+    const double y_ = std::sqrt( 1.0 - lambdaSquared_ * oneMinusXSquared_ );
+    const double ySquared_ = y_ * y_;
+    const double yCubed_ = ySquared_ * y_;
+
+    firstDerivative = ( 3.0 * timeOfFlight * x - 2.0 + 2.0 * lambdaCubed_ * x / y_ )
+            / oneMinusXSquared_;
+    secondDerivative = ( 3.0 * timeOfFlight + 5.0 * x * firstDerivative
+                         + 2.0 * ( 1.0 - lambdaSquared_ ) * lambdaCubed_ / yCubed_ )
+            / oneMinusXSquared_;
+    thirdDerivative = ( 7.0 * x * secondDerivative + 8.0 * firstDerivative
+                        - 6.0 * ( 1.0 - lambdaSquared_ ) * lambdaSquared_ * lambdaCubed_ * x
+                        / yCubed_ / ySquared_ ) / oneMinusXSquared_;
+}
+
+//! Compute maximum number of revolutions from non-dimensional geometry.
+/*!
+ * Computes the maximum number of revolutions for a given lambda parameter and non-dimensional
+ * time of flight, by computing the minimum time of flight with Halley iterations if needed.
+ * \param lambda Lambda parameter of Lambert problem.
+ * \param timeOfFlight Non-dimensional time of flight.
+ * \return Maximum number of revolutions.
+ */
+unsigned int computeMaximumNumberOfRevolutions( const double lambda, const double timeOfFlight )
+{
+    unsigned int maximumNumberOfRevolutions_
+            = static_cast< unsigned int >( std::floor( timeOfFlight / PI ) );
+
+    // Compute time of flight for x = 0 at the maximum number of revolutions.
+    const double minimumEnergyTimeOfFlight_ = std::acos( lambda )
+            + lambda * std::sqrt( 1.0 - lambda * lambda )
+            + static_cast< double >( maximumNumberOfRevolutions_ ) * PI;
+
+    // If the time of flight is lower, check whether it is above the minimum time of flight, using
+    // Halley iterations to find the minimum.
+    if ( maximumNumberOfRevolutions_ > 0 && timeOfFlight < minimumEnergyTimeOfFlight_ )
+    {
+        double x_ = 0.0;
+        double minimumTimeOfFlight_ = minimumEnergyTimeOfFlight_;
+        double firstDerivative_ = 0.0;
+        double secondDerivative_ = 0.0;
+        double thirdDerivative_ = 0.0;
+
+        for ( unsigned int iteration = 0; iteration < 12; iteration++ )
+        {
+            computeTimeOfFlightDerivatives( x_, minimumTimeOfFlight_, lambda, firstDerivative_,
+                                            secondDerivative_, thirdDerivative_ );
+
+            const double xStep_ = firstDerivative_ * secondDerivative_
+                    / ( secondDerivative_ * secondDerivative_
+                        - 0.5 * firstDerivative_ * thirdDerivative_ );
+            x_ -= xStep_;
+            minimumTimeOfFlight_ = computeNonDimensionalTimeOfFlight(
+                        x_, lambda, maximumNumberOfRevolutions_ );
+
+            if ( std::fabs( xStep_ ) < 1.0e-13 )
+            {
+                break;
+            }
+        }
+
+        if ( minimumTimeOfFlight_ > timeOfFlight )
+        {
+            maximumNumberOfRevolutions_--;
+        }
+    }
+
+    return maximumNumberOfRevolutions_;
+}
+
+//! Compute initial guess of x.
+/*!
+ * Computes initial guess of the non-dimensional Lambert parameter x (Izzo, 2015).
+ * \param lambda Lambda parameter of Lambert problem.
+ * \param timeOfFlight Non-dimensional time of flight.
+ * \param numberOfRevolutions Number of complete revolutions.
+ * \param isRightBranch Flag indicating whether the right branch is used.
+ * \return Initial guess of x.
+ */
+double computeInitialGuessOfX( const double lambda, const double timeOfFlight,
+                               const unsigned int numberOfRevolutions, const bool isRightBranch )
+{
+    // Zero-revolution case.
+    if ( numberOfRevolutions == 0 )
+    {
+        const double zeroRevolutionTimeOfFlight_ = std::acos( lambda )
+                + lambda * std::sqrt( 1.0 - lambda * lambda );
+        const double parabolicTimeOfFlight_ = 2.0 / 3.0 * ( 1.0 - lambda * lambda * lambda );
+
+        if ( timeOfFlight >= zeroRevolutionTimeOfFlight_ )
+        {
+            return -( timeOfFlight - zeroRevolutionTimeOfFlight_ )
+                    / ( timeOfFlight - zeroRevolutionTimeOfFlight_ + 4.0 );
+        }
+
+        else if ( timeOfFlight <= parabolicTimeOfFlight_ )
+        {
+            return parabolicTimeOfFlight_ * ( parabolicTimeOfFlight_ - timeOfFlight )
+                    / ( 0.4 * ( 1.0 - lambda * lambda * lambda * lambda * lambda ) * timeOfFlight )
+                    + 1.0;
+        }
+
+        return std::pow( timeOfFlight / zeroRevolutionTimeOfFlight_,
+                         std::log( 2.0 ) / std::log( parabolicTimeOfFlight_
+                                                     / zeroRevolutionTimeOfFlight_ ) ) - 1.0;
+    }
+
+    // Multi-revolution case.
+    const double revolutionAngle_ = static_cast< double >( numberOfRevolutions ) * PI;
+    double ratio_ = 0.0;
+
+    if ( isRightBranch )
+    {
+        ratio_ = std::pow( 8.0 * timeOfFlight / revolutionAngle_, 2.0 / 3.0 );
+    }
+
+    else
+    {
+        ratio_ = std::pow( ( revolutionAngle_ + PI ) / ( 8.0 * timeOfFlight ), 2.0 / 3.0 );
+    }
+
+    return ( ratio_ - 1.0 ) / ( ratio_ + 1.0 );
+}
+
+//! Solve time of flight equation for x.
+/*!
+ * Solves the time of flight equation for x using Householder iterations, and throws an error if
+ * the iterations do not converge.
+ * \param lambda Lambda parameter of Lambert problem.
+ * \param timeOfFlight Non-dimensional time of flight.
+ * \param initialGuess Initial guess of x.
+ * \param numberOfRevolutions Number of complete revolutions.
+ * \param convergenceTolerance Absolute tolerance on the iteration step of x.
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \return Value of x.
+ */
+double solveForX( const double lambda, const double timeOfFlight, const double initialGuess,
+                  const unsigned int numberOfRevolutions, const double convergenceTolerance,
+                  const unsigned int maximumNumberOfIterations )
+{
+    double x_ = initialGuess;
+    double firstDerivative_ = 0.0;
+    double secondDerivative_ = 0.0;
+    double thirdDerivative_ = 0.0;
+
+    for ( unsigned int iteration = 0; iteration < maximumNumberOfIterations; iteration++ )
+    {
+        // Compute time of flight error and its derivatives.
+        const double currentTimeOfFlight_ = computeNonDimensionalTimeOfFlight(
+                    x_, lambda, numberOfRevolutions );
+        computeTimeOfFlightDerivatives( x_, currentTimeOfFlight_, lambda, firstDerivative_,
+                                        secondDerivative_, thirdDerivative_ );
+        const double timeOfFlightError_ = currentTimeOfFlight_ - timeOfFlight;
+        const double firstDerivativeSquared_ = firstDerivative_ * firstDerivative_;
+
+        // Compute Householder step.
+        const double xStep_ = timeOfFlightError_
+                * ( firstDerivativeSquared_ - 0.5 * timeOfFlightError_ * secondDerivative_ )
+                / ( firstDerivative_ * ( firstDerivativeSquared_
+                                         - timeOfFlightError_ * secondDerivative_ )
+                    + thirdDerivative_ * timeOfFlightError_ * timeOfFlightError_ / 6.0 );
+        x_ -= xStep_;
+
+        if ( std::fabs( xStep_ ) <= convergenceTolerance )
+        {
+            return x_;
+        }
+    }
+
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error( "Lambert solver did not converge." ) ) );
+}
+
+//! Loop body for solution of a set of Lambert problems.
+/*!
+ * Loop body for solution of a set of Lambert problems, to be used with executeParallelLoop().
+ * Each call solves the problems in a contiguous range.
+ */
+class BatchLambertSolution
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param departurePositions Matrix of positions at departure (3 x N).
+     * \param arrivalPositions Matrix of positions at arrival (3 x N).
+     * \param timesOfFlight Vector of times of flight.
+     * \param gravitationalParameter Gravitational parameter of central body.
+     * \param isRetrograde Flag indicating whether the transfers are retrograde.
+     * \param numberOfRevolutions Number of complete revolutions.
+     * \param isRightBranch Flag indicating whether the right branch is used.
+     * \param departureVelocities Matrix in which velocities at departure are stored (3 x N).
+     * \param arrivalVelocities Matrix in which velocities at arrival are stored (3 x N).
+     */
+    BatchLambertSolution( const Eigen::MatrixXd& departurePositions,
+                          const Eigen::MatrixXd& arrivalPositions,
+                          const Eigen::VectorXd& timesOfFlight,
+                          const double gravitationalParameter, const bool isRetrograde,
+                          const unsigned int numberOfRevolutions, const bool isRightBranch,
+                          Eigen::MatrixXd& departureVelocities,
+                          Eigen::MatrixXd& arrivalVelocities )
+        : departurePositions_( departurePositions ),
+          arrivalPositions_( arrivalPositions ),
+          timesOfFlight_( timesOfFlight ),
+          gravitationalParameter_( gravitationalParameter ),
+          isRetrograde_( isRetrograde ),
+          numberOfRevolutions_( numberOfRevolutions ),
+          isRightBranch_( isRightBranch ),
+          departureVelocities_( departureVelocities ),
+          arrivalVelocities_( arrivalVelocities )
+    { }
+
+    //! Solve range of Lambert problems.
+    /*!
+     * Solves the Lambert problems in the index range [ startIndex, endIndex ). Problems for which
+     * the solver throws an error, e.g., due to collinear positions or non-convergence, are marked
+     * as unsolvable by NaN velocities, rather than aborting the solution of the other problems.
+     * \param startIndex Index of first problem.
+     * \param endIndex One past the index of the last problem.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        Eigen::Vector3d departureVelocity_;
+        Eigen::Vector3d arrivalVelocity_;
+
+        for ( int problemIndex = startIndex; problemIndex < endIndex; problemIndex++ )
+        {
+            try
+            {
+                solveLambertProblemIzzo( departurePositions_.col( problemIndex ),
+                                         arrivalPositions_.col( problemIndex ),
+                                         timesOfFlight_( problemIndex ), gravitationalParameter_,
+                                         departureVelocity_, arrivalVelocity_, isRetrograde_,
+                                         numberOfRevolutions_, isRightBranch_ );
+            }
+
+            catch ( std::runtime_error& )
+            {
+                departureVelocity_.setConstant( TUDAT_NAN );
+                arrivalVelocity_.setConstant( TUDAT_NAN );
+            }
+
+            departureVelocities_.col( problemIndex ) = departureVelocity_;
+            arrivalVelocities_.col( problemIndex ) = arrivalVelocity_;
+        }
+    }
+
+private:
+
+    //! Matrix of positions at departure.
+    const Eigen::MatrixXd& departurePositions_;
+
+    //! Matrix of positions at arrival.
+    const Eigen::MatrixXd& arrivalPositions_;
+
+    //! Vector of times of flight.
+    const Eigen::VectorXd& timesOfFlight_;
+
+    //! Gravitational parameter of central body.
+    const double gravitationalParameter_;
+
+    //! Flag indicating whether the transfers are retrograde.
+    const bool isRetrograde_;
+
+    //! Number of complete revolutions.
+    const unsigned int numberOfRevolutions_;
+
+    //! Flag indicating whether the right branch is used.
+    const bool isRightBranch_;
+
+    //! Matrix in which velocities at departure are stored.
+    Eigen::MatrixXd& departureVelocities_;
+
+    //! Matrix in which velocities at arrival are stored.
+    Eigen::MatrixXd& arrivalVelocities_;
+};
+
+} // namespace
+
+//! Compute maximum number of revolutions of Lambert transfer.
+unsigned int computeMaximumNumberOfLambertRevolutions( const Eigen::Vector3d& departurePosition,
+                                                       const Eigen::Vector3d& arrivalPosition,
+                                                       const double timeOfFlight,
+                                                       const double gravitationalParameter,
+                                                       const bool isRetrograde )
+{
+    LambertGeometry geometry_;
+    computeLambertGeometry( departurePosition, arrivalPosition, timeOfFlight,
+                            gravitationalParameter, isRetrograde, geometry_ );
+
+    return computeMaximumNumberOfRevolutions( geometry_.lambda,
+                                              geometry_.nonDimensionalTimeOfFlight );
+}
+
+//! Solve Lambert's problem using Izzo's algorithm.
+bool solveLambertProblemIzzo( const Eigen::Vector3d& departurePosition,
+                              const Eigen::Vector3d& arrivalPosition,
+                              const double timeOfFlight, const double gravitationalParameter,
+                              Eigen::Vector3d& departureVelocity, Eigen::Vector3d& arrivalVelocity,
+                              const bool isRetrograde, const unsigned int numberOfRevolutions,
+                              const bool isRightBranch, const double convergenceTolerance,
+                              const unsigned int maximumNumberOfIterations )
+{
+    // Compute non-dimensional geometry.
+    LambertGeometry geometry_;
+    computeLambertGeometry( departurePosition, arrivalPosition, timeOfFlight,
+                            gravitationalParameter, isRetrograde, geometry_ );
+    const double lambda_ = geometry_.lambda;
+
+    // Check if a solution exists for the requested number of revolutions.
+    if ( numberOfRevolutions > 0
+         && numberOfRevolutions > computeMaximumNumberOfRevolutions(
+             lambda_, geometry_.nonDimensionalTimeOfFlight ) )
+    {
+        departureVelocity.setConstant( TUDAT_NAN );
+        arrivalVelocity.setConstant( TUDAT_NAN );
+        return false;
+    }
+
+    // Solve time of flight equation for x.
+    const double x_ = solveForX(
+                lambda_, geometry_.nonDimensionalTimeOfFlight,
+                computeInitialGuessOfX( lambda_, geometry_.nonDimensionalTimeOfFlight,
+                                        numberOfRevolutions, isRightBranch ),
+                numberOfRevolutions, convergenceTolerance, maximumNumberOfIterations );
+
+    // Reconstruct radial and transverse velocity components.
+    const double gamma_ = std::sqrt( 0.5 * gravitationalParameter * geometry_.semiPerimeter );
+    const double rho_ = ( geometry_.departureRadius - geometry_.arrivalRadius ) / geometry_.chord;
+    const double sigma_ = std::sqrt( 1.0 - rho_ * rho_ );
+    const double y_ = std::sqrt( 1.0 - lambda_ * lambda_ + lambda_ * lambda_ * x_ * x_ );
+
+    const double departureRadialVelocity_
+            = gamma_ * ( ( lambda_ * y_ - x_ ) - rho_ * ( lambda_ * y_ + x_ ) )
+            / geometry_.departureRadius;
+    const double arrivalRadialVelocity_
+            = -gamma_ * ( ( lambda_ * y_ - x_ ) + rho_ * ( lambda_ * y_ + x_ ) )
+            / geometry_.arrivalRadius;
+    const double transverseVelocityTerm_ = gamma_ * sigma_ * ( y_ + lambda_ * x_ );
+
+    departureVelocity = departureRadialVelocity_ * geometry_.departureRadialUnitVector
+            + transverseVelocityTerm_ / geometry_.departureRadius
+            * geometry_.departureTransverseUnitVector;
+    arrivalVelocity = arrivalRadialVelocity_ * geometry_.arrivalRadialUnitVector
+            + transverseVelocityTerm_ / geometry_.arrivalRadius
+            * geometry_.arrivalTransverseUnitVector;
+
+    return true;
+}
+
+//! Solve set of Lambert problems using Izzo's algorithm.
+void solveLambertProblemsIzzo( const Eigen::MatrixXd& departurePositions,
+                               const Eigen::MatrixXd& arrivalPositions,
+                               const Eigen::VectorXd& timesOfFlight,
+                               const double gravitationalParameter,
+                               Eigen::MatrixXd& departureVelocities,
+                               Eigen::MatrixXd& arrivalVelocities,
+                               const bool isRetrograde,
+                               const unsigned int numberOfRevolutions,
+                               const bool isRightBranch,
+                               const unsigned int numberOfThreads )
+{
+    // Check if input sizes are consistent and throw an error if not.
+    if ( departurePositions.rows( ) != 3 || arrivalPositions.rows( ) != 3
+         || arrivalPositions.cols( ) != departurePositions.cols( )
+         || timesOfFlight.rows( ) != departurePositions.cols( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Sizes of Lambert problem inputs are inconsistent." ) ) );
+    }
+
+    // Resize output matrices; this does not allocate if they already have the correct size.
+    departureVelocities.resize( 3, departurePositions.cols( ) );
+    arrivalVelocities.resize( 3, departurePositions.cols( ) );
+
+    basics::executeParallelLoop(
+                static_cast< int >( departurePositions.cols( ) ),
+                BatchLambertSolution( departurePositions, arrivalPositions, timesOfFlight,
+                                      gravitationalParameter, isRetrograde, numberOfRevolutions,
+                                      isRightBranch, departureVelocities, arrivalVelocities ),
+                numberOfThreads, 16 );
+}
+
+} // namespace mission_segments
+} // namespace tudat
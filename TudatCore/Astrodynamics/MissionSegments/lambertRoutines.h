@@ -0,0 +1,147 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Izzo, D. Revisiting Lambert's problem, Celestial Mechanics and Dynamical Astronomy, 121(1),
+ *          1-15, 2015.
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *      The solver follows (Izzo, 2015): the time of flight is expressed as a function of a single
+ *      non-dimensional parameter x, which is solved for with Householder iterations starting from
+ *      an explicit initial guess. Typically, two to three iterations are required.
+ *
+ *      The transfer plane is defined by the departure and arrival positions, so that the problem
+ *      is undefined for collinear positions. Prograde transfers have a positive z-component of the
+ *      angular momentum.
+ *
+ */
+
+#ifndef TUDAT_CORE_LAMBERT_ROUTINES_H
+#define TUDAT_CORE_LAMBERT_ROUTINES_H
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Compute maximum number of revolutions of Lambert transfer.
+/*!
+ * Computes the maximum number of complete revolutions for which a solution of Lambert's problem
+ * exists for the given positions and time of flight, by comparing the time of flight with the
+ * minimum time of flight of the multi-revolution solutions (Izzo, 2015).
+ * \param departurePosition Position at departure.                                              [m]
+ * \param arrivalPosition Position at arrival.                                                  [m]
+ * \param timeOfFlight Time of flight.                                                          [s]
+ * \param gravitationalParameter Gravitational parameter of central body.                 [m^3/s^2]
+ * \param isRetrograde Flag indicating whether the transfer is retrograde.
+ * \return Maximum number of revolutions.
+ */
+unsigned int computeMaximumNumberOfLambertRevolutions( const Eigen::Vector3d& departurePosition,
+                                                       const Eigen::Vector3d& arrivalPosition,
+                                                       const double timeOfFlight,
+                                                       const double gravitationalParameter,
+                                                       const bool isRetrograde = false );
+
+//! Solve Lambert's problem using Izzo's algorithm.
+/*!
+ * Solves Lambert's problem, i.e., computes the velocities at departure and arrival of the
+ * Kepler orbit that connects two positions in a given time of flight, using the algorithm of
+ * (Izzo, 2015) with Householder iterations. For zero revolutions, a unique solution always
+ * exists. For one or more complete revolutions, two solutions exist if the time of flight exceeds
+ * the minimum time of flight for that number of revolutions; these are distinguished as the left
+ * and right branch, where the left branch has the lower value of the non-dimensional parameter x
+ * (i.e., the larger semi-major axis). If no solution exists, false is returned and the velocities
+ * are set to NaN. No memory is allocated. An error is thrown if the time of flight is not
+ * positive, if the positions are collinear, or if the iteration does not converge.
+ * \param departurePosition Position at departure.                                              [m]
+ * \param arrivalPosition Position at arrival.                                                  [m]
+ * \param timeOfFlight Time of flight.                                                          [s]
+ * \param gravitationalParameter Gravitational parameter of central body.                 [m^3/s^2]
+ * \param departureVelocity Velocity at departure (returned by reference).                    [m/s]
+ * \param arrivalVelocity Velocity at arrival (returned by reference).                        [m/s]
+ * \param isRetrograde Flag indicating whether the transfer is retrograde.
+ * \param numberOfRevolutions Number of complete revolutions.
+ * \param isRightBranch Flag indicating whether the right branch of the multi-revolution
+ *          solutions is used; ignored for zero revolutions.
+ * \param convergenceTolerance Absolute tolerance on the iteration step of x used as convergence
+ *          criterion.                                                                          [-]
+ * \param maximumNumberOfIterations Maximum number of Householder iterations.
+ * \return True if a solution exists, false otherwise.
+ */
+bool solveLambertProblemIzzo( const Eigen::Vector3d& departurePosition,
+                              const Eigen::Vector3d& arrivalPosition,
+                              const double timeOfFlight, const double gravitationalParameter,
+                              Eigen::Vector3d& departureVelocity, Eigen::Vector3d& arrivalVelocity,
+                              const bool isRetrograde = false,
+                              const unsigned int numberOfRevolutions = 0,
+                              const bool isRightBranch = false,
+                              const double convergenceTolerance = 1.0e-11,
+                              const unsigned int maximumNumberOfIterations = 15 );
+
+//! Solve set of Lambert problems using Izzo's algorithm.
+/*!
+ * Solves a set of Lambert problems, by calling solveLambertProblemIzzo() for each problem. The set
+ * of problems is divided over multiple threads; apart from the output matrices, no memory is
+ * allocated. For problems without solution, including problems for which solveLambertProblemIzzo()
+ * throws an error, e.g., due to collinear positions or non-convergence, the velocities are set to
+ * NaN, while the other problems are still solved.
+ * \param departurePositions Matrix of positions at departure, one per column (3 x N).          [m]
+ * \param arrivalPositions Matrix of positions at arrival, one per column (3 x N).              [m]
+ * \param timesOfFlight Vector of times of flight (N entries).                                  [s]
+ * \param gravitationalParameter Gravitational parameter of central body.                 [m^3/s^2]
+ * \param departureVelocities Matrix in which velocities at departure are stored (3 x N). If the
+ *          matrix is preallocated with the correct size, no memory is allocated; otherwise it is
+ *          resized.                                                                          [m/s]
+ * \param arrivalVelocities Matrix in which velocities at arrival are stored (3 x N). If the
+ *          matrix is preallocated with the correct size, no memory is allocated; otherwise it is
+ *          resized.                                                                          [m/s]
+ * \param isRetrograde Flag indicating whether the transfers are retrograde.
+ * \param numberOfRevolutions Number of complete revolutions.
+ * \param isRightBranch Flag indicating whether the right branch of the multi-revolution
+ *          solutions is used; ignored for zero revolutions.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ */
+void solveLambertProblemsIzzo( const Eigen::MatrixXd& departurePositions,
+                               const Eigen::MatrixXd& arrivalPositions,
+                               const Eigen::VectorXd& timesOfFlight,
+                               const double gravitationalParameter,
+                               Eigen::MatrixXd& departureVelocities,
+                               Eigen::MatrixXd& arrivalVelocities,
+                               const bool isRetrograde = false,
+                               const unsigned int numberOfRevolutions = 0,
+                               const bool isRightBranch = false,
+                               const unsigned int numberOfThreads = 0 );
+
+} // namespace mission_segments
+} // namespace tudat
+
+#endif // TUDAT_CORE_LAMBERT_ROUTINES_H
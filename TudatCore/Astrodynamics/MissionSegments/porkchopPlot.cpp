@@ -0,0 +1,290 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/astrodynamicsFunctions.h"
+#include "TudatCore/Astrodynamics/MissionSegments/lambertRoutines.h"
+#include "TudatCore/Astrodynamics/MissionSegments/porkchopPlot.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+namespace
+{
+
+//! Evaluate states of body at set of epochs.
+/*!
+ * Evaluates the Cartesian states of a body at a set of epochs.
+ * \param bodyStateFunction Function returning the Cartesian state of the body at a given epoch.
+ * \param epochs Set of epochs.
+ * \return Matrix of Cartesian states, one per column (6 x N).
+ */
+Eigen::MatrixXd evaluateBodyStates( const BodyStateFunction& bodyStateFunction,
+                                    const Eigen::VectorXd& epochs )
+{
+    Eigen::MatrixXd bodyStates_( 6, epochs.rows( ) );
+    for ( int epochIndex = 0; epochIndex < epochs.rows( ); epochIndex++ )
+    {
+        bodyStates_.col( epochIndex ) = bodyStateFunction( epochs( epochIndex ) );
+    }
+
+    return bodyStates_;
+}
+
+//! Loop body for evaluation of tiles of porkchop plot.
+/*!
+ * Loop body for evaluation of tiles of a porkchop plot, to be used with executeParallelLoop().
+ * Tiles are numbered with the departure tile index running fastest, and each call evaluates a
+ * contiguous range of tiles.
+ */
+class PorkchopPlotTileEvaluation
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param departureBodyStates Matrix of states of departure body at departure epochs (6 x N).
+     * \param arrivalBodyStates Matrix of states of arrival body at arrival epochs (6 x M).
+     * \param departureEpochs Grid of departure epochs.
+     * \param arrivalEpochs Grid of arrival epochs.
+     * \param gravitationalParameter Gravitational parameter of central body.
+     * \param tileSize Number of departure and arrival epochs per tile.
+     * \param numberOfDepartureTiles Number of tiles along the departure epoch grid.
+     * \param departureDeltaVs Matrix in which departure delta-v's are stored (N x M).
+     * \param arrivalDeltaVs Matrix in which arrival delta-v's are stored (N x M).
+     */
+    PorkchopPlotTileEvaluation( const Eigen::MatrixXd& departureBodyStates,
+                                const Eigen::MatrixXd& arrivalBodyStates,
+                                const Eigen::VectorXd& departureEpochs,
+                                const Eigen::VectorXd& arrivalEpochs,
+                                const double gravitationalParameter, const int tileSize,
+                                const int numberOfDepartureTiles,
+                                Eigen::MatrixXd& departureDeltaVs,
+                                Eigen::MatrixXd& arrivalDeltaVs )
+        : departureBodyStates_( departureBodyStates ),
+          arrivalBodyStates_( arrivalBodyStates ),
+          departureEpochs_( departureEpochs ),
+          arrivalEpochs_( arrivalEpochs ),
+          gravitationalParameter_( gravitationalParameter ),
+          tileSize_( tileSize ),
+          numberOfDepartureTiles_( numberOfDepartureTiles ),
+          departureDeltaVs_( departureDeltaVs ),
+          arrivalDeltaVs_( arrivalDeltaVs )
+    { }
+
+    //! Evaluate range of tiles.
+    /*!
+     * Evaluates the tiles in the index range [ startIndex, endIndex ).
+     * \param startIndex Index of first tile.
+     * \param endIndex One past the index of the last tile.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        for ( int tileIndex = startIndex; tileIndex < endIndex; tileIndex++ )
+        {
+            // Determine ranges of departure and arrival epochs of tile.
+            const int departureStartIndex_ = ( tileIndex % numberOfDepartureTiles_ ) * tileSize_;
+            const int departureEndIndex_ = std::min(
+                        departureStartIndex_ + tileSize_,
+                        static_cast< int >( departureEpochs_.rows( ) ) );
+            const int arrivalStartIndex_ = ( tileIndex / numberOfDepartureTiles_ ) * tileSize_;
+            const int arrivalEndIndex_ = std::min(
+                        arrivalStartIndex_ + tileSize_,
+                        static_cast< int >( arrivalEpochs_.rows( ) ) );
+
+            // Evaluate tile column by column, such that the output is written contiguously.
+            for ( int arrivalIndex = arrivalStartIndex_; arrivalIndex < arrivalEndIndex_;
+                  arrivalIndex++ )
+            {
+                for ( int departureIndex = departureStartIndex_;
+                      departureIndex < departureEndIndex_; departureIndex++ )
+                {
+                    evaluateTransfer( departureIndex, arrivalIndex );
+                }
+            }
+        }
+    }
+
+private:
+
+    //! Evaluate single transfer.
+    /*!
+     * Evaluates the transfer for a single combination of departure and arrival epoch, and stores
+     * the delta-v's, or NaN if no transfer exists.
+     * \param departureIndex Index of departure epoch.
+     * \param arrivalIndex Index of arrival epoch.
+     */
+    void evaluateTransfer( const int departureIndex, const int arrivalIndex ) const
+    {
+        const double timeOfFlight_ = arrivalEpochs_( arrivalIndex )
+                - departureEpochs_( departureIndex );
+
+        if ( !( timeOfFlight_ > 0.0 ) )
+        {
+            departureDeltaVs_( departureIndex, arrivalIndex ) = TUDAT_NAN;
+            arrivalDeltaVs_( departureIndex, arrivalIndex ) = TUDAT_NAN;
+            return;
+        }
+
+        // Solve Lambert problem; degenerate geometries are marked as infeasible, rather than
+        // aborting the evaluation of the grid.
+        Eigen::Vector3d departureVelocity_;
+        Eigen::Vector3d arrivalVelocity_;
+        try
+        {
+            solveLambertProblemIzzo(
+                        departureBodyStates_.block< 3, 1 >( 0, departureIndex ),
+                        arrivalBodyStates_.block< 3, 1 >( 0, arrivalIndex ), timeOfFlight_,
+                        gravitationalParameter_, departureVelocity_, arrivalVelocity_ );
+        }
+
+        catch ( std::runtime_error& )
+        {
+            departureVelocity_.setConstant( TUDAT_NAN );
+            arrivalVelocity_.setConstant( TUDAT_NAN );
+        }
+
+        departureDeltaVs_( departureIndex, arrivalIndex )
+                = ( departureVelocity_
+                    - departureBodyStates_.block< 3, 1 >( 3, departureIndex ) ).norm( );
+        arrivalDeltaVs_( departureIndex, arrivalIndex )
+                = ( arrivalBodyStates_.block< 3, 1 >( 3, arrivalIndex )
+                    - arrivalVelocity_ ).norm( );
+    }
+
+    //! Matrix of states of departure body at departure epochs.
+    const Eigen::MatrixXd& departureBodyStates_;
+
+    //! Matrix of states of arrival body at arrival epochs.
+    const Eigen::MatrixXd& arrivalBodyStates_;
+
+    //! Grid of departure epochs.
+    const Eigen::VectorXd& departureEpochs_;
+
+    //! Grid of arrival epochs.
+    const Eigen::VectorXd& arrivalEpochs_;
+
+    //! Gravitational parameter of central body.
+    const double gravitationalParameter_;
+
+    //! Number of departure and arrival epochs per tile.
+    const int tileSize_;
+
+    //! Number of tiles along the departure epoch grid.
+    const int numberOfDepartureTiles_;
+
+    //! Matrix in which departure delta-v's are stored.
+    Eigen::MatrixXd& departureDeltaVs_;
+
+    //! Matrix in which arrival delta-v's are stored.
+    Eigen::MatrixXd& arrivalDeltaVs_;
+};
+
+} // namespace
+
+//! Create grid of departure epochs covering one synodic period.
+Eigen::VectorXd createSynodicDepartureEpochGrid( const double startEpoch,
+                                                 const double orbitalPeriodOfDepartureBody,
+                                                 const double orbitalPeriodOfArrivalBody,
+                                                 const int numberOfEpochs )
+{
+    // Check if number of epochs is positive and throw an error if not.
+    if ( numberOfEpochs < 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Number of epochs should be positive." ) ) );
+    }
+
+    const double synodicPeriod_ = basic_astrodynamics::computeSynodicPeriod(
+                orbitalPeriodOfDepartureBody, orbitalPeriodOfArrivalBody );
+
+    return Eigen::VectorXd::LinSpaced(
+                numberOfEpochs, 0.0, synodicPeriod_ * static_cast< double >( numberOfEpochs - 1 )
+                / static_cast< double >( numberOfEpochs ) ).array( ) + startEpoch;
+}
+
+//! Compute porkchop plot of transfer delta-v's.
+void computePorkchopPlot( const BodyStateFunction& departureBodyStateFunction,
+                          const BodyStateFunction& arrivalBodyStateFunction,
+                          const Eigen::VectorXd& departureEpochs,
+                          const Eigen::VectorXd& arrivalEpochs,
+                          const double gravitationalParameter,
+                          Eigen::MatrixXd& departureDeltaVs, Eigen::MatrixXd& arrivalDeltaVs,
+                          const unsigned int numberOfThreads, const int tileSize )
+{
+    // Check if tile size is positive and throw an error if not.
+    if ( tileSize < 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Tile size should be positive." ) ) );
+    }
+
+    // Evaluate states of bodies once per epoch.
+    const Eigen::MatrixXd departureBodyStates_
+            = evaluateBodyStates( departureBodyStateFunction, departureEpochs );
+    const Eigen::MatrixXd arrivalBodyStates_
+            = evaluateBodyStates( arrivalBodyStateFunction, arrivalEpochs );
+
+    // Resize output matrices; this does not allocate if they already have the correct size.
+    departureDeltaVs.resize( departureEpochs.rows( ), arrivalEpochs.rows( ) );
+    arrivalDeltaVs.resize( departureEpochs.rows( ), arrivalEpochs.rows( ) );
+
+    // Evaluate grid tile by tile.
+    const int numberOfDepartureTiles_
+            = ( static_cast< int >( departureEpochs.rows( ) ) + tileSize - 1 ) / tileSize;
+    const int numberOfArrivalTiles_
+            = ( static_cast< int >( arrivalEpochs.rows( ) ) + tileSize - 1 ) / tileSize;
+
+    basics::executeParallelLoop(
+                numberOfDepartureTiles_ * numberOfArrivalTiles_,
+                PorkchopPlotTileEvaluation( departureBodyStates_, arrivalBodyStates_,
+                                            departureEpochs, arrivalEpochs,
+                                            gravitationalParameter, tileSize,
+                                            numberOfDepartureTiles_, departureDeltaVs,
+                                            arrivalDeltaVs ),
+                numberOfThreads, 1 );
+}
+
+} // namespace mission_segments
+} // namespace tudat
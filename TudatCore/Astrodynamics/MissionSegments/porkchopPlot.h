@@ -0,0 +1,113 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Izzo, D. Revisiting Lambert's problem, Celestial Mechanics and Dynamical Astronomy, 121(1),
+ *          1-15, 2015.
+ *
+ *    Notes
+ *      The state functions of the departure and arrival body are evaluated once per epoch, in the
+ *      calling thread, so they need not be thread-safe. The Lambert problems of the grid are then
+ *      divided into square tiles of departure and arrival epochs, which are distributed over the
+ *      threads; within a tile, the states of the bodies are read from small contiguous blocks and
+ *      the delta-v's are written column by column.
+ *
+ */
+
+#ifndef TUDAT_CORE_PORKCHOP_PLOT_H
+#define TUDAT_CORE_PORKCHOP_PLOT_H
+
+#include <boost/function.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Typedef for function returning Cartesian state of a body at a given epoch.
+typedef boost::function< basic_astrodynamics::orbital_element_conversions::Vector6d(
+        const double ) > BodyStateFunction;
+
+//! Create grid of departure epochs covering one synodic period.
+/*!
+ * Creates a grid of equidistant departure epochs covering one synodic period of the departure and
+ * arrival body, starting at a given epoch. Since the relative geometry of the bodies repeats
+ * (approximately) after one synodic period, such a grid contains all launch opportunities. The
+ * epoch one synodic period after the start epoch is not included in the grid.
+ * \param startEpoch First epoch of the grid.                                                   [s]
+ * \param orbitalPeriodOfDepartureBody Orbital period of the departure body.                    [s]
+ * \param orbitalPeriodOfArrivalBody Orbital period of the arrival body.                        [s]
+ * \param numberOfEpochs Number of epochs in the grid.
+ * \return Grid of departure epochs.                                                            [s]
+ */
+Eigen::VectorXd createSynodicDepartureEpochGrid( const double startEpoch,
+                                                 const double orbitalPeriodOfDepartureBody,
+                                                 const double orbitalPeriodOfArrivalBody,
+                                                 const int numberOfEpochs );
+
+//! Compute porkchop plot of transfer delta-v's.
+/*!
+ * Computes the delta-v's of zero-revolution, prograde Lambert transfers between a departure and
+ * arrival body, for all combinations of departure and arrival epochs on the given grids. The
+ * departure (arrival) delta-v is the norm of the difference between the velocity of the transfer
+ * orbit and that of the departure (arrival) body. Cells for which the arrival epoch does not lie
+ * after the departure epoch, or for which the Lambert problem has no solution (e.g., collinear
+ * positions), are set to NaN. The grid is evaluated in tiles, which are divided over multiple
+ * threads.
+ * \param departureBodyStateFunction Function returning the Cartesian state of the departure body
+ *          at a given epoch.
+ * \param arrivalBodyStateFunction Function returning the Cartesian state of the arrival body at a
+ *          given epoch.
+ * \param departureEpochs Grid of departure epochs.                                             [s]
+ * \param arrivalEpochs Grid of arrival epochs.                                                 [s]
+ * \param gravitationalParameter Gravitational parameter of central body.                 [m^3/s^2]
+ * \param departureDeltaVs Matrix in which departure delta-v's are stored, with one row per
+ *          departure epoch and one column per arrival epoch. If the matrix is preallocated with
+ *          the correct size, no memory is allocated; otherwise it is resized.                [m/s]
+ * \param arrivalDeltaVs Matrix in which arrival delta-v's are stored, with one row per departure
+ *          epoch and one column per arrival epoch. If the matrix is preallocated with the correct
+ *          size, no memory is allocated; otherwise it is resized.                            [m/s]
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \param tileSize Number of departure and arrival epochs per tile.
+ */
+void computePorkchopPlot( const BodyStateFunction& departureBodyStateFunction,
+                          const BodyStateFunction& arrivalBodyStateFunction,
+                          const Eigen::VectorXd& departureEpochs,
+                          const Eigen::VectorXd& arrivalEpochs,
+                          const double gravitationalParameter,
+                          Eigen::MatrixXd& departureDeltaVs, Eigen::MatrixXd& arrivalDeltaVs,
+                          const unsigned int numberOfThreads = 0, const int tileSize = 32 );
+
+} // namespace mission_segments
+} // namespace tudat
+
+#endif // TUDAT_CORE_PORKCHOP_PLOT_H
@@ -0,0 +1,227 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/enckePropagator.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/euler.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+using tudat::basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+//! Compute J2 perturbing acceleration of the Earth.
+/*!
+ * Computes the perturbing acceleration due to the J2 term of the gravity field of the Earth.
+ * \param time Current time (unused).
+ * \param cartesianState Current Cartesian state.
+ * \return Perturbing acceleration.
+ */
+Eigen::Vector3d computeEarthJ2Acceleration( const double time, const Vector6d& cartesianState )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+    const double earthJ2 = 1.08262668e-3;
+    const double earthRadius = 6378137.0;
+
+    const Eigen::Vector3d position = cartesianState.segment< 3 >( 0 );
+    const double radiusSquared = position.squaredNorm( );
+    const double zSquaredOverRadiusSquared = position.z( ) * position.z( ) / radiusSquared;
+    const double factor = -1.5 * earthGravitationalParameter * earthJ2 * earthRadius * earthRadius
+            / ( radiusSquared * radiusSquared * std::sqrt( radiusSquared ) );
+
+    return factor * Eigen::Vector3d(
+                position.x( ) * ( 1.0 - 5.0 * zSquaredOverRadiusSquared ),
+                position.y( ) * ( 1.0 - 5.0 * zSquaredOverRadiusSquared ),
+                position.z( ) * ( 3.0 - 5.0 * zSquaredOverRadiusSquared ) );
+}
+
+//! Cartesian state derivative for point-mass gravity with J2 perturbation.
+/*!
+ * Computes the Cartesian state derivative for point-mass gravity of the Earth with the J2
+ * perturbing acceleration of computeEarthJ2Acceleration().
+ * \param time Current time.
+ * \param cartesianState Current Cartesian state.
+ * \return Cartesian state derivative.
+ */
+Eigen::VectorXd computeJ2PerturbedCartesianStateDerivative( const double time,
+                                                            const Eigen::VectorXd& cartesianState )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+    const Eigen::Vector3d position = cartesianState.segment( 0, 3 );
+
+    Eigen::VectorXd stateDerivative( 6 );
+    stateDerivative.segment( 0, 3 ) = cartesianState.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 )
+            = -earthGravitationalParameter / ( position.norm( ) * position.squaredNorm( ) )
+            * position + computeEarthJ2Acceleration( time, cartesianState );
+    return stateDerivative;
+}
+
+BOOST_AUTO_TEST_SUITE( test_encke_propagator )
+
+//! Test if unperturbed orbit is propagated exactly using Encke's method.
+BOOST_AUTO_TEST_CASE( testUnperturbedEnckePropagation )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set initial Keplerian elements [m,-,rad,rad,rad,rad].
+    Eigen::VectorXd keplerianElements( 6 );
+    keplerianElements << 2.65e7, 0.7, 63.4 / 180.0 * PI, 270.0 / 180.0 * PI,
+            45.0 / 180.0 * PI, 20.0 / 180.0 * PI;
+    const propagators::KeplerOrbit keplerOrbit( keplerianElements, earthGravitationalParameter );
+
+    // Propagate orbit with a very large step size, using both the Euler and RK4 integrators. For
+    // an unperturbed orbit, the deviation remains zero, such that the result is exact for any
+    // integrator.
+    propagators::EnckePropagator eulerPropagator(
+                100.0, keplerOrbit.getStateAtTime( 0.0 ), earthGravitationalParameter,
+                propagators::EnckePropagator::PerturbingAccelerationFunction( ),
+                &propagators::createNumericalIntegrator<
+                numerical_integrators::EulerIntegratorXd > );
+    propagators::EnckePropagator rungeKutta4Propagator(
+                100.0, keplerOrbit.getStateAtTime( 0.0 ), earthGravitationalParameter,
+                propagators::EnckePropagator::PerturbingAccelerationFunction( ),
+                &propagators::createNumericalIntegrator<
+                numerical_integrators::RungeKutta4IntegratorXd > );
+
+    const double finalTime = 100.0 + 1.0e6;
+    const Vector6d expectedState = keplerOrbit.getStateAtTime( 1.0e6 );
+    const Vector6d eulerState = eulerPropagator.propagateTo( finalTime, 3.0e4 );
+    const Vector6d rungeKutta4State = rungeKutta4Propagator.propagateTo( finalTime, 3.0e4 );
+
+    BOOST_CHECK_SMALL( eulerPropagator.getCurrentTime( ) - finalTime, 1.0e-9 );
+    BOOST_CHECK_EQUAL( eulerPropagator.getNumberOfRectifications( ), 0 );
+    BOOST_CHECK_SMALL( ( eulerState - expectedState ).segment( 0, 3 ).norm( ), 1.0e-4 );
+    BOOST_CHECK_SMALL( ( eulerState - expectedState ).segment( 3, 3 ).norm( ), 1.0e-7 );
+    BOOST_CHECK_SMALL( ( rungeKutta4State - expectedState ).segment( 0, 3 ).norm( ), 1.0e-4 );
+    BOOST_CHECK_SMALL( ( rungeKutta4State - expectedState ).segment( 3, 3 ).norm( ), 1.0e-7 );
+
+    // Propagate back to the initial time.
+    const Vector6d initialState = rungeKutta4Propagator.propagateTo( 100.0, 3.0e4 );
+    BOOST_CHECK_SMALL( ( initialState - keplerOrbit.getStateAtTime( 0.0 ) ).segment( 0, 3 )
+                       .norm( ), 1.0e-4 );
+}
+
+//! Test if J2-perturbed orbit is propagated more accurately with Encke's than Cowell's method.
+BOOST_AUTO_TEST_CASE( testJ2PerturbedEnckePropagation )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set initial state of a low Earth orbit, and propagate over three orbital periods.
+    Vector6d keplerianElements;
+    keplerianElements << 7.0e6, 0.05, 50.0 / 180.0 * PI, 1.0, 2.0, 0.5;
+    const Vector6d initialState = convertKeplerianToCartesianElements(
+                keplerianElements, earthGravitationalParameter );
+    const double finalTime = 3.0 * 2.0 * PI * std::sqrt(
+                std::pow( keplerianElements( semiMajorAxisIndex ), 3.0 )
+                / earthGravitationalParameter );
+
+    // Compute reference solution using Cowell's method with a small step size.
+    numerical_integrators::RungeKutta4IntegratorXd referenceIntegrator(
+                &computeJ2PerturbedCartesianStateDerivative, 0.0, initialState );
+    const Eigen::VectorXd referenceState = referenceIntegrator.integrateTo( finalTime, 1.0 );
+
+    // Propagate with Cowell's and Encke's methods with a large step size.
+    const double stepSize = 120.0;
+    numerical_integrators::RungeKutta4IntegratorXd cowellIntegrator(
+                &computeJ2PerturbedCartesianStateDerivative, 0.0, initialState );
+    const Eigen::VectorXd cowellState = cowellIntegrator.integrateTo( finalTime, stepSize );
+
+    propagators::EnckePropagator enckePropagator(
+                0.0, initialState, earthGravitationalParameter, &computeEarthJ2Acceleration,
+                &propagators::createNumericalIntegrator<
+                numerical_integrators::RungeKutta4IntegratorXd > );
+    const Vector6d enckeState = enckePropagator.propagateTo( finalTime, stepSize );
+
+    // Check that the orbit has actually been perturbed, and that the error of Encke's method is
+    // much smaller than that of Cowell's method.
+    const double cowellError = ( cowellState - referenceState ).segment( 0, 3 ).norm( );
+    const double enckeError = ( enckeState - referenceState ).segment( 0, 3 ).norm( );
+    BOOST_CHECK_GT( ( propagators::KeplerOrbit( keplerianElements, earthGravitationalParameter )
+                      .getStateAtTime( finalTime ) - referenceState ).segment( 0, 3 ).norm( ),
+                    1.0e4 );
+    BOOST_CHECK_LT( enckeError, 2.0 );
+    BOOST_CHECK_LT( 1000.0 * enckeError, cowellError );
+
+    // Propagate with a small rectification threshold, and check that the reference orbit is
+    // rectified without loss of accuracy.
+    propagators::EnckePropagator rectifiedEnckePropagator(
+                0.0, initialState, earthGravitationalParameter, &computeEarthJ2Acceleration,
+                &propagators::createNumericalIntegrator<
+                numerical_integrators::RungeKutta4IntegratorXd >, 1.0e-5 );
+    const Vector6d rectifiedEnckeState = rectifiedEnckePropagator.propagateTo( finalTime,
+                                                                              stepSize );
+    BOOST_CHECK_GT( rectifiedEnckePropagator.getNumberOfRectifications( ),
+                    enckePropagator.getNumberOfRectifications( ) );
+    BOOST_CHECK_GT( rectifiedEnckePropagator.getReferenceEpoch( ), 0.0 );
+    BOOST_CHECK_LT( ( rectifiedEnckeState - referenceState ).segment( 0, 3 ).norm( ), 5.0 );
+}
+
+//! Test if an error is thrown for an invalid rectification threshold.
+BOOST_AUTO_TEST_CASE( testEnckePropagatorErrors )
+{
+    Vector6d initialState;
+    initialState << 7.0e6, 0.0, 0.0, 0.0, 7.5e3, 0.0;
+    BOOST_CHECK_THROW( propagators::EnckePropagator(
+                           0.0, initialState, 3.986004418e14,
+                           &computeEarthJ2Acceleration,
+                           &propagators::createNumericalIntegrator<
+                           numerical_integrators::RungeKutta4IntegratorXd >, 0.0 ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,233 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/j2SecularPropagator.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerPropagator.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+
+BOOST_AUTO_TEST_SUITE( test_j2_secular_propagator )
+
+//! Gravitational parameter of the Earth.                                                [m^3/s^2]
+const double earthGravitationalParameter = 3.986004418e14;
+
+//! J2 coefficient of the Earth.                                                                [-]
+const double earthJ2 = 1.08262668e-3;
+
+//! Equatorial radius of the Earth.                                                             [m]
+const double earthRadius = 6378137.0;
+
+//! Test if J2 secular rates are computed correctly.
+BOOST_AUTO_TEST_CASE( testJ2SecularRates )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    // Test 1: Sun-synchronous orbit. The inclination of a circular orbit for which the node
+    //         rotates once per tropical year follows from inverting the nodal rate equation.
+    {
+        const double semiMajorAxis = 7078.137e3;
+        const double sunSynchronousNodeRate = 2.0 * PI / ( 365.2421897 * 86400.0 );
+        const double meanMotion = std::sqrt( earthGravitationalParameter
+                                             / std::pow( semiMajorAxis, 3.0 ) );
+        const double inclination = std::acos(
+                    -2.0 / 3.0 * sunSynchronousNodeRate / ( meanMotion * earthJ2 )
+                    * std::pow( semiMajorAxis / earthRadius, 2.0 ) );
+
+        // Check that inclination is the well-known value of about 98.19 degrees for this
+        // altitude of 700 km.
+        BOOST_CHECK_CLOSE( inclination * 180.0 / PI, 98.19, 0.01 );
+
+        Vector6d keplerianElements;
+        keplerianElements << semiMajorAxis, 0.0, inclination, 0.0, 0.0, 0.0;
+        const Eigen::Vector3d secularRates = propagators::computeJ2SecularRates(
+                    keplerianElements, earthGravitationalParameter, earthJ2, earthRadius );
+        BOOST_CHECK_CLOSE_FRACTION( secularRates( 1 ), sunSynchronousNodeRate, 1.0e-14 );
+    }
+
+    // Test 2: Orbit at critical inclination, for which the argument of periapsis is frozen.
+    {
+        Vector6d keplerianElements;
+        keplerianElements << 26562.0e3, 0.74, std::acos( std::sqrt( 0.2 ) ), 1.5 * PI, 1.0, 0.0;
+        const Eigen::Vector3d secularRates = propagators::computeJ2SecularRates(
+                    keplerianElements, earthGravitationalParameter, earthJ2, earthRadius );
+        BOOST_CHECK_SMALL( secularRates( 0 ), 1.0e-22 );
+
+        // Check that the mean anomaly rate of an orbit at the "magic" inclination of
+        // acos( sqrt( 1 / 3 ) ) is the Kepler mean motion.
+        keplerianElements( inclinationIndex ) = std::acos( std::sqrt( 1.0 / 3.0 ) );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    propagators::computeJ2SecularRates( keplerianElements,
+                                                        earthGravitationalParameter, earthJ2,
+                                                        earthRadius )( 2 ),
+                    std::sqrt( earthGravitationalParameter / std::pow( 26562.0e3, 3.0 ) ),
+                    1.0e-15 );
+    }
+}
+
+//! Test if orbits are propagated correctly with J2 secular rates.
+BOOST_AUTO_TEST_CASE( testJ2SecularPropagation )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    Vector6d initialState;
+    initialState << 7000.0e3, 0.05, 0.9, 5.0, 6.0, 2.5;
+
+    // Test 1: Without J2, the propagation should be equal to Kepler propagation.
+    {
+        const Vector6d propagatedState = propagators::propagateJ2SecularOrbit(
+                    initialState, 86400.0, earthGravitationalParameter, 0.0, earthRadius );
+        const Eigen::VectorXd expectedState = propagators::propagateKeplerOrbit(
+                    initialState, 86400.0, earthGravitationalParameter );
+
+        BOOST_CHECK_SMALL( std::fabs( propagatedState( trueAnomalyIndex )
+                                      - expectedState( trueAnomalyIndex ) ), 1.0e-9 );
+        BOOST_CHECK_EQUAL( propagatedState( semiMajorAxisIndex ), initialState( 0 ) );
+        BOOST_CHECK_CLOSE_FRACTION( propagatedState( argumentOfPeriapsisIndex ), 5.0, 1.0e-15 );
+    }
+
+    // Test 2: With J2, the angles should advance with the secular rates, and forward and backward
+    //         propagation should cancel.
+    {
+        const double propagationTime = 10.0 * 86400.0;
+        const Eigen::Vector3d secularRates = propagators::computeJ2SecularRates(
+                    initialState, earthGravitationalParameter, earthJ2, earthRadius );
+        const Vector6d propagatedState = propagators::propagateJ2SecularOrbit(
+                    initialState, propagationTime, earthGravitationalParameter, earthJ2,
+                    earthRadius );
+
+        BOOST_CHECK_CLOSE_FRACTION(
+                    propagatedState( longitudeOfAscendingNodeIndex ),
+                    std::fmod( 6.0 + secularRates( 1 ) * propagationTime + 2.0 * PI, 2.0 * PI ),
+                    1.0e-12 );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    propagatedState( argumentOfPeriapsisIndex ),
+                    std::fmod( 5.0 + secularRates( 0 ) * propagationTime, 2.0 * PI ), 1.0e-12 );
+
+        const Vector6d backPropagatedState = propagators::propagateJ2SecularOrbit(
+                    propagatedState, -propagationTime, earthGravitationalParameter, earthJ2,
+                    earthRadius );
+        BOOST_CHECK_SMALL( std::fabs( backPropagatedState( trueAnomalyIndex ) - 2.5 ), 1.0e-9 );
+        BOOST_CHECK_SMALL( std::fabs( backPropagatedState( argumentOfPeriapsisIndex ) - 5.0 ),
+                           1.0e-12 );
+        BOOST_CHECK_SMALL( std::fabs( backPropagatedState( longitudeOfAscendingNodeIndex )
+                                      - 6.0 ), 1.0e-12 );
+    }
+
+    // Test 3: An error should be thrown for hyperbolic orbits.
+    {
+        Vector6d hyperbolicState = initialState;
+        hyperbolicState( semiMajorAxisIndex ) = -7000.0e3;
+        hyperbolicState( eccentricityIndex ) = 1.5;
+        BOOST_CHECK_THROW( propagators::propagateJ2SecularOrbit(
+                               hyperbolicState, 100.0, earthGravitationalParameter, earthJ2,
+                               earthRadius ), std::runtime_error );
+    }
+}
+
+//! Test if catalog of orbits is propagated correctly with J2 secular rates.
+BOOST_AUTO_TEST_CASE( testJ2SecularCatalogPropagation )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    // Create catalog of orbits with random elements and propagation times; the number of orbits
+    // is not a multiple of the block size.
+    const int numberOfOrbits = 1001;
+    Eigen::MatrixXd initialStates = Eigen::MatrixXd::Random( 6, numberOfOrbits );
+    initialStates.row( semiMajorAxisIndex ) = 7.0e6 + 3.0e6 * initialStates.row( 0 ).array( );
+    initialStates.row( eccentricityIndex ) = 0.45 + 0.45 * initialStates.row( 1 ).array( );
+    initialStates.row( inclinationIndex ) = 0.5 * PI + 0.5 * PI * initialStates.row( 2 ).array( );
+    initialStates.bottomRows( 3 ) *= PI;
+    const Eigen::VectorXd propagationTimes
+            = 1.0e6 * Eigen::VectorXd::Random( numberOfOrbits );
+
+    // Propagate catalog with a single and with multiple threads.
+    Eigen::MatrixXd finalStates;
+    propagators::propagateJ2SecularOrbits( initialStates, propagationTimes,
+                                           earthGravitationalParameter, earthJ2, earthRadius,
+                                           finalStates, 1 );
+    Eigen::MatrixXd finalStatesWithThreads;
+    propagators::propagateJ2SecularOrbits( initialStates, propagationTimes,
+                                           earthGravitationalParameter, earthJ2, earthRadius,
+                                           finalStatesWithThreads, 4 );
+
+    // Check that the results are independent of the number of threads, and agree with the
+    // single-orbit propagation up to rounding differences of the array operations.
+    BOOST_CHECK_EQUAL( ( finalStates - finalStatesWithThreads ).norm( ), 0.0 );
+    for ( int orbitIndex = 0; orbitIndex < numberOfOrbits; orbitIndex++ )
+    {
+        const Vector6d expectedState = propagators::propagateJ2SecularOrbit(
+                    initialStates.col( orbitIndex ), propagationTimes( orbitIndex ),
+                    earthGravitationalParameter, earthJ2, earthRadius );
+        for ( int elementIndex = 0; elementIndex < 6; elementIndex++ )
+        {
+            // Angles close to the boundaries of their range may be wrapped differently.
+            const double difference = std::fabs( finalStates( elementIndex, orbitIndex )
+                                                 - expectedState( elementIndex ) );
+            BOOST_CHECK_SMALL( std::min( difference, std::fabs( difference - 2.0 * PI ) ),
+                               1.0e-6 );
+        }
+    }
+
+    // Check that errors are thrown for a mismatch in sizes and for non-elliptical orbits.
+    BOOST_CHECK_THROW( propagators::propagateJ2SecularOrbits(
+                           initialStates, propagationTimes.head( 10 ),
+                           earthGravitationalParameter, earthJ2, earthRadius, finalStates ),
+                       std::runtime_error );
+    initialStates( eccentricityIndex, 500 ) = 1.0;
+    BOOST_CHECK_THROW( propagators::propagateJ2SecularOrbits(
+                           initialStates, propagationTimes, earthGravitationalParameter,
+                           earthJ2, earthRadius, finalStates ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,200 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerPropagator.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+
+//! Check if Cartesian states match.
+/*!
+ * Checks if two Cartesian states match, using tolerances relative to the norm of the expected
+ * position and velocity.
+ * \param expectedCartesianState Expected Cartesian state.
+ * \param computedCartesianState Computed Cartesian state.
+ * \param relativeTolerance Relative tolerance.
+ */
+void checkCartesianStatesMatch( const Eigen::VectorXd& expectedCartesianState,
+                                const Eigen::VectorXd& computedCartesianState,
+                                const double relativeTolerance )
+{
+    const double positionTolerance
+            = relativeTolerance * expectedCartesianState.segment( 0, 3 ).norm( );
+    const double velocityTolerance
+            = relativeTolerance * expectedCartesianState.segment( 3, 3 ).norm( );
+
+    BOOST_CHECK_SMALL( ( expectedCartesianState.segment( 0, 3 )
+                         - computedCartesianState.segment( 0, 3 ) ).norm( ), positionTolerance );
+    BOOST_CHECK_SMALL( ( expectedCartesianState.segment( 3, 3 )
+                         - computedCartesianState.segment( 3, 3 ) ).norm( ), velocityTolerance );
+}
+
+BOOST_AUTO_TEST_SUITE( test_kepler_orbit )
+
+//! Test if Kepler orbit is sampled correctly at true anomalies, mean anomalies and times.
+BOOST_AUTO_TEST_CASE( testKeplerOrbitSampling )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set Keplerian elements of an elliptical and a hyperbolic orbit [m,-,rad,rad,rad,rad].
+    Eigen::MatrixXd keplerianElements( 6, 2 );
+    keplerianElements.col( 0 ) << 2.65e7, 0.74, 63.4 / 180.0 * PI, 270.0 / 180.0 * PI,
+            45.0 / 180.0 * PI, 20.0 / 180.0 * PI;
+    keplerianElements.col( 1 ) << -4.0e7, 1.8, 0.3, 1.2, -2.1, -0.4;
+
+    // Set samples, which lie between the asymptotes of the hyperbolic orbit.
+    Eigen::VectorXd samples( 7 );
+    samples << -1.5, -0.7, -1.0e-3, 0.0, 0.2, 1.1, 1.9;
+
+    for ( int orbitIndex = 0; orbitIndex < 2; orbitIndex++ )
+    {
+        const Eigen::VectorXd orbitElements = keplerianElements.col( orbitIndex );
+        const double eccentricity = orbitElements( eccentricityIndex );
+
+        // Create Kepler orbit.
+        const propagators::KeplerOrbit keplerOrbit( orbitElements,
+                                                    earthGravitationalParameter );
+
+        // Compute states at samples, interpreted as true anomalies, mean anomalies and times.
+        Eigen::MatrixXd statesAtTrueAnomalies;
+        keplerOrbit.getStatesAtTrueAnomalies( samples, statesAtTrueAnomalies );
+        Eigen::MatrixXd statesAtMeanAnomalies;
+        keplerOrbit.getStatesAtMeanAnomalies( samples, statesAtMeanAnomalies );
+        const Eigen::VectorXd times = 1.0e4 * samples;
+        Eigen::MatrixXd statesAtTimes;
+        keplerOrbit.getStatesAtTimes( times, statesAtTimes );
+
+        BOOST_CHECK_EQUAL( statesAtTrueAnomalies.cols( ), samples.rows( ) );
+        BOOST_CHECK_EQUAL( statesAtMeanAnomalies.cols( ), samples.rows( ) );
+        BOOST_CHECK_EQUAL( statesAtTimes.cols( ), samples.rows( ) );
+
+        for ( int i = 0; i < samples.rows( ); i++ )
+        {
+            // Check state at true anomaly against Keplerian to Cartesian element conversion.
+            Eigen::VectorXd sampleElements = orbitElements;
+            sampleElements( trueAnomalyIndex ) = samples( i );
+            const Eigen::VectorXd expectedStateAtTrueAnomaly
+                    = convertKeplerianToCartesianElements( sampleElements,
+                                                           earthGravitationalParameter );
+            checkCartesianStatesMatch( expectedStateAtTrueAnomaly,
+                                       keplerOrbit.getStateAtTrueAnomaly( samples( i ) ),
+                                       1.0e-14 );
+            checkCartesianStatesMatch( expectedStateAtTrueAnomaly,
+                                       statesAtTrueAnomalies.col( i ), 1.0e-14 );
+
+            // Check state at mean anomaly against anomaly and element conversions.
+            sampleElements( trueAnomalyIndex ) = convertEccentricAnomalyToTrueAnomaly(
+                        convertMeanAnomalyToEccentricAnomaly( samples( i ), eccentricity ),
+                        eccentricity );
+            const Eigen::VectorXd expectedStateAtMeanAnomaly
+                    = convertKeplerianToCartesianElements( sampleElements,
+                                                           earthGravitationalParameter );
+            checkCartesianStatesMatch( expectedStateAtMeanAnomaly,
+                                       keplerOrbit.getStateAtMeanAnomaly( samples( i ) ),
+                                       1.0e-12 );
+            checkCartesianStatesMatch( expectedStateAtMeanAnomaly,
+                                       statesAtMeanAnomalies.col( i ), 1.0e-12 );
+
+            // Check state at time against single-orbit Kepler propagator.
+            const Eigen::VectorXd expectedStateAtTime = convertKeplerianToCartesianElements(
+                        propagators::propagateKeplerOrbit( orbitElements, times( i ),
+                                                           earthGravitationalParameter ),
+                        earthGravitationalParameter );
+            checkCartesianStatesMatch( expectedStateAtTime,
+                                       keplerOrbit.getStateAtTime( times( i ) ), 1.0e-12 );
+            checkCartesianStatesMatch( expectedStateAtTime, statesAtTimes.col( i ), 1.0e-12 );
+        }
+
+        // Check if the state at epoch is recovered.
+        checkCartesianStatesMatch(
+                    convertKeplerianToCartesianElements( orbitElements,
+                                                         earthGravitationalParameter ),
+                    keplerOrbit.getStateAtTime( 0.0 ), 1.0e-12 );
+    }
+}
+
+//! Test if parabolic and invalid Kepler orbits are handled correctly.
+BOOST_AUTO_TEST_CASE( testKeplerOrbitLimitCases )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set Keplerian elements of parabolic orbit, with the semi-latus rectum as first element
+    // [m,-,rad,rad,rad,rad].
+    Eigen::VectorXd keplerianElements( 6 );
+    keplerianElements << 1.2e7, 1.0, 0.8, 2.0, 0.5, 0.0;
+
+    // Create Kepler orbit.
+    const propagators::KeplerOrbit keplerOrbit( keplerianElements, earthGravitationalParameter );
+
+    // Check if parabolic orbit can be sampled at true anomaly.
+    keplerianElements( trueAnomalyIndex ) = 2.5;
+    checkCartesianStatesMatch(
+                convertKeplerianToCartesianElements( keplerianElements,
+                                                     earthGravitationalParameter ),
+                keplerOrbit.getStateAtTrueAnomaly( 2.5 ), 1.0e-14 );
+
+    // Check if an error is thrown when sampling parabolic orbit at mean anomaly or time.
+    BOOST_CHECK_THROW( keplerOrbit.getStateAtMeanAnomaly( 0.5 ), std::runtime_error );
+    BOOST_CHECK_THROW( keplerOrbit.getStateAtTime( 100.0 ), std::runtime_error );
+
+    // Check if an error is thrown for negative eccentricity.
+    keplerianElements( eccentricityIndex ) = -0.1;
+    BOOST_CHECK_THROW( propagators::KeplerOrbit( keplerianElements, earthGravitationalParameter ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
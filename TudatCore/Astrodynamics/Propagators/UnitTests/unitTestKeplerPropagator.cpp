@@ -0,0 +1,198 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerPropagator.h"
+#include "TudatCore/Basics/testMacros.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+
+BOOST_AUTO_TEST_SUITE( test_kepler_propagator )
+
+//! Test if Kepler orbit is propagated correctly.
+BOOST_AUTO_TEST_CASE( testKeplerOrbitPropagation )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Case 1: Elliptical orbit around the Earth.
+    // The benchmark data is obtained from (Vallado, 2004), Example 2-4.
+    {
+        // Set Earth gravitational parameter [m^3/s^2].
+        const double earthGravitationalParameter = 3.986004418e14;
+
+        // Set initial Cartesian elements [m,m,m,m/s,m/s,m/s].
+        Eigen::VectorXd initialCartesianElements( 6 );
+        initialCartesianElements << 1131.340e3, -2282.343e3, 6672.423e3,
+                -5.64305e3, 4.30333e3, 2.42879e3;
+
+        // Set propagation time [s].
+        const double propagationTime = 40.0 * 60.0;
+
+        // Set expected Cartesian elements [m,m,m,m/s,m/s,m/s].
+        Eigen::VectorXd expectedCartesianElements( 6 );
+        expectedCartesianElements << -4219.7527e3, 4363.0292e3, -3958.7666e3,
+                3.689866e3, -1.916735e3, -6.112511e3;
+
+        // Propagate Kepler orbit.
+        const Eigen::VectorXd propagatedKeplerianElements = propagators::propagateKeplerOrbit(
+                    convertCartesianToKeplerianElements( initialCartesianElements,
+                                                         earthGravitationalParameter ),
+                    propagationTime, earthGravitationalParameter );
+
+        // Check if propagated Cartesian elements match the expected values.
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                    expectedCartesianElements,
+                    convertKeplerianToCartesianElements( propagatedKeplerianElements,
+                                                         earthGravitationalParameter ), 1.0e-6 );
+    }
+
+    // Case 2: Elliptical orbit propagated over one orbital period, forwards and backwards.
+    {
+        // Set Earth gravitational parameter [m^3/s^2].
+        const double earthGravitationalParameter = 3.986004418e14;
+
+        // Set Keplerian elements [m,-,rad,rad,rad,rad].
+        Eigen::VectorXd keplerianElements( 6 );
+        keplerianElements << 2.65e7, 0.74, 63.4 / 180.0 * PI, 270.0 / 180.0 * PI,
+                45.0 / 180.0 * PI, 20.0 / 180.0 * PI;
+
+        // Compute orbital period [s].
+        const double orbitalPeriod = 2.0 * PI * std::sqrt(
+                    std::pow( keplerianElements( semiMajorAxisIndex ), 3.0 )
+                    / earthGravitationalParameter );
+
+        // Check if true anomaly is recovered after one period in both directions.
+        BOOST_CHECK_CLOSE_FRACTION(
+                    keplerianElements( trueAnomalyIndex ),
+                    propagators::propagateKeplerOrbit( keplerianElements, orbitalPeriod,
+                                                       earthGravitationalParameter )
+                    ( trueAnomalyIndex ), 1.0e-12 );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    keplerianElements( trueAnomalyIndex ),
+                    propagators::propagateKeplerOrbit( keplerianElements, -orbitalPeriod,
+                                                       earthGravitationalParameter )
+                    ( trueAnomalyIndex ), 1.0e-12 );
+    }
+}
+
+//! Test if catalog of Kepler orbits is propagated correctly.
+BOOST_AUTO_TEST_CASE( testKeplerOrbitCatalogPropagation )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Sun gravitational parameter [m^3/s^2].
+    const double sunGravitationalParameter = 1.32712440018e20;
+
+    // Set catalog of elliptical and hyperbolic orbits [m,-,rad,rad,rad,rad].
+    const int numberOfOrbits = 200;
+    Eigen::MatrixXd keplerianElementsCatalog( 6, numberOfOrbits );
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        const bool isHyperbolic = ( i % 4 == 0 );
+        keplerianElementsCatalog( eccentricityIndex, i ) = isHyperbolic
+                ? 1.05 + 0.01 * i : 0.005 * i;
+        keplerianElementsCatalog( semiMajorAxisIndex, i ) = isHyperbolic
+                ? -2.0e11 - 1.0e9 * i : 1.0e11 + 1.0e9 * i;
+        keplerianElementsCatalog( inclinationIndex, i ) = 0.015 * i;
+        keplerianElementsCatalog( argumentOfPeriapsisIndex, i ) = 0.03 * i;
+        keplerianElementsCatalog( longitudeOfAscendingNodeIndex, i ) = -0.02 * i;
+        keplerianElementsCatalog( trueAnomalyIndex, i ) = isHyperbolic ? -0.5 + 0.004 * i
+                                                                       : 0.07 * i;
+    }
+
+    // Set propagation times [s].
+    Eigen::VectorXd propagationTimes( 5 );
+    propagationTimes << 0.0, 1.0e5, -3.0e6, 2.5e7, 1.0e8;
+
+    // Propagate catalog, using multiple threads and a single thread.
+    Eigen::MatrixXd computedCartesianStates;
+    propagators::propagateKeplerOrbits( keplerianElementsCatalog, propagationTimes,
+                                        sunGravitationalParameter, computedCartesianStates, 4 );
+    Eigen::MatrixXd computedCartesianStatesSingleThread(
+                6 * numberOfOrbits, propagationTimes.rows( ) );
+    propagators::propagateKeplerOrbits( keplerianElementsCatalog, propagationTimes,
+                                        sunGravitationalParameter,
+                                        computedCartesianStatesSingleThread, 1 );
+
+    // Check if results are independent of the number of threads.
+    BOOST_CHECK( computedCartesianStates == computedCartesianStatesSingleThread );
+
+    // Check if catalog states match the states computed by the single-orbit propagator.
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        for ( int j = 0; j < propagationTimes.rows( ); j++ )
+        {
+            const Eigen::VectorXd expectedCartesianState = convertKeplerianToCartesianElements(
+                        propagators::propagateKeplerOrbit(
+                            keplerianElementsCatalog.col( i ), propagationTimes( j ),
+                            sunGravitationalParameter ), sunGravitationalParameter );
+
+            const Eigen::VectorXd computedCartesianState
+                    = computedCartesianStates.col( j ).segment( 6 * i, 6 );
+
+            // Set position and velocity tolerances.
+            const double positionTolerance
+                    = 1.0e-10 * expectedCartesianState.segment( 0, 3 ).norm( );
+            const double velocityTolerance
+                    = 1.0e-10 * expectedCartesianState.segment( 3, 3 ).norm( );
+
+            // Check if computed position and velocity match the expected values.
+            BOOST_CHECK_SMALL( ( expectedCartesianState.segment( 0, 3 )
+                                 - computedCartesianState.segment( 0, 3 ) ).norm( ),
+                               positionTolerance );
+            BOOST_CHECK_SMALL( ( expectedCartesianState.segment( 3, 3 )
+                                 - computedCartesianState.segment( 3, 3 ) ).norm( ),
+                               velocityTolerance );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
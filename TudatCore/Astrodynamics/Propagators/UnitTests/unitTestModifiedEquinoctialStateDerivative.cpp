@@ -0,0 +1,185 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+
+#include <boost/bind.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/modifiedEquinoctialElementConversions.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Astrodynamics/Propagators/modifiedEquinoctialStateDerivative.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+using tudat::basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+//! Compute constant along-track perturbing acceleration.
+/*!
+ * Computes a perturbing acceleration of constant magnitude along the velocity vector.
+ * \param time Current time (unused).
+ * \param cartesianState Current Cartesian state.
+ * \return Perturbing acceleration.
+ */
+Eigen::Vector3d computeAlongTrackAcceleration( const double time, const Vector6d& cartesianState )
+{
+    return 1.0e-4 * cartesianState.segment< 3 >( 3 ).normalized( );
+}
+
+//! Cartesian state derivative for point-mass gravity with along-track perturbation.
+/*!
+ * Computes the Cartesian state derivative for point-mass gravity of the Earth with the
+ * along-track perturbing acceleration of computeAlongTrackAcceleration().
+ * \param time Current time.
+ * \param cartesianState Current Cartesian state.
+ * \return Cartesian state derivative.
+ */
+Eigen::VectorXd computePerturbedCartesianStateDerivative( const double time,
+                                                          const Eigen::VectorXd& cartesianState )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+    const Eigen::Vector3d position = cartesianState.segment( 0, 3 );
+
+    Eigen::VectorXd stateDerivative( 6 );
+    stateDerivative.segment( 0, 3 ) = cartesianState.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 )
+            = -earthGravitationalParameter / ( position.norm( ) * position.squaredNorm( ) )
+            * position + computeAlongTrackAcceleration( time, cartesianState );
+    return stateDerivative;
+}
+
+BOOST_AUTO_TEST_SUITE( test_modified_equinoctial_state_derivative )
+
+//! Test if unperturbed orbit is propagated correctly using modified equinoctial elements.
+BOOST_AUTO_TEST_CASE( testUnperturbedModifiedEquinoctialPropagation )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set initial Keplerian elements [m,-,rad,rad,rad,rad] and compute orbital period [s].
+    Eigen::VectorXd keplerianElements( 6 );
+    keplerianElements << 2.65e7, 0.3, 63.4 / 180.0 * PI, 270.0 / 180.0 * PI,
+            45.0 / 180.0 * PI, 20.0 / 180.0 * PI;
+    const double orbitalPeriod = 2.0 * PI * std::sqrt(
+                keplerianElements( semiMajorAxisIndex ) * keplerianElements( semiMajorAxisIndex )
+                * keplerianElements( semiMajorAxisIndex ) / earthGravitationalParameter );
+
+    const Eigen::VectorXd initialModifiedEquinoctialElements
+            = convertKeplerianToModifiedEquinoctialElements( keplerianElements );
+
+    // Propagate modified equinoctial elements over one orbital period, using 100 steps.
+    const propagators::ModifiedEquinoctialStateDerivative stateDerivative(
+                earthGravitationalParameter );
+    numerical_integrators::RungeKutta4IntegratorXd integrator(
+                boost::bind( &propagators::ModifiedEquinoctialStateDerivative::
+                             computeStateDerivative, &stateDerivative, _1, _2 ),
+                0.0, initialModifiedEquinoctialElements );
+    const Eigen::VectorXd finalModifiedEquinoctialElements
+            = integrator.integrateTo( orbitalPeriod, orbitalPeriod / 100.0 );
+
+    // Check if only the true longitude has changed.
+    BOOST_CHECK( finalModifiedEquinoctialElements.segment( 0, 5 )
+                 == initialModifiedEquinoctialElements.segment( 0, 5 ) );
+
+    // Check if the propagated state matches the analytical Kepler orbit.
+    const Vector6d expectedCartesianState = propagators::KeplerOrbit(
+                keplerianElements, earthGravitationalParameter ).getStateAtTime( orbitalPeriod );
+    const Vector6d computedCartesianState = convertModifiedEquinoctialToCartesianElements(
+                finalModifiedEquinoctialElements, earthGravitationalParameter );
+    BOOST_CHECK_SMALL( ( computedCartesianState - expectedCartesianState ).segment( 0, 3 ).norm( ),
+                       1.0e-5 * expectedCartesianState.segment( 0, 3 ).norm( ) );
+}
+
+//! Test if perturbed orbit is propagated correctly using modified equinoctial elements.
+BOOST_AUTO_TEST_CASE( testPerturbedModifiedEquinoctialPropagation )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set initial Keplerian elements of a near-circular, near-equatorial orbit
+    // [m,-,rad,rad,rad,rad], and propagation time [s].
+    Eigen::VectorXd keplerianElements( 6 );
+    keplerianElements << 7.0e6, 1.0e-3, 1.0e-3, 1.0, 2.0, 3.0;
+    const double propagationTime = 2.0e4;
+
+    const Eigen::VectorXd initialCartesianState
+            = convertKeplerianToCartesianElements( keplerianElements,
+                                                   earthGravitationalParameter );
+
+    // Propagate Cartesian state with small step size, as reference.
+    numerical_integrators::RungeKutta4IntegratorXd cartesianIntegrator(
+                &computePerturbedCartesianStateDerivative, 0.0, initialCartesianState );
+    const Eigen::VectorXd expectedCartesianState
+            = cartesianIntegrator.integrateTo( propagationTime, 1.0 );
+
+    // Propagate modified equinoctial elements with large step size.
+    const propagators::ModifiedEquinoctialStateDerivative stateDerivative(
+                earthGravitationalParameter, &computeAlongTrackAcceleration );
+    numerical_integrators::RungeKutta4IntegratorXd integrator(
+                boost::bind( &propagators::ModifiedEquinoctialStateDerivative::
+                             computeStateDerivative, &stateDerivative, _1, _2 ),
+                0.0, convertCartesianToModifiedEquinoctialElements(
+                    initialCartesianState, earthGravitationalParameter ) );
+    const Vector6d computedCartesianState = convertModifiedEquinoctialToCartesianElements(
+                integrator.integrateTo( propagationTime, 60.0 ), earthGravitationalParameter );
+
+    // Check if the perturbation has had a significant effect, and if the propagated state
+    // matches the reference.
+    const Vector6d unperturbedCartesianState = propagators::KeplerOrbit(
+                keplerianElements, earthGravitationalParameter ).getStateAtTime( propagationTime );
+    BOOST_CHECK_GT( ( unperturbedCartesianState - expectedCartesianState ).segment( 0, 3 )
+                    .norm( ), 1.0e4 );
+    BOOST_CHECK_SMALL( ( computedCartesianState - expectedCartesianState ).segment( 0, 3 ).norm( ),
+                       1.0 );
+    BOOST_CHECK_SMALL( ( computedCartesianState - expectedCartesianState ).segment( 3, 3 ).norm( ),
+                       1.0e-3 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
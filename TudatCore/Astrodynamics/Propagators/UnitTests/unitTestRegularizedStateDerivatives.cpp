@@ -0,0 +1,343 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Astrodynamics/Propagators/regularizedStateDerivatives.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+using tudat::basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+//! Compute constant along-track perturbing acceleration.
+/*!
+ * Computes a perturbing acceleration of constant magnitude along the velocity vector.
+ * \param time Current time (unused).
+ * \param cartesianState Current Cartesian state.
+ * \return Perturbing acceleration.
+ */
+Eigen::Vector3d computeConstantAlongTrackAcceleration( const double time,
+                                                       const Vector6d& cartesianState )
+{
+    return 1.0e-4 * cartesianState.segment< 3 >( 3 ).normalized( );
+}
+
+//! Cartesian state derivative for point-mass gravity with optional along-track perturbation.
+/*!
+ * Computes the Cartesian state derivative for point-mass gravity of the Earth, with the
+ * along-track perturbing acceleration of computeConstantAlongTrackAcceleration() if requested.
+ * \param time Current time.
+ * \param cartesianState Current Cartesian state.
+ * \param isPerturbed Flag indicating whether the perturbing acceleration is included.
+ * \return Cartesian state derivative.
+ */
+Eigen::VectorXd computeCartesianStateDerivative( const double time,
+                                                 const Eigen::VectorXd& cartesianState,
+                                                 const bool isPerturbed )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+    const Eigen::Vector3d position = cartesianState.segment( 0, 3 );
+
+    Eigen::VectorXd stateDerivative( 6 );
+    stateDerivative.segment( 0, 3 ) = cartesianState.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 )
+            = -earthGravitationalParameter / ( position.norm( ) * position.squaredNorm( ) )
+            * position;
+    if ( isPerturbed )
+    {
+        stateDerivative.segment( 3, 3 ) += computeConstantAlongTrackAcceleration(
+                    time, Vector6d( cartesianState ) );
+    }
+    return stateDerivative;
+}
+
+BOOST_AUTO_TEST_SUITE( test_regularized_state_derivatives )
+
+//! Test if Cartesian states are converted correctly to and from Kustaanheimo-Stiefel states.
+BOOST_AUTO_TEST_CASE( testKustaanheimoStiefelConversions )
+{
+    using namespace tudat::propagators;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set Cartesian states with positive and negative x-components [m,m/s].
+    Eigen::MatrixXd cartesianStates( 6, 3 );
+    cartesianStates << 7.0e6, -4.0e6, 0.0,
+            1.0e6, 2.0e6, -3.0e6,
+            -2.0e6, 5.0e6, 6.5e6,
+            -1.0e3, 3.0e3, 7.0e3,
+            7.0e3, -2.0e3, 1.0e3,
+            1.0e3, 4.0e3, -2.0e3;
+
+    for ( int stateIndex = 0; stateIndex < cartesianStates.cols( ); stateIndex++ )
+    {
+        const Vector6d cartesianState = cartesianStates.col( stateIndex );
+        const Vector10d kustaanheimoStiefelState = convertCartesianToKustaanheimoStiefelState(
+                    cartesianState, 123.0, earthGravitationalParameter );
+        const Eigen::Vector4d u = kustaanheimoStiefelState.segment< 4 >(
+                    kustaanheimoStiefelPositionIndex );
+        const Eigen::Vector4d uPrime = kustaanheimoStiefelState.segment< 4 >(
+                    kustaanheimoStiefelVelocityIndex );
+
+        // Check radius, bilinear relation, energy and time.
+        BOOST_CHECK_CLOSE_FRACTION( u.squaredNorm( ), cartesianState.segment( 0, 3 ).norm( ),
+                                    1.0e-15 );
+        BOOST_CHECK_SMALL( ( u( 3 ) * uPrime( 0 ) - u( 2 ) * uPrime( 1 ) + u( 1 ) * uPrime( 2 )
+                             - u( 0 ) * uPrime( 3 ) ) / ( u.norm( ) * uPrime.norm( ) ), 1.0e-15 );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    kustaanheimoStiefelState( kustaanheimoStiefelEnergyIndex ),
+                    earthGravitationalParameter / cartesianState.segment( 0, 3 ).norm( )
+                    - 0.5 * cartesianState.segment( 3, 3 ).squaredNorm( ), 1.0e-15 );
+        BOOST_CHECK_EQUAL( kustaanheimoStiefelState( kustaanheimoStiefelTimeIndex ), 123.0 );
+
+        // Check conversion back to Cartesian state.
+        const Vector6d reconstructedCartesianState
+                = convertKustaanheimoStiefelToCartesianState( kustaanheimoStiefelState );
+        BOOST_CHECK_SMALL( ( reconstructedCartesianState - cartesianState ).segment( 0, 3 )
+                           .norm( ), 1.0e-8 );
+        BOOST_CHECK_SMALL( ( reconstructedCartesianState - cartesianState ).segment( 3, 3 )
+                           .norm( ), 1.0e-11 );
+
+        // Check conversion to and from Sundman-transformed state.
+        const Vector7d sundmanState = convertCartesianToSundmanState( cartesianState, 123.0 );
+        BOOST_CHECK_EQUAL( sundmanState( sundmanTimeIndex ), 123.0 );
+        BOOST_CHECK_EQUAL( ( convertSundmanToCartesianState( sundmanState )
+                             - cartesianState ).norm( ), 0.0 );
+    }
+}
+
+//! Test if highly eccentric orbits are propagated accurately in fictitious time.
+BOOST_AUTO_TEST_CASE( testRegularizedPropagationOfEccentricOrbit )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+    using namespace tudat::propagators;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set highly eccentric orbit, starting at periapsis, and set output times over one period.
+    Eigen::VectorXd keplerianElements( 6 );
+    keplerianElements << 1.0e8, 0.95, 0.3, 1.0, 2.0, 0.0;
+    const double semiMajorAxis = keplerianElements( semiMajorAxisIndex );
+    const double orbitalPeriod = 2.0 * PI * std::sqrt(
+                semiMajorAxis * semiMajorAxis * semiMajorAxis / earthGravitationalParameter );
+    const KeplerOrbit keplerOrbit( keplerianElements, earthGravitationalParameter );
+    const Vector6d initialState = keplerOrbit.getStateAtTime( 0.0 );
+
+    Eigen::VectorXd outputTimes( 4 );
+    outputTimes << 0.0, 0.01 * orbitalPeriod, 0.5 * orbitalPeriod, orbitalPeriod;
+
+    // Propagate Cartesian state in physical time with 1600 steps per revolution.
+    numerical_integrators::RungeKutta4IntegratorXd cartesianIntegrator(
+                boost::bind( &computeCartesianStateDerivative, _1, _2, false ), 0.0,
+                initialState );
+    const Eigen::VectorXd cartesianState = cartesianIntegrator.integrateTo(
+                orbitalPeriod, orbitalPeriod / 1600.0 );
+
+    // Propagate KS state in fictitious time with 200 steps per revolution, for which the period
+    // in fictitious time is 2 pi sqrt( a / mu ).
+    const KustaanheimoStiefelStateDerivative kustaanheimoStiefelStateDerivative;
+    numerical_integrators::RungeKutta4IntegratorXd kustaanheimoStiefelIntegrator(
+                boost::bind( &KustaanheimoStiefelStateDerivative::computeStateDerivative,
+                             &kustaanheimoStiefelStateDerivative, _1, _2 ), 0.0,
+                convertCartesianToKustaanheimoStiefelState( initialState, 0.0,
+                                                            earthGravitationalParameter ) );
+    Eigen::MatrixXd kustaanheimoStiefelStates;
+    integrateToPhysicalTimes( kustaanheimoStiefelIntegrator, kustaanheimoStiefelTimeIndex,
+                              outputTimes, 2.0 * PI * std::sqrt( semiMajorAxis
+                                                                 / earthGravitationalParameter )
+                              / 200.0, kustaanheimoStiefelStates );
+
+    // Propagate Sundman-transformed state with 1600 steps per revolution, using the true anomaly
+    // as fictitious time.
+    const SundmanStateDerivative sundmanStateDerivative(
+                earthGravitationalParameter, 2.0,
+                1.0 / std::sqrt( earthGravitationalParameter * semiMajorAxis
+                                 * ( 1.0 - 0.95 * 0.95 ) ) );
+    numerical_integrators::RungeKutta4IntegratorXd sundmanIntegrator(
+                boost::bind( &SundmanStateDerivative::computeStateDerivative,
+                             &sundmanStateDerivative, _1, _2 ), 0.0,
+                convertCartesianToSundmanState( initialState, 0.0 ) );
+    Eigen::MatrixXd sundmanStates;
+    integrateToPhysicalTimes( sundmanIntegrator, sundmanTimeIndex, outputTimes, 2.0 * PI / 1600.0,
+                              sundmanStates );
+
+    // Check that the states are obtained at the output times, and that the regularized
+    // propagations are accurate, unlike the propagation in physical time.
+    for ( int outputIndex = 0; outputIndex < outputTimes.rows( ); outputIndex++ )
+    {
+        const Vector6d expectedState = keplerOrbit.getStateAtTime( outputTimes( outputIndex ) );
+        BOOST_CHECK_SMALL( kustaanheimoStiefelStates( kustaanheimoStiefelTimeIndex, outputIndex )
+                           - outputTimes( outputIndex ), 1.0e-9 );
+        BOOST_CHECK_SMALL( sundmanStates( sundmanTimeIndex, outputIndex )
+                           - outputTimes( outputIndex ), 1.0e-9 );
+        BOOST_CHECK_SMALL( ( convertKustaanheimoStiefelToCartesianState(
+                                 kustaanheimoStiefelStates.col( outputIndex ) )
+                             - expectedState ).segment( 0, 3 ).norm( ), 10.0 );
+        BOOST_CHECK_SMALL( ( convertSundmanToCartesianState( sundmanStates.col( outputIndex ) )
+                             - expectedState ).segment( 0, 3 ).norm( ), 100.0 );
+    }
+    BOOST_CHECK_GT( ( cartesianState - keplerOrbit.getStateAtTime( orbitalPeriod ) )
+                    .segment( 0, 3 ).norm( ), 1.0e4 );
+    BOOST_CHECK_EQUAL( kustaanheimoStiefelIntegrator.getCurrentState( )(
+                           kustaanheimoStiefelTimeIndex ), kustaanheimoStiefelStates(
+                           kustaanheimoStiefelTimeIndex, outputTimes.rows( ) - 1 ) );
+}
+
+//! Test if perturbed orbits are propagated accurately in fictitious time.
+BOOST_AUTO_TEST_CASE( testRegularizedPropagationOfPerturbedOrbit )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+    using namespace tudat::propagators;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set eccentric orbit and output times over one orbital period.
+    Vector6d keplerianElements;
+    keplerianElements << 2.65e7, 0.7, 1.1, 4.7, 0.8, 0.3;
+    const double semiMajorAxis = keplerianElements( semiMajorAxisIndex );
+    const double orbitalPeriod = 2.0 * PI * std::sqrt(
+                semiMajorAxis * semiMajorAxis * semiMajorAxis / earthGravitationalParameter );
+    const Vector6d initialState = convertKeplerianToCartesianElements(
+                keplerianElements, earthGravitationalParameter );
+    Eigen::VectorXd outputTimes = Eigen::VectorXd::LinSpaced( 11, 0.0, orbitalPeriod );
+
+    // Compute reference solution in physical time with a small step size.
+    numerical_integrators::RungeKutta4IntegratorXd referenceIntegrator(
+                boost::bind( &computeCartesianStateDerivative, _1, _2, true ), 0.0,
+                initialState );
+    Eigen::MatrixXd referenceStates( 6, outputTimes.rows( ) );
+    for ( int outputIndex = 0; outputIndex < outputTimes.rows( ); outputIndex++ )
+    {
+        referenceStates.col( outputIndex ) = referenceIntegrator.integrateTo(
+                    outputTimes( outputIndex ), 0.5 );
+    }
+
+    // Propagate KS and Sundman-transformed states with 300 and 1000 steps per revolution,
+    // respectively, using the true anomaly as fictitious time for the Sundman transformation.
+    const KustaanheimoStiefelStateDerivative kustaanheimoStiefelStateDerivative(
+                &computeConstantAlongTrackAcceleration );
+    numerical_integrators::RungeKutta4IntegratorXd kustaanheimoStiefelIntegrator(
+                boost::bind( &KustaanheimoStiefelStateDerivative::computeStateDerivative,
+                             &kustaanheimoStiefelStateDerivative, _1, _2 ), 0.0,
+                convertCartesianToKustaanheimoStiefelState( initialState, 0.0,
+                                                            earthGravitationalParameter ) );
+    Eigen::MatrixXd kustaanheimoStiefelStates;
+    integrateToPhysicalTimes( kustaanheimoStiefelIntegrator, kustaanheimoStiefelTimeIndex,
+                              outputTimes, 2.0 * PI * std::sqrt( semiMajorAxis
+                                                                 / earthGravitationalParameter )
+                              / 300.0, kustaanheimoStiefelStates );
+
+    const double semiLatusRectum = semiMajorAxis * ( 1.0 - 0.7 * 0.7 );
+    const SundmanStateDerivative sundmanStateDerivative(
+                earthGravitationalParameter, 2.0,
+                1.0 / std::sqrt( earthGravitationalParameter * semiLatusRectum ),
+                &computeConstantAlongTrackAcceleration );
+    numerical_integrators::RungeKutta4IntegratorXd sundmanIntegrator(
+                boost::bind( &SundmanStateDerivative::computeStateDerivative,
+                             &sundmanStateDerivative, _1, _2 ), 0.0,
+                convertCartesianToSundmanState( initialState, 0.0 ) );
+    Eigen::MatrixXd sundmanStates;
+    integrateToPhysicalTimes( sundmanIntegrator, sundmanTimeIndex, outputTimes, 2.0 * PI / 1000.0,
+                              sundmanStates );
+
+    for ( int outputIndex = 0; outputIndex < outputTimes.rows( ); outputIndex++ )
+    {
+        BOOST_CHECK_SMALL( ( convertKustaanheimoStiefelToCartesianState(
+                                 kustaanheimoStiefelStates.col( outputIndex ) )
+                             - referenceStates.col( outputIndex ) ).segment( 0, 3 ).norm( ),
+                           1.0 );
+        BOOST_CHECK_SMALL( ( convertSundmanToCartesianState( sundmanStates.col( outputIndex ) )
+                             - referenceStates.col( outputIndex ) ).segment( 0, 3 ).norm( ),
+                           10.0 );
+    }
+
+    // Check that the energy element follows the energy change caused by the perturbation.
+    const Eigen::VectorXd finalReferenceState = referenceStates.col( outputTimes.rows( ) - 1 );
+    const double finalEnergy = earthGravitationalParameter
+            / finalReferenceState.segment( 0, 3 ).norm( )
+            - 0.5 * finalReferenceState.segment( 3, 3 ).squaredNorm( );
+    BOOST_CHECK_CLOSE_FRACTION( kustaanheimoStiefelStates( kustaanheimoStiefelEnergyIndex,
+                                                           outputTimes.rows( ) - 1 ),
+                                finalEnergy, 1.0e-8 );
+    BOOST_CHECK_LT( finalEnergy, 0.999 * convertCartesianToKustaanheimoStiefelState(
+                        initialState, 0.0, earthGravitationalParameter )(
+                        kustaanheimoStiefelEnergyIndex ) );
+}
+
+//! Test if errors are thrown for invalid output times.
+BOOST_AUTO_TEST_CASE( testRegularizedPropagationErrors )
+{
+    using namespace tudat::propagators;
+
+    Vector6d initialState;
+    initialState << 7.0e6, 0.0, 0.0, 0.0, 7.5e3, 0.0;
+    const SundmanStateDerivative sundmanStateDerivative( 3.986004418e14, 1.0, 1.0e-3 );
+    numerical_integrators::RungeKutta4IntegratorXd sundmanIntegrator(
+                boost::bind( &SundmanStateDerivative::computeStateDerivative,
+                             &sundmanStateDerivative, _1, _2 ), 0.0,
+                convertCartesianToSundmanState( initialState, 100.0 ) );
+
+    // Check output times before the current time and decreasing output times.
+    Eigen::MatrixXd sundmanStates;
+    BOOST_CHECK_THROW( integrateToPhysicalTimes( sundmanIntegrator, sundmanTimeIndex,
+                                                 Eigen::VectorXd::Constant( 1, 50.0 ), 0.1,
+                                                 sundmanStates ), std::runtime_error );
+    Eigen::VectorXd outputTimes( 2 );
+    outputTimes << 200.0, 150.0;
+    BOOST_CHECK_THROW( integrateToPhysicalTimes( sundmanIntegrator, sundmanTimeIndex,
+                                                 outputTimes, 0.1, sundmanStates ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
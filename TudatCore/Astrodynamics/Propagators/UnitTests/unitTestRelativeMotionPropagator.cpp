@@ -0,0 +1,342 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Yamanaka, K., Ankersen, F. New state transition matrix for relative motion on an arbitrary
+ *          elliptical orbit, Journal of Guidance, Control, and Dynamics, 25(1), 60-66, 2002.
+ *
+ *    Notes
+ *      The reference relative states are obtained by propagating the chief and deputy orbits
+ *      separately with the universal-variable Kepler propagator, and expressing the difference of
+ *      their Cartesian states in the rotating RSW frame of the chief.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/astrodynamicsFunctions.h"
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/relativeMotionPropagator.h"
+#include "TudatCore/Astrodynamics/Propagators/universalVariablePropagator.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+using tudat::basic_astrodynamics::orbital_element_conversions::Vector6d;
+using tudat::basic_astrodynamics::orbital_element_conversions::Matrix6d;
+
+//! Compute rotation matrix from RSW frame of chief to inertial frame.
+/*!
+ * Computes the rotation matrix from the RSW frame of the chief to the inertial frame.
+ * \param chiefCartesianState Cartesian state of the chief.
+ * \return Rotation matrix from RSW frame to inertial frame.
+ */
+Eigen::Matrix3d computeRswToInertialFrameRotation( const Vector6d& chiefCartesianState )
+{
+    const Eigen::Vector3d radialUnitVector = chiefCartesianState.head< 3 >( ).normalized( );
+    const Eigen::Vector3d crossTrackUnitVector = chiefCartesianState.head< 3 >( ).cross(
+                chiefCartesianState.tail< 3 >( ) ).normalized( );
+
+    Eigen::Matrix3d rotation;
+    rotation.col( 0 ) = radialUnitVector;
+    rotation.col( 1 ) = crossTrackUnitVector.cross( radialUnitVector );
+    rotation.col( 2 ) = crossTrackUnitVector;
+    return rotation;
+}
+
+//! Compute angular velocity of RSW frame of chief, expressed in RSW frame.
+/*!
+ * Computes the angular velocity of the RSW frame of the chief, expressed in the RSW frame.
+ * \param chiefCartesianState Cartesian state of the chief.
+ * \return Angular velocity of RSW frame.                                                   [rad/s]
+ */
+Eigen::Vector3d computeRswFrameAngularVelocity( const Vector6d& chiefCartesianState )
+{
+    return Eigen::Vector3d( 0.0, 0.0, chiefCartesianState.head< 3 >( ).cross(
+                                chiefCartesianState.tail< 3 >( ) ).norm( )
+                            / chiefCartesianState.head< 3 >( ).squaredNorm( ) );
+}
+
+//! Convert relative state in RSW frame of chief to Cartesian state of deputy.
+/*!
+ * Converts a relative state in the rotating RSW frame of the chief to the inertial Cartesian
+ * state of the deputy.
+ * \param chiefCartesianState Cartesian state of the chief.
+ * \param relativeState Relative state in RSW frame.
+ * \return Cartesian state of deputy.
+ */
+Vector6d convertRelativeStateToDeputyCartesianState( const Vector6d& chiefCartesianState,
+                                                     const Vector6d& relativeState )
+{
+    const Eigen::Matrix3d rotation = computeRswToInertialFrameRotation( chiefCartesianState );
+    const Eigen::Vector3d relativePosition = relativeState.head< 3 >( );
+
+    Vector6d deputyCartesianState;
+    deputyCartesianState.head< 3 >( ) = chiefCartesianState.head< 3 >( )
+            + rotation * relativePosition;
+    deputyCartesianState.tail< 3 >( ) = chiefCartesianState.tail< 3 >( ) + rotation
+            * ( relativeState.tail< 3 >( ) + computeRswFrameAngularVelocity(
+                    chiefCartesianState ).cross( relativePosition ) );
+    return deputyCartesianState;
+}
+
+//! Convert Cartesian state of deputy to relative state in RSW frame of chief.
+/*!
+ * Converts the inertial Cartesian state of the deputy to a relative state in the rotating RSW
+ * frame of the chief.
+ * \param chiefCartesianState Cartesian state of the chief.
+ * \param deputyCartesianState Cartesian state of the deputy.
+ * \return Relative state in RSW frame.
+ */
+Vector6d convertDeputyCartesianStateToRelativeState( const Vector6d& chiefCartesianState,
+                                                     const Vector6d& deputyCartesianState )
+{
+    const Eigen::Matrix3d rotation = computeRswToInertialFrameRotation( chiefCartesianState );
+    const Eigen::Vector3d relativePosition = rotation.transpose( )
+            * ( deputyCartesianState.head< 3 >( ) - chiefCartesianState.head< 3 >( ) );
+
+    Vector6d relativeState;
+    relativeState.head< 3 >( ) = relativePosition;
+    relativeState.tail< 3 >( ) = rotation.transpose( )
+            * ( deputyCartesianState.tail< 3 >( ) - chiefCartesianState.tail< 3 >( ) )
+            - computeRswFrameAngularVelocity( chiefCartesianState ).cross( relativePosition );
+    return relativeState;
+}
+
+BOOST_AUTO_TEST_SUITE( test_relative_motion_propagator )
+
+//! Test if state transition matrices reduce to identity and to each other for a circular chief.
+BOOST_AUTO_TEST_CASE( testRelativeMotionStateTransitionMatrixLimitCases )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+    const double chiefSemiMajorAxis = 7.0e6;
+    const double chiefMeanMotion = basic_astrodynamics::computeKeplerMeanMotion(
+                chiefSemiMajorAxis, earthGravitationalParameter );
+
+    Vector6d chiefKeplerianElements;
+    chiefKeplerianElements << chiefSemiMajorAxis, 0.0, 0.9, 0.3, 1.2, 2.5;
+
+    // Check that the state transition matrices are the identity matrix for zero propagation time.
+    chiefKeplerianElements( 1 ) = 0.6;
+    const Matrix6d clohessyWiltshireIdentity
+            = propagators::computeClohessyWiltshireStateTransitionMatrix( chiefMeanMotion, 0.0 );
+    const Matrix6d yamanakaAnkersenIdentity
+            = propagators::computeYamanakaAnkersenStateTransitionMatrix(
+                chiefKeplerianElements, 0.0, earthGravitationalParameter );
+    for ( int i = 0; i < 6; i++ )
+    {
+        for ( int j = 0; j < 6; j++ )
+        {
+            const double expectedEntry = ( i == j ) ? 1.0 : 0.0;
+            BOOST_CHECK_SMALL( clohessyWiltshireIdentity( i, j ) - expectedEntry, 1.0e-15 );
+            BOOST_CHECK_SMALL( yamanakaAnkersenIdentity( i, j ) - expectedEntry, 1.0e-11 );
+        }
+    }
+
+    // Check that the Yamanaka-Ankersen matrix reduces to the Clohessy-Wiltshire matrix for a
+    // circular chief orbit, over several revolutions.
+    chiefKeplerianElements( 1 ) = 0.0;
+    const double propagationTimes[ 3 ] = { 1234.5, -4321.0, 3.7 * 2.0 * PI / chiefMeanMotion };
+    for ( int k = 0; k < 3; k++ )
+    {
+        const Matrix6d clohessyWiltshireMatrix
+                = propagators::computeClohessyWiltshireStateTransitionMatrix(
+                    chiefMeanMotion, propagationTimes[ k ] );
+        const Matrix6d yamanakaAnkersenMatrix
+                = propagators::computeYamanakaAnkersenStateTransitionMatrix(
+                    chiefKeplerianElements, propagationTimes[ k ], earthGravitationalParameter );
+        for ( int i = 0; i < 6; i++ )
+        {
+            for ( int j = 0; j < 6; j++ )
+            {
+                BOOST_CHECK_SMALL( yamanakaAnkersenMatrix( i, j )
+                                   - clohessyWiltshireMatrix( i, j ),
+                                   1.0e-10 * ( 1.0
+                                               + std::fabs( clohessyWiltshireMatrix( i, j ) ) ) );
+            }
+        }
+    }
+}
+
+//! Test if relative motion about an elliptical chief agrees with nonlinear relative motion.
+BOOST_AUTO_TEST_CASE( testYamanakaAnkersenRelativeMotionAgainstKeplerPropagation )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    Vector6d chiefKeplerianElements;
+    chiefKeplerianElements << 2.4e7, 0.6, 0.4, 1.1, 2.0, 0.7;
+    const Vector6d chiefCartesianState
+            = basic_astrodynamics::orbital_element_conversions::
+            convertKeplerianToCartesianElements( chiefKeplerianElements,
+                                                 earthGravitationalParameter );
+    const double chiefOrbitalPeriod = 2.0 * PI / basic_astrodynamics::computeKeplerMeanMotion(
+                chiefKeplerianElements( 0 ), earthGravitationalParameter );
+
+    // Set initial relative state of deputy, at a separation of a few tens of meters.
+    Vector6d initialRelativeState;
+    initialRelativeState << 10.0, -20.0, 5.0, 0.002, -0.005, 0.003;
+
+    // Propagate over two orbital periods, and compare with the nonlinear relative motion. The
+    // linearization error is checked to increase quadratically with the initial separation.
+    for ( int k = 1; k <= 8; k++ )
+    {
+        const double propagationTime = 0.25 * k * chiefOrbitalPeriod + 100.0;
+
+        const Vector6d chiefFinalCartesianState
+                = propagators::propagateKeplerOrbitWithUniversalVariable(
+                    chiefCartesianState, propagationTime, earthGravitationalParameter );
+        const Matrix6d stateTransitionMatrix
+                = propagators::computeYamanakaAnkersenStateTransitionMatrix(
+                    chiefKeplerianElements, propagationTime, earthGravitationalParameter );
+        const Matrix6d clohessyWiltshireMatrix
+                = propagators::computeClohessyWiltshireStateTransitionMatrix(
+                    basic_astrodynamics::computeKeplerMeanMotion(
+                        chiefKeplerianElements( 0 ), earthGravitationalParameter ),
+                    propagationTime );
+
+        double positionErrors[ 2 ];
+        for ( int scaling = 0; scaling < 2; scaling++ )
+        {
+            const Vector6d scaledInitialRelativeState
+                    = ( scaling == 0 ? 1.0 : 10.0 ) * initialRelativeState;
+
+            const Vector6d expectedRelativeState = convertDeputyCartesianStateToRelativeState(
+                        chiefFinalCartesianState,
+                        propagators::propagateKeplerOrbitWithUniversalVariable(
+                            convertRelativeStateToDeputyCartesianState(
+                                chiefCartesianState, scaledInitialRelativeState ),
+                            propagationTime, earthGravitationalParameter ) );
+            const Vector6d stateError
+                    = stateTransitionMatrix * scaledInitialRelativeState - expectedRelativeState;
+            positionErrors[ scaling ] = stateError.head< 3 >( ).norm( );
+
+            BOOST_CHECK_LT( positionErrors[ scaling ],
+                            3.0e-3 * expectedRelativeState.head< 3 >( ).norm( ) );
+            BOOST_CHECK_LT( stateError.tail< 3 >( ).norm( ),
+                            1.0e-2 * expectedRelativeState.tail< 3 >( ).norm( ) );
+
+            // Check that the Clohessy-Wiltshire matrix does not capture the elliptical motion.
+            BOOST_CHECK_GT( ( clohessyWiltshireMatrix * scaledInitialRelativeState
+                              - expectedRelativeState ).head< 3 >( ).norm( ),
+                            0.5 * expectedRelativeState.head< 3 >( ).norm( ) );
+        }
+
+        BOOST_CHECK_GT( positionErrors[ 1 ] / positionErrors[ 0 ], 50.0 );
+        BOOST_CHECK_LT( positionErrors[ 1 ] / positionErrors[ 0 ], 200.0 );
+    }
+}
+
+//! Test if relative states of multiple deputies are propagated correctly to multiple epochs.
+BOOST_AUTO_TEST_CASE( testBatchRelativeMotionPropagation )
+{
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    Vector6d chiefKeplerianElements;
+    chiefKeplerianElements << 8.0e6, 0.1, 0.4, 1.1, 2.0, 0.7;
+    const double chiefMeanMotion = basic_astrodynamics::computeKeplerMeanMotion(
+                chiefKeplerianElements( 0 ), earthGravitationalParameter );
+
+    const int numberOfDeputies = 50;
+    const Eigen::MatrixXd initialRelativeStates
+            = Eigen::MatrixXd::Random( 6, numberOfDeputies ) * 100.0;
+
+    Eigen::VectorXd propagationTimes( 3 );
+    propagationTimes << -600.0, 0.0, 5000.0;
+
+    // Propagate with both state transition matrices, and compare with propagation per deputy.
+    std::vector< Eigen::MatrixXd > clohessyWiltshireRelativeStates;
+    propagators::propagateClohessyWiltshireRelativeStates(
+                initialRelativeStates, chiefKeplerianElements( 0 ), earthGravitationalParameter,
+                propagationTimes, clohessyWiltshireRelativeStates );
+    std::vector< Eigen::MatrixXd > yamanakaAnkersenRelativeStates(
+                3, Eigen::MatrixXd( 6, numberOfDeputies ) );
+    propagators::propagateYamanakaAnkersenRelativeStates(
+                initialRelativeStates, chiefKeplerianElements, earthGravitationalParameter,
+                propagationTimes, yamanakaAnkersenRelativeStates );
+
+    BOOST_CHECK_EQUAL( clohessyWiltshireRelativeStates.size( ), 3 );
+    BOOST_CHECK_EQUAL( yamanakaAnkersenRelativeStates.size( ), 3 );
+
+    for ( int k = 0; k < propagationTimes.size( ); k++ )
+    {
+        const Matrix6d clohessyWiltshireMatrix
+                = propagators::computeClohessyWiltshireStateTransitionMatrix(
+                    chiefMeanMotion, propagationTimes( k ) );
+        const Matrix6d yamanakaAnkersenMatrix
+                = propagators::computeYamanakaAnkersenStateTransitionMatrix(
+                    chiefKeplerianElements, propagationTimes( k ), earthGravitationalParameter );
+
+        BOOST_CHECK_EQUAL( clohessyWiltshireRelativeStates[ k ].rows( ), 6 );
+        BOOST_CHECK_EQUAL( clohessyWiltshireRelativeStates[ k ].cols( ), numberOfDeputies );
+
+        for ( int j = 0; j < numberOfDeputies; j++ )
+        {
+            const Vector6d expectedClohessyWiltshireState
+                    = clohessyWiltshireMatrix * initialRelativeStates.col( j );
+            const Vector6d expectedYamanakaAnkersenState
+                    = yamanakaAnkersenMatrix * initialRelativeStates.col( j );
+            for ( int i = 0; i < 6; i++ )
+            {
+                BOOST_CHECK_SMALL( clohessyWiltshireRelativeStates[ k ]( i, j )
+                                   - expectedClohessyWiltshireState( i ), 1.0e-9 );
+                BOOST_CHECK_SMALL( yamanakaAnkersenRelativeStates[ k ]( i, j )
+                                   - expectedYamanakaAnkersenState( i ), 1.0e-9 );
+            }
+        }
+    }
+
+    // Check that errors are thrown for invalid relative states and chief orbits.
+    BOOST_CHECK_THROW( propagators::propagateClohessyWiltshireRelativeStates(
+                           Eigen::MatrixXd::Zero( 5, 3 ), chiefKeplerianElements( 0 ),
+                           earthGravitationalParameter, propagationTimes,
+                           clohessyWiltshireRelativeStates ), std::runtime_error );
+
+    Vector6d hyperbolicChiefKeplerianElements = chiefKeplerianElements;
+    hyperbolicChiefKeplerianElements( 0 ) = -8.0e6;
+    hyperbolicChiefKeplerianElements( 1 ) = 1.5;
+    BOOST_CHECK_THROW( propagators::propagateYamanakaAnkersenRelativeStates(
+                           initialRelativeStates, hyperbolicChiefKeplerianElements,
+                           earthGravitationalParameter, propagationTimes,
+                           yamanakaAnkersenRelativeStates ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,291 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., Crawford, P., Hujsak, R., Kelso, T. S. Revisiting Spacetrack Report #3,
+ *          AIAA/AAS Astrodynamics Specialist Conference, AIAA 2006-6753, 2006.
+ *
+ *    Notes
+ *      The reference states are taken from the verification output of (Vallado et al., 2006),
+ *      which is given in km and km/s with 8 and 9 decimals, respectively. The resonance terms of
+ *      SDP4 are only tested for consistency, since they do not affect the states at epoch.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/sgp4Orbit.h"
+#include "TudatCore/InputOutput/basicInputOutput.h"
+#include "TudatCore/InputOutput/twoLineElementSetReader.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_sgp4_orbit )
+
+//! Read element sets of SGP4 verification cases.
+std::vector< input_output::TwoLineElementSet > readSgp4VerificationElementSets( )
+{
+    return input_output::readTwoLineElementSetsFromFile(
+                input_output::getCoreRootPath( )
+                + "/InputOutput/UnitTests/testTwoLineElementSets.txt" );
+}
+
+//! Read element sets of SDP4 verification cases.
+std::vector< input_output::TwoLineElementSet > readSdp4VerificationElementSets( )
+{
+    return input_output::readTwoLineElementSetsFromFile(
+                input_output::getCoreRootPath( )
+                + "/InputOutput/UnitTests/testDeepSpaceTwoLineElementSets.txt" );
+}
+
+//! Test if SGP4 reproduces the verification states of (Vallado et al., 2006).
+BOOST_AUTO_TEST_CASE( testSgp4VerificationStates )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    const std::vector< input_output::TwoLineElementSet > elementSets
+            = readSgp4VerificationElementSets( );
+
+    // Set reference states of satellite 00005 at 0 and 360 minutes, and of satellite 06251 at
+    // 0 minutes, in km and km/s.
+    Vector6d expectedStateAtEpoch;
+    expectedStateAtEpoch << 7022.46529266, -1400.08296755, 0.03995155,
+            1.893841015, 6.405893759, 4.534807250;
+    Vector6d expectedStateAfter360Minutes;
+    expectedStateAfter360Minutes << -7154.03120202, -3783.17682504, -3536.19412294,
+            4.741887409, -4.151817765, -2.093935425;
+    Vector6d expectedStateOfDragCase;
+    expectedStateOfDragCase << 3988.31022699, 5498.96657235, 0.90055879,
+            -3.290032738, 2.357652820, 6.496623475;
+
+    // Compute states with SGP4, in km and km/s.
+    const propagators::Sgp4Orbit orbit( elementSets[ 0 ] );
+    const Vector6d computedStateAtEpoch = orbit.getStateAtTime( 0.0 ) / 1.0e3;
+    const Vector6d computedStateAfter360Minutes = orbit.getStateAtTime( 360.0 * 60.0 ) / 1.0e3;
+    const Vector6d computedStateOfDragCase
+            = propagators::Sgp4Orbit( elementSets[ 1 ] ).getStateAtTime( 0.0 ) / 1.0e3;
+
+    // Check that the states agree to the precision of the reference output.
+    BOOST_CHECK_SMALL( ( computedStateAtEpoch - expectedStateAtEpoch ).head( 3 ).norm( ), 1.0e-7 );
+    BOOST_CHECK_SMALL( ( computedStateAtEpoch - expectedStateAtEpoch ).tail( 3 ).norm( ), 1.0e-8 );
+    BOOST_CHECK_SMALL( ( computedStateAfter360Minutes - expectedStateAfter360Minutes )
+                       .head( 3 ).norm( ), 1.0e-7 );
+    BOOST_CHECK_SMALL( ( computedStateAfter360Minutes - expectedStateAfter360Minutes )
+                       .tail( 3 ).norm( ), 1.0e-8 );
+    BOOST_CHECK_SMALL( ( computedStateOfDragCase - expectedStateOfDragCase ).head( 3 ).norm( ),
+                       1.0e-7 );
+    BOOST_CHECK_SMALL( ( computedStateOfDragCase - expectedStateOfDragCase ).tail( 3 ).norm( ),
+                       1.0e-8 );
+}
+
+//! Test if SDP4 reproduces the verification states of (Vallado et al., 2006).
+BOOST_AUTO_TEST_CASE( testSdp4VerificationStates )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    const std::vector< input_output::TwoLineElementSet > elementSets
+            = readSdp4VerificationElementSets( );
+    BOOST_REQUIRE_EQUAL( elementSets.size( ), 3 );
+
+    // Set reference positions of satellite 11801 at 0, 360 and 720 minutes, in km.
+    Eigen::Matrix3d expectedPositions;
+    expectedPositions << 7473.37102491, -3305.22148694, 14271.29083858,
+            428.94748312, 32410.84323331, 24110.44309009,
+            5828.74846783, -24697.16974954, -4725.76320143;
+
+    // Set reference states of satellites 04632, 08195 and 09880 at 0 minutes, in km and km/s.
+    Eigen::Matrix< double, 6, 3 > expectedStatesAtEpoch;
+    expectedStatesAtEpoch << 2334.11450085, 2349.89483350, 13020.06750784,
+            -41920.44035349, -14785.93811562, -2449.07193500,
+            -0.03867437, 0.02119378, 1.15896030,
+            2.826321032, 2.721488096, 4.247363935,
+            -0.065091664, -3.256811655, 1.597178501,
+            0.570936053, 4.498416672, 4.956708611;
+
+    // Check that the positions of satellite 11801, which has a large drag term, agree to the
+    // precision of the reference output.
+    const propagators::Sgp4Orbit orbit( readSgp4VerificationElementSets( )[ 2 ] );
+    for ( int timeIndex = 0; timeIndex < 3; timeIndex++ )
+    {
+        const Vector6d computedState = orbit.getStateAtTime( timeIndex * 360.0 * 60.0 ) / 1.0e3;
+        BOOST_CHECK_SMALL( ( computedState.head( 3 ) - expectedPositions.col( timeIndex ) ).norm( ),
+                           1.0e-7 );
+    }
+
+    // Check that the states of the other deep-space orbits, which include the lunar-solar
+    // periodic terms with and without the Lyddane modification, agree to the precision of the
+    // reference output.
+    for ( int objectIndex = 0; objectIndex < 3; objectIndex++ )
+    {
+        const propagators::Sgp4Orbit deepSpaceOrbit( elementSets[ objectIndex ] );
+        const Vector6d computedState = deepSpaceOrbit.getStateAtTime( 0.0 ) / 1.0e3;
+        BOOST_CHECK_SMALL( ( computedState - expectedStatesAtEpoch.col( objectIndex ) )
+                           .head( 3 ).norm( ), 1.0e-7 );
+        BOOST_CHECK_SMALL( ( computedState - expectedStatesAtEpoch.col( objectIndex ) )
+                           .tail( 3 ).norm( ), 1.0e-8 );
+    }
+}
+
+//! Test if the resonance terms of SDP4 are integrated consistently.
+BOOST_AUTO_TEST_CASE( testSdp4Resonances )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    // Create synchronous orbit with a low inclination from the elements of satellite 04632, and
+    // take satellite 08195 as half-day resonant orbit.
+    const std::vector< input_output::TwoLineElementSet > elementSets
+            = readSdp4VerificationElementSets( );
+    input_output::TwoLineElementSet synchronousElementSet = elementSets[ 0 ];
+    synchronousElementSet.meanMotion = 7.2921e-5;
+    synchronousElementSet.eccentricity = 2.0e-4;
+    synchronousElementSet.inclination = 1.0e-3;
+    const propagators::Sgp4Orbit synchronousOrbit( synchronousElementSet );
+    const propagators::Sgp4Orbit halfDayOrbit( elementSets[ 1 ] );
+
+    // Check that the positions are continuous across the integration steps of 720 minutes of the
+    // resonance terms, forward and backward in time, by comparing their central difference to
+    // the velocity; these differ by up to about 1 m/s for SGP4 in general. Also check that the
+    // synchronous orbit remains close to the geostationary radius of 42164 km for 10 days.
+    for ( int stepIndex = -20; stepIndex <= 20; stepIndex++ )
+    {
+        const double stepTime = stepIndex * 720.0 * 60.0;
+        const Vector6d synchronousState = synchronousOrbit.getStateAtTime( stepTime );
+        const Vector6d halfDayState = halfDayOrbit.getStateAtTime( stepTime );
+
+        BOOST_CHECK_SMALL( ( synchronousOrbit.getStateAtTime( stepTime + 0.5 ).head( 3 )
+                             - synchronousOrbit.getStateAtTime( stepTime - 0.5 ).head( 3 )
+                             - synchronousState.tail( 3 ) ).norm( ), 2.0 );
+        BOOST_CHECK_SMALL( ( halfDayOrbit.getStateAtTime( stepTime + 0.5 ).head( 3 )
+                             - halfDayOrbit.getStateAtTime( stepTime - 0.5 ).head( 3 )
+                             - halfDayState.tail( 3 ) ).norm( ), 2.0 );
+        BOOST_CHECK_CLOSE_FRACTION( synchronousState.head( 3 ).norm( ), 42164.0e3, 1.0e-3 );
+    }
+}
+
+//! Test if deep-space orbits and failures of the theory are handled correctly.
+BOOST_AUTO_TEST_CASE( testSgp4Errors )
+{
+    const std::vector< input_output::TwoLineElementSet > elementSets
+            = readSgp4VerificationElementSets( );
+
+    // Check that deep-space orbits are detected and propagated.
+    BOOST_CHECK( !propagators::isDeepSpaceOrbit( elementSets[ 0 ] ) );
+    BOOST_CHECK( propagators::isDeepSpaceOrbit( elementSets[ 2 ] ) );
+    BOOST_CHECK_NO_THROW( propagators::Sgp4Orbit( elementSets[ 2 ] ).getStateAtTime( 0.0 ) );
+
+    // Check that the decay of an orbit with a large drag term is detected.
+    input_output::TwoLineElementSet decayingElementSet = elementSets[ 1 ];
+    decayingElementSet.bStarDragTerm = 0.1;
+    const propagators::Sgp4Orbit decayingOrbit( decayingElementSet );
+    propagators::Sgp4Orbit::Vector6d state;
+    BOOST_CHECK( decayingOrbit.computeStateAtTime( 0.0, state ) );
+    BOOST_CHECK( !decayingOrbit.computeStateAtTime( 30.0 * 86400.0, state ) );
+    BOOST_CHECK( state.hasNaN( ) );
+    BOOST_CHECK_THROW( decayingOrbit.getStateAtTime( 30.0 * 86400.0 ), std::runtime_error );
+}
+
+//! Test if catalog of element sets is propagated correctly.
+BOOST_AUTO_TEST_CASE( testTwoLineElementSetCatalogPropagation )
+{
+    using namespace basic_astrodynamics::orbital_element_conversions;
+
+    // Create catalog by repeating the verification element sets, such that it is divided over
+    // multiple threads.
+    const std::vector< input_output::TwoLineElementSet > verificationElementSets
+            = readSgp4VerificationElementSets( );
+    std::vector< input_output::TwoLineElementSet > elementSets;
+    for ( int repetition = 0; repetition < 100; repetition++ )
+    {
+        elementSets.insert( elementSets.end( ), verificationElementSets.begin( ),
+                            verificationElementSets.end( ) );
+    }
+    const int numberOfObjects = elementSets.size( );
+
+    // Set epoch grid, starting at the epoch of the first element set.
+    const Eigen::VectorXd epochs = Eigen::VectorXd::LinSpaced( 5, elementSets[ 0 ].epoch,
+                                                               elementSets[ 0 ].epoch + 86400.0 );
+
+    // Propagate catalog with a single and with multiple threads.
+    std::vector< Eigen::MatrixXd > cartesianStates;
+    propagators::propagateTwoLineElementSets( elementSets, epochs, cartesianStates, 1 );
+    std::vector< Eigen::MatrixXd > cartesianStatesWithThreads;
+    propagators::propagateTwoLineElementSets( elementSets, epochs, cartesianStatesWithThreads, 4 );
+
+    BOOST_REQUIRE_EQUAL( cartesianStates.size( ), 5 );
+    for ( int epochIndex = 0; epochIndex < 5; epochIndex++ )
+    {
+        BOOST_REQUIRE_EQUAL( cartesianStates[ epochIndex ].rows( ), 6 );
+        BOOST_REQUIRE_EQUAL( cartesianStates[ epochIndex ].cols( ), numberOfObjects );
+
+        for ( int objectIndex = 0; objectIndex < numberOfObjects; objectIndex++ )
+        {
+            const Eigen::VectorXd state = cartesianStates[ epochIndex ].col( objectIndex );
+
+            // Check that the states are equal to those of the single-orbit propagation, including
+            // the deep-space objects, and NaN where the theory fails. Satellite 11801 fails, since
+            // it is propagated 20 years beyond its epoch.
+            const propagators::Sgp4Orbit orbit( elementSets[ objectIndex ] );
+            propagators::Sgp4Orbit::Vector6d expectedState;
+            if ( orbit.computeStateAtTime( epochs( epochIndex ) - orbit.getEpoch( ),
+                                           expectedState ) )
+            {
+                BOOST_CHECK_EQUAL( ( state - expectedState ).norm( ), 0.0 );
+                BOOST_CHECK_EQUAL( ( state - cartesianStatesWithThreads[ epochIndex ]
+                                     .col( objectIndex ) ).norm( ), 0.0 );
+            }
+
+            else
+            {
+                BOOST_CHECK( state.hasNaN( ) );
+                BOOST_CHECK( cartesianStatesWithThreads[ epochIndex ].col( objectIndex )
+                             .hasNaN( ) );
+            }
+        }
+    }
+
+    // Check that the states can be converted to Keplerian elements directly, and that the
+    // osculating semi-major axis of satellite 00005 is close to its mean value of about 8630 km.
+    Eigen::MatrixXd keplerianElements;
+    convertCartesianToKeplerianElements( cartesianStates[ 0 ], 398600.8e9, keplerianElements );
+    BOOST_CHECK_CLOSE_FRACTION( keplerianElements( semiMajorAxisIndex, 0 ), 8.63e6, 5.0e-3 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,279 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *      The parabolic test case uses Barker's equation for the time of flight between two true
+ *      anomalies (Vallado, 2004).
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Astrodynamics/Propagators/universalVariablePropagator.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::mathematical_constants::PI;
+using tudat::basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+//! Compute time since periapsis on parabolic orbit using Barker's equation.
+/*!
+ * Computes the time since periapsis passage on a parabolic orbit, using Barker's equation.
+ * \param trueAnomaly True anomaly.                                                           [rad]
+ * \param semiLatusRectum Semi-latus rectum.                                                    [m]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Time since periapsis.                                                                [s]
+ */
+double computeParabolicTimeSincePeriapsis( const double trueAnomaly, const double semiLatusRectum,
+                                           const double centralBodyGravitationalParameter )
+{
+    const double tangentOfHalfTrueAnomaly = std::tan( 0.5 * trueAnomaly );
+    return 0.5 * std::sqrt( semiLatusRectum * semiLatusRectum * semiLatusRectum
+                            / centralBodyGravitationalParameter )
+            * ( tangentOfHalfTrueAnomaly
+                + tangentOfHalfTrueAnomaly * tangentOfHalfTrueAnomaly
+                * tangentOfHalfTrueAnomaly / 3.0 );
+}
+
+BOOST_AUTO_TEST_SUITE( test_universal_variable_propagator )
+
+//! Test if Stumpff functions are computed correctly.
+BOOST_AUTO_TEST_CASE( testStumpffFunctions )
+{
+    using propagators::computeStumpffFunctions;
+
+    double c2 = 0.0;
+    double c3 = 0.0;
+
+    // Check values at zero.
+    computeStumpffFunctions( 0.0, c2, c3 );
+    BOOST_CHECK_EQUAL( c2, 0.5 );
+    BOOST_CHECK_CLOSE_FRACTION( c3, 1.0 / 6.0, 1.0e-15 );
+
+    // Check closed-form values for positive and negative arguments, including arguments in the
+    // range in which the power series are used.
+    const double arguments[ ] = { 0.3, 0.999, 1.001, 4.0 * PI * PI, -0.3, -0.999, -1.001, -50.0 };
+    for ( unsigned int i = 0; i < sizeof( arguments ) / sizeof( arguments[ 0 ] ); i++ )
+    {
+        const double psi = arguments[ i ];
+        computeStumpffFunctions( psi, c2, c3 );
+        if ( psi > 0.0 )
+        {
+            BOOST_CHECK_CLOSE_FRACTION( c2, ( 1.0 - std::cos( std::sqrt( psi ) ) ) / psi, 1.0e-14 );
+            BOOST_CHECK_CLOSE_FRACTION( c3, ( std::sqrt( psi ) - std::sin( std::sqrt( psi ) ) )
+                                        / std::pow( psi, 1.5 ), 1.0e-14 );
+        }
+        else
+        {
+            BOOST_CHECK_CLOSE_FRACTION( c2, ( 1.0 - std::cosh( std::sqrt( -psi ) ) ) / psi,
+                                        1.0e-14 );
+            BOOST_CHECK_CLOSE_FRACTION( c3, ( std::sinh( std::sqrt( -psi ) ) - std::sqrt( -psi ) )
+                                        / std::pow( -psi, 1.5 ), 1.0e-14 );
+        }
+    }
+}
+
+//! Test if elliptical and hyperbolic orbits are propagated correctly.
+BOOST_AUTO_TEST_CASE( testUniversalVariablePropagationOfEllipticalAndHyperbolicOrbits )
+{
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set elliptical, near-circular and hyperbolic orbits [m,-,rad,rad,rad,rad].
+    Eigen::MatrixXd keplerianElements( 6, 4 );
+    keplerianElements << 7.0e6, 2.65e7, 4.2164e7, -3.0e7,
+            0.01, 0.7, 0.0, 2.5,
+            0.9, 1.1, 0.0, 0.3,
+            1.0, 4.7, 0.0, 2.0,
+            2.0, 0.8, 0.0, 5.0,
+            0.5, 3.0, 1.0, -0.8;
+    const double propagationTimes[ ] = { 1.0, -1.0e3, 5.0e4, -2.0e5, 1.0e7 };
+
+    for ( int orbitIndex = 0; orbitIndex < keplerianElements.cols( ); orbitIndex++ )
+    {
+        const propagators::KeplerOrbit keplerOrbit( keplerianElements.col( orbitIndex ),
+                                                    earthGravitationalParameter );
+        const Vector6d initialState = keplerOrbit.getStateAtTime( 0.0 );
+
+        for ( unsigned int timeIndex = 0; timeIndex < 5; timeIndex++ )
+        {
+            // Skip propagation of hyperbolic orbit far backwards, through the asymptotes.
+            if ( orbitIndex == 3 && propagationTimes[ timeIndex ] < -1.0e4 )
+            {
+                continue;
+            }
+
+            const Vector6d expectedState = keplerOrbit.getStateAtTime(
+                        propagationTimes[ timeIndex ] );
+            const Vector6d computedState = propagators::propagateKeplerOrbitWithUniversalVariable(
+                        initialState, propagationTimes[ timeIndex ],
+                        earthGravitationalParameter );
+            BOOST_CHECK_SMALL( ( computedState - expectedState ).segment( 0, 3 ).norm( )
+                               / expectedState.segment( 0, 3 ).norm( ), 1.0e-9 );
+            BOOST_CHECK_SMALL( ( computedState - expectedState ).segment( 3, 3 ).norm( )
+                               / expectedState.segment( 3, 3 ).norm( ), 1.0e-9 );
+        }
+
+        // Check that zero propagation time returns the initial state.
+        BOOST_CHECK_EQUAL( ( propagators::propagateKeplerOrbitWithUniversalVariable(
+                                 initialState, 0.0, earthGravitationalParameter )
+                             - initialState ).norm( ), 0.0 );
+    }
+}
+
+//! Test if parabolic and near-parabolic orbits are propagated correctly.
+BOOST_AUTO_TEST_CASE( testUniversalVariablePropagationOfParabolicOrbits )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Sun gravitational parameter [m^3/s^2] and semi-latus rectum of comet orbit [m].
+    const double sunGravitationalParameter = 1.32712440018e20;
+    const double semiLatusRectum = 1.5e11;
+
+    // Set parabolic orbit, for which the semi-latus rectum replaces the semi-major axis.
+    Eigen::VectorXd keplerianElements( 6 );
+    keplerianElements << semiLatusRectum, 1.0, 2.0, 1.0, 0.5, 0.0;
+    const propagators::KeplerOrbit parabolicOrbit( keplerianElements, sunGravitationalParameter );
+
+    // Propagate between true anomalies, forwards and backwards in time.
+    const double initialTrueAnomaly = -2.0;
+    const double finalTrueAnomaly = 1.5;
+    const double propagationTime = computeParabolicTimeSincePeriapsis(
+                finalTrueAnomaly, semiLatusRectum, sunGravitationalParameter )
+            - computeParabolicTimeSincePeriapsis( initialTrueAnomaly, semiLatusRectum,
+                                                  sunGravitationalParameter );
+    const Vector6d initialState = parabolicOrbit.getStateAtTrueAnomaly( initialTrueAnomaly );
+    const Vector6d finalState = parabolicOrbit.getStateAtTrueAnomaly( finalTrueAnomaly );
+
+    const Vector6d forwardState = propagators::propagateKeplerOrbitWithUniversalVariable(
+                initialState, propagationTime, sunGravitationalParameter );
+    const Vector6d backwardState = propagators::propagateKeplerOrbitWithUniversalVariable(
+                finalState, -propagationTime, sunGravitationalParameter );
+    BOOST_CHECK_SMALL( ( forwardState - finalState ).segment( 0, 3 ).norm( )
+                       / finalState.segment( 0, 3 ).norm( ), 1.0e-11 );
+    BOOST_CHECK_SMALL( ( forwardState - finalState ).segment( 3, 3 ).norm( )
+                       / finalState.segment( 3, 3 ).norm( ), 1.0e-11 );
+    BOOST_CHECK_SMALL( ( backwardState - initialState ).segment( 0, 3 ).norm( )
+                       / initialState.segment( 0, 3 ).norm( ), 1.0e-11 );
+
+    // Check that near-parabolic orbits, on either side of the parabola, give nearly the same
+    // result, i.e., that the propagation is continuous across the conic types.
+    for ( int sign = -1; sign <= 1; sign += 2 )
+    {
+        Vector6d perturbedInitialState = initialState;
+        perturbedInitialState.segment( 3, 3 ) *= 1.0 + sign * 1.0e-10;
+        const Vector6d perturbedFinalState
+                = propagators::propagateKeplerOrbitWithUniversalVariable(
+                    perturbedInitialState, propagationTime, sunGravitationalParameter );
+        BOOST_CHECK_SMALL( ( perturbedFinalState - finalState ).segment( 0, 3 ).norm( )
+                           / finalState.segment( 0, 3 ).norm( ), 1.0e-8 );
+    }
+}
+
+//! Test if batch universal-variable propagation is correct.
+BOOST_AUTO_TEST_CASE( testBatchUniversalVariablePropagation )
+{
+    using namespace tudat::basic_astrodynamics::orbital_element_conversions;
+
+    // Set Earth gravitational parameter [m^3/s^2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Create set of orbits with random elements, including hyperbolic orbits, and random
+    // propagation times.
+    const int numberOfOrbits = 1000;
+    Eigen::MatrixXd keplerianElements = Eigen::MatrixXd::Random( 6, numberOfOrbits );
+    keplerianElements.row( eccentricityIndex ) = 1.0 + 0.9 * keplerianElements.row( 1 ).array( );
+    keplerianElements.row( semiMajorAxisIndex ) = 1.0e7 * ( 1.0 - keplerianElements.row(
+                                                                eccentricityIndex ).array( ) )
+            .sign( ) * ( 1.5 + keplerianElements.row( 0 ).array( ) );
+    keplerianElements.row( inclinationIndex ) = 0.5 * PI + 0.5 * PI * keplerianElements.row(
+                2 ).array( );
+    keplerianElements.row( trueAnomalyIndex ) = 0.5 * keplerianElements.row( 5 ).array( );
+    Eigen::MatrixXd initialStates( 6, numberOfOrbits );
+    for ( int orbitIndex = 0; orbitIndex < numberOfOrbits; orbitIndex++ )
+    {
+        initialStates.col( orbitIndex ) = convertKeplerianToCartesianElements(
+                    Vector6d( keplerianElements.col( orbitIndex ) ),
+                    earthGravitationalParameter );
+    }
+    const Eigen::VectorXd propagationTimes = 1.0e4 * Eigen::VectorXd::Random( numberOfOrbits );
+
+    // Propagate with a single and multiple threads, and compare with single-orbit propagation.
+    Eigen::MatrixXd finalStates;
+    Eigen::MatrixXd finalStatesWithThreads;
+    propagators::propagateKeplerOrbitsWithUniversalVariable(
+                initialStates, propagationTimes, earthGravitationalParameter, finalStates, 1 );
+    propagators::propagateKeplerOrbitsWithUniversalVariable(
+                initialStates, propagationTimes, earthGravitationalParameter,
+                finalStatesWithThreads, 4 );
+
+    BOOST_CHECK( !finalStates.hasNaN( ) );
+    BOOST_CHECK_EQUAL( ( finalStates - finalStatesWithThreads ).norm( ), 0.0 );
+    for ( int orbitIndex = 0; orbitIndex < numberOfOrbits; orbitIndex++ )
+    {
+        BOOST_CHECK_EQUAL( ( finalStates.col( orbitIndex )
+                             - propagators::propagateKeplerOrbitWithUniversalVariable(
+                                 Vector6d( initialStates.col( orbitIndex ) ),
+                                 propagationTimes( orbitIndex ), earthGravitationalParameter ) )
+                           .norm( ), 0.0 );
+    }
+
+    // Check that an invalid state is set to NaN in the batch propagation, and that an error is
+    // thrown in the single-orbit propagation.
+    initialStates.col( 10 ).setZero( );
+    propagators::propagateKeplerOrbitsWithUniversalVariable(
+                initialStates, propagationTimes, earthGravitationalParameter, finalStates );
+    BOOST_CHECK( finalStates.col( 10 ).hasNaN( ) );
+    BOOST_CHECK( !finalStates.col( 11 ).hasNaN( ) );
+    BOOST_CHECK_THROW( propagators::propagateKeplerOrbitWithUniversalVariable(
+                           Vector6d( initialStates.col( 10 ) ), 100.0,
+                           earthGravitationalParameter ), std::runtime_error );
+    BOOST_CHECK_THROW( propagators::propagateKeplerOrbitsWithUniversalVariable(
+                           initialStates, Eigen::VectorXd( propagationTimes.head( 10 ) ),
+                           earthGravitationalParameter, finalStates ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
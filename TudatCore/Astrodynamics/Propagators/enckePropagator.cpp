@@ -0,0 +1,186 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics, Revised
+ *          Edition, AIAA Education Series, Reston, VA, 1999.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/Propagators/enckePropagator.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using namespace basic_astrodynamics::orbital_element_conversions;
+
+//! Default constructor.
+EnckePropagator::EnckePropagator(
+        const double initialTime, const Vector6d& initialCartesianState,
+        const double centralBodyGravitationalParameter,
+        const PerturbingAccelerationFunction& perturbingAccelerationFunction,
+        const IntegratorCreationFunction& integratorCreationFunction,
+        const double rectificationThreshold )
+    : centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+      perturbingAccelerationFunction_( perturbingAccelerationFunction ),
+      integratorCreationFunction_( integratorCreationFunction ),
+      rectificationThreshold_( rectificationThreshold ),
+      referenceOrbit_( convertCartesianToKeplerianElements(
+                           initialCartesianState, centralBodyGravitationalParameter ),
+                       centralBodyGravitationalParameter ),
+      referenceEpoch_( initialTime ),
+      numberOfRectifications_( 0 )
+{
+    // Check if rectification threshold is valid and throw an error if not.
+    if ( !( rectificationThreshold_ > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Rectification threshold must be positive." ) ) );
+    }
+
+    restartIntegrator( initialTime );
+}
+
+//! Compute deviation derivative.
+Eigen::VectorXd EnckePropagator::computeDeviationDerivative(
+        const double time, const Eigen::VectorXd& deviation ) const
+{
+    const Vector6d referenceState_ = referenceOrbit_.getStateAtTime( time - referenceEpoch_ );
+    const Eigen::Vector3d positionDeviation_ = deviation.segment( 0, 3 );
+    const Eigen::Vector3d referencePosition_ = referenceState_.segment( 0, 3 );
+    const Eigen::Vector3d position_ = referencePosition_ + positionDeviation_;
+
+    // Compute the difference of central body accelerations as mu / rho^3 ( f r - dr ), where
+    // f = 1 - ( rho / r )^3 is evaluated without cancellation from q = ( rho^2 - r^2 ) / r^2
+    // (Battin, 1999).
+    const double q_ = positionDeviation_.dot( positionDeviation_ - 2.0 * position_ )
+            / position_.squaredNorm( );
+    const double f_ = -q_ * ( 3.0 + 3.0 * q_ + q_ * q_ ) / ( 1.0 + std::pow( 1.0 + q_, 1.5 ) );
+    const double referenceRadius_ = referencePosition_.norm( );
+
+    Eigen::VectorXd deviationDerivative_( 6 );
+    deviationDerivative_.segment( 0, 3 ) = deviation.segment( 3, 3 );
+    deviationDerivative_.segment( 3, 3 ) = centralBodyGravitationalParameter_
+            / ( referenceRadius_ * referenceRadius_ * referenceRadius_ )
+            * ( f_ * position_ - positionDeviation_ );
+
+    if ( !perturbingAccelerationFunction_.empty( ) )
+    {
+        deviationDerivative_.segment( 3, 3 ) += perturbingAccelerationFunction_(
+                    time, Vector6d( referenceState_ + deviation ) );
+    }
+
+    return deviationDerivative_;
+}
+
+//! Propagate orbit to given time.
+EnckePropagator::Vector6d EnckePropagator::propagateTo( const double finalTime,
+                                                        const double stepSize )
+{
+    // Set the sign of the step size to the direction of propagation.
+    double stepSize_ = ( finalTime < getCurrentTime( ) ) ? -std::fabs( stepSize )
+                                                         : std::fabs( stepSize );
+
+    bool atFinalTime_ = std::fabs( finalTime - getCurrentTime( ) )
+            <= std::numeric_limits< double >::epsilon( ) * std::fabs( finalTime );
+
+    while ( !atFinalTime_ )
+    {
+        // Check if the remaining interval is smaller than the step size, as in
+        // NumericalIntegrator::integrateTo().
+        if ( std::fabs( finalTime - getCurrentTime( ) )
+             <= std::fabs( stepSize_ ) * ( 1.0 + std::numeric_limits< double >::epsilon( ) ) )
+        {
+            stepSize_ = finalTime - getCurrentTime( );
+            atFinalTime_ = true;
+        }
+
+        integrator_->performIntegrationStep( stepSize_ );
+        stepSize_ = integrator_->getNextStepSize( );
+
+        // Perform additional steps if a variable step size integrator has reduced the last step.
+        if ( atFinalTime_ && std::fabs( finalTime - getCurrentTime( ) ) > std::fabs( stepSize_ )
+             * ( 1.0 + std::numeric_limits< double >::epsilon( ) ) )
+        {
+            atFinalTime_ = false;
+        }
+
+        // Rectify the reference orbit if the position deviation has become too large.
+        const Eigen::VectorXd deviation_ = integrator_->getCurrentState( );
+        if ( deviation_.segment( 0, 3 ).norm( ) > rectificationThreshold_
+             * referenceOrbit_.getStateAtTime( getCurrentTime( ) - referenceEpoch_ )
+             .segment( 0, 3 ).norm( ) )
+        {
+            rectify( );
+        }
+    }
+
+    return getCurrentState( );
+}
+
+//! Rectify reference orbit.
+void EnckePropagator::rectify( )
+{
+    const double currentTime_ = getCurrentTime( );
+    referenceOrbit_ = KeplerOrbit( convertCartesianToKeplerianElements(
+                                       getCurrentState( ), centralBodyGravitationalParameter_ ),
+                                   centralBodyGravitationalParameter_ );
+    referenceEpoch_ = currentTime_;
+    numberOfRectifications_++;
+
+    restartIntegrator( currentTime_ );
+}
+
+//! Get current Cartesian state.
+EnckePropagator::Vector6d EnckePropagator::getCurrentState( ) const
+{
+    return referenceOrbit_.getStateAtTime( getCurrentTime( ) - referenceEpoch_ )
+            + integrator_->getCurrentState( );
+}
+
+//! Restart numerical integrator with zero deviation at given time.
+void EnckePropagator::restartIntegrator( const double time )
+{
+    integrator_ = integratorCreationFunction_(
+                boost::bind( &EnckePropagator::computeDeviationDerivative, this, _1, _2 ),
+                time, Eigen::VectorXd::Zero( 6 ) );
+}
+
+} // namespace propagators
+} // namespace tudat
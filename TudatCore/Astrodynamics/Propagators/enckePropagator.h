@@ -0,0 +1,249 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics, Revised
+ *          Edition, AIAA Education Series, Reston, VA, 1999.
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *      In Encke's method, only the deviation from a reference Kepler orbit is integrated. For
+ *      weakly perturbed orbits, this deviation and its derivatives are small and smooth, such that
+ *      much larger step sizes can be used than when integrating the Cartesian state directly
+ *      (Cowell's method). The reference orbit is rectified, i.e., replaced by the osculating orbit
+ *      at the current state, when the deviation becomes too large.
+ *
+ */
+
+#ifndef TUDAT_CORE_ENCKE_PROPAGATOR_H
+#define TUDAT_CORE_ENCKE_PROPAGATOR_H
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/numericalIntegrator.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Create numerical integrator of given type.
+/*!
+ * Creates a numerical integrator of a given type, which has a constructor taking the state
+ * derivative function, initial independent variable and initial state, such as the Euler and
+ * RK4 integrators. A pointer to this function can be passed as integrator creation function to
+ * the EnckePropagator, e.g., &createNumericalIntegrator< RungeKutta4IntegratorXd >.
+ * \tparam IntegratorType Type of numerical integrator.
+ * \param stateDerivativeFunction State derivative function.
+ * \param initialTime Initial time.                                                             [s]
+ * \param initialState Initial state.
+ * \return Pointer to created numerical integrator.
+ */
+template< typename IntegratorType >
+numerical_integrators::NumericalIntegratorXdPointer createNumericalIntegrator(
+        const numerical_integrators::NumericalIntegrator< >::StateDerivativeFunction&
+        stateDerivativeFunction, const double initialTime, const Eigen::VectorXd& initialState )
+{
+    return numerical_integrators::NumericalIntegratorXdPointer(
+                new IntegratorType( stateDerivativeFunction, initialTime, initialState ) );
+}
+
+//! Propagator of perturbed orbits using Encke's method.
+/*!
+ * Propagator of perturbed orbits using Encke's method, in which the deviation of the Cartesian
+ * state from a reference Kepler orbit is integrated numerically (Battin, 1999; Vallado, 2004). The
+ * reference orbit is evaluated in closed form using a KeplerOrbit, constructed from the
+ * osculating Keplerian elements at the reference epoch. The deviation is integrated with an
+ * arbitrary numerical integrator, created through an integrator creation function. When the
+ * position deviation exceeds a given fraction of the reference position, the reference orbit is
+ * rectified to the osculating orbit at the current state, and the integrator is restarted with a
+ * zero deviation. Since the state derivative function of the integrator is bound to this object,
+ * the propagator cannot be copied.
+ */
+class EnckePropagator
+{
+public:
+
+    //! Typedef for Cartesian state vector.
+    typedef basic_astrodynamics::orbital_element_conversions::Vector6d Vector6d;
+
+    //! Typedef for perturbing acceleration function.
+    /*!
+     * Typedef for function returning the perturbing acceleration in the inertial frame, given the
+     * time and the Cartesian state.
+     */
+    typedef boost::function< Eigen::Vector3d( const double, const Vector6d& ) >
+    PerturbingAccelerationFunction;
+
+    //! Typedef for integrator creation function.
+    /*!
+     * Typedef for function creating a numerical integrator, given the state derivative function,
+     * initial time and initial state.
+     * \sa createNumericalIntegrator().
+     */
+    typedef boost::function< numerical_integrators::NumericalIntegratorXdPointer(
+            const numerical_integrators::NumericalIntegrator< >::StateDerivativeFunction&,
+            const double, const Eigen::VectorXd& ) > IntegratorCreationFunction;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, which sets the reference orbit to the osculating orbit at the initial
+     * state and creates the numerical integrator. An error is thrown if the rectification
+     * threshold is not positive.
+     * \param initialTime Initial time.                                                         [s]
+     * \param initialCartesianState Initial Cartesian state, ordered as given by the
+     *          CartesianElementVectorIndices enum.
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.  [m^3/s^2]
+     * \param perturbingAccelerationFunction Function returning the perturbing acceleration in the
+     *          inertial frame. If empty, the orbit is unperturbed.
+     * \param integratorCreationFunction Function creating the numerical integrator.
+     * \param rectificationThreshold Ratio of position deviation and reference position above
+     *          which the reference orbit is rectified.                                         [-]
+     */
+    EnckePropagator( const double initialTime, const Vector6d& initialCartesianState,
+                     const double centralBodyGravitationalParameter,
+                     const PerturbingAccelerationFunction& perturbingAccelerationFunction,
+                     const IntegratorCreationFunction& integratorCreationFunction,
+                     const double rectificationThreshold = 1.0e-3 );
+
+    //! Compute deviation derivative.
+    /*!
+     * Computes the time derivative of the deviation from the reference orbit. The difference of
+     * the central body accelerations on the actual and reference orbits is computed using the
+     * numerically stable formulation of Battin (1999), which avoids cancellation for small
+     * deviations. This function is bound to the numerical integrator.
+     * \param time Current time.                                                                [s]
+     * \param deviation Current deviation of Cartesian state from reference orbit.
+     * \return Time derivative of deviation.
+     */
+    Eigen::VectorXd computeDeviationDerivative( const double time,
+                                                const Eigen::VectorXd& deviation ) const;
+
+    //! Propagate orbit to given time.
+    /*!
+     * Propagates the orbit to a given time, which may lie before the current time. After each
+     * integration step, the reference orbit is rectified if the position deviation exceeds the
+     * rectification threshold.
+     * \param finalTime Time to propagate to.                                                  [s]
+     * \param stepSize Initial step size; its sign is ignored.                                  [s]
+     * \return Cartesian state at final time.
+     */
+    Vector6d propagateTo( const double finalTime, const double stepSize );
+
+    //! Rectify reference orbit.
+    /*!
+     * Replaces the reference orbit by the osculating orbit at the current state, and restarts the
+     * numerical integrator with a zero deviation.
+     */
+    void rectify( );
+
+    //! Get current time.
+    /*!
+     * Returns the current time of the propagation.
+     * \return Current time.                                                                    [s]
+     */
+    double getCurrentTime( ) const { return integrator_->getCurrentIndependentVariable( ); }
+
+    //! Get current Cartesian state.
+    /*!
+     * Returns the current Cartesian state, as the sum of the reference state and the deviation.
+     * \return Current Cartesian state.
+     */
+    Vector6d getCurrentState( ) const;
+
+    //! Get reference orbit.
+    /*!
+     * Returns the current reference orbit, of which the epoch is given by getReferenceEpoch().
+     * \return Reference orbit.
+     */
+    const KeplerOrbit& getReferenceOrbit( ) const { return referenceOrbit_; }
+
+    //! Get reference epoch.
+    /*!
+     * Returns the epoch of the current reference orbit, i.e., the time of the last
+     * rectification.
+     * \return Reference epoch.                                                                 [s]
+     */
+    double getReferenceEpoch( ) const { return referenceEpoch_; }
+
+    //! Get number of rectifications.
+    /*!
+     * Returns the number of rectifications of the reference orbit since construction.
+     * \return Number of rectifications.
+     */
+    int getNumberOfRectifications( ) const { return numberOfRectifications_; }
+
+private:
+
+    //! Copy constructor, which is not implemented, since the integrator is bound to this object.
+    EnckePropagator( const EnckePropagator& );
+
+    //! Assignment operator, which is not implemented, since the integrator is bound to this object.
+    EnckePropagator& operator=( const EnckePropagator& );
+
+    //! Restart numerical integrator with zero deviation at given time.
+    /*!
+     * Creates a new numerical integrator, starting with a zero deviation at a given time.
+     * \param time Initial time of integrator.                                                  [s]
+     */
+    void restartIntegrator( const double time );
+
+    //! Gravitational parameter of central body.
+    const double centralBodyGravitationalParameter_;
+
+    //! Function returning the perturbing acceleration in the inertial frame.
+    const PerturbingAccelerationFunction perturbingAccelerationFunction_;
+
+    //! Function creating the numerical integrator.
+    const IntegratorCreationFunction integratorCreationFunction_;
+
+    //! Ratio of position deviation and reference position above which the orbit is rectified.
+    const double rectificationThreshold_;
+
+    //! Reference Kepler orbit.
+    KeplerOrbit referenceOrbit_;
+
+    //! Epoch of reference orbit.
+    double referenceEpoch_;
+
+    //! Number of rectifications since construction.
+    int numberOfRectifications_;
+
+    //! Numerical integrator of deviation from reference orbit.
+    numerical_integrators::NumericalIntegratorXdPointer integrator_;
+};
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_ENCKE_PROPAGATOR_H
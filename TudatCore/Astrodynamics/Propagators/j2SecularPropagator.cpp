@@ -0,0 +1,324 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/astrodynamicsFunctions.h"
+#include "TudatCore/Astrodynamics/Propagators/j2SecularPropagator.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/basicMathematicsFunctions.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using namespace basic_astrodynamics::orbital_element_conversions;
+
+namespace
+{
+
+//! Number of orbits per block in batch J2 secular propagation.
+const int PROPAGATION_BLOCK_SIZE = 16;
+
+//! Typedef for fixed-size array used for blocks in batch J2 secular propagation.
+typedef Eigen::Array< double, PROPAGATION_BLOCK_SIZE, 1 > PropagationBlockArray;
+
+//! Check if Keplerian elements describe an elliptical orbit.
+/*!
+ * Checks if Keplerian elements describe an elliptical orbit, i.e., if the semi-major axis is
+ * positive and the eccentricity lies in [ 0, 1 ).
+ * \param semiMajorAxis Semi-major axis.                                                        [m]
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \return True if the orbit is elliptical.
+ */
+bool isEllipticalOrbit( const double semiMajorAxis, const double eccentricity )
+{
+    return semiMajorAxis > 0.0 && eccentricity >= 0.0 && eccentricity < 1.0;
+}
+
+//! Advance angles of orbit.
+/*!
+ * Advances the argument of periapsis, longitude of ascending node and true anomaly of an
+ * elliptical orbit, given the secular rates of the argument of periapsis, longitude of ascending
+ * node and mean anomaly. The true anomaly is converted to mean anomaly and back, via the
+ * eccentric anomaly.
+ * \param keplerianElements Keplerian elements, of which the angles are advanced.
+ * \param secularRates Secular rates of argument of periapsis, longitude of ascending node and
+ *          mean anomaly.                                                                 [rad/s]
+ * \param propagationTime Propagation time.                                                     [s]
+ */
+void advanceAngles( Vector6d& keplerianElements, const Eigen::Vector3d& secularRates,
+                    const double propagationTime )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    const double eccentricity_ = keplerianElements( eccentricityIndex );
+
+    // Compute mean anomaly at end of propagation; whole revolutions are removed before solving
+    // Kepler's equation.
+    const double initialMeanAnomaly_ = convertEllipticalEccentricAnomalyToMeanAnomaly(
+                convertTrueAnomalyToEllipticalEccentricAnomaly(
+                    keplerianElements( trueAnomalyIndex ), eccentricity_ ), eccentricity_ );
+    const double finalMeanAnomaly_ = basic_mathematics::computeModulo(
+                initialMeanAnomaly_ + secularRates( 2 ) * propagationTime + PI, 2.0 * PI ) - PI;
+
+    keplerianElements( argumentOfPeriapsisIndex ) = basic_mathematics::computeModulo(
+                keplerianElements( argumentOfPeriapsisIndex )
+                + secularRates( 0 ) * propagationTime, 2.0 * PI );
+    keplerianElements( longitudeOfAscendingNodeIndex ) = basic_mathematics::computeModulo(
+                keplerianElements( longitudeOfAscendingNodeIndex )
+                + secularRates( 1 ) * propagationTime, 2.0 * PI );
+    keplerianElements( trueAnomalyIndex ) = convertEllipticalEccentricAnomalyToTrueAnomaly(
+                convertMeanAnomalyToEllipticalEccentricAnomaly( finalMeanAnomaly_,
+                                                                eccentricity_ ),
+                eccentricity_ );
+}
+
+//! Loop body for batch J2 secular propagation.
+/*!
+ * Loop body for propagation of a catalog of orbits with the J2 secular rates, to be used with
+ * executeParallelLoop(). Each call propagates a range of blocks of PROPAGATION_BLOCK_SIZE orbits.
+ * For each block, the secular rates are computed with fixed-size arrays, after which the angles
+ * of each orbit are advanced.
+ */
+class J2SecularCatalogPropagation
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param initialStates Matrix of initial states in Keplerian elements (6 x N).
+     * \param propagationTimes Vector of propagation times (N entries).
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+     * \param j2Coefficient Unnormalized J2 coefficient of central body.
+     * \param equatorialRadius Equatorial radius of central body.
+     * \param finalStates Matrix in which the propagated states are stored (6 x N).
+     */
+    J2SecularCatalogPropagation( const Eigen::MatrixXd& initialStates,
+                                 const Eigen::VectorXd& propagationTimes,
+                                 const double centralBodyGravitationalParameter,
+                                 const double j2Coefficient, const double equatorialRadius,
+                                 Eigen::MatrixXd& finalStates )
+        : initialStates_( initialStates ),
+          propagationTimes_( propagationTimes ),
+          centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+          j2Coefficient_( j2Coefficient ),
+          equatorialRadius_( equatorialRadius ),
+          finalStates_( finalStates )
+    { }
+
+    //! Propagate range of blocks.
+    /*!
+     * Propagates the blocks of orbits in the index range [ startBlock, endBlock ).
+     * \param startBlock Index of first block.
+     * \param endBlock One past the index of the last block.
+     */
+    void operator( )( const int startBlock, const int endBlock ) const
+    {
+        for ( int block = startBlock; block < endBlock; block++ )
+        {
+            const int startColumn_ = block * PROPAGATION_BLOCK_SIZE;
+            const int numberOfColumns_ = std::min(
+                        PROPAGATION_BLOCK_SIZE,
+                        static_cast< int >( initialStates_.cols( ) ) - startColumn_ );
+
+            // Load elements into fixed-size arrays. Unused entries of a partial block are set to
+            // a circular orbit with unit semi-major axis, to avoid computations on invalid values.
+            PropagationBlockArray semiMajorAxis_ = PropagationBlockArray::Ones( );
+            PropagationBlockArray eccentricity_ = PropagationBlockArray::Zero( );
+            PropagationBlockArray inclination_ = PropagationBlockArray::Zero( );
+            for ( int i = 0; i < numberOfColumns_; i++ )
+            {
+                semiMajorAxis_( i ) = initialStates_( semiMajorAxisIndex, startColumn_ + i );
+                eccentricity_( i ) = initialStates_( eccentricityIndex, startColumn_ + i );
+                inclination_( i ) = initialStates_( inclinationIndex, startColumn_ + i );
+            }
+
+            // Compute secular rates, as in computeJ2SecularRates().
+            const PropagationBlockArray meanMotion_
+                    = ( centralBodyGravitationalParameter_ / semiMajorAxis_.cube( ) ).sqrt( );
+            const PropagationBlockArray oneMinusEccentricitySquared_
+                    = 1.0 - eccentricity_.square( );
+            const PropagationBlockArray cosineOfInclination_ = inclination_.cos( );
+            const PropagationBlockArray cosineOfInclinationSquared_
+                    = cosineOfInclination_.square( );
+            const PropagationBlockArray rateFactor_ = 0.75 * meanMotion_ * j2Coefficient_
+                    * ( equatorialRadius_ / ( semiMajorAxis_ * oneMinusEccentricitySquared_ ) )
+                    .square( );
+
+            const PropagationBlockArray argumentOfPeriapsisRate_
+                    = rateFactor_ * ( 5.0 * cosineOfInclinationSquared_ - 1.0 );
+            const PropagationBlockArray longitudeOfAscendingNodeRate_
+                    = -2.0 * rateFactor_ * cosineOfInclination_;
+            const PropagationBlockArray meanAnomalyRate_ = meanMotion_ + rateFactor_
+                    * oneMinusEccentricitySquared_.sqrt( )
+                    * ( 3.0 * cosineOfInclinationSquared_ - 1.0 );
+
+            // Advance angles of each orbit.
+            for ( int i = 0; i < numberOfColumns_; i++ )
+            {
+                Vector6d state_ = initialStates_.col( startColumn_ + i );
+                advanceAngles( state_, Eigen::Vector3d( argumentOfPeriapsisRate_( i ),
+                                                        longitudeOfAscendingNodeRate_( i ),
+                                                        meanAnomalyRate_( i ) ),
+                               propagationTimes_( startColumn_ + i ) );
+                finalStates_.col( startColumn_ + i ) = state_;
+            }
+        }
+    }
+
+private:
+
+    //! Matrix of initial states in Keplerian elements.
+    const Eigen::MatrixXd& initialStates_;
+
+    //! Vector of propagation times.
+    const Eigen::VectorXd& propagationTimes_;
+
+    //! Gravitational parameter of central body.
+    const double centralBodyGravitationalParameter_;
+
+    //! Unnormalized J2 coefficient of central body.
+    const double j2Coefficient_;
+
+    //! Equatorial radius of central body.
+    const double equatorialRadius_;
+
+    //! Matrix in which the propagated states are stored.
+    Eigen::MatrixXd& finalStates_;
+};
+
+} // namespace
+
+//! Compute secular rates due to J2.
+Eigen::Vector3d computeJ2SecularRates( const Vector6d& keplerianElements,
+                                       const double centralBodyGravitationalParameter,
+                                       const double j2Coefficient, const double equatorialRadius )
+{
+    const double semiMajorAxis_ = keplerianElements( semiMajorAxisIndex );
+    const double eccentricity_ = keplerianElements( eccentricityIndex );
+    if ( !isEllipticalOrbit( semiMajorAxis_, eccentricity_ ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "J2 secular rates are only defined for elliptical "
+                                            "orbits." ) ) );
+    }
+
+    const double meanMotion_ = basic_astrodynamics::computeKeplerMeanMotion(
+                semiMajorAxis_, centralBodyGravitationalParameter );
+    const double oneMinusEccentricitySquared_ = 1.0 - eccentricity_ * eccentricity_;
+    const double cosineOfInclination_ = std::cos( keplerianElements( inclinationIndex ) );
+    const double radiusRatio_ = equatorialRadius
+            / ( semiMajorAxis_ * oneMinusEccentricitySquared_ );
+    const double rateFactor_ = 0.75 * meanMotion_ * j2Coefficient * radiusRatio_ * radiusRatio_;
+
+    return Eigen::Vector3d(
+                rateFactor_ * ( 5.0 * cosineOfInclination_ * cosineOfInclination_ - 1.0 ),
+                -2.0 * rateFactor_ * cosineOfInclination_,
+                meanMotion_ + rateFactor_ * std::sqrt( oneMinusEccentricitySquared_ )
+                * ( 3.0 * cosineOfInclination_ * cosineOfInclination_ - 1.0 ) );
+}
+
+//! Propagate orbit with J2 secular rates.
+Vector6d propagateJ2SecularOrbit( const Vector6d& initialStateInKeplerianElements,
+                                  const double propagationTime,
+                                  const double centralBodyGravitationalParameter,
+                                  const double j2Coefficient, const double equatorialRadius )
+{
+    Vector6d finalStateInKeplerianElements_ = initialStateInKeplerianElements;
+    advanceAngles( finalStateInKeplerianElements_,
+                   computeJ2SecularRates( initialStateInKeplerianElements,
+                                          centralBodyGravitationalParameter, j2Coefficient,
+                                          equatorialRadius ),
+                   propagationTime );
+    return finalStateInKeplerianElements_;
+}
+
+//! Propagate catalog of orbits with J2 secular rates.
+void propagateJ2SecularOrbits( const Eigen::MatrixXd& initialStatesInKeplerianElements,
+                               const Eigen::VectorXd& propagationTimes,
+                               const double centralBodyGravitationalParameter,
+                               const double j2Coefficient, const double equatorialRadius,
+                               Eigen::MatrixXd& finalStatesInKeplerianElements,
+                               const unsigned int numberOfThreads )
+{
+    // Check input sizes and orbit types, such that no errors can occur in the threads.
+    if ( initialStatesInKeplerianElements.rows( ) != 6
+         || propagationTimes.rows( ) != initialStatesInKeplerianElements.cols( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Keplerian elements matrix should have 6 rows, and "
+                                            "one propagation time per orbit." ) ) );
+    }
+
+    for ( int orbitIndex = 0; orbitIndex < initialStatesInKeplerianElements.cols( );
+          orbitIndex++ )
+    {
+        if ( !isEllipticalOrbit(
+                 initialStatesInKeplerianElements( semiMajorAxisIndex, orbitIndex ),
+                 initialStatesInKeplerianElements( eccentricityIndex, orbitIndex ) ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "J2 secular propagation is only defined for "
+                                                "elliptical orbits." ) ) );
+        }
+    }
+
+    // Resize output matrix; this does not allocate if it already has the correct size.
+    finalStatesInKeplerianElements.resize( 6, initialStatesInKeplerianElements.cols( ) );
+
+    // Propagate blocks of orbits, divided over multiple threads.
+    const int numberOfBlocks_ = ( initialStatesInKeplerianElements.cols( )
+                                  + PROPAGATION_BLOCK_SIZE - 1 ) / PROPAGATION_BLOCK_SIZE;
+    basics::executeParallelLoop(
+                numberOfBlocks_,
+                J2SecularCatalogPropagation( initialStatesInKeplerianElements, propagationTimes,
+                                             centralBodyGravitationalParameter, j2Coefficient,
+                                             equatorialRadius, finalStatesInKeplerianElements ),
+                numberOfThreads, 4 );
+}
+
+} // namespace propagators
+} // namespace tudat
@@ -0,0 +1,134 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *      The secular rates are first-order in J2, and should be applied to mean elements; when
+ *      osculating elements are propagated, the short-period variations due to J2 are not removed
+ *      and appear as errors of order J2 in the propagated elements.
+ *
+ */
+
+#ifndef TUDAT_CORE_J2_SECULAR_PROPAGATOR_H
+#define TUDAT_CORE_J2_SECULAR_PROPAGATOR_H
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Compute secular rates due to J2.
+/*!
+ * Computes the first-order secular rates of the argument of periapsis, the longitude of the
+ * ascending node and the mean anomaly due to the J2 term of the gravity field of the central body
+ * (Vallado, 2004):
+ * \f{eqnarray*}{
+ *      \dot{\omega} &=& \frac{3}{4} n J_2 \left( \frac{R}{p} \right)^2 ( 5 \cos^2 i - 1 ) \\
+ *      \dot{\Omega} &=& -\frac{3}{2} n J_2 \left( \frac{R}{p} \right)^2 \cos i \\
+ *      \dot{M} &=& n + \frac{3}{4} n J_2 \left( \frac{R}{p} \right)^2 \sqrt{ 1 - e^2 }
+ *                      ( 3 \cos^2 i - 1 )
+ * \f}
+ * where n is the Kepler mean motion and p the semi-latus rectum. The other elements have no
+ * secular rates. Only elliptical orbits are supported.
+ * \param keplerianElements Keplerian elements, ordered as given by the
+ *          KeplerianElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.                            [-]
+ * \param equatorialRadius Equatorial radius of central body, with respect to which the J2
+ *          coefficient is defined.                                                             [m]
+ * \return Secular rates of argument of periapsis, longitude of ascending node and mean anomaly,
+ *          in that order.                                                                [rad/s]
+ */
+Eigen::Vector3d computeJ2SecularRates(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d& keplerianElements,
+        const double centralBodyGravitationalParameter, const double j2Coefficient,
+        const double equatorialRadius );
+
+//! Propagate orbit with J2 secular rates.
+/*!
+ * Propagates an elliptical orbit analytically over a given propagation time, using the
+ * first-order secular rates due to J2 of the argument of periapsis, the longitude of the
+ * ascending node and the mean anomaly, as given by computeJ2SecularRates(). The true anomaly is
+ * converted to mean anomaly, all angles are advanced in closed form, and the mean anomaly is
+ * converted back to true anomaly by solving Kepler's equation. The semi-major axis, eccentricity
+ * and inclination are constant. The argument of periapsis and longitude of ascending node are
+ * returned in the range [ 0, 2 pi ), and the true anomaly in the range ( -pi, pi ]. An error is
+ * thrown for non-elliptical orbits.
+ * \param initialStateInKeplerianElements Initial state in Keplerian elements, ordered as given
+ *          by the KeplerianElementVectorIndices enum.
+ * \param propagationTime Propagation time; may be negative.                                    [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.                            [-]
+ * \param equatorialRadius Equatorial radius of central body.                                   [m]
+ * \return Propagated state in Keplerian elements.
+ * \sa computeJ2SecularRates(), orbital_element_conversions::KeplerianElementVectorIndices.
+ */
+basic_astrodynamics::orbital_element_conversions::Vector6d propagateJ2SecularOrbit(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d&
+        initialStateInKeplerianElements,
+        const double propagationTime, const double centralBodyGravitationalParameter,
+        const double j2Coefficient, const double equatorialRadius );
+
+//! Propagate catalog of orbits with J2 secular rates.
+/*!
+ * Propagates a catalog of elliptical orbits analytically with the J2 secular rates, each over its
+ * own propagation time, e.g., to bring element sets with different epochs to a common epoch. The
+ * secular rates of the orbits are computed in blocks using array operations, after which Kepler's
+ * equation is solved for each orbit. The catalog is divided over multiple threads. An error is
+ * thrown if the input sizes do not match or if the catalog contains non-elliptical orbits.
+ * \param initialStatesInKeplerianElements Matrix of initial states in Keplerian elements, with
+ *          one orbit per column (6 x N), ordered as given by the KeplerianElementVectorIndices
+ *          enum.
+ * \param propagationTimes Vector of propagation times, one per orbit (N entries).              [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param j2Coefficient Unnormalized J2 coefficient of central body.                            [-]
+ * \param equatorialRadius Equatorial radius of central body.                                   [m]
+ * \param finalStatesInKeplerianElements Matrix in which the propagated states in Keplerian
+ *          elements are stored (6 x N). If the matrix is preallocated with the correct size, no
+ *          memory is allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \sa propagateJ2SecularOrbit().
+ */
+void propagateJ2SecularOrbits( const Eigen::MatrixXd& initialStatesInKeplerianElements,
+                               const Eigen::VectorXd& propagationTimes,
+                               const double centralBodyGravitationalParameter,
+                               const double j2Coefficient, const double equatorialRadius,
+                               Eigen::MatrixXd& finalStatesInKeplerianElements,
+                               const unsigned int numberOfThreads = 0 );
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_J2_SECULAR_PROPAGATOR_H
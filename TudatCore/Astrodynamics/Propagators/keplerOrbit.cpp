@@ -0,0 +1,245 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using namespace basic_astrodynamics::orbital_element_conversions;
+
+//! Default constructor.
+KeplerOrbit::KeplerOrbit( const Eigen::VectorXd& keplerianElements,
+                          const double centralBodyGravitationalParameter )
+    : keplerianElements_( keplerianElements ),
+      eccentricity_( keplerianElements( eccentricityIndex ) ),
+      isHyperbolic_( eccentricity_ > 1.0 ),
+      isParabolic_( std::fabs( eccentricity_ - 1.0 )
+                    <= std::numeric_limits< double >::epsilon( ) ),
+      meanMotion_( TUDAT_NAN ),
+      meanAnomalyAtEpoch_( TUDAT_NAN )
+{
+    // Check if eccentricity is valid and throw an error if not.
+    if ( eccentricity_ < 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Eccentricity is invalid." ) ) );
+    }
+
+    const double semiMajorAxis_ = keplerianElements( semiMajorAxisIndex );
+
+    // Compute semi-latus rectum, which is given as the first element for parabolic orbits.
+    semiLatusRectum_ = isParabolic_ ? semiMajorAxis_
+                                    : semiMajorAxis_ * ( 1.0 - eccentricity_ * eccentricity_ );
+    velocityScaleAtTrueAnomaly_ = std::sqrt( centralBodyGravitationalParameter
+                                             / semiLatusRectum_ );
+
+    // Compute quantities required to sample the orbit at mean anomaly and time, which are not
+    // defined for parabolic orbits.
+    absoluteSemiMajorAxis_ = std::fabs( semiMajorAxis_ );
+    eccentricityFactor_ = std::sqrt( std::fabs( 1.0 - eccentricity_ * eccentricity_ ) );
+    velocityScaleAtEccentricAnomaly_ = std::sqrt( centralBodyGravitationalParameter
+                                                  * absoluteSemiMajorAxis_ );
+
+    if ( !isParabolic_ )
+    {
+        meanMotion_ = std::sqrt( centralBodyGravitationalParameter
+                                 / ( absoluteSemiMajorAxis_ * absoluteSemiMajorAxis_
+                                     * absoluteSemiMajorAxis_ ) );
+        meanAnomalyAtEpoch_ = convertEccentricAnomalyToMeanAnomaly(
+                    convertTrueAnomalyToEccentricAnomaly( keplerianElements( trueAnomalyIndex ),
+                                                          eccentricity_ ), eccentricity_ );
+    }
+
+    // Compute unit vectors of perifocal frame, which are the columns of the transformation matrix
+    // used in convertKeplerianToCartesianElements().
+    const double cosineOfInclination_ = std::cos( keplerianElements( inclinationIndex ) );
+    const double sineOfInclination_ = std::sin( keplerianElements( inclinationIndex ) );
+    const double cosineOfArgumentOfPeriapsis_
+            = std::cos( keplerianElements( argumentOfPeriapsisIndex ) );
+    const double sineOfArgumentOfPeriapsis_
+            = std::sin( keplerianElements( argumentOfPeriapsisIndex ) );
+    const double cosineOfLongitudeOfAscendingNode_
+            = std::cos( keplerianElements( longitudeOfAscendingNodeIndex ) );
+    const double sineOfLongitudeOfAscendingNode_
+            = std::sin( keplerianElements( longitudeOfAscendingNodeIndex ) );
+
+    unitPeriapsisVector_
+            << cosineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+               - sineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+               * cosineOfInclination_,
+            sineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+            + cosineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+            * cosineOfInclination_,
+            sineOfArgumentOfPeriapsis_ * sineOfInclination_;
+
+    unitSemiLatusRectumVector_
+            << -cosineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+               - sineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+               * cosineOfInclination_,
+            -sineOfLongitudeOfAscendingNode_ * sineOfArgumentOfPeriapsis_
+            + cosineOfLongitudeOfAscendingNode_ * cosineOfArgumentOfPeriapsis_
+            * cosineOfInclination_,
+            cosineOfArgumentOfPeriapsis_ * sineOfInclination_;
+}
+
+//! Get Cartesian state at true anomaly.
+KeplerOrbit::Vector6d KeplerOrbit::getStateAtTrueAnomaly( const double trueAnomaly ) const
+{
+    const double sineOfTrueAnomaly_ = std::sin( trueAnomaly );
+    const double cosineOfTrueAnomaly_ = std::cos( trueAnomaly );
+
+    // Compute radius.
+    const double radius_ = semiLatusRectum_ / ( 1.0 + eccentricity_ * cosineOfTrueAnomaly_ );
+
+    // Transform position and velocity in perifocal frame to inertial frame.
+    Vector6d cartesianState_;
+    cartesianState_.segment< 3 >( 0 )
+            = radius_ * ( cosineOfTrueAnomaly_ * unitPeriapsisVector_
+                          + sineOfTrueAnomaly_ * unitSemiLatusRectumVector_ );
+    cartesianState_.segment< 3 >( 3 )
+            = velocityScaleAtTrueAnomaly_
+            * ( -sineOfTrueAnomaly_ * unitPeriapsisVector_
+                + ( eccentricity_ + cosineOfTrueAnomaly_ ) * unitSemiLatusRectumVector_ );
+
+    return cartesianState_;
+}
+
+//! Get Cartesian state at mean anomaly.
+KeplerOrbit::Vector6d KeplerOrbit::getStateAtMeanAnomaly( const double meanAnomaly ) const
+{
+    // Check if orbit is parabolic and throw an error if true.
+    if ( isParabolic_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Parabolic orbits have not yet been implemented." ) ) );
+    }
+
+    // Compute eccentric anomaly.
+    const double eccentricAnomaly_
+            = convertMeanAnomalyToEccentricAnomaly( meanAnomaly, eccentricity_ );
+
+    // Compute position and velocity components in perifocal frame.
+    double periapsisComponent_ = -0.0;
+    double semiLatusRectumComponent_ = -0.0;
+    double velocityPeriapsisComponent_ = -0.0;
+    double velocitySemiLatusRectumComponent_ = -0.0;
+    double radius_ = -0.0;
+
+    if ( isHyperbolic_ )
+    {
+        const double hyperbolicSine_ = std::sinh( eccentricAnomaly_ );
+        const double hyperbolicCosine_ = std::cosh( eccentricAnomaly_ );
+        radius_ = absoluteSemiMajorAxis_ * ( eccentricity_ * hyperbolicCosine_ - 1.0 );
+        periapsisComponent_ = absoluteSemiMajorAxis_ * ( eccentricity_ - hyperbolicCosine_ );
+        semiLatusRectumComponent_ = absoluteSemiMajorAxis_ * eccentricityFactor_
+                * hyperbolicSine_;
+        velocityPeriapsisComponent_ = -hyperbolicSine_;
+        velocitySemiLatusRectumComponent_ = eccentricityFactor_ * hyperbolicCosine_;
+    }
+
+    else
+    {
+        const double sine_ = std::sin( eccentricAnomaly_ );
+        const double cosine_ = std::cos( eccentricAnomaly_ );
+        radius_ = absoluteSemiMajorAxis_ * ( 1.0 - eccentricity_ * cosine_ );
+        periapsisComponent_ = absoluteSemiMajorAxis_ * ( cosine_ - eccentricity_ );
+        semiLatusRectumComponent_ = absoluteSemiMajorAxis_ * eccentricityFactor_ * sine_;
+        velocityPeriapsisComponent_ = -sine_;
+        velocitySemiLatusRectumComponent_ = eccentricityFactor_ * cosine_;
+    }
+
+    const double velocityFactor_ = velocityScaleAtEccentricAnomaly_ / radius_;
+
+    // Transform position and velocity in perifocal frame to inertial frame.
+    Vector6d cartesianState_;
+    cartesianState_.segment< 3 >( 0 )
+            = periapsisComponent_ * unitPeriapsisVector_
+            + semiLatusRectumComponent_ * unitSemiLatusRectumVector_;
+    cartesianState_.segment< 3 >( 3 )
+            = velocityFactor_ * ( velocityPeriapsisComponent_ * unitPeriapsisVector_
+                                  + velocitySemiLatusRectumComponent_
+                                  * unitSemiLatusRectumVector_ );
+
+    return cartesianState_;
+}
+
+//! Get Cartesian states at true anomalies.
+void KeplerOrbit::getStatesAtTrueAnomalies( const Eigen::VectorXd& trueAnomalies,
+                                            Eigen::MatrixXd& cartesianStates ) const
+{
+    cartesianStates.resize( 6, trueAnomalies.rows( ) );
+    for ( int i = 0; i < trueAnomalies.rows( ); i++ )
+    {
+        cartesianStates.col( i ) = getStateAtTrueAnomaly( trueAnomalies( i ) );
+    }
+}
+
+//! Get Cartesian states at mean anomalies.
+void KeplerOrbit::getStatesAtMeanAnomalies( const Eigen::VectorXd& meanAnomalies,
+                                            Eigen::MatrixXd& cartesianStates ) const
+{
+    cartesianStates.resize( 6, meanAnomalies.rows( ) );
+    for ( int i = 0; i < meanAnomalies.rows( ); i++ )
+    {
+        cartesianStates.col( i ) = getStateAtMeanAnomaly( meanAnomalies( i ) );
+    }
+}
+
+//! Get Cartesian states at times.
+void KeplerOrbit::getStatesAtTimes( const Eigen::VectorXd& timesSinceEpoch,
+                                    Eigen::MatrixXd& cartesianStates ) const
+{
+    cartesianStates.resize( 6, timesSinceEpoch.rows( ) );
+    for ( int i = 0; i < timesSinceEpoch.rows( ); i++ )
+    {
+        cartesianStates.col( i ) = getStateAtTime( timesSinceEpoch( i ) );
+    }
+}
+
+} // namespace propagators
+} // namespace tudat
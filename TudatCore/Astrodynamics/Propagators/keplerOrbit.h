@@ -0,0 +1,217 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *      Parabolic orbits can only be sampled at given true anomalies, since the anomaly
+ *      conversions on which sampling at mean anomaly and time are based do not support them.
+ *
+ */
+
+#ifndef TUDAT_CORE_KEPLER_ORBIT_H
+#define TUDAT_CORE_KEPLER_ORBIT_H
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Kepler orbit with precomputed orbit-constant quantities.
+/*!
+ * Kepler orbit, defined by a set of Keplerian elements, which can be sampled efficiently at many
+ * true anomalies, mean anomalies or times. All orbit-constant quantities (semi-latus rectum,
+ * mean motion, perifocal unit vectors, etc.) are computed once at construction, such that
+ * sampling the orbit only requires the trigonometric functions of the anomaly at each sample.
+ * Elliptical and hyperbolic orbits are supported for all sampling functions; parabolic orbits can
+ * only be sampled at given true anomalies, in which case the semi-latus rectum is given instead
+ * of the semi-major axis, as for convertKeplerianToCartesianElements().
+ */
+class KeplerOrbit
+{
+public:
+
+    //! Typedef for Cartesian state vector.
+    typedef basic_astrodynamics::orbital_element_conversions::Vector6d Vector6d;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, which computes the orbit-constant quantities of the orbit.
+     * \param keplerianElements Keplerian elements at the epoch of the orbit, ordered as given by
+     *          the KeplerianElementVectorIndices enum.
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.  [m^3/s^2]
+     * \sa orbital_element_conversions::KeplerianElementVectorIndices.
+     */
+    KeplerOrbit( const Eigen::VectorXd& keplerianElements,
+                 const double centralBodyGravitationalParameter );
+
+    //! Get Keplerian elements at epoch.
+    /*!
+     * Returns the Keplerian elements at the epoch of the orbit.
+     * \return Keplerian elements at epoch.
+     */
+    Vector6d getKeplerianElements( ) const { return keplerianElements_; }
+
+    //! Get mean motion.
+    /*!
+     * Returns the mean motion of the orbit. For parabolic orbits, NaN is returned.
+     * \return Mean motion.                                                                 [rad/s]
+     */
+    double getMeanMotion( ) const { return meanMotion_; }
+
+    //! Get mean anomaly at epoch.
+    /*!
+     * Returns the mean anomaly at the epoch of the orbit. For parabolic orbits, NaN is returned.
+     * \return Mean anomaly at epoch.                                                         [rad]
+     */
+    double getMeanAnomalyAtEpoch( ) const { return meanAnomalyAtEpoch_; }
+
+    //! Get Cartesian state at true anomaly.
+    /*!
+     * Returns the Cartesian state of the orbit at a given true anomaly. For hyperbolic orbits, the
+     * true anomaly should lie between the asymptotes.
+     * \param trueAnomaly True anomaly.                                                       [rad]
+     * \return Cartesian state, ordered as given by the CartesianElementVectorIndices enum.
+     */
+    Vector6d getStateAtTrueAnomaly( const double trueAnomaly ) const;
+
+    //! Get Cartesian state at mean anomaly.
+    /*!
+     * Returns the Cartesian state of the orbit at a given mean anomaly. The eccentric anomaly is
+     * obtained by solving Kepler's equation, after which the state is computed in closed form
+     * from the eccentric anomaly (Vallado, 2004), without computing the true anomaly. An error is
+     * thrown for parabolic orbits.
+     * \param meanAnomaly Mean anomaly.                                                       [rad]
+     * \return Cartesian state, ordered as given by the CartesianElementVectorIndices enum.
+     */
+    Vector6d getStateAtMeanAnomaly( const double meanAnomaly ) const;
+
+    //! Get Cartesian state at time.
+    /*!
+     * Returns the Cartesian state of the orbit at a given time with respect to the epoch of the
+     * orbit. An error is thrown for parabolic orbits.
+     * \param timeSinceEpoch Time since epoch; may be negative.                                 [s]
+     * \return Cartesian state, ordered as given by the CartesianElementVectorIndices enum.
+     */
+    Vector6d getStateAtTime( const double timeSinceEpoch ) const
+    {
+        return getStateAtMeanAnomaly( meanAnomalyAtEpoch_ + meanMotion_ * timeSinceEpoch );
+    }
+
+    //! Get Cartesian states at true anomalies.
+    /*!
+     * Computes the Cartesian states of the orbit at a set of true anomalies.
+     * \param trueAnomalies Vector of true anomalies (N entries).                             [rad]
+     * \param cartesianStates Matrix in which the Cartesian states are stored (6 x N), with one
+     *          state per column. If the matrix is preallocated with the correct size, no memory is
+     *          allocated; otherwise it is resized.
+     * \sa getStateAtTrueAnomaly().
+     */
+    void getStatesAtTrueAnomalies( const Eigen::VectorXd& trueAnomalies,
+                                   Eigen::MatrixXd& cartesianStates ) const;
+
+    //! Get Cartesian states at mean anomalies.
+    /*!
+     * Computes the Cartesian states of the orbit at a set of mean anomalies.
+     * \param meanAnomalies Vector of mean anomalies (N entries).                             [rad]
+     * \param cartesianStates Matrix in which the Cartesian states are stored (6 x N), with one
+     *          state per column. If the matrix is preallocated with the correct size, no memory is
+     *          allocated; otherwise it is resized.
+     * \sa getStateAtMeanAnomaly().
+     */
+    void getStatesAtMeanAnomalies( const Eigen::VectorXd& meanAnomalies,
+                                   Eigen::MatrixXd& cartesianStates ) const;
+
+    //! Get Cartesian states at times.
+    /*!
+     * Computes the Cartesian states of the orbit at a set of times with respect to the epoch of
+     * the orbit.
+     * \param timesSinceEpoch Vector of times since epoch (N entries).                          [s]
+     * \param cartesianStates Matrix in which the Cartesian states are stored (6 x N), with one
+     *          state per column. If the matrix is preallocated with the correct size, no memory is
+     *          allocated; otherwise it is resized.
+     * \sa getStateAtTime().
+     */
+    void getStatesAtTimes( const Eigen::VectorXd& timesSinceEpoch,
+                           Eigen::MatrixXd& cartesianStates ) const;
+
+private:
+
+    //! Keplerian elements at epoch.
+    /*!
+     * Keplerian elements at epoch, stored without alignment requirement, such that orbits can be
+     * stored by value in standard containers without an aligned allocator.
+     */
+    Eigen::Matrix< double, 6, 1, Eigen::DontAlign > keplerianElements_;
+
+    //! Eccentricity.
+    double eccentricity_;
+
+    //! Flag indicating whether the orbit is hyperbolic.
+    bool isHyperbolic_;
+
+    //! Flag indicating whether the orbit is parabolic.
+    bool isParabolic_;
+
+    //! Semi-latus rectum.
+    double semiLatusRectum_;
+
+    //! Square root of the ratio of gravitational parameter and semi-latus rectum.
+    double velocityScaleAtTrueAnomaly_;
+
+    //! Absolute value of semi-major axis.
+    double absoluteSemiMajorAxis_;
+
+    //! Square root of | 1 - e^2 |.
+    double eccentricityFactor_;
+
+    //! Square root of the product of gravitational parameter and absolute semi-major axis.
+    double velocityScaleAtEccentricAnomaly_;
+
+    //! Mean motion.
+    double meanMotion_;
+
+    //! Mean anomaly at epoch.
+    double meanAnomalyAtEpoch_;
+
+    //! Unit vector pointing to periapsis.
+    Eigen::Vector3d unitPeriapsisVector_;
+
+    //! Unit vector in orbital plane, perpendicular to unitPeriapsisVector_ in direction of motion.
+    Eigen::Vector3d unitSemiLatusRectumVector_;
+};
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_KEPLER_ORBIT_H
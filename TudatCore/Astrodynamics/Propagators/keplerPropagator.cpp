@@ -0,0 +1,182 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Chobotov, V.A. Orbital Mechanics, Third Edition, AIAA Education Series, VA, 2002.
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerOrbit.h"
+#include "TudatCore/Astrodynamics/Propagators/keplerPropagator.h"
+#include "TudatCore/Basics/parallelLoop.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using namespace basic_astrodynamics::orbital_element_conversions;
+
+namespace
+{
+
+//! Loop body for propagation of a catalog of Kepler orbits.
+/*!
+ * Loop body for propagation of a catalog of Kepler orbits, to be used with executeParallelLoop().
+ * Each call propagates a contiguous block of orbits to all propagation times.
+ */
+class KeplerOrbitCatalogPropagation
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param orbits Kepler orbits in catalog.
+     * \param propagationTimes Vector of propagation times.
+     * \param cartesianStates Matrix in which the propagated Cartesian states are stored.
+     */
+    KeplerOrbitCatalogPropagation( const std::vector< KeplerOrbit >& orbits,
+                                   const Eigen::VectorXd& propagationTimes,
+                                   Eigen::MatrixXd& cartesianStates )
+        : orbits_( orbits ),
+          propagationTimes_( propagationTimes ),
+          cartesianStates_( cartesianStates )
+    { }
+
+    //! Propagate block of orbits.
+    /*!
+     * Propagates the orbits in the index range [ startIndex, endIndex ) to all propagation times.
+     * \param startIndex Index of first orbit.
+     * \param endIndex One past the index of the last orbit.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        for ( int timeIndex = 0; timeIndex < propagationTimes_.rows( ); timeIndex++ )
+        {
+            for ( int orbitIndex = startIndex; orbitIndex < endIndex; orbitIndex++ )
+            {
+                cartesianStates_.col( timeIndex ).segment< 6 >( 6 * orbitIndex )
+                        = orbits_[ orbitIndex ].getStateAtTime( propagationTimes_( timeIndex ) );
+            }
+        }
+    }
+
+private:
+
+    //! Kepler orbits in catalog.
+    const std::vector< KeplerOrbit >& orbits_;
+
+    //! Vector of propagation times.
+    const Eigen::VectorXd& propagationTimes_;
+
+    //! Matrix in which the propagated Cartesian states are stored.
+    Eigen::MatrixXd& cartesianStates_;
+};
+
+} // namespace
+
+//! Propagate Kepler orbit.
+Eigen::VectorXd propagateKeplerOrbit( const Eigen::VectorXd& initialStateInKeplerianElements,
+                                      const double propagationTime,
+                                      const double centralBodyGravitationalParameter )
+{
+    // Set eccentricity.
+    const double eccentricity_ = initialStateInKeplerianElements( eccentricityIndex );
+
+    // Compute initial mean anomaly.
+    const double initialMeanAnomaly_ = convertEccentricAnomalyToMeanAnomaly(
+                convertTrueAnomalyToEccentricAnomaly(
+                    initialStateInKeplerianElements( trueAnomalyIndex ), eccentricity_ ),
+                eccentricity_ );
+
+    // Compute mean anomaly at end of propagation.
+    const double finalMeanAnomaly_ = initialMeanAnomaly_ + convertElapsedTimeToMeanAnomalyChange(
+                propagationTime, centralBodyGravitationalParameter,
+                initialStateInKeplerianElements( semiMajorAxisIndex ) );
+
+    // Declare propagated Keplerian elements; only the true anomaly changes.
+    Eigen::VectorXd finalStateInKeplerianElements_ = initialStateInKeplerianElements;
+
+    // Compute true anomaly at end of propagation.
+    finalStateInKeplerianElements_( trueAnomalyIndex ) = convertEccentricAnomalyToTrueAnomaly(
+                convertMeanAnomalyToEccentricAnomaly( finalMeanAnomaly_, eccentricity_ ),
+                eccentricity_ );
+
+    // Return propagated Keplerian elements.
+    return finalStateInKeplerianElements_;
+}
+
+//! Propagate catalog of Kepler orbits to a grid of times.
+void propagateKeplerOrbits( const Eigen::MatrixXd& initialStatesInKeplerianElements,
+                            const Eigen::VectorXd& propagationTimes,
+                            const double centralBodyGravitationalParameter,
+                            Eigen::MatrixXd& cartesianStates,
+                            const unsigned int numberOfThreads )
+{
+    // Check if input matrix has the correct number of rows and throw an error if not.
+    if ( initialStatesInKeplerianElements.rows( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Keplerian elements matrix should have 6 rows." ) ) );
+    }
+
+    const int numberOfOrbits_ = initialStatesInKeplerianElements.cols( );
+
+    // Compute orbit-constant quantities of all orbits.
+    std::vector< KeplerOrbit > orbits_;
+    orbits_.reserve( numberOfOrbits_ );
+    for ( int orbitIndex = 0; orbitIndex < numberOfOrbits_; orbitIndex++ )
+    {
+        orbits_.push_back( KeplerOrbit( initialStatesInKeplerianElements.col( orbitIndex ),
+                                        centralBodyGravitationalParameter ) );
+    }
+
+    // Resize output matrix; this does not allocate if it already has the correct size.
+    cartesianStates.resize( 6 * numberOfOrbits_, propagationTimes.rows( ) );
+
+    // Propagate orbits, divided over multiple threads.
+    basics::executeParallelLoop(
+                numberOfOrbits_, KeplerOrbitCatalogPropagation( orbits_, propagationTimes,
+                                                                cartesianStates ),
+                numberOfThreads, 64 );
+}
+
+} // namespace propagators
+} // namespace tudat
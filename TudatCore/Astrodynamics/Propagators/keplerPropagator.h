@@ -0,0 +1,99 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Chobotov, V.A. Orbital Mechanics, Third Edition, AIAA Education Series, VA, 2002.
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *
+ *    Notes
+ *      Parabolic orbits are not supported by the functions in this file, since the anomaly
+ *      conversions they are based on do not support them.
+ *
+ */
+
+#ifndef TUDAT_CORE_KEPLER_PROPAGATOR_H
+#define TUDAT_CORE_KEPLER_PROPAGATOR_H
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Propagate Kepler orbit.
+/*!
+ * Propagates a Kepler orbit analytically, given as a set of Keplerian elements, over a given
+ * propagation time. The true anomaly is converted to mean anomaly, the mean anomaly is advanced
+ * using the mean motion, and the result is converted back to true anomaly by solving Kepler's
+ * equation. The other elements are constant. Both elliptical and hyperbolic orbits are supported.
+ * \param initialStateInKeplerianElements Initial state in Keplerian elements, ordered as given
+ *          by the KeplerianElementVectorIndices enum.
+ * \param propagationTime Propagation time; may be negative.                                    [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Propagated state in Keplerian elements.
+ * \sa orbital_element_conversions::KeplerianElementVectorIndices.
+ */
+Eigen::VectorXd propagateKeplerOrbit( const Eigen::VectorXd& initialStateInKeplerianElements,
+                                      const double propagationTime,
+                                      const double centralBodyGravitationalParameter );
+
+//! Propagate catalog of Kepler orbits to a grid of times.
+/*!
+ * Propagates a catalog of Kepler orbits analytically to a grid of propagation times, and computes
+ * the Cartesian states of all orbits at all times. For each orbit, a KeplerOrbit is constructed,
+ * such that the orbit-constant quantities (mean motion, initial mean anomaly, perifocal unit
+ * vectors, etc.) are computed once. The Cartesian state at each time is then computed in closed
+ * form from the eccentric anomaly, so that the true anomaly and the transformation matrix are not
+ * recomputed. The catalog is divided over multiple threads.
+ * \param initialStatesInKeplerianElements Matrix of initial states in Keplerian elements, with
+ *          one orbit per column (6 x N), ordered as given by the KeplerianElementVectorIndices
+ *          enum.
+ * \param propagationTimes Vector of propagation times, with respect to the epoch of the initial
+ *          states (T entries).                                                                 [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param cartesianStates Matrix in which the propagated Cartesian states are stored (6N x T),
+ *          such that column j contains the states of all orbits at propagationTimes( j ), with the
+ *          state of orbit i in rows 6i to 6i+5, ordered as given by the
+ *          CartesianElementVectorIndices enum. If the matrix is preallocated with the correct
+ *          size, no memory is allocated; otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \sa orbital_element_conversions::KeplerianElementVectorIndices,
+ *     orbital_element_conversions::CartesianElementVectorIndices.
+ */
+void propagateKeplerOrbits( const Eigen::MatrixXd& initialStatesInKeplerianElements,
+                            const Eigen::VectorXd& propagationTimes,
+                            const double centralBodyGravitationalParameter,
+                            Eigen::MatrixXd& cartesianStates,
+                            const unsigned int numberOfThreads = 0 );
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_KEPLER_PROPAGATOR_H
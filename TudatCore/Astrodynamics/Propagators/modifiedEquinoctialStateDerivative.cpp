@@ -0,0 +1,141 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Walker, M.J.H., Ireland, B., Owens, J. A set of modified equinoctial orbit elements,
+ *          Celestial Mechanics, 36, 409-419, 1985.
+ *      Betts, J.T. Practical Methods for Optimal Control and Estimation Using Nonlinear
+ *          Programming, 2nd Edition, SIAM, Philadelphia, 2010.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/modifiedEquinoctialElementConversions.h"
+#include "TudatCore/Astrodynamics/Propagators/modifiedEquinoctialStateDerivative.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using namespace basic_astrodynamics::orbital_element_conversions;
+
+//! Compute rates of modified equinoctial elements.
+Vector6d computeModifiedEquinoctialElementRates(
+        const Vector6d& modifiedEquinoctialElements,
+        const Eigen::Vector3d& perturbingAccelerationInRswFrame,
+        const double centralBodyGravitationalParameter )
+{
+    const double semiLatusRectum_ = modifiedEquinoctialElements( semiLatusRectumIndex );
+    const double fElement_ = modifiedEquinoctialElements( fElementIndex );
+    const double gElement_ = modifiedEquinoctialElements( gElementIndex );
+    const double hElement_ = modifiedEquinoctialElements( hElementIndex );
+    const double kElement_ = modifiedEquinoctialElements( kElementIndex );
+    const double cosineOfTrueLongitude_
+            = std::cos( modifiedEquinoctialElements( trueLongitudeIndex ) );
+    const double sineOfTrueLongitude_
+            = std::sin( modifiedEquinoctialElements( trueLongitudeIndex ) );
+
+    const double radialAcceleration_ = perturbingAccelerationInRswFrame( 0 );
+    const double transverseAcceleration_ = perturbingAccelerationInRswFrame( 1 );
+    const double normalAcceleration_ = perturbingAccelerationInRswFrame( 2 );
+
+    // Compute auxiliary quantities (Betts, 2010).
+    const double qTerm_ = 1.0 + fElement_ * cosineOfTrueLongitude_
+            + gElement_ * sineOfTrueLongitude_;
+    const double inverseOfQTerm_ = 1.0 / qTerm_;
+    const double squaredSTerm_ = 1.0 + hElement_ * hElement_ + kElement_ * kElement_;
+    const double rateScale_ = std::sqrt( semiLatusRectum_ / centralBodyGravitationalParameter );
+    const double outOfPlaneTerm_ = ( hElement_ * sineOfTrueLongitude_
+                                     - kElement_ * cosineOfTrueLongitude_ )
+            * inverseOfQTerm_ * normalAcceleration_;
+
+    Vector6d elementRates_;
+
+    elementRates_( semiLatusRectumIndex ) = 2.0 * semiLatusRectum_ * inverseOfQTerm_
+            * rateScale_ * transverseAcceleration_;
+    elementRates_( fElementIndex ) = rateScale_ * (
+                radialAcceleration_ * sineOfTrueLongitude_
+                + ( ( qTerm_ + 1.0 ) * cosineOfTrueLongitude_ + fElement_ ) * inverseOfQTerm_
+                * transverseAcceleration_
+                - gElement_ * outOfPlaneTerm_ );
+    elementRates_( gElementIndex ) = rateScale_ * (
+                -radialAcceleration_ * cosineOfTrueLongitude_
+                + ( ( qTerm_ + 1.0 ) * sineOfTrueLongitude_ + gElement_ ) * inverseOfQTerm_
+                * transverseAcceleration_
+                + fElement_ * outOfPlaneTerm_ );
+    elementRates_( hElementIndex ) = 0.5 * rateScale_ * squaredSTerm_ * inverseOfQTerm_
+            * normalAcceleration_ * cosineOfTrueLongitude_;
+    elementRates_( kElementIndex ) = 0.5 * rateScale_ * squaredSTerm_ * inverseOfQTerm_
+            * normalAcceleration_ * sineOfTrueLongitude_;
+    elementRates_( trueLongitudeIndex )
+            = std::sqrt( centralBodyGravitationalParameter * semiLatusRectum_ )
+            * ( qTerm_ / semiLatusRectum_ ) * ( qTerm_ / semiLatusRectum_ )
+            + rateScale_ * outOfPlaneTerm_;
+
+    return elementRates_;
+}
+
+//! Compute state derivative.
+Eigen::VectorXd ModifiedEquinoctialStateDerivative::computeStateDerivative(
+        const double time, const Eigen::VectorXd& modifiedEquinoctialElements ) const
+{
+    // Compute perturbing acceleration in RSW frame, if a perturbation is set.
+    Eigen::Vector3d perturbingAccelerationInRswFrame_ = Eigen::Vector3d::Zero( );
+
+    if ( !perturbingAccelerationFunction_.empty( ) )
+    {
+        const Vector6d cartesianState_ = convertModifiedEquinoctialToCartesianElements(
+                    modifiedEquinoctialElements, centralBodyGravitationalParameter_ );
+        const Eigen::Vector3d perturbingAcceleration_
+                = perturbingAccelerationFunction_( time, cartesianState_ );
+
+        // Compute unit vectors of RSW frame.
+        const Eigen::Vector3d unitRadialVector_
+                = cartesianState_.segment< 3 >( xPositionIndex ).normalized( );
+        const Eigen::Vector3d unitNormalVector_
+                = cartesianState_.segment< 3 >( xPositionIndex ).cross(
+                    cartesianState_.segment< 3 >( xVelocityIndex ) ).normalized( );
+        const Eigen::Vector3d unitTransverseVector_ = unitNormalVector_.cross( unitRadialVector_ );
+
+        perturbingAccelerationInRswFrame_ << perturbingAcceleration_.dot( unitRadialVector_ ),
+                perturbingAcceleration_.dot( unitTransverseVector_ ),
+                perturbingAcceleration_.dot( unitNormalVector_ );
+    }
+
+    return computeModifiedEquinoctialElementRates( modifiedEquinoctialElements,
+                                                   perturbingAccelerationInRswFrame_,
+                                                   centralBodyGravitationalParameter_ );
+}
+
+} // namespace propagators
+} // namespace tudat
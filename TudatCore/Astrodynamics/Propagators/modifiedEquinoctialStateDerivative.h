@@ -0,0 +1,139 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Walker, M.J.H., Ireland, B., Owens, J. A set of modified equinoctial orbit elements,
+ *          Celestial Mechanics, 36, 409-419, 1985.
+ *      Betts, J.T. Practical Methods for Optimal Control and Estimation Using Nonlinear
+ *          Programming, 2nd Edition, SIAM, Philadelphia, 2010.
+ *
+ *    Notes
+ *      For unperturbed orbits, only the true longitude changes, such that numerical integration of
+ *      the modified equinoctial elements allows much larger step sizes than integration of the
+ *      Cartesian state for near-Keplerian orbits.
+ *
+ */
+
+#ifndef TUDAT_CORE_MODIFIED_EQUINOCTIAL_STATE_DERIVATIVE_H
+#define TUDAT_CORE_MODIFIED_EQUINOCTIAL_STATE_DERIVATIVE_H
+
+#include <boost/function.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Compute rates of modified equinoctial elements.
+/*!
+ * Computes the time derivatives of the modified equinoctial elements using the Gauss variational
+ * equations (Walker et al., 1985; Betts, 2010), for a given perturbing acceleration expressed in
+ * the RSW frame. The RSW frame has its first axis along the position vector, its third axis along
+ * the angular momentum vector and its second axis completing the right-handed frame.
+ * \param modifiedEquinoctialElements Modified equinoctial elements, ordered as given by the
+ *          ModifiedEquinoctialElementVectorIndices enum.
+ * \param perturbingAccelerationInRswFrame Perturbing acceleration in RSW frame.           [m/s^2]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Time derivatives of modified equinoctial elements.
+ * \sa orbital_element_conversions::ModifiedEquinoctialElementVectorIndices.
+ */
+basic_astrodynamics::orbital_element_conversions::Vector6d
+computeModifiedEquinoctialElementRates(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d&
+        modifiedEquinoctialElements,
+        const Eigen::Vector3d& perturbingAccelerationInRswFrame,
+        const double centralBodyGravitationalParameter );
+
+//! State derivative for propagation of modified equinoctial elements.
+/*!
+ * State derivative for numerical propagation of modified equinoctial elements, for a central
+ * body with point-mass gravity and an optional perturbing acceleration. The perturbing
+ * acceleration is provided as a function of time and Cartesian state, expressed in the inertial
+ * frame, and is transformed to the RSW frame before the Gauss variational equations are
+ * evaluated. The computeStateDerivative() function can be bound to the state derivative function
+ * of the numerical integrators, e.g.:
+ * \code
+ * RungeKutta4IntegratorXd integrator(
+ *     boost::bind( &ModifiedEquinoctialStateDerivative::computeStateDerivative,
+ *                  &stateDerivative, _1, _2 ), initialTime, initialModifiedEquinoctialElements );
+ * \endcode
+ */
+class ModifiedEquinoctialStateDerivative
+{
+public:
+
+    //! Typedef for perturbing acceleration function.
+    /*!
+     * Typedef for function returning the perturbing acceleration in the inertial frame, given the
+     * time and the Cartesian state.
+     */
+    typedef boost::function< Eigen::Vector3d(
+            const double, const basic_astrodynamics::orbital_element_conversions::Vector6d& ) >
+    PerturbingAccelerationFunction;
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.  [m^3/s^2]
+     * \param perturbingAccelerationFunction Function returning the perturbing acceleration in the
+     *          inertial frame. If empty, the orbit is unperturbed.
+     */
+    ModifiedEquinoctialStateDerivative(
+            const double centralBodyGravitationalParameter,
+            const PerturbingAccelerationFunction& perturbingAccelerationFunction
+            = PerturbingAccelerationFunction( ) )
+        : centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+          perturbingAccelerationFunction_( perturbingAccelerationFunction )
+    { }
+
+    //! Compute state derivative.
+    /*!
+     * Computes the time derivatives of the modified equinoctial elements.
+     * \param time Current time.                                                                [s]
+     * \param modifiedEquinoctialElements Current modified equinoctial elements.
+     * \return Time derivatives of modified equinoctial elements.
+     */
+    Eigen::VectorXd computeStateDerivative(
+            const double time, const Eigen::VectorXd& modifiedEquinoctialElements ) const;
+
+private:
+
+    //! Gravitational parameter of central body.
+    const double centralBodyGravitationalParameter_;
+
+    //! Function returning the perturbing acceleration in the inertial frame.
+    const PerturbingAccelerationFunction perturbingAccelerationFunction_;
+};
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_MODIFIED_EQUINOCTIAL_STATE_DERIVATIVE_H
@@ -0,0 +1,316 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Stiefel, E.L., Scheifele, G. Linear and Regular Celestial Mechanics, Springer-Verlag,
+ *          Berlin, 1971.
+ *      Dowell, M., Jarratt, P. A modified regula falsi method for computing the root of an
+ *          equation, BIT Numerical Mathematics, 11, 168-174, 1971.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/Propagators/regularizedStateDerivatives.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+namespace
+{
+
+//! Compute Kustaanheimo-Stiefel matrix.
+/*!
+ * Computes the Kustaanheimo-Stiefel matrix L( u ), for which the Cartesian position is given by
+ * the first three elements of L( u ) u (Stiefel and Scheifele, 1971).
+ * \param kustaanheimoStiefelPosition Kustaanheimo-Stiefel position u.                    [m^0.5]
+ * \return Kustaanheimo-Stiefel matrix.
+ */
+Eigen::Matrix4d computeKustaanheimoStiefelMatrix(
+        const Eigen::Vector4d& kustaanheimoStiefelPosition )
+{
+    const Eigen::Vector4d& u = kustaanheimoStiefelPosition;
+
+    Eigen::Matrix4d kustaanheimoStiefelMatrix_;
+    kustaanheimoStiefelMatrix_ << u( 0 ), -u( 1 ), -u( 2 ), u( 3 ),
+            u( 1 ), u( 0 ), -u( 3 ), -u( 2 ),
+            u( 2 ), u( 3 ), u( 0 ), u( 1 ),
+            u( 3 ), -u( 2 ), u( 1 ), -u( 0 );
+    return kustaanheimoStiefelMatrix_;
+}
+
+} // namespace
+
+//! Convert Cartesian state and time to Kustaanheimo-Stiefel state.
+Vector10d convertCartesianToKustaanheimoStiefelState(
+        const Vector6d& cartesianState, const double time,
+        const double centralBodyGravitationalParameter )
+{
+    const double radius_ = cartesianState.segment< 3 >( 0 ).norm( );
+
+    // Compute KS position, selecting the solution for which the largest element is obtained from
+    // the square root, which avoids loss of precision.
+    Eigen::Vector4d kustaanheimoStiefelPosition_;
+    if ( cartesianState( 0 ) >= 0.0 )
+    {
+        const double u1_ = std::sqrt( 0.5 * ( radius_ + cartesianState( 0 ) ) );
+        kustaanheimoStiefelPosition_ << u1_, 0.5 * cartesianState( 1 ) / u1_,
+                0.5 * cartesianState( 2 ) / u1_, 0.0;
+    }
+    else
+    {
+        const double u2_ = std::sqrt( 0.5 * ( radius_ - cartesianState( 0 ) ) );
+        kustaanheimoStiefelPosition_ << 0.5 * cartesianState( 1 ) / u2_, u2_,
+                0.0, 0.5 * cartesianState( 2 ) / u2_;
+    }
+
+    // Compute KS velocity, which satisfies the bilinear relation, as u' = L^T( u ) v / 2.
+    Eigen::Vector4d cartesianVelocity_;
+    cartesianVelocity_ << cartesianState.segment< 3 >( 3 ), 0.0;
+
+    Vector10d kustaanheimoStiefelState_;
+    kustaanheimoStiefelState_.segment< 4 >( kustaanheimoStiefelPositionIndex )
+            = kustaanheimoStiefelPosition_;
+    kustaanheimoStiefelState_.segment< 4 >( kustaanheimoStiefelVelocityIndex )
+            = 0.5 * computeKustaanheimoStiefelMatrix( kustaanheimoStiefelPosition_ ).transpose( )
+            * cartesianVelocity_;
+    kustaanheimoStiefelState_( kustaanheimoStiefelEnergyIndex )
+            = centralBodyGravitationalParameter / radius_
+            - 0.5 * cartesianState.segment< 3 >( 3 ).squaredNorm( );
+    kustaanheimoStiefelState_( kustaanheimoStiefelTimeIndex ) = time;
+    return kustaanheimoStiefelState_;
+}
+
+//! Convert Kustaanheimo-Stiefel state to Cartesian state.
+Vector6d convertKustaanheimoStiefelToCartesianState( const Vector10d& kustaanheimoStiefelState )
+{
+    const Eigen::Vector4d kustaanheimoStiefelPosition_
+            = kustaanheimoStiefelState.segment< 4 >( kustaanheimoStiefelPositionIndex );
+    const Eigen::Matrix4d kustaanheimoStiefelMatrix_
+            = computeKustaanheimoStiefelMatrix( kustaanheimoStiefelPosition_ );
+
+    // Compute position as L( u ) u and velocity as 2 L( u ) u' / r.
+    Vector6d cartesianState_;
+    cartesianState_.segment< 3 >( 0 ) = ( kustaanheimoStiefelMatrix_
+                                          * kustaanheimoStiefelPosition_ ).segment< 3 >( 0 );
+    cartesianState_.segment< 3 >( 3 ) = 2.0 / kustaanheimoStiefelPosition_.squaredNorm( )
+            * ( kustaanheimoStiefelMatrix_ * kustaanheimoStiefelState.segment< 4 >(
+                    kustaanheimoStiefelVelocityIndex ) ).segment< 3 >( 0 );
+    return cartesianState_;
+}
+
+//! Convert Cartesian state and time to Sundman-transformed state.
+Vector7d convertCartesianToSundmanState( const Vector6d& cartesianState, const double time )
+{
+    Vector7d sundmanState_;
+    sundmanState_ << cartesianState, time;
+    return sundmanState_;
+}
+
+//! Convert Sundman-transformed state to Cartesian state.
+Vector6d convertSundmanToCartesianState( const Vector7d& sundmanState )
+{
+    return sundmanState.segment< 6 >( 0 );
+}
+
+//! Compute state derivative.
+Eigen::VectorXd KustaanheimoStiefelStateDerivative::computeStateDerivative(
+        const double fictitiousTime, const Eigen::VectorXd& kustaanheimoStiefelState ) const
+{
+    const Eigen::Vector4d kustaanheimoStiefelPosition_
+            = kustaanheimoStiefelState.segment< 4 >( kustaanheimoStiefelPositionIndex );
+    const Eigen::Vector4d kustaanheimoStiefelVelocity_
+            = kustaanheimoStiefelState.segment< 4 >( kustaanheimoStiefelVelocityIndex );
+    const double energy_ = kustaanheimoStiefelState( kustaanheimoStiefelEnergyIndex );
+    const double radius_ = kustaanheimoStiefelPosition_.squaredNorm( );
+
+    // Compute derivatives of the unperturbed harmonic oscillator.
+    Eigen::VectorXd stateDerivative_( 10 );
+    stateDerivative_.segment< 4 >( kustaanheimoStiefelPositionIndex )
+            = kustaanheimoStiefelVelocity_;
+    stateDerivative_.segment< 4 >( kustaanheimoStiefelVelocityIndex )
+            = -0.5 * energy_ * kustaanheimoStiefelPosition_;
+    stateDerivative_( kustaanheimoStiefelEnergyIndex ) = 0.0;
+    stateDerivative_( kustaanheimoStiefelTimeIndex ) = radius_;
+
+    // Add contributions of perturbing acceleration.
+    if ( !perturbingAccelerationFunction_.empty( ) )
+    {
+        const double time_ = kustaanheimoStiefelState( kustaanheimoStiefelTimeIndex );
+        Eigen::Vector4d perturbingAcceleration_;
+        perturbingAcceleration_ << perturbingAccelerationFunction_(
+                                       time_, convertKustaanheimoStiefelToCartesianState(
+                                           kustaanheimoStiefelState ) ), 0.0;
+        const Eigen::Vector4d transformedPerturbingAcceleration_
+                = computeKustaanheimoStiefelMatrix( kustaanheimoStiefelPosition_ ).transpose( )
+                * perturbingAcceleration_;
+
+        stateDerivative_.segment< 4 >( kustaanheimoStiefelVelocityIndex )
+                += 0.5 * radius_ * transformedPerturbingAcceleration_;
+        stateDerivative_( kustaanheimoStiefelEnergyIndex )
+                = -2.0 * kustaanheimoStiefelVelocity_.dot( transformedPerturbingAcceleration_ );
+    }
+
+    return stateDerivative_;
+}
+
+//! Compute state derivative.
+Eigen::VectorXd SundmanStateDerivative::computeStateDerivative(
+        const double fictitiousTime, const Eigen::VectorXd& sundmanState ) const
+{
+    const Eigen::Vector3d position_ = sundmanState.segment< 3 >( 0 );
+    const double radius_ = position_.norm( );
+
+    // Compute derivative of physical time with respect to fictitious time.
+    const double timeDerivative_ = sundmanScaleFactor_ * std::pow( radius_, sundmanExponent_ );
+
+    Eigen::Vector3d acceleration_ = -centralBodyGravitationalParameter_
+            / ( radius_ * radius_ * radius_ ) * position_;
+    if ( !perturbingAccelerationFunction_.empty( ) )
+    {
+        acceleration_ += perturbingAccelerationFunction_(
+                    sundmanState( sundmanTimeIndex ), Vector6d( sundmanState.segment< 6 >( 0 ) ) );
+    }
+
+    Eigen::VectorXd stateDerivative_( 7 );
+    stateDerivative_.segment< 3 >( 0 ) = timeDerivative_ * sundmanState.segment< 3 >( 3 );
+    stateDerivative_.segment< 3 >( 3 ) = timeDerivative_ * acceleration_;
+    stateDerivative_( sundmanTimeIndex ) = timeDerivative_;
+    return stateDerivative_;
+}
+
+//! Integrate regularized state to given physical times.
+void integrateToPhysicalTimes( numerical_integrators::NumericalIntegrator< >& integrator,
+                               const int timeIndex, const Eigen::VectorXd& outputTimes,
+                               const double fictitiousTimeStepSize,
+                               Eigen::MatrixXd& statesAtOutputTimes,
+                               const double timeTolerance, const int maximumNumberOfIterations )
+{
+    statesAtOutputTimes.resize( integrator.getCurrentState( ).rows( ), outputTimes.rows( ) );
+
+    for ( int outputIndex = 0; outputIndex < outputTimes.rows( ); outputIndex++ )
+    {
+        const double outputTime_ = outputTimes( outputIndex );
+
+        // Check if output time is valid and throw an error if not.
+        if ( ( outputIndex > 0 && outputTime_ < outputTimes( outputIndex - 1 ) )
+             || outputTime_ < integrator.getCurrentState( )( timeIndex ) - timeTolerance )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Output times must be increasing and not lie "
+                                                "before the current time." ) ) );
+        }
+
+        // Take steps in fictitious time until the output time is reached.
+        double currentTime_ = integrator.getCurrentState( )( timeIndex );
+        while ( currentTime_ < outputTime_ - timeTolerance )
+        {
+            const double previousFictitiousTime_ = integrator.getCurrentIndependentVariable( );
+            const double previousTime_ = currentTime_;
+            currentTime_ = integrator.performIntegrationStep( fictitiousTimeStepSize )(
+                        timeIndex );
+
+            if ( !( currentTime_ > previousTime_ ) )
+            {
+                boost::throw_exception(
+                            boost::enable_error_info(
+                                std::runtime_error( "Physical time does not increase with "
+                                                    "fictitious time." ) ) );
+            }
+
+            if ( currentTime_ <= outputTime_ + timeTolerance )
+            {
+                continue;
+            }
+
+            // Find step size in fictitious time at which the output time is reached, using the
+            // Illinois method with the step bracketed between zero and the step just taken.
+            double lowerStepSize_ = 0.0;
+            double lowerTimeError_ = previousTime_ - outputTime_;
+            double upperStepSize_ = integrator.getCurrentIndependentVariable( )
+                    - previousFictitiousTime_;
+            double upperTimeError_ = currentTime_ - outputTime_;
+            int retainedSide_ = 0;
+            int iteration_ = 0;
+            while ( std::fabs( currentTime_ - outputTime_ ) > timeTolerance )
+            {
+                if ( iteration_++ == maximumNumberOfIterations
+                     || !integrator.rollbackToPreviousState( ) )
+                {
+                    boost::throw_exception(
+                                boost::enable_error_info(
+                                    std::runtime_error( "Output time could not be reached in "
+                                                        "fictitious time." ) ) );
+                }
+
+                const double trialStepSize_ = lowerStepSize_ - lowerTimeError_
+                        * ( upperStepSize_ - lowerStepSize_ )
+                        / ( upperTimeError_ - lowerTimeError_ );
+                currentTime_ = integrator.performIntegrationStep( trialStepSize_ )( timeIndex );
+                const double trialTimeError_ = currentTime_ - outputTime_;
+
+                // Replace the bound on the side of the trial, and halve the error at the other
+                // bound if it has been retained twice in a row.
+                if ( trialTimeError_ < 0.0 )
+                {
+                    lowerStepSize_ = trialStepSize_;
+                    lowerTimeError_ = trialTimeError_;
+                    if ( retainedSide_ == 1 )
+                    {
+                        upperTimeError_ *= 0.5;
+                    }
+                    retainedSide_ = 1;
+                }
+                else
+                {
+                    upperStepSize_ = trialStepSize_;
+                    upperTimeError_ = trialTimeError_;
+                    if ( retainedSide_ == -1 )
+                    {
+                        lowerTimeError_ *= 0.5;
+                    }
+                    retainedSide_ = -1;
+                }
+            }
+        }
+
+        statesAtOutputTimes.col( outputIndex ) = integrator.getCurrentState( );
+    }
+}
+
+} // namespace propagators
+} // namespace tudat
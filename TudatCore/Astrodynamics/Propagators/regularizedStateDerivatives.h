@@ -0,0 +1,306 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Stiefel, E.L., Scheifele, G. Linear and Regular Celestial Mechanics, Springer-Verlag,
+ *          Berlin, 1971.
+ *      Sundman, K.F. Memoire sur le probleme des trois corps, Acta Mathematica, 36, 105-179, 1913.
+ *      Bond, V.R., Allman, M.C. Modern Astrodynamics, Princeton University Press, Princeton, NJ,
+ *          1996.
+ *
+ *    Notes
+ *      In the regularized formulations, the physical time is replaced as independent variable by
+ *      a fictitious time s, with dt = c r^n ds. The physical time becomes an element of the state,
+ *      such that the numerical integrators can be used without modification, with s as the
+ *      independent variable. Since dt/ds is small near periapsis, the steps in physical time are
+ *      automatically reduced where the dynamics are fast, and a fixed step size in s gives
+ *      accurate results for highly eccentric orbits.
+ *
+ *      The Kustaanheimo-Stiefel (KS) transformation additionally maps the three-dimensional
+ *      position to a four-dimensional vector u, in which the unperturbed Kepler problem becomes a
+ *      harmonic oscillator with a frequency that depends on the orbital energy only (Stiefel and
+ *      Scheifele, 1971). The fictitious time of the KS formulation is defined by dt = r ds.
+ *
+ */
+
+#ifndef TUDAT_CORE_REGULARIZED_STATE_DERIVATIVES_H
+#define TUDAT_CORE_REGULARIZED_STATE_DERIVATIVES_H
+
+#include <boost/function.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/Mathematics/NumericalIntegrators/numericalIntegrator.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Typedef for Kustaanheimo-Stiefel state vector.
+typedef Eigen::Matrix< double, 10, 1 > Vector10d;
+
+//! Typedef for Sundman-transformed state vector.
+typedef Eigen::Matrix< double, 7, 1 > Vector7d;
+
+//! Kustaanheimo-Stiefel state vector indices.
+/*!
+ * Indices of the Kustaanheimo-Stiefel state vector. The state consists of the KS position u (four
+ * elements), its derivative u' with respect to fictitious time (four elements), the Kepler energy
+ * h = mu / r - v^2 / 2 and the physical time.
+ */
+enum KustaanheimoStiefelStateVectorIndices
+{
+    kustaanheimoStiefelPositionIndex = 0,
+    kustaanheimoStiefelVelocityIndex = 4,
+    kustaanheimoStiefelEnergyIndex = 8,
+    kustaanheimoStiefelTimeIndex = 9
+};
+
+//! Sundman-transformed state vector indices.
+/*!
+ * Indices of the Sundman-transformed state vector, which consists of the Cartesian state, ordered
+ * as given by the CartesianElementVectorIndices enum, and the physical time.
+ */
+enum SundmanStateVectorIndices
+{
+    sundmanTimeIndex = 6
+};
+
+//! Convert Cartesian state and time to Kustaanheimo-Stiefel state.
+/*!
+ * Converts a Cartesian state and physical time to a Kustaanheimo-Stiefel state. Of the family of
+ * KS positions corresponding to the Cartesian position, the one with either the fourth or the
+ * third element equal to zero is selected, depending on the sign of the x-component of the
+ * position, to avoid loss of precision (Stiefel and Scheifele, 1971). The KS velocity satisfies
+ * the bilinear relation.
+ * \param cartesianState Cartesian state, ordered as given by the CartesianElementVectorIndices
+ *          enum.
+ * \param time Physical time.                                                                  [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return Kustaanheimo-Stiefel state, ordered as given by the
+ *          KustaanheimoStiefelStateVectorIndices enum.
+ */
+Vector10d convertCartesianToKustaanheimoStiefelState(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d& cartesianState,
+        const double time, const double centralBodyGravitationalParameter );
+
+//! Convert Kustaanheimo-Stiefel state to Cartesian state.
+/*!
+ * Converts a Kustaanheimo-Stiefel state to a Cartesian state. The physical time is given by the
+ * element at kustaanheimoStiefelTimeIndex of the KS state.
+ * \param kustaanheimoStiefelState Kustaanheimo-Stiefel state, ordered as given by the
+ *          KustaanheimoStiefelStateVectorIndices enum.
+ * \return Cartesian state, ordered as given by the CartesianElementVectorIndices enum.
+ */
+basic_astrodynamics::orbital_element_conversions::Vector6d
+convertKustaanheimoStiefelToCartesianState( const Vector10d& kustaanheimoStiefelState );
+
+//! Convert Cartesian state and time to Sundman-transformed state.
+/*!
+ * Converts a Cartesian state and physical time to a Sundman-transformed state.
+ * \param cartesianState Cartesian state, ordered as given by the CartesianElementVectorIndices
+ *          enum.
+ * \param time Physical time.                                                                  [s]
+ * \return Sundman-transformed state, ordered as given by the SundmanStateVectorIndices enum.
+ */
+Vector7d convertCartesianToSundmanState(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d& cartesianState,
+        const double time );
+
+//! Convert Sundman-transformed state to Cartesian state.
+/*!
+ * Converts a Sundman-transformed state to a Cartesian state. The physical time is given by the
+ * element at sundmanTimeIndex of the Sundman-transformed state.
+ * \param sundmanState Sundman-transformed state, ordered as given by the
+ *          SundmanStateVectorIndices enum.
+ * \return Cartesian state, ordered as given by the CartesianElementVectorIndices enum.
+ */
+basic_astrodynamics::orbital_element_conversions::Vector6d convertSundmanToCartesianState(
+        const Vector7d& sundmanState );
+
+//! State derivative for propagation of Kustaanheimo-Stiefel state.
+/*!
+ * State derivative for numerical propagation of the Kustaanheimo-Stiefel state with respect to
+ * fictitious time, for a central body with point-mass gravity and an optional perturbing
+ * acceleration (Stiefel and Scheifele, 1971):
+ * \f[
+ *      u'' = -\frac{h}{2} u + \frac{r}{2} L^T( u ) P, \qquad h' = -2 u' \cdot L^T( u ) P,
+ *      \qquad t' = r
+ * \f]
+ * where L( u ) is the KS matrix and P the perturbing acceleration. The
+ * computeStateDerivative() function can be bound to the state derivative function of the
+ * numerical integrators, e.g.:
+ * \code
+ * RungeKutta4IntegratorXd integrator(
+ *     boost::bind( &KustaanheimoStiefelStateDerivative::computeStateDerivative,
+ *                  &stateDerivative, _1, _2 ), 0.0, initialKustaanheimoStiefelState );
+ * \endcode
+ */
+class KustaanheimoStiefelStateDerivative
+{
+public:
+
+    //! Typedef for perturbing acceleration function.
+    /*!
+     * Typedef for function returning the perturbing acceleration in the inertial frame, given the
+     * physical time and the Cartesian state.
+     */
+    typedef boost::function< Eigen::Vector3d(
+            const double, const basic_astrodynamics::orbital_element_conversions::Vector6d& ) >
+    PerturbingAccelerationFunction;
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param perturbingAccelerationFunction Function returning the perturbing acceleration in the
+     *          inertial frame. If empty, the orbit is unperturbed.
+     */
+    KustaanheimoStiefelStateDerivative(
+            const PerturbingAccelerationFunction& perturbingAccelerationFunction
+            = PerturbingAccelerationFunction( ) )
+        : perturbingAccelerationFunction_( perturbingAccelerationFunction )
+    { }
+
+    //! Compute state derivative.
+    /*!
+     * Computes the derivatives of the Kustaanheimo-Stiefel state with respect to fictitious time.
+     * The central body gravitational parameter is not required, since it is contained in the
+     * energy element of the state.
+     * \param fictitiousTime Current fictitious time (unused).
+     * \param kustaanheimoStiefelState Current Kustaanheimo-Stiefel state.
+     * \return Derivatives of Kustaanheimo-Stiefel state with respect to fictitious time.
+     */
+    Eigen::VectorXd computeStateDerivative(
+            const double fictitiousTime, const Eigen::VectorXd& kustaanheimoStiefelState ) const;
+
+private:
+
+    //! Function returning the perturbing acceleration in the inertial frame.
+    const PerturbingAccelerationFunction perturbingAccelerationFunction_;
+};
+
+//! State derivative for propagation of Sundman-transformed Cartesian state.
+/*!
+ * State derivative for numerical propagation of the Cartesian state and physical time with
+ * respect to a fictitious time s, defined by the generalized Sundman transformation
+ * dt = c r^n ds, for a central body with point-mass gravity and an optional perturbing
+ * acceleration. For n = 1 and c = sqrt( a / mu ), s is the eccentric anomaly for an
+ * unperturbed elliptical orbit; for n = 2 and c = 1 / sqrt( mu p ), s is the true anomaly. The
+ * computeStateDerivative() function can be bound to the state derivative function of the
+ * numerical integrators, in the same way as for the KustaanheimoStiefelStateDerivative.
+ */
+class SundmanStateDerivative
+{
+public:
+
+    //! Typedef for perturbing acceleration function.
+    /*!
+     * Typedef for function returning the perturbing acceleration in the inertial frame, given the
+     * physical time and the Cartesian state.
+     */
+    typedef boost::function< Eigen::Vector3d(
+            const double, const basic_astrodynamics::orbital_element_conversions::Vector6d& ) >
+    PerturbingAccelerationFunction;
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.  [m^3/s^2]
+     * \param sundmanExponent Exponent n of the radius in the Sundman transformation.          [-]
+     * \param sundmanScaleFactor Scale factor c of the Sundman transformation.            [s/m^n]
+     * \param perturbingAccelerationFunction Function returning the perturbing acceleration in the
+     *          inertial frame. If empty, the orbit is unperturbed.
+     */
+    SundmanStateDerivative( const double centralBodyGravitationalParameter,
+                            const double sundmanExponent, const double sundmanScaleFactor,
+                            const PerturbingAccelerationFunction& perturbingAccelerationFunction
+                            = PerturbingAccelerationFunction( ) )
+        : centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+          sundmanExponent_( sundmanExponent ),
+          sundmanScaleFactor_( sundmanScaleFactor ),
+          perturbingAccelerationFunction_( perturbingAccelerationFunction )
+    { }
+
+    //! Compute state derivative.
+    /*!
+     * Computes the derivatives of the Sundman-transformed state with respect to fictitious time.
+     * \param fictitiousTime Current fictitious time (unused).
+     * \param sundmanState Current Sundman-transformed state.
+     * \return Derivatives of Sundman-transformed state with respect to fictitious time.
+     */
+    Eigen::VectorXd computeStateDerivative( const double fictitiousTime,
+                                            const Eigen::VectorXd& sundmanState ) const;
+
+private:
+
+    //! Gravitational parameter of central body.
+    const double centralBodyGravitationalParameter_;
+
+    //! Exponent of the radius in the Sundman transformation.
+    const double sundmanExponent_;
+
+    //! Scale factor of the Sundman transformation.
+    const double sundmanScaleFactor_;
+
+    //! Function returning the perturbing acceleration in the inertial frame.
+    const PerturbingAccelerationFunction perturbingAccelerationFunction_;
+};
+
+//! Integrate regularized state to given physical times.
+/*!
+ * Integrates a regularized state, with fictitious time as independent variable and physical time
+ * as one of the state elements, such that the states at a set of physical times are obtained.
+ * The integrator takes steps of a fixed size in fictitious time, until the physical time exceeds
+ * the next output time. The last step is then rolled back and repeated with a step size found by
+ * the Illinois variant of the regula falsi method, until the physical time of the state matches
+ * the output time to within the given tolerance. The integration is continued from that state,
+ * such that the integrator is left at the last output time. An error is thrown if the output
+ * times are not increasing, if the first output time lies before the current physical time, if
+ * the physical time does not increase during a step, or if the root finding does not converge.
+ * \param integrator Numerical integrator of the regularized state, which is modified.
+ * \param timeIndex Index of the physical time in the regularized state, e.g.,
+ *          kustaanheimoStiefelTimeIndex or sundmanTimeIndex.
+ * \param outputTimes Increasing vector of physical times (N entries).                          [s]
+ * \param fictitiousTimeStepSize Step size in fictitious time.
+ * \param statesAtOutputTimes Matrix in which the regularized states at the output times are
+ *          stored, with one state per column. It is resized if required.
+ * \param timeTolerance Tolerance of the physical time of the output states.                    [s]
+ * \param maximumNumberOfIterations Maximum number of root finding iterations per output time.
+ */
+void integrateToPhysicalTimes( numerical_integrators::NumericalIntegrator< >& integrator,
+                               const int timeIndex, const Eigen::VectorXd& outputTimes,
+                               const double fictitiousTimeStepSize,
+                               Eigen::MatrixXd& statesAtOutputTimes,
+                               const double timeTolerance = 1.0e-9,
+                               const int maximumNumberOfIterations = 50 );
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_REGULARIZED_STATE_DERIVATIVES_H
@@ -0,0 +1,378 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Clohessy, W.H., Wiltshire, R.S. Terminal guidance system for satellite rendezvous, Journal
+ *          of the Aerospace Sciences, 27(9), 653-658, 1960.
+ *      Yamanaka, K., Ankersen, F. New state transition matrix for relative motion on an arbitrary
+ *          elliptical orbit, Journal of Guidance, Control, and Dynamics, 25(1), 60-66, 2002.
+ *
+ *    Notes
+ *      The Yamanaka-Ankersen matrix is formulated in the local-vertical-local-horizontal frame of
+ *      the original paper, with the first axis along-track, the second axis opposite to the
+ *      orbital angular momentum and the third axis towards the central body, and in the
+ *      transformed variables of the Tschauner-Hempel equations, with true anomaly as independent
+ *      variable. It is mapped to and from the RSW frame and the physical relative state here.
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/astrodynamicsFunctions.h"
+#include "TudatCore/Astrodynamics/Propagators/relativeMotionPropagator.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using namespace basic_astrodynamics::orbital_element_conversions;
+
+namespace
+{
+
+//! Compute matrix that maps relative state in RSW frame to transformed Yamanaka-Ankersen state.
+/*!
+ * Computes the matrix that maps the relative state in the RSW frame to the transformed state of
+ * the Tschauner-Hempel equations in the frame of Yamanaka and Ankersen (2002), ordered as
+ * position components followed by their derivatives with respect to true anomaly. For each
+ * component q, the transformed variables are given by q~ = rho q and
+ * q~' = -e sin( theta ) q + q_dot / ( k^2 rho ), with rho = 1 + e cos( theta ).
+ * \param eccentricity Eccentricity of the chief orbit.                                        [-]
+ * \param trueAnomaly True anomaly of the chief.                                              [rad]
+ * \param angularRateParameter Parameter k^2 = sqrt( mu / p^3 ) of the chief orbit.         [rad/s]
+ * \return Matrix that maps relative state in RSW frame to transformed state.
+ */
+Matrix6d computeTransformationToYamanakaAnkersenState( const double eccentricity,
+                                                       const double trueAnomaly,
+                                                       const double angularRateParameter )
+{
+    const double rho_ = 1.0 + eccentricity * std::cos( trueAnomaly );
+
+    // Map components as along-track = S, y = -W, z = -R.
+    Eigen::Matrix3d frameRotation_ = Eigen::Matrix3d::Zero( );
+    frameRotation_( 0, 1 ) = 1.0;
+    frameRotation_( 1, 2 ) = -1.0;
+    frameRotation_( 2, 0 ) = -1.0;
+
+    Matrix6d transformation_ = Matrix6d::Zero( );
+    transformation_.topLeftCorner( 3, 3 ) = rho_ * frameRotation_;
+    transformation_.bottomLeftCorner( 3, 3 )
+            = -eccentricity * std::sin( trueAnomaly ) * frameRotation_;
+    transformation_.bottomRightCorner( 3, 3 )
+            = frameRotation_ / ( angularRateParameter * rho_ );
+    return transformation_;
+}
+
+//! Compute matrix that maps transformed Yamanaka-Ankersen state to relative state in RSW frame.
+/*!
+ * Computes the inverse of the matrix computed by computeTransformationToYamanakaAnkersenState(),
+ * using q = q~ / rho and q_dot = k^2 ( rho q~' + e sin( theta ) q~ ).
+ * \param eccentricity Eccentricity of the chief orbit.                                        [-]
+ * \param trueAnomaly True anomaly of the chief.                                              [rad]
+ * \param angularRateParameter Parameter k^2 = sqrt( mu / p^3 ) of the chief orbit.         [rad/s]
+ * \return Matrix that maps transformed state to relative state in RSW frame.
+ */
+Matrix6d computeTransformationFromYamanakaAnkersenState( const double eccentricity,
+                                                         const double trueAnomaly,
+                                                         const double angularRateParameter )
+{
+    const double rho_ = 1.0 + eccentricity * std::cos( trueAnomaly );
+
+    // Map components as R = -z, S = along-track, W = -y.
+    Eigen::Matrix3d frameRotation_ = Eigen::Matrix3d::Zero( );
+    frameRotation_( 0, 2 ) = -1.0;
+    frameRotation_( 1, 0 ) = 1.0;
+    frameRotation_( 2, 1 ) = -1.0;
+
+    Matrix6d transformation_ = Matrix6d::Zero( );
+    transformation_.topLeftCorner( 3, 3 ) = frameRotation_ / rho_;
+    transformation_.bottomLeftCorner( 3, 3 )
+            = angularRateParameter * eccentricity * std::sin( trueAnomaly ) * frameRotation_;
+    transformation_.bottomRightCorner( 3, 3 ) = angularRateParameter * rho_ * frameRotation_;
+    return transformation_;
+}
+
+//! Compute true anomaly after propagation time.
+/*!
+ * Computes the true anomaly of an elliptical orbit after a given propagation time, by conversion
+ * to mean anomaly, addition of the mean anomaly change and conversion back to true anomaly.
+ * \param eccentricity Eccentricity.                                                            [-]
+ * \param initialTrueAnomaly Initial true anomaly.                                            [rad]
+ * \param meanMotion Mean motion.                                                           [rad/s]
+ * \param propagationTime Propagation time.                                                     [s]
+ * \return True anomaly after propagation time.                                               [rad]
+ */
+double computeTrueAnomalyAfterPropagationTime( const double eccentricity,
+                                               const double initialTrueAnomaly,
+                                               const double meanMotion,
+                                               const double propagationTime )
+{
+    const double initialMeanAnomaly_ = convertEllipticalEccentricAnomalyToMeanAnomaly(
+                convertTrueAnomalyToEllipticalEccentricAnomaly( initialTrueAnomaly,
+                                                                eccentricity ), eccentricity );
+
+    return convertEllipticalEccentricAnomalyToTrueAnomaly(
+                convertMeanAnomalyToEllipticalEccentricAnomaly(
+                    initialMeanAnomaly_ + meanMotion * propagationTime, eccentricity ),
+                eccentricity );
+}
+
+//! Check relative states and resize output.
+/*!
+ * Checks that the relative states have six rows, throwing an error otherwise, and resizes the
+ * output vector and its matrices, if required.
+ * \param initialRelativeStates Matrix of initial relative states (6 x N).
+ * \param numberOfEpochs Number of propagation times.
+ * \param finalRelativeStates Vector of propagated relative states, which is resized.
+ */
+void prepareRelativeStatePropagation( const Eigen::MatrixXd& initialRelativeStates,
+                                      const int numberOfEpochs,
+                                      std::vector< Eigen::MatrixXd >& finalRelativeStates )
+{
+    if ( initialRelativeStates.rows( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Relative states must have six rows." ) ) );
+    }
+
+    finalRelativeStates.resize( numberOfEpochs );
+    for ( int i = 0; i < numberOfEpochs; i++ )
+    {
+        finalRelativeStates[ i ].resize( 6, initialRelativeStates.cols( ) );
+    }
+}
+
+} // namespace
+
+//! Compute Clohessy-Wiltshire state transition matrix.
+Matrix6d computeClohessyWiltshireStateTransitionMatrix( const double chiefMeanMotion,
+                                                        const double propagationTime )
+{
+    const double meanMotionTimesTime_ = chiefMeanMotion * propagationTime;
+    const double cosine_ = std::cos( meanMotionTimesTime_ );
+    const double sine_ = std::sin( meanMotionTimesTime_ );
+
+    Matrix6d stateTransitionMatrix_ = Matrix6d::Zero( );
+
+    // Radial component.
+    stateTransitionMatrix_( 0, 0 ) = 4.0 - 3.0 * cosine_;
+    stateTransitionMatrix_( 0, 3 ) = sine_ / chiefMeanMotion;
+    stateTransitionMatrix_( 0, 4 ) = 2.0 * ( 1.0 - cosine_ ) / chiefMeanMotion;
+
+    // Along-track component.
+    stateTransitionMatrix_( 1, 0 ) = 6.0 * ( sine_ - meanMotionTimesTime_ );
+    stateTransitionMatrix_( 1, 1 ) = 1.0;
+    stateTransitionMatrix_( 1, 3 ) = -2.0 * ( 1.0 - cosine_ ) / chiefMeanMotion;
+    stateTransitionMatrix_( 1, 4 ) = ( 4.0 * sine_ - 3.0 * meanMotionTimesTime_ )
+            / chiefMeanMotion;
+
+    // Cross-track component.
+    stateTransitionMatrix_( 2, 2 ) = cosine_;
+    stateTransitionMatrix_( 2, 5 ) = sine_ / chiefMeanMotion;
+
+    // Radial velocity component.
+    stateTransitionMatrix_( 3, 0 ) = 3.0 * chiefMeanMotion * sine_;
+    stateTransitionMatrix_( 3, 3 ) = cosine_;
+    stateTransitionMatrix_( 3, 4 ) = 2.0 * sine_;
+
+    // Along-track velocity component.
+    stateTransitionMatrix_( 4, 0 ) = -6.0 * chiefMeanMotion * ( 1.0 - cosine_ );
+    stateTransitionMatrix_( 4, 3 ) = -2.0 * sine_;
+    stateTransitionMatrix_( 4, 4 ) = 4.0 * cosine_ - 3.0;
+
+    // Cross-track velocity component.
+    stateTransitionMatrix_( 5, 2 ) = -chiefMeanMotion * sine_;
+    stateTransitionMatrix_( 5, 5 ) = cosine_;
+
+    return stateTransitionMatrix_;
+}
+
+//! Compute Yamanaka-Ankersen state transition matrix.
+Matrix6d computeYamanakaAnkersenStateTransitionMatrix(
+        const Vector6d& chiefKeplerianElements, const double propagationTime,
+        const double centralBodyGravitationalParameter )
+{
+    const double semiMajorAxis_ = chiefKeplerianElements( semiMajorAxisIndex );
+    const double eccentricity_ = chiefKeplerianElements( eccentricityIndex );
+
+    if ( !( semiMajorAxis_ > 0.0 ) || !( eccentricity_ >= 0.0 ) || !( eccentricity_ < 1.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Chief orbit must be elliptical." ) ) );
+    }
+
+    const double initialTrueAnomaly_ = chiefKeplerianElements( trueAnomalyIndex );
+    const double finalTrueAnomaly_ = computeTrueAnomalyAfterPropagationTime(
+                eccentricity_, initialTrueAnomaly_,
+                basic_astrodynamics::computeKeplerMeanMotion(
+                    semiMajorAxis_, centralBodyGravitationalParameter ), propagationTime );
+
+    const double semiLatusRectum_ = semiMajorAxis_ * ( 1.0 - eccentricity_ * eccentricity_ );
+    const double angularRateParameter_ = std::sqrt( centralBodyGravitationalParameter
+                                                    / ( semiLatusRectum_ * semiLatusRectum_
+                                                        * semiLatusRectum_ ) );
+    const double eccentricitySquared_ = eccentricity_ * eccentricity_;
+
+    // Inverse of fundamental matrix of in-plane motion at initial true anomaly, for the
+    // transformed state ordered as along-track, radial (z) and their derivatives.
+    const double initialSine_ = std::sin( initialTrueAnomaly_ );
+    const double initialCosine_ = std::cos( initialTrueAnomaly_ );
+    const double initialRho_ = 1.0 + eccentricity_ * initialCosine_;
+    const double initialS_ = initialRho_ * initialSine_;
+    const double initialC_ = initialRho_ * initialCosine_;
+
+    Eigen::Matrix4d inverseInitialFundamentalMatrix_;
+    inverseInitialFundamentalMatrix_
+            << 1.0 - eccentricitySquared_,
+               3.0 * eccentricity_ * initialS_ * ( 1.0 / initialRho_
+                                                   + 1.0 / ( initialRho_ * initialRho_ ) ),
+               -eccentricity_ * initialS_ * ( 1.0 + 1.0 / initialRho_ ),
+               -eccentricity_ * initialC_ + 2.0,
+               0.0,
+               -3.0 * initialS_ * ( 1.0 / initialRho_
+                                    + eccentricitySquared_ / ( initialRho_ * initialRho_ ) ),
+               initialS_ * ( 1.0 + 1.0 / initialRho_ ),
+               initialC_ - 2.0 * eccentricity_,
+               0.0,
+               -3.0 * ( initialC_ / initialRho_ + eccentricity_ ),
+               initialC_ * ( 1.0 + 1.0 / initialRho_ ) + eccentricity_,
+               -initialS_,
+               0.0,
+               3.0 * initialRho_ + eccentricitySquared_ - 1.0,
+               -initialRho_ * initialRho_,
+               eccentricity_ * initialS_;
+    inverseInitialFundamentalMatrix_ /= 1.0 - eccentricitySquared_;
+
+    // Fundamental matrix of in-plane motion at final true anomaly.
+    const double finalSine_ = std::sin( finalTrueAnomaly_ );
+    const double finalCosine_ = std::cos( finalTrueAnomaly_ );
+    const double finalRho_ = 1.0 + eccentricity_ * finalCosine_;
+    const double finalS_ = finalRho_ * finalSine_;
+    const double finalC_ = finalRho_ * finalCosine_;
+    const double finalSDerivative_ = finalCosine_ + eccentricity_
+            * ( finalCosine_ * finalCosine_ - finalSine_ * finalSine_ );
+    const double finalCDerivative_ = -( finalSine_ + 2.0 * eccentricity_ * finalSine_
+                                        * finalCosine_ );
+    const double timeIntegral_ = angularRateParameter_ * propagationTime;
+
+    Eigen::Matrix4d finalFundamentalMatrix_;
+    finalFundamentalMatrix_
+            << 1.0,
+               -finalC_ * ( 1.0 + 1.0 / finalRho_ ),
+               finalS_ * ( 1.0 + 1.0 / finalRho_ ),
+               3.0 * finalRho_ * finalRho_ * timeIntegral_,
+               0.0,
+               finalS_,
+               finalC_,
+               2.0 - 3.0 * eccentricity_ * finalS_ * timeIntegral_,
+               0.0,
+               2.0 * finalS_,
+               2.0 * finalC_ - eccentricity_,
+               3.0 * ( 1.0 - 2.0 * eccentricity_ * finalS_ * timeIntegral_ ),
+               0.0,
+               finalSDerivative_,
+               finalCDerivative_,
+               -3.0 * eccentricity_ * ( finalSDerivative_ * timeIntegral_
+                                        + finalS_ / ( finalRho_ * finalRho_ ) );
+
+    const Eigen::Matrix4d inPlaneStateTransitionMatrix_
+            = finalFundamentalMatrix_ * inverseInitialFundamentalMatrix_;
+
+    // Assemble state transition matrix of transformed state, ordered as along-track, y, z and
+    // their derivatives; the out-of-plane motion is a harmonic oscillation in true anomaly.
+    const int inPlaneIndices_[ 4 ] = { 0, 2, 3, 5 };
+    Matrix6d transformedStateTransitionMatrix_ = Matrix6d::Zero( );
+    for ( int i = 0; i < 4; i++ )
+    {
+        for ( int j = 0; j < 4; j++ )
+        {
+            transformedStateTransitionMatrix_( inPlaneIndices_[ i ], inPlaneIndices_[ j ] )
+                    = inPlaneStateTransitionMatrix_( i, j );
+        }
+    }
+
+    const double trueAnomalyChange_ = finalTrueAnomaly_ - initialTrueAnomaly_;
+    transformedStateTransitionMatrix_( 1, 1 ) = std::cos( trueAnomalyChange_ );
+    transformedStateTransitionMatrix_( 1, 4 ) = std::sin( trueAnomalyChange_ );
+    transformedStateTransitionMatrix_( 4, 1 ) = -std::sin( trueAnomalyChange_ );
+    transformedStateTransitionMatrix_( 4, 4 ) = std::cos( trueAnomalyChange_ );
+
+    return computeTransformationFromYamanakaAnkersenState(
+                eccentricity_, finalTrueAnomaly_, angularRateParameter_ )
+            * transformedStateTransitionMatrix_
+            * computeTransformationToYamanakaAnkersenState(
+                eccentricity_, initialTrueAnomaly_, angularRateParameter_ );
+}
+
+//! Propagate relative states with Clohessy-Wiltshire state transition matrix.
+void propagateClohessyWiltshireRelativeStates(
+        const Eigen::MatrixXd& initialRelativeStates, const double chiefSemiMajorAxis,
+        const double centralBodyGravitationalParameter, const Eigen::VectorXd& propagationTimes,
+        std::vector< Eigen::MatrixXd >& finalRelativeStates )
+{
+    prepareRelativeStatePropagation( initialRelativeStates, propagationTimes.size( ),
+                                     finalRelativeStates );
+
+    const double chiefMeanMotion_ = basic_astrodynamics::computeKeplerMeanMotion(
+                chiefSemiMajorAxis, centralBodyGravitationalParameter );
+
+    for ( int i = 0; i < propagationTimes.size( ); i++ )
+    {
+        finalRelativeStates[ i ].noalias( )
+                = computeClohessyWiltshireStateTransitionMatrix( chiefMeanMotion_,
+                                                                 propagationTimes( i ) )
+                * initialRelativeStates;
+    }
+}
+
+//! Propagate relative states with Yamanaka-Ankersen state transition matrix.
+void propagateYamanakaAnkersenRelativeStates( const Eigen::MatrixXd& initialRelativeStates,
+                                              const Vector6d& chiefKeplerianElements,
+                                              const double centralBodyGravitationalParameter,
+                                              const Eigen::VectorXd& propagationTimes,
+                                              std::vector< Eigen::MatrixXd >& finalRelativeStates )
+{
+    prepareRelativeStatePropagation( initialRelativeStates, propagationTimes.size( ),
+                                     finalRelativeStates );
+
+    for ( int i = 0; i < propagationTimes.size( ); i++ )
+    {
+        finalRelativeStates[ i ].noalias( )
+                = computeYamanakaAnkersenStateTransitionMatrix(
+                    chiefKeplerianElements, propagationTimes( i ),
+                    centralBodyGravitationalParameter ) * initialRelativeStates;
+    }
+}
+
+} // namespace propagators
+} // namespace tudat
@@ -0,0 +1,142 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Clohessy, W.H., Wiltshire, R.S. Terminal guidance system for satellite rendezvous, Journal
+ *          of the Aerospace Sciences, 27(9), 653-658, 1960.
+ *      Yamanaka, K., Ankersen, F. New state transition matrix for relative motion on an arbitrary
+ *          elliptical orbit, Journal of Guidance, Control, and Dynamics, 25(1), 60-66, 2002.
+ *
+ *    Notes
+ *      Relative states are expressed in the rotating RSW frame of the chief, with the first axis
+ *      along the radius vector of the chief, the third axis along its orbital angular momentum,
+ *      and the second axis completing the right-handed frame (along-track). Relative velocities
+ *      are taken with respect to this rotating frame. Both state transition matrices follow from
+ *      the linearized equations of relative motion, so that their accuracy degrades as the
+ *      separation grows with respect to the orbital radius of the chief. The chief orbit is
+ *      assumed to be unperturbed.
+ *
+ */
+
+#ifndef TUDAT_CORE_RELATIVE_MOTION_PROPAGATOR_H
+#define TUDAT_CORE_RELATIVE_MOTION_PROPAGATOR_H
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Compute Clohessy-Wiltshire state transition matrix.
+/*!
+ * Computes the state transition matrix of the Clohessy-Wiltshire (or Hill) equations, which
+ * describe the linearized motion of a deputy relative to a chief on a circular orbit (Clohessy
+ * and Wiltshire, 1960). The matrix maps the relative state in the rotating RSW frame of the chief
+ * at the initial epoch to the relative state after the given propagation time.
+ * \param chiefMeanMotion Mean motion of the chief orbit.                                   [rad/s]
+ * \param propagationTime Propagation time; may be negative.                                    [s]
+ * \return State transition matrix of relative state in RSW frame.
+ */
+basic_astrodynamics::orbital_element_conversions::Matrix6d
+computeClohessyWiltshireStateTransitionMatrix( const double chiefMeanMotion,
+                                               const double propagationTime );
+
+//! Compute Yamanaka-Ankersen state transition matrix.
+/*!
+ * Computes the state transition matrix of the Tschauner-Hempel equations, which describe the
+ * linearized motion of a deputy relative to a chief on an elliptical orbit, in the closed form
+ * derived by Yamanaka and Ankersen (2002). The matrix maps the relative state in the rotating
+ * RSW frame of the chief at the initial epoch to the relative state after the given propagation
+ * time. The true anomaly of the chief at the final epoch is obtained from the anomaly conversions.
+ * For a circular chief orbit, the matrix reduces to the Clohessy-Wiltshire matrix. An error is
+ * thrown if the chief orbit is not elliptical.
+ * \param chiefKeplerianElements Keplerian elements of the chief at the initial epoch, ordered as
+ *          given by the KeplerianElementVectorIndices enum. Only the semi-major axis, eccentricity
+ *          and true anomaly are used.
+ * \param propagationTime Propagation time; may be negative.                                    [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \return State transition matrix of relative state in RSW frame.
+ */
+basic_astrodynamics::orbital_element_conversions::Matrix6d
+computeYamanakaAnkersenStateTransitionMatrix(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d& chiefKeplerianElements,
+        const double propagationTime, const double centralBodyGravitationalParameter );
+
+//! Propagate relative states with Clohessy-Wiltshire state transition matrix.
+/*!
+ * Propagates a set of deputy states relative to a chief on a circular orbit to a number of
+ * epochs. For each epoch, a single state transition matrix is computed with
+ * computeClohessyWiltshireStateTransitionMatrix(), and applied to all deputies at once as a
+ * single matrix product. An error is thrown if the relative states do not have six rows.
+ * \param initialRelativeStates Matrix of initial relative states in the RSW frame of the chief,
+ *          with one deputy per column (6 x N).
+ * \param chiefSemiMajorAxis Semi-major axis (orbital radius) of the chief orbit.               [m]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param propagationTimes Vector of propagation times with respect to the initial epoch.      [s]
+ * \param finalRelativeStates Vector in which the propagated relative states are stored, with one
+ *          6 x N matrix per propagation time. If the vector and its matrices are preallocated with
+ *          the correct sizes, no memory is allocated for them; otherwise they are resized.
+ * \sa computeClohessyWiltshireStateTransitionMatrix().
+ */
+void propagateClohessyWiltshireRelativeStates(
+        const Eigen::MatrixXd& initialRelativeStates, const double chiefSemiMajorAxis,
+        const double centralBodyGravitationalParameter, const Eigen::VectorXd& propagationTimes,
+        std::vector< Eigen::MatrixXd >& finalRelativeStates );
+
+//! Propagate relative states with Yamanaka-Ankersen state transition matrix.
+/*!
+ * Propagates a set of deputy states relative to a chief on an elliptical orbit to a number of
+ * epochs. For each epoch, a single state transition matrix is computed with
+ * computeYamanakaAnkersenStateTransitionMatrix(), and applied to all deputies at once as a
+ * single matrix product. An error is thrown if the relative states do not have six rows, or if
+ * the chief orbit is not elliptical.
+ * \param initialRelativeStates Matrix of initial relative states in the RSW frame of the chief,
+ *          with one deputy per column (6 x N).
+ * \param chiefKeplerianElements Keplerian elements of the chief at the initial epoch, ordered as
+ *          given by the KeplerianElementVectorIndices enum.
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param propagationTimes Vector of propagation times with respect to the initial epoch.      [s]
+ * \param finalRelativeStates Vector in which the propagated relative states are stored, with one
+ *          6 x N matrix per propagation time. If the vector and its matrices are preallocated with
+ *          the correct sizes, no memory is allocated for them; otherwise they are resized.
+ * \sa computeYamanakaAnkersenStateTransitionMatrix().
+ */
+void propagateYamanakaAnkersenRelativeStates(
+        const Eigen::MatrixXd& initialRelativeStates,
+        const basic_astrodynamics::orbital_element_conversions::Vector6d& chiefKeplerianElements,
+        const double centralBodyGravitationalParameter, const Eigen::VectorXd& propagationTimes,
+        std::vector< Eigen::MatrixXd >& finalRelativeStates );
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_RELATIVE_MOTION_PROPAGATOR_H
@@ -0,0 +1,1196 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Hoots, F. R., Roehrich, R. L. Spacetrack Report No. 3: Models for Propagation of NORAD
+ *          Element Sets, Aerospace Defense Command, 1980.
+ *      Vallado, D. A., Crawford, P., Hujsak, R., Kelso, T. S. Revisiting Spacetrack Report #3,
+ *          AIAA/AAS Astrodynamics Specialist Conference, AIAA 2006-6753, 2006.
+ *
+ *    Notes
+ *      The theory is evaluated in the canonical units of (Vallado et al., 2006), i.e., Earth radii
+ *      and minutes, and the variable names of the coefficients follow that reference, such that
+ *      the implementation can be compared to it directly. The states are converted to SI units at
+ *      the end.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "TudatCore/Astrodynamics/Propagators/sgp4Orbit.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using namespace basic_astrodynamics::orbital_element_conversions;
+
+//! Coefficients of the deep-space perturbations of the SDP4 theory.
+/*!
+ * Orbit-constant coefficients of the lunar-solar perturbations and of the resonance effects of
+ * the SDP4 theory, with the names of (Vallado et al., 2006).
+ */
+struct DeepSpaceCoefficients
+{
+    //! Coefficients of the solar periodic terms.
+    double se2, se3, si2, si3, sl2, sl3, sl4, sgh2, sgh3, sgh4, sh2, sh3;
+
+    //! Coefficients of the lunar periodic terms.
+    double ee2, e3, xi2, xi3, xl2, xl3, xl4, xgh2, xgh3, xgh4, xh2, xh3;
+
+    //! Mean anomalies of the Sun and the Moon at epoch.                                      [rad]
+    double zmos, zmol;
+
+    //! Lunar-solar secular rates of the eccentricity, inclination, mean anomaly, node and
+    //! argument of perigee.                                                          [rad/min]
+    double dedt, didt, dmdt, dnodt, domdt;
+
+    //! Resonance type: 0 for none, 1 for synchronous and 2 for half-day orbits.
+    int irez;
+
+    //! Greenwich sidereal time at epoch.                                                     [rad]
+    double gsto;
+
+    //! Coefficients of the half-day resonance terms.
+    double d2201, d2211, d3210, d3222, d4410, d4422, d5220, d5232, d5421, d5433;
+
+    //! Coefficients of the synchronous resonance terms.
+    double del1, del2, del3;
+
+    //! Resonance longitude at epoch and its rate.                                  [rad, rad/min]
+    double xlamo, xfact;
+};
+
+namespace
+{
+
+//! Equatorial radius of the Earth in the WGS-72 model.                                        [km]
+const double EARTH_RADIUS = 6378.135;
+
+//! Gravitational parameter of the Earth in the WGS-72 model.                            [km^3/s^2]
+const double EARTH_GRAVITATIONAL_PARAMETER = 398600.8;
+
+//! Unnormalized J2 coefficient of the Earth in the WGS-72 model.                               [-]
+const double J2 = 0.001082616;
+
+//! Unnormalized J3 coefficient of the Earth in the WGS-72 model.                               [-]
+const double J3 = -0.00000253881;
+
+//! Unnormalized J4 coefficient of the Earth in the WGS-72 model.                               [-]
+const double J4 = -0.00000165597;
+
+//! Square root of the gravitational parameter, in Earth radii^1.5 per minute.
+const double XKE = 60.0 / std::sqrt( EARTH_RADIUS * EARTH_RADIUS * EARTH_RADIUS
+                                     / EARTH_GRAVITATIONAL_PARAMETER );
+
+//! Minimum orbital period for which the deep-space theory is used.                          [min]
+const double DEEP_SPACE_PERIOD_LIMIT = 225.0;
+
+//! Compute un-Kozai'd mean motion and semi-major axis.
+/*!
+ * Computes the un-Kozai'd (Brouwer) mean motion and the corresponding semi-major axis from the
+ * Kozai mean motion of a two-line element set (Vallado et al., 2006).
+ * \param elementSet Two-line element set.
+ * \param semiMajorAxis Semi-major axis.                                               [Earth radii]
+ * \return Un-Kozai'd mean motion.                                                        [rad/min]
+ */
+double computeUnKozaiMeanMotion( const input_output::TwoLineElementSet& elementSet,
+                                 double& semiMajorAxis )
+{
+    const double kozaiMeanMotion_ = elementSet.meanMotion * 60.0;
+    const double cosineOfInclination_ = std::cos( elementSet.inclination );
+    const double omeosq_ = 1.0 - elementSet.eccentricity * elementSet.eccentricity;
+
+    const double ak_ = std::pow( XKE / kozaiMeanMotion_, 2.0 / 3.0 );
+    const double d1_ = 0.75 * J2 * ( 3.0 * cosineOfInclination_ * cosineOfInclination_ - 1.0 )
+            / ( std::sqrt( omeosq_ ) * omeosq_ );
+    double delta_ = d1_ / ( ak_ * ak_ );
+    const double adel_ = ak_ * ( 1.0 - delta_ * delta_
+                                 - delta_ * ( 1.0 / 3.0 + 134.0 * delta_ * delta_ / 81.0 ) );
+    delta_ = d1_ / ( adel_ * adel_ );
+
+    const double meanMotion_ = kozaiMeanMotion_ / ( 1.0 + delta_ );
+    semiMajorAxis = std::pow( XKE / meanMotion_, 2.0 / 3.0 );
+    return meanMotion_;
+}
+
+//! Lunar-solar perturbation terms of a single perturbing body.
+/*!
+ * Intermediate terms of the lunar-solar perturbations of a single perturbing body, as computed by
+ * the dscom routine of (Vallado et al., 2006).
+ */
+struct LunarSolarTerms
+{
+    //! Terms s1 to s7.
+    double s1, s2, s3, s4, s5, s6, s7;
+
+    //! Terms z1 to z33.
+    double z1, z2, z3, z11, z12, z13, z21, z22, z23, z31, z32, z33;
+};
+
+//! Compute lunar-solar perturbation terms of a single perturbing body.
+/*!
+ * Computes the intermediate terms of the lunar-solar perturbations of a single perturbing body
+ * from the orientation of its orbit, as in the dscom routine of (Vallado et al., 2006).
+ * \param cc Perturbation constant of the body.
+ * \param zcosg Cosine of the argument of perigee of the body.
+ * \param zsing Sine of the argument of perigee of the body.
+ * \param zcosi Cosine of the inclination of the body.
+ * \param zsini Sine of the inclination of the body.
+ * \param zcosh Cosine of the node of the body relative to the node of the orbit.
+ * \param zsinh Sine of the node of the body relative to the node of the orbit.
+ * \param elementSet Two-line element set.
+ * \param meanMotion Un-Kozai'd mean motion.                                              [rad/min]
+ * \return Lunar-solar perturbation terms.
+ */
+LunarSolarTerms computeLunarSolarTerms( const double cc,
+                                        const double zcosg, const double zsing,
+                                        const double zcosi, const double zsini,
+                                        const double zcosh, const double zsinh,
+                                        const input_output::TwoLineElementSet& elementSet,
+                                        const double meanMotion )
+{
+    const double em_ = elementSet.eccentricity;
+    const double emsq_ = em_ * em_;
+    const double betasq_ = 1.0 - emsq_;
+    const double rtemsq_ = std::sqrt( betasq_ );
+    const double sinim_ = std::sin( elementSet.inclination );
+    const double cosim_ = std::cos( elementSet.inclination );
+    const double sinomm_ = std::sin( elementSet.argumentOfPerigee );
+    const double cosomm_ = std::cos( elementSet.argumentOfPerigee );
+
+    const double a1_ = zcosg * zcosh + zsing * zcosi * zsinh;
+    const double a3_ = -zsing * zcosh + zcosg * zcosi * zsinh;
+    const double a7_ = -zcosg * zsinh + zsing * zcosi * zcosh;
+    const double a8_ = zsing * zsini;
+    const double a9_ = zsing * zsinh + zcosg * zcosi * zcosh;
+    const double a10_ = zcosg * zsini;
+    const double a2_ = cosim_ * a7_ + sinim_ * a8_;
+    const double a4_ = cosim_ * a9_ + sinim_ * a10_;
+    const double a5_ = -sinim_ * a7_ + cosim_ * a8_;
+    const double a6_ = -sinim_ * a9_ + cosim_ * a10_;
+
+    const double x1_ = a1_ * cosomm_ + a2_ * sinomm_;
+    const double x2_ = a3_ * cosomm_ + a4_ * sinomm_;
+    const double x3_ = -a1_ * sinomm_ + a2_ * cosomm_;
+    const double x4_ = -a3_ * sinomm_ + a4_ * cosomm_;
+    const double x5_ = a5_ * sinomm_;
+    const double x6_ = a6_ * sinomm_;
+    const double x7_ = a5_ * cosomm_;
+    const double x8_ = a6_ * cosomm_;
+
+    LunarSolarTerms terms_;
+    terms_.z31 = 12.0 * x1_ * x1_ - 3.0 * x3_ * x3_;
+    terms_.z32 = 24.0 * x1_ * x2_ - 6.0 * x3_ * x4_;
+    terms_.z33 = 12.0 * x2_ * x2_ - 3.0 * x4_ * x4_;
+    terms_.z1 = 3.0 * ( a1_ * a1_ + a2_ * a2_ ) + terms_.z31 * emsq_;
+    terms_.z2 = 6.0 * ( a1_ * a3_ + a2_ * a4_ ) + terms_.z32 * emsq_;
+    terms_.z3 = 3.0 * ( a3_ * a3_ + a4_ * a4_ ) + terms_.z33 * emsq_;
+    terms_.z11 = -6.0 * a1_ * a5_ + emsq_ * ( -24.0 * x1_ * x7_ - 6.0 * x3_ * x5_ );
+    terms_.z12 = -6.0 * ( a1_ * a6_ + a3_ * a5_ )
+            + emsq_ * ( -24.0 * ( x2_ * x7_ + x1_ * x8_ ) - 6.0 * ( x3_ * x6_ + x4_ * x5_ ) );
+    terms_.z13 = -6.0 * a3_ * a6_ + emsq_ * ( -24.0 * x2_ * x8_ - 6.0 * x4_ * x6_ );
+    terms_.z21 = 6.0 * a2_ * a5_ + emsq_ * ( 24.0 * x1_ * x5_ - 6.0 * x3_ * x7_ );
+    terms_.z22 = 6.0 * ( a4_ * a5_ + a2_ * a6_ )
+            + emsq_ * ( 24.0 * ( x2_ * x5_ + x1_ * x6_ ) - 6.0 * ( x4_ * x7_ + x3_ * x8_ ) );
+    terms_.z23 = 6.0 * a4_ * a6_ + emsq_ * ( 24.0 * x2_ * x6_ - 6.0 * x4_ * x8_ );
+    terms_.z1 = terms_.z1 + terms_.z1 + betasq_ * terms_.z31;
+    terms_.z2 = terms_.z2 + terms_.z2 + betasq_ * terms_.z32;
+    terms_.z3 = terms_.z3 + terms_.z3 + betasq_ * terms_.z33;
+
+    terms_.s3 = cc / meanMotion;
+    terms_.s2 = -0.5 * terms_.s3 / rtemsq_;
+    terms_.s4 = terms_.s3 * rtemsq_;
+    terms_.s1 = -15.0 * em_ * terms_.s4;
+    terms_.s5 = x1_ * x3_ + x2_ * x4_;
+    terms_.s6 = x2_ * x3_ + x1_ * x4_;
+    terms_.s7 = x2_ * x4_ - x1_ * x3_;
+
+    return terms_;
+}
+
+//! Compute Greenwich sidereal time.
+/*!
+ * Computes the Greenwich mean sidereal time from the IAU-82 model, as in the gstime routine of
+ * (Vallado et al., 2006).
+ * \param epoch Epoch, in seconds since 1 January 2000, 12:00 UTC.                              [s]
+ * \return Greenwich mean sidereal time, in [0, 2 pi).                                        [rad]
+ */
+double computeGreenwichSiderealTime( const double epoch )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    const double tut1_ = epoch / 86400.0 / 36525.0;
+    double gst_ = -6.2e-6 * tut1_ * tut1_ * tut1_ + 0.093104 * tut1_ * tut1_
+            + ( 876600.0 * 3600.0 + 8640184.812866 ) * tut1_ + 67310.54841;
+    gst_ = std::fmod( gst_ * PI / 180.0 / 240.0, 2.0 * PI );
+    if ( gst_ < 0.0 )
+    {
+        gst_ += 2.0 * PI;
+    }
+    return gst_;
+}
+
+//! Compute coefficients of the deep-space perturbations.
+/*!
+ * Computes the orbit-constant coefficients of the lunar-solar perturbations and the resonance
+ * effects of the SDP4 theory, as in the dscom and dsinit routines of (Vallado et al., 2006).
+ * \param elementSet Two-line element set.
+ * \param meanMotion Un-Kozai'd mean motion.                                              [rad/min]
+ * \param meanAnomalyRate Secular rate of the mean anomaly due to J2 and J4.              [rad/min]
+ * \param argumentOfPerigeeRate Secular rate of the argument of perigee due to J2 and J4. [rad/min]
+ * \param nodeRate Secular rate of the right ascension of the ascending node due to J2 and J4.
+ *                                                                                     [rad/min]
+ * \return Coefficients of the deep-space perturbations.
+ */
+DeepSpaceCoefficients computeDeepSpaceCoefficients(
+        const input_output::TwoLineElementSet& elementSet, const double meanMotion,
+        const double meanAnomalyRate, const double argumentOfPerigeeRate, const double nodeRate )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    DeepSpaceCoefficients coefficients_;
+
+    const double em_ = elementSet.eccentricity;
+    const double emsq_ = em_ * em_;
+    const double inclm_ = elementSet.inclination;
+    const double sinim_ = std::sin( inclm_ );
+    const double cosim_ = std::cos( inclm_ );
+    const double snodm_ = std::sin( elementSet.rightAscensionOfAscendingNode );
+    const double cnodm_ = std::cos( elementSet.rightAscensionOfAscendingNode );
+
+    // Compute the orbit of the Moon at epoch, with the time in days since 31 December 1899,
+    // 12:00.
+    const double day_ = elementSet.epoch / 86400.0 + 18263.5 + 18261.5;
+    const double xnodce_ = std::fmod( 4.5236020 - 9.2422029e-4 * day_, 2.0 * PI );
+    const double stem_ = std::sin( xnodce_ );
+    const double ctem_ = std::cos( xnodce_ );
+    const double zcosil_ = 0.91375164 - 0.03568096 * ctem_;
+    const double zsinil_ = std::sqrt( 1.0 - zcosil_ * zcosil_ );
+    const double zsinhl_ = 0.089683511 * stem_ / zsinil_;
+    const double zcoshl_ = std::sqrt( 1.0 - zsinhl_ * zsinhl_ );
+    const double gam_ = 5.8351514 + 0.0019443680 * day_;
+    const double zx_ = gam_ + std::atan2( 0.39785416 * stem_ / zsinil_,
+                                          zcoshl_ * ctem_ + 0.91744867 * zsinhl_ * stem_ )
+            - xnodce_;
+
+    // Compute the lunar-solar perturbation terms of the Sun and the Moon.
+    const double zes_ = 0.01675;
+    const double zel_ = 0.05490;
+    const double zns_ = 1.19459e-5;
+    const double znl_ = 1.5835218e-4;
+    const LunarSolarTerms solarTerms_ = computeLunarSolarTerms(
+                2.9864797e-6, 0.1945905, -0.98088458, 0.91744867, 0.39785416, cnodm_, snodm_,
+                elementSet, meanMotion );
+    const LunarSolarTerms lunarTerms_ = computeLunarSolarTerms(
+                4.7968065e-7, std::cos( zx_ ), std::sin( zx_ ), zcosil_, zsinil_,
+                zcoshl_ * cnodm_ + zsinhl_ * snodm_, snodm_ * zcoshl_ - cnodm_ * zsinhl_,
+                elementSet, meanMotion );
+    const LunarSolarTerms& ss_ = solarTerms_;
+    const LunarSolarTerms& sl_ = lunarTerms_;
+
+    coefficients_.zmol = std::fmod( 4.7199672 + 0.22997150 * day_ - gam_, 2.0 * PI );
+    coefficients_.zmos = std::fmod( 6.2565837 + 0.017201977 * day_, 2.0 * PI );
+
+    // Compute the coefficients of the solar periodic terms.
+    coefficients_.se2 = 2.0 * ss_.s1 * ss_.s6;
+    coefficients_.se3 = 2.0 * ss_.s1 * ss_.s7;
+    coefficients_.si2 = 2.0 * ss_.s2 * ss_.z12;
+    coefficients_.si3 = 2.0 * ss_.s2 * ( ss_.z13 - ss_.z11 );
+    coefficients_.sl2 = -2.0 * ss_.s3 * ss_.z2;
+    coefficients_.sl3 = -2.0 * ss_.s3 * ( ss_.z3 - ss_.z1 );
+    coefficients_.sl4 = -2.0 * ss_.s3 * ( -21.0 - 9.0 * emsq_ ) * zes_;
+    coefficients_.sgh2 = 2.0 * ss_.s4 * ss_.z32;
+    coefficients_.sgh3 = 2.0 * ss_.s4 * ( ss_.z33 - ss_.z31 );
+    coefficients_.sgh4 = -18.0 * ss_.s4 * zes_;
+    coefficients_.sh2 = -2.0 * ss_.s2 * ss_.z22;
+    coefficients_.sh3 = -2.0 * ss_.s2 * ( ss_.z23 - ss_.z21 );
+
+    // Compute the coefficients of the lunar periodic terms.
+    coefficients_.ee2 = 2.0 * sl_.s1 * sl_.s6;
+    coefficients_.e3 = 2.0 * sl_.s1 * sl_.s7;
+    coefficients_.xi2 = 2.0 * sl_.s2 * sl_.z12;
+    coefficients_.xi3 = 2.0 * sl_.s2 * ( sl_.z13 - sl_.z11 );
+    coefficients_.xl2 = -2.0 * sl_.s3 * sl_.z2;
+    coefficients_.xl3 = -2.0 * sl_.s3 * ( sl_.z3 - sl_.z1 );
+    coefficients_.xl4 = -2.0 * sl_.s3 * ( -21.0 - 9.0 * emsq_ ) * zel_;
+    coefficients_.xgh2 = 2.0 * sl_.s4 * sl_.z32;
+    coefficients_.xgh3 = 2.0 * sl_.s4 * ( sl_.z33 - sl_.z31 );
+    coefficients_.xgh4 = -18.0 * sl_.s4 * zel_;
+    coefficients_.xh2 = -2.0 * sl_.s2 * sl_.z22;
+    coefficients_.xh3 = -2.0 * sl_.s2 * ( sl_.z23 - sl_.z21 );
+
+    // Compute the lunar-solar secular rates; the node rates are not used for (nearly) equatorial
+    // orbits.
+    const bool isEquatorial_ = ( inclm_ < 5.2359877e-2 || inclm_ > PI - 5.2359877e-2 );
+    double shs_ = isEquatorial_ ? 0.0 : -zns_ * ss_.s2 * ( ss_.z21 + ss_.z23 );
+    const double shll_ = isEquatorial_ ? 0.0 : -znl_ * sl_.s2 * ( sl_.z21 + sl_.z23 );
+    if ( sinim_ != 0.0 )
+    {
+        shs_ = shs_ / sinim_;
+    }
+    const double sghs_ = ss_.s4 * zns_ * ( ss_.z31 + ss_.z33 - 6.0 );
+    const double sghl_ = sl_.s4 * znl_ * ( sl_.z31 + sl_.z33 - 6.0 );
+
+    coefficients_.dedt = ss_.s1 * zns_ * ss_.s5 + sl_.s1 * znl_ * sl_.s5;
+    coefficients_.didt = ss_.s2 * zns_ * ( ss_.z11 + ss_.z13 )
+            + sl_.s2 * znl_ * ( sl_.z11 + sl_.z13 );
+    coefficients_.dmdt = -zns_ * ss_.s3 * ( ss_.z1 + ss_.z3 - 14.0 - 6.0 * emsq_ )
+            - znl_ * sl_.s3 * ( sl_.z1 + sl_.z3 - 14.0 - 6.0 * emsq_ );
+    coefficients_.domdt = sghs_ - cosim_ * shs_ + sghl_;
+    coefficients_.dnodt = shs_;
+    if ( sinim_ != 0.0 )
+    {
+        coefficients_.domdt = coefficients_.domdt - cosim_ / sinim_ * shll_;
+        coefficients_.dnodt = coefficients_.dnodt + shll_ / sinim_;
+    }
+
+    // Determine the resonance type from the mean motion and the eccentricity.
+    coefficients_.irez = 0;
+    if ( meanMotion < 0.0052359877 && meanMotion > 0.0034906585 )
+    {
+        coefficients_.irez = 1;
+    }
+    if ( meanMotion >= 8.26e-3 && meanMotion <= 9.24e-3 && em_ >= 0.5 )
+    {
+        coefficients_.irez = 2;
+    }
+
+    coefficients_.gsto = computeGreenwichSiderealTime( elementSet.epoch );
+    coefficients_.d2201 = coefficients_.d2211 = coefficients_.d3210 = coefficients_.d3222 = 0.0;
+    coefficients_.d4410 = coefficients_.d4422 = coefficients_.d5220 = coefficients_.d5232 = 0.0;
+    coefficients_.d5421 = coefficients_.d5433 = 0.0;
+    coefficients_.del1 = coefficients_.del2 = coefficients_.del3 = 0.0;
+    coefficients_.xlamo = coefficients_.xfact = 0.0;
+
+    const double rptim_ = 4.37526908801129966e-3;
+    const double aonv_ = std::pow( meanMotion / XKE, 2.0 / 3.0 );
+    const double theta_ = coefficients_.gsto;
+
+    // Compute the coefficients of the half-day resonance terms, with the polynomials in the
+    // eccentricity of (Vallado et al., 2006).
+    if ( coefficients_.irez == 2 )
+    {
+        const double cosisq_ = cosim_ * cosim_;
+        const double eoc_ = em_ * emsq_;
+        const double g201_ = -0.306 - ( em_ - 0.64 ) * 0.440;
+        double g211_, g310_, g322_, g410_, g422_, g520_, g533_, g521_, g532_;
+        if ( em_ <= 0.65 )
+        {
+            g211_ = 3.616 - 13.2470 * em_ + 16.2900 * emsq_;
+            g310_ = -19.302 + 117.3900 * em_ - 228.4190 * emsq_ + 156.5910 * eoc_;
+            g322_ = -18.9068 + 109.7927 * em_ - 214.6334 * emsq_ + 146.5816 * eoc_;
+            g410_ = -41.122 + 242.6940 * em_ - 471.0940 * emsq_ + 313.9530 * eoc_;
+            g422_ = -146.407 + 841.8800 * em_ - 1629.014 * emsq_ + 1083.4350 * eoc_;
+            g520_ = -532.114 + 3017.977 * em_ - 5740.032 * emsq_ + 3708.2760 * eoc_;
+        }
+        else
+        {
+            g211_ = -72.099 + 331.819 * em_ - 508.738 * emsq_ + 266.724 * eoc_;
+            g310_ = -346.844 + 1582.851 * em_ - 2415.925 * emsq_ + 1246.113 * eoc_;
+            g322_ = -342.585 + 1554.908 * em_ - 2366.899 * emsq_ + 1215.972 * eoc_;
+            g410_ = -1052.797 + 4758.686 * em_ - 7193.992 * emsq_ + 3651.957 * eoc_;
+            g422_ = -3581.690 + 16178.110 * em_ - 24462.770 * emsq_ + 12422.520 * eoc_;
+            g520_ = ( em_ > 0.715 )
+                    ? -5149.66 + 29936.92 * em_ - 54087.36 * emsq_ + 31324.56 * eoc_
+                    : 1464.74 - 4664.75 * em_ + 3763.64 * emsq_;
+        }
+        if ( em_ < 0.7 )
+        {
+            g533_ = -919.22770 + 4988.6100 * em_ - 9064.7700 * emsq_ + 5542.21 * eoc_;
+            g521_ = -822.71072 + 4568.6173 * em_ - 8491.4146 * emsq_ + 5337.524 * eoc_;
+            g532_ = -853.66600 + 4690.2500 * em_ - 8624.7700 * emsq_ + 5341.4 * eoc_;
+        }
+        else
+        {
+            g533_ = -37995.780 + 161616.52 * em_ - 229838.20 * emsq_ + 109377.94 * eoc_;
+            g521_ = -51752.104 + 218913.95 * em_ - 309468.16 * emsq_ + 146349.42 * eoc_;
+            g532_ = -40023.880 + 170470.89 * em_ - 242699.48 * emsq_ + 115605.82 * eoc_;
+        }
+
+        const double sini2_ = sinim_ * sinim_;
+        const double f220_ = 0.75 * ( 1.0 + 2.0 * cosim_ + cosisq_ );
+        const double f221_ = 1.5 * sini2_;
+        const double f321_ = 1.875 * sinim_ * ( 1.0 - 2.0 * cosim_ - 3.0 * cosisq_ );
+        const double f322_ = -1.875 * sinim_ * ( 1.0 + 2.0 * cosim_ - 3.0 * cosisq_ );
+        const double f441_ = 35.0 * sini2_ * f220_;
+        const double f442_ = 39.3750 * sini2_ * sini2_;
+        const double f522_ = 9.84375 * sinim_
+                * ( sini2_ * ( 1.0 - 2.0 * cosim_ - 5.0 * cosisq_ )
+                    + 0.33333333 * ( -2.0 + 4.0 * cosim_ + 6.0 * cosisq_ ) );
+        const double f523_ = sinim_
+                * ( 4.92187512 * sini2_ * ( -2.0 - 4.0 * cosim_ + 10.0 * cosisq_ )
+                    + 6.56250012 * ( 1.0 + 2.0 * cosim_ - 3.0 * cosisq_ ) );
+        const double f542_ = 29.53125 * sinim_
+                * ( 2.0 - 8.0 * cosim_ + cosisq_ * ( -12.0 + 8.0 * cosim_ + 10.0 * cosisq_ ) );
+        const double f543_ = 29.53125 * sinim_
+                * ( -2.0 - 8.0 * cosim_ + cosisq_ * ( 12.0 + 8.0 * cosim_ - 10.0 * cosisq_ ) );
+
+        double temp1_ = 3.0 * meanMotion * meanMotion * aonv_ * aonv_;
+        double temp_ = temp1_ * 1.7891679e-6;
+        coefficients_.d2201 = temp_ * f220_ * g201_;
+        coefficients_.d2211 = temp_ * f221_ * g211_;
+        temp1_ = temp1_ * aonv_;
+        temp_ = temp1_ * 3.7393792e-7;
+        coefficients_.d3210 = temp_ * f321_ * g310_;
+        coefficients_.d3222 = temp_ * f322_ * g322_;
+        temp1_ = temp1_ * aonv_;
+        temp_ = 2.0 * temp1_ * 7.3636953e-9;
+        coefficients_.d4410 = temp_ * f441_ * g410_;
+        coefficients_.d4422 = temp_ * f442_ * g422_;
+        temp1_ = temp1_ * aonv_;
+        temp_ = temp1_ * 1.1428639e-7;
+        coefficients_.d5220 = temp_ * f522_ * g520_;
+        coefficients_.d5232 = temp_ * f523_ * g532_;
+        temp_ = 2.0 * temp1_ * 2.1765803e-9;
+        coefficients_.d5421 = temp_ * f542_ * g521_;
+        coefficients_.d5433 = temp_ * f543_ * g533_;
+
+        coefficients_.xlamo = std::fmod( elementSet.meanAnomaly
+                                         + 2.0 * elementSet.rightAscensionOfAscendingNode
+                                         - 2.0 * theta_, 2.0 * PI );
+        coefficients_.xfact = meanAnomalyRate + coefficients_.dmdt
+                + 2.0 * ( nodeRate + coefficients_.dnodt - rptim_ ) - meanMotion;
+    }
+
+    // Compute the coefficients of the synchronous resonance terms.
+    if ( coefficients_.irez == 1 )
+    {
+        const double g200_ = 1.0 + emsq_ * ( -2.5 + 0.8125 * emsq_ );
+        const double g310_ = 1.0 + 2.0 * emsq_;
+        const double g300_ = 1.0 + emsq_ * ( -6.0 + 6.60937 * emsq_ );
+        const double f220_ = 0.75 * ( 1.0 + cosim_ ) * ( 1.0 + cosim_ );
+        const double f311_ = 0.9375 * sinim_ * sinim_ * ( 1.0 + 3.0 * cosim_ )
+                - 0.75 * ( 1.0 + cosim_ );
+        const double f330_ = 1.875 * ( 1.0 + cosim_ ) * ( 1.0 + cosim_ ) * ( 1.0 + cosim_ );
+
+        const double del1_ = 3.0 * meanMotion * meanMotion * aonv_ * aonv_;
+        coefficients_.del2 = 2.0 * del1_ * f220_ * g200_ * 1.7891679e-6;
+        coefficients_.del3 = 3.0 * del1_ * f330_ * g300_ * 2.2123015e-7 * aonv_;
+        coefficients_.del1 = del1_ * f311_ * g310_ * 2.1460748e-6 * aonv_;
+
+        coefficients_.xlamo = std::fmod( elementSet.meanAnomaly
+                                         + elementSet.rightAscensionOfAscendingNode
+                                         + elementSet.argumentOfPerigee - theta_, 2.0 * PI );
+        coefficients_.xfact = meanAnomalyRate + argumentOfPerigeeRate + nodeRate - rptim_
+                + coefficients_.dmdt + coefficients_.domdt + coefficients_.dnodt - meanMotion;
+    }
+
+    return coefficients_;
+}
+
+//! Apply secular and resonance effects of the deep-space perturbations.
+/*!
+ * Applies the lunar-solar secular rates and the resonance effects of the SDP4 theory to the mean
+ * elements, as in the dspace routine of (Vallado et al., 2006). The resonance terms are
+ * integrated with fixed steps of 720 minutes from the epoch of the element set at every call.
+ * \param coefficients Coefficients of the deep-space perturbations.
+ * \param t Time since epoch.                                                                [min]
+ * \param meanMotionAtEpoch Un-Kozai'd mean motion.                                       [rad/min]
+ * \param argumentOfPerigeeAtEpoch Argument of perigee at epoch.                              [rad]
+ * \param argumentOfPerigeeRate Secular rate of the argument of perigee due to J2 and J4. [rad/min]
+ * \param eccentricity Mean eccentricity, which is updated.                                     [-]
+ * \param inclination Mean inclination, which is updated.                                     [rad]
+ * \param argumentOfPerigee Mean argument of perigee, which is updated.                       [rad]
+ * \param node Mean right ascension of the ascending node, which is updated.                  [rad]
+ * \param meanAnomaly Mean anomaly, which is updated.                                         [rad]
+ * \param meanMotion Mean motion, which is updated for resonant orbits.                   [rad/min]
+ */
+void applyDeepSpaceSecularEffects( const DeepSpaceCoefficients& coefficients, const double t,
+                                   const double meanMotionAtEpoch,
+                                   const double argumentOfPerigeeAtEpoch,
+                                   const double argumentOfPerigeeRate,
+                                   double& eccentricity, double& inclination,
+                                   double& argumentOfPerigee, double& node,
+                                   double& meanAnomaly, double& meanMotion )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    eccentricity += coefficients.dedt * t;
+    inclination += coefficients.didt * t;
+    argumentOfPerigee += coefficients.domdt * t;
+    node += coefficients.dnodt * t;
+    meanAnomaly += coefficients.dmdt * t;
+
+    if ( coefficients.irez == 0 )
+    {
+        return;
+    }
+
+    const double fasx2_ = 0.13130908;
+    const double fasx4_ = 2.8843198;
+    const double fasx6_ = 0.37448087;
+    const double g22_ = 5.7686396;
+    const double g32_ = 0.95240898;
+    const double g44_ = 1.8014998;
+    const double g52_ = 1.0508330;
+    const double g54_ = 4.4108898;
+    const double rptim_ = 4.37526908801129966e-3;
+    const double stepp_ = 720.0;
+    const double step2_ = 259200.0;
+    const double delt_ = ( t > 0.0 ) ? stepp_ : -stepp_;
+    const double theta_ = std::fmod( coefficients.gsto + t * rptim_, 2.0 * PI );
+
+    // Integrate the resonance longitude and mean motion from the epoch to the requested time.
+    double atime_ = 0.0;
+    double xni_ = meanMotionAtEpoch;
+    double xli_ = coefficients.xlamo;
+    double xndt_ = 0.0;
+    double xldot_ = 0.0;
+    double xnddt_ = 0.0;
+    double ft_ = 0.0;
+    while ( true )
+    {
+        if ( coefficients.irez != 2 )
+        {
+            xndt_ = coefficients.del1 * std::sin( xli_ - fasx2_ )
+                    + coefficients.del2 * std::sin( 2.0 * ( xli_ - fasx4_ ) )
+                    + coefficients.del3 * std::sin( 3.0 * ( xli_ - fasx6_ ) );
+            xldot_ = xni_ + coefficients.xfact;
+            xnddt_ = ( coefficients.del1 * std::cos( xli_ - fasx2_ )
+                       + 2.0 * coefficients.del2 * std::cos( 2.0 * ( xli_ - fasx4_ ) )
+                       + 3.0 * coefficients.del3 * std::cos( 3.0 * ( xli_ - fasx6_ ) ) )
+                    * xldot_;
+        }
+        else
+        {
+            const double xomi_ = argumentOfPerigeeAtEpoch + argumentOfPerigeeRate * atime_;
+            const double x2omi_ = xomi_ + xomi_;
+            const double x2li_ = xli_ + xli_;
+            xndt_ = coefficients.d2201 * std::sin( x2omi_ + xli_ - g22_ )
+                    + coefficients.d2211 * std::sin( xli_ - g22_ )
+                    + coefficients.d3210 * std::sin( xomi_ + xli_ - g32_ )
+                    + coefficients.d3222 * std::sin( -xomi_ + xli_ - g32_ )
+                    + coefficients.d4410 * std::sin( x2omi_ + x2li_ - g44_ )
+                    + coefficients.d4422 * std::sin( x2li_ - g44_ )
+                    + coefficients.d5220 * std::sin( xomi_ + xli_ - g52_ )
+                    + coefficients.d5232 * std::sin( -xomi_ + xli_ - g52_ )
+                    + coefficients.d5421 * std::sin( xomi_ + x2li_ - g54_ )
+                    + coefficients.d5433 * std::sin( -xomi_ + x2li_ - g54_ );
+            xldot_ = xni_ + coefficients.xfact;
+            xnddt_ = ( coefficients.d2201 * std::cos( x2omi_ + xli_ - g22_ )
+                       + coefficients.d2211 * std::cos( xli_ - g22_ )
+                       + coefficients.d3210 * std::cos( xomi_ + xli_ - g32_ )
+                       + coefficients.d3222 * std::cos( -xomi_ + xli_ - g32_ )
+                       + coefficients.d5220 * std::cos( xomi_ + xli_ - g52_ )
+                       + coefficients.d5232 * std::cos( -xomi_ + xli_ - g52_ )
+                       + 2.0 * ( coefficients.d4410 * std::cos( x2omi_ + x2li_ - g44_ )
+                                 + coefficients.d4422 * std::cos( x2li_ - g44_ )
+                                 + coefficients.d5421 * std::cos( xomi_ + x2li_ - g54_ )
+                                 + coefficients.d5433 * std::cos( -xomi_ + x2li_ - g54_ ) ) )
+                    * xldot_;
+        }
+
+        if ( std::fabs( t - atime_ ) < stepp_ )
+        {
+            ft_ = t - atime_;
+            break;
+        }
+
+        xli_ = xli_ + xldot_ * delt_ + xndt_ * step2_;
+        xni_ = xni_ + xndt_ * delt_ + xnddt_ * step2_;
+        atime_ = atime_ + delt_;
+    }
+
+    meanMotion = xni_ + xndt_ * ft_ + xnddt_ * ft_ * ft_ * 0.5;
+    const double xl_ = xli_ + xldot_ * ft_ + xndt_ * ft_ * ft_ * 0.5;
+    meanAnomaly = ( coefficients.irez != 1 )
+            ? xl_ - 2.0 * node + 2.0 * theta_
+            : xl_ - node - argumentOfPerigee + theta_;
+}
+
+//! Apply lunar-solar periodic terms.
+/*!
+ * Applies the lunar-solar periodic terms of the SDP4 theory to the mean elements, as in the dpper
+ * routine of (Vallado et al., 2006). For inclinations below 0.2 rad, the terms are applied with
+ * the Lyddane modification, to avoid the singularity of the node at zero inclination.
+ * \param coefficients Coefficients of the deep-space perturbations.
+ * \param t Time since epoch.                                                                [min]
+ * \param eccentricity Eccentricity, which is updated.                                          [-]
+ * \param inclination Inclination, which is updated.                                          [rad]
+ * \param node Right ascension of the ascending node, which is updated.                       [rad]
+ * \param argumentOfPerigee Argument of perigee, which is updated.                            [rad]
+ * \param meanAnomaly Mean anomaly, which is updated.                                         [rad]
+ */
+void applyLunarSolarPeriodics( const DeepSpaceCoefficients& coefficients, const double t,
+                               double& eccentricity, double& inclination, double& node,
+                               double& argumentOfPerigee, double& meanAnomaly )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    // Compute the solar periodic terms.
+    double zm_ = coefficients.zmos + 1.19459e-5 * t;
+    double zf_ = zm_ + 2.0 * 0.01675 * std::sin( zm_ );
+    double sinzf_ = std::sin( zf_ );
+    double f2_ = 0.5 * sinzf_ * sinzf_ - 0.25;
+    double f3_ = -0.5 * sinzf_ * std::cos( zf_ );
+    const double ses_ = coefficients.se2 * f2_ + coefficients.se3 * f3_;
+    const double sis_ = coefficients.si2 * f2_ + coefficients.si3 * f3_;
+    const double sls_ = coefficients.sl2 * f2_ + coefficients.sl3 * f3_
+            + coefficients.sl4 * sinzf_;
+    const double sghs_ = coefficients.sgh2 * f2_ + coefficients.sgh3 * f3_
+            + coefficients.sgh4 * sinzf_;
+    const double shs_ = coefficients.sh2 * f2_ + coefficients.sh3 * f3_;
+
+    // Compute the lunar periodic terms.
+    zm_ = coefficients.zmol + 1.5835218e-4 * t;
+    zf_ = zm_ + 2.0 * 0.05490 * std::sin( zm_ );
+    sinzf_ = std::sin( zf_ );
+    f2_ = 0.5 * sinzf_ * sinzf_ - 0.25;
+    f3_ = -0.5 * sinzf_ * std::cos( zf_ );
+    const double sel_ = coefficients.ee2 * f2_ + coefficients.e3 * f3_;
+    const double sil_ = coefficients.xi2 * f2_ + coefficients.xi3 * f3_;
+    const double sll_ = coefficients.xl2 * f2_ + coefficients.xl3 * f3_
+            + coefficients.xl4 * sinzf_;
+    const double sghl_ = coefficients.xgh2 * f2_ + coefficients.xgh3 * f3_
+            + coefficients.xgh4 * sinzf_;
+    const double shll_ = coefficients.xh2 * f2_ + coefficients.xh3 * f3_;
+
+    const double pe_ = ses_ + sel_;
+    const double pinc_ = sis_ + sil_;
+    const double pl_ = sls_ + sll_;
+    double pgh_ = sghs_ + sghl_;
+    double ph_ = shs_ + shll_;
+
+    inclination += pinc_;
+    eccentricity += pe_;
+    const double sinip_ = std::sin( inclination );
+    const double cosip_ = std::cos( inclination );
+
+    if ( inclination >= 0.2 )
+    {
+        ph_ = ph_ / sinip_;
+        pgh_ = pgh_ - cosip_ * ph_;
+        argumentOfPerigee += pgh_;
+        node += ph_;
+        meanAnomaly += pl_;
+    }
+    else
+    {
+        // Apply the periodic terms to the node with the Lyddane modification.
+        const double sinop_ = std::sin( node );
+        const double cosop_ = std::cos( node );
+        const double alfdp_ = sinip_ * sinop_ + ph_ * cosop_ + pinc_ * cosip_ * sinop_;
+        const double betdp_ = sinip_ * cosop_ - ph_ * sinop_ + pinc_ * cosip_ * cosop_;
+        node = std::fmod( node, 2.0 * PI );
+        const double xls_ = meanAnomaly + argumentOfPerigee + cosip_ * node
+                + pl_ + pgh_ - pinc_ * node * sinip_;
+        const double xnoh_ = node;
+        node = std::atan2( alfdp_, betdp_ );
+        if ( std::fabs( xnoh_ - node ) > PI )
+        {
+            node = ( node < xnoh_ ) ? node + 2.0 * PI : node - 2.0 * PI;
+        }
+        meanAnomaly += pl_;
+        argumentOfPerigee = xls_ - meanAnomaly - cosip_ * node;
+    }
+}
+
+//! Loop body for propagation of a catalog of two-line element sets.
+/*!
+ * Loop body for propagation of a catalog of two-line element sets, to be used with
+ * executeParallelLoop(). Each call propagates a contiguous block of orbits to all epochs.
+ */
+class TwoLineElementSetCatalogPropagation
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param orbits SGP4 orbits of objects in catalog.
+     * \param orbitIndices Indices of objects in catalog.
+     * \param epochs Vector of epochs.
+     * \param cartesianStates Vector of matrices in which the propagated Cartesian states are
+     *          stored.
+     */
+    TwoLineElementSetCatalogPropagation( const std::vector< Sgp4Orbit >& orbits,
+                                         const std::vector< int >& orbitIndices,
+                                         const Eigen::VectorXd& epochs,
+                                         std::vector< Eigen::MatrixXd >& cartesianStates )
+        : orbits_( orbits ),
+          orbitIndices_( orbitIndices ),
+          epochs_( epochs ),
+          cartesianStates_( cartesianStates )
+    { }
+
+    //! Propagate block of orbits.
+    /*!
+     * Propagates a block of orbits to all epochs.
+     * \param startIndex Index of first orbit in block.
+     * \param endIndex Index one past last orbit in block.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        Sgp4Orbit::Vector6d cartesianState_;
+        for ( int orbitIndex = startIndex; orbitIndex < endIndex; orbitIndex++ )
+        {
+            const Sgp4Orbit& orbit_ = orbits_[ orbitIndex ];
+            for ( int epochIndex = 0; epochIndex < epochs_.rows( ); epochIndex++ )
+            {
+                orbit_.computeStateAtTime( epochs_( epochIndex ) - orbit_.getEpoch( ),
+                                           cartesianState_ );
+                cartesianStates_[ epochIndex ].col( orbitIndices_[ orbitIndex ] )
+                        = cartesianState_;
+            }
+        }
+    }
+
+private:
+
+    //! SGP4 orbits of objects in catalog.
+    const std::vector< Sgp4Orbit >& orbits_;
+
+    //! Indices of objects in catalog.
+    const std::vector< int >& orbitIndices_;
+
+    //! Vector of epochs.
+    const Eigen::VectorXd& epochs_;
+
+    //! Vector of matrices in which the propagated Cartesian states are stored.
+    std::vector< Eigen::MatrixXd >& cartesianStates_;
+};
+
+} // namespace
+
+//! Check if two-line element set describes a deep-space orbit.
+bool isDeepSpaceOrbit( const input_output::TwoLineElementSet& elementSet )
+{
+    double semiMajorAxis_;
+    return 2.0 * basic_mathematics::mathematical_constants::PI
+            / computeUnKozaiMeanMotion( elementSet, semiMajorAxis_ ) >= DEEP_SPACE_PERIOD_LIMIT;
+}
+
+//! Default constructor.
+Sgp4Orbit::Sgp4Orbit( const input_output::TwoLineElementSet& elementSet )
+    : epoch_( elementSet.epoch ),
+      bStarDragTerm_( elementSet.bStarDragTerm ),
+      eccentricity_( elementSet.eccentricity ),
+      inclination_( elementSet.inclination ),
+      argumentOfPerigee_( elementSet.argumentOfPerigee ),
+      rightAscensionOfAscendingNode_( elementSet.rightAscensionOfAscendingNode ),
+      meanAnomaly_( elementSet.meanAnomaly )
+{
+    // Check if the element set can be propagated with SGP4.
+    if ( !( eccentricity_ >= 0.0 && eccentricity_ < 1.0 && elementSet.meanMotion > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Eccentricity of two-line element set should be in "
+                                            "[0, 1) and mean motion should be positive." ) ) );
+    }
+
+    // Compute the un-Kozai'd mean motion and the inclination and eccentricity functions.
+    double ao_;
+    meanMotion_ = computeUnKozaiMeanMotion( elementSet, ao_ );
+
+    cosineOfInclination_ = std::cos( inclination_ );
+    sineOfInclination_ = std::sin( inclination_ );
+    const double cosio2_ = cosineOfInclination_ * cosineOfInclination_;
+    const double cosio4_ = cosio2_ * cosio2_;
+    const double omeosq_ = 1.0 - eccentricity_ * eccentricity_;
+    const double rteosq_ = std::sqrt( omeosq_ );
+    const double po_ = ao_ * omeosq_;
+    const double con42_ = 1.0 - 5.0 * cosio2_;
+    con41_ = 3.0 * cosio2_ - 1.0;
+    x1mth2_ = 1.0 - cosio2_;
+    x7thm1_ = 7.0 * cosio2_ - 1.0;
+    const double rp_ = ao_ * ( 1.0 - eccentricity_ );
+
+    // Use the simplified drag model for perigee heights below 220 km, and for deep-space orbits.
+    const bool isDeepSpace_ = ( 2.0 * basic_mathematics::mathematical_constants::PI / meanMotion_
+                                >= DEEP_SPACE_PERIOD_LIMIT );
+    isSimplifiedDragModel_ = ( rp_ < 220.0 / EARTH_RADIUS + 1.0 ) || isDeepSpace_;
+
+    // Compute the parameters of the atmospheric density model; the parameter s is lowered for
+    // perigee heights below 156 km.
+    double sfour_ = 78.0 / EARTH_RADIUS + 1.0;
+    double qzms24_ = std::pow( ( 120.0 - 78.0 ) / EARTH_RADIUS, 4.0 );
+    const double perigeeHeight_ = ( rp_ - 1.0 ) * EARTH_RADIUS;
+    if ( perigeeHeight_ < 156.0 )
+    {
+        sfour_ = ( perigeeHeight_ < 98.0 ) ? 20.0 : perigeeHeight_ - 78.0;
+        qzms24_ = std::pow( ( 120.0 - sfour_ ) / EARTH_RADIUS, 4.0 );
+        sfour_ = sfour_ / EARTH_RADIUS + 1.0;
+    }
+
+    // Compute the drag coefficients.
+    const double pinvsq_ = 1.0 / ( po_ * po_ );
+    const double tsi_ = 1.0 / ( ao_ - sfour_ );
+    eta_ = ao_ * eccentricity_ * tsi_;
+    const double etasq_ = eta_ * eta_;
+    const double eeta_ = eccentricity_ * eta_;
+    const double psisq_ = std::fabs( 1.0 - etasq_ );
+    const double coef_ = qzms24_ * std::pow( tsi_, 4.0 );
+    const double coef1_ = coef_ / std::pow( psisq_, 3.5 );
+    const double c2_ = coef1_ * meanMotion_
+            * ( ao_ * ( 1.0 + 1.5 * etasq_ + eeta_ * ( 4.0 + etasq_ ) )
+                + 0.375 * J2 * tsi_ / psisq_ * con41_
+                * ( 8.0 + 3.0 * etasq_ * ( 8.0 + etasq_ ) ) );
+    c1_ = bStarDragTerm_ * c2_;
+    const double c3_ = ( eccentricity_ > 1.0e-4 )
+            ? -2.0 * coef_ * tsi_ * J3 / J2 * meanMotion_ * sineOfInclination_ / eccentricity_
+            : 0.0;
+    c4_ = 2.0 * meanMotion_ * coef1_ * ao_ * omeosq_
+            * ( eta_ * ( 2.0 + 0.5 * etasq_ ) + eccentricity_ * ( 0.5 + 2.0 * etasq_ )
+                - J2 * tsi_ / ( ao_ * psisq_ )
+                * ( -3.0 * con41_ * ( 1.0 - 2.0 * eeta_ + etasq_ * ( 1.5 - 0.5 * eeta_ ) )
+                    + 0.75 * x1mth2_ * ( 2.0 * etasq_ - eeta_ * ( 1.0 + etasq_ ) )
+                    * std::cos( 2.0 * argumentOfPerigee_ ) ) );
+    c5_ = 2.0 * coef1_ * ao_ * omeosq_ * ( 1.0 + 2.75 * ( etasq_ + eeta_ ) + eeta_ * etasq_ );
+
+    // Compute the secular rates due to J2 and J4.
+    const double temp1_ = 1.5 * J2 * pinvsq_ * meanMotion_;
+    const double temp2_ = 0.5 * temp1_ * J2 * pinvsq_;
+    const double temp3_ = -0.46875 * J4 * pinvsq_ * pinvsq_ * meanMotion_;
+    meanAnomalyRate_ = meanMotion_ + 0.5 * temp1_ * rteosq_ * con41_
+            + 0.0625 * temp2_ * rteosq_ * ( 13.0 - 78.0 * cosio2_ + 137.0 * cosio4_ );
+    argumentOfPerigeeRate_ = -0.5 * temp1_ * con42_
+            + 0.0625 * temp2_ * ( 7.0 - 114.0 * cosio2_ + 395.0 * cosio4_ )
+            + temp3_ * ( 3.0 - 36.0 * cosio2_ + 49.0 * cosio4_ );
+    const double xhdot1_ = -temp1_ * cosineOfInclination_;
+    rightAscensionOfAscendingNodeRate_ = xhdot1_
+            + ( 0.5 * temp2_ * ( 4.0 - 19.0 * cosio2_ ) + 2.0 * temp3_ * ( 3.0 - 7.0 * cosio2_ ) )
+            * cosineOfInclination_;
+
+    // Compute the drag coefficients of the angles and the mean longitude.
+    argumentOfPerigeeDragCoefficient_ = bStarDragTerm_ * c3_ * std::cos( argumentOfPerigee_ );
+    meanAnomalyDragCoefficient_ = ( eccentricity_ > 1.0e-4 )
+            ? -2.0 / 3.0 * coef_ * bStarDragTerm_ / eeta_ : 0.0;
+    nodeDragCoefficient_ = 3.5 * omeosq_ * xhdot1_ * c1_;
+    t2Coefficient_ = 1.5 * c1_;
+
+    // Compute the coefficients of the long-period periodic terms; the singularity for an
+    // inclination of pi is avoided as in (Vallado et al., 2006).
+    const double onePlusCosineOfInclination_ = ( std::fabs( cosineOfInclination_ + 1.0 ) > 1.5e-12 )
+            ? 1.0 + cosineOfInclination_ : 1.5e-12;
+    longitudeCoefficient_ = -0.25 * J3 / J2 * sineOfInclination_
+            * ( 3.0 + 5.0 * cosineOfInclination_ ) / onePlusCosineOfInclination_;
+    ayCoefficient_ = -0.5 * J3 / J2 * sineOfInclination_;
+    deltaMeanAnomalyAtEpoch_ = std::pow( 1.0 + eta_ * std::cos( meanAnomaly_ ), 3.0 );
+    sineOfMeanAnomalyAtEpoch_ = std::sin( meanAnomaly_ );
+
+    // Compute the higher-order drag coefficients, which are not used in the simplified model.
+    d2_ = 0.0;
+    d3_ = 0.0;
+    d4_ = 0.0;
+    t3Coefficient_ = 0.0;
+    t4Coefficient_ = 0.0;
+    t5Coefficient_ = 0.0;
+    if ( !isSimplifiedDragModel_ )
+    {
+        const double c1sq_ = c1_ * c1_;
+        d2_ = 4.0 * ao_ * tsi_ * c1sq_;
+        const double temp_ = d2_ * tsi_ * c1_ / 3.0;
+        d3_ = ( 17.0 * ao_ + sfour_ ) * temp_;
+        d4_ = 0.5 * temp_ * ao_ * tsi_ * ( 221.0 * ao_ + 31.0 * sfour_ ) * c1_;
+        t3Coefficient_ = d2_ + 2.0 * c1sq_;
+        t4Coefficient_ = 0.25 * ( 3.0 * d3_ + c1_ * ( 12.0 * d2_ + 10.0 * c1sq_ ) );
+        t5Coefficient_ = 0.2 * ( 3.0 * d4_ + 12.0 * c1_ * d3_ + 6.0 * d2_ * d2_
+                                 + 15.0 * c1sq_ * ( 2.0 * d2_ + c1sq_ ) );
+    }
+
+    // Compute the coefficients of the deep-space perturbations.
+    if ( isDeepSpace_ )
+    {
+        deepSpaceCoefficients_.reset( new DeepSpaceCoefficients(
+                                          computeDeepSpaceCoefficients(
+                                              elementSet, meanMotion_, meanAnomalyRate_,
+                                              argumentOfPerigeeRate_,
+                                              rightAscensionOfAscendingNodeRate_ ) ) );
+    }
+}
+
+//! Compute Cartesian state at time.
+bool Sgp4Orbit::computeStateAtTime( const double timeSinceEpoch,
+                                    Vector6d& cartesianState ) const
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    const double t_ = timeSinceEpoch / 60.0;
+
+    // Update the mean elements for the secular effects of gravity and drag.
+    const double xmdf_ = meanAnomaly_ + meanAnomalyRate_ * t_;
+    const double argpdf_ = argumentOfPerigee_ + argumentOfPerigeeRate_ * t_;
+    const double nodedf_ = rightAscensionOfAscendingNode_ + rightAscensionOfAscendingNodeRate_ * t_;
+    const double t2_ = t_ * t_;
+    double argpm_ = argpdf_;
+    double mm_ = xmdf_;
+    double nodem_ = nodedf_ + nodeDragCoefficient_ * t2_;
+    double tempa_ = 1.0 - c1_ * t_;
+    double tempe_ = bStarDragTerm_ * c4_ * t_;
+    double templ_ = t2Coefficient_ * t2_;
+
+    if ( !isSimplifiedDragModel_ )
+    {
+        const double delomg_ = argumentOfPerigeeDragCoefficient_ * t_;
+        const double delmtemp_ = 1.0 + eta_ * std::cos( xmdf_ );
+        const double delm_ = meanAnomalyDragCoefficient_
+                * ( delmtemp_ * delmtemp_ * delmtemp_ - deltaMeanAnomalyAtEpoch_ );
+        mm_ = xmdf_ + delomg_ + delm_;
+        argpm_ = argpdf_ - delomg_ - delm_;
+        const double t3_ = t2_ * t_;
+        const double t4_ = t3_ * t_;
+        tempa_ = tempa_ - d2_ * t2_ - d3_ * t3_ - d4_ * t4_;
+        tempe_ = tempe_ + bStarDragTerm_ * c5_ * ( std::sin( mm_ ) - sineOfMeanAnomalyAtEpoch_ );
+        templ_ = templ_ + t3Coefficient_ * t3_ + t4_ * ( t4Coefficient_ + t_ * t5Coefficient_ );
+    }
+
+    // Add the lunar-solar secular and resonance effects for deep-space orbits.
+    double nm_ = meanMotion_;
+    double em_ = eccentricity_;
+    double inclm_ = inclination_;
+    if ( deepSpaceCoefficients_ )
+    {
+        applyDeepSpaceSecularEffects( *deepSpaceCoefficients_, t_, meanMotion_,
+                                      argumentOfPerigee_, argumentOfPerigeeRate_,
+                                      em_, inclm_, argpm_, nodem_, mm_, nm_ );
+    }
+    if ( !( nm_ > 0.0 ) )
+    {
+        cartesianState.setConstant( TUDAT_NAN );
+        return false;
+    }
+
+    const double am_ = std::pow( XKE / nm_, 2.0 / 3.0 ) * tempa_ * tempa_;
+    nm_ = XKE / std::pow( am_, 1.5 );
+    em_ = em_ - tempe_;
+
+    // Check if the mean eccentricity is still valid.
+    if ( !( em_ < 1.0 && em_ >= -0.001 ) || !( am_ > 0.0 ) )
+    {
+        cartesianState.setConstant( TUDAT_NAN );
+        return false;
+    }
+    if ( em_ < 1.0e-6 )
+    {
+        em_ = 1.0e-6;
+    }
+
+    mm_ = mm_ + meanMotion_ * templ_;
+    double xlm_ = mm_ + argpm_ + nodem_;
+    nodem_ = std::fmod( nodem_, 2.0 * PI );
+    argpm_ = std::fmod( argpm_, 2.0 * PI );
+    xlm_ = std::fmod( xlm_, 2.0 * PI );
+    mm_ = std::fmod( xlm_ - argpm_ - nodem_, 2.0 * PI );
+
+    // Add the lunar-solar periodic terms for deep-space orbits, which change the inclination and
+    // thereby the inclination functions.
+    double ep_ = em_;
+    double xincp_ = inclm_;
+    double argpp_ = argpm_;
+    double nodep_ = nodem_;
+    double mp_ = mm_;
+    double sinip_ = sineOfInclination_;
+    double cosip_ = cosineOfInclination_;
+    double aycof_ = ayCoefficient_;
+    double xlcof_ = longitudeCoefficient_;
+    double con41p_ = con41_;
+    double x1mth2p_ = x1mth2_;
+    double x7thm1p_ = x7thm1_;
+    if ( deepSpaceCoefficients_ )
+    {
+        applyLunarSolarPeriodics( *deepSpaceCoefficients_, t_, ep_, xincp_, nodep_, argpp_, mp_ );
+        if ( xincp_ < 0.0 )
+        {
+            xincp_ = -xincp_;
+            nodep_ = nodep_ + PI;
+            argpp_ = argpp_ - PI;
+        }
+        if ( ep_ < 0.0 || ep_ > 1.0 )
+        {
+            cartesianState.setConstant( TUDAT_NAN );
+            return false;
+        }
+
+        sinip_ = std::sin( xincp_ );
+        cosip_ = std::cos( xincp_ );
+        const double cosisq_ = cosip_ * cosip_;
+        aycof_ = -0.5 * J3 / J2 * sinip_;
+        xlcof_ = -0.25 * J3 / J2 * sinip_ * ( 3.0 + 5.0 * cosip_ )
+                / ( ( std::fabs( cosip_ + 1.0 ) > 1.5e-12 ) ? 1.0 + cosip_ : 1.5e-12 );
+        con41p_ = 3.0 * cosisq_ - 1.0;
+        x1mth2p_ = 1.0 - cosisq_;
+        x7thm1p_ = 7.0 * cosisq_ - 1.0;
+    }
+
+    // Add the long-period periodic terms.
+    const double axnl_ = ep_ * std::cos( argpp_ );
+    double temp_ = 1.0 / ( am_ * ( 1.0 - ep_ * ep_ ) );
+    const double aynl_ = ep_ * std::sin( argpp_ ) + temp_ * aycof_;
+    const double xl_ = mp_ + argpp_ + nodep_ + temp_ * xlcof_ * axnl_;
+
+    // Solve Kepler's equation for the sum of eccentric anomaly and argument of perigee, with
+    // steps limited to 0.95 rad, as in (Vallado et al., 2006).
+    const double u_ = std::fmod( xl_ - nodep_, 2.0 * PI );
+    double eo1_ = u_;
+    double sineo1_ = 0.0;
+    double coseo1_ = 0.0;
+    double tem5_ = 1.0;
+    for ( int iteration = 0; iteration < 10 && std::fabs( tem5_ ) >= 1.0e-12; iteration++ )
+    {
+        sineo1_ = std::sin( eo1_ );
+        coseo1_ = std::cos( eo1_ );
+        tem5_ = ( u_ - aynl_ * coseo1_ + axnl_ * sineo1_ - eo1_ )
+                / ( 1.0 - coseo1_ * axnl_ - sineo1_ * aynl_ );
+        if ( std::fabs( tem5_ ) >= 0.95 )
+        {
+            tem5_ = ( tem5_ > 0.0 ) ? 0.95 : -0.95;
+        }
+        eo1_ = eo1_ + tem5_;
+    }
+
+    // Compute the short-period preliminary quantities.
+    const double ecose_ = axnl_ * coseo1_ + aynl_ * sineo1_;
+    const double esine_ = axnl_ * sineo1_ - aynl_ * coseo1_;
+    const double el2_ = axnl_ * axnl_ + aynl_ * aynl_;
+    const double pl_ = am_ * ( 1.0 - el2_ );
+    if ( pl_ < 0.0 )
+    {
+        cartesianState.setConstant( TUDAT_NAN );
+        return false;
+    }
+
+    const double rl_ = am_ * ( 1.0 - ecose_ );
+    const double rdotl_ = std::sqrt( am_ ) * esine_ / rl_;
+    const double rvdotl_ = std::sqrt( pl_ ) / rl_;
+    const double betal_ = std::sqrt( 1.0 - el2_ );
+    temp_ = esine_ / ( 1.0 + betal_ );
+    const double sinu_ = am_ / rl_ * ( sineo1_ - aynl_ - axnl_ * temp_ );
+    const double cosu_ = am_ / rl_ * ( coseo1_ - axnl_ + aynl_ * temp_ );
+    double su_ = std::atan2( sinu_, cosu_ );
+    const double sin2u_ = ( cosu_ + cosu_ ) * sinu_;
+    const double cos2u_ = 1.0 - 2.0 * sinu_ * sinu_;
+    temp_ = 1.0 / pl_;
+    const double temp1_ = 0.5 * J2 * temp_;
+    const double temp2_ = temp1_ * temp_;
+
+    // Update for the short-period periodic terms.
+    const double mrt_ = rl_ * ( 1.0 - 1.5 * temp2_ * betal_ * con41p_ )
+            + 0.5 * temp1_ * x1mth2p_ * cos2u_;
+    su_ = su_ - 0.25 * temp2_ * x7thm1p_ * sin2u_;
+    const double xnode_ = nodep_ + 1.5 * temp2_ * cosip_ * sin2u_;
+    const double xinc_ = xincp_ + 1.5 * temp2_ * cosip_ * sinip_ * cos2u_;
+    const double mvt_ = rdotl_ - nm_ * temp1_ * x1mth2p_ * sin2u_ / XKE;
+    const double rvdot_ = rvdotl_ + nm_ * temp1_ * ( x1mth2p_ * cos2u_ + 1.5 * con41p_ ) / XKE;
+
+    // Check if the orbit has decayed.
+    if ( mrt_ < 1.0 )
+    {
+        cartesianState.setConstant( TUDAT_NAN );
+        return false;
+    }
+
+    // Compute the orientation vectors and the Cartesian state.
+    const double sinsu_ = std::sin( su_ );
+    const double cossu_ = std::cos( su_ );
+    const double snod_ = std::sin( xnode_ );
+    const double cnod_ = std::cos( xnode_ );
+    const double sini_ = std::sin( xinc_ );
+    const double cosi_ = std::cos( xinc_ );
+    const double xmx_ = -snod_ * cosi_;
+    const double xmy_ = cnod_ * cosi_;
+    const Eigen::Vector3d unitPositionVector_( xmx_ * sinsu_ + cnod_ * cossu_,
+                                               xmy_ * sinsu_ + snod_ * cossu_,
+                                               sini_ * sinsu_ );
+    const Eigen::Vector3d unitTransverseVector_( xmx_ * cossu_ - cnod_ * sinsu_,
+                                                 xmy_ * cossu_ - snod_ * sinsu_,
+                                                 sini_ * cossu_ );
+
+    const double distanceUnit_ = EARTH_RADIUS * 1.0e3;
+    const double velocityUnit_ = distanceUnit_ * XKE / 60.0;
+    cartesianState.segment( xPositionIndex, 3 ) = mrt_ * distanceUnit_ * unitPositionVector_;
+    cartesianState.segment( xVelocityIndex, 3 ) = velocityUnit_
+            * ( mvt_ * unitPositionVector_ + rvdot_ * unitTransverseVector_ );
+
+    return true;
+}
+
+//! Get Cartesian state at time.
+Sgp4Orbit::Vector6d Sgp4Orbit::getStateAtTime( const double timeSinceEpoch ) const
+{
+    Vector6d cartesianState_;
+    if ( !computeStateAtTime( timeSinceEpoch, cartesianState_ ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "SGP4 theory failed; the mean eccentricity or mean "
+                                            "motion is invalid or the orbit has decayed." ) ) );
+    }
+
+    return cartesianState_;
+}
+
+//! Propagate catalog of two-line element sets to a grid of epochs.
+void propagateTwoLineElementSets( const std::vector< input_output::TwoLineElementSet >& elementSets,
+                                  const Eigen::VectorXd& epochs,
+                                  std::vector< Eigen::MatrixXd >& cartesianStates,
+                                  const unsigned int numberOfThreads )
+{
+    const int numberOfObjects_ = elementSets.size( );
+
+    // Resize output matrices, and initialize them to NaN, which remains for objects that cannot
+    // be propagated; resizing does not allocate if the matrices already have the correct size.
+    cartesianStates.resize( epochs.rows( ) );
+    for ( unsigned int epochIndex = 0; epochIndex < cartesianStates.size( ); epochIndex++ )
+    {
+        cartesianStates[ epochIndex ].resize( 6, numberOfObjects_ );
+        cartesianStates[ epochIndex ].setConstant( TUDAT_NAN );
+    }
+
+    // Compute orbit-constant coefficients of all objects with valid elements.
+    std::vector< Sgp4Orbit > orbits_;
+    std::vector< int > orbitIndices_;
+    orbits_.reserve( numberOfObjects_ );
+    orbitIndices_.reserve( numberOfObjects_ );
+    for ( int objectIndex = 0; objectIndex < numberOfObjects_; objectIndex++ )
+    {
+        const input_output::TwoLineElementSet& elementSet_ = elementSets[ objectIndex ];
+        if ( elementSet_.eccentricity >= 0.0 && elementSet_.eccentricity < 1.0
+             && elementSet_.meanMotion > 0.0 )
+        {
+            orbits_.push_back( Sgp4Orbit( elementSet_ ) );
+            orbitIndices_.push_back( objectIndex );
+        }
+    }
+
+    // Propagate orbits, divided over multiple threads.
+    basics::executeParallelLoop(
+                orbits_.size( ), TwoLineElementSetCatalogPropagation( orbits_, orbitIndices_,
+                                                                      epochs, cartesianStates ),
+                numberOfThreads, 64 );
+}
+
+} // namespace propagators
+} // namespace tudat
@@ -0,0 +1,238 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Hoots, F. R., Roehrich, R. L. Spacetrack Report No. 3: Models for Propagation of NORAD
+ *          Element Sets, Aerospace Defense Command, 1980.
+ *      Vallado, D. A., Crawford, P., Hujsak, R., Kelso, T. S. Revisiting Spacetrack Report #3,
+ *          AIAA/AAS Astrodynamics Specialist Conference, AIAA 2006-6753, 2006.
+ *
+ *    Notes
+ *      Both the near-Earth (SGP4) and the deep-space (SDP4) parts of the theory are implemented.
+ *      For orbits with a period of 225 minutes or more, the lunar-solar perturbations and the
+ *      resonance effects of the Earth's gravity field on synchronous and half-day orbits are
+ *      included, as in (Vallado et al., 2006). The resonance terms are integrated numerically from
+ *      the epoch of the element set at every evaluation, rather than continued from the previous
+ *      evaluation, such that an orbit can be evaluated concurrently from multiple threads.
+ *
+ */
+
+#ifndef TUDAT_CORE_SGP4_ORBIT_H
+#define TUDAT_CORE_SGP4_ORBIT_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "TudatCore/InputOutput/twoLineElementSetReader.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Check if two-line element set describes a deep-space orbit.
+/*!
+ * Checks if a two-line element set describes a deep-space orbit, i.e., an orbit with a period
+ * (based on the un-Kozai'd mean motion) of 225 minutes or more, for which the deep-space
+ * perturbations of the SDP4 theory are included (Vallado et al., 2006).
+ * \param elementSet Two-line element set.
+ * \return True if the orbit is a deep-space orbit.
+ */
+bool isDeepSpaceOrbit( const input_output::TwoLineElementSet& elementSet );
+
+//! Forward declaration of coefficients of the deep-space perturbations of the SDP4 theory.
+struct DeepSpaceCoefficients;
+
+//! Orbit propagated with the SGP4/SDP4 theory.
+/*!
+ * Orbit defined by a two-line element set, propagated with the SGP4 theory, as given by (Vallado
+ * et al., 2006), using the WGS-72 constants with which the element sets are generated. For
+ * deep-space orbits, the lunar-solar and resonance perturbations of SDP4 are included. All
+ * orbit-constant coefficients of the theory are computed once at construction, such that
+ * evaluating the orbit at a time only requires the secular, drag, resonance and periodic terms.
+ * The states are given in the True Equator, Mean Equinox (TEME) frame of the epoch of the element
+ * set.
+ * \sa isDeepSpaceOrbit().
+ */
+class Sgp4Orbit
+{
+public:
+
+    //! Typedef for Cartesian state vector.
+    typedef basic_astrodynamics::orbital_element_conversions::Vector6d Vector6d;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, which computes the orbit-constant coefficients of the SGP4 theory, and
+     * for deep-space orbits those of the SDP4 perturbations. An error is thrown for element sets
+     * with an eccentricity outside [0, 1) or a non-positive mean motion.
+     * \param elementSet Two-line element set.
+     */
+    Sgp4Orbit( const input_output::TwoLineElementSet& elementSet );
+
+    //! Get epoch.
+    /*!
+     * Returns the epoch of the element set.
+     * \return Epoch in seconds since 1 January 2000, 12:00 UTC.                                [s]
+     */
+    double getEpoch( ) const { return epoch_; }
+
+    //! Compute Cartesian state at time.
+    /*!
+     * Computes the Cartesian state of the orbit at a given time with respect to the epoch of the
+     * element set, without throwing errors, such that it can be used when propagating large
+     * catalogs. If the theory fails, i.e., if the mean eccentricity leaves [0, 1) (also after
+     * adding the lunar-solar periodic terms), the mean motion or the semi-latus rectum becomes
+     * negative, or the orbit has decayed below the surface of the Earth, false is returned and
+     * the state is set to NaN.
+     * \param timeSinceEpoch Time since epoch; may be negative.                                 [s]
+     * \param cartesianState Cartesian state in TEME frame, ordered as given by the
+     *          CartesianElementVectorIndices enum.                                    [m, m/s]
+     * \return True if the state could be computed.
+     */
+    bool computeStateAtTime( const double timeSinceEpoch, Vector6d& cartesianState ) const;
+
+    //! Get Cartesian state at time.
+    /*!
+     * Returns the Cartesian state of the orbit at a given time with respect to the epoch of the
+     * element set. An error is thrown if the theory fails.
+     * \param timeSinceEpoch Time since epoch; may be negative.                                 [s]
+     * \return Cartesian state in TEME frame, ordered as given by the CartesianElementVectorIndices
+     *          enum.                                                                  [m, m/s]
+     * \sa computeStateAtTime().
+     */
+    Vector6d getStateAtTime( const double timeSinceEpoch ) const;
+
+private:
+
+    //! Epoch of element set.
+    double epoch_;
+
+    //! Drag term B*.
+    double bStarDragTerm_;
+
+    //! Mean eccentricity at epoch.
+    double eccentricity_;
+
+    //! Mean inclination at epoch.
+    double inclination_;
+
+    //! Mean argument of perigee at epoch.
+    double argumentOfPerigee_;
+
+    //! Mean right ascension of ascending node at epoch.
+    double rightAscensionOfAscendingNode_;
+
+    //! Mean anomaly at epoch.
+    double meanAnomaly_;
+
+    //! Un-Kozai'd mean motion, in radians per minute.
+    double meanMotion_;
+
+    //! Flag indicating whether the simplified drag model is used (perigee below 220 km).
+    bool isSimplifiedDragModel_;
+
+    //! Cosine of inclination.
+    double cosineOfInclination_;
+
+    //! Sine of inclination.
+    double sineOfInclination_;
+
+    //! Secular rate of mean anomaly, in radians per minute.
+    double meanAnomalyRate_;
+
+    //! Secular rate of argument of perigee, in radians per minute.
+    double argumentOfPerigeeRate_;
+
+    //! Secular rate of right ascension of ascending node, in radians per minute.
+    double rightAscensionOfAscendingNodeRate_;
+
+    //! Parameter eta of the drag model.
+    double eta_;
+
+    //! Drag coefficients C1, C4 and C5.
+    double c1_, c4_, c5_;
+
+    //! Drag coefficients D2, D3 and D4 of the secular semi-major axis decay.
+    double d2_, d3_, d4_;
+
+    //! Coefficients of the secular mean longitude terms in t^2 to t^5.
+    double t2Coefficient_, t3Coefficient_, t4Coefficient_, t5Coefficient_;
+
+    //! Drag coefficients of the argument of perigee, mean anomaly and node.
+    double argumentOfPerigeeDragCoefficient_, meanAnomalyDragCoefficient_, nodeDragCoefficient_;
+
+    //! Cube of ( 1 + eta cos( M0 ) ).
+    double deltaMeanAnomalyAtEpoch_;
+
+    //! Sine of mean anomaly at epoch.
+    double sineOfMeanAnomalyAtEpoch_;
+
+    //! Coefficients of the long-period periodic terms due to J3.
+    double longitudeCoefficient_, ayCoefficient_;
+
+    //! Inclination functions 3 cos^2 i - 1, 1 - cos^2 i and 7 cos^2 i - 1.
+    double con41_, x1mth2_, x7thm1_;
+
+    //! Coefficients of the deep-space perturbations; empty for near-Earth orbits.
+    boost::shared_ptr< const DeepSpaceCoefficients > deepSpaceCoefficients_;
+};
+
+//! Propagate catalog of two-line element sets to a grid of epochs.
+/*!
+ * Propagates a catalog of two-line element sets with the SGP4/SDP4 theory to a grid of epochs, and
+ * computes the Cartesian states of all objects at all epochs. The orbit-constant coefficients of
+ * each element set are computed once, after which the catalog is divided over multiple threads.
+ * The states at each epoch are stored in a separate 6 x N matrix, with one object per column,
+ * such that they can be passed directly to the batch version of
+ * convertCartesianToKeplerianElements(). The states of objects with invalid elements, and of
+ * objects for which the theory fails at an epoch (e.g., because they have decayed), are set to
+ * NaN.
+ * \param elementSets Catalog of two-line element sets (N entries).
+ * \param epochs Vector of epochs, in seconds since 1 January 2000, 12:00 UTC (T entries).     [s]
+ * \param cartesianStates Vector in which the propagated Cartesian states in TEME frame are stored
+ *          (T entries), where entry j contains the states of all objects at epochs( j ) (6 x N),
+ *          ordered as given by the CartesianElementVectorIndices enum. If the vector and its
+ *          matrices are preallocated with the correct sizes, no memory is allocated; otherwise
+ *          they are resized.                                                          [m, m/s]
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \sa Sgp4Orbit, orbital_element_conversions::convertCartesianToKeplerianElements().
+ */
+void propagateTwoLineElementSets( const std::vector< input_output::TwoLineElementSet >& elementSets,
+                                  const Eigen::VectorXd& epochs,
+                                  std::vector< Eigen::MatrixXd >& cartesianStates,
+                                  const unsigned int numberOfThreads = 0 );
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_SGP4_ORBIT_H
@@ -0,0 +1,404 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *      Press, W.H., Teukolsky, S.A., Vetterling, W.T., Flannery, B.P. Numerical Recipes: The Art
+ *          of Scientific Computing, 3rd Edition, Cambridge University Press, Cambridge, 2007.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Geometry>
+
+#include "TudatCore/Astrodynamics/Propagators/universalVariablePropagator.h"
+#include "TudatCore/Basics/parallelLoop.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+using basic_astrodynamics::orbital_element_conversions::Vector6d;
+
+namespace
+{
+
+//! Threshold of | r0 / a | below which the orbit is treated as parabolic in the initial guess.
+const double PARABOLIC_ORBIT_THRESHOLD = 1.0e-6;
+
+//! Propagate Kepler orbit using universal variable, without throwing errors.
+/*!
+ * Propagates a Kepler orbit using the universal-variable formulation, as described for
+ * propagateKeplerOrbitWithUniversalVariable(), but returns false instead of throwing an error if
+ * the iteration does not converge or the initial state is invalid.
+ * \param initialCartesianState Initial Cartesian state.
+ * \param propagationTime Propagation time.                                                     [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param relativeTolerance Relative tolerance of the universal variable.                      [-]
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \param finalCartesianState Propagated Cartesian state, which is computed.
+ * \return True if the iteration has converged.
+ */
+bool computeUniversalVariablePropagation( const Vector6d& initialCartesianState,
+                                          const double propagationTime,
+                                          const double centralBodyGravitationalParameter,
+                                          const double relativeTolerance,
+                                          const int maximumNumberOfIterations,
+                                          Vector6d& finalCartesianState )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    const Eigen::Vector3d initialPosition_ = initialCartesianState.segment< 3 >( 0 );
+    const Eigen::Vector3d initialVelocity_ = initialCartesianState.segment< 3 >( 3 );
+    const double initialRadius_ = initialPosition_.norm( );
+    const double squareRootOfGravitationalParameter_
+            = std::sqrt( centralBodyGravitationalParameter );
+
+    if ( !( initialRadius_ > 0.0 ) || !( centralBodyGravitationalParameter > 0.0 ) )
+    {
+        return false;
+    }
+
+    // Compute reciprocal of semi-major axis, which is zero for parabolic orbits, and the scaled
+    // radial velocity r0 . v0 / sqrt( mu ).
+    const double reciprocalSemiMajorAxis_ = 2.0 / initialRadius_
+            - initialVelocity_.squaredNorm( ) / centralBodyGravitationalParameter;
+    const double scaledRadialVelocity_ = initialPosition_.dot( initialVelocity_ )
+            / squareRootOfGravitationalParameter_;
+
+    const double scaledReciprocalSemiMajorAxis_ = reciprocalSemiMajorAxis_ * initialRadius_;
+
+    // Remove whole revolutions from propagation time for elliptical orbits.
+    double propagationTime_ = propagationTime;
+    if ( scaledReciprocalSemiMajorAxis_ > PARABOLIC_ORBIT_THRESHOLD )
+    {
+        const double orbitalPeriod_ = 2.0 * PI / ( squareRootOfGravitationalParameter_
+                                                   * std::pow( reciprocalSemiMajorAxis_, 1.5 ) );
+        propagationTime_ = std::fmod( propagationTime_, orbitalPeriod_ );
+    }
+
+    if ( propagationTime_ == 0.0 )
+    {
+        finalCartesianState = initialCartesianState;
+        return true;
+    }
+
+    // Compute initial guess of universal variable, depending on the conic type (Vallado, 2004).
+    double universalVariable_;
+    if ( scaledReciprocalSemiMajorAxis_ > PARABOLIC_ORBIT_THRESHOLD )
+    {
+        universalVariable_ = squareRootOfGravitationalParameter_ * propagationTime_
+                * reciprocalSemiMajorAxis_;
+    }
+    else if ( scaledReciprocalSemiMajorAxis_ < -PARABOLIC_ORBIT_THRESHOLD )
+    {
+        const double semiMajorAxis_ = 1.0 / reciprocalSemiMajorAxis_;
+        const double timeSign_ = ( propagationTime_ > 0.0 ) ? 1.0 : -1.0;
+        universalVariable_ = timeSign_ * std::sqrt( -semiMajorAxis_ ) * std::log(
+                    -2.0 * centralBodyGravitationalParameter * reciprocalSemiMajorAxis_
+                    * propagationTime_
+                    / ( initialPosition_.dot( initialVelocity_ ) + timeSign_
+                        * std::sqrt( -centralBodyGravitationalParameter * semiMajorAxis_ )
+                        * ( 1.0 - initialRadius_ * reciprocalSemiMajorAxis_ ) ) );
+    }
+    else
+    {
+        // Use solution of Barker's equation for a parabolic orbit with the same semi-latus
+        // rectum, starting at periapsis.
+        const double semiLatusRectum_ = initialPosition_.cross( initialVelocity_ ).squaredNorm( )
+                / centralBodyGravitationalParameter;
+        const double halfAngle_ = 0.5 * std::atan(
+                    1.0 / ( 3.0 * std::sqrt( centralBodyGravitationalParameter
+                                             / ( semiLatusRectum_ * semiLatusRectum_
+                                                 * semiLatusRectum_ ) )
+                            * std::fabs( propagationTime_ ) ) );
+        const double angle_ = std::atan( std::pow( std::tan( halfAngle_ ), 1.0 / 3.0 ) );
+        universalVariable_ = ( ( propagationTime_ > 0.0 ) ? 1.0 : -1.0 )
+                * std::sqrt( semiLatusRectum_ ) * 2.0 / std::tan( 2.0 * angle_ );
+    }
+
+    // Bracket universal variable, using that its derivative with respect to time is
+    // sqrt( mu ) / r, such that its magnitude lies between zero and sqrt( mu ) | dt | / r_p.
+    const double semiLatusRectum_ = initialPosition_.cross( initialVelocity_ ).squaredNorm( )
+            / centralBodyGravitationalParameter;
+    const double periapsisRadius_ = semiLatusRectum_ / ( 1.0 + std::sqrt( std::max(
+                0.0, 1.0 - semiLatusRectum_ * reciprocalSemiMajorAxis_ ) ) );
+    const double bracketWidth_ = squareRootOfGravitationalParameter_
+            * std::fabs( propagationTime_ ) / periapsisRadius_;
+    double lowerBound_ = ( propagationTime_ > 0.0 ) ? 0.0 : -bracketWidth_;
+    double upperBound_ = ( propagationTime_ > 0.0 ) ? bracketWidth_ : 0.0;
+
+    // Solve universal Kepler equation by Newton iteration, safeguarded by bisection when a step
+    // leaves the bracket or does not halve the previous step (Press et al., 2007). The derivative
+    // of the equation with respect to the universal variable is the radius, which is always
+    // positive.
+    double psi_ = 0.0;
+    double c2_ = 0.5;
+    double c3_ = 1.0 / 6.0;
+    double radius_ = initialRadius_;
+    double previousCorrection_ = bracketWidth_;
+    bool isConverged_ = false;
+    for ( int iteration = 0; iteration < maximumNumberOfIterations && !isConverged_;
+          iteration++ )
+    {
+        psi_ = universalVariable_ * universalVariable_ * reciprocalSemiMajorAxis_;
+        computeStumpffFunctions( psi_, c2_, c3_ );
+
+        const double universalVariableSquared_ = universalVariable_ * universalVariable_;
+        radius_ = universalVariableSquared_ * c2_
+                + scaledRadialVelocity_ * universalVariable_ * ( 1.0 - psi_ * c3_ )
+                + initialRadius_ * ( 1.0 - psi_ * c2_ );
+        const double residual_ = universalVariableSquared_ * universalVariable_ * c3_
+                + scaledRadialVelocity_ * universalVariableSquared_ * c2_
+                + initialRadius_ * universalVariable_ * ( 1.0 - psi_ * c3_ )
+                - squareRootOfGravitationalParameter_ * propagationTime_;
+
+        // Update bracket, which is infinite for radial orbits.
+        if ( residual_ < 0.0 )
+        {
+            lowerBound_ = std::max( lowerBound_, universalVariable_ );
+        }
+        else
+        {
+            upperBound_ = std::min( upperBound_, universalVariable_ );
+        }
+
+        double correction_ = -residual_ / radius_;
+        if ( upperBound_ - lowerBound_ < std::numeric_limits< double >::infinity( )
+             && ( !( universalVariable_ + correction_ >= lowerBound_
+                     && universalVariable_ + correction_ <= upperBound_ )
+                  || std::fabs( 2.0 * correction_ ) > std::fabs( previousCorrection_ ) ) )
+        {
+            correction_ = 0.5 * ( lowerBound_ + upperBound_ ) - universalVariable_;
+        }
+        previousCorrection_ = correction_;
+        universalVariable_ += correction_;
+
+        isConverged_ = std::fabs( correction_ ) <= relativeTolerance
+                * std::fabs( universalVariable_ );
+    }
+
+    if ( !isConverged_ || !( radius_ > 0.0 ) )
+    {
+        return false;
+    }
+
+    // Compute Lagrange coefficients at converged universal variable.
+    psi_ = universalVariable_ * universalVariable_ * reciprocalSemiMajorAxis_;
+    computeStumpffFunctions( psi_, c2_, c3_ );
+    const double universalVariableSquared_ = universalVariable_ * universalVariable_;
+    radius_ = universalVariableSquared_ * c2_
+            + scaledRadialVelocity_ * universalVariable_ * ( 1.0 - psi_ * c3_ )
+            + initialRadius_ * ( 1.0 - psi_ * c2_ );
+
+    const double f_ = 1.0 - universalVariableSquared_ * c2_ / initialRadius_;
+    const double g_ = propagationTime_ - universalVariableSquared_ * universalVariable_ * c3_
+            / squareRootOfGravitationalParameter_;
+    const double fDot_ = squareRootOfGravitationalParameter_ / ( radius_ * initialRadius_ )
+            * universalVariable_ * ( psi_ * c3_ - 1.0 );
+    const double gDot_ = 1.0 - universalVariableSquared_ * c2_ / radius_;
+
+    finalCartesianState.segment< 3 >( 0 ) = f_ * initialPosition_ + g_ * initialVelocity_;
+    finalCartesianState.segment< 3 >( 3 ) = fDot_ * initialPosition_ + gDot_ * initialVelocity_;
+    return true;
+}
+
+//! Loop body for batch universal-variable propagation.
+/*!
+ * Loop body for propagation of a catalog of Kepler orbits with the universal-variable
+ * formulation, to be used with executeParallelLoop(). Each call propagates a contiguous range of
+ * orbits; the states of orbits that fail to converge are set to NaN.
+ */
+class UniversalVariableCatalogPropagation
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor.
+     * \param initialStates Matrix of initial Cartesian states (6 x N).
+     * \param propagationTimes Vector of propagation times (N entries).
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body.
+     * \param relativeTolerance Relative tolerance of the universal variable.
+     * \param maximumNumberOfIterations Maximum number of iterations.
+     * \param finalStates Matrix in which the propagated Cartesian states are stored (6 x N).
+     */
+    UniversalVariableCatalogPropagation( const Eigen::MatrixXd& initialStates,
+                                         const Eigen::VectorXd& propagationTimes,
+                                         const double centralBodyGravitationalParameter,
+                                         const double relativeTolerance,
+                                         const int maximumNumberOfIterations,
+                                         Eigen::MatrixXd& finalStates )
+        : initialStates_( initialStates ),
+          propagationTimes_( propagationTimes ),
+          centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+          relativeTolerance_( relativeTolerance ),
+          maximumNumberOfIterations_( maximumNumberOfIterations ),
+          finalStates_( finalStates )
+    { }
+
+    //! Propagate range of orbits.
+    /*!
+     * Propagates the orbits in the index range [ startIndex, endIndex ).
+     * \param startIndex Index of first orbit.
+     * \param endIndex One past the index of the last orbit.
+     */
+    void operator( )( const int startIndex, const int endIndex ) const
+    {
+        Vector6d finalState_;
+        for ( int orbitIndex = startIndex; orbitIndex < endIndex; orbitIndex++ )
+        {
+            if ( !computeUniversalVariablePropagation(
+                     initialStates_.col( orbitIndex ), propagationTimes_( orbitIndex ),
+                     centralBodyGravitationalParameter_, relativeTolerance_,
+                     maximumNumberOfIterations_, finalState_ ) )
+            {
+                finalState_.setConstant( TUDAT_NAN );
+            }
+            finalStates_.col( orbitIndex ) = finalState_;
+        }
+    }
+
+private:
+
+    //! Matrix of initial Cartesian states.
+    const Eigen::MatrixXd& initialStates_;
+
+    //! Vector of propagation times.
+    const Eigen::VectorXd& propagationTimes_;
+
+    //! Gravitational parameter of central body.
+    const double centralBodyGravitationalParameter_;
+
+    //! Relative tolerance of the universal variable.
+    const double relativeTolerance_;
+
+    //! Maximum number of iterations.
+    const int maximumNumberOfIterations_;
+
+    //! Matrix in which the propagated Cartesian states are stored.
+    Eigen::MatrixXd& finalStates_;
+};
+
+} // namespace
+
+//! Compute Stumpff functions.
+void computeStumpffFunctions( const double psi, double& c2, double& c3 )
+{
+    if ( psi >= 1.0 )
+    {
+        const double squareRootOfPsi_ = std::sqrt( psi );
+        c2 = ( 1.0 - std::cos( squareRootOfPsi_ ) ) / psi;
+        c3 = ( squareRootOfPsi_ - std::sin( squareRootOfPsi_ ) ) / ( psi * squareRootOfPsi_ );
+    }
+    else if ( psi <= -1.0 )
+    {
+        const double squareRootOfMinusPsi_ = std::sqrt( -psi );
+        c2 = ( 1.0 - std::cosh( squareRootOfMinusPsi_ ) ) / psi;
+        c3 = ( std::sinh( squareRootOfMinusPsi_ ) - squareRootOfMinusPsi_ )
+                / ( -psi * squareRootOfMinusPsi_ );
+    }
+    else
+    {
+        // Evaluate power series c2 = sum ( -psi )^k / ( 2k + 2 )! and
+        // c3 = sum ( -psi )^k / ( 2k + 3 )! with Horner's scheme; for | psi | < 1, the truncation
+        // error of nine terms is below machine precision.
+        c2 = 0.0;
+        c3 = 0.0;
+        for ( int k = 8; k >= 0; k-- )
+        {
+            c2 = 1.0 / ( ( 2.0 * k + 1.0 ) * ( 2.0 * k + 2.0 ) ) * ( 1.0 - psi * c2 );
+            c3 = 1.0 / ( ( 2.0 * k + 2.0 ) * ( 2.0 * k + 3.0 ) ) * ( 1.0 - psi * c3 );
+        }
+    }
+}
+
+//! Propagate Kepler orbit using universal variable.
+Vector6d propagateKeplerOrbitWithUniversalVariable( const Vector6d& initialCartesianState,
+                                                    const double propagationTime,
+                                                    const double centralBodyGravitationalParameter,
+                                                    const double relativeTolerance,
+                                                    const int maximumNumberOfIterations )
+{
+    Vector6d finalCartesianState_;
+    if ( !computeUniversalVariablePropagation( initialCartesianState, propagationTime,
+                                               centralBodyGravitationalParameter,
+                                               relativeTolerance, maximumNumberOfIterations,
+                                               finalCartesianState_ ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Universal Kepler equation did not converge." ) ) );
+    }
+
+    return finalCartesianState_;
+}
+
+//! Propagate catalog of Kepler orbits using universal variable.
+void propagateKeplerOrbitsWithUniversalVariable( const Eigen::MatrixXd& initialCartesianStates,
+                                                 const Eigen::VectorXd& propagationTimes,
+                                                 const double centralBodyGravitationalParameter,
+                                                 Eigen::MatrixXd& finalCartesianStates,
+                                                 const unsigned int numberOfThreads,
+                                                 const double relativeTolerance,
+                                                 const int maximumNumberOfIterations )
+{
+    // Check input sizes, such that no errors can occur in the threads.
+    if ( initialCartesianStates.rows( ) != 6
+         || propagationTimes.rows( ) != initialCartesianStates.cols( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Cartesian state matrix should have 6 rows, and one "
+                                            "propagation time per orbit." ) ) );
+    }
+
+    // Resize output matrix; this does not allocate if it already has the correct size.
+    finalCartesianStates.resize( 6, initialCartesianStates.cols( ) );
+
+    basics::executeParallelLoop(
+                initialCartesianStates.cols( ),
+                UniversalVariableCatalogPropagation( initialCartesianStates, propagationTimes,
+                                                     centralBodyGravitationalParameter,
+                                                     relativeTolerance, maximumNumberOfIterations,
+                                                     finalCartesianStates ),
+                numberOfThreads, 64 );
+}
+
+} // namespace propagators
+} // namespace tudat
@@ -0,0 +1,121 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., McClain, W. D. Fundamentals of astrodynamics and applications, 2nd Edition,
+ *          Kluwer Academic Publishers, The Netherlands, 2004.
+ *      Bate, R.R., Mueller, D.D., White, J.E. Fundamentals of Astrodynamics, Dover Publications,
+ *          New York, 1971.
+ *
+ *    Notes
+ *      The universal-variable formulation covers elliptical, parabolic and hyperbolic orbits with
+ *      a single set of equations, such that no distinction between conic types is required and
+ *      near-parabolic orbits are propagated without loss of accuracy. The Stumpff functions are
+ *      evaluated with their power series near zero, where the closed-form expressions suffer from
+ *      cancellation.
+ *
+ */
+
+#ifndef TUDAT_CORE_UNIVERSAL_VARIABLE_PROPAGATOR_H
+#define TUDAT_CORE_UNIVERSAL_VARIABLE_PROPAGATOR_H
+
+#include <Eigen/Core>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+
+namespace tudat
+{
+namespace propagators
+{
+
+//! Compute Stumpff functions.
+/*!
+ * Computes the Stumpff functions c2( psi ) = ( 1 - cos( sqrt( psi ) ) ) / psi and
+ * c3( psi ) = ( sqrt( psi ) - sin( sqrt( psi ) ) ) / sqrt( psi )^3, and their hyperbolic
+ * counterparts for negative psi (Vallado, 2004). For | psi | < 1, the power series are used.
+ * \param psi Argument of the Stumpff functions, i.e., the square of the universal variable
+ *          multiplied by the reciprocal of the semi-major axis.                                [-]
+ * \param c2 Stumpff function c2, which is computed.                                            [-]
+ * \param c3 Stumpff function c3, which is computed.                                            [-]
+ */
+void computeStumpffFunctions( const double psi, double& c2, double& c3 );
+
+//! Propagate Kepler orbit using universal variable.
+/*!
+ * Propagates a Kepler orbit, given as a Cartesian state, over a given propagation time using the
+ * universal-variable formulation (Vallado, 2004; Bate et al., 1971). The universal Kepler
+ * equation is solved by Newton iteration, safeguarded by bisection, starting from an initial
+ * guess that depends on the conic type, after which the state is computed with the Lagrange
+ * coefficients. Elliptical,
+ * parabolic and hyperbolic orbits are supported. For elliptical orbits, whole revolutions are
+ * removed from the propagation time. Only fixed-size vectors are used, such that no dynamic
+ * memory is allocated. An error is thrown if the iteration does not converge.
+ * \param initialCartesianState Initial Cartesian state, ordered as given by the
+ *          CartesianElementVectorIndices enum.
+ * \param propagationTime Propagation time; may be negative.                                    [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param relativeTolerance Relative tolerance of the universal variable.                      [-]
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \return Propagated Cartesian state.
+ */
+basic_astrodynamics::orbital_element_conversions::Vector6d
+propagateKeplerOrbitWithUniversalVariable(
+        const basic_astrodynamics::orbital_element_conversions::Vector6d& initialCartesianState,
+        const double propagationTime, const double centralBodyGravitationalParameter,
+        const double relativeTolerance = 1.0e-13, const int maximumNumberOfIterations = 100 );
+
+//! Propagate catalog of Kepler orbits using universal variable.
+/*!
+ * Propagates a catalog of Kepler orbits, given as Cartesian states, each over its own
+ * propagation time using the universal-variable formulation. The catalog is divided over multiple
+ * threads. The propagated states of orbits for which the iteration does not converge are set to
+ * NaN, instead of throwing an error. An error is thrown if the input sizes do not match.
+ * \param initialCartesianStates Matrix of initial Cartesian states, with one orbit per column
+ *          (6 x N), ordered as given by the CartesianElementVectorIndices enum.
+ * \param propagationTimes Vector of propagation times, one per orbit (N entries).              [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body.      [m^3/s^2]
+ * \param finalCartesianStates Matrix in which the propagated Cartesian states are stored
+ *          (6 x N). If the matrix is preallocated with the correct size, no memory is allocated;
+ *          otherwise it is resized.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \param relativeTolerance Relative tolerance of the universal variable.                      [-]
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \sa propagateKeplerOrbitWithUniversalVariable().
+ */
+void propagateKeplerOrbitsWithUniversalVariable( const Eigen::MatrixXd& initialCartesianStates,
+                                                 const Eigen::VectorXd& propagationTimes,
+                                                 const double centralBodyGravitationalParameter,
+                                                 Eigen::MatrixXd& finalCartesianStates,
+                                                 const unsigned int numberOfThreads = 0,
+                                                 const double relativeTolerance = 1.0e-13,
+                                                 const int maximumNumberOfIterations = 100 );
+
+} // namespace propagators
+} // namespace tudat
+
+#endif // TUDAT_CORE_UNIVERSAL_VARIABLE_PROPAGATOR_H
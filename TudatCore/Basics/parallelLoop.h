@@ -0,0 +1,192 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *
+ *    Notes
+ *      The loop body is copied for each thread, so any state it holds by value is thread-local.
+ *      State shared through references or pointers must be safe to access concurrently; in
+ *      particular, different blocks of iterations should write to disjoint memory.
+ *
+ */
+
+#ifndef TUDAT_CORE_PARALLEL_LOOP_H
+#define TUDAT_CORE_PARALLEL_LOOP_H
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/thread.hpp>
+
+namespace tudat
+{
+namespace basics
+{
+
+//! Block of iterations of a parallel loop.
+/*!
+ * Functor that executes a contiguous block of iterations of a parallel loop, and stores any
+ * exception thrown by the loop body, such that it can be rethrown in the calling thread.
+ * \tparam LoopBodyType Type of loop body; see executeParallelLoop().
+ */
+template< typename LoopBodyType >
+class ParallelLoopBlock
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking the loop body, the index range of the block and the storage for
+     * a caught exception as arguments.
+     * \param loopBody Loop body, called as loopBody( startIndex, endIndex ).
+     * \param startIndex First index of the block.
+     * \param endIndex One past the last index of the block.
+     * \param caughtException Storage for the exception thrown by the loop body, if any.
+     */
+    ParallelLoopBlock( const LoopBodyType& loopBody, const int startIndex, const int endIndex,
+                       boost::exception_ptr& caughtException )
+        : loopBody_( loopBody ),
+          startIndex_( startIndex ),
+          endIndex_( endIndex ),
+          caughtException_( caughtException )
+    { }
+
+    //! Execute block of iterations.
+    /*!
+     * Executes the block of iterations, storing any exception thrown by the loop body.
+     */
+    void operator( )( )
+    {
+        try
+        {
+            loopBody_( startIndex_, endIndex_ );
+        }
+
+        catch ( ... )
+        {
+            caughtException_ = boost::current_exception( );
+        }
+    }
+
+private:
+
+    //! Loop body.
+    /*!
+     * Loop body, copied such that each thread has its own instance.
+     */
+    LoopBodyType loopBody_;
+
+    //! First index of the block.
+    /*!
+     * First index of the block.
+     */
+    int startIndex_;
+
+    //! One past the last index of the block.
+    /*!
+     * One past the last index of the block.
+     */
+    int endIndex_;
+
+    //! Storage for caught exception.
+    /*!
+     * Storage for exception thrown by the loop body, if any.
+     */
+    boost::exception_ptr& caughtException_;
+};
+
+//! Execute loop in parallel.
+/*!
+ * Executes a loop over the indices [ 0, numberOfIterations ) in parallel, by dividing the index
+ * range into contiguous blocks of (nearly) equal size, one per thread. The first block is executed
+ * on the calling thread. The loop body is called once per block as
+ * loopBody( startIndex, endIndex ), and should process the indices [ startIndex, endIndex ). If
+ * the loop body throws an exception in any of the threads, the first one caught is rethrown in
+ * the calling thread after all threads have finished.
+ * \tparam LoopBodyType Type of loop body, which should be copyable and callable with two integer
+ *          arguments.
+ * \param numberOfIterations Number of iterations of the loop.
+ * \param loopBody Loop body.
+ * \param numberOfThreads Number of threads to use. If set to 0, the number of hardware threads is
+ *          used.
+ * \param minimumNumberOfIterationsPerThread Minimum number of iterations per thread, used to
+ *          limit the number of threads for small loops, for which the overhead of starting a
+ *          thread is not worthwhile.
+ */
+template< typename LoopBodyType >
+void executeParallelLoop( const int numberOfIterations, const LoopBodyType& loopBody,
+                          const unsigned int numberOfThreads = 0,
+                          const int minimumNumberOfIterationsPerThread = 1 )
+{
+    // Determine number of blocks to use.
+    int numberOfBlocks_ = static_cast< int >(
+                numberOfThreads == 0 ? boost::thread::hardware_concurrency( )
+                                     : numberOfThreads );
+    numberOfBlocks_ = std::min( numberOfBlocks_, numberOfIterations
+                                / std::max( minimumNumberOfIterationsPerThread, 1 ) );
+
+    // Execute loop on calling thread if parallel execution is not required.
+    if ( numberOfBlocks_ <= 1 )
+    {
+        if ( numberOfIterations > 0 )
+        {
+            loopBody( 0, numberOfIterations );
+        }
+        return;
+    }
+
+    // Start threads for all but the first block.
+    std::vector< boost::exception_ptr > caughtExceptions_( numberOfBlocks_ );
+    boost::thread_group threads_;
+    for ( int block = 1; block < numberOfBlocks_; block++ )
+    {
+        threads_.create_thread( ParallelLoopBlock< LoopBodyType >(
+                                    loopBody, block * numberOfIterations / numberOfBlocks_,
+                                    ( block + 1 ) * numberOfIterations / numberOfBlocks_,
+                                    caughtExceptions_[ block ] ) );
+    }
+
+    // Execute first block on calling thread and wait for other threads to finish.
+    ParallelLoopBlock< LoopBodyType >( loopBody, 0, numberOfIterations / numberOfBlocks_,
+                                       caughtExceptions_[ 0 ] )( );
+    threads_.join_all( );
+
+    // Rethrow first exception caught, if any.
+    for ( int block = 0; block < numberOfBlocks_; block++ )
+    {
+        if ( caughtExceptions_[ block ] )
+        {
+            boost::rethrow_exception( caughtExceptions_[ block ] );
+        }
+    }
+}
+
+} // namespace basics
+} // namespace tudat
+
+#endif // TUDAT_CORE_PARALLEL_LOOP_H
@@ -0,0 +1,182 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., Crawford, P., Hujsak, R., Kelso, T. S. Revisiting Spacetrack Report #3,
+ *          AIAA/AAS Astrodynamics Specialist Conference, AIAA 2006-6753, 2006.
+ *
+ *    Notes
+ *      The test file contains element sets from the verification set of (Vallado et al., 2006),
+ *      in the three-line format, with Windows line endings for the second element set and an
+ *      element set without name line.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "TudatCore/InputOutput/basicInputOutput.h"
+#include "TudatCore/InputOutput/twoLineElementSetReader.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_two_line_element_set_reader )
+
+// Test if two-line element sets are parsed correctly.
+BOOST_AUTO_TEST_CASE( testTwoLineElementSetParsing )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    // Read element sets from test file.
+    const std::vector< input_output::TwoLineElementSet > elementSets
+            = input_output::readTwoLineElementSetsFromFile(
+                input_output::getCoreRootPath( )
+                + "/InputOutput/UnitTests/testTwoLineElementSets.txt" );
+
+    // Check that all element sets are read, skipping name lines and empty lines.
+    BOOST_REQUIRE_EQUAL( elementSets.size( ), 3 );
+    BOOST_CHECK_EQUAL( elementSets[ 0 ].catalogNumber, 5 );
+    BOOST_CHECK_EQUAL( elementSets[ 1 ].catalogNumber, 6251 );
+    BOOST_CHECK_EQUAL( elementSets[ 2 ].catalogNumber, 11801 );
+
+    // Set tolerance; the parsed values should be correctly rounded.
+    const double tolerance = 2.0 * std::numeric_limits< double >::epsilon( );
+    const double degreesToRadians = PI / 180.0;
+    const double revolutionsPerDayToRadiansPerSecond = 2.0 * PI / 86400.0;
+
+    // Check all fields of the first element set. The epoch is day 179.78495062 of 2000, which
+    // starts 0.5 days before J2000.
+    const input_output::TwoLineElementSet& elementSet = elementSets[ 0 ];
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.epoch, ( 178.78495062 - 0.5 ) * 86400.0, tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.firstDerivativeOfMeanMotion,
+                                2.0 * 0.00000023 * revolutionsPerDayToRadiansPerSecond / 86400.0,
+                                tolerance );
+    BOOST_CHECK_EQUAL( elementSet.secondDerivativeOfMeanMotion, 0.0 );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.bStarDragTerm, 0.28098e-4, tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.inclination, 34.2682 * degreesToRadians, tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.rightAscensionOfAscendingNode,
+                                348.7242 * degreesToRadians, tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.eccentricity, 0.1859667, tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.argumentOfPerigee, 331.7664 * degreesToRadians,
+                                tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.meanAnomaly, 19.3264 * degreesToRadians, tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.meanMotion,
+                                10.82419157 * revolutionsPerDayToRadiansPerSecond, tolerance );
+    BOOST_CHECK_EQUAL( elementSet.revolutionNumber, 41366 );
+
+    // Check the epoch of the second element set, in 2006, which starts 2192 days after 2000, and
+    // the fields affected by the carriage returns.
+    BOOST_CHECK_CLOSE_FRACTION( elementSets[ 1 ].epoch,
+                                ( 2192.0 - 0.5 + 175.82412014 ) * 86400.0, tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSets[ 1 ].meanMotion,
+                                15.56387291 * revolutionsPerDayToRadiansPerSecond, tolerance );
+    BOOST_CHECK_EQUAL( elementSets[ 1 ].revolutionNumber, 653 );
+
+    // Check the epoch of the third element set, in 1980, and its drag term.
+    BOOST_CHECK_CLOSE_FRACTION( elementSets[ 2 ].epoch,
+                                ( -7305.0 - 0.5 + 229.29629788 ) * 86400.0, tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( elementSets[ 2 ].bStarDragTerm, 0.14311e-1, tolerance );
+}
+
+// Test if special field formats are parsed correctly.
+BOOST_AUTO_TEST_CASE( testTwoLineElementSetFieldFormats )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    // Parse element set with alpha-5 catalog number, negative mean motion derivatives and drag
+    // term, and a positive drag exponent.
+    const input_output::TwoLineElementSet elementSet = input_output::parseTwoLineElementSet(
+                "1 B1234U 98067A   24001.50000000 -.00001234 -12345-5 -11606+1 0  9990",
+                "2 B1234  51.6400 120.0000 0001234  90.0000 270.0000 15.50000000    10" );
+
+    BOOST_CHECK_EQUAL( elementSet.catalogNumber, 111234 );
+    BOOST_CHECK_LT( elementSet.firstDerivativeOfMeanMotion, 0.0 );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.secondDerivativeOfMeanMotion,
+                                6.0 * -0.12345e-5 * 2.0 * PI
+                                / ( 86400.0 * 86400.0 * 86400.0 ),
+                                1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.bStarDragTerm, -1.1606, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( elementSet.eccentricity, 0.0001234, 1.0e-15 );
+    BOOST_CHECK_EQUAL( elementSet.revolutionNumber, 1 );
+}
+
+// Test if errors are thrown for invalid element sets.
+BOOST_AUTO_TEST_CASE( testTwoLineElementSetErrors )
+{
+    const std::string firstLine
+            = "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753";
+    const std::string secondLine
+            = "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667";
+
+    // Test that an error is thrown if the catalog numbers do not match.
+    std::string otherSecondLine = secondLine;
+    otherSecondLine[ 6 ] = '6';
+    BOOST_CHECK_THROW( input_output::parseTwoLineElementSet( firstLine.c_str( ),
+                                                             otherSecondLine.c_str( ) ),
+                       std::runtime_error );
+
+    // Test that an error is thrown for an invalid character in a field.
+    std::string invalidSecondLine = secondLine;
+    invalidSecondLine[ 11 ] = 'x';
+    BOOST_CHECK_THROW( input_output::parseTwoLineElementSet( firstLine.c_str( ),
+                                                             invalidSecondLine.c_str( ) ),
+                       std::runtime_error );
+
+    // Test that an error is thrown for a truncated line.
+    BOOST_CHECK_THROW( input_output::parseTwoLineElementSet( firstLine.substr( 0, 40 ).c_str( ),
+                                                             secondLine.c_str( ) ),
+                       std::runtime_error );
+
+    // Test that an error is thrown if the lines are swapped.
+    std::stringstream swappedLines( secondLine + "\n" + firstLine + "\n" );
+    BOOST_CHECK_THROW( input_output::readTwoLineElementSets( swappedLines ),
+                       std::runtime_error );
+
+    // Test that an error is thrown if the second line is missing.
+    std::stringstream missingLine( "NAME\n" + firstLine + "\n" );
+    BOOST_CHECK_THROW( input_output::readTwoLineElementSets( missingLine ),
+                       std::runtime_error );
+
+    // Test that an error is thrown if the file does not exist.
+    BOOST_CHECK_THROW( input_output::readTwoLineElementSetsFromFile( "nonexistentFile.txt" ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
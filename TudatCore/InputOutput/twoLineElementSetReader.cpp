@@ -0,0 +1,446 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., Crawford, P., Hujsak, R., Kelso, T. S. Revisiting Spacetrack Report #3,
+ *          AIAA/AAS Astrodynamics Specialist Conference, AIAA 2006-6753, 2006.
+ *      CelesTrak. NORAD Two-Line Element Set Format, http://celestrak.com/columns/v04n03/,
+ *          last accessed: 18th October, 2026.
+ *
+ *    Notes
+ *      Two-digit epoch years from 57 to 99 are interpreted as 1957 to 1999, and years from 00 to 56
+ *      as 2000 to 2056, following (Vallado et al., 2006).
+ *
+ */
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/format.hpp>
+
+#include "TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "TudatCore/InputOutput/twoLineElementSetReader.h"
+#include "TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+namespace
+{
+
+//! Size of line buffers used to read element sets.
+const int LINE_BUFFER_SIZE = 256;
+
+//! Throw error for invalid field in two-line element set.
+/*!
+ * Throws a runtime error for an invalid field in a two-line element set.
+ * \param line Element line containing the field.
+ * \param firstColumn First column of field (1-based, as in the format definition).
+ */
+void throwInvalidFieldError( const char* line, const int firstColumn )
+{
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error(
+                        boost::str( boost::format( "Invalid field at column %1% of two-line "
+                                                   "element line: %2%" )
+                                    % firstColumn % line ) ) ) );
+}
+
+//! Parse decimal number in fixed-column field.
+/*!
+ * Parses a decimal number, with an optional sign and decimal point and without exponent, from a
+ * fixed-column field. Leading and trailing spaces are skipped. The digits are accumulated in an
+ * integer, which is divided by the power of ten given by the number of decimals at the end, such
+ * that the result is correctly rounded for all fields of the two-line element format.
+ * \param line Element line.
+ * \param firstColumn First column of field (1-based, as in the format definition).
+ * \param lastColumn Last column of field (1-based, inclusive).
+ * \param hasImpliedDecimalPoint Flag indicating whether the field has an implied leading decimal
+ *          point, as for the eccentricity. In that case, spaces are read as zeros, following
+ *          (Vallado et al., 2006).
+ * \return Value of field.
+ */
+double parseDecimalField( const char* line, const int firstColumn, const int lastColumn,
+                          const bool hasImpliedDecimalPoint = false )
+{
+    long long digits_ = 0;
+    int numberOfDigits_ = 0;
+    int numberOfDecimals_ = 0;
+    bool isNegative_ = false;
+    bool isDecimalPart_ = false;
+    bool isNumberStarted_ = false;
+    bool isNumberEnded_ = false;
+
+    for ( int column = firstColumn; column <= lastColumn; column++ )
+    {
+        const char character_ = ( hasImpliedDecimalPoint && line[ column - 1 ] == ' ' )
+                ? '0' : line[ column - 1 ];
+        if ( character_ == ' ' )
+        {
+            // Spaces are only allowed before and after the number.
+            isNumberEnded_ = isNumberStarted_;
+            continue;
+        }
+
+        if ( isNumberEnded_ )
+        {
+            throwInvalidFieldError( line, firstColumn );
+        }
+
+        if ( character_ >= '0' && character_ <= '9' )
+        {
+            digits_ = 10 * digits_ + ( character_ - '0' );
+            numberOfDigits_++;
+            if ( isDecimalPart_ || hasImpliedDecimalPoint )
+            {
+                numberOfDecimals_++;
+            }
+        }
+
+        else if ( character_ == '.' && !isDecimalPart_ && !hasImpliedDecimalPoint )
+        {
+            isDecimalPart_ = true;
+        }
+
+        else if ( ( character_ == '-' || character_ == '+' ) && !isNumberStarted_ )
+        {
+            isNegative_ = ( character_ == '-' );
+        }
+
+        else
+        {
+            throwInvalidFieldError( line, firstColumn );
+        }
+
+        isNumberStarted_ = true;
+    }
+
+    if ( numberOfDigits_ == 0 )
+    {
+        throwInvalidFieldError( line, firstColumn );
+    }
+
+    double powerOfTen_ = 1.0;
+    for ( int decimal = 0; decimal < numberOfDecimals_; decimal++ )
+    {
+        powerOfTen_ *= 10.0;
+    }
+
+    const double value_ = static_cast< double >( digits_ ) / powerOfTen_;
+    return isNegative_ ? -value_ : value_;
+}
+
+//! Parse number with implied decimal point and exponent in fixed-column field.
+/*!
+ * Parses a number in the exponential notation of the two-line element format, in which the
+ * mantissa has an implied leading decimal point and the exponent is given by a sign and a digit,
+ * e.g., " 12345-4" = 0.12345e-4, from a fixed-column field.
+ * \param line Element line.
+ * \param firstColumn First column of field (1-based, as in the format definition).
+ * \param lastColumn Last column of field (1-based, inclusive).
+ * \return Value of field.
+ */
+double parseExponentialField( const char* line, const int firstColumn, const int lastColumn )
+{
+    // Find the sign of the exponent, searching backwards from the end of the field.
+    int exponentSignColumn_ = lastColumn;
+    while ( exponentSignColumn_ > firstColumn && line[ exponentSignColumn_ - 1 ] != '-'
+            && line[ exponentSignColumn_ - 1 ] != '+' )
+    {
+        exponentSignColumn_--;
+    }
+
+    // Parse the mantissa; a field without exponent is read as a mantissa only.
+    const bool hasExponent_ = ( exponentSignColumn_ > firstColumn );
+    const int lastMantissaColumn_ = hasExponent_ ? exponentSignColumn_ - 1 : lastColumn;
+
+    // Skip leading spaces and sign of the mantissa, such that the implied decimal point can be
+    // placed before the first digit.
+    int firstMantissaColumn_ = firstColumn;
+    bool isNegative_ = false;
+    while ( firstMantissaColumn_ < lastMantissaColumn_
+            && ( line[ firstMantissaColumn_ - 1 ] == ' '
+                 || line[ firstMantissaColumn_ - 1 ] == '-'
+                 || line[ firstMantissaColumn_ - 1 ] == '+' ) )
+    {
+        isNegative_ = isNegative_ || ( line[ firstMantissaColumn_ - 1 ] == '-' );
+        firstMantissaColumn_++;
+    }
+
+    const double mantissa_ = parseDecimalField( line, firstMantissaColumn_, lastMantissaColumn_,
+                                                true );
+
+    const double exponent_ = hasExponent_
+            ? parseDecimalField( line, exponentSignColumn_, lastColumn ) : 0.0;
+
+    return ( isNegative_ ? -mantissa_ : mantissa_ ) * std::pow( 10.0, exponent_ );
+}
+
+//! Parse catalog number.
+/*!
+ * Parses the satellite catalog number in columns 3 to 7 of an element line, including catalog
+ * numbers in the alpha-5 format, in which the first digit is replaced by a letter (A = 10,
+ * ..., Z = 33, skipping I and O) for catalog numbers above 99999.
+ * \param line Element line.
+ * \return Catalog number.
+ */
+int parseCatalogNumber( const char* line )
+{
+    const char firstCharacter_ = line[ 2 ];
+    if ( firstCharacter_ >= 'A' && firstCharacter_ <= 'Z'
+         && firstCharacter_ != 'I' && firstCharacter_ != 'O' )
+    {
+        int leadingNumber_ = 10 + ( firstCharacter_ - 'A' );
+        if ( firstCharacter_ > 'I' )
+        {
+            leadingNumber_--;
+        }
+        if ( firstCharacter_ > 'O' )
+        {
+            leadingNumber_--;
+        }
+
+        return 10000 * leadingNumber_ + static_cast< int >( parseDecimalField( line, 4, 7 ) );
+    }
+
+    return static_cast< int >( parseDecimalField( line, 3, 7 ) );
+}
+
+//! Convert degrees to radians.
+/*!
+ * Converts an angle in degrees to radians.
+ * \param angleInDegrees Angle in degrees.                                                [deg]
+ * \return Angle in radians.                                                                [rad]
+ */
+double convertDegreesToRadians( const double angleInDegrees )
+{
+    return angleInDegrees * basic_mathematics::mathematical_constants::PI / 180.0;
+}
+
+//! Remove trailing carriage return from line in buffer.
+/*!
+ * Removes a trailing carriage return from a line in a buffer, as present in files with Windows
+ * line endings.
+ * \param line Buffer containing line.
+ * \return Length of line.
+ */
+int removeTrailingCarriageReturn( char* line )
+{
+    int length_ = std::strlen( line );
+    if ( length_ > 0 && line[ length_ - 1 ] == '\r' )
+    {
+        line[ --length_ ] = '\0';
+    }
+    return length_;
+}
+
+//! Read line into buffer.
+/*!
+ * Reads a line from a stream into a buffer of size LINE_BUFFER_SIZE. Lines that do not fit in
+ * the buffer are truncated, and the remainder of the line is skipped.
+ * \param inputStream Stream from which line is read.
+ * \param line Buffer in which line is stored.
+ * \return True if a line was read, false at the end of the stream.
+ */
+bool readLine( std::istream& inputStream, char* line )
+{
+    inputStream.getline( line, LINE_BUFFER_SIZE );
+    if ( inputStream.eof( ) && std::strlen( line ) == 0 )
+    {
+        return false;
+    }
+
+    if ( inputStream.fail( ) && !inputStream.eof( ) )
+    {
+        // Line was too long for buffer; skip the remainder.
+        inputStream.clear( );
+        inputStream.ignore( std::numeric_limits< std::streamsize >::max( ), '\n' );
+    }
+
+    removeTrailingCarriageReturn( line );
+    return true;
+}
+
+//! Check if line is element line with given line number.
+/*!
+ * Checks if a line is an element line with a given line number, i.e., if it starts with the line
+ * number followed by a space.
+ * \param line Line to check.
+ * \param lineNumber Line number ('1' or '2').
+ * \return True if the line is an element line with the given line number.
+ */
+bool isElementLine( const char* line, const char lineNumber )
+{
+    return line[ 0 ] == lineNumber && line[ 1 ] == ' ';
+}
+
+} // namespace
+
+//! Parse two-line element set.
+TwoLineElementSet parseTwoLineElementSet( const char* firstLine, const char* secondLine )
+{
+    using basic_mathematics::mathematical_constants::PI;
+    using basic_astrodynamics::physical_constants::JULIAN_DAY;
+
+    // Check line lengths and line numbers.
+    const int firstLineLength_ = std::strlen( firstLine );
+    const int secondLineLength_ = std::strlen( secondLine );
+    if ( firstLineLength_ < 61 || secondLineLength_ < 63
+         || !isElementLine( firstLine, '1' ) || !isElementLine( secondLine, '2' ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format( "Invalid two-line element set:\n%1%\n%2%" )
+                                        % firstLine % secondLine ) ) ) );
+    }
+
+    TwoLineElementSet elementSet_;
+
+    // Check that both lines belong to the same satellite.
+    elementSet_.catalogNumber = parseCatalogNumber( firstLine );
+    if ( parseCatalogNumber( secondLine ) != elementSet_.catalogNumber )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format( "Catalog numbers of two-line element "
+                                                       "lines do not match:\n%1%\n%2%" )
+                                        % firstLine % secondLine ) ) ) );
+    }
+
+    // Compute the epoch from the two-digit year and the fractional day of year. The Julian day of
+    // 1 January of the year, 00:00, is computed for the Gregorian calendar.
+    const int twoDigitYear_ = static_cast< int >( parseDecimalField( firstLine, 19, 20 ) );
+    const int year_ = ( twoDigitYear_ < 57 ) ? 2000 + twoDigitYear_ : 1900 + twoDigitYear_;
+    const int daysSinceStartOfYearOne_ = 365 * ( year_ - 1 ) + ( year_ - 1 ) / 4
+            - ( year_ - 1 ) / 100 + ( year_ - 1 ) / 400;
+    const double julianDayOfStartOfYear_ = 1721425.5 + daysSinceStartOfYearOne_;
+    const double dayOfYear_ = parseDecimalField( firstLine, 21, 32 );
+    elementSet_.epoch = ( ( julianDayOfStartOfYear_ - 2451545.0 ) + ( dayOfYear_ - 1.0 ) )
+            * JULIAN_DAY;
+
+    // Parse the mean motion derivatives, which are given as n-dot / 2 in rev/day^2 and
+    // n-double-dot / 6 in rev/day^3, and the drag term.
+    const double revolutionsPerDayToRadiansPerSecond_ = 2.0 * PI / JULIAN_DAY;
+    elementSet_.firstDerivativeOfMeanMotion = 2.0 * parseDecimalField( firstLine, 34, 43 )
+            * revolutionsPerDayToRadiansPerSecond_ / JULIAN_DAY;
+    elementSet_.secondDerivativeOfMeanMotion = 6.0 * parseExponentialField( firstLine, 45, 52 )
+            * revolutionsPerDayToRadiansPerSecond_ / ( JULIAN_DAY * JULIAN_DAY );
+    elementSet_.bStarDragTerm = parseExponentialField( firstLine, 54, 61 );
+
+    // Parse the mean elements.
+    elementSet_.inclination = convertDegreesToRadians( parseDecimalField( secondLine, 9, 16 ) );
+    elementSet_.rightAscensionOfAscendingNode = convertDegreesToRadians(
+                parseDecimalField( secondLine, 18, 25 ) );
+    elementSet_.eccentricity = parseDecimalField( secondLine, 27, 33, true );
+    elementSet_.argumentOfPerigee = convertDegreesToRadians(
+                parseDecimalField( secondLine, 35, 42 ) );
+    elementSet_.meanAnomaly = convertDegreesToRadians( parseDecimalField( secondLine, 44, 51 ) );
+    elementSet_.meanMotion = parseDecimalField( secondLine, 53, 63 )
+            * revolutionsPerDayToRadiansPerSecond_;
+
+    // Parse the revolution number, if present.
+    elementSet_.revolutionNumber = 0;
+    if ( secondLineLength_ >= 68 )
+    {
+        elementSet_.revolutionNumber = static_cast< int >(
+                    parseDecimalField( secondLine, 64, 68 ) );
+    }
+
+    return elementSet_;
+}
+
+//! Read two-line element sets from stream.
+std::vector< TwoLineElementSet > readTwoLineElementSets( std::istream& inputStream )
+{
+    std::vector< TwoLineElementSet > elementSets_;
+
+    // Buffers for the current line and the first element line.
+    char line_[ LINE_BUFFER_SIZE ];
+    char firstLine_[ LINE_BUFFER_SIZE ];
+
+    while ( readLine( inputStream, line_ ) )
+    {
+        // Skip name lines and empty lines.
+        if ( !isElementLine( line_, '1' ) )
+        {
+            if ( isElementLine( line_, '2' ) )
+            {
+                boost::throw_exception(
+                            boost::enable_error_info(
+                                std::runtime_error(
+                                    boost::str( boost::format( "Second two-line element line "
+                                                               "without first line: %1%" )
+                                                % line_ ) ) ) );
+            }
+            continue;
+        }
+
+        // Read the second element line.
+        std::strcpy( firstLine_, line_ );
+        if ( !readLine( inputStream, line_ ) || !isElementLine( line_, '2' ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                boost::str( boost::format( "First two-line element line not "
+                                                           "followed by second line: %1%" )
+                                            % firstLine_ ) ) ) );
+        }
+
+        elementSets_.push_back( parseTwoLineElementSet( firstLine_, line_ ) );
+    }
+
+    return elementSets_;
+}
+
+//! Read two-line element sets from file.
+std::vector< TwoLineElementSet > readTwoLineElementSetsFromFile( const std::string& filePath )
+{
+    std::ifstream file_( filePath.c_str( ) );
+    if ( file_.fail( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format( "Data file '%s' could not be opened." )
+                                        % filePath.c_str( ) ) ) ) );
+    }
+
+    return readTwoLineElementSets( file_ );
+}
+
+} // namespace input_output
+} // namespace tudat
@@ -0,0 +1,138 @@
+/*    Copyright (c) 2010-2013, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *
+ *    References
+ *      Vallado, D. A., Crawford, P., Hujsak, R., Kelso, T. S. Revisiting Spacetrack Report #3,
+ *          AIAA/AAS Astrodynamics Specialist Conference, AIAA 2006-6753, 2006.
+ *      CelesTrak. NORAD Two-Line Element Set Format, http://celestrak.com/columns/v04n03/,
+ *          last accessed: 18th October, 2026.
+ *
+ *    Notes
+ *      The checksums of the element lines are not verified, since they are known to be incorrect
+ *      in a number of published catalogs; the fixed-column fields are validated instead.
+ *
+ */
+
+#ifndef TUDAT_CORE_TWO_LINE_ELEMENT_SET_READER_H
+#define TUDAT_CORE_TWO_LINE_ELEMENT_SET_READER_H
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Two-line element set.
+/*!
+ * Data of a NORAD two-line element set (TLE), converted to SI units. The orbital elements are the
+ * mean elements of the SGP4 theory, and should only be used with a compatible propagator. The
+ * epoch is given in seconds since 1 January 2000, 12:00 UTC, such that the epochs of different
+ * element sets can be compared directly.
+ */
+struct TwoLineElementSet
+{
+    //! Satellite catalog number; alpha-5 numbers (e.g., A0001 = 100001) are supported.
+    int catalogNumber;
+
+    //! Epoch of element set in seconds since 1 January 2000, 12:00 UTC.                        [s]
+    double epoch;
+
+    //! First time derivative of mean motion.                                           [rad/s^2]
+    double firstDerivativeOfMeanMotion;
+
+    //! Second time derivative of mean motion.                                          [rad/s^3]
+    double secondDerivativeOfMeanMotion;
+
+    //! SGP4 drag term B*.                                                      [1/Earth radii]
+    double bStarDragTerm;
+
+    //! Mean inclination.                                                                   [rad]
+    double inclination;
+
+    //! Mean right ascension of ascending node.                                             [rad]
+    double rightAscensionOfAscendingNode;
+
+    //! Mean eccentricity.                                                                    [-]
+    double eccentricity;
+
+    //! Mean argument of perigee.                                                           [rad]
+    double argumentOfPerigee;
+
+    //! Mean anomaly.                                                                       [rad]
+    double meanAnomaly;
+
+    //! Mean motion (Kozai).                                                              [rad/s]
+    double meanMotion;
+
+    //! Revolution number at epoch.
+    int revolutionNumber;
+};
+
+//! Parse two-line element set.
+/*!
+ * Parses a two-line element set from its two element lines. The fields are read from their fixed
+ * columns directly, without splitting the lines or allocating memory. An error is thrown if the
+ * lines are too short, do not start with the correct line numbers, have different catalog
+ * numbers, or contain a field that is not a valid number.
+ * \param firstLine First element line (at least 61 characters; the checksum is not needed).
+ * \param secondLine Second element line (at least 63 characters; the revolution number is read if
+ *          present).
+ * \return Two-line element set.
+ */
+TwoLineElementSet parseTwoLineElementSet( const char* firstLine, const char* secondLine );
+
+//! Read two-line element sets from stream.
+/*!
+ * Reads all two-line element sets from a stream, which is read line by line into fixed-size
+ * buffers, such that no memory is allocated per line. Both the two-line format and the three-line
+ * format, in which each element set is preceded by a line with the name of the satellite, are
+ * supported: all lines that are not element lines are skipped, as are empty lines. Lines ending
+ * in carriage returns are accepted. An error is thrown if a first element line is not followed by
+ * a matching second element line, or if an element set cannot be parsed.
+ * \param inputStream Stream from which the element sets are read.
+ * \return Vector of two-line element sets, in the order in which they appear in the stream.
+ * \sa parseTwoLineElementSet().
+ */
+std::vector< TwoLineElementSet > readTwoLineElementSets( std::istream& inputStream );
+
+//! Read two-line element sets from file.
+/*!
+ * Reads all two-line element sets from a file, which is streamed, such that the file does not
+ * have to be loaded into memory. An error is thrown if the file cannot be opened.
+ * \param filePath Path to file.
+ * \return Vector of two-line element sets, in the order in which they appear in the file.
+ * \sa readTwoLineElementSets( std::istream& ).
+ */
+std::vector< TwoLineElementSet > readTwoLineElementSetsFromFile( const std::string& filePath );
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_CORE_TWO_LINE_ELEMENT_SET_READER_H
@@ -222,6 +222,47 @@ BOOST_AUTO_TEST_CASE( testCartesianToSphericalConversion )
     }
 }
 
+//! Test if fixed-size and dynamic-size coordinate conversions give identical results.
+BOOST_AUTO_TEST_CASE( testFixedSizeCoordinateConversions )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+    using tudat::basic_mathematics::coordinate_conversions::convertSphericalToCartesian;
+    using tudat::basic_mathematics::coordinate_conversions::convertCartesianToSpherical;
+
+    // Set spherical coordinates of a number of points, stored as columns of a matrix.
+    Eigen::Matrix3d sphericalCoordinates;
+    sphericalCoordinates << 1.0, 2.0, 3.5,
+            PI / 6.0, PI / 4.0, 2.0 * PI / 3.0,
+            PI / 3.0, -PI / 4.0, 3.0;
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        // Test 1: Spherical-to-Cartesian conversion, with dynamic-size vector, fixed-size vector
+        //         and matrix column as input.
+        const Eigen::VectorXd dynamicCartesianCoordinates
+                = convertSphericalToCartesian( Eigen::VectorXd( sphericalCoordinates.col( i ) ) );
+        const Eigen::Vector3d fixedCartesianCoordinates
+                = convertSphericalToCartesian( Eigen::Vector3d( sphericalCoordinates.col( i ) ) );
+        const Eigen::Vector3d expressionCartesianCoordinates
+                = convertSphericalToCartesian( sphericalCoordinates.col( i ) );
+
+        BOOST_CHECK( dynamicCartesianCoordinates == fixedCartesianCoordinates );
+        BOOST_CHECK( expressionCartesianCoordinates == fixedCartesianCoordinates );
+
+        // Test 2: Cartesian-to-spherical conversion, with dynamic-size vector, fixed-size vector
+        //         and vector expression as input.
+        const Eigen::VectorXd dynamicSphericalCoordinates
+                = convertCartesianToSpherical( dynamicCartesianCoordinates );
+        const Eigen::Vector3d fixedSphericalCoordinates
+                = convertCartesianToSpherical( fixedCartesianCoordinates );
+        const Eigen::Vector3d expressionSphericalCoordinates
+                = convertCartesianToSpherical( 1.0 * fixedCartesianCoordinates );
+
+        BOOST_CHECK( dynamicSphericalCoordinates == fixedSphericalCoordinates );
+        BOOST_CHECK( expressionSphericalCoordinates == fixedSphericalCoordinates );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
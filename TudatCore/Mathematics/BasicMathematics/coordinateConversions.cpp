@@ -66,6 +66,12 @@ namespace coordinate_conversions
 
 //! Convert spherical (radius_, zenith, azimuth) to Cartesian (x,y,z) coordinates.
 Eigen::VectorXd convertSphericalToCartesian( const Eigen::VectorXd& sphericalCoordinates )
+{
+    return convertSphericalToCartesian( Eigen::Vector3d( sphericalCoordinates ) );
+}
+
+//! Convert spherical to Cartesian coordinates, using fixed-size vectors.
+Eigen::Vector3d convertSphericalToCartesian( const Eigen::Vector3d& sphericalCoordinates )
 {
     // Create local variables.
     double radius_ = sphericalCoordinates( 0 );
@@ -75,8 +81,8 @@ Eigen::VectorXd convertSphericalToCartesian( const Eigen::VectorXd& sphericalCoo
     // Declaring sine which has multiple usages to save computation time.
     double sineOfZenithAngle_ = std::sin( sphericalCoordinates( 1 ) );
 
-    // Create output VectorXd.
-    Eigen::VectorXd convertedCartesianCoordinates_ = Eigen::VectorXd::Zero( 3 );
+    // Create output vector.
+    Eigen::Vector3d convertedCartesianCoordinates_ = Eigen::Vector3d::Zero( );
 
     // Perform transformation.
     convertedCartesianCoordinates_( 0 ) = radius_ * std::cos( azimuthAngle_ ) * sineOfZenithAngle_;
@@ -89,8 +95,14 @@ Eigen::VectorXd convertSphericalToCartesian( const Eigen::VectorXd& sphericalCoo
 //! Convert Cartesian (x,y,z) to spherical (radius, zenith, azimuth) coordinates.
 Eigen::VectorXd convertCartesianToSpherical( const Eigen::VectorXd& cartesianCoordinates )
 {
-    // Create output VectorXd.
-    Eigen::VectorXd convertedSphericalCoordinates_ = Eigen::VectorXd::Zero( 3 );
+    return convertCartesianToSpherical( Eigen::Vector3d( cartesianCoordinates ) );
+}
+
+//! Convert Cartesian to spherical coordinates, using fixed-size vectors.
+Eigen::Vector3d convertCartesianToSpherical( const Eigen::Vector3d& cartesianCoordinates )
+{
+    // Create output vector.
+    Eigen::Vector3d convertedSphericalCoordinates_ = Eigen::Vector3d::Zero( );
 
     // Compute transformation of Cartesian coordinates to spherical coordinates.
     convertedSphericalCoordinates_( 0 ) = cartesianCoordinates.norm( );
@@ -83,6 +83,33 @@ namespace coordinate_conversions
  */
 Eigen::VectorXd convertSphericalToCartesian( const Eigen::VectorXd& sphericalCoordinates );
 
+//! Convert spherical to Cartesian coordinates, using fixed-size vectors.
+/*!
+ * Converts spherical to Cartesian coordinates, using fixed-size vectors only, such that no
+ * dynamic memory is allocated.
+ * \param sphericalCoordinates Vector containing radius, zenith and azimuth (in that order).
+ * \return Vector containing Cartesian coordinates, as calculated from sphericalCoordinates.
+ * \sa convertSphericalToCartesian( const Eigen::VectorXd& ).
+ */
+Eigen::Vector3d convertSphericalToCartesian( const Eigen::Vector3d& sphericalCoordinates );
+
+//! Convert spherical to Cartesian coordinates, given as Eigen expression.
+/*!
+ * Converts spherical to Cartesian coordinates, given as an arbitrary Eigen expression of three
+ * coordinates, e.g., a column of a matrix. The coordinates are evaluated into a fixed-size
+ * vector, such that no dynamic memory is allocated.
+ * \param sphericalCoordinates Eigen expression containing radius, zenith and azimuth (in that
+ *          order).
+ * \return Vector containing Cartesian coordinates, as calculated from sphericalCoordinates.
+ * \sa convertSphericalToCartesian( const Eigen::VectorXd& ).
+ */
+template< typename SphericalCoordinatesType >
+Eigen::Vector3d convertSphericalToCartesian(
+        const Eigen::MatrixBase< SphericalCoordinatesType >& sphericalCoordinates )
+{
+    return convertSphericalToCartesian( Eigen::Vector3d( sphericalCoordinates ) );
+}
+
 //! Convert Cartesian (x,y,z) to spherical (radius, zenith, azimuth) coordinates.
 /*!
  * Converts Cartesian to spherical coordinates. Schematic representation can be found on, e.g.,
@@ -100,6 +127,34 @@ Eigen::VectorXd convertSphericalToCartesian( const Eigen::VectorXd& sphericalCoo
 */
 Eigen::VectorXd convertCartesianToSpherical( const Eigen::VectorXd& cartesianCoordinates );
 
+//! Convert Cartesian to spherical coordinates, using fixed-size vectors.
+/*!
+ * Converts Cartesian to spherical coordinates, using fixed-size vectors only, such that no
+ * dynamic memory is allocated.
+ * \param cartesianCoordinates Vector containing Cartesian coordinates.
+ * \return Vector containing radius, zenith and azimuth (in that order), as calculated from
+ *          cartesianCoordinates.
+ * \sa convertCartesianToSpherical( const Eigen::VectorXd& ).
+ */
+Eigen::Vector3d convertCartesianToSpherical( const Eigen::Vector3d& cartesianCoordinates );
+
+//! Convert Cartesian to spherical coordinates, given as Eigen expression.
+/*!
+ * Converts Cartesian to spherical coordinates, given as an arbitrary Eigen expression of three
+ * coordinates, e.g., a column of a matrix. The coordinates are evaluated into a fixed-size
+ * vector, such that no dynamic memory is allocated.
+ * \param cartesianCoordinates Eigen expression containing Cartesian coordinates.
+ * \return Vector containing radius, zenith and azimuth (in that order), as calculated from
+ *          cartesianCoordinates.
+ * \sa convertCartesianToSpherical( const Eigen::VectorXd& ).
+ */
+template< typename CartesianCoordinatesType >
+Eigen::Vector3d convertCartesianToSpherical(
+        const Eigen::MatrixBase< CartesianCoordinatesType >& cartesianCoordinates )
+{
+    return convertCartesianToSpherical( Eigen::Vector3d( cartesianCoordinates ) );
+}
+
 } // namespace coordinate_conversions
 } // namespace basic_mathematics
 } // namespace tudat